@@ -39,11 +39,13 @@
 #include "gui/statusbar.h"
 
 #include "hardware/json_psram_allocator.h"
-
-
-
+#include "hardware/wifictl.h"
+#include "hardware/dataprovider.h"
+#include "hardware/configapi.h"
 
 crypto_ticker_config_t crypto_ticker_config;
+crypto_ticker_data_t crypto_ticker_data;
+dataprovider_t *crypto_ticker_provider = NULL;
 
 
 uint32_t crypto_ticker_main_tile_num;
@@ -60,14 +62,29 @@ LV_IMG_DECLARE(info_1_16px);
 
 // declare callback functions
 static void enter_crypto_ticker_event_cb( lv_obj_t * obj, lv_event_t event );
+static int crypto_ticker_provider_fetch_cb( void *data, datacache_t *cache );
+void crypto_ticker_wifictl_event_cb( EventBits_t event, char* msg );
 
 void crypto_ticker_load_config( void );
 
+/*
+ * settings for /api/config
+ */
+static const configapi_field_t crypto_ticker_configapi_fields[] = {
+    CONFIGAPI_STRING_FIELD( "symbol", sizeof( crypto_ticker_config.symbol ) - 1, []() -> const char * { return( crypto_ticker_config.symbol ); }, []( const char *value ) { strlcpy( crypto_ticker_config.symbol, value, sizeof( crypto_ticker_config.symbol ) ); } ),
+    CONFIGAPI_BOOL_FIELD( "autosync", []() -> bool { return( crypto_ticker_config.autosync ); }, []( bool value ) { crypto_ticker_config.autosync = value; } ),
+};
+
 // setup routine for example app
 void crypto_ticker_setup( void ) {
 
     crypto_ticker_load_config();
 
+    configapi_register( "crypto", crypto_ticker_configapi_fields, sizeof( crypto_ticker_configapi_fields ) / sizeof( configapi_field_t ), crypto_ticker_save_config );
+
+    // one fetch for main tile and widget
+    crypto_ticker_provider = dataprovider_create( "crypto ticker", CRYPTO_TICKER_CACHE_FILE, CRYPTO_TICKER_CACHE_VERSION, &crypto_ticker_data, sizeof( crypto_ticker_data ), crypto_ticker_provider_fetch_cb, CRYPTO_TICKER_TTL );
+
     // register 2 vertical tiles and get the first tile number and save it for later use
     crypto_ticker_main_tile_num = mainbar_add_app_tile( 1, 2 );
     crypto_ticker_setup_tile_num = crypto_ticker_main_tile_num + 1;
@@ -100,6 +117,32 @@ void crypto_ticker_setup( void ) {
     crypto_ticker_widget_setup();
 
     #endif // CRYPTO_TICKER_WIDGET
+
+    // show the last known statistics until the first sync is done
+    dataprovider_load( crypto_ticker_provider, crypto_ticker_config.symbol );
+
+    wifictl_register_cb( WIFICTL_CONNECT, crypto_ticker_wifictl_event_cb );
+}
+
+static int crypto_ticker_provider_fetch_cb( void *data, datacache_t *cache ) {
+    return( crypto_ticker_fetch_statistics( &crypto_ticker_config, (crypto_ticker_data_t*)data, cache ) );
+}
+
+void crypto_ticker_wifictl_event_cb( EventBits_t event, char* msg ) {
+    switch( event ) {
+        case WIFICTL_CONNECT:       if ( crypto_ticker_config.autosync ) {
+                                        crypto_ticker_sync_request( false );
+                                    }
+                                    break;
+    }
+}
+
+void crypto_ticker_sync_request( bool force ) {
+    dataprovider_request( crypto_ticker_provider, crypto_ticker_config.symbol, force );
+}
+
+dataprovider_t *crypto_ticker_get_provider( void ) {
+    return( crypto_ticker_provider );
 }
 
 uint32_t crypto_ticker_get_app_main_tile_num( void ) {
@@ -140,6 +183,9 @@ crypto_ticker_config_t *crypto_ticker_get_config( void ) {
  *
  */
 void crypto_ticker_save_config( void ) {
+    if ( configapi_defer_save( crypto_ticker_save_config ) ) {
+        return;
+    }
   
 
     fs::File file = SPIFFS.open( crypto_ticker_JSON_CONFIG_FILE, FILE_WRITE );
@@ -24,9 +24,16 @@
 
     #include <TTGO.h>
 
+    #include "hardware/dataprovider.h"
+
     //#define CRYPTO_TICKER_WIDGET    // uncomment if an widget need, comment to hide
 
     #define crypto_ticker_JSON_CONFIG_FILE        "/crypto-ticker.json"
+    #define CRYPTO_TICKER_CACHE_FILE              "/crypto-ticker.cache"
+    #define CRYPTO_TICKER_CACHE_VERSION           2
+    #define CRYPTO_TICKER_CACHE_MAX_AGE           ( 15 * 60 )     /** @brief age in seconds after cached prices are shown as stale */
+    #define CRYPTO_TICKER_TTL                     60              /** @brief age in seconds after prices are fetched again on connect */
+    #define CRYPTO_TICKER_STALE_CHECK_INTERVAL    1000            /** @brief interval in ms to check the age of the shown data */
 
     
 
@@ -35,6 +42,17 @@
             bool autosync = true;
         } crypto_ticker_config_t;
 
+    /*
+     * @brief 24h statistics, shared by main tile and widget
+     */
+    typedef struct {
+        bool valide = false;
+        time_t timestamp = 0;
+        char lastPrice[50] = "";
+        char priceChangePercent[50] = "";
+        char volume[50] = "";
+    } crypto_ticker_data_t;
+
 
     void crypto_ticker_setup( void );
     crypto_ticker_config_t *crypto_ticker_get_config( void );
@@ -46,5 +64,17 @@
     void crypto_ticker_jump_to_setup( void );
 
     void crypto_ticker_save_config( void );
+    /*
+     * @brief request a sync, main tile and widget are updated by the crypto ticker provider
+     *
+     * @param   force   fetch even if the data is fresh
+     */
+    void crypto_ticker_sync_request( bool force );
+    /*
+     * @brief get the crypto ticker provider, subscribe to get notified on new data
+     *
+     * @return  pointer to the crypto ticker provider
+     */
+    dataprovider_t *crypto_ticker_get_provider( void );
 
 #endif // _CRYPTO_TICKER_H
\ No newline at end of file
@@ -20,96 +20,56 @@
  *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
 #include "config.h"
-#include "HTTPClient.h"
 
 #include "crypto_ticker.h"
-#include "crypto_ticker_main.h"
-#include "crypto_ticker_widget.h"
 #include "crypto_ticker_fetch.h"
 
 #include "hardware/powermgm.h"
-#include "hardware/json_psram_allocator.h"
+#include "hardware/httpctl.h"
+#include "hardware/datacache.h"
+#include "hardware/json_extract.h"
 
+static const json_extract_field_t crypto_ticker_statistics_fields[] = {
+    JSON_EXTRACT_FIELD( "lastPrice",            JSON_EXTRACT_STRING, crypto_ticker_data_t, lastPrice ),
+    JSON_EXTRACT_FIELD( "priceChangePercent",   JSON_EXTRACT_STRING, crypto_ticker_data_t, priceChangePercent ),
+    JSON_EXTRACT_FIELD( "volume",               JSON_EXTRACT_STRING, crypto_ticker_data_t, volume )
+};
 
-int crypto_ticker_fetch_price( crypto_ticker_config_t *crypto_ticker_config, crypto_ticker_widget_data_t *crypto_ticker_widget_data ) {
-    char url[512]="";
-    int httpcode = -1;
-
-    
-    snprintf( url, sizeof( url ), "http://%s/api/CryptoTicker/Price/%s", MY_TTGO_WATCH_HOST, crypto_ticker_config->symbol);
-
-    HTTPClient today_client;
-
-    today_client.useHTTP10( true );
-    today_client.begin( url );
-    today_client.addHeader("force-unsecure","true");
-    httpcode = today_client.GET();
-
-    if ( httpcode != 200 ) {
-        log_e("HTTPClient error %d", httpcode, url );
-        today_client.end();
-        return( -1 );
-    }
-
-    SpiRamJsonDocument doc( 1000 );
-
-    DeserializationError error = deserializeJson( doc, today_client.getStream() );
-    if (error) {
-        log_e("crypto_ticker deserializeJson() failed: %s", error.c_str() );
-        doc.clear();
-        today_client.end();
-        return( -1 );
-    }
-
-    today_client.end();
-
-    crypto_ticker_widget_data->valide = true;
-    strcpy( crypto_ticker_widget_data->price, doc["price"] );
-
-
-    doc.clear();
-    return( httpcode );
-}
-
-
-
-int crypto_ticker_fetch_statistics( crypto_ticker_config_t *crypto_ticker_config, crypto_ticker_main_data_t *crypto_ticker_main_data ) {
+int crypto_ticker_fetch_statistics( crypto_ticker_config_t *crypto_ticker_config, crypto_ticker_data_t *crypto_ticker_data, datacache_t *cache ) {
     char url[512]="";
+    char headers[ 192 ]="force-unsecure: true\r\n";
     int httpcode = -1;
 
     
     snprintf( url, sizeof( url ), "http://%s/api/CryptoTicker/24hrStatistics/%s", MY_TTGO_WATCH_HOST, crypto_ticker_config->symbol);
 
-    HTTPClient today_client;
+    httpctl_response_t response;
+    datacache_get_conditional_headers( cache, headers + strlen( headers ), sizeof( headers ) - strlen( headers ) );
+    httpctl_con_t *today_con = httpctl_get( url, headers, &response );
 
-    today_client.useHTTP10( true );
-    today_client.begin( url );
-    today_client.addHeader("force-unsecure","true");
-    httpcode = today_client.GET();
+    if ( today_con != NULL && response.httpcode == 304 ) {
+        httpctl_close( today_con );
+        datacache_update( cache, &response );
+        return( response.httpcode );
+    }
 
-    if ( httpcode != 200 ) {
-        log_e("HTTPClient error %d", httpcode, url );
-        today_client.end();
+    if ( today_con == NULL || response.httpcode != 200 ) {
+        log_e("http error %d", response.httpcode );
+        httpctl_close( today_con );
         return( -1 );
     }
+    httpcode = response.httpcode;
 
-    SpiRamJsonDocument doc( 1000 );
-
-    DeserializationError error = deserializeJson( doc, today_client.getStream() );
-    if (error) {
-        log_e("crypto_ticker deserializeJson() failed: %s", error.c_str() );
-        doc.clear();
-        today_client.end();
+    if ( json_extract( *httpctl_get_stream( today_con ), crypto_ticker_statistics_fields, sizeof( crypto_ticker_statistics_fields ) / sizeof( json_extract_field_t ), crypto_ticker_data ) < 0 ) {
+        log_e("crypto_ticker json_extract() failed");
+        httpctl_close( today_con );
         return( -1 );
     }
 
-    today_client.end();
+    httpctl_close( today_con );
+    datacache_update( cache, &response );
 
-    crypto_ticker_main_data->valide = true;
-    strcpy( crypto_ticker_main_data->lastPrice, doc["lastPrice"] );
-    strcpy( crypto_ticker_main_data->priceChangePercent, doc["priceChangePercent"] );
-    strcpy( crypto_ticker_main_data->volume, doc["volume"] );
+    crypto_ticker_data->valide = true;
 
-    doc.clear();
     return( httpcode );
 }
\ No newline at end of file
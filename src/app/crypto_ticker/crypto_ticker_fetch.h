@@ -20,15 +20,19 @@
  *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
 
-#include "crypto_ticker_widget.h" //TODO: why is this needed
-#include "crypto_ticker_main.h"   //TODO: why is this needed
-
 #ifndef _CRYPTO_TICKER_FETCH_H
     #define _CRYPTO_TICKER_FETCH_H
 
     #define MY_TTGO_WATCH_HOST    "my-ttgo-watch.co.uk"
 
-    int crypto_ticker_fetch_price( crypto_ticker_config_t * crypto_ticker_config, crypto_ticker_widget_data_t * crypto_ticker_today );
-    int crypto_ticker_fetch_statistics( crypto_ticker_config_t *crypto_ticker_config, crypto_ticker_main_data_t *crypto_ticker_main_data );
+    #include "crypto_ticker.h"
+    #include "hardware/datacache.h"
+
+    /*
+     * @brief fetch 24h statistics, an conditional request is send if the cache hold validators
+     *
+     * @return  200 on new data, 304 if unchanged or -1 if fail
+     */
+    int crypto_ticker_fetch_statistics( crypto_ticker_config_t *crypto_ticker_config, crypto_ticker_data_t *crypto_ticker_data, datacache_t *cache );
 
 #endif // _CRYPTO_TICKER_FETCH_H
\ No newline at end of file
@@ -37,10 +37,7 @@
 #include "gui/mainbar/mainbar.h"
 #include "gui/statusbar.h"
 
-#include "hardware/wifictl.h"
-
-EventGroupHandle_t crypto_ticker_main_event_handle = NULL;
-TaskHandle_t _crypto_ticker_main_sync_Task;
+#include "hardware/dataprovider.h"
 
 lv_obj_t *crypto_ticker_main_tile = NULL;
 lv_style_t crypto_ticker_main_style;
@@ -50,11 +47,13 @@ lv_obj_t *crypto_ticker_main_last_price_value_label = NULL;
 lv_obj_t *crypto_ticker_main_price_change_value_label = NULL;
 lv_obj_t *crypto_ticker_main_volume_value_label = NULL;
 
-crypto_ticker_main_data_t crypto_ticker_main_data;
-
+lv_task_t *crypto_ticker_main_stale_task = NULL;
+bool crypto_ticker_main_stale = false;
 
-void crypto_ticker_main_sync_Task( void * pvParameters );
-void crypto_ticker_main_wifictl_event_cb( EventBits_t event, char* msg );
+static void crypto_ticker_main_update( void );
+static void crypto_ticker_main_set_stale( bool stale );
+static void crypto_ticker_main_stale_task_cb( lv_task_t *task );
+static void crypto_ticker_main_provider_event_cb( EventBits_t event, void *data );
 
 LV_IMG_DECLARE(exit_32px);
 LV_IMG_DECLARE(setup_32px);
@@ -146,19 +145,58 @@ void crypto_ticker_main_setup( uint32_t tile_num ) {
     lv_obj_align( crypto_ticker_main_volume_value_label, NULL, LV_ALIGN_IN_RIGHT_MID, -5, 0 );
 
 
-    crypto_ticker_main_event_handle = xEventGroupCreate();
+    dataprovider_register_cb( crypto_ticker_get_provider(), DATAPROVIDER_UPDATE | DATAPROVIDER_DONE, crypto_ticker_main_provider_event_cb );
+    crypto_ticker_main_stale_task = lv_task_create( crypto_ticker_main_stale_task_cb, CRYPTO_TICKER_STALE_CHECK_INTERVAL, LV_TASK_PRIO_LOWEST, NULL );
+}
 
-    wifictl_register_cb( WIFICTL_OFF | WIFICTL_CONNECT, crypto_ticker_main_wifictl_event_cb );
+static void crypto_ticker_main_provider_event_cb( EventBits_t event, void *data ) {
+    crypto_ticker_main_update();
+    crypto_ticker_main_set_stale( dataprovider_is_stale( crypto_ticker_get_provider(), CRYPTO_TICKER_CACHE_MAX_AGE ) );
 }
 
-void crypto_ticker_main_wifictl_event_cb( EventBits_t event, char* msg ) {    
-    switch( event ) {
-        case WIFICTL_CONNECT:       crypto_ticker_config_t *crypto_ticker_config = crypto_ticker_get_config();
-                                    if ( crypto_ticker_config->autosync ) {
-                                        crypto_ticker_main_sync_request();
-                                    }
-                                    break;
+static void crypto_ticker_main_stale_task_cb( lv_task_t *task ) {
+    crypto_ticker_data_t *crypto_ticker_data = ( crypto_ticker_data_t * )crypto_ticker_get_provider()->data;
+
+    if ( !crypto_ticker_data->valide ) {
+        return;
     }
+    bool stale = dataprovider_is_stale( crypto_ticker_get_provider(), CRYPTO_TICKER_CACHE_MAX_AGE );
+    if ( stale != crypto_ticker_main_stale ) {
+        crypto_ticker_main_set_stale( stale );
+    }
+}
+
+/*
+ * dim the values while they are outdated
+ */
+static void crypto_ticker_main_set_stale( bool stale ) {
+    crypto_ticker_main_stale = stale;
+    lv_obj_set_style_local_text_opa( crypto_ticker_main_update_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, stale ? LV_OPA_50 : LV_OPA_COVER );
+    lv_obj_set_style_local_text_opa( crypto_ticker_main_last_price_value_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, stale ? LV_OPA_50 : LV_OPA_COVER );
+    lv_obj_set_style_local_text_opa( crypto_ticker_main_price_change_value_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, stale ? LV_OPA_50 : LV_OPA_COVER );
+    lv_obj_set_style_local_text_opa( crypto_ticker_main_volume_value_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, stale ? LV_OPA_50 : LV_OPA_COVER );
+    lv_obj_invalidate( crypto_ticker_main_tile );
+}
+
+static void crypto_ticker_main_update( void ) {
+    crypto_ticker_data_t *crypto_ticker_data = ( crypto_ticker_data_t * )crypto_ticker_get_provider()->data;
+    time_t timestamp = dataprovider_get_timestamp( crypto_ticker_get_provider() );
+    struct tm info;
+    char buf[64];
+
+    lv_label_set_text( crypto_ticker_main_last_price_value_label, crypto_ticker_data->lastPrice );
+    lv_obj_align( crypto_ticker_main_last_price_value_label, NULL, LV_ALIGN_IN_RIGHT_MID, -5, 0 );
+
+    lv_label_set_text( crypto_ticker_main_price_change_value_label, crypto_ticker_data->priceChangePercent );
+    lv_obj_align( crypto_ticker_main_price_change_value_label, NULL, LV_ALIGN_IN_RIGHT_MID, -5, 0 );
+
+    lv_label_set_text( crypto_ticker_main_volume_value_label, crypto_ticker_data->volume );
+    lv_obj_align( crypto_ticker_main_volume_value_label, NULL, LV_ALIGN_IN_RIGHT_MID, -5, 0 );
+
+    localtime_r( &timestamp, &info );
+    strftime( buf, sizeof(buf), "updated: %d.%b %H:%M", &info );
+    lv_label_set_text( crypto_ticker_main_update_label, buf );
+    lv_obj_invalidate( lv_scr_act() );
 }
 
 static void enter_crypto_ticker_setup_event_cb( lv_obj_t * obj, lv_event_t event ) {
@@ -178,69 +216,7 @@ static void exit_crypto_ticker_main_event_cb( lv_obj_t * obj, lv_event_t event )
 
 static void refresh_crypto_ticker_main_event_cb( lv_obj_t * obj, lv_event_t event ) {
     switch( event ) {
-        case( LV_EVENT_CLICKED ):       crypto_ticker_main_sync_request();
-
-#ifdef CRYPTO_TICKER_WIDGET
-
-                                        crypto_ticker_widget_sync_request();
-
-#endif // CRYPTO_TICKER_WIDGET
+        case( LV_EVENT_CLICKED ):       crypto_ticker_sync_request( true );
                                         break;
     }
 }
-
-
-void crypto_ticker_main_sync_request( void ) {
-    if ( xEventGroupGetBits( crypto_ticker_main_event_handle ) & CRYPTO_TICKER_MAIN_SYNC_REQUEST ) {
-        return;
-    }
-    else {
-        xEventGroupSetBits( crypto_ticker_main_event_handle, CRYPTO_TICKER_MAIN_SYNC_REQUEST );
-        xTaskCreate(    crypto_ticker_main_sync_Task,      /* Function to implement the task */
-                        "crypto ticker main sync Task",    /* Name of the task */
-                        5000,                            /* Stack size in words */
-                        NULL,                            /* Task input parameter */
-                        1,                               /* Priority of the task */
-                        &_crypto_ticker_main_sync_Task );  /* Task handle. */ 
-    }
-}
-
-void crypto_ticker_main_sync_Task( void * pvParameters ) {
-    crypto_ticker_config_t *crypto_ticker_config = crypto_ticker_get_config();
-    int32_t retval = -1;
-
-    log_i("start crypto ticker main task, heap: %d", ESP.getFreeHeap() );
-
-    vTaskDelay( 250 );
-
-    if ( xEventGroupGetBits( crypto_ticker_main_event_handle ) & CRYPTO_TICKER_MAIN_SYNC_REQUEST ) {   
-        if ( crypto_ticker_config->autosync ) {
-            retval = crypto_ticker_fetch_statistics( crypto_ticker_config , &crypto_ticker_main_data );
-            if ( retval == 200 ) {
-                time_t now;
-                struct tm info;
-                char buf[64];
-
-
-                lv_label_set_text( crypto_ticker_main_last_price_value_label, crypto_ticker_main_data.lastPrice );
-                lv_obj_align( crypto_ticker_main_last_price_value_label, NULL, LV_ALIGN_IN_RIGHT_MID, -5, 0 );
-
-                lv_label_set_text( crypto_ticker_main_price_change_value_label, crypto_ticker_main_data.priceChangePercent );
-                lv_obj_align( crypto_ticker_main_price_change_value_label, NULL, LV_ALIGN_IN_RIGHT_MID, -5, 0 );
-
-                lv_label_set_text( crypto_ticker_main_volume_value_label, crypto_ticker_main_data.volume );
-                lv_obj_align( crypto_ticker_main_volume_value_label, NULL, LV_ALIGN_IN_RIGHT_MID, -5, 0 );
-               
-
-                time( &now );
-                localtime_r( &now, &info );
-                strftime( buf, sizeof(buf), "updated: %d.%b %H:%M", &info );
-                lv_label_set_text( crypto_ticker_main_update_label, buf );
-                lv_obj_invalidate( lv_scr_act() );
-            }
-        }
-    }
-    xEventGroupClearBits( crypto_ticker_main_event_handle, CRYPTO_TICKER_MAIN_SYNC_REQUEST );
-    log_i("finish crypto ticker main task, heap: %d", ESP.getFreeHeap() );
-    vTaskDelete( NULL );
-}
\ No newline at end of file
@@ -28,6 +28,7 @@
 #include "gui/mainbar/mainbar.h"
 #include "gui/statusbar.h"
 #include "gui/keyboard.h"
+#include "hardware/configapi.h"
 
 
 lv_obj_t *crypto_ticker_setup_tile = NULL;
@@ -41,6 +42,7 @@ LV_IMG_DECLARE(exit_32px);
 static void exit_crypto_ticker_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void crypto_ticker_textarea_event_cb( lv_obj_t * obj, lv_event_t event );
 static void crypto_ticker_autosync_switch_event_cb( lv_obj_t * obj, lv_event_t event );
+static void crypto_ticker_setup_refresh( void );
 
 void crypto_ticker_setup_setup( uint32_t tile_num ) {
 
@@ -108,6 +110,18 @@ void crypto_ticker_setup_setup( uint32_t tile_num ) {
     lv_obj_add_style( crypto_ticker_autosync_switch_label, LV_OBJ_PART_MAIN, &crypto_ticker_setup_style  );
     lv_label_set_text( crypto_ticker_autosync_switch_label, "autosync");
     lv_obj_align( crypto_ticker_autosync_switch_label, crypto_ticker_autosync_switch_cont, LV_ALIGN_IN_LEFT_MID, 5, 0 );
+
+    configapi_register_cb( crypto_ticker_setup_refresh );
+}
+
+/*
+ * show the current settings, also called when they are changed over the webserver
+ */
+static void crypto_ticker_setup_refresh( void ) {
+    crypto_ticker_config_t * crypto_ticker_config = crypto_ticker_get_config();
+
+    lv_textarea_set_text( crypto_ticker_symbol_textfield, crypto_ticker_config->symbol );
+    crypto_ticker_config->autosync ? lv_switch_on( crypto_ticker_autosync_switch, LV_ANIM_OFF ) : lv_switch_off( crypto_ticker_autosync_switch, LV_ANIM_OFF );
 }
 
 
@@ -32,12 +32,10 @@
 
 #include "hardware/json_psram_allocator.h"
 #include "hardware/wifictl.h"
+#include "hardware/dataprovider.h"
 
-EventGroupHandle_t crypto_ticker_widget_event_handle = NULL;
-TaskHandle_t _crypto_ticker_widget_sync_Task;
-void crypto_ticker_widget_sync_Task( void * pvParameters );
-
-crypto_ticker_widget_data_t crypto_ticker_widget_data;
+lv_task_t *crypto_ticker_widget_stale_task = NULL;
+bool crypto_ticker_widget_stale = false;
 
 // widget icon container
 lv_obj_t *crypto_ticker_widget_cont = NULL;
@@ -47,6 +45,10 @@ lv_obj_t *crypto_ticker_widget_label = NULL;
 
 static void enter_crypto_ticker_widget_event_cb( lv_obj_t * obj, lv_event_t event );
 void crypto_ticker_widget_wifictl_event_cb( EventBits_t event, char* msg );
+static void crypto_ticker_widget_update( void );
+static void crypto_ticker_widget_set_stale( bool stale );
+static void crypto_ticker_widget_stale_task_cb( lv_task_t *task );
+static void crypto_ticker_widget_provider_event_cb( EventBits_t event, void *data );
 
 // declare you images or fonts you need
 LV_IMG_DECLARE(info_ok_16px);
@@ -89,12 +91,62 @@ void crypto_ticker_widget_setup( void ) {
     lv_obj_align( crypto_ticker_widget_label, crypto_ticker_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
 
 
-    crypto_ticker_widget_event_handle = xEventGroupCreate();
+    // the widget show the last price of the 24h statistics fetched for the main tile
+    dataprovider_register_cb( crypto_ticker_get_provider(), DATAPROVIDER_SYNC | DATAPROVIDER_UPDATE | DATAPROVIDER_DONE | DATAPROVIDER_FAIL, crypto_ticker_widget_provider_event_cb );
+    crypto_ticker_widget_stale_task = lv_task_create( crypto_ticker_widget_stale_task_cb, CRYPTO_TICKER_STALE_CHECK_INTERVAL, LV_TASK_PRIO_LOWEST, NULL );
 
-    wifictl_register_cb( WIFICTL_OFF | WIFICTL_CONNECT, crypto_ticker_widget_wifictl_event_cb );
+    wifictl_register_cb( WIFICTL_OFF, crypto_ticker_widget_wifictl_event_cb );
 
 }
 
+static void crypto_ticker_widget_provider_event_cb( EventBits_t event, void *data ) {
+    if ( event & DATAPROVIDER_SYNC ) {
+        lv_obj_set_hidden( crypto_ticker_widget_icon_info, true );
+    }
+    if ( event & DATAPROVIDER_UPDATE ) {
+        crypto_ticker_widget_update();
+        crypto_ticker_widget_set_stale( dataprovider_is_stale( crypto_ticker_get_provider(), CRYPTO_TICKER_CACHE_MAX_AGE ) );
+    }
+    if ( event & DATAPROVIDER_DONE ) {
+        crypto_ticker_widget_set_stale( false );
+        lv_img_set_src( crypto_ticker_widget_icon_info, &info_ok_16px );
+        lv_obj_set_hidden( crypto_ticker_widget_icon_info, false );
+    }
+    if ( event & DATAPROVIDER_FAIL ) {
+        lv_img_set_src( crypto_ticker_widget_icon_info, &info_fail_16px );
+        lv_obj_set_hidden( crypto_ticker_widget_icon_info, false );
+    }
+    lv_obj_invalidate( lv_scr_act() );
+}
+
+static void crypto_ticker_widget_stale_task_cb( lv_task_t *task ) {
+    crypto_ticker_data_t *crypto_ticker_data = ( crypto_ticker_data_t * )crypto_ticker_get_provider()->data;
+
+    if ( !crypto_ticker_data->valide ) {
+        return;
+    }
+    bool stale = dataprovider_is_stale( crypto_ticker_get_provider(), CRYPTO_TICKER_CACHE_MAX_AGE );
+    if ( stale != crypto_ticker_widget_stale ) {
+        crypto_ticker_widget_set_stale( stale );
+    }
+}
+
+/*
+ * dim the price while it is outdated
+ */
+static void crypto_ticker_widget_set_stale( bool stale ) {
+    crypto_ticker_widget_stale = stale;
+    lv_obj_set_style_local_text_opa( crypto_ticker_widget_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, stale ? LV_OPA_50 : LV_OPA_COVER );
+    lv_obj_invalidate( crypto_ticker_widget_cont );
+}
+
+static void crypto_ticker_widget_update( void ) {
+    crypto_ticker_data_t *crypto_ticker_data = ( crypto_ticker_data_t * )crypto_ticker_get_provider()->data;
+
+    lv_label_set_text( crypto_ticker_widget_label, crypto_ticker_data->lastPrice );
+    lv_obj_align( crypto_ticker_widget_label, crypto_ticker_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, 0 );
+}
+
 
 
 
@@ -117,11 +169,6 @@ void crypto_ticker_widget_wifictl_event_cb( EventBits_t event, char* msg ) {
     log_i("crypto_ticker widget wifictl event: %04x", event );
 
     switch( event ) {
-        case WIFICTL_CONNECT:       if ( crypto_ticker_get_config()->autosync ) {
-                                        crypto_ticker_widget_sync_request();
-                                    }
-                                    break;
-
         case WIFICTL_OFF:           lv_obj_set_hidden( crypto_ticker_widget_icon_info, true );
                                     break;
 
@@ -137,49 +184,3 @@ static void enter_crypto_ticker_widget_event_cb( lv_obj_t * obj, lv_event_t even
                                         break;
     }    
 }
-
-
-
-void crypto_ticker_widget_sync_request( void ) {
-    if ( xEventGroupGetBits( crypto_ticker_widget_event_handle ) & CRYPTO_TICKER_WIDGET_SYNC_REQUEST ) {
-        return;
-    }
-    else {
-        xEventGroupSetBits( crypto_ticker_widget_event_handle, CRYPTO_TICKER_WIDGET_SYNC_REQUEST );
-        lv_obj_set_hidden( crypto_ticker_widget_icon_info, true );
-        xTaskCreate(    crypto_ticker_widget_sync_Task,       /* Function to implement the task */
-                        "crypto_ticker widget sync Task",     /* Name of the task */
-                        5000,                           /* Stack size in words */
-                        NULL,                           /* Task input parameter */
-                        1,                              /* Priority of the task */
-                        &_crypto_ticker_widget_sync_Task );   /* Task handle. */
-    }
-}
-
-
-
-
-void crypto_ticker_widget_sync_Task( void * pvParameters ) {
-    log_i("start crypto_ticker widget task");
-
-    vTaskDelay( 250 );
-
-    if ( xEventGroupGetBits( crypto_ticker_widget_event_handle ) & CRYPTO_TICKER_WIDGET_SYNC_REQUEST ) {       
-        uint32_t retval = crypto_ticker_fetch_price(crypto_ticker_get_config() , &crypto_ticker_widget_data );
-        if ( retval == 200 ) {
-           
-            lv_img_set_src( crypto_ticker_widget_icon_info, &info_ok_16px );
-            lv_obj_set_hidden( crypto_ticker_widget_icon_info, false );
-            lv_label_set_text( crypto_ticker_widget_label, crypto_ticker_widget_data.price);
-            lv_obj_align( crypto_ticker_widget_label, crypto_ticker_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
-        }
-        else {
-            lv_img_set_src( crypto_ticker_widget_icon_info, &info_fail_16px );
-            lv_obj_set_hidden( crypto_ticker_widget_icon_info, false );
-        }
-        lv_obj_invalidate( lv_scr_act() );
-    }
-    xEventGroupClearBits( crypto_ticker_widget_event_handle, CRYPTO_TICKER_WIDGET_SYNC_REQUEST );
-    vTaskDelete( NULL );
-}
-
@@ -24,18 +24,7 @@
 
     #include <TTGO.h>
 
-    #define CRYPTO_TICKER_WIDGET_SYNC_REQUEST    _BV(0)
-
-
-    typedef struct {
-        bool valide = false;
-        time_t timestamp = 0;
-        char price[50] = "";
-    } crypto_ticker_widget_data_t;
-
     void crypto_ticker_widget_setup( void );
     void crypto_ticker_hide_widget_icon_info( bool show );
 
-    void crypto_ticker_widget_sync_request( void );
-
 #endif // CRYPTO_TICKER_WIDGET_H
\ No newline at end of file
@@ -38,13 +38,20 @@
 #include "hardware/powermgm.h"
 #include "hardware/json_psram_allocator.h"
 #include "hardware/wifictl.h"
+#include "hardware/dataprovider.h"
+#include "hardware/configapi.h"
 
-EventGroupHandle_t weather_widget_event_handle = NULL;
-TaskHandle_t _weather_widget_sync_Task;
-void weather_widget_sync_Task( void * pvParameters );
+portMUX_TYPE weatherMux = portMUX_INITIALIZER_UNLOCKED;
 
 weather_config_t weather_config;
-weather_forcast_t weather_today;
+weather_data_t *weather_data = NULL;
+dataprovider_t *weather_provider = NULL;
+
+static weather_phone_t weather_phone;
+static bool weather_phone_pending = false;
+static uint32_t weather_phone_today = 0;            /** @brief phone updates today */
+static uint32_t weather_skipped_today = 0;          /** @brief wifi fetches not needed today */
+static int weather_today = -1;                      /** @brief day of the year of the today counters */
 
 uint32_t weather_app_tile_num;
 uint32_t weather_app_setup_tile_num;
@@ -55,8 +62,19 @@ lv_obj_t *weather_widget_info_img = NULL;
 lv_obj_t *weather_widget_condition_img = NULL;
 lv_obj_t *weather_widget_temperature_label = NULL;
 lv_obj_t *weather_widget_wind_label = NULL;
+lv_task_t *weather_widget_stale_task = NULL;
+bool weather_widget_stale = false;
 
 static void enter_weather_widget_event_cb( lv_obj_t * obj, lv_event_t event );
+static void weather_widget_update( void );
+static void weather_widget_set_stale( bool stale );
+static void weather_widget_stale_task_cb( lv_task_t *task );
+static void weather_widget_provider_event_cb( EventBits_t event, void *data );
+static int weather_provider_fetch_cb( void *data, datacache_t *cache );
+static int weather_provider_push_cb( void *data, datacache_t *cache );
+static bool weather_phone_is_fresh( void );
+static void weather_count_today( bool skipped );
+static uint32_t weather_get_fetch_time( void );
 void weather_widget_wifictl_event_cb( EventBits_t event, char* msg );
 
 LV_IMG_DECLARE(owm_01d_64px);
@@ -64,10 +82,31 @@ LV_IMG_DECLARE(info_ok_16px);
 LV_IMG_DECLARE(info_fail_16px);
 LV_FONT_DECLARE(Ubuntu_16px);
 
+/*
+ * settings for /api/config
+ */
+static const configapi_field_t weather_configapi_fields[] = {
+    CONFIGAPI_STRING_FIELD( "apikey", sizeof( weather_config.apikey ) - 1, []() -> const char * { return( weather_config.apikey ); }, []( const char *value ) { strlcpy( weather_config.apikey, value, sizeof( weather_config.apikey ) ); } ),
+    CONFIGAPI_STRING_FIELD( "lat", sizeof( weather_config.lat ) - 1, []() -> const char * { return( weather_config.lat ); }, []( const char *value ) { strlcpy( weather_config.lat, value, sizeof( weather_config.lat ) ); } ),
+    CONFIGAPI_STRING_FIELD( "lon", sizeof( weather_config.lon ) - 1, []() -> const char * { return( weather_config.lon ); }, []( const char *value ) { strlcpy( weather_config.lon, value, sizeof( weather_config.lon ) ); } ),
+    CONFIGAPI_BOOL_FIELD( "autosync", []() -> bool { return( weather_config.autosync ); }, []( bool value ) { weather_config.autosync = value; } ),
+    CONFIGAPI_BOOL_FIELD( "showWind", []() -> bool { return( weather_config.showWind ); }, []( bool value ) { weather_config.showWind = value; } ),
+    CONFIGAPI_BOOL_FIELD( "imperial", []() -> bool { return( weather_config.imperial ); }, []( bool value ) { weather_config.imperial = value; } ),
+};
+
 void weather_app_setup( void ) {
 
     weather_load_config();
 
+    configapi_register( "weather", weather_configapi_fields, sizeof( weather_configapi_fields ) / sizeof( configapi_field_t ), weather_save_config );
+
+    weather_data = (weather_data_t*)ps_calloc( sizeof( weather_data_t ), 1 );
+    if( !weather_data ) {
+      log_e("weather data calloc faild");
+      while(true);
+    }
+    weather_provider = dataprovider_create( "weather", WEATHER_CACHE_FILE, WEATHER_CACHE_VERSION, weather_data, sizeof( weather_data_t ), weather_provider_fetch_cb, WEATHER_TTL );
+
     // get an app tile and copy mainstyle
     weather_app_tile_num = mainbar_add_app_tile( 1, 2 );
     weather_app_setup_tile_num = weather_app_tile_num + 1;
@@ -120,18 +159,171 @@ void weather_app_setup( void ) {
         lv_obj_align( weather_widget_wind_label, weather_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, +5);
     }
 
-    weather_widget_event_handle = xEventGroupCreate();
+    dataprovider_register_cb( weather_provider, DATAPROVIDER_SYNC | DATAPROVIDER_UPDATE | DATAPROVIDER_DONE | DATAPROVIDER_FAIL, weather_widget_provider_event_cb );
+
+    // show the last known weather until the first sync is done
+    char key[ DATACACHE_KEY_SIZE ];
+    weather_get_cache_key( key, sizeof( key ) );
+    dataprovider_load( weather_provider, key );
+
+    weather_widget_stale_task = lv_task_create( weather_widget_stale_task_cb, WEATHER_STALE_CHECK_INTERVAL, LV_TASK_PRIO_LOWEST, NULL );
 
     wifictl_register_cb( WIFICTL_OFF | WIFICTL_CONNECT, weather_widget_wifictl_event_cb );
 }
 
+void weather_get_cache_key( char *key, size_t size ) {
+    snprintf( key, size, "%s,%s,%s", weather_config.lat, weather_config.lon, weather_config.imperial ? "imperial" : "metric" );
+}
+
+static int weather_provider_fetch_cb( void *data, datacache_t *cache ) {
+    return( weather_fetch( &weather_config, (weather_data_t*)data, cache ) );
+}
+
+static int weather_provider_push_cb( void *data, datacache_t *cache ) {
+    weather_phone_t phone;
+
+    portENTER_CRITICAL( &weatherMux );
+    phone = weather_phone;
+    weather_phone_pending = false;
+    portEXIT_CRITICAL( &weatherMux );
+
+    weather_from_phone( &weather_config, &phone, (weather_data_t*)data );
+    return( 200 );
+}
+
+void weather_push_from_phone( weather_phone_t *phone ) {
+    portENTER_CRITICAL( &weatherMux );
+    weather_phone = *phone;
+    weather_phone_pending = true;
+    portEXIT_CRITICAL( &weatherMux );
+}
+
+static bool weather_phone_is_fresh( void ) {
+    // a pending update counts too, it is taken with the next stale check
+    return( weather_phone_pending || ( weather_data->source == WEATHER_SOURCE_PHONE && !dataprovider_is_stale( weather_provider, WEATHER_PHONE_TTL ) ) );
+}
+
+/*
+ * a fetch that was not needed saves the radio time of an average fetch
+ */
+static void weather_count_today( bool skipped ) {
+    struct tm info;
+    time_t now;
+
+    time( &now );
+    localtime_r( &now, &info );
+
+    if ( info.tm_yday != weather_today ) {
+        if ( weather_today >= 0 ) {
+            log_i("weather: %d updates from the phone the day before, %d wifi fetches skipped, %ds radio time saved", weather_phone_today, weather_skipped_today, weather_skipped_today * weather_get_fetch_time() / 1000 );
+        }
+        weather_today = info.tm_yday;
+        weather_phone_today = 0;
+        weather_skipped_today = 0;
+    }
+    if ( skipped ) {
+        weather_skipped_today++;
+    }
+    else {
+        weather_phone_today++;
+    }
+}
+
+static uint32_t weather_get_fetch_time( void ) {
+    return( weather_provider->fetch_count ? weather_provider->fetch_time / weather_provider->fetch_count : WEATHER_FETCH_ESTIMATE );
+}
+
+uint32_t weather_get_radio_saved_today( void ) {
+    struct tm info;
+    time_t now;
+
+    time( &now );
+    localtime_r( &now, &info );
+
+    return( info.tm_yday == weather_today ? weather_skipped_today * weather_get_fetch_time() : 0 );
+}
+
+static void weather_widget_provider_event_cb( EventBits_t event, void *data ) {
+    if ( event & DATAPROVIDER_SYNC ) {
+        lv_obj_set_hidden( weather_widget_info_img, true );
+    }
+    if ( event & DATAPROVIDER_UPDATE ) {
+        weather_widget_update();
+        weather_widget_set_stale( dataprovider_is_stale( weather_provider, WEATHER_CACHE_MAX_AGE ) );
+    }
+    if ( event & DATAPROVIDER_DONE ) {
+        weather_widget_set_stale( false );
+        lv_img_set_src( weather_widget_info_img, &info_ok_16px );
+        lv_obj_set_hidden( weather_widget_info_img, false );
+    }
+    if ( event & DATAPROVIDER_FAIL ) {
+        lv_img_set_src( weather_widget_info_img, &info_fail_16px );
+        lv_obj_set_hidden( weather_widget_info_img, false );
+    }
+    lv_obj_invalidate( lv_scr_act() );
+}
+
+static void weather_widget_stale_task_cb( lv_task_t *task ) {
+    // the weather from the phone is taken here in the loop task, a running fetch delays it
+    if ( weather_phone_pending && dataprovider_push( weather_provider, weather_provider_push_cb ) ) {
+        weather_count_today( false );
+    }
+    if ( !weather_data->today.valide ) {
+        return;
+    }
+    bool stale = dataprovider_is_stale( weather_provider, WEATHER_CACHE_MAX_AGE );
+    if ( stale != weather_widget_stale ) {
+        weather_widget_set_stale( stale );
+    }
+}
+
+/*
+ * dim the widget labels while the shown weather is outdated
+ */
+static void weather_widget_set_stale( bool stale ) {
+    weather_widget_stale = stale;
+    lv_obj_set_style_local_text_opa( weather_widget_temperature_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, stale ? LV_OPA_50 : LV_OPA_COVER );
+    lv_obj_set_style_local_text_opa( weather_widget_wind_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, stale ? LV_OPA_50 : LV_OPA_COVER );
+    lv_obj_invalidate( weather_widget_cont );
+}
+
+static void weather_widget_update( void ) {
+    weather_forcast_t *weather_today = &weather_data->today;
+
+    lv_label_set_text( weather_widget_temperature_label, weather_today->temp );
+    lv_imgbtn_set_src( weather_widget_condition_img, LV_BTN_STATE_RELEASED, resolve_owm_icon( weather_today->icon ) );
+    lv_imgbtn_set_src( weather_widget_condition_img, LV_BTN_STATE_PRESSED, resolve_owm_icon( weather_today->icon ) );
+    lv_imgbtn_set_src( weather_widget_condition_img, LV_BTN_STATE_CHECKED_RELEASED, resolve_owm_icon( weather_today->icon ) );
+    lv_imgbtn_set_src( weather_widget_condition_img, LV_BTN_STATE_CHECKED_PRESSED, resolve_owm_icon( weather_today->icon ) );
+
+    if ( weather_config.showWind ) {
+        lv_label_set_text( weather_widget_wind_label, weather_today->wind );
+        lv_obj_align( weather_widget_temperature_label, weather_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, -22);
+        lv_obj_align( weather_widget_wind_label, weather_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
+    }
+    else {
+        lv_label_set_text( weather_widget_wind_label, "" );
+        lv_obj_align( weather_widget_temperature_label, weather_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
+        lv_obj_align( weather_widget_wind_label, weather_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
+    }
+}
+
 void weather_widget_wifictl_event_cb( EventBits_t event, char* msg ) {
     log_i("weather widget wifictl event: %04x", event );
 
     switch( event ) {
-        case WIFICTL_CONNECT:       if ( weather_config.autosync ) {
-                                        weather_widget_sync_request();
+        case WIFICTL_CONNECT:       if ( !weather_config.autosync ) {
+                                        break;
                                     }
+                                    if ( weather_phone_is_fresh() ) {
+                                        // only count the fetches the ttl would not skip
+                                        if ( dataprovider_is_stale( weather_provider, WEATHER_TTL ) ) {
+                                            weather_count_today( true );
+                                        }
+                                        log_i("weather from the phone is fresh, skip fetch, %ds radio time saved today", weather_get_radio_saved_today() / 1000 );
+                                        break;
+                                    }
+                                    weather_sync_request( false );
                                     break;
         case WIFICTL_OFF:           lv_obj_set_hidden( weather_widget_info_img, true );
                                     break;
@@ -156,69 +348,28 @@ void weather_jump_to_setup( void ) {
     mainbar_jump_to_tilenumber( weather_app_setup_tile_num, LV_ANIM_ON );    
 }
 
-void weather_widget_sync_request( void ) {
-    if ( xEventGroupGetBits( weather_widget_event_handle ) & WEATHER_WIDGET_SYNC_REQUEST ) {
-        return;
-    }
-    else {
-        xEventGroupSetBits( weather_widget_event_handle, WEATHER_WIDGET_SYNC_REQUEST );
-        lv_obj_set_hidden( weather_widget_info_img, true );
-        xTaskCreate(    weather_widget_sync_Task,       /* Function to implement the task */
-                        "weather widget sync Task",     /* Name of the task */
-                        5000,                           /* Stack size in words */
-                        NULL,                           /* Task input parameter */
-                        1,                              /* Priority of the task */
-                        &_weather_widget_sync_Task );   /* Task handle. */
-    }
-}
+void weather_sync_request( bool force ) {
+    char key[ DATACACHE_KEY_SIZE ];
 
-weather_config_t *weather_get_config( void ) {
-    return( &weather_config );
+    weather_get_cache_key( key, sizeof( key ) );
+    dataprovider_request( weather_provider, key, force );
 }
 
-void weather_widget_sync_Task( void * pvParameters ) {
-    log_i("start weather widget task, heap: %d", ESP.getFreeHeap() );
-
-    vTaskDelay( 250 );
-
-    if ( xEventGroupGetBits( weather_widget_event_handle ) & WEATHER_WIDGET_SYNC_REQUEST ) {       
-        uint32_t retval = weather_fetch_today( &weather_config, &weather_today );
-        if ( retval == 200 ) {
-            lv_label_set_text( weather_widget_temperature_label, weather_today.temp );
-            lv_imgbtn_set_src( weather_widget_condition_img, LV_BTN_STATE_RELEASED, resolve_owm_icon( weather_today.icon ) );
-            lv_imgbtn_set_src( weather_widget_condition_img, LV_BTN_STATE_PRESSED, resolve_owm_icon( weather_today.icon ) );
-            lv_imgbtn_set_src( weather_widget_condition_img, LV_BTN_STATE_CHECKED_RELEASED, resolve_owm_icon( weather_today.icon ) );
-            lv_imgbtn_set_src( weather_widget_condition_img, LV_BTN_STATE_CHECKED_PRESSED, resolve_owm_icon( weather_today.icon ) );
-
-            if ( weather_config.showWind ) {
-                lv_label_set_text( weather_widget_wind_label, weather_today.wind );
-                lv_obj_align( weather_widget_temperature_label, weather_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, -22);
-                lv_obj_align( weather_widget_wind_label, weather_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
-            }
-            else {
-                lv_label_set_text( weather_widget_wind_label, "" );
-                lv_obj_align( weather_widget_temperature_label, weather_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
-                lv_obj_align( weather_widget_wind_label, weather_widget_cont, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
-            }
+dataprovider_t *weather_get_provider( void ) {
+    return( weather_provider );
+}
 
-            lv_img_set_src( weather_widget_info_img, &info_ok_16px );
-            lv_obj_set_hidden( weather_widget_info_img, false );
-        }
-        else {
-            lv_img_set_src( weather_widget_info_img, &info_fail_16px );
-            lv_obj_set_hidden( weather_widget_info_img, false );
-        }
-        lv_obj_invalidate( lv_scr_act() );
-    }
-    xEventGroupClearBits( weather_widget_event_handle, WEATHER_WIDGET_SYNC_REQUEST );
-    log_i("finish weather widget task, heap: %d", ESP.getFreeHeap() );
-    vTaskDelete( NULL );
+weather_config_t *weather_get_config( void ) {
+    return( &weather_config );
 }
 
 /*
  *
  */
 void weather_save_config( void ) {
+    if ( configapi_defer_save( weather_save_config ) ) {
+        return;
+    }
     if ( SPIFFS.exists( WEATHER_CONFIG_FILE ) ) {
         SPIFFS.remove( WEATHER_CONFIG_FILE );
         log_i("remove old binary weather config");
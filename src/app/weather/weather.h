@@ -24,10 +24,21 @@
 
     #include <TTGO.h>
 
+    #include "weather_forecast.h"
+    #include "hardware/dataprovider.h"
+
     #define WEATHER_CONFIG_FILE             "/weather.cfg"
     #define WEATHER_JSON_CONFIG_FILE        "/weather.json"
+    #define WEATHER_CACHE_FILE              "/weather.cache"
+    #define WEATHER_CACHE_VERSION           4
+    #define WEATHER_CACHE_MAX_AGE           ( 2 * 60 * 60 )     /** @brief age in seconds after cached weather data is shown as stale */
+    #define WEATHER_TTL                     ( 10 * 60 )         /** @brief age in seconds after weather data is fetched again on connect */
+    #define WEATHER_STALE_CHECK_INTERVAL    1000                /** @brief interval in ms to check the age of the shown data */
+    #define WEATHER_PHONE_TTL               WEATHER_CACHE_MAX_AGE   /** @brief age in seconds weather from the phone makes a wifi fetch needless */
+    #define WEATHER_FETCH_ESTIMATE          2000                /** @brief ms radio time of a fetch until one is measured */
 
-    #define WEATHER_WIDGET_SYNC_REQUEST    _BV(0)
+    #define WEATHER_SOURCE_OWM              0                   /** @brief fetched from openweathermap over wifi */
+    #define WEATHER_SOURCE_PHONE            1                   /** @brief pushed by Gadgetbridge over ble */
 
     typedef struct {
         char version = 2;
@@ -42,7 +53,7 @@
     typedef struct {
         bool valide = false;
         time_t timestamp = 0;
-        char temp[8] = "";
+        char temp[12] = "";                             /** @brief like "-12.3°C", ° takes two bytes */
         char pressure[8] = "";
         char humidity[8] = "";
         char name[32] = "";
@@ -50,6 +61,28 @@
         char wind[8] = "";
     } weather_forcast_t;
 
+    /*
+     * @brief all data of one fetch, shared by widget and forecast tile
+     */
+    typedef struct {
+        uint8_t source;                                 /** @brief WEATHER_SOURCE_OWM or WEATHER_SOURCE_PHONE */
+        weather_forcast_t today;
+        weather_forecast_data_t forecast;
+    } weather_data_t;
+
+    /*
+     * @brief current weather as Gadgetbridge sends it, GB({"t":"weather",...}), in metric units
+     */
+    typedef struct {
+        time_t timestamp;                               /** @brief time of arrival */
+        int16_t temp;                                   /** @brief temperature in 0.1°C */
+        uint8_t humidity;                               /** @brief humidity in % */
+        uint16_t code;                                  /** @brief owm condition code like 800 */
+        uint16_t wind_speed;                            /** @brief wind speed in 0.1m/s */
+        uint16_t wind_deg;                              /** @brief wind direction in degree */
+        char name[32];                                  /** @brief location */
+    } weather_phone_t;
+
     void weather_app_setup( void );
 
     void weather_tile_setup( lv_obj_t *tile, lv_style_t *style, lv_coord_t hres, lv_coord_t vres );
@@ -60,7 +93,38 @@
 
     void weather_jump_to_setup( void );
 
-    void weather_widget_sync_request( void );
+    /*
+     * @brief request a weather sync, widget and forecast tile are updated by the weather provider
+     *
+     * @param   force   fetch even if the data is fresh
+     */
+    void weather_sync_request( bool force );
+    /*
+     * @brief take the weather pushed by the phone, can be called from any task. it is
+     * shown with the next stale check and makes the wifi fetch needless for WEATHER_PHONE_TTL
+     *
+     * @param   phone   pointer to the weather from the phone
+     */
+    void weather_push_from_phone( weather_phone_t *phone );
+    /*
+     * @brief get the wifi radio time that was not needed today thanks to the phone
+     *
+     * @return  ms, skipped fetches times the average fetch time
+     */
+    uint32_t weather_get_radio_saved_today( void );
+    /*
+     * @brief get the weather provider, subscribe to get notified on new data
+     *
+     * @return  pointer to the weather provider
+     */
+    dataprovider_t *weather_get_provider( void );
+    /*
+     * @brief get the key for the weather cache, it change when location or units change
+     *
+     * @param   key     buffer for the key
+     * @param   size    size of the buffer
+     */
+    void weather_get_cache_key( char *key, size_t size );
 
     void weather_save_config( void );
 
@@ -20,116 +20,296 @@
  *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
 #include "config.h"
-#include "HTTPClient.h"
 
 #include "weather.h"
 #include "weather_fetch.h"
 #include "weather_forecast.h"
 
 #include "hardware/powermgm.h"
-#include "hardware/json_psram_allocator.h"
+#include "hardware/httpctl.h"
+#include "hardware/datacache.h"
+#include "hardware/json_extract.h"
 
-/* Utility function to convert numbers to directions */
-static void weather_wind_to_string( weather_forcast_t* container, int speed, int directionDegree);
+/*
+ * raw values from the owm api, only this fields are extracted from the stream
+ */
+typedef struct {
+    int32_t timestamp;
+    float temp;
+    float humidity;
+    float pressure;
+    float wind_speed;
+    int32_t wind_deg;
+    float rain;
+    float snow;
+    char icon[8];
+} weather_fetch_entry_t;
 
-int weather_fetch_today( weather_config_t *weather_config, weather_forcast_t *weather_today ) {
-    char url[512]="";
-    int httpcode = -1;
-    const char* weather_units_symbol = weather_config->imperial ? "F" : "C";
-    const char* weather_units_char = weather_config->imperial ? "imperial" : "metric";
-    
-    snprintf( url, sizeof( url ), "http://%s/data/2.5/weather?lat=%s&lon=%s&appid=%s&units=%s", OWM_HOST, weather_config->lat, weather_config->lon, weather_config->apikey, weather_units_char);
+typedef struct {
+    char name[32];
+    weather_fetch_entry_t today;
+} weather_fetch_today_t;
+
+typedef struct {
+    char name[32];
+    weather_fetch_entry_t list[ WEATHER_MAX_FORECAST ];
+} weather_fetch_forecast_t;
+
+static const json_extract_field_t weather_today_fields[] = {
+    JSON_EXTRACT_FIELD( "name",              JSON_EXTRACT_STRING, weather_fetch_today_t, name ),
+    JSON_EXTRACT_FIELD( "dt",                JSON_EXTRACT_INT,    weather_fetch_today_t, today.timestamp ),
+    JSON_EXTRACT_FIELD( "main.temp",         JSON_EXTRACT_FLOAT,  weather_fetch_today_t, today.temp ),
+    JSON_EXTRACT_FIELD( "main.humidity",     JSON_EXTRACT_FLOAT,  weather_fetch_today_t, today.humidity ),
+    JSON_EXTRACT_FIELD( "main.pressure",     JSON_EXTRACT_FLOAT,  weather_fetch_today_t, today.pressure ),
+    JSON_EXTRACT_FIELD( "weather[0].icon",   JSON_EXTRACT_STRING, weather_fetch_today_t, today.icon ),
+    JSON_EXTRACT_FIELD( "wind.speed",        JSON_EXTRACT_FLOAT,  weather_fetch_today_t, today.wind_speed ),
+    JSON_EXTRACT_FIELD( "wind.deg",          JSON_EXTRACT_INT,    weather_fetch_today_t, today.wind_deg )
+};
+
+static const json_extract_field_t weather_forecast_fields[] = {
+    JSON_EXTRACT_FIELD( "city.name",                     JSON_EXTRACT_STRING, weather_fetch_forecast_t, name ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].dt",               JSON_EXTRACT_INT,    weather_fetch_forecast_t, list, timestamp ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].main.temp",        JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, temp ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].main.humidity",    JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, humidity ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].main.pressure",    JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, pressure ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].weather[0].icon",  JSON_EXTRACT_STRING, weather_fetch_forecast_t, list, icon ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].wind.speed",       JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, wind_speed ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].wind.deg",         JSON_EXTRACT_INT,    weather_fetch_forecast_t, list, wind_deg ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].rain.3h",          JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, rain ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].snow.3h",          JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, snow )
+};
 
-    HTTPClient today_client;
+/*
+ * the provider cache holds the validators of the weather request, the forecast
+ * request has its own. they are not stored, after a restart the first fetch is complete
+ */
+static datacache_t weather_forecast_cache;
+
+static int weather_fetch_today( httpctl_con_t *today_con, httpctl_response_t *response, weather_config_t *weather_config, weather_data_t *weather_data, datacache_t *cache );
+static int weather_fetch_forecast( httpctl_con_t *forecast_con, httpctl_response_t *response, weather_data_t *weather_data, datacache_t *cache );
 
-    today_client.useHTTP10( true );
-    today_client.begin( url );
-    httpcode = today_client.GET();
+int weather_fetch( weather_config_t *weather_config, weather_data_t *weather_data, datacache_t *cache ) {
+    char today_path[ 256 ]="";
+    char forecast_path[ 256 ]="";
+    char today_headers[ 160 ]="";
+    char forecast_headers[ 160 ]="";
+    httpctl_response_t response;
 
-    if ( httpcode != 200 ) {
-        log_e("HTTPClient error %d", httpcode, url );
-        today_client.end();
+    // a changed location or unit clears the validators of the forecast too
+    datacache_set_key( &weather_forecast_cache, cache->key );
+
+    /*
+     * always in metric units, the weather is converted to the configured units
+     * below and the forecast when shown
+     */
+    snprintf( today_path, sizeof( today_path ), "/data/2.5/weather?lat=%s&lon=%s&appid=%s&units=metric", weather_config->lat, weather_config->lon, weather_config->apikey );
+    snprintf( forecast_path, sizeof( forecast_path ), "/data/2.5/forecast?cnt=%d&lat=%s&lon=%s&appid=%s&units=metric", WEATHER_MAX_FORECAST, weather_config->lat, weather_config->lon, weather_config->apikey );
+    const char *path[] = { today_path, forecast_path };
+    const char *headers[] = { datacache_get_conditional_headers( cache, today_headers, sizeof( today_headers ) ),
+                              datacache_get_conditional_headers( &weather_forecast_cache, forecast_headers, sizeof( forecast_headers ) ) };
+
+    /*
+     * both requests go out at once on one connection, the forecast response follows the weather
+     */
+    httpctl_con_t *con = httpctl_get_pipelined( OWM_HOST, 80, 2, path, headers, &response );
+    int today = weather_fetch_today( con, &response, weather_config, weather_data, cache );
+    if ( today < 0 ) {
+        httpctl_close( con );
+        return( -1 );
+    }
+    // a server that closed the connection after the weather lost the forecast request, ask again
+    if ( httpctl_receive( con, &response ) < 0 ) {
+        log_i("pipelined forecast request lost, send it again");
+        httpctl_close( con );
+        con = httpctl_get_pipelined( OWM_HOST, 80, 1, &path[ 1 ], &headers[ 1 ], &response );
+    }
+    int forecast = weather_fetch_forecast( con, &response, weather_data, &weather_forecast_cache );
+    httpctl_close( con );
+    if ( forecast < 0 ) {
         return( -1 );
     }
+    return( today == 200 || forecast == 200 ? 200 : 304 );
+}
+
+/*
+ * the connection stays open for the next response, it is closed by the caller
+ */
+static int weather_fetch_today( httpctl_con_t *today_con, httpctl_response_t *response, weather_config_t *weather_config, weather_data_t *weather_data, datacache_t *cache ) {
+    int httpcode = -1;
+    weather_fetch_today_t today;
+
+    if ( today_con != NULL && response->httpcode == 304 ) {
+        datacache_update( cache, response );
+        return( response->httpcode );
+    }
 
-    SpiRamJsonDocument doc( today_client.getSize() * 2 );
+    if ( today_con == NULL || response->httpcode != 200 ) {
+        log_e("http error %d", response->httpcode );
+        return( -1 );
+    }
+    httpcode = response->httpcode;
 
-    DeserializationError error = deserializeJson( doc, today_client.getStream() );
-    if (error) {
-        log_e("weather today deserializeJson() failed: %s", error.c_str() );
-        doc.clear();
-        today_client.end();
+    memset( &today, 0, sizeof( today ) );
+    if ( json_extract( *httpctl_get_stream( today_con ), weather_today_fields, sizeof( weather_today_fields ) / sizeof( json_extract_field_t ), &today ) < 0 ) {
+        log_e("weather today json_extract() failed");
         return( -1 );
     }
 
-    today_client.end();
+    datacache_update( cache, response );
 
-    weather_today->valide = true;
-    snprintf( weather_today->temp, sizeof( weather_today->temp ), "%0.1f°%s", doc["main"]["temp"].as<float>(), weather_units_symbol);
-    snprintf( weather_today->humidity, sizeof( weather_today->humidity ),"%f%%", doc["main"]["humidity"].as<float>() );
-    snprintf( weather_today->pressure, sizeof( weather_today->pressure ),"%fpha", doc["main"]["pressure"].as<float>() );
-    strcpy( weather_today->icon, doc["weather"][0]["icon"] );
-    strcpy( weather_today->name, doc["name"] );
+    /*
+     * current weather, formatted in the configured units
+     */
+    weather_forcast_t *weather_today = &weather_data->today;
+    float temp = weather_config->imperial ? today.today.temp * 9 / 5 + 32 : today.today.temp;
+    float wind_speed = weather_config->imperial ? today.today.wind_speed * 2.237 : today.today.wind_speed;
 
-    int directionDegree = doc["wind"]["deg"].as<int>();
-    int speed = doc["wind"]["speed"].as<int>();
-    weather_wind_to_string( weather_today, speed, directionDegree );
+    weather_data->source = WEATHER_SOURCE_OWM;
+    weather_today->valide = true;
+    weather_today->timestamp = today.today.timestamp;
+    snprintf( weather_today->temp, sizeof( weather_today->temp ), "%0.1f°%s", temp, weather_config->imperial ? "F" : "C" );
+    snprintf( weather_today->humidity, sizeof( weather_today->humidity ),"%f%%", today.today.humidity );
+    snprintf( weather_today->pressure, sizeof( weather_today->pressure ),"%fpha", today.today.pressure );
+    strlcpy( weather_today->icon, today.today.icon, sizeof( weather_today->icon ) );
+    strlcpy( weather_today->name, today.name, sizeof( weather_today->name ) );
+    weather_wind_to_string( weather_today->wind, sizeof( weather_today->wind ), (int)wind_speed, today.today.wind_deg );
 
-    doc.clear();
     return( httpcode );
 }
 
-int weather_fetch_forecast( weather_config_t *weather_config, weather_forcast_t * weather_forecast ) {
-    char url[512]="";
+/*
+ * the connection is closed by the caller
+ */
+static int weather_fetch_forecast( httpctl_con_t *forecast_con, httpctl_response_t *response, weather_data_t *weather_data, datacache_t *cache ) {
     int httpcode = -1;
-    const char* weather_units_symbol = weather_config->imperial ? "F" : "C";
-    const char* weather_units_char = weather_config->imperial ? "imperial" : "metric";
 
-    snprintf( url, sizeof( url ), "http://%s/data/2.5/forecast?cnt=%d&lat=%s&lon=%s&appid=%s&units=%s", OWM_HOST, WEATHER_MAX_FORECAST, weather_config->lat, weather_config->lon, weather_config->apikey, weather_units_char);
-
-    HTTPClient forecast_client;
-
-    forecast_client.useHTTP10( true );
-    forecast_client.begin( url );
-    httpcode = forecast_client.GET();
+    if ( forecast_con != NULL && response->httpcode == 304 ) {
+        datacache_update( cache, response );
+        return( response->httpcode );
+    }
 
-    if ( httpcode != 200 ) {
-        log_e("HTTPClient error %d", httpcode, url );
-        forecast_client.end();
+    if ( forecast_con == NULL || response->httpcode != 200 ) {
+        log_e("http error %d", response->httpcode );
         return( -1 );
     }
+    httpcode = response->httpcode;
 
-    SpiRamJsonDocument doc( forecast_client.getSize() * 2 );
+    weather_fetch_forecast_t *forecast = (weather_fetch_forecast_t*)ps_calloc( sizeof( weather_fetch_forecast_t ), 1 );
+    if ( forecast == NULL ) {
+        log_e("weather_fetch_forecast_t alloc failed");
+        while(true);
+    }
+    strlcpy( forecast->name, "n/a", sizeof( forecast->name ) );
+    for ( int i = 0 ; i < WEATHER_MAX_FORECAST ; i++ ) {
+        strlcpy( forecast->list[ i ].icon, "n/a", sizeof( forecast->list[ i ].icon ) );
+    }
 
-    DeserializationError error = deserializeJson( doc, forecast_client.getStream() );
-    if (error) {
-        log_e("weather forecast deserializeJson() failed: %s", error.c_str() );
-        doc.clear();
-        forecast_client.end();
+    if ( json_extract( *httpctl_get_stream( forecast_con ), weather_forecast_fields, sizeof( weather_forecast_fields ) / sizeof( json_extract_field_t ), forecast ) < 0 ) {
+        log_e("weather forecast json_extract() failed");
+        free( forecast );
         return( -1 );
     }
 
-    forecast_client.end();
+    datacache_update( cache, response );
 
-    weather_forecast[0].valide = true;
+    weather_forecast_data_t *weather_forecast = &weather_data->forecast;
+
+    strlcpy( weather_forecast->name, forecast->name, sizeof( weather_forecast->name ) );
+    weather_forecast->count = 0;
     for ( int i = 0 ; i < WEATHER_MAX_FORECAST ; i++ ) {
-        weather_forecast[ i ].timestamp = doc["list"][i]["dt"].as<long>() | 0;
-        snprintf( weather_forecast[ i ].temp, sizeof( weather_forecast[ i ].temp ),"%0.1f°%s", doc["list"][i]["main"]["temp"].as<float>(), weather_units_symbol );
-        snprintf( weather_forecast[ i ].humidity, sizeof( weather_forecast[ i ].humidity ),"%f%%", doc["list"][i]["main"]["humidity"].as<float>() );
-        snprintf( weather_forecast[ i ].pressure, sizeof( weather_forecast[ i ].pressure ),"%fpha", doc["list"][i]["main"]["pressure"].as<float>() );
-        strlcpy( weather_forecast[ i ].icon, doc["list"][i]["weather"][0]["icon"] | "n/a", sizeof(  weather_forecast[ i ].icon ) );
-        strlcpy( weather_forecast[ i ].name, doc["city"]["name"] | "n/a", sizeof( weather_forecast[ i ].name ) );
-
-        int directionDegree = doc["list"][i]["wind"]["deg"].as<int>() | 0;
-        int speed = doc["list"][i]["wind"]["speed"].as<int>() | 0;
-        weather_wind_to_string( &weather_forecast[i], speed, directionDegree );
+        weather_fetch_entry_t *entry = &forecast->list[ i ];
+
+        if ( entry->timestamp != 0 ) {
+            weather_forecast->count = i + 1;
+        }
+        weather_forecast->timestamp[ i ] = entry->timestamp;
+        weather_forecast->temp[ i ] = lroundf( entry->temp * 10 );
+        weather_forecast->humidity[ i ] = lroundf( entry->humidity );
+        weather_forecast->pressure[ i ] = lroundf( entry->pressure );
+        weather_forecast->wind_speed[ i ] = lroundf( entry->wind_speed * 10 );
+        weather_forecast->wind_deg[ i ] = entry->wind_deg;
+        weather_forecast->precipitation[ i ] = lroundf( ( entry->rain + entry->snow ) * 10 );
+        strlcpy( weather_forecast->icon[ i ], entry->icon, sizeof( weather_forecast->icon[ i ] ) );
     }
+    weather_forecast->valide = true;
 
-    doc.clear();
+    free( forecast );
     return( httpcode );
 }
 
-void weather_wind_to_string( weather_forcast_t* container, int speed, int directionDegree )
+void weather_from_phone( weather_config_t *weather_config, weather_phone_t *phone, weather_data_t *weather_data ) {
+    weather_forcast_t *weather_today = &weather_data->today;
+    weather_forecast_data_t *weather_forecast = &weather_data->forecast;
+    int temp = weather_config->imperial ? phone->temp * 9 / 5 + 320 : phone->temp;
+    int wind_speed = weather_config->imperial ? phone->wind_speed * 2237 / 1000 : phone->wind_speed;
+    struct tm info;
+
+    localtime_r( &phone->timestamp, &info );
+
+    weather_data->source = WEATHER_SOURCE_PHONE;
+    weather_today->valide = true;
+    weather_today->timestamp = phone->timestamp;
+    snprintf( weather_today->temp, sizeof( weather_today->temp ), "%s%d.%d°%s", temp < 0 ? "-" : "", abs( temp ) / 10, abs( temp ) % 10, weather_config->imperial ? "F" : "C" );
+    snprintf( weather_today->humidity, sizeof( weather_today->humidity ), "%d%%", phone->humidity );
+    strlcpy( weather_today->pressure, "", sizeof( weather_today->pressure ) );
+    // no sunrise from the phone, the day icon from 6 to 20 o'clock
+    weather_code_to_icon( weather_today->icon, sizeof( weather_today->icon ), phone->code, info.tm_hour >= 6 && info.tm_hour < 20 );
+    strlcpy( weather_today->name, phone->name, sizeof( weather_today->name ) );
+    weather_wind_to_string( weather_today->wind, sizeof( weather_today->wind ), wind_speed / 10, phone->wind_deg );
+
+    /*
+     * keep the forecast of the last fetch from the entry that is not over
+     */
+    int past = 0;
+    while( past < weather_forecast->count && weather_forecast->timestamp[ past ] + 3 * 60 * 60 <= phone->timestamp ) {
+        past++;
+    }
+    if ( past ) {
+        for ( int i = 0 ; i + past < weather_forecast->count ; i++ ) {
+            weather_forecast->timestamp[ i ] = weather_forecast->timestamp[ i + past ];
+            weather_forecast->temp[ i ] = weather_forecast->temp[ i + past ];
+            weather_forecast->humidity[ i ] = weather_forecast->humidity[ i + past ];
+            weather_forecast->pressure[ i ] = weather_forecast->pressure[ i + past ];
+            weather_forecast->wind_speed[ i ] = weather_forecast->wind_speed[ i + past ];
+            weather_forecast->wind_deg[ i ] = weather_forecast->wind_deg[ i + past ];
+            weather_forecast->precipitation[ i ] = weather_forecast->precipitation[ i + past ];
+            strlcpy( weather_forecast->icon[ i ], weather_forecast->icon[ i + past ], sizeof( weather_forecast->icon[ i ] ) );
+        }
+        weather_forecast->count -= past;
+    }
+    strlcpy( weather_forecast->name, phone->name, sizeof( weather_forecast->name ) );
+}
+
+/*
+ * https://openweathermap.org/weather-conditions
+ */
+void weather_code_to_icon( char *icon, size_t size, uint16_t code, bool day ) {
+    const char *number = "01";
+
+    if ( code >= 200 && code < 300 )
+        number = "11";
+    else if ( code >= 300 && code < 400 )
+        number = "09";
+    else if ( code == 511 )
+        number = "13";
+    else if ( code >= 500 && code < 520 )
+        number = "10";
+    else if ( code >= 520 && code < 600 )
+        number = "09";
+    else if ( code >= 600 && code < 700 )
+        number = "13";
+    else if ( code >= 700 && code < 800 )
+        number = "50";
+    else if ( code == 801 )
+        number = "02";
+    else if ( code == 802 )
+        number = "03";
+    else if ( code == 803 || code == 804 )
+        number = "04";
+    snprintf( icon, size, "%s%c", number, day ? 'd' : 'n' );
+}
+
+void weather_wind_to_string( char *wind, size_t size, int speed, int directionDegree )
 {
     const char *dir = "N";
     if ( directionDegree > 348 )
@@ -164,6 +344,6 @@ void weather_wind_to_string( weather_forcast_t* container, int speed, int direct
         dir = "NE";
     else if ( directionDegree > 11 )
         dir = "NNE";
-    snprintf( container->wind, sizeof(container->wind), "%d %s", speed, dir);
+    snprintf( wind, size, "%d %s", speed, dir);
     return;
 }
\ No newline at end of file
@@ -25,10 +25,43 @@
     #define OWM_HOST    "api.openweathermap.org"
     #define OWM_PORT    80
 
-    #define WEATHER_TODAY_BUFFER_SIZE       10000
-    #define WEATHER_FORECAST_BUFFER_SIZE    40000
+    #include "weather.h"
+    #include "weather_forecast.h"
+    #include "hardware/datacache.h"
 
-    int weather_fetch_today( weather_config_t * weather_config, weather_forcast_t * weather_today );
-    int weather_fetch_forecast( weather_config_t *weather_config, weather_forcast_t * weather_forecast );
+    /*
+     * @brief fetch current weather and forecast, each request is send conditional
+     * if the cache hold validators of it
+     *
+     * @return  200 if one of them has new data, 304 if both are unchanged or -1 if fail
+     */
+    int weather_fetch( weather_config_t *weather_config, weather_data_t *weather_data, datacache_t *cache );
+    /*
+     * @brief take the weather from the phone into the weather data. the phone sends no
+     * forecast, so the entries of the last fetch that are over are dropped
+     *
+     * @param   weather_config  pointer to the config, for the units
+     * @param   phone           pointer to the weather from the phone
+     * @param   weather_data    pointer to the data to update
+     */
+    void weather_from_phone( weather_config_t *weather_config, weather_phone_t *phone, weather_data_t *weather_data );
+    /*
+     * @brief get the owm icon of an owm condition code
+     *
+     * @param   icon    buffer for the icon name like "01d"
+     * @param   size    size of the buffer
+     * @param   code    condition code like 800
+     * @param   day     true for the day icon
+     */
+    void weather_code_to_icon( char *icon, size_t size, uint16_t code, bool day );
+    /*
+     * @brief format wind speed and direction like "5 NNE"
+     *
+     * @param   wind            buffer for the string
+     * @param   size            size of the buffer
+     * @param   speed           wind speed
+     * @param   directionDegree wind direction in degree
+     */
+    void weather_wind_to_string( char *wind, size_t size, int speed, int directionDegree );
 
 #endif // _WEATHER_FETCH_H
\ No newline at end of file
@@ -33,10 +33,7 @@
 #include "gui/keyboard.h"
 
 #include "hardware/powermgm.h"
-#include "hardware/wifictl.h"
-
-EventGroupHandle_t weather_forecast_event_handle = NULL;
-TaskHandle_t _weather_forecast_sync_Task;
+#include "hardware/dataprovider.h"
 
 lv_obj_t *weather_forecast_tile = NULL;
 lv_style_t weather_forecast_style;
@@ -48,11 +45,25 @@ lv_obj_t *weather_forecast_time_label[ WEATHER_MAX_FORECAST ];
 lv_obj_t *weather_forecast_icon_imgbtn[ WEATHER_MAX_FORECAST ];
 lv_obj_t *weather_forecast_temperature_label[ WEATHER_MAX_FORECAST ];
 lv_obj_t *weather_forecast_wind_label[ WEATHER_MAX_FORECAST ];
-
-static weather_forcast_t *weather_forecast = NULL;
-
-void weather_forecast_sync_Task( void * pvParameters );
-void weather_forecast_wifictl_event_cb( EventBits_t event, char* msg );
+lv_obj_t *weather_forecast_temp_chart = NULL;
+lv_obj_t *weather_forecast_precipitation_chart = NULL;
+lv_chart_series_t *weather_forecast_temp_series = NULL;
+lv_chart_series_t *weather_forecast_precipitation_series = NULL;
+
+static weather_forecast_data_t *weather_forecast = NULL;
+lv_task_t *weather_forecast_stale_task = NULL;
+bool weather_forecast_stale = false;
+bool weather_forecast_tile_active = false;
+bool weather_forecast_dirty = false;
+
+static void weather_forecast_update( void );
+static void weather_forecast_refresh( void );
+static void weather_forecast_chart_refresh( void );
+static void weather_forecast_activate_cb( void );
+static void weather_forecast_hibernate_cb( void );
+static void weather_forecast_set_stale( bool stale );
+static void weather_forecast_stale_task_cb( lv_task_t *task );
+static void weather_forecast_provider_event_cb( EventBits_t event, void *data );
 
 LV_IMG_DECLARE(exit_32px);
 LV_IMG_DECLARE(setup_32px);
@@ -65,11 +76,7 @@ static void refresh_weather_widget_event_cb( lv_obj_t * obj, lv_event_t event );
 
 void weather_forecast_tile_setup( uint32_t tile_num ) {
 
-    weather_forecast = (weather_forcast_t*)ps_calloc( sizeof( weather_forcast_t ) * WEATHER_MAX_FORECAST , 1 );
-    if( !weather_forecast ) {
-      log_e("weather forecast calloc faild");
-      while(true);
-    }
+    weather_forecast = &( ( weather_data_t * )weather_get_provider()->data )->forecast;
 
     weather_forecast_tile_num = tile_num;
     weather_forecast_tile = mainbar_get_tile_obj( weather_forecast_tile_num );
@@ -142,20 +149,197 @@ void weather_forecast_tile_setup( uint32_t tile_num ) {
         lv_obj_align( weather_forecast_time_label[ i ], weather_forecast_icon_imgbtn[ i ], LV_ALIGN_OUT_TOP_MID, 0, 0);
     }
 
-    weather_forecast_event_handle = xEventGroupCreate();
+    /*
+     * precipitation columns with a transparent temperature line chart on top
+     */
+    weather_forecast_precipitation_chart = lv_chart_create( weather_forecast_tile, NULL );
+    lv_obj_set_size( weather_forecast_precipitation_chart, WEATHER_FORECAST_CHART_WIDTH, WEATHER_FORECAST_CHART_HEIGHT );
+    lv_obj_align( weather_forecast_precipitation_chart, weather_forecast_tile, LV_ALIGN_IN_BOTTOM_MID, 0, -10 );
+    lv_obj_set_style_local_bg_opa( weather_forecast_precipitation_chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, LV_OPA_TRANSP );
+    lv_obj_set_style_local_border_width( weather_forecast_precipitation_chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 0 );
+    lv_obj_set_style_local_pad_all( weather_forecast_precipitation_chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 0 );
+    lv_chart_set_type( weather_forecast_precipitation_chart, LV_CHART_TYPE_COLUMN );
+    lv_chart_set_div_line_count( weather_forecast_precipitation_chart, 0, 0 );
+    lv_chart_set_point_count( weather_forecast_precipitation_chart, WEATHER_MAX_FORECAST );
+    lv_chart_set_range( weather_forecast_precipitation_chart, 0, WEATHER_FORECAST_CHART_MIN_PRECIPITATION );
+    weather_forecast_precipitation_series = lv_chart_add_series( weather_forecast_precipitation_chart, LV_COLOR_BLUE );
+    lv_chart_init_points( weather_forecast_precipitation_chart, weather_forecast_precipitation_series, LV_CHART_POINT_DEF );
+
+    weather_forecast_temp_chart = lv_chart_create( weather_forecast_tile, NULL );
+    lv_obj_set_size( weather_forecast_temp_chart, WEATHER_FORECAST_CHART_WIDTH, WEATHER_FORECAST_CHART_HEIGHT );
+    lv_obj_align( weather_forecast_temp_chart, weather_forecast_tile, LV_ALIGN_IN_BOTTOM_MID, 0, -10 );
+    lv_obj_set_style_local_bg_opa( weather_forecast_temp_chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, LV_OPA_TRANSP );
+    lv_obj_set_style_local_border_width( weather_forecast_temp_chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 0 );
+    lv_obj_set_style_local_pad_all( weather_forecast_temp_chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 0 );
+    lv_obj_set_style_local_line_width( weather_forecast_temp_chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 2 );
+    lv_obj_set_style_local_size( weather_forecast_temp_chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 0 );
+    lv_chart_set_type( weather_forecast_temp_chart, LV_CHART_TYPE_LINE );
+    lv_chart_set_div_line_count( weather_forecast_temp_chart, 0, 0 );
+    lv_chart_set_point_count( weather_forecast_temp_chart, WEATHER_MAX_FORECAST );
+    weather_forecast_temp_series = lv_chart_add_series( weather_forecast_temp_chart, LV_COLOR_RED );
+    lv_chart_init_points( weather_forecast_temp_chart, weather_forecast_temp_series, LV_CHART_POINT_DEF );
+
+    mainbar_add_tile_activate_cb( weather_forecast_tile_num, weather_forecast_activate_cb );
+    mainbar_add_tile_hibernate_cb( weather_forecast_tile_num, weather_forecast_hibernate_cb );
+
+    // the forecast is fetched together with the current weather by the weather provider
+    dataprovider_register_cb( weather_get_provider(), DATAPROVIDER_UPDATE | DATAPROVIDER_DONE, weather_forecast_provider_event_cb );
+    weather_forecast_stale_task = lv_task_create( weather_forecast_stale_task_cb, WEATHER_STALE_CHECK_INTERVAL, LV_TASK_PRIO_LOWEST, NULL );
+}
 
-    wifictl_register_cb( WIFICTL_OFF | WIFICTL_CONNECT, weather_forecast_wifictl_event_cb );
+static void weather_forecast_provider_event_cb( EventBits_t event, void *data ) {
+    weather_forecast_update();
+    weather_forecast_set_stale( dataprovider_is_stale( weather_get_provider(), WEATHER_CACHE_MAX_AGE ) );
 }
 
-void weather_forecast_wifictl_event_cb( EventBits_t event, char* msg ) {
-    log_i("weather forecast wifictl event: %04x", event );
-    
-    switch( event ) {
-        case WIFICTL_CONNECT:       weather_config_t *tmp_weather_config = weather_get_config();
-                                    if ( tmp_weather_config->autosync ) {
-                                        weather_forecast_sync_request();
-                                    }
-                                    break;
+static void weather_forecast_stale_task_cb( lv_task_t *task ) {
+    if ( !weather_forecast->valide ) {
+        return;
+    }
+    bool stale = dataprovider_is_stale( weather_get_provider(), WEATHER_CACHE_MAX_AGE );
+    if ( stale != weather_forecast_stale ) {
+        weather_forecast_set_stale( stale );
+    }
+}
+
+/*
+ * dim the forecast while it is outdated
+ */
+static void weather_forecast_set_stale( bool stale ) {
+    weather_forecast_stale = stale;
+    lv_obj_set_style_local_text_opa( weather_forecast_update_label, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, stale ? LV_OPA_50 : LV_OPA_COVER );
+    for( int i = 0 ; i < WEATHER_MAX_FORECAST / 4 ; i++ ) {
+        lv_obj_set_style_local_text_opa( weather_forecast_temperature_label[ i ], LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, stale ? LV_OPA_50 : LV_OPA_COVER );
+        lv_obj_set_style_local_text_opa( weather_forecast_wind_label[ i ], LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, stale ? LV_OPA_50 : LV_OPA_COVER );
+    }
+    lv_obj_invalidate( weather_forecast_tile );
+}
+
+static void weather_forecast_activate_cb( void ) {
+    weather_forecast_tile_active = true;
+    if ( weather_forecast_dirty ) {
+        weather_forecast_refresh();
+    }
+}
+
+static void weather_forecast_hibernate_cb( void ) {
+    weather_forecast_tile_active = false;
+}
+
+/*
+ * new data arrived, labels and chart are only build when the tile is shown
+ */
+static void weather_forecast_update( void ) {
+    weather_forecast_dirty = true;
+    if ( weather_forecast_tile_active ) {
+        weather_forecast_refresh();
+    }
+}
+
+static void weather_forecast_refresh( void ) {
+    weather_config_t *weather_config = weather_get_config();
+    struct tm info;
+    char buf[64];
+
+    weather_forecast_dirty = false;
+
+    lv_label_set_text( weather_forecast_location_label, weather_forecast->name );
+
+    for( int i = 0 ; i < WEATHER_MAX_FORECAST / 4 ; i++ ) {
+        int entry = i * 2;
+        int16_t temp = weather_forecast->temp[ entry ];
+        int wind_speed = weather_forecast->wind_speed[ entry ];
+
+        // weather from the phone shortens the forecast of the last fetch
+        if ( entry >= weather_forecast->count ) {
+            lv_label_set_text( weather_forecast_temperature_label[ i ], "n/a" );
+            lv_label_set_text( weather_forecast_wind_label[ i ], "" );
+            lv_label_set_text( weather_forecast_time_label[ i ], "" );
+            continue;
+        }
+
+        if ( weather_config->imperial ) {
+            temp = temp * 9 / 5 + 320;
+            wind_speed = wind_speed * 2237 / 1000;
+        }
+
+        lv_imgbtn_set_src( weather_forecast_icon_imgbtn[ i ], LV_BTN_STATE_RELEASED, resolve_owm_icon( weather_forecast->icon[ entry ] ) );
+        lv_imgbtn_set_src( weather_forecast_icon_imgbtn[ i ], LV_BTN_STATE_PRESSED, resolve_owm_icon( weather_forecast->icon[ entry ] ) );
+        lv_imgbtn_set_src( weather_forecast_icon_imgbtn[ i ], LV_BTN_STATE_CHECKED_RELEASED, resolve_owm_icon( weather_forecast->icon[ entry ] ) );
+        lv_imgbtn_set_src( weather_forecast_icon_imgbtn[ i ], LV_BTN_STATE_CHECKED_PRESSED, resolve_owm_icon( weather_forecast->icon[ entry ] ) );
+
+        snprintf( buf, sizeof( buf ), "%s%d.%d°%s", temp < 0 ? "-" : "", abs( temp ) / 10, abs( temp ) % 10, weather_config->imperial ? "F" : "C" );
+        lv_label_set_text( weather_forecast_temperature_label[ i ], buf );
+
+        if(weather_config->showWind)
+        {
+            lv_obj_align(weather_forecast_temperature_label[i], weather_forecast_icon_imgbtn[i], LV_ALIGN_OUT_BOTTOM_MID, 0, -22);
+            weather_wind_to_string( buf, sizeof( buf ), wind_speed / 10, weather_forecast->wind_deg[ entry ] );
+            lv_label_set_text(weather_forecast_wind_label[i], buf);
+            lv_obj_align(weather_forecast_wind_label[i], weather_forecast_icon_imgbtn[i], LV_ALIGN_OUT_BOTTOM_MID, 0, 0);
+        }
+        else
+        {
+            lv_obj_align(weather_forecast_temperature_label[i], weather_forecast_icon_imgbtn[i], LV_ALIGN_OUT_BOTTOM_MID, 0, 0);
+            lv_label_set_text(weather_forecast_wind_label[i], "");
+        }
+
+        localtime_r( &weather_forecast->timestamp[ entry ], &info );
+        strftime( buf, sizeof(buf), "%H:%M", &info );
+        lv_label_set_text( weather_forecast_time_label[ i ], buf );
+        lv_obj_align( weather_forecast_time_label[ i ], weather_forecast_icon_imgbtn[ i ], LV_ALIGN_OUT_TOP_MID, 0, 0);
+    }
+
+    time_t timestamp = dataprovider_get_timestamp( weather_get_provider() );
+    localtime_r( &timestamp, &info );
+    strftime( buf, sizeof(buf), ( ( weather_data_t * )weather_get_provider()->data )->source == WEATHER_SOURCE_PHONE ? "phone: %d.%b %H:%M" : "updated: %d.%b %H:%M", &info );
+    lv_label_set_text( weather_forecast_update_label, buf );
+
+    weather_forecast_chart_refresh();
+    lv_obj_invalidate( lv_scr_act() );
+}
+
+/*
+ * only changed points are written, the charts are redrawn only on a change
+ */
+static void weather_forecast_chart_refresh( void ) {
+    bool imperial = weather_get_config()->imperial;
+    bool temp_changed = false;
+    bool precipitation_changed = false;
+    lv_coord_t temp_min = LV_COORD_MAX;
+    lv_coord_t temp_max = LV_COORD_MIN;
+    lv_coord_t precipitation_max = WEATHER_FORECAST_CHART_MIN_PRECIPITATION;
+
+    for ( int i = 0 ; i < WEATHER_MAX_FORECAST ; i++ ) {
+        lv_coord_t temp = LV_CHART_POINT_DEF;
+        lv_coord_t precipitation = LV_CHART_POINT_DEF;
+
+        if ( i < weather_forecast->count ) {
+            temp = imperial ? weather_forecast->temp[ i ] * 9 / 5 + 320 : weather_forecast->temp[ i ];
+            precipitation = weather_forecast->precipitation[ i ];
+            if ( temp < temp_min ) temp_min = temp;
+            if ( temp > temp_max ) temp_max = temp;
+            if ( precipitation > precipitation_max ) precipitation_max = precipitation;
+        }
+        if ( weather_forecast_temp_series->points[ i ] != temp ) {
+            weather_forecast_temp_series->points[ i ] = temp;
+            temp_changed = true;
+        }
+        if ( weather_forecast_precipitation_series->points[ i ] != precipitation ) {
+            weather_forecast_precipitation_series->points[ i ] = precipitation;
+            precipitation_changed = true;
+        }
+    }
+
+    if ( temp_changed ) {
+        if ( temp_min <= temp_max ) {
+            lv_chart_set_range( weather_forecast_temp_chart, temp_min - 10, temp_max + 10 );
+        }
+        lv_chart_refresh( weather_forecast_temp_chart );
+    }
+    if ( precipitation_changed ) {
+        lv_chart_set_range( weather_forecast_precipitation_chart, 0, precipitation_max );
+        lv_chart_refresh( weather_forecast_precipitation_chart );
     }
 }
 
@@ -175,80 +359,7 @@ static void setup_weather_widget_event_cb( lv_obj_t * obj, lv_event_t event ) {
 
 static void refresh_weather_widget_event_cb( lv_obj_t * obj, lv_event_t event ) {
     switch( event ) {
-        case( LV_EVENT_CLICKED ):       weather_forecast_sync_request();
-                                        weather_widget_sync_request();
+        case( LV_EVENT_CLICKED ):       weather_sync_request( true );
                                         break;
     }
 }
-
-void weather_forecast_sync_request( void ) {
-    if ( xEventGroupGetBits( weather_forecast_event_handle ) & WEATHER_FORECAST_SYNC_REQUEST ) {
-        return;
-    }
-    else {
-        xEventGroupSetBits( weather_forecast_event_handle, WEATHER_FORECAST_SYNC_REQUEST );
-        xTaskCreate(    weather_forecast_sync_Task,      /* Function to implement the task */
-                        "weather forecast sync Task",    /* Name of the task */
-                        5000,                            /* Stack size in words */
-                        NULL,                            /* Task input parameter */
-                        1,                               /* Priority of the task */
-                        &_weather_forecast_sync_Task );  /* Task handle. */ 
-    }
-}
-
-void weather_forecast_sync_Task( void * pvParameters ) {
-    weather_config_t *weather_config = weather_get_config();
-    int32_t retval = -1;
-
-    log_i("start weather forecast task, heap: %d", ESP.getFreeHeap() );
-
-    vTaskDelay( 250 );
-
-    if ( xEventGroupGetBits( weather_forecast_event_handle ) & WEATHER_FORECAST_SYNC_REQUEST ) {   
-        if ( weather_config->autosync ) {
-            retval = weather_fetch_forecast( weather_get_config() , &weather_forecast[ 0 ] );
-            if ( retval == 200 ) {
-                time_t now;
-                struct tm info;
-                char buf[64];
-
-                lv_label_set_text( weather_forecast_location_label, weather_forecast[ 0 ].name );
-
-                for( int i = 0 ; i < WEATHER_MAX_FORECAST / 4 ; i++ ) {
-                    lv_imgbtn_set_src( weather_forecast_icon_imgbtn[ i ], LV_BTN_STATE_RELEASED, resolve_owm_icon( weather_forecast[ i * 2 ].icon ) );
-                    lv_imgbtn_set_src( weather_forecast_icon_imgbtn[ i ], LV_BTN_STATE_PRESSED, resolve_owm_icon( weather_forecast[ i * 2 ].icon ) );
-                    lv_imgbtn_set_src( weather_forecast_icon_imgbtn[ i ], LV_BTN_STATE_CHECKED_RELEASED, resolve_owm_icon( weather_forecast[ i * 2 ].icon ) );
-                    lv_imgbtn_set_src( weather_forecast_icon_imgbtn[ i ], LV_BTN_STATE_CHECKED_PRESSED, resolve_owm_icon( weather_forecast[ i * 2 ].icon ) );
-
-                    lv_label_set_text( weather_forecast_temperature_label[ i ], weather_forecast[ i * 2 ].temp );
-
-                    if(weather_config->showWind)
-                    {
-                        lv_obj_align(weather_forecast_temperature_label[i], weather_forecast_icon_imgbtn[i], LV_ALIGN_OUT_BOTTOM_MID, 0, -22);
-                        lv_label_set_text(weather_forecast_wind_label[i], weather_forecast[i * 2].wind);
-                        lv_obj_align(weather_forecast_wind_label[i], weather_forecast_icon_imgbtn[i], LV_ALIGN_OUT_BOTTOM_MID, 0, 0);
-                    }
-                    else
-                    {
-                        lv_obj_align(weather_forecast_temperature_label[i], weather_forecast_icon_imgbtn[i], LV_ALIGN_OUT_BOTTOM_MID, 0, 0);
-                        lv_label_set_text(weather_forecast_wind_label[i], "");
-                    }
-
-                    localtime_r( &weather_forecast[ i * 2 ].timestamp, &info );
-                    strftime( buf, sizeof(buf), "%H:%M", &info );
-                    lv_label_set_text( weather_forecast_time_label[ i ], buf );
-                    lv_obj_align( weather_forecast_time_label[ i ], weather_forecast_icon_imgbtn[ i ], LV_ALIGN_OUT_TOP_MID, 0, 0);
-                }
-
-                time( &now );
-                localtime_r( &now, &info );
-                strftime( buf, sizeof(buf), "updated: %d.%b %H:%M", &info );
-                lv_label_set_text( weather_forecast_update_label, buf );
-                lv_obj_invalidate( lv_scr_act() );
-            }
-        }
-    }
-    xEventGroupClearBits( weather_forecast_event_handle, WEATHER_FORECAST_SYNC_REQUEST );
-    log_i("finsh weather forecast task, heap: %d", ESP.getFreeHeap() );
-    vTaskDelete( NULL );
-}
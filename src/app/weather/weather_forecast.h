@@ -3,10 +3,29 @@
 
     #include <TTGO.h>
 
-    #define WEATHER_FORECAST_SYNC_REQUEST   _BV(0)
     #define WEATHER_MAX_FORECAST            16
+    #define WEATHER_FORECAST_CHART_WIDTH    136
+    #define WEATHER_FORECAST_CHART_HEIGHT   48
+    #define WEATHER_FORECAST_CHART_MIN_PRECIPITATION    50  /** @brief min range of the precipitation chart in 0.1mm */
+
+    /*
+     * @brief forecast as struct of arrays with fixed-point values in metric units,
+     * labels are formatted when an entry is shown
+     */
+    typedef struct {
+        bool valide = false;
+        uint8_t count = 0;                                      /** @brief number of valid entries */
+        char name[32] = "";                                     /** @brief city name */
+        time_t timestamp[ WEATHER_MAX_FORECAST ];               /** @brief forecast time */
+        int16_t temp[ WEATHER_MAX_FORECAST ];                   /** @brief temperature in 0.1°C */
+        uint8_t humidity[ WEATHER_MAX_FORECAST ];               /** @brief humidity in % */
+        uint16_t pressure[ WEATHER_MAX_FORECAST ];              /** @brief pressure in hPa */
+        uint16_t wind_speed[ WEATHER_MAX_FORECAST ];            /** @brief wind speed in 0.1m/s */
+        uint16_t wind_deg[ WEATHER_MAX_FORECAST ];              /** @brief wind direction in degree */
+        uint16_t precipitation[ WEATHER_MAX_FORECAST ];         /** @brief rain and snow in 0.1mm per 3h */
+        char icon[ WEATHER_MAX_FORECAST ][ 4 ];                 /** @brief owm icon like "01d" */
+    } weather_forecast_data_t;
 
     void weather_forecast_tile_setup( uint32_t tile_num );
-    void weather_forecast_sync_request( void );
 
 #endif // _WEATHER_FORECAST_H
\ No newline at end of file
@@ -32,6 +32,7 @@
 
 #include "hardware/blectl.h"
 #include "hardware/motor.h"
+#include "hardware/configapi.h"
 #include "hardware/json_psram_allocator.h"
 
 lv_obj_t *weather_setup_tile = NULL;
@@ -54,6 +55,7 @@ static void exit_weather_widget_setup_event_cb( lv_obj_t * obj, lv_event_t event
 static void weather_autosync_onoff_event_handler( lv_obj_t * obj, lv_event_t event );
 static void weather_wind_onoff_event_handler( lv_obj_t *obj, lv_event_t event );
 static void weather_imperial_onoff_event_handler( lv_obj_t *obj, lv_event_t event );
+static void weather_setup_refresh( void );
 
 static void bluetooth_message_event_cb( EventBits_t event, char* msg );
 static void bluetooth_message_msg_pharse( char* msg );
@@ -196,6 +198,22 @@ void weather_setup_tile_setup( uint32_t tile_num ) {
     lv_label_set_text( weather_imperial_label, "Use Imperial");
     lv_obj_align( weather_imperial_label, weather_imperial_cont, LV_ALIGN_IN_LEFT_MID, 5, 0);
 
+    blectl_register_cb( BLECTL_MSG, bluetooth_message_event_cb );
+
+    weather_setup_refresh();
+    configapi_register_cb( weather_setup_refresh );
+}
+
+/*
+ * show the current settings, also called when they are changed over the webserver
+ */
+static void weather_setup_refresh( void ) {
+    weather_config_t *weather_config = weather_get_config();
+
+    lv_textarea_set_text( weather_apikey_textfield, weather_config->apikey );
+    lv_textarea_set_text( weather_lat_textfield, weather_config->lat );
+    lv_textarea_set_text( weather_lon_textfield, weather_config->lon );
+
     if ( weather_config->autosync)
         lv_switch_on(weather_autosync_onoff, LV_ANIM_OFF);
     else
@@ -210,8 +228,6 @@ void weather_setup_tile_setup( uint32_t tile_num ) {
         lv_switch_on( weather_imperial_onoff, LV_ANIM_OFF );
     else
         lv_switch_off( weather_imperial_onoff, LV_ANIM_OFF );
-
-    blectl_register_cb( BLECTL_MSG, bluetooth_message_event_cb );
 }
 
 static void weather_textarea_event_cb( lv_obj_t * obj, lv_event_t event ) {
@@ -293,6 +309,23 @@ void bluetooth_message_msg_pharse( char* msg ) {
             }
 
         }
+        else if( !strcmp( doc["t"], "weather" ) && doc.containsKey( "temp" ) ) {
+            /*
+             * Gadgetbridge sends kelvin and km/h, like
+             * {"t":"weather","temp":293,"hum":52,"code":800,"txt":"Clear","wind":12.6,"wdir":230,"loc":"Berlin"}
+             */
+            weather_phone_t phone;
+
+            phone.timestamp = time( NULL );
+            phone.temp = lroundf( ( doc["temp"].as<float>() - 273.15 ) * 10 );
+            phone.humidity = doc["hum"].as<uint8_t>();
+            phone.code = doc["code"].as<uint16_t>();
+            phone.wind_speed = lroundf( doc["wind"].as<float>() / 3.6 * 10 );
+            phone.wind_deg = doc["wdir"].as<uint16_t>();
+            strlcpy( phone.name, doc["loc"] | "", sizeof( phone.name ) );
+            log_i("weather from phone: %s%d.%d°C, code %d, %s", phone.temp < 0 ? "-" : "", abs( phone.temp ) / 10, abs( phone.temp ) % 10, phone.code, phone.name );
+            weather_push_from_phone( &phone );
+        }
     }        
     doc.clear();
 }
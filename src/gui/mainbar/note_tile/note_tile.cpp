@@ -20,31 +20,270 @@
  *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
 #include "config.h"
+#include <time.h>
 
 #include "gui/mainbar/mainbar.h"
+#include "gui/statusbar.h"
+#include "gui/mainbar/setup_tile/bluetooth_settings/bluetooth_message.h"
+#include "hardware/notestore.h"
 #include "note_tile.h"
 
+/*
+ * the list only has the rows that fit on the screen plus one, they are moved
+ * and refilled while scrolling, so the number of lvgl objects does not grow
+ * with the number of notifications
+ */
+typedef struct {
+    lv_obj_t *cont;
+    lv_obj_t *img;
+    lv_obj_t *head;
+    lv_obj_t *text;
+    int32_t index;                                  /** @brief position in the list or -1 */
+    uint32_t id;                                    /** @brief id of the shown notification */
+} note_tile_row_t;
+
 static lv_obj_t *note_cont = NULL;
-static lv_obj_t *notelabel = NULL;
+static lv_obj_t *note_header = NULL;
+static lv_obj_t *note_list = NULL;
+static note_tile_row_t note_rows[ NOTE_TILE_ROWS ];
+static uint32_t note_tile_num = 0;
+static lv_task_t *note_tile_task = NULL;
+static int note_filter_app = -1;                    /** @brief show only this app or -1 for all */
+static uint32_t note_serial = 0;
+static lv_coord_t note_scrl_y = 1;
 
 static lv_style_t *style;
 static lv_style_t notestyle;
+static lv_style_t note_list_style;
+static lv_style_t note_head_style;
 
-LV_FONT_DECLARE(Ubuntu_72px);
 LV_FONT_DECLARE(Ubuntu_16px);
 
+static void note_tile_activate_cb( void );
+static void note_tile_hibernate_cb( void );
+static void note_tile_update_task( lv_task_t *task );
+static void note_tile_update( bool force );
+static void note_tile_fill_row( note_tile_row_t *row, int32_t index );
+static void note_tile_row_event_cb( lv_obj_t *obj, lv_event_t event );
+static void note_tile_header_event_cb( lv_obj_t *obj, lv_event_t event );
+static uint32_t note_tile_total( void );
+
 void note_tile_setup( void ) {
 
-    note_cont = mainbar_get_tile_obj( mainbar_add_tile( 0, 1 ) );
+    note_tile_num = mainbar_add_tile( 0, 1 );
+    note_cont = mainbar_get_tile_obj( note_tile_num );
     style = mainbar_get_style();
 
     lv_style_copy( &notestyle, style);
-    lv_style_set_text_opa( &notestyle, LV_OBJ_PART_MAIN, LV_OPA_30);
-    lv_style_set_text_font( &notestyle, LV_STATE_DEFAULT, &Ubuntu_72px);
-
-    notelabel = lv_label_create( note_cont, NULL);
-    lv_label_set_text( notelabel, "note");
-    lv_obj_reset_style_list( notelabel, LV_OBJ_PART_MAIN );
-    lv_obj_add_style( notelabel, LV_OBJ_PART_MAIN, &notestyle );
-    lv_obj_align( notelabel, NULL, LV_ALIGN_CENTER, 0, 0);
-}
\ No newline at end of file
+    lv_style_set_text_font( &notestyle, LV_STATE_DEFAULT, &Ubuntu_16px);
+
+    lv_style_copy( &note_head_style, &notestyle );
+    lv_style_set_text_opa( &note_head_style, LV_OBJ_PART_MAIN, LV_OPA_50 );
+
+    lv_style_copy( &note_list_style, style );
+    lv_style_set_pad_top( &note_list_style, LV_STATE_DEFAULT, 0 );
+    lv_style_set_pad_bottom( &note_list_style, LV_STATE_DEFAULT, 0 );
+    lv_style_set_pad_left( &note_list_style, LV_STATE_DEFAULT, 0 );
+    lv_style_set_pad_right( &note_list_style, LV_STATE_DEFAULT, 0 );
+    lv_style_set_pad_inner( &note_list_style, LV_STATE_DEFAULT, 0 );
+
+    note_header = lv_label_create( note_cont, NULL );
+    lv_obj_add_style( note_header, LV_OBJ_PART_MAIN, &notestyle );
+    lv_label_set_text( note_header, "no notifications" );
+    lv_obj_set_click( note_header, true );
+    lv_obj_set_event_cb( note_header, note_tile_header_event_cb );
+    lv_obj_align( note_header, note_cont, LV_ALIGN_IN_TOP_LEFT, 10, STATUSBAR_HEIGHT + 5 );
+
+    note_list = lv_page_create( note_cont, NULL );
+    lv_obj_set_size( note_list, lv_disp_get_hor_res( NULL ), NOTE_TILE_LIST_HEIGHT );
+    lv_obj_add_style( note_list, LV_PAGE_PART_BG, &note_list_style );
+    lv_obj_add_style( note_list, LV_PAGE_PART_SCROLLABLE, &note_list_style );
+    lv_page_set_scrl_layout( note_list, LV_LAYOUT_OFF );
+    lv_page_set_scrollable_fit( note_list, LV_FIT_NONE );
+    lv_page_set_scrlbar_mode( note_list, LV_SCRLBAR_MODE_DRAG );
+    // at the top or bottom of the list a swipe goes on to the mainbar
+    lv_page_set_scroll_propagation( note_list, true );
+    lv_obj_align( note_list, note_cont, LV_ALIGN_IN_BOTTOM_MID, 0, 0 );
+
+    for ( int i = 0 ; i < NOTE_TILE_ROWS ; i++ ) {
+        note_tile_row_t *row = &note_rows[ i ];
+
+        row->cont = lv_cont_create( note_list, NULL );
+        lv_obj_set_size( row->cont, lv_disp_get_hor_res( NULL ), NOTE_TILE_ROW_HEIGHT );
+        lv_obj_add_style( row->cont, LV_OBJ_PART_MAIN, &note_list_style );
+        lv_page_glue_obj( row->cont, true );
+        lv_obj_set_event_cb( row->cont, note_tile_row_event_cb );
+
+        row->img = lv_img_create( row->cont, NULL );
+        lv_obj_align( row->img, row->cont, LV_ALIGN_IN_LEFT_MID, 5, 0 );
+
+        row->head = lv_label_create( row->cont, NULL );
+        lv_obj_add_style( row->head, LV_OBJ_PART_MAIN, &note_head_style );
+        lv_label_set_long_mode( row->head, LV_LABEL_LONG_DOT );
+        lv_obj_set_width( row->head, lv_disp_get_hor_res( NULL ) - 50 );
+        lv_obj_align( row->head, row->cont, LV_ALIGN_IN_TOP_LEFT, 45, 4 );
+
+        row->text = lv_label_create( row->cont, NULL );
+        lv_obj_add_style( row->text, LV_OBJ_PART_MAIN, &notestyle );
+        lv_label_set_long_mode( row->text, LV_LABEL_LONG_DOT );
+        lv_obj_set_width( row->text, lv_disp_get_hor_res( NULL ) - 50 );
+        lv_obj_align( row->text, row->cont, LV_ALIGN_IN_TOP_LEFT, 45, 24 );
+
+        row->index = -1;
+        lv_obj_set_hidden( row->cont, true );
+    }
+
+    mainbar_add_tile_activate_cb( note_tile_num, note_tile_activate_cb );
+    mainbar_add_tile_hibernate_cb( note_tile_num, note_tile_hibernate_cb );
+}
+
+static void note_tile_activate_cb( void ) {
+    note_tile_update( true );
+    note_tile_task = lv_task_create( note_tile_update_task, NOTE_TILE_UPDATE_INTERVAL, LV_TASK_PRIO_LOW, NULL );
+}
+
+static void note_tile_hibernate_cb( void ) {
+    if ( note_tile_task ) {
+        lv_task_del( note_tile_task );
+        note_tile_task = NULL;
+    }
+}
+
+static void note_tile_update_task( lv_task_t *task ) {
+    note_tile_update( false );
+}
+
+static uint32_t note_tile_total( void ) {
+    return( note_filter_app < 0 ? notestore_count() : notestore_app_count( note_filter_app ) );
+}
+
+/*
+ * place the rows at the scroll position, a row is only filled again when it shows an other notification
+ */
+static void note_tile_update( bool force ) {
+    lv_obj_t *scrl = lv_page_get_scrollable( note_list );
+    uint32_t total = note_tile_total();
+    char header[ 64 ] = "";
+
+    if ( force || note_serial != notestore_get_serial() ) {
+        struct tm info;
+        time_t now;
+
+        time( &now );
+        localtime_r( &now, &info );
+        info.tm_hour = 0;
+        info.tm_min = 0;
+        info.tm_sec = 0;
+
+        if ( note_filter_app >= 0 ) {
+            snprintf( header, sizeof( header ), "%s: %d", notestore_get_app_name( note_filter_app ), total );
+        }
+        else if ( total ) {
+            snprintf( header, sizeof( header ), "%d notifications, %d today", total, notestore_count_since( mktime( &info ) ) );
+        }
+        else {
+            snprintf( header, sizeof( header ), "no notifications" );
+        }
+        lv_label_set_text( note_header, header );
+        lv_obj_set_height( scrl, total * NOTE_TILE_ROW_HEIGHT > NOTE_TILE_LIST_HEIGHT ? total * NOTE_TILE_ROW_HEIGHT : NOTE_TILE_LIST_HEIGHT );
+        note_serial = notestore_get_serial();
+        force = true;
+    }
+
+    if ( !force && lv_obj_get_y( scrl ) == note_scrl_y ) {
+        return;
+    }
+    note_scrl_y = lv_obj_get_y( scrl );
+
+    int32_t first = -note_scrl_y / NOTE_TILE_ROW_HEIGHT;
+    if ( first < 0 ) {
+        first = 0;
+    }
+    for ( int i = 0 ; i < NOTE_TILE_ROWS ; i++ ) {
+        int32_t index = first + i;
+        note_tile_row_t *row = &note_rows[ ( index % NOTE_TILE_ROWS ) ];
+
+        if ( index >= (int32_t)total ) {
+            row->index = -1;
+            lv_obj_set_hidden( row->cont, true );
+            continue;
+        }
+        if ( force || row->index != index ) {
+            note_tile_fill_row( row, index );
+            lv_obj_set_y( row->cont, index * NOTE_TILE_ROW_HEIGHT );
+            lv_obj_set_hidden( row->cont, false );
+        }
+    }
+}
+
+static void note_tile_fill_row( note_tile_row_t *row, int32_t index ) {
+    notestore_record_t record;
+    char head[ NOTESTORE_APP_SIZE + 16 ] = "";
+    char text[ NOTESTORE_TITLE_SIZE + NOTESTORE_BODY_SIZE + 4 ] = "";
+    bool found = note_filter_app < 0 ? notestore_get( index, &record ) : notestore_get_app( note_filter_app, index, &record );
+
+    row->index = index;
+    if ( !found ) {
+        row->id = 0;
+        lv_obj_set_hidden( row->cont, true );
+        return;
+    }
+    row->id = record.id;
+
+    const char *app = notestore_get_app_name( record.app );
+    struct tm info;
+    time_t timestamp = record.timestamp;
+    time_t now;
+
+    time( &now );
+    localtime_r( &timestamp, &info );
+    if ( now - timestamp < 24 * 60 * 60 ) {
+        snprintf( head, sizeof( head ), "%02d:%02d  %s", info.tm_hour, info.tm_min, *app ? app : "Message" );
+    }
+    else {
+        snprintf( head, sizeof( head ), "%02d.%02d.  %s", info.tm_mday, info.tm_mon + 1, *app ? app : "Message" );
+    }
+    if ( *record.title && *record.body ) {
+        snprintf( text, sizeof( text ), "%s: %s", record.title, record.body );
+    }
+    else {
+        snprintf( text, sizeof( text ), "%s", *record.title ? record.title : record.body );
+    }
+    lv_img_set_src( row->img, bluetooth_message_get_src_img( app ) );
+    lv_label_set_text( row->head, head );
+    lv_label_set_text( row->text, text );
+}
+
+/*
+ * a tap on a notification shows only the notifications of its app
+ */
+static void note_tile_row_event_cb( lv_obj_t *obj, lv_event_t event ) {
+    if ( event != LV_EVENT_CLICKED || note_filter_app >= 0 ) {
+        return;
+    }
+    for ( int i = 0 ; i < NOTE_TILE_ROWS ; i++ ) {
+        notestore_record_t record;
+
+        if ( note_rows[ i ].cont == obj && note_rows[ i ].index >= 0 && notestore_get( note_rows[ i ].index, &record ) ) {
+            note_filter_app = record.app;
+            lv_obj_set_y( lv_page_get_scrollable( note_list ), 0 );
+            note_tile_update( true );
+            break;
+        }
+    }
+}
+
+/*
+ * a tap on the header shows all notifications again, a long press clears them
+ */
+static void note_tile_header_event_cb( lv_obj_t *obj, lv_event_t event ) {
+    switch( event ) {
+        case( LV_EVENT_SHORT_CLICKED ): note_filter_app = -1;
+                                        note_tile_update( true );
+                                        break;
+        case( LV_EVENT_LONG_PRESSED ):  notestore_clear();
+                                        note_filter_app = -1;
+                                        note_tile_update( true );
+                                        break;
+    }
+}
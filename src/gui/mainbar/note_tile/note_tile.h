@@ -24,6 +24,14 @@
 
     #include <TTGO.h>
 
+    #define NOTE_TILE_ROW_HEIGHT        48
+    #define NOTE_TILE_LIST_HEIGHT       ( 240 - STATUSBAR_HEIGHT - 30 )
+    #define NOTE_TILE_ROWS              ( NOTE_TILE_LIST_HEIGHT / NOTE_TILE_ROW_HEIGHT + 2 )   /** @brief rows on screen plus the one scrolling in */
+    #define NOTE_TILE_UPDATE_INTERVAL   50          /** @brief ms between two checks of the scroll position */
+
+    /*
+     * @brief setup the note tile with the notification history
+     */
     void note_tile_setup( void );
 
 #endif // _NOTE_TILE_H
\ No newline at end of file
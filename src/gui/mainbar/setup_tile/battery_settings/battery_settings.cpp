@@ -29,6 +29,7 @@
 #include "hardware/display.h"
 #include "hardware/motor.h"
 #include "hardware/pmu.h"
+#include "hardware/configapi.h"
 
 lv_obj_t *battery_settings_tile=NULL;
 lv_style_t battery_settings_style;
@@ -50,6 +51,7 @@ static void exit_battery_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void battery_silence_wakeup_switch_event_handler( lv_obj_t * obj, lv_event_t event );
 static void battery_percent_switch_event_handler( lv_obj_t * obj, lv_event_t event );
 static void battery_experimental_switch_event_handler( lv_obj_t * obj, lv_event_t event );
+static void battery_settings_refresh( void );
 void battery_set_experimental_indicator( void );
 
 void battery_settings_tile_setup( void ) {
@@ -150,6 +152,14 @@ void battery_settings_tile_setup( void ) {
     lv_label_set_text( doubleclick_label, "power save");
     lv_obj_align( doubleclick_label, battery_experimental_switch_cont, LV_ALIGN_IN_LEFT_MID, 5, 0 );
 
+    battery_settings_refresh();
+    configapi_register_cb( battery_settings_refresh );
+}
+
+/*
+ * show the current settings, also called when they are changed over the webserver
+ */
+static void battery_settings_refresh( void ) {
     if ( pmu_get_calculated_percent() )
         lv_switch_on( battery_percent_switch, LV_ANIM_OFF);
     else
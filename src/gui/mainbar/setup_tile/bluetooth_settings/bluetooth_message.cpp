@@ -29,6 +29,8 @@
 #include "hardware/powermgm.h"
 #include "hardware/motor.h"
 #include "hardware/json_psram_allocator.h"
+#include "hardware/notestore.h"
+#include "hardware/notifyctl.h"
 
 lv_obj_t *bluetooth_message_tile=NULL;
 lv_style_t bluetooth_message_style;
@@ -72,7 +74,8 @@ static bool bluetooth_message_active = true;
 static void exit_bluetooth_message_event_cb( lv_obj_t * obj, lv_event_t event );
 static void bluetooth_message_event_cb( EventBits_t event, char* msg );
 static void bluetooth_message_msg_pharse( char* msg );
-const lv_img_dsc_t *bluetooth_message_find_img( const char * src_name );
+static void bluetooth_message_alert_cb( notifyburst_summary_t *summary );
+static void bluetooth_message_vibe( const char * src_name );
 
 void bluetooth_message_tile_setup( void ) {
     // get an app tile and copy mainstyle
@@ -125,6 +128,7 @@ void bluetooth_message_tile_setup( void ) {
     lv_obj_set_event_cb( exit_btn, exit_bluetooth_message_event_cb );
 
     blectl_register_cb( BLECTL_MSG, bluetooth_message_event_cb );
+    notifyctl_register_cb( bluetooth_message_alert_cb );
 }
 
 static void bluetooth_message_event_cb( EventBits_t event, char* msg ) {
@@ -149,24 +153,31 @@ void bluetooth_message_enable( void ) {
     bluetooth_message_active = true;    
 }
 
-const lv_img_dsc_t *bluetooth_message_find_img( const char * src_name ) {
+const lv_img_dsc_t *bluetooth_message_get_src_img( const char * src_name ) {
     for ( int i = 0; src_icon[ i ].img != NULL; i++ ) {
         if ( strstr( src_name, src_icon[ i ].src_name ) ) {
-            log_i("hit: %s -> %s", src_name, src_icon[ i ].src_name );
-            if ( src_icon[ i ].vibe != 0 ) {
-                motor_vibe( src_icon[ i ].vibe );
-            }
             return( src_icon[ i ].img );
         }
     }
     return( &message_32px );
 }
 
-void bluetooth_message_msg_pharse( char* msg ) {
-    if ( bluetooth_message_active == false ) {
-        return;
+/*
+ * a notification that does not wake the watch, the vibe of the source app or a short one
+ */
+static void bluetooth_message_vibe( const char * src_name ) {
+    for ( int i = 0; src_name && src_icon[ i ].img != NULL; i++ ) {
+        if ( strstr( src_name, src_icon[ i ].src_name ) ) {
+            if ( src_icon[ i ].vibe != 0 ) {
+                motor_vibe( src_icon[ i ].vibe );
+            }
+            return;
+        }
     }
+    motor_vibe( 100 );
+}
 
+void bluetooth_message_msg_pharse( char* msg ) {
     log_i("msg: %s", msg );
 
     SpiRamJsonDocument doc( strlen( msg ) * 2 );
@@ -177,46 +188,55 @@ void bluetooth_message_msg_pharse( char* msg ) {
     }
     else {
         if( !strcmp( doc["t"], "notify" ) ) {
-            statusbar_hide( true );
-
-            // set notify source icon
-            if ( doc["src"] ) {
-                lv_img_set_src( bluetooth_message_img, bluetooth_message_find_img( doc["src"] ) ); 
-                lv_label_set_text( bluetooth_message_notify_source_label, doc["src"] );
-            }
-            else {
-                lv_img_set_src( bluetooth_message_img, &message_32px );
-                lv_label_set_text( bluetooth_message_notify_source_label, "Message" );
-                motor_vibe(100);
-            }
-            
-            // set message
-            if ( doc["body"] )
-                lv_label_set_text( bluetooth_message_msg_label, doc["body"] );
-            else if ( doc["title"] )
-                lv_label_set_text( bluetooth_message_msg_label, doc["title"] );
-            else 
-                lv_label_set_text( bluetooth_message_msg_label, "" );
-
-            // scroll back to the top
-            if ( lv_page_get_scrl_height( bluetooth_message_page ) > 160 )
-                lv_page_scroll_ver( bluetooth_message_page, lv_page_get_scrl_height( bluetooth_message_page ) );
-            
-            // set sender label
-            if ( doc["title"] )
-                lv_label_set_text( bluetooth_message_sender_label, doc["title"] );
-            else if ( doc["sender"] )
-                lv_label_set_text( bluetooth_message_sender_label, doc["sender"] );
-            else if( doc["tel"] ) 
-                lv_label_set_text( bluetooth_message_sender_label, doc["tel"] );
-            else
-                lv_label_set_text( bluetooth_message_sender_label, "n/a" );
-
-            powermgm_set_event( POWERMGM_WAKEUP_REQUEST );
-            mainbar_jump_to_tilenumber( bluetooth_message_tile_num, LV_ANIM_OFF );
-
-            lv_obj_invalidate( lv_scr_act() );
+            // keep every notification in the history, also when an app has the screen. only the ring
+            // in psram is changed here, notestore_loop() writes it to flash
+            const char *title = doc["title"].as<const char *>();
+            if ( title == NULL )
+                title = doc["sender"].as<const char *>();
+            if ( title == NULL )
+                title = doc["tel"].as<const char *>();
+            notestore_add( doc["src"].as<const char *>(), title, doc["body"].as<const char *>(), time( NULL ) );
+            // the rules decide if it is worth to wake up the watch, notifyctl_loop() alerts once per burst
+            notifyctl_notify( doc["id"] | 0, doc["src"].as<const char *>(), title, doc["body"].as<const char *>() );
         }
     }        
     doc.clear();
 }
+
+static void bluetooth_message_alert_cb( notifyburst_summary_t *summary ) {
+    if ( summary->action == NOTIFYRULES_VIBE ) {
+        bluetooth_message_vibe( summary->src );
+        return;
+    }
+    if ( bluetooth_message_active == false ) {
+        return;
+    }
+
+    statusbar_hide( true );
+    bluetooth_message_vibe( summary->src );
+
+    // set notify source icon, a burst from several apps is a generic message
+    if ( *summary->src ) {
+        lv_img_set_src( bluetooth_message_img, bluetooth_message_get_src_img( summary->src ) );
+        lv_label_set_text( bluetooth_message_notify_source_label, summary->src );
+    }
+    else {
+        lv_img_set_src( bluetooth_message_img, &message_32px );
+        lv_label_set_text( bluetooth_message_notify_source_label, "Message" );
+    }
+
+    // set message
+    lv_label_set_text( bluetooth_message_msg_label, *summary->body ? summary->body : summary->title );
+
+    // scroll back to the top
+    if ( lv_page_get_scrl_height( bluetooth_message_page ) > 160 )
+        lv_page_scroll_ver( bluetooth_message_page, lv_page_get_scrl_height( bluetooth_message_page ) );
+
+    // set sender label
+    lv_label_set_text( bluetooth_message_sender_label, *summary->title ? summary->title : "n/a" );
+
+    powermgm_set_event( POWERMGM_WAKEUP_REQUEST );
+    mainbar_jump_to_tilenumber( bluetooth_message_tile_num, LV_ANIM_OFF );
+
+    lv_obj_invalidate( lv_scr_act() );
+}
@@ -33,5 +33,13 @@
     void bluetooth_message_tile_setup( void );
     void bluetooth_message_disable( void );
     void bluetooth_message_enable( void );
+    /*
+     * @brief get the icon of a notification source without the vibe
+     *
+     * @param   src_name    source app like "Telegram"
+     *
+     * @return  icon, a generic message icon for unknown sources
+     */
+    const lv_img_dsc_t *bluetooth_message_get_src_img( const char * src_name );
 
 #endif // _BLUETOOTH_MESSAGE_H
\ No newline at end of file
@@ -29,6 +29,7 @@
 #include "gui/mainbar/setup_tile/setup.h"
 #include "gui/statusbar.h"
 #include "hardware/blectl.h"
+#include "hardware/configapi.h"
 
 lv_obj_t *bluetooth_settings_tile=NULL;
 lv_style_t bluetooth_settings_style;
@@ -48,6 +49,7 @@ static void enter_bluetooth_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void exit_bluetooth_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void bluetooth_standby_onoff_event_handler(lv_obj_t * obj, lv_event_t event);
 static void bluetooth_advertising_onoff_event_handler(lv_obj_t * obj, lv_event_t event);
+static void bluetooth_settings_refresh( void );
 
 void bluetooth_settings_tile_setup( void ) {
     // get an app tile and copy mainstyle
@@ -130,6 +132,18 @@ void bluetooth_settings_tile_setup( void ) {
     lv_label_set_text( bluetooth_standby_label, "always on");
     lv_obj_align( bluetooth_standby_label, bluetooth_standby_cont, LV_ALIGN_IN_LEFT_MID, 5, 0 );
 
+    bluetooth_pairing_tile_setup();
+    bluetooth_call_tile_setup();
+    bluetooth_message_tile_setup();
+
+    bluetooth_settings_refresh();
+    configapi_register_cb( bluetooth_settings_refresh );
+}
+
+/*
+ * show the current settings, also called when they are changed over the webserver
+ */
+static void bluetooth_settings_refresh( void ) {
     if ( blectl_get_advertising() ) {
         lv_switch_on( bluetooth_advertising_onoff, LV_ANIM_OFF );
     }
@@ -142,12 +156,9 @@ void bluetooth_settings_tile_setup( void ) {
         lv_switch_on( bluetooth_standby_onoff, LV_ANIM_OFF );
     }
     else {
+        lv_obj_set_hidden( bluetooth_setup_info_img, true );
         lv_switch_off( bluetooth_standby_onoff, LV_ANIM_OFF );
     }
-
-    bluetooth_pairing_tile_setup();
-    bluetooth_call_tile_setup();
-    bluetooth_message_tile_setup();
 }
 
 static void enter_bluetooth_setup_event_cb( lv_obj_t * obj, lv_event_t event ) {
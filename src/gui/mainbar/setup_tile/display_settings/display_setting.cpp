@@ -28,6 +28,7 @@
 #include "hardware/display.h"
 #include "hardware/motor.h"
 #include "hardware/bma.h"
+#include "hardware/configapi.h"
 
 lv_obj_t *display_settings_tile_1 = NULL;
 lv_obj_t *display_settings_tile_2 = NULL;
@@ -62,6 +63,7 @@ static void display_timeout_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void display_rotation_event_handler(lv_obj_t * obj, lv_event_t event);
 static void display_vibe_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void display_block_return_maintile_setup_event_cb( lv_obj_t * obj, lv_event_t event );
+static void display_settings_refresh( void );
 
 void display_settings_tile_setup( void ) {
     // get an app tile and copy mainstyle
@@ -206,6 +208,20 @@ void display_settings_tile_setup( void ) {
     lv_label_set_text( display_block_return_maintile_label, "block return maintile" );
     lv_obj_align( display_block_return_maintile_label, block_return_maintile_cont, LV_ALIGN_IN_LEFT_MID, 5, 0 );
 
+    lv_tileview_add_element( display_settings_tile_1, brightness_cont );
+    lv_tileview_add_element( display_settings_tile_1, timeout_cont );
+    lv_tileview_add_element( display_settings_tile_1, rotation_cont );
+    lv_tileview_add_element( display_settings_tile_2, vibe_cont );
+    lv_tileview_add_element( display_settings_tile_2, block_return_maintile_cont );
+
+    display_settings_refresh();
+    configapi_register_cb( display_settings_refresh );
+}
+
+/*
+ * show the current settings, also called when they are changed over the webserver
+ */
+static void display_settings_refresh( void ) {
     lv_slider_set_value( display_brightness_slider, display_get_brightness(), LV_ANIM_OFF );
     lv_slider_set_value( display_timeout_slider, display_get_timeout(), LV_ANIM_OFF );
     char temp[16]="";
@@ -215,6 +231,7 @@ void display_settings_tile_setup( void ) {
     }
     else {
         snprintf( temp, sizeof( temp ), "%d seconds", lv_slider_get_value( display_timeout_slider ) );
+        lv_obj_set_hidden( display_setup_info_img, true );
     }
     lv_label_set_text( display_timeout_slider_label, temp );
     lv_obj_align( display_timeout_slider_label, display_timeout_slider, LV_ALIGN_OUT_BOTTOM_MID, 0, 15 );
@@ -229,12 +246,6 @@ void display_settings_tile_setup( void ) {
         lv_switch_on( display_block_return_maintile_onoff, LV_ANIM_OFF );
     else
         lv_switch_off( display_block_return_maintile_onoff, LV_ANIM_OFF );
-
-    lv_tileview_add_element( display_settings_tile_1, brightness_cont );
-    lv_tileview_add_element( display_settings_tile_1, timeout_cont );
-    lv_tileview_add_element( display_settings_tile_1, rotation_cont );
-    lv_tileview_add_element( display_settings_tile_2, vibe_cont );
-    lv_tileview_add_element( display_settings_tile_2, block_return_maintile_cont );
 }
 
 static void enter_display_setup_event_cb( lv_obj_t * obj, lv_event_t event ) {
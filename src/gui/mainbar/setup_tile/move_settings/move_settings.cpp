@@ -27,6 +27,7 @@
 #include "gui/statusbar.h"
 #include "hardware/bma.h"
 #include "hardware/motor.h"
+#include "hardware/configapi.h"
 
 lv_obj_t *move_settings_tile=NULL;
 lv_style_t move_settings_style;
@@ -44,6 +45,7 @@ static void exit_move_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void stepcounter_onoff_event_handler(lv_obj_t * obj, lv_event_t event);
 static void doubleclick_onoff_event_handler(lv_obj_t * obj, lv_event_t event);
 static void tilt_onoff_event_handler(lv_obj_t * obj, lv_event_t event);
+static void move_settings_refresh( void );
 
 void move_settings_tile_setup( void ) {
     // get an app tile and copy mainstyle
@@ -125,6 +127,14 @@ void move_settings_tile_setup( void ) {
     lv_label_set_text( tilt_label, "tilt");
     lv_obj_align( tilt_label, tilt_cont, LV_ALIGN_IN_LEFT_MID, 5, 0 );
 
+    move_settings_refresh();
+    configapi_register_cb( move_settings_refresh );
+}
+
+/*
+ * show the current settings, also called when they are changed over the webserver
+ */
+static void move_settings_refresh( void ) {
     if ( bma_get_config( BMA_DOUBLECLICK ) )
         lv_switch_on( doubleclick_onoff, LV_ANIM_OFF );
     else
@@ -28,6 +28,7 @@
 #include "gui/statusbar.h"
 #include "hardware/timesync.h"
 #include "hardware/motor.h"
+#include "hardware/configapi.h"
 
 lv_obj_t *time_settings_tile=NULL;
 lv_style_t time_settings_style;
@@ -46,6 +47,7 @@ static void exit_time_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void wifisync_onoff_event_handler(lv_obj_t * obj, lv_event_t event);
 static void daylight_onoff_event_handler(lv_obj_t * obj, lv_event_t event);
 static void utczone_event_handler(lv_obj_t * obj, lv_event_t event);
+static void time_settings_refresh( void );
 
 void time_settings_tile_setup( void ) {
     // get an app tile and copy mainstyle
@@ -126,6 +128,14 @@ void time_settings_tile_setup( void ) {
     lv_obj_align(utczone_list, utczone_cont, LV_ALIGN_IN_RIGHT_MID, -5, 0);
     lv_obj_set_event_cb(utczone_list, utczone_event_handler);
 
+    time_settings_refresh();
+    configapi_register_cb( time_settings_refresh );
+}
+
+/*
+ * show the current settings, also called when they are changed over the webserver
+ */
+static void time_settings_refresh( void ) {
     if ( timesync_get_timesync() )
         lv_switch_on( wifisync_onoff, LV_ANIM_OFF );
     else
@@ -21,12 +21,12 @@
  */
 #include "config.h"
 #include <Arduino.h>
-#include <HTTPClient.h>
-#include <HTTPUpdate.h>
+#include <WiFi.h>
 
 #include "update.h"
 #include "update_setup.h"
 #include "update_check_version.h"
+#include "update_download.h"
 
 #include "gui/mainbar/mainbar.h"
 #include "gui/mainbar/setup_tile/setup.h"
@@ -34,6 +34,7 @@
 #include "hardware/display.h"
 #include "hardware/powermgm.h"
 #include "hardware/wifictl.h"
+#include "hardware/otaupdate.h"
 
 EventGroupHandle_t update_event_handle = NULL;
 TaskHandle_t _update_Task;
@@ -47,11 +48,22 @@ lv_obj_t *update_btn = NULL;
 lv_obj_t *update_status_label = NULL;
 lv_obj_t *update_setup_icon_cont = NULL;
 lv_obj_t *update_info_img = NULL;
+lv_task_t *update_status_task = NULL;
+
+/*
+ * set from the update task and the ota writer task, shown by update_status_task
+ */
+static portMUX_TYPE updateMux = portMUX_INITIALIZER_UNLOCKED;
+static char update_status_msg[ UPDATE_STATUS_LEN ] = "";
+static bool update_status_changed = false;
+static int8_t update_status_info = -1;              /** @brief show (1) or hide (0) the new version icon, -1 unchanged */
 
 static void enter_update_setup_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void enter_update_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void exit_update_setup_event_cb( lv_obj_t * obj, lv_event_t event );
 static void update_event_handler(lv_obj_t * obj, lv_event_t event );
+static void update_set_status( const char *msg, int8_t info );
+static void update_status_task_cb( lv_task_t *task );
 
 LV_IMG_DECLARE(exit_32px);
 LV_IMG_DECLARE(setup_32px);
@@ -59,6 +71,7 @@ LV_IMG_DECLARE(update_64px);
 LV_IMG_DECLARE(info_1_16px);
 
 void update_wifictl_event_cb( EventBits_t event, char* msg );
+void update_otaupdate_event_cb( EventBits_t event, size_t written, size_t total, const char *msg );
 
 void update_tile_setup( void ) {
     // get an app tile and copy mainstyle
@@ -138,6 +151,8 @@ void update_tile_setup( void ) {
     lv_obj_align( update_status_label, update_btn, LV_ALIGN_OUT_BOTTOM_MID, 0, 5 );
 
     wifictl_register_cb( WIFICTL_CONNECT, update_wifictl_event_cb );
+    otaupdate_register_cb( OTAUPDATE_PROGRESS | OTAUPDATE_SUSPEND, update_otaupdate_event_cb );
+    update_status_task = lv_task_create( update_status_task_cb, UPDATE_STATUS_INTERVAL, LV_TASK_PRIO_LOWEST, NULL );
 
     update_event_handle = xEventGroupCreate();
     xEventGroupClearBits( update_event_handle, UPDATE_REQUEST );
@@ -146,10 +161,72 @@ void update_tile_setup( void ) {
 void update_wifictl_event_cb( EventBits_t event, char* msg ) {
     log_i("update wifictl event: %04x", event );
     switch( event ) {
-        case WIFICTL_CONNECT:       if ( update_setup_get_autosync() ) {
-                                    update_check_version();
+        case WIFICTL_CONNECT:       if ( update_download_is_pending() ) {
+                                        /*
+                                         * continue an interrupted update after reconnect or wakeup
+                                         */
+                                        update_update_firmware();
+                                    }
+                                    else if ( update_setup_get_autosync() ) {
+                                        update_check_version();
+                                    }
                                     break;
-        }
+    }
+}
+
+/*
+ * called from the ota writer task, no lvgl calls in here
+ */
+void update_otaupdate_event_cb( EventBits_t event, size_t written, size_t total, const char *msg ) {
+    char progress_msg[32] = "";
+
+    switch( event ) {
+        case OTAUPDATE_PROGRESS:    if ( total ) {
+                                        snprintf( progress_msg, sizeof( progress_msg ), "update %d%% ...", written * 100 / total );
+                                    }
+                                    else {
+                                        snprintf( progress_msg, sizeof( progress_msg ), "update %dkB ...", written / 1024 );
+                                    }
+                                    update_set_status( progress_msg, -1 );
+                                    break;
+        case OTAUPDATE_SUSPEND:     update_set_status( "wait for wifi ...", -1 );
+                                    break;
+    }
+}
+
+/*
+ * the last status wins, the label is changed from update_status_task
+ */
+static void update_set_status( const char *msg, int8_t info ) {
+    char status[ UPDATE_STATUS_LEN ];
+
+    strlcpy( status, msg, sizeof( status ) );
+    portENTER_CRITICAL(&updateMux);
+    memcpy( update_status_msg, status, sizeof( update_status_msg ) );
+    update_status_changed = true;
+    if ( info >= 0 ) {
+        update_status_info = info;
+    }
+    portEXIT_CRITICAL(&updateMux);
+}
+
+static void update_status_task_cb( lv_task_t *task ) {
+    char status[ UPDATE_STATUS_LEN ];
+
+    portENTER_CRITICAL(&updateMux);
+    bool changed = update_status_changed;
+    int8_t info = update_status_info;
+    memcpy( status, update_status_msg, sizeof( status ) );
+    update_status_changed = false;
+    update_status_info = -1;
+    portEXIT_CRITICAL(&updateMux);
+
+    if ( changed ) {
+        lv_label_set_text( update_status_label, status );
+        lv_obj_align( update_status_label, update_btn, LV_ALIGN_OUT_BOTTOM_MID, 0, 15 );
+    }
+    if ( info >= 0 ) {
+        lv_obj_set_hidden( update_info_img, info == 0 );
     }
 }
 
@@ -175,18 +252,22 @@ static void exit_update_setup_event_cb( lv_obj_t * obj, lv_event_t event ) {
 
 static void update_event_handler(lv_obj_t * obj, lv_event_t event) {
     if(event == LV_EVENT_CLICKED) {
-        if ( xEventGroupGetBits( update_event_handle) & ( UPDATE_GET_VERSION_REQUEST | UPDATE_REQUEST ) )  {
-            return;
-        }
-        else {
-            xEventGroupSetBits( update_event_handle, UPDATE_REQUEST );
-            xTaskCreate(    update_Task,        /* Function to implement the task */
-                            "update Task",      /* Name of the task */
-                            10000,               /* Stack size in words */
-                            NULL,               /* Task input parameter */
-                            0,                  /* Priority of the task */
-                            &_update_Task );    /* Task handle. */
-        }
+        update_update_firmware();
+    }
+}
+
+void update_update_firmware( void ) {
+    if ( xEventGroupGetBits( update_event_handle) & ( UPDATE_GET_VERSION_REQUEST | UPDATE_REQUEST ) )  {
+        return;
+    }
+    else {
+        xEventGroupSetBits( update_event_handle, UPDATE_REQUEST );
+        xTaskCreate(    update_Task,        /* Function to implement the task */
+                        "update Task",      /* Name of the task */
+                        10000,               /* Stack size in words */
+                        NULL,               /* Task input parameter */
+                        0,                  /* Priority of the task */
+                        &_update_Task );    /* Task handle. */
     }
 }
 
@@ -213,58 +294,53 @@ void update_Task( void * pvParameters ) {
         if ( firmware_version > atol( __FIRMWARE__ ) && firmware_version > 0 ) {
             char version_msg[48] = "";
             snprintf( version_msg, sizeof( version_msg ), "new version: %lld", firmware_version );
-            lv_label_set_text( update_status_label, (const char*)version_msg );
-            lv_obj_align( update_status_label, update_btn, LV_ALIGN_OUT_BOTTOM_MID, 0, 15 );
-            lv_obj_set_hidden( update_info_img, false );
+            update_set_status( version_msg, 1 );
         }
         else if ( firmware_version == atol( __FIRMWARE__ ) ) {
-            lv_label_set_text( update_status_label, "yeah! up to date ..." );
-            lv_obj_align( update_status_label, update_btn, LV_ALIGN_OUT_BOTTOM_MID, 0, 15 );  
-            lv_obj_set_hidden( update_info_img, true );
+            update_set_status( "yeah! up to date ...", 0 );
         }
         else {
-            lv_label_set_text( update_status_label, "get update info failed" );
-            lv_obj_align( update_status_label, update_btn, LV_ALIGN_OUT_BOTTOM_MID, 0, 15 );  
-            lv_obj_set_hidden( update_info_img, true );
+            update_set_status( "get update info failed", 0 );
         }
-        lv_obj_invalidate( lv_scr_act() );
     }
-    if ( ( xEventGroupGetBits( update_event_handle) & UPDATE_REQUEST ) && ( update_get_url() != NULL ) ) {
+    if ( ( xEventGroupGetBits( update_event_handle) & UPDATE_REQUEST ) && ( update_get_url() != NULL || update_download_is_pending() ) ) {
         if( WiFi.status() == WL_CONNECTED ) {
 
             uint32_t display_timeout = display_get_timeout();
             display_set_timeout( DISPLAY_MAX_TIMEOUT );
 
-            WiFiClient client;
-
-            lv_label_set_text( update_status_label, "start update ..." );
-            lv_obj_align( update_status_label, update_btn, LV_ALIGN_OUT_BOTTOM_MID, 0, 15 );
-
-            httpUpdate.rebootOnUpdate( false );
-
-            t_httpUpdate_return ret = httpUpdate.update( client, update_get_url() );
-
-            switch(ret) {
-                case HTTP_UPDATE_FAILED:
-                    lv_label_set_text( update_status_label, "update failed" );
-                    lv_obj_align( update_status_label, update_btn, LV_ALIGN_OUT_BOTTOM_MID, 0, 15 );  
-                    break;
+            int retval = -1;
 
-                case HTTP_UPDATE_NO_UPDATES:
-                    lv_label_set_text( update_status_label, "no update" );
-                    lv_obj_align( update_status_label, update_btn, LV_ALIGN_OUT_BOTTOM_MID, 0, 15 );  
-                    break;
+            /*
+             * continue an interrupted download, otherwise try the small delta patch
+             * first, if it is missing or does not fit the running firmware get the full image
+             */
+            if ( update_download_is_pending() ) {
+                update_set_status( "resume update ...", -1 );
+                retval = update_download_resume();
+            }
+            else if ( update_get_delta_url() != NULL ) {
+                update_set_status( "start delta update ...", -1 );
+                retval = update_download( update_get_delta_url(), NULL );
+            }
+            if ( retval != 200 && retval != UPDATE_DOWNLOAD_PAUSED && update_get_url() != NULL ) {
+                update_set_status( "start update ...", -1 );
+                retval = update_download( update_get_url(), update_get_sha256() );
+            }
 
-                case HTTP_UPDATE_OK:
-                    lv_label_set_text( update_status_label, "update ok, turn off and on!" );
-                    lv_obj_align( update_status_label, update_btn, LV_ALIGN_OUT_BOTTOM_MID, 0, 15 );  
-                    break;
+            if ( retval == 200 ) {
+                update_set_status( "update ok, turn off and on!", -1 );
+            }
+            else if ( retval == UPDATE_DOWNLOAD_PAUSED ) {
+                update_set_status( "update paused, resume on wifi", -1 );
+            }
+            else {
+                update_set_status( "update failed", -1 );
             }
             display_set_timeout( display_timeout );
         }
         else {
-            lv_label_set_text( update_status_label, "turn wifi on!" );
-            lv_obj_align( update_status_label, update_btn, LV_ALIGN_OUT_BOTTOM_MID, 0, 15 );  
+            update_set_status( "turn wifi on!", -1 );
         }
     }
     xEventGroupClearBits( update_event_handle, UPDATE_REQUEST | UPDATE_GET_VERSION_REQUEST );
@@ -27,6 +27,9 @@
     #define UPDATE_REQUEST              _BV(0)
     #define UPDATE_GET_VERSION_REQUEST  _BV(1)
 
+    #define UPDATE_STATUS_INTERVAL      250         /** @brief ms between two status label updates */
+    #define UPDATE_STATUS_LEN           48
+
     void update_tile_setup( void );
     void update_check_version( void );
     void update_update_firmware( void );
@@ -23,15 +23,34 @@
 #include "HTTPClient.h"
 
 #include "update_check_version.h"
-#include "hardware/json_psram_allocator.h"
+#include "hardware/json_extract.h"
 
 char *firmwarehost = NULL;
 char *firmwarefile = NULL;
 char* firmwareurl = NULL;
+char* firmwaredeltaurl = NULL;
+char firmwaresha256[ 65 ] = "";
 int64_t firmwareversion = -1;
 
+typedef struct {
+    char host[128];
+    char file[128];
+    char version[24];
+    char delta[128];
+    char sha256[65];
+} update_check_version_t;
+
+static const json_extract_field_t update_check_version_fields[] = {
+    JSON_EXTRACT_FIELD( "host",     JSON_EXTRACT_STRING, update_check_version_t, host ),
+    JSON_EXTRACT_FIELD( "file",     JSON_EXTRACT_STRING, update_check_version_t, file ),
+    JSON_EXTRACT_FIELD( "version",  JSON_EXTRACT_STRING, update_check_version_t, version ),
+    JSON_EXTRACT_FIELD( "delta",    JSON_EXTRACT_STRING, update_check_version_t, delta ),
+    JSON_EXTRACT_FIELD( "sha256",   JSON_EXTRACT_STRING, update_check_version_t, sha256 )
+};
+
 int64_t update_check_new_version( char *url ) {
     int httpcode = -1;
+    update_check_version_t version;
 
     HTTPClient check_update_client;
 
@@ -46,55 +65,52 @@ int64_t update_check_new_version( char *url ) {
         return( -1 );
     }
 
-    SpiRamJsonDocument doc( check_update_client.getSize() * 2 );
-
-    DeserializationError error = deserializeJson( doc, check_update_client.getStream() );
-    if (error) {
-        log_e("update check deserializeJson() failed: %s", error.c_str() );
-        doc.clear();
+    memset( &version, 0, sizeof( version ) );
+    if ( json_extract( check_update_client.getStream(), update_check_version_fields, sizeof( update_check_version_fields ) / sizeof( json_extract_field_t ), &version ) < 0 ) {
+        log_e("update check json_extract() failed");
         check_update_client.end();
         return( -1 );
     }
 
     check_update_client.end();
 
-    if ( doc["host"] ) {
+    if ( *version.host ) {
         if ( firmwarehost == NULL ) {
-            firmwarehost = (char*)ps_calloc( strlen( doc["host"] ) + 1, 1 );
+            firmwarehost = (char*)ps_calloc( strlen( version.host ) + 1, 1 );
             if ( firmwarehost == NULL ) {
                 log_e("ps_calloc error");
                 while(true);
             }
         }
         else {
-            char * tmp_firmwarehost = (char*)ps_realloc( firmwarehost, strlen( doc["host"] ) + 1 );
+            char * tmp_firmwarehost = (char*)ps_realloc( firmwarehost, strlen( version.host ) + 1 );
             if ( tmp_firmwarehost == NULL ) {
                 log_e("ps_realloc error");
                 while(true);
             }
             firmwarehost = tmp_firmwarehost;
         }
-        strcpy( firmwarehost, doc["host"] );
+        strcpy( firmwarehost, version.host );
         log_i("firmwarehost: %s", firmwarehost );
     }
 
-    if ( doc["file"] ) {
+    if ( *version.file ) {
         if ( firmwarefile == NULL ) {
-            firmwarefile = (char*)ps_calloc( strlen( doc["file"] ) + 1, 1 );
+            firmwarefile = (char*)ps_calloc( strlen( version.file ) + 1, 1 );
             if ( firmwarefile == NULL ) {
                 log_e("ps_calloc error");
                 while(true);
             }
         }
         else {
-            char * tmp_firmwarefile = (char*)ps_realloc( firmwarefile, strlen( doc["file"] ) + 1 );
+            char * tmp_firmwarefile = (char*)ps_realloc( firmwarefile, strlen( version.file ) + 1 );
             if ( tmp_firmwarefile == NULL ) {
                 log_e("ps_realloc error");
                 while(true);
             }
             firmwarefile = tmp_firmwarefile;
         }
-        strcpy( firmwarefile, doc["file"] );
+        strcpy( firmwarefile, version.file );
         log_i("firmwarefile: %s", firmwarefile );
     }
 
@@ -118,11 +134,35 @@ int64_t update_check_new_version( char *url ) {
         log_i("firmwareurl: %s", firmwareurl );
     }
 
-    if ( doc["version"] ) {
-        firmwareversion = atoll( doc["version"] );
+    /*
+     * "delta" is the path of the patches for this release, the patch for the running
+     * firmware is <host>/<delta><running version>.delta
+     */
+    if ( firmwarehost != NULL && *version.delta ) {
+        size_t size = strlen( firmwarehost ) + strlen( version.delta ) + strlen( __FIRMWARE__ ) + 9;
+        char * tmp_firmwaredeltaurl = (char*)ps_realloc( firmwaredeltaurl, size );
+        if ( tmp_firmwaredeltaurl == NULL ) {
+            log_e("ps_realloc error");
+            while(true);
+        }
+        firmwaredeltaurl = tmp_firmwaredeltaurl;
+        snprintf( firmwaredeltaurl, size, "%s/%s%s.delta", firmwarehost, version.delta, __FIRMWARE__ );
+        log_i("firmwaredeltaurl: %s", firmwaredeltaurl );
+    }
+    else if ( firmwaredeltaurl != NULL ) {
+        free( firmwaredeltaurl );
+        firmwaredeltaurl = NULL;
+    }
+
+    /*
+     * "sha256" of the full image, checked after the download
+     */
+    strlcpy( firmwaresha256, version.sha256, sizeof( firmwaresha256 ) );
+
+    if ( *version.version ) {
+        firmwareversion = atoll( version.version );
     }
 
-    doc.clear();
     return( firmwareversion );
 }
 
@@ -131,4 +171,18 @@ const char* update_get_url( void ) {
         return( (const char*)firmwareurl );
     }
     return( NULL );
+}
+
+const char* update_get_delta_url( void ) {
+    if ( firmwareversion > 0 ) {
+        return( (const char*)firmwaredeltaurl );
+    }
+    return( NULL );
+}
+
+const char* update_get_sha256( void ) {
+    if ( firmwareversion > 0 && *firmwaresha256 ) {
+        return( (const char*)firmwaresha256 );
+    }
+    return( NULL );
 }
\ No newline at end of file
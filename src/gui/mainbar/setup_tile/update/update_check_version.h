@@ -26,5 +26,17 @@
 
     int64_t update_check_new_version( char *url );
     const char* update_get_url( void );
+    /*
+     * @brief get the url of the delta patch from the running firmware to the new one
+     *
+     * @return  url or NULL if the version check has no delta path
+     */
+    const char* update_get_delta_url( void );
+    /*
+     * @brief get the sha256 of the full firmware image from the version check
+     *
+     * @return  sha256 as hex string or NULL if the version check has no sha256
+     */
+    const char* update_get_sha256( void );
 
 #endif // _UPDATE_CHECK_VERSION_H
\ No newline at end of file
@@ -0,0 +1,295 @@
+/****************************************************************************
+ *   Sep 09 20:12:45 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+ 
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include <Update.h>
+#include <WiFi.h>
+#include <SPIFFS.h>
+
+#include "update_download.h"
+#include "hardware/json_psram_allocator.h"
+
+static int update_download_part( update_download_state_t *state );
+static bool update_download_wait_wifi( void );
+static bool update_download_load_state( update_download_state_t *state );
+static void update_download_save_state( update_download_state_t *state );
+static void update_download_remove_state( void );
+
+int update_download( const char *url, const char *sha256 ) {
+    update_download_state_t state;
+    int retval = -1;
+
+    /*
+     * only one download can be pending, a new one drops the old one
+     */
+    if ( !update_download_load_state( &state ) || strcmp( state.url, url ) || strcmp( state.sha256, sha256 ? sha256 : "" ) ) {
+        update_download_remove_state();
+        state = update_download_state_t();
+        strlcpy( state.url, url, sizeof( state.url ) );
+        strlcpy( state.sha256, sha256 ? sha256 : "", sizeof( state.sha256 ) );
+        strlcpy( state.firmware, __FIRMWARE__, sizeof( state.firmware ) );
+    }
+
+    /*
+     * only reconnects without progress count as retry
+     */
+    int retry = 0;
+    while( true ) {
+        uint32_t offset = state.offset;
+
+        retval = update_download_part( &state );
+        if ( retval != UPDATE_DOWNLOAD_PAUSED ) {
+            break;
+        }
+        if ( state.offset > offset ) {
+            retry = 0;
+        }
+        if ( ++retry > UPDATE_DOWNLOAD_RETRIES ) {
+            break;
+        }
+        log_i("retry %d of %d at %d", retry, UPDATE_DOWNLOAD_RETRIES, state.offset );
+        if ( !update_download_wait_wifi() ) {
+            break;
+        }
+        delay( 1000 );
+    }
+
+    if ( retval == UPDATE_DOWNLOAD_PAUSED && state.offset ) {
+        log_i("download paused at %d of %d", state.offset, state.total );
+        return( retval );
+    }
+    update_download_remove_state();
+    return( retval == UPDATE_DOWNLOAD_PAUSED ? -1 : retval );
+}
+
+int update_download_resume( void ) {
+    update_download_state_t state;
+
+    if ( !update_download_load_state( &state ) ) {
+        return( -1 );
+    }
+    return( update_download( state.url, *state.sha256 ? state.sha256 : NULL ) );
+}
+
+bool update_download_is_pending( void ) {
+    update_download_state_t state;
+
+    return( update_download_load_state( &state ) );
+}
+
+/*
+ * download the rest of the image, the connection can be lost at any time
+ *
+ * @return  200 if done, UPDATE_DOWNLOAD_PAUSED if the rest can be fetched with the next
+ *          request, the http status code or -1 if the download failed
+ */
+static int update_download_part( update_download_state_t *state ) {
+    httpctl_response_t response;
+    uint8_t buffer[ UPDATE_DOWNLOAD_BUFFER_SIZE ];
+    char headers[ 96 + HTTPCTL_ETAG_SIZE ];
+    size_t received = 0;
+    bool write_failed = false;
+    bool complete = false;
+
+    /*
+     * If-Range: the server sends the whole file if it has changed since the first part
+     */
+    headers[ 0 ] = '\0';
+    if ( state->offset ) {
+        int pos = snprintf( headers, sizeof( headers ), "Range: bytes=%u-\r\n", state->offset );
+        if ( *state->etag && strncmp( state->etag, "W/", 2 ) ) {
+            snprintf( headers + pos, sizeof( headers ) - pos, "If-Range: %s\r\n", state->etag );
+        }
+    }
+
+    httpctl_con_t *con = httpctl_get( state->url, headers, &response );
+    if ( con == NULL ) {
+        log_e("connection failed: %s", state->url );
+        return( UPDATE_DOWNLOAD_PAUSED );
+    }
+
+    if ( response.httpcode == 206 && state->offset && response.range_start == (int32_t)state->offset ) {
+        if ( response.range_total > 0 ) {
+            state->total = response.range_total;
+        }
+        if ( !otaupdate_resume( U_FLASH, state->offset, state->total, state->sha256, state->written_sha256 ) ) {
+            httpctl_close( con );
+            if ( otaupdate_is_running() ) {
+                return( -1 );
+            }
+            /*
+             * the written part is gone, start again
+             */
+            state->offset = 0;
+            update_download_remove_state();
+            return( UPDATE_DOWNLOAD_PAUSED );
+        }
+        log_i("resume at %d of %d", state->offset, state->total );
+    }
+    else if ( response.httpcode == 200 ) {
+        state->offset = 0;
+        state->total = response.content_length > 0 ? response.content_length : 0;
+        strlcpy( state->etag, response.etag, sizeof( state->etag ) );
+        if ( !otaupdate_begin( U_FLASH, state->total, state->sha256 ) ) {
+            httpctl_close( con );
+            return( -1 );
+        }
+    }
+    else if ( response.httpcode == 206 || response.httpcode == 416 ) {
+        /*
+         * not the part that was asked for or the file on the server is
+         * shorter than the written part, start again
+         */
+        httpctl_close( con );
+        state->offset = 0;
+        update_download_remove_state();
+        return( UPDATE_DOWNLOAD_PAUSED );
+    }
+    else {
+        log_e("http error %d: %s", response.httpcode, state->url );
+        httpctl_close( con );
+        return( response.httpcode );
+    }
+
+    Stream *stream = httpctl_get_stream( con );
+    while( true ) {
+        size_t len = stream->readBytes( (char *)buffer, sizeof( buffer ) );
+        if ( len == 0 ) {
+            break;
+        }
+        if ( !otaupdate_write( buffer, len ) ) {
+            write_failed = true;
+            break;
+        }
+        received += len;
+    }
+    complete = httpctl_body_complete( con );
+    httpctl_close( con );
+
+    if ( write_failed ) {
+        otaupdate_abort();
+        return( -1 );
+    }
+
+    /*
+     * a lost connection also ends the stream, done is only the whole file from Content-Range
+     * or Content-Length or the end of a chunked body. a body without any length ends with
+     * the connection, then otaupdate_end() has to find out if the image is complete
+     */
+    if ( state->total ) {
+        complete = state->offset + received >= state->total;
+    }
+    if ( !complete && ( state->total || response.chunked || response.content_length >= 0 ) ) {
+        log_e("connection lost after %d of %d bytes", state->offset + received, state->total );
+        state->offset = otaupdate_suspend( state->written_sha256 );
+        if ( state->offset ) {
+            update_download_save_state( state );
+        }
+        return( UPDATE_DOWNLOAD_PAUSED );
+    }
+    if ( !otaupdate_end() ) {
+        return( -1 );
+    }
+    log_i("%d bytes from %s", state->total ? state->total : received, state->url );
+    return( 200 );
+}
+
+/*
+ * wait until the wifi is connected again, the watch may go to standby in the meantime
+ */
+static bool update_download_wait_wifi( void ) {
+    uint32_t start = millis();
+
+    while( WiFi.status() != WL_CONNECTED ) {
+        if ( millis() - start > UPDATE_DOWNLOAD_WIFI_TIMEOUT ) {
+            log_e("no wifi, pause download");
+            return( false );
+        }
+        delay( 250 );
+    }
+    return( true );
+}
+
+/*
+ * a pending download is only valid for the firmware that has started it, after
+ * an update the other ota partition is the target
+ */
+static bool update_download_load_state( update_download_state_t *state ) {
+    if ( !SPIFFS.exists( UPDATE_DOWNLOAD_RESUME_FILE ) ) {
+        return( false );
+    }
+
+    fs::File file = SPIFFS.open( UPDATE_DOWNLOAD_RESUME_FILE, FILE_READ );
+    if ( !file ) {
+        log_e("Can't open file: %s!", UPDATE_DOWNLOAD_RESUME_FILE );
+        return( false );
+    }
+
+    SpiRamJsonDocument doc( 1000 );
+    DeserializationError error = deserializeJson( doc, file );
+    file.close();
+    if ( error ) {
+        log_e("update resume deserializeJson() failed: %s", error.c_str() );
+        return( false );
+    }
+
+    strlcpy( state->url, doc["url"] | "", sizeof( state->url ) );
+    strlcpy( state->sha256, doc["sha256"] | "", sizeof( state->sha256 ) );
+    strlcpy( state->etag, doc["etag"] | "", sizeof( state->etag ) );
+    strlcpy( state->firmware, doc["firmware"] | "", sizeof( state->firmware ) );
+    strlcpy( state->written_sha256, doc["written_sha256"] | "", sizeof( state->written_sha256 ) );
+    state->offset = doc["offset"] | 0;
+    state->total = doc["total"] | 0;
+    doc.clear();
+
+    return( *state->url && state->offset && !strcmp( state->firmware, __FIRMWARE__ ) );
+}
+
+static void update_download_save_state( update_download_state_t *state ) {
+    fs::File file = SPIFFS.open( UPDATE_DOWNLOAD_RESUME_FILE, FILE_WRITE );
+
+    if (!file) {
+        log_e("Can't open file: %s!", UPDATE_DOWNLOAD_RESUME_FILE );
+        return;
+    }
+
+    SpiRamJsonDocument doc( 1000 );
+
+    doc["url"] = state->url;
+    doc["sha256"] = state->sha256;
+    doc["etag"] = state->etag;
+    doc["firmware"] = state->firmware;
+    doc["written_sha256"] = state->written_sha256;
+    doc["offset"] = state->offset;
+    doc["total"] = state->total;
+
+    if ( serializeJson( doc, file ) == 0) {
+        log_e("Failed to write resume file");
+    }
+    doc.clear();
+    file.close();
+}
+
+static void update_download_remove_state( void ) {
+    if ( SPIFFS.exists( UPDATE_DOWNLOAD_RESUME_FILE ) ) {
+        SPIFFS.remove( UPDATE_DOWNLOAD_RESUME_FILE );
+    }
+}
@@ -0,0 +1,75 @@
+/****************************************************************************
+ *   Sep 09 20:12:45 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+ 
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _UPDATE_DOWNLOAD_H
+    #define _UPDATE_DOWNLOAD_H
+
+    #include <TTGO.h>
+    #include "hardware/httpctl.h"
+    #include "hardware/otaupdate.h"
+
+    #define UPDATE_DOWNLOAD_BUFFER_SIZE     1024        /** @brief bytes read from the connection at once */
+    #define UPDATE_DOWNLOAD_RESUME_FILE     "/update_resume.json"
+    #define UPDATE_DOWNLOAD_RETRIES         5           /** @brief reconnects within one download */
+    #define UPDATE_DOWNLOAD_WIFI_TIMEOUT    30000       /** @brief max time in ms to wait for the wifi after a lost connection */
+    #define UPDATE_DOWNLOAD_PAUSED          -2          /** @brief the download is paused and can be resumed */
+
+    /*
+     * @brief resume state, saved to UPDATE_DOWNLOAD_RESUME_FILE when a download is interrupted
+     */
+    typedef struct {
+        char url[ 256 ] = "";
+        char sha256[ OTAUPDATE_SHA256_LEN + 1 ] = "";             /** @brief expected sha256 of the image or empty */
+        char etag[ HTTPCTL_ETAG_SIZE ] = "";                      /** @brief the file must not change between the parts */
+        char firmware[ 16 ] = "";                                 /** @brief firmware version that has started the download */
+        char written_sha256[ OTAUPDATE_SHA256_LEN + 1 ] = "";     /** @brief sha256 of the part in the flash */
+        uint32_t offset = 0;                                      /** @brief bytes in the flash */
+        uint32_t total = 0;                                       /** @brief size of the image or 0 if unknown */
+    } update_download_state_t;
+
+    /*
+     * @brief download a firmware or a delta patch and write it with otaupdate,
+     * the new image is only activated if it is complete and verified. if the
+     * connection is lost a firmware download continues with a range request
+     * after the wifi is back, a delta patch starts again
+     *
+     * @param   url         url of the firmware or patch
+     * @param   sha256      expected sha256 of the image as hex string or NULL
+     *
+     * @return  200 if the new image is activated, the http status code if the
+     *          server has no such file, UPDATE_DOWNLOAD_PAUSED if the wifi is
+     *          gone and the download can be resumed or -1 if fail
+     */
+    int update_download( const char *url, const char *sha256 );
+    /*
+     * @brief continue an interrupted download, also after a restart
+     *
+     * @return  same as update_download() or -1 if no download is pending
+     */
+    int update_download_resume( void );
+    /*
+     * @brief check if an interrupted download of the running firmware can be resumed
+     *
+     * @return  true if a download is pending
+     */
+    bool update_download_is_pending( void );
+
+#endif // _UPDATE_DOWNLOAD_H
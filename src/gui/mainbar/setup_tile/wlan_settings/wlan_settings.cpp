@@ -31,6 +31,7 @@
 #include "hardware/motor.h"
 #include "webserver/webserver.h"
 #include "hardware/blectl.h"
+#include "hardware/configapi.h"
 #include "hardware/json_psram_allocator.h"
 
 #include <WiFi.h>
@@ -303,6 +304,7 @@ lv_obj_t *wifi_webserver_onoff;
 static void wps_start_event_handler( lv_obj_t * obj, lv_event_t event );
 static void wifi_autoon_onoff_event_handler( lv_obj_t * obj, lv_event_t event );
 static void wifi_webserver_onoff_event_handler( lv_obj_t * obj, lv_event_t event );
+static void wlan_setup_refresh( void );
 
 void wlan_setup_tile_setup( uint32_t wifi_setup_tile_num ) {
     // get an app tile and copy mainstyle
@@ -365,6 +367,16 @@ void wlan_setup_tile_setup( uint32_t wifi_setup_tile_num ) {
     lv_obj_t *wps_btn_label = lv_label_create( wps_btn, NULL );
     lv_label_set_text( wps_btn_label, "start WPS");
 
+    blectl_register_cb( BLECTL_MSG, bluetooth_message_event_cb );
+
+    wlan_setup_refresh();
+    configapi_register_cb( wlan_setup_refresh );
+}
+
+/*
+ * show the current settings, also called when they are changed over the webserver
+ */
+static void wlan_setup_refresh( void ) {
     if ( wifictl_get_autoon() )
         lv_switch_on( wifi_autoon_onoff, LV_ANIM_OFF);
     else
@@ -374,8 +386,6 @@ void wlan_setup_tile_setup( uint32_t wifi_setup_tile_num ) {
         lv_switch_on( wifi_webserver_onoff, LV_ANIM_OFF);
     else
         lv_switch_off( wifi_webserver_onoff, LV_ANIM_OFF);
-
-    blectl_register_cb( BLECTL_MSG, bluetooth_message_event_cb );
 }
 
 static void wps_start_event_handler( lv_obj_t * obj, lv_event_t event ) {
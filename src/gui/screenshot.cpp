@@ -23,8 +23,18 @@
 #include "screenshot.h"
 
 uint16_t *png;
+static bool screenshot_streaming = false;
+portMUX_TYPE screenshotMux = portMUX_INITIALIZER_UNLOCKED;
 
-static void screenshot_disp_flush( lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p );
+#ifdef SCREENSHOT_SHADOW_FRAMEBUFFER
+    static uint16_t *screenshot_shadow = NULL;
+    static SemaphoreHandle_t screenshot_shadow_mutex = NULL;
+    static void ( * screenshot_display_flush_cb )( lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p ) = NULL;
+    static SCREENSHOT_FLUSH_CALLBACK_FUNC screenshot_flush_cb = NULL;
+    static void screenshot_shadow_flush( lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p );
+#else
+    static void screenshot_disp_flush( lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p );
+#endif
 
 void screenshot_setup( void ) {
     png = (uint16_t*)ps_malloc( lv_disp_get_hor_res( NULL ) * lv_disp_get_ver_res( NULL ) * sizeof( lv_color_t ) );
@@ -32,8 +42,76 @@ void screenshot_setup( void ) {
         log_e("screenshot malloc failed");
         while(1);
     }
+
+#ifdef SCREENSHOT_SHADOW_FRAMEBUFFER
+    screenshot_shadow = (uint16_t*)ps_calloc( lv_disp_get_hor_res( NULL ) * lv_disp_get_ver_res( NULL ), sizeof( lv_color_t ) );
+    if ( screenshot_shadow == NULL ) {
+        log_e("screenshot shadow calloc failed");
+        while(1);
+    }
+    screenshot_shadow_mutex = xSemaphoreCreateMutex();
+
+    /*
+     * hook into the display flush, every flushed area is also copied into the shadow framebuffer
+     */
+    lv_disp_t *system_disp = lv_disp_get_default();
+    screenshot_display_flush_cb = system_disp->driver.flush_cb;
+    system_disp->driver.flush_cb = screenshot_shadow_flush;
+#endif
+}
+
+/*
+ * copy a flushed area row by row into a full size framebuffer
+ */
+static void screenshot_copy_area( uint16_t *framebuffer, const lv_area_t *area, lv_color_t *color_p ) {
+    uint32_t y;
+    uint32_t width = area->x2 - area->x1 + 1;
+    lv_coord_t hor_res = lv_disp_get_hor_res( NULL );
+    uint16_t *data = (uint16_t *)color_p;
+
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy( framebuffer + ( y * hor_res + area->x1 ), data, width * sizeof( uint16_t ) );
+        data += width;
+    }
+}
+
+#ifdef SCREENSHOT_SHADOW_FRAMEBUFFER
+
+void screenshot_take( void ) {
+    xSemaphoreTake( screenshot_shadow_mutex, portMAX_DELAY );
+    memcpy( png, screenshot_shadow, lv_disp_get_hor_res( NULL ) * lv_disp_get_ver_res( NULL ) * sizeof( lv_color_t ) );
+    xSemaphoreGive( screenshot_shadow_mutex );
+}
+
+static void screenshot_shadow_flush( lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p ) {
+    xSemaphoreTake( screenshot_shadow_mutex, portMAX_DELAY );
+    screenshot_copy_area( screenshot_shadow, area, color_p );
+    xSemaphoreGive( screenshot_shadow_mutex );
+    if ( screenshot_flush_cb ) {
+        screenshot_flush_cb( area );
+    }
+    screenshot_display_flush_cb( disp_drv, area, color_p );
 }
 
+void screenshot_register_flush_cb( SCREENSHOT_FLUSH_CALLBACK_FUNC flush_cb ) {
+    screenshot_flush_cb = flush_cb;
+}
+
+void screenshot_shadow_read( const lv_area_t *area, uint16_t *dest ) {
+    uint32_t y;
+    uint32_t width = area->x2 - area->x1 + 1;
+    lv_coord_t hor_res = lv_disp_get_hor_res( NULL );
+
+    xSemaphoreTake( screenshot_shadow_mutex, portMAX_DELAY );
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy( dest, screenshot_shadow + ( y * hor_res + area->x1 ), width * sizeof( uint16_t ) );
+        dest += width;
+    }
+    xSemaphoreGive( screenshot_shadow_mutex );
+}
+
+#else
+
 void screenshot_take( void ) {
     lv_disp_drv_t driver;
     lv_disp_t *system_disp;;
@@ -46,24 +124,37 @@ void screenshot_take( void ) {
     system_disp->driver.flush_cb = driver.flush_cb;
 }
 
-void screenshot_save( void ) {
-    SPIFFS.remove( SCREENSHOT_FILE_NAME );
-    fs::File file = SPIFFS.open( SCREENSHOT_FILE_NAME, FILE_WRITE );
-    
-    file.write( (uint8_t *)png, lv_disp_get_hor_res( NULL ) * lv_disp_get_ver_res( NULL ) * 2 );
-    file.close();
+static void screenshot_disp_flush( lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p ) {
+    screenshot_copy_area( png, area, color_p );
+    lv_disp_flush_ready(disp_drv);
 }
 
-static void screenshot_disp_flush( lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p ) {
+#endif // SCREENSHOT_SHADOW_FRAMEBUFFER
 
-    uint32_t x, y;
-    uint16_t *data = (uint16_t *)color_p;
+screenshot_encoder_t *screenshot_stream_open( screenshot_format_t format ) {
+    portENTER_CRITICAL( &screenshotMux );
+    if ( screenshot_streaming ) {
+        portEXIT_CRITICAL( &screenshotMux );
+        log_e("screenshot stream busy");
+        return( NULL );
+    }
+    screenshot_streaming = true;
+    portEXIT_CRITICAL( &screenshotMux );
 
-    for(y = area->y1; y <= area->y2; y++) {
-        for(x = area->x1; x <= area->x2; x++) {
-            *(png + (y * lv_disp_get_hor_res( NULL ) + x )) = *data;
-            data++;
-        }
-    } 
-    lv_disp_flush_ready(disp_drv);
+    screenshot_take();
+    screenshot_encoder_t *encoder = screenshot_encoder_open( format, png, lv_disp_get_hor_res( NULL ), lv_disp_get_ver_res( NULL ), LV_COLOR_16_SWAP );
+    if ( encoder == NULL ) {
+        portENTER_CRITICAL( &screenshotMux );
+        screenshot_streaming = false;
+        portEXIT_CRITICAL( &screenshotMux );
+    }
+    return( encoder );
+}
+
+void screenshot_stream_close( screenshot_encoder_t *encoder ) {
+    screenshot_encoder_close( encoder );
+    portENTER_CRITICAL( &screenshotMux );
+    screenshot_streaming = false;
+    portEXIT_CRITICAL( &screenshotMux );
 }
+
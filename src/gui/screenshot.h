@@ -23,21 +23,53 @@
     #define _SCREENSHOT_H
 
     #include "config.h"
+    #include "screenshot_encoder.h"
 
-    #define SCREENSHOT_FILE_NAME    "/screen.data"
+    #define SCREENSHOT_SHADOW_FRAMEBUFFER       // comment to disable, screenshots force a full redraw without it
+
+    typedef void ( * SCREENSHOT_FLUSH_CALLBACK_FUNC ) ( const lv_area_t *area );
 
     /*
      * @brief setup screenshot
      */
     void screenshot_setup( void );
     /*
-     * @brief take a screenshoot an store it in psram
+     * @brief take a screenshoot an store it in psram. with SCREENSHOT_SHADOW_FRAMEBUFFER
+     * this is a copy of the shadow framebuffer, otherwise the screen is redrawn
      */
     void screenshot_take( void );
     /*
-     * @brief store a screenshoot from psram to spiffs
+     * @brief take a screenshot and start encoding it, the psram buffer is read while
+     * the image is send. only one stream at a time is possible
+     *
+     * @param   format  SCREENSHOT_RAW, SCREENSHOT_PNG or SCREENSHOT_QOI
+     *
+     * @return  pointer to the encoder or NULL if busy
+     */
+    screenshot_encoder_t *screenshot_stream_open( screenshot_format_t format );
+    /*
+     * @brief finish a screenshot stream
+     *
+     * @param   encoder pointer to the encoder from screenshot_stream_open
+     */
+    void screenshot_stream_close( screenshot_encoder_t *encoder );
+
+#ifdef SCREENSHOT_SHADOW_FRAMEBUFFER
+    /*
+     * @brief register a callback that is called after each flushed area is copied into
+     * the shadow framebuffer. it is called from the lvgl task and must be fast
+     *
+     * @param   flush_cb    pointer to the callback function or NULL to remove it
+     */
+    void screenshot_register_flush_cb( SCREENSHOT_FLUSH_CALLBACK_FUNC flush_cb );
+    /*
+     * @brief copy an area from the shadow framebuffer
+     *
+     * @param   area        area to copy
+     * @param   dest        destination with space for the pixels of the area, row by row
      */
-    void screenshot_save( void );
+    void screenshot_shadow_read( const lv_area_t *area, uint16_t *dest );
+#endif
 
 /*
     struct PNG_IMAGE {
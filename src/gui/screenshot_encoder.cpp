@@ -0,0 +1,375 @@
+/****************************************************************************
+ *   Sep 02 20:14:31 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include "screenshot_encoder.h"
+
+#define SCREENSHOT_ENCODER_HEADER       0
+#define SCREENSHOT_ENCODER_ROWS         1
+#define SCREENSHOT_ENCODER_TRAILER      2
+#define SCREENSHOT_ENCODER_DONE         3
+
+#define QOI_OP_INDEX                    0x00
+#define QOI_OP_DIFF                     0x40
+#define QOI_OP_LUMA                     0x80
+#define QOI_OP_RUN                      0xc0
+#define QOI_OP_RGB                      0xfe
+
+static uint32_t screenshot_encoder_crc_table[ 256 ];
+static bool screenshot_encoder_crc_table_valid = false;
+
+static bool screenshot_encoder_fill( screenshot_encoder_t *encoder );
+static void screenshot_encoder_png_header( screenshot_encoder_t *encoder );
+static void screenshot_encoder_png_row( screenshot_encoder_t *encoder );
+static void screenshot_encoder_png_trailer( screenshot_encoder_t *encoder );
+static void screenshot_encoder_qoi_header( screenshot_encoder_t *encoder );
+static void screenshot_encoder_qoi_row( screenshot_encoder_t *encoder );
+static void screenshot_encoder_qoi_trailer( screenshot_encoder_t *encoder );
+
+screenshot_encoder_t *screenshot_encoder_open( screenshot_format_t format, const uint16_t *framebuffer, uint16_t width, uint16_t height, bool swap ) {
+    screenshot_encoder_t *encoder = ( screenshot_encoder_t * )ps_calloc( sizeof( screenshot_encoder_t ), 1 );
+    if ( encoder == NULL ) {
+        log_e("screenshot encoder calloc failed");
+        return( NULL );
+    }
+
+    encoder->format = format;
+    encoder->framebuffer = framebuffer;
+    encoder->width = width;
+    encoder->height = height;
+    encoder->swap = swap;
+    encoder->state = SCREENSHOT_ENCODER_HEADER;
+
+    /*
+     * raw is read straight from the framebuffer, png and qoi need space for one row:
+     * png: block header + filter byte + 3 byte per pixel, qoi: max 4 byte per pixel
+     */
+    if ( format != SCREENSHOT_RAW ) {
+        encoder->buf = ( uint8_t * )ps_malloc( width * 4 + 64 );
+        if ( encoder->buf == NULL ) {
+            log_e("screenshot encoder malloc failed");
+            free( encoder );
+            return( NULL );
+        }
+    }
+
+    if ( !screenshot_encoder_crc_table_valid ) {
+        for ( uint32_t n = 0 ; n < 256 ; n++ ) {
+            uint32_t c = n;
+            for ( int k = 0 ; k < 8 ; k++ ) {
+                c = ( c & 1 ) ? 0xedb88320 ^ ( c >> 1 ) : c >> 1;
+            }
+            screenshot_encoder_crc_table[ n ] = c;
+        }
+        screenshot_encoder_crc_table_valid = true;
+    }
+
+    return( encoder );
+}
+
+size_t screenshot_encoder_read( screenshot_encoder_t *encoder, uint8_t *buf, size_t size ) {
+    size_t len = 0;
+
+    if ( encoder->format == SCREENSHOT_RAW ) {
+        size_t total = encoder->width * encoder->height * sizeof( uint16_t );
+        len = total - encoder->raw_pos < size ? total - encoder->raw_pos : size;
+        memcpy( buf, ( const uint8_t * )encoder->framebuffer + encoder->raw_pos, len );
+        encoder->raw_pos += len;
+        return( len );
+    }
+
+    while( len < size ) {
+        if ( encoder->buf_pos == encoder->buf_len && !screenshot_encoder_fill( encoder ) ) {
+            break;
+        }
+        size_t chunk = encoder->buf_len - encoder->buf_pos < size - len ? encoder->buf_len - encoder->buf_pos : size - len;
+        memcpy( buf + len, encoder->buf + encoder->buf_pos, chunk );
+        encoder->buf_pos += chunk;
+        len += chunk;
+    }
+    return( len );
+}
+
+void screenshot_encoder_close( screenshot_encoder_t *encoder ) {
+    if ( encoder == NULL ) {
+        return;
+    }
+    free( encoder->buf );
+    free( encoder );
+}
+
+bool screenshot_encoder_get_format( const char *name, screenshot_format_t *format ) {
+    if ( !strcmp( name, "raw" ) ) {
+        *format = SCREENSHOT_RAW;
+    }
+    else if ( !strcmp( name, "png" ) ) {
+        *format = SCREENSHOT_PNG;
+    }
+    else if ( !strcmp( name, "qoi" ) ) {
+        *format = SCREENSHOT_QOI;
+    }
+    else {
+        return( false );
+    }
+    return( true );
+}
+
+const char *screenshot_encoder_get_mime_type( screenshot_format_t format ) {
+    switch( format ) {
+        case SCREENSHOT_PNG:    return( "image/png" );
+        case SCREENSHOT_QOI:    return( "image/qoi" );
+        default:                return( "application/octet-stream" );
+    }
+}
+
+/*
+ * encode the next part into the row buffer, return false at the end of the image
+ */
+static bool screenshot_encoder_fill( screenshot_encoder_t *encoder ) {
+    encoder->buf_len = 0;
+    encoder->buf_pos = 0;
+
+    switch( encoder->state ) {
+        case SCREENSHOT_ENCODER_HEADER:
+            if ( encoder->format == SCREENSHOT_PNG ) {
+                screenshot_encoder_png_header( encoder );
+            }
+            else {
+                screenshot_encoder_qoi_header( encoder );
+            }
+            encoder->state = SCREENSHOT_ENCODER_ROWS;
+            break;
+        case SCREENSHOT_ENCODER_ROWS:
+            if ( encoder->format == SCREENSHOT_PNG ) {
+                screenshot_encoder_png_row( encoder );
+            }
+            else {
+                screenshot_encoder_qoi_row( encoder );
+            }
+            encoder->row++;
+            if ( encoder->row == encoder->height ) {
+                encoder->state = SCREENSHOT_ENCODER_TRAILER;
+            }
+            break;
+        case SCREENSHOT_ENCODER_TRAILER:
+            if ( encoder->format == SCREENSHOT_PNG ) {
+                screenshot_encoder_png_trailer( encoder );
+            }
+            else {
+                screenshot_encoder_qoi_trailer( encoder );
+            }
+            encoder->state = SCREENSHOT_ENCODER_DONE;
+            break;
+        default:
+            return( false );
+    }
+    return( true );
+}
+
+static inline void screenshot_encoder_get_rgb( screenshot_encoder_t *encoder, uint16_t pixel, uint8_t *r, uint8_t *g, uint8_t *b ) {
+    if ( encoder->swap ) {
+        pixel = ( pixel >> 8 ) | ( pixel << 8 );
+    }
+    *r = ( ( pixel >> 8 ) & 0xf8 ) | ( pixel >> 13 );
+    *g = ( ( pixel >> 3 ) & 0xfc ) | ( ( pixel >> 9 ) & 0x03 );
+    *b = ( ( pixel << 3 ) & 0xf8 ) | ( ( pixel >> 2 ) & 0x07 );
+}
+
+static inline void screenshot_encoder_put32( uint8_t *buf, uint32_t value ) {
+    buf[ 0 ] = value >> 24;
+    buf[ 1 ] = value >> 16;
+    buf[ 2 ] = value >> 8;
+    buf[ 3 ] = value;
+}
+
+static uint32_t screenshot_encoder_crc( uint32_t crc, const uint8_t *data, size_t len ) {
+    while( len-- ) {
+        crc = screenshot_encoder_crc_table[ ( crc ^ *data++ ) & 0xff ] ^ ( crc >> 8 );
+    }
+    return( crc );
+}
+
+/*
+ * png: signature, IHDR and the start of one IDAT chunk. the zlib stream use one
+ * stored deflate block per row, so the IDAT length is known in advance
+ */
+static void screenshot_encoder_png_header( screenshot_encoder_t *encoder ) {
+    static const uint8_t signature[ 8 ] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    uint8_t *buf = encoder->buf;
+    uint32_t row_size = 1 + encoder->width * 3;
+    uint32_t idat_size = 2 + encoder->height * ( 5 + row_size ) + 4;
+
+    memcpy( buf, signature, sizeof( signature ) );
+    screenshot_encoder_put32( buf + 8, 13 );
+    memcpy( buf + 12, "IHDR", 4 );
+    screenshot_encoder_put32( buf + 16, encoder->width );
+    screenshot_encoder_put32( buf + 20, encoder->height );
+    buf[ 24 ] = 8;          // bit depth
+    buf[ 25 ] = 2;          // truecolor
+    buf[ 26 ] = 0;          // deflate
+    buf[ 27 ] = 0;          // adaptive filter
+    buf[ 28 ] = 0;          // no interlace
+    screenshot_encoder_put32( buf + 29, screenshot_encoder_crc( 0xffffffff, buf + 12, 17 ) ^ 0xffffffff );
+
+    screenshot_encoder_put32( buf + 33, idat_size );
+    memcpy( buf + 37, "IDAT", 4 );
+    buf[ 41 ] = 0x78;       // zlib, 32k window
+    buf[ 42 ] = 0x01;       // no compression level, check bits
+    encoder->crc = screenshot_encoder_crc( 0xffffffff, buf + 37, 6 );
+    encoder->adler_a = 1;
+    encoder->adler_b = 0;
+    encoder->buf_len = 43;
+}
+
+static void screenshot_encoder_png_row( screenshot_encoder_t *encoder ) {
+    const uint16_t *pixel = encoder->framebuffer + encoder->row * encoder->width;
+    uint8_t *buf = encoder->buf;
+    uint16_t row_size = 1 + encoder->width * 3;
+    uint32_t a = encoder->adler_a;
+    uint32_t b = encoder->adler_b;
+
+    buf[ 0 ] = encoder->row == encoder->height - 1 ? 1 : 0;
+    buf[ 1 ] = row_size & 0xff;
+    buf[ 2 ] = row_size >> 8;
+    buf[ 3 ] = ~row_size & 0xff;
+    buf[ 4 ] = ~row_size >> 8;
+    buf[ 5 ] = 0;           // filter type none
+
+    uint8_t *p = buf + 6;
+    for ( int x = 0 ; x < encoder->width ; x++ ) {
+        screenshot_encoder_get_rgb( encoder, *pixel++, p, p + 1, p + 2 );
+        p += 3;
+    }
+
+    /*
+     * a row is short enough to take the modulo only once per row
+     */
+    for ( int i = 5 ; i < 5 + row_size ; i++ ) {
+        a += buf[ i ];
+        b += a;
+    }
+    encoder->adler_a = a % 65521;
+    encoder->adler_b = b % 65521;
+
+    encoder->buf_len = 5 + row_size;
+    encoder->crc = screenshot_encoder_crc( encoder->crc, buf, encoder->buf_len );
+}
+
+static void screenshot_encoder_png_trailer( screenshot_encoder_t *encoder ) {
+    static const uint8_t iend[ 12 ] = { 0, 0, 0, 0, 'I', 'E', 'N', 'D', 0xae, 0x42, 0x60, 0x82 };
+    uint8_t *buf = encoder->buf;
+
+    screenshot_encoder_put32( buf, ( encoder->adler_b << 16 ) | encoder->adler_a );
+    screenshot_encoder_put32( buf + 4, screenshot_encoder_crc( encoder->crc, buf, 4 ) ^ 0xffffffff );
+    memcpy( buf + 8, iend, sizeof( iend ) );
+    encoder->buf_len = 8 + sizeof( iend );
+}
+
+/*
+ * qoi: header, pixel ops and end marker. the run is carried over the row end
+ */
+static void screenshot_encoder_qoi_header( screenshot_encoder_t *encoder ) {
+    uint8_t *buf = encoder->buf;
+
+    memcpy( buf, "qoif", 4 );
+    screenshot_encoder_put32( buf + 4, encoder->width );
+    screenshot_encoder_put32( buf + 8, encoder->height );
+    buf[ 12 ] = 3;          // rgb
+    buf[ 13 ] = 0;          // srgb
+    encoder->buf_len = 14;
+
+    memset( encoder->qoi_index, 0, sizeof( encoder->qoi_index ) );
+    encoder->qoi_prev = 0x000000ff;
+    encoder->qoi_run = 0;
+}
+
+static void screenshot_encoder_qoi_row( screenshot_encoder_t *encoder ) {
+    const uint16_t *pixel = encoder->framebuffer + encoder->row * encoder->width;
+    uint8_t *p = encoder->buf;
+    uint32_t prev = encoder->qoi_prev;
+    uint8_t run = encoder->qoi_run;
+
+    for ( int x = 0 ; x < encoder->width ; x++ ) {
+        uint8_t r, g, b;
+
+        screenshot_encoder_get_rgb( encoder, *pixel++, &r, &g, &b );
+        uint32_t px = ( r << 24 ) | ( g << 16 ) | ( b << 8 ) | 0xff;
+
+        if ( px == prev ) {
+            run++;
+            if ( run == 62 ) {
+                *p++ = QOI_OP_RUN | ( run - 1 );
+                run = 0;
+            }
+            continue;
+        }
+        if ( run ) {
+            *p++ = QOI_OP_RUN | ( run - 1 );
+            run = 0;
+        }
+
+        uint8_t hash = ( r * 3 + g * 5 + b * 7 + 255 * 11 ) % 64;
+        if ( encoder->qoi_index[ hash ] == px ) {
+            *p++ = QOI_OP_INDEX | hash;
+        }
+        else {
+            encoder->qoi_index[ hash ] = px;
+
+            int8_t vr = r - ( prev >> 24 );
+            int8_t vg = g - ( ( prev >> 16 ) & 0xff );
+            int8_t vb = b - ( ( prev >> 8 ) & 0xff );
+            int8_t vg_r = vr - vg;
+            int8_t vg_b = vb - vg;
+
+            if ( vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2 ) {
+                *p++ = QOI_OP_DIFF | ( vr + 2 ) << 4 | ( vg + 2 ) << 2 | ( vb + 2 );
+            }
+            else if ( vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8 ) {
+                *p++ = QOI_OP_LUMA | ( vg + 32 );
+                *p++ = ( vg_r + 8 ) << 4 | ( vg_b + 8 );
+            }
+            else {
+                *p++ = QOI_OP_RGB;
+                *p++ = r;
+                *p++ = g;
+                *p++ = b;
+            }
+        }
+        prev = px;
+    }
+
+    encoder->qoi_prev = prev;
+    encoder->qoi_run = run;
+    encoder->buf_len = p - encoder->buf;
+}
+
+static void screenshot_encoder_qoi_trailer( screenshot_encoder_t *encoder ) {
+    static const uint8_t end_marker[ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    uint8_t *p = encoder->buf;
+
+    if ( encoder->qoi_run ) {
+        *p++ = QOI_OP_RUN | ( encoder->qoi_run - 1 );
+        encoder->qoi_run = 0;
+    }
+    memcpy( p, end_marker, sizeof( end_marker ) );
+    p += sizeof( end_marker );
+    encoder->buf_len = p - encoder->buf;
+}
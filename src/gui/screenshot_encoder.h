@@ -0,0 +1,102 @@
+/****************************************************************************
+ *   Sep 02 20:14:31 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _SCREENSHOT_ENCODER_H
+    #define _SCREENSHOT_ENCODER_H
+
+    #include "config.h"
+
+    typedef enum {
+        SCREENSHOT_RAW = 0,                         /** @brief RGB565 as stored in the framebuffer */
+        SCREENSHOT_PNG,                             /** @brief 24bit png with uncompressed deflate blocks */
+        SCREENSHOT_QOI                              /** @brief 24bit qoi */
+    } screenshot_format_t;
+
+    /*
+     * @brief encoder state, the image is encoded row by row while it is read
+     */
+    typedef struct {
+        screenshot_format_t format;
+        const uint16_t *framebuffer;                /** @brief RGB565 pixels */
+        uint16_t width;
+        uint16_t height;
+        bool swap;                                  /** @brief pixels are stored byte swapped */
+        uint8_t state;
+        uint16_t row;                               /** @brief next row to encode */
+        size_t raw_pos;                             /** @brief read position in the framebuffer for raw */
+        uint8_t *buf;                               /** @brief one encoded row */
+        size_t buf_len;
+        size_t buf_pos;
+        uint32_t crc;                               /** @brief png chunk crc */
+        uint32_t adler_a;                           /** @brief png zlib checksum */
+        uint32_t adler_b;
+        uint32_t qoi_index[ 64 ];                   /** @brief qoi color index */
+        uint32_t qoi_prev;                          /** @brief qoi previous pixel */
+        uint8_t qoi_run;                            /** @brief qoi run length */
+    } screenshot_encoder_t;
+
+    /*
+     * @brief start encoding a framebuffer, the framebuffer must not change until the encoder is closed
+     *
+     * @param   format      SCREENSHOT_RAW, SCREENSHOT_PNG or SCREENSHOT_QOI
+     * @param   framebuffer pointer to RGB565 pixels
+     * @param   width       width in pixel
+     * @param   height      height in pixel
+     * @param   swap        true if the pixels are stored byte swapped
+     *
+     * @return  pointer to the encoder or NULL if fail
+     */
+    screenshot_encoder_t *screenshot_encoder_open( screenshot_format_t format, const uint16_t *framebuffer, uint16_t width, uint16_t height, bool swap );
+    /*
+     * @brief read the next part of the encoded image
+     *
+     * @param   encoder     pointer to the encoder
+     * @param   buf         destination buffer
+     * @param   size        size of the destination buffer
+     *
+     * @return  number of bytes written to buf, 0 at the end of the image
+     */
+    size_t screenshot_encoder_read( screenshot_encoder_t *encoder, uint8_t *buf, size_t size );
+    /*
+     * @brief free the encoder
+     *
+     * @param   encoder     pointer to the encoder
+     */
+    void screenshot_encoder_close( screenshot_encoder_t *encoder );
+    /*
+     * @brief get the format from a name like "png"
+     *
+     * @param   name        "raw", "png" or "qoi"
+     * @param   format      pointer to the format
+     *
+     * @return  true if the name is known
+     */
+    bool screenshot_encoder_get_format( const char *name, screenshot_format_t *format );
+    /*
+     * @brief get the mime type of a format
+     *
+     * @param   format      SCREENSHOT_RAW, SCREENSHOT_PNG or SCREENSHOT_QOI
+     *
+     * @return  mime type like "image/png"
+     */
+    const char *screenshot_encoder_get_mime_type( screenshot_format_t format );
+
+#endif // _SCREENSHOT_ENCODER_H
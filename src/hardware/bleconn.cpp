@@ -0,0 +1,194 @@
+/****************************************************************************
+ *   Sep 13 09:48:02 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <string.h>
+
+#include "bleconn.h"
+
+/*
+ * the idle level is the slowest a phone accepts without trouble: max_int * ( latency + 1 )
+ * stays below 2s and the timeout is more than three times of it
+ */
+const bleconn_params_t bleconn_levels[ BLECONN_LEVELS ] = {
+    {   6,  12, 0, 400 },                           // bulk, 7.5-15ms
+    {  12,  24, 0, 400 },                           // burst, 15-30ms
+    {  48,  80, 0, 400 },                           // active, 60-100ms
+    { 320, 400, 3, 600 }                            // idle, 400-500ms, the watch wakes up every 2s
+};
+
+static const bleconn_adv_step_t bleconn_adv_steps[] = {
+    {   32,   48,  30000 },                         // 20-30ms right after the disconnect
+    {  244,  244, 120000 },                         // 152.5ms
+    {  874,  874, 600000 },                         // 546.25ms
+    { 2056, 2056,      0 }                          // 1285ms
+};
+#define BLECONN_ADV_STEPS   ( sizeof( bleconn_adv_steps ) / sizeof( bleconn_adv_step_t ) )
+
+static void bleconn_account( bleconn_t *conn, uint32_t now );
+
+void bleconn_init( bleconn_t *conn, uint32_t now ) {
+    memset( conn, 0, sizeof( bleconn_t ) );
+    conn->level = BLECONN_LEVEL_IDLE;
+    conn->requested = -1;
+    conn->adv_since = now;
+    conn->adv_pending = true;
+    conn->last_account = now;
+    conn->stats_since = now;
+}
+
+void bleconn_connect( bleconn_t *conn, uint32_t now ) {
+    bleconn_account( conn, now );
+    conn->connected = true;
+    conn->bulk = false;
+    conn->requested = -1;
+    conn->interval = 0;
+    conn->latency = 0;
+    // service discovery and the first sync come right after the connect
+    conn->level = BLECONN_LEVEL_BURST;
+    conn->last_activity = now;
+    conn->last_request = now - BLECONN_REQUEST_GAP;
+}
+
+void bleconn_disconnect( bleconn_t *conn, uint32_t now ) {
+    bleconn_account( conn, now );
+    conn->connected = false;
+    conn->bulk = false;
+    conn->adv_step = 0;
+    conn->adv_since = now;
+    conn->adv_pending = true;
+}
+
+void bleconn_activity( bleconn_t *conn, uint32_t now ) {
+    bleconn_account( conn, now );
+    conn->last_activity = now;
+    if ( conn->level > BLECONN_LEVEL_BURST ) {
+        conn->level = BLECONN_LEVEL_BURST;
+    }
+}
+
+void bleconn_bulk( bleconn_t *conn, bool bulk, uint32_t now ) {
+    bleconn_account( conn, now );
+    conn->bulk = bulk;
+    conn->last_activity = now;
+    conn->level = bulk ? BLECONN_LEVEL_BULK : BLECONN_LEVEL_BURST;
+}
+
+void bleconn_params( bleconn_t *conn, uint16_t interval, uint16_t latency, uint32_t now ) {
+    bleconn_account( conn, now );
+    conn->interval = interval;
+    conn->latency = latency;
+}
+
+uint32_t bleconn_loop( bleconn_t *conn, uint32_t now, bool advertising ) {
+    uint32_t retval = 0;
+
+    if ( advertising != conn->advertising ) {
+        bleconn_account( conn, now );
+        conn->advertising = advertising;
+    }
+
+    if ( conn->connected ) {
+        /*
+         * step down one level at a time, a transfer holds the bulk level
+         */
+        if ( !conn->bulk ) {
+            uint32_t quiet = now - conn->last_activity;
+            uint8_t level = quiet >= BLECONN_ACTIVE_HOLD ? BLECONN_LEVEL_IDLE : quiet >= BLECONN_BURST_HOLD ? BLECONN_LEVEL_ACTIVE : BLECONN_LEVEL_BURST;
+            if ( level > conn->level ) {
+                conn->level = level;
+            }
+        }
+        /*
+         * a faster level is requested at once, a slower one not more often than BLECONN_REQUEST_GAP
+         */
+        if ( conn->level != conn->requested && ( conn->requested < 0 || conn->level < conn->requested || now - conn->last_request >= BLECONN_REQUEST_GAP ) ) {
+            conn->requested = conn->level;
+            conn->last_request = now;
+            conn->requests++;
+            retval |= BLECONN_UPDATE_CONN;
+        }
+    }
+    else if ( advertising ) {
+        if ( bleconn_adv_steps[ conn->adv_step ].duration && now - conn->adv_since >= bleconn_adv_steps[ conn->adv_step ].duration ) {
+            bleconn_account( conn, now );
+            conn->adv_step++;
+            conn->adv_since = now;
+            conn->adv_pending = true;
+        }
+        if ( conn->adv_pending ) {
+            conn->adv_pending = false;
+            retval |= BLECONN_UPDATE_ADV;
+        }
+    }
+
+    if ( now - conn->stats_since >= BLECONN_STATS_PERIOD ) {
+        bleconn_account( conn, now );
+        retval |= BLECONN_STATS;
+    }
+    return( retval );
+}
+
+const bleconn_adv_step_t *bleconn_adv_step( bleconn_t *conn ) {
+    return( &bleconn_adv_steps[ conn->adv_step ] );
+}
+
+uint32_t bleconn_duty( bleconn_t *conn, uint32_t now ) {
+    bleconn_account( conn, now );
+    uint64_t elapsed = (uint64_t)( now - conn->stats_since ) * 1000;
+    uint64_t radio = (uint64_t)conn->conn_events * BLECONN_CONN_EVENT_US + (uint64_t)conn->adv_events * BLECONN_ADV_EVENT_US;
+
+    return( elapsed ? radio * 10000 / elapsed : 0 );
+}
+
+void bleconn_stats_reset( bleconn_t *conn, uint32_t now ) {
+    bleconn_account( conn, now );
+    conn->stats_since = now;
+    conn->conn_events = 0;
+    conn->adv_events = 0;
+    conn->requests = 0;
+}
+
+/*
+ * count the events since the last call with the parameters that were valid until now,
+ * without traffic the watch skips latency events
+ */
+static void bleconn_account( bleconn_t *conn, uint32_t now ) {
+    uint64_t elapsed = (uint64_t)( now - conn->last_account ) * 1000;
+
+    conn->last_account = now;
+    if ( conn->connected && conn->interval ) {
+        uint64_t period = (uint64_t)conn->interval * 1250;
+        if ( !conn->bulk && now - conn->last_activity >= BLECONN_BURST_HOLD ) {
+            period *= conn->latency + 1;
+        }
+        conn->conn_event_frac += elapsed;
+        conn->conn_events += conn->conn_event_frac / period;
+        conn->conn_event_frac %= period;
+    }
+    else if ( !conn->connected && conn->advertising ) {
+        const bleconn_adv_step_t *step = &bleconn_adv_steps[ conn->adv_step ];
+        // advInterval plus the random advDelay of 0-10ms
+        uint64_t period = (uint64_t)( step->min_int + step->max_int ) * 625 / 2 + 5000;
+        conn->adv_event_frac += elapsed;
+        conn->adv_events += conn->adv_event_frac / period;
+        conn->adv_event_frac %= period;
+    }
+}
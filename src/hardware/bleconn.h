@@ -0,0 +1,160 @@
+/****************************************************************************
+ *   Sep 13 09:48:02 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _BLECONN_H
+    #define _BLECONN_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    /*
+     * connection and advertising policy, no ble calls in here. blectl_loop() asks
+     * what to change and does it.
+     *
+     * a connection starts in BLECONN_LEVEL_BURST, traffic keeps it there. after
+     * BLECONN_BURST_HOLD without traffic it steps to BLECONN_LEVEL_ACTIVE and after
+     * BLECONN_ACTIVE_HOLD to BLECONN_LEVEL_IDLE with slave latency. a transfer holds
+     * BLECONN_LEVEL_BULK until it ends.
+     *
+     * advertising starts fast after a boot or disconnect and gets slower in steps
+     */
+    #define BLECONN_LEVEL_BULK          0
+    #define BLECONN_LEVEL_BURST         1
+    #define BLECONN_LEVEL_ACTIVE        2
+    #define BLECONN_LEVEL_IDLE          3
+    #define BLECONN_LEVELS              4
+
+    #define BLECONN_BURST_HOLD          5000        /** @brief ms without traffic before BLECONN_LEVEL_ACTIVE */
+    #define BLECONN_ACTIVE_HOLD         30000       /** @brief ms without traffic before BLECONN_LEVEL_IDLE */
+    #define BLECONN_REQUEST_GAP         2000        /** @brief ms between two requests, except for a faster level */
+    #define BLECONN_STATS_PERIOD        60000       /** @brief ms between two stats logs */
+
+    /*
+     * estimated radio time per event, an empty connection event is a short
+     * exchange of two packets, an advertising event three adv packets and a
+     * possible scan response
+     */
+    #define BLECONN_CONN_EVENT_US       400
+    #define BLECONN_ADV_EVENT_US        1500
+
+    #define BLECONN_UPDATE_CONN         _BV(0)      /** @brief request bleconn_levels[ level ] */
+    #define BLECONN_UPDATE_ADV          _BV(1)      /** @brief restart advertising with adv_min and adv_max */
+    #define BLECONN_STATS               _BV(2)      /** @brief log the stats and call bleconn_stats_reset() */
+
+    #ifndef _BV
+        #define _BV(bit) ( 1 << ( bit ) )
+    #endif
+
+    typedef struct {
+        uint16_t min_int;                           /** @brief in 1.25ms */
+        uint16_t max_int;                           /** @brief in 1.25ms */
+        uint16_t latency;                           /** @brief connection events the watch may skip */
+        uint16_t timeout;                           /** @brief supervision timeout in 10ms */
+    } bleconn_params_t;
+
+    typedef struct {
+        uint16_t min_int;                           /** @brief in 0.625ms */
+        uint16_t max_int;                           /** @brief in 0.625ms */
+        uint32_t duration;                          /** @brief ms until the next step, 0 for the last one */
+    } bleconn_adv_step_t;
+
+    extern const bleconn_params_t bleconn_levels[ BLECONN_LEVELS ];
+
+    typedef struct {
+        bool connected;
+        bool bulk;                                  /** @brief a transfer is running */
+        uint8_t level;                              /** @brief wanted level */
+        int8_t requested;                           /** @brief last requested level or -1 */
+        uint32_t last_activity;
+        uint32_t last_request;
+        uint16_t interval;                          /** @brief current interval in 1.25ms from the stack */
+        uint16_t latency;                           /** @brief current slave latency from the stack */
+        bool advertising;                           /** @brief advertising is enabled */
+        uint8_t adv_step;
+        uint32_t adv_since;
+        bool adv_pending;
+        uint32_t last_account;                      /** @brief time up to the events are counted */
+        uint32_t stats_since;
+        uint32_t conn_events;                       /** @brief estimated connection events since stats_since */
+        uint32_t adv_events;                        /** @brief estimated advertising events since stats_since */
+        uint64_t conn_event_frac;                   /** @brief remainder of the event counting in us */
+        uint64_t adv_event_frac;
+        uint32_t requests;                          /** @brief parameter requests since stats_since */
+    } bleconn_t;
+
+    /*
+     * @brief reset the policy, advertising starts with the fast step
+     *
+     * @param   conn        pointer to the policy state
+     * @param   now         time in ms
+     */
+    void bleconn_init( bleconn_t *conn, uint32_t now );
+    /*
+     * @brief a connection is established
+     */
+    void bleconn_connect( bleconn_t *conn, uint32_t now );
+    /*
+     * @brief the connection is lost, advertising starts again with the fast step
+     */
+    void bleconn_disconnect( bleconn_t *conn, uint32_t now );
+    /*
+     * @brief data was received or send
+     */
+    void bleconn_activity( bleconn_t *conn, uint32_t now );
+    /*
+     * @brief a transfer starts or ends
+     */
+    void bleconn_bulk( bleconn_t *conn, bool bulk, uint32_t now );
+    /*
+     * @brief the stack reports the parameters of the connection
+     *
+     * @param   conn        pointer to the policy state
+     * @param   interval    connection interval in 1.25ms
+     * @param   latency     slave latency
+     * @param   now         time in ms
+     */
+    void bleconn_params( bleconn_t *conn, uint16_t interval, uint16_t latency, uint32_t now );
+    /*
+     * @brief check what has to change
+     *
+     * @param   conn        pointer to the policy state
+     * @param   now         time in ms
+     * @param   advertising true if advertising is enabled
+     *
+     * @return  BLECONN_UPDATE_CONN, BLECONN_UPDATE_ADV and BLECONN_STATS as needed
+     */
+    uint32_t bleconn_loop( bleconn_t *conn, uint32_t now, bool advertising );
+    /*
+     * @brief the current advertising intervals in 0.625ms
+     */
+    const bleconn_adv_step_t *bleconn_adv_step( bleconn_t *conn );
+    /*
+     * @brief estimated radio duty cycle since the last stats reset
+     *
+     * @return  duty cycle in 1/10000
+     */
+    uint32_t bleconn_duty( bleconn_t *conn, uint32_t now );
+    /*
+     * @brief start a new stats period
+     */
+    void bleconn_stats_reset( bleconn_t *conn, uint32_t now );
+
+#endif // _BLECONN_H
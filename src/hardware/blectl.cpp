@@ -31,9 +31,17 @@
 #include <BLEServer.h>
 #include <BLEUtils.h>
 #include <BLE2902.h>
+#include <Update.h>
+#include "esp_ota_ops.h"
 
 #include "blectl.h"
 #include "json_psram_allocator.h"
+#include "configapi.h"
+#include "blexfer.h"
+#include "bleconn.h"
+#include "bleframer.h"
+#include "bleout.h"
+#include "otaupdate.h"
 
 #include "gui/statusbar.h"
 
@@ -54,8 +62,44 @@ uint8_t txValue = 0;
 BLECharacteristic *pBatteryLevelCharacteristic;
 BLECharacteristic *pBatteryPowerStateCharacteristic;
 
-char *gadgetbridge_msg = NULL;
-uint32_t gadgetbridge_msg_size = 0;
+static bleframer_t blectl_framer;
+uint32_t blectl_rx_bytes = 0;
+uint32_t blectl_rx_writes = 0;
+static uint16_t blectl_mtu = BLECTL_DEFAULT_MTU;
+
+BLECharacteristic *pXferControlCharacteristic;
+BLECharacteristic *pXferDataCharacteristic;
+static blexfer_t *blectl_xfer = NULL;
+static fs::File blectl_xfer_file;
+static bool blectl_xfer_restart = false;        /** @brief a new firmware is activated, restart after the disconnect */
+static bool blectl_xfer_disconnected = false;   /** @brief suspend the transfer in blectl_loop() */
+static QueueHandle_t blectl_xfer_queue = NULL;
+
+typedef struct {
+    uint8_t len;
+    uint8_t data[ BLEXFER_MAX_CMD ];
+} blectl_xfer_cmd_t;
+static esp_bd_addr_t blectl_remote_bda;
+
+static bool blectl_xfer_open( blexfer_t *xfer, uint32_t *offset, uint32_t *crc );
+static bool blectl_xfer_write( const uint8_t *data, size_t len );
+static bool blectl_xfer_close( blexfer_t *xfer, uint8_t reason );
+static void blectl_xfer_reply( const uint8_t *data, size_t len );
+static void blectl_xfer_save( blexfer_t *xfer, size_t offset, const char *written_sha256 );
+static bool blectl_xfer_crc_file( const char *filename, uint32_t *offset, uint32_t *crc );
+static bool blectl_xfer_crc_partition( size_t len, uint32_t *crc );
+static void blectl_xfer_loop( void );
+static bleconn_t blectl_conn;
+static bleout_t *blectl_out = NULL;
+static bleout_batch_t *blectl_out_batch = NULL;
+static uint32_t blectl_out_notifies = 0;                /** @brief counters at the last stats log */
+static uint32_t blectl_out_batches = 0;
+static uint32_t blectl_out_deduped = 0;
+static void blectl_activity( void );
+static void blectl_out_flush( void );
+static void blectl_advertising_update( void );
+static void blectl_gap_event_handler( esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param );
+static void blectl_gatts_event_handler( esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param );
 
 /*
  *
@@ -65,7 +109,15 @@ class BleCtlServerCallbacks: public BLEServerCallbacks {
         blectl_set_event( BLECTL_CONNECT );
         blectl_clear_event( BLECTL_DISCONNECT );
         blectl_send_event_cb( BLECTL_CONNECT, (char*)"connected" );
-        pServer->updateConnParams( param->connect.remote_bda, 500, 1000, 750, 10000 );
+        memcpy( blectl_remote_bda, param->connect.remote_bda, sizeof( esp_bd_addr_t ) );
+        // longer link layer packets, the phone starts the mtu exchange
+        blectl_mtu = BLECTL_DEFAULT_MTU;
+        esp_ble_gap_set_pkt_data_len( param->connect.remote_bda, BLECTL_DATA_LEN );
+        // the connection parameters follow the traffic, see blectl_loop()
+        portENTER_CRITICAL(&blectlMux);
+        bleconn_connect( &blectl_conn, millis() );
+        bleout_connect( blectl_out );
+        portEXIT_CRITICAL(&blectlMux);
         log_i("BLE connected");
     };
 
@@ -74,11 +126,13 @@ class BleCtlServerCallbacks: public BLEServerCallbacks {
         blectl_clear_event( BLECTL_CONNECT );
         blectl_send_event_cb( BLECTL_DISCONNECT, (char*)"disconnected" );
         log_i("BLE disconnected");
-        delay(500);
-        if ( blectl_get_advertising() ) {
-            pServer->getAdvertising()->start();
-            log_i("BLE advertising...");
-        }
+        // commands of the lost connection are dropped, blectl_loop() suspends the transfer
+        // or starts a new firmware and starts advertising again with the fast interval
+        xQueueReset( blectl_xfer_queue );
+        portENTER_CRITICAL(&blectlMux);
+        blectl_xfer_disconnected = true;
+        bleconn_disconnect( &blectl_conn, millis() );
+        portEXIT_CRITICAL(&blectlMux);
     }
 };
 
@@ -116,7 +170,7 @@ class BtlCtlSecurity : public BLESecurityCallbacks {
             if ( blectl_get_event( BLECTL_PIN_AUTH ) ) {
                 blectl_send_event_cb( BLECTL_PAIRING_ABORT, (char*)"abort" );
             }
-            pServer->startAdvertising();
+            BLEDevice::startAdvertising();
         }
 
         if ( blectl_get_event( BLECTL_PIN_AUTH ) ) {
@@ -125,97 +179,68 @@ class BtlCtlSecurity : public BLESecurityCallbacks {
     }
 };
 
-void blectl_add_char_to_gadgetbridge_msg( char msg_char ) {
-    gadgetbridge_msg_size++;
-
-    if ( gadgetbridge_msg == NULL ) {
-        gadgetbridge_msg = (char *)ps_calloc( gadgetbridge_msg_size + 1, 1 );
-        if ( gadgetbridge_msg == NULL ) {
-            log_e("gadgetbridge_msg alloc fail");
-            while(true);
-        }
-    }
-    else {
-        char *new_gadgetbridge_msg = NULL;
-        new_gadgetbridge_msg = (char *)ps_realloc( gadgetbridge_msg, gadgetbridge_msg_size + 1 );
-        if ( new_gadgetbridge_msg == NULL ) {
-            log_e("gadgetbridge_msg realloc fail");
-            while(true);            
-        }
-        gadgetbridge_msg = new_gadgetbridge_msg;
-    }
-    gadgetbridge_msg[ gadgetbridge_msg_size - 1 ] = msg_char;
-    gadgetbridge_msg[ gadgetbridge_msg_size ] = '\0';
+/*
+ * a complete gadgetbridge message from the framer
+ */
+static void blectl_framer_msg( uint8_t type, char *msg ) {
+    blectl_send_event_cb( type == BLEFRAMER_CMD ? BLECTL_CMD : BLECTL_MSG, msg );
 }
 
-void blectl_delete_gadgetbridge_msg ( void ) {
-    gadgetbridge_msg_size = 0;
+class BleCtlCallbacks : public BLECharacteristicCallbacks
+{
+    void onWrite(BLECharacteristic *pCharacteristic)
+    {
+        std::string value = pCharacteristic->getValue();
 
-    if ( gadgetbridge_msg == NULL ) {
-        gadgetbridge_msg = (char *)ps_calloc( gadgetbridge_msg_size + 1, 1 );
-        if ( gadgetbridge_msg == NULL ) {
-            log_e("gadgetbridge_msg alloc fail");
-            while(true);
-        }
+        blectl_rx_bytes += value.length();
+        blectl_rx_writes++;
+        blectl_activity();
+        bleframer_feed( &blectl_framer, value.data(), value.length() );
     }
-    else {
-        char *new_gadgetbridge_msg = NULL;
-        new_gadgetbridge_msg = (char *)ps_realloc( gadgetbridge_msg, gadgetbridge_msg_size + 1 );
-        if ( new_gadgetbridge_msg == NULL ) {
-            log_e("gadgetbridge_msg realloc fail");
-            while(true);            
+};
+
+class BleCtlXferControlCallbacks : public BLECharacteristicCallbacks
+{
+    void onWrite(BLECharacteristic *pCharacteristic)
+    {
+        blectl_xfer_cmd_t cmd;
+        size_t len = pCharacteristic->getValue().length();
+
+        // a too long command is cut and rejected by blexfer_control()
+        cmd.len = len > sizeof( cmd.data ) ? sizeof( cmd.data ) : len;
+        memcpy( cmd.data, pCharacteristic->getValue().data(), cmd.len );
+        if ( cmd.len && xQueueSend( blectl_xfer_queue, &cmd, 0 ) != pdTRUE ) {
+            const uint8_t busy[] = { BLEXFER_REPLY_ERROR, 'b', 'u', 's', 'y' };
+            blectl_xfer_reply( busy, sizeof( busy ) );
         }
-        gadgetbridge_msg = new_gadgetbridge_msg;
     }
-    gadgetbridge_msg[ gadgetbridge_msg_size ] = '\0';
-}
+};
 
-class BleCtlCallbacks : public BLECharacteristicCallbacks
+class BleCtlXferDataCallbacks : public BLECharacteristicCallbacks
 {
     void onWrite(BLECharacteristic *pCharacteristic)
     {
-        char *msg = (char *)ps_calloc( pCharacteristic->getValue().length() + 1, 1 );
-        if ( msg == NULL ) {
-            Serial.printf("ps_calloc fail\r\n");
-            return;
-        }
-        else {
-            strlcpy( msg, pCharacteristic->getValue().c_str(), pCharacteristic->getValue().length() + 1 );
-            for ( int i = 0 ; i < pCharacteristic->getValue().length(); i++ ) {
-                switch( msg[ i ] ) {
-                    case EndofText:         blectl_delete_gadgetbridge_msg();
-                                            log_i("attention, new link establish");
-                                            break;
-                    case DataLinkEscape:    blectl_delete_gadgetbridge_msg();
-                                            log_i("attention, new message");
-                                            break;
-                    case LineFeed:          log_i("message complete, fire BLTCTL_MSG callback");
-                                            if( gadgetbridge_msg[ 0 ] == 'G' && gadgetbridge_msg[ 1 ] == 'B' ) {
-                                                log_i("gadgetbridge message identified, cut down to json");
-                                                gadgetbridge_msg[ gadgetbridge_msg_size - 1 ] = '\0';
-                                                log_i("msg: %s", &gadgetbridge_msg[ 3 ] );
-                                                blectl_send_event_cb( BLECTL_MSG, &gadgetbridge_msg[ 3 ] );
-                                            }
-                                            else {
-                                                log_i("msg: %s", gadgetbridge_msg );
-                                                blectl_send_event_cb( BLECTL_MSG, gadgetbridge_msg );
-                                            }
-                                            break;
-                    default:                blectl_add_char_to_gadgetbridge_msg( msg[ i ] );
-                }
-            }
-            free(msg);
-        }
+        blectl_rx_bytes += pCharacteristic->getValue().length();
+        blexfer_data( blectl_xfer, (const uint8_t *)pCharacteristic->getValue().data(), pCharacteristic->getValue().length() );
     }
 };
 
+/*
+ * settings for /api/config
+ */
+static const configapi_field_t blectl_configapi_fields[] = {
+    CONFIGAPI_BOOL_FIELD( "advertising", []() -> bool { return( blectl_get_advertising() ); }, []( bool value ) { blectl_set_advertising( value ); } ),
+    CONFIGAPI_BOOL_FIELD( "enable_on_standby", []() -> bool { return( blectl_get_enable_on_standby() ); }, []( bool value ) { blectl_set_enable_on_standby( value ); } ),
+};
 
 /*
  *
  */
 void blectl_setup( void ) {
+    configapi_register( "blectl", blectl_configapi_fields, sizeof( blectl_configapi_fields ) / sizeof( configapi_field_t ), blectl_save_config );
 
     blectl_status = xEventGroupCreate();
+    bleframer_init( &blectl_framer, blectl_framer_msg );
 
     esp_bt_controller_enable( ESP_BT_MODE_BLE );
     esp_bt_controller_mem_release( ESP_BT_MODE_CLASSIC_BT );
@@ -230,6 +255,9 @@ void blectl_setup( void ) {
     BLEDevice::init("Espruino (T-Watch2020)");
     // The minimum power level (-12dbm) ESP_PWR_LVL_N12 was too low
     BLEDevice::setPower( ESP_PWR_LVL_N9 );
+    // allow a large mtu, the negotiated one is catched in blectl_gatts_event_handler
+    BLEDevice::setMTU( BLECTL_MTU );
+    BLEDevice::setCustomGattsHandler( blectl_gatts_event_handler );
 
     // Enable encryption
     BLEServer* pServer = BLEDevice::createServer();
@@ -262,6 +290,39 @@ void blectl_setup( void ) {
     pServer->getAdvertising()->addServiceUUID( pService->getUUID() );
 
 
+    // Create bulk transfer service, not advertised, the client finds it after the connect
+    blectl_out = (bleout_t *)ps_malloc( sizeof( bleout_t ) );
+    blectl_out_batch = (bleout_batch_t *)ps_malloc( sizeof( bleout_batch_t ) );
+    if ( blectl_out == NULL || blectl_out_batch == NULL ) {
+        log_e("blectl_out malloc faild");
+        while(true);
+    }
+    bleout_init( blectl_out );
+    bleout_char( blectl_out, BLECTL_OUT_BATTERY_LEVEL, BLECTL_BATTERY_LEVEL_INTERVAL );
+    bleout_char( blectl_out, BLECTL_OUT_BATTERY_POWER_STATE, BLECTL_BATTERY_POWER_STATE_INTERVAL );
+
+    blectl_xfer = (blexfer_t *)ps_malloc( sizeof( blexfer_t ) );
+    if ( blectl_xfer == NULL ) {
+        log_e("blectl_xfer malloc faild");
+        while(true);
+    }
+    blexfer_init( blectl_xfer, blectl_xfer_open, blectl_xfer_write, blectl_xfer_close, blectl_xfer_reply );
+    blectl_xfer_queue = xQueueCreate( BLECTL_XFER_QUEUE, sizeof( blectl_xfer_cmd_t ) );
+    if ( blectl_xfer_queue == NULL ) {
+        log_e("blectl_xfer_queue create faild");
+        while(true);
+    }
+    BLEService *pXferService = pServer->createService( BLEXFER_SERVICE_UUID );
+    pXferControlCharacteristic = pXferService->createCharacteristic( BLEXFER_CONTROL_CHARACTERISTIC_UUID, BLECharacteristic::PROPERTY_WRITE | BLECharacteristic::PROPERTY_NOTIFY );
+    pXferControlCharacteristic->setAccessPermissions(ESP_GATT_PERM_READ_ENCRYPTED | ESP_GATT_PERM_WRITE_ENCRYPTED);
+    pXferControlCharacteristic->addDescriptor( new BLE2902() );
+    pXferControlCharacteristic->setCallbacks( new BleCtlXferControlCallbacks() );
+    pXferDataCharacteristic = pXferService->createCharacteristic( BLEXFER_DATA_CHARACTERISTIC_UUID, BLECharacteristic::PROPERTY_WRITE_NR );
+    pXferDataCharacteristic->setAccessPermissions(ESP_GATT_PERM_READ_ENCRYPTED | ESP_GATT_PERM_WRITE_ENCRYPTED);
+    pXferDataCharacteristic->setCallbacks( new BleCtlXferDataCallbacks() );
+    pXferService->start();
+
+
     // Create device information service
     BLEService *pDeviceInformationService = pServer->createService(DEVICE_INFORMATION_SERVICE_UUID);
     // Create manufacturer name string Characteristic - 
@@ -295,17 +356,116 @@ void blectl_setup( void ) {
     // Start advertising battery service
     pServer->getAdvertising()->addServiceUUID( pBatteryService->getUUID() );
 
-    // Slow advertising interval for battery life
+    // Advertising starts fast and gets slower for battery life, see bleconn.cpp
     // The maximum 0x4000 interval of ~16 sec was too slow, I could not reliably connect
-    pServer->getAdvertising()->setMinInterval( 100 );
-    pServer->getAdvertising()->setMaxInterval( 200 );
+    bleconn_init( &blectl_conn, millis() );
+    BLEDevice::setCustomGapHandler( blectl_gap_event_handler );
+    blectl_loop();
+}
+
+/*
+ * apply the connection and advertising policy and log the link stats
+ */
+void blectl_loop( void ) {
+    bool advertising = blectl_get_advertising();
+
+    blectl_xfer_loop();
+
+    portENTER_CRITICAL(&blectlMux);
+    uint32_t update = bleconn_loop( &blectl_conn, millis(), advertising );
+    int8_t level = blectl_conn.requested;
+    portEXIT_CRITICAL(&blectlMux);
+
+    if ( update & BLECONN_UPDATE_CONN ) {
+        esp_ble_conn_update_params_t conn_params;
+
+        memcpy( conn_params.bda, blectl_remote_bda, sizeof( esp_bd_addr_t ) );
+        conn_params.min_int = bleconn_levels[ level ].min_int;
+        conn_params.max_int = bleconn_levels[ level ].max_int;
+        conn_params.latency = bleconn_levels[ level ].latency;
+        conn_params.timeout = bleconn_levels[ level ].timeout;
+        esp_ble_gap_update_conn_params( &conn_params );
+        log_i("BLE request interval %d-%dms, latency %d", conn_params.min_int * 5 / 4, conn_params.max_int * 5 / 4, conn_params.latency );
+    }
+    if ( update & BLECONN_UPDATE_ADV ) {
+        blectl_advertising_update();
+    }
+    if ( blectl_get_event( BLECTL_CONNECT ) ) {
+        blectl_out_flush();
+    }
+    if ( update & BLECONN_STATS ) {
+        portENTER_CRITICAL(&blectlMux);
+        uint32_t duty = bleconn_duty( &blectl_conn, millis() );
+        uint32_t conn_events = blectl_conn.conn_events;
+        uint32_t adv_events = blectl_conn.adv_events;
+        uint32_t requests = blectl_conn.requests;
+        uint16_t interval = blectl_conn.interval;
+        uint16_t latency = blectl_conn.latency;
+        uint32_t notifies = blectl_out->notifies - blectl_out_notifies;
+        uint32_t batches = blectl_out->batches - blectl_out_batches;
+        uint32_t deduped = blectl_out->deduped - blectl_out_deduped;
+        blectl_out_notifies = blectl_out->notifies;
+        blectl_out_batches = blectl_out->batches;
+        blectl_out_deduped = blectl_out->deduped;
+        bleconn_stats_reset( &blectl_conn, millis() );
+        portEXIT_CRITICAL(&blectlMux);
+        log_i("BLE last %ds: %d conn events (interval %dms, latency %d), %d adv events, %d requests, radio duty ~%d.%02d%%",
+              BLECONN_STATS_PERIOD / 1000, conn_events, interval * 5 / 4, latency, adv_events, requests, duty / 100, duty % 100 );
+        log_i("BLE last %ds: %d notifies in %d batches, %d unchanged values dropped", BLECONN_STATS_PERIOD / 1000, notifies, batches, deduped );
+    }
+}
+
+/*
+ * send what is due in one go, the notifies are called outside of the lock
+ * because blectl_send_msg() may come from the ble task
+ */
+static void blectl_out_flush( void ) {
+    uint16_t part = blectl_mtu - 3;
+    bool tx = false;
 
-    if ( blectl_get_advertising() ) {
-        pServer->getAdvertising()->start();
-        log_i("BLE advertising...");
+    portENTER_CRITICAL(&blectlMux);
+    uint8_t count = bleout_take( blectl_out, blectl_out_batch, part, millis() );
+    portEXIT_CRITICAL(&blectlMux);
+
+    for ( int i = 0 ; i < count ; i++ ) {
+        BLECharacteristic *characteristic = NULL;
+        switch ( blectl_out_batch->item[ i ].id ) {
+            case BLECTL_OUT_BATTERY_LEVEL:          characteristic = pBatteryLevelCharacteristic;
+                                                    break;
+            case BLECTL_OUT_BATTERY_POWER_STATE:    characteristic = pBatteryPowerStateCharacteristic;
+                                                    break;
+            case BLEOUT_TX:                         characteristic = pTxCharacteristic;
+                                                    tx = true;
+                                                    break;
+        }
+        if ( characteristic ) {
+            characteristic->setValue( &blectl_out_batch->data[ blectl_out_batch->item[ i ].offset ], blectl_out_batch->item[ i ].len );
+            characteristic->notify();
+        }
+    }
+    // a battery notify alone does not keep the fast interval, a reply may get an answer
+    if ( tx ) {
+        blectl_activity();
     }
 }
 
+static void blectl_activity( void ) {
+    portENTER_CRITICAL(&blectlMux);
+    bleconn_activity( &blectl_conn, millis() );
+    portEXIT_CRITICAL(&blectlMux);
+}
+
+static void blectl_advertising_update( void ) {
+    BLEAdvertising *pAdvertising = BLEDevice::getAdvertising();
+    const bleconn_adv_step_t *step = bleconn_adv_step( &blectl_conn );
+
+    pAdvertising->stop();
+    pAdvertising->setMinInterval( step->min_int );
+    pAdvertising->setMaxInterval( step->max_int );
+    pAdvertising->start();
+    log_i("BLE advertising, interval %d-%dms", step->min_int * 5 / 8, step->max_int * 5 / 8 );
+}
+
 /*
  *
  */
@@ -393,6 +553,58 @@ void blectl_wakeup( void ) {
 */
 }
 
+uint32_t blectl_get_rx_bytes( void ) {
+    return( blectl_rx_bytes );
+}
+
+uint32_t blectl_get_rx_writes( void ) {
+    return( blectl_rx_writes );
+}
+
+uint32_t blectl_get_rx_msgs( void ) {
+    return( blectl_framer.msgs );
+}
+
+uint16_t blectl_get_mtu( void ) {
+    return( blectl_mtu );
+}
+
+bool blectl_send_msg( const char *msg ) {
+    bool retval = false;
+
+    if ( !blectl_get_event( BLECTL_CONNECT ) ) {
+        return( false );
+    }
+    portENTER_CRITICAL(&blectlMux);
+    retval = bleout_send( blectl_out, (const uint8_t *)msg, strlen( msg ), millis() );
+    portEXIT_CRITICAL(&blectlMux);
+    if ( !retval ) {
+        log_e("BLE tx queue full, message dropped");
+    }
+    return( retval );
+}
+
+bool blectl_send_gadgetbridge_msg( const char *msg ) {
+    bool retval = false;
+    size_t len = strlen( msg );
+
+    if ( !blectl_get_event( BLECTL_CONNECT ) ) {
+        return( false );
+    }
+    // gadgetbridge reads lines, the message and its line feed go into the queue together
+    portENTER_CRITICAL(&blectlMux);
+    if ( len + 1 <= (size_t)( BLEOUT_TX_SIZE - blectl_out->tx_len ) ) {
+        const uint8_t lf = LineFeed;
+        bleout_send( blectl_out, (const uint8_t *)msg, len, millis() );
+        retval = bleout_send( blectl_out, &lf, 1, millis() );
+    }
+    portEXIT_CRITICAL(&blectlMux);
+    if ( !retval ) {
+        log_e("BLE tx queue full, message dropped");
+    }
+    return( retval );
+}
+
 void blectl_set_enable_on_standby( bool enable_on_standby ) {        
     blectl_config.enable_on_standby = enable_on_standby;
     blectl_save_config();
@@ -405,10 +617,10 @@ void blectl_set_advertising( bool advertising ) {
         return;
 
     if ( advertising ) {
-        pServer->getAdvertising()->start();
+        BLEDevice::getAdvertising()->start();
     }
     else {
-        pServer->getAdvertising()->stop();
+        BLEDevice::getAdvertising()->stop();
     }
 }
 
@@ -417,12 +629,15 @@ bool blectl_get_enable_on_standby( void ) {
 }
 
 bool blectl_get_advertising( void ) {
-    return( blectl_config.enable_on_standby );
+    return( blectl_config.advertising );
 }
 /*
  *
  */
 void blectl_save_config( void ) {
+    if ( configapi_defer_save( blectl_save_config ) ) {
+        return;
+    }
     fs::File file = SPIFFS.open( BLECTL_JSON_COFIG_FILE, FILE_WRITE );
 
     if (!file) {
@@ -476,13 +691,278 @@ void blectl_update_battery( int32_t percent, bool charging, bool plug )
     uint8_t level = (uint8_t)percent;
     if (level > 100) level = 100;
 
-    pBatteryLevelCharacteristic->setValue(&level, 1);
-    pBatteryLevelCharacteristic->notify();
+    // called every second, bleout only sends a changed value and the level at most every minute
+    portENTER_CRITICAL(&blectlMux);
+    bleout_set( blectl_out, BLECTL_OUT_BATTERY_LEVEL, &level, 1 );
+    portEXIT_CRITICAL(&blectlMux);
 
     uint8_t batteryPowerState = BATTERY_POWER_STATE_BATTERY_PRESENT | 
         (plug ? BATTERY_POWER_STATE_DISCHARGE_NOT_DISCHARING : BATTERY_POWER_STATE_DISCHARGE_DISCHARING) |
         (charging? BATTERY_POWER_STATE_CHARGE_CHARING : BATTERY_POWER_STATE_CHARGE_NOT_CHARING) | 
         (percent > 10 ? BATTERY_POWER_STATE_LEVEL_GOOD : BATTERY_POWER_STATE_LEVEL_CRITICALLY_LOW );
-    pBatteryPowerStateCharacteristic->setValue(&batteryPowerState, 1);
-    pBatteryPowerStateCharacteristic->notify();
-}
\ No newline at end of file
+    portENTER_CRITICAL(&blectlMux);
+    bleout_set( blectl_out, BLECTL_OUT_BATTERY_POWER_STATE, &batteryPowerState, 1 );
+    portEXIT_CRITICAL(&blectlMux);
+}
+
+/*
+ * a transfer is resumed if target, name, size and crc32 match the saved one. a file
+ * continues at the end of the part file, a firmware where otaupdate_suspend() has stopped
+ */
+static bool blectl_xfer_open( blexfer_t *xfer, uint32_t *offset, uint32_t *crc ) {
+    size_t resume_offset = 0;
+    char written_sha256[ OTAUPDATE_SHA256_LEN + 1 ] = "";
+    bool resume = false;
+
+    if ( SPIFFS.exists( BLECTL_XFER_JSON_FILE ) ) {
+        fs::File file = SPIFFS.open( BLECTL_XFER_JSON_FILE, FILE_READ );
+        if ( file ) {
+            SpiRamJsonDocument doc( 1000 );
+
+            DeserializationError error = deserializeJson( doc, file );
+            if ( error ) {
+                log_e("blexfer deserializeJson() failed: %s", error.c_str() );
+            }
+            else if ( doc["target"].as<int>() == xfer->target && doc["size"].as<uint32_t>() == xfer->size &&
+                      doc["crc"].as<uint32_t>() == xfer->crc && !strcmp( doc["name"] | "", xfer->name ) ) {
+                resume = true;
+                resume_offset = doc["offset"] | 0;
+                strlcpy( written_sha256, doc["written_sha256"] | "", sizeof( written_sha256 ) );
+            }
+            doc.clear();
+        }
+        file.close();
+    }
+
+    switch( xfer->target ) {
+        case BLEXFER_TARGET_FILE:
+            if ( xfer->name[ 0 ] != '/' || !strcmp( xfer->name, BLECTL_XFER_PART_FILE ) || !strcmp( xfer->name, BLECTL_XFER_JSON_FILE ) ) {
+                xfer->error = "bad filename";
+                return( false );
+            }
+            if ( !resume || !blectl_xfer_crc_file( BLECTL_XFER_PART_FILE, offset, crc ) || *offset > xfer->size ) {
+                *offset = 0;
+                *crc = 0;
+                SPIFFS.remove( BLECTL_XFER_PART_FILE );
+            }
+            if ( SPIFFS.totalBytes() - SPIFFS.usedBytes() < xfer->size - *offset ) {
+                xfer->error = "no space left";
+                return( false );
+            }
+            blectl_xfer_file = SPIFFS.open( BLECTL_XFER_PART_FILE, FILE_APPEND );
+            if ( !blectl_xfer_file ) {
+                xfer->error = "can't open file";
+                return( false );
+            }
+            // a file can continue after a power loss, it needs no state from the suspend
+            blectl_xfer_save( xfer, 0, NULL );
+            break;
+        case BLEXFER_TARGET_FIRMWARE:
+            if ( resume && resume_offset && otaupdate_resume( U_FLASH, resume_offset, xfer->size, NULL, written_sha256 ) ) {
+                if ( !blectl_xfer_crc_partition( resume_offset, crc ) ) {
+                    otaupdate_abort();
+                    xfer->error = "flash read failed";
+                    return( false );
+                }
+                *offset = resume_offset;
+            }
+            else if ( !otaupdate_begin( U_FLASH, xfer->size, NULL ) ) {
+                xfer->error = otaupdate_get_error();
+                return( false );
+            }
+            break;
+        default:
+            xfer->error = "unknown target";
+            return( false );
+    }
+    log_i("transfer %s, %d bytes, %s at %d", xfer->name, xfer->size, *offset ? "resumed" : "started", *offset );
+    portENTER_CRITICAL(&blectlMux);
+    bleconn_bulk( &blectl_conn, true, millis() );
+    portEXIT_CRITICAL(&blectlMux);
+    return( true );
+}
+
+static bool blectl_xfer_write( const uint8_t *data, size_t len ) {
+    if ( blectl_xfer->target == BLEXFER_TARGET_FILE ) {
+        return( blectl_xfer_file.write( data, len ) == len );
+    }
+    if ( !otaupdate_write( data, len ) ) {
+        blectl_xfer->error = otaupdate_get_error();
+        return( false );
+    }
+    return( true );
+}
+
+static bool blectl_xfer_close( blexfer_t *xfer, uint8_t reason ) {
+    bool retval = true;
+
+    portENTER_CRITICAL(&blectlMux);
+    bleconn_bulk( &blectl_conn, false, millis() );
+    portEXIT_CRITICAL(&blectlMux);
+
+    if ( xfer->target == BLEXFER_TARGET_FILE ) {
+        blectl_xfer_file.close();
+        switch( reason ) {
+            case BLEXFER_CLOSE_DONE:
+                SPIFFS.remove( xfer->name );
+                retval = SPIFFS.rename( BLECTL_XFER_PART_FILE, xfer->name );
+                if ( !retval ) {
+                    xfer->error = "rename failed";
+                }
+                break;
+            case BLEXFER_CLOSE_ABORT:
+                SPIFFS.remove( BLECTL_XFER_PART_FILE );
+                break;
+            case BLEXFER_CLOSE_SUSPEND:
+                log_i("transfer %s suspended at %d", xfer->name, xfer->offset );
+                return( true );
+        }
+    }
+    else {
+        switch( reason ) {
+            case BLEXFER_CLOSE_DONE:
+                retval = otaupdate_end();
+                if ( !retval ) {
+                    xfer->error = otaupdate_get_error();
+                }
+                blectl_xfer_restart = retval;
+                break;
+            case BLEXFER_CLOSE_ABORT:
+                otaupdate_abort();
+                break;
+            case BLEXFER_CLOSE_SUSPEND: {
+                char written_sha256[ OTAUPDATE_SHA256_LEN + 1 ];
+                size_t offset = otaupdate_suspend( written_sha256 );
+                if ( offset ) {
+                    blectl_xfer_save( xfer, offset, written_sha256 );
+                    return( true );
+                }
+                break;
+            }
+        }
+    }
+    SPIFFS.remove( BLECTL_XFER_JSON_FILE );
+    log_i("transfer %s %s", xfer->name, reason == BLEXFER_CLOSE_DONE && retval ? "done" : "dropped" );
+    return( retval );
+}
+
+/*
+ * the transfer commands open, hash, write and close files and the ota partition,
+ * so they run here and not in the ble task. the replies are send from here too.
+ * the client sends the chunks of a block before the block command and waits for
+ * the reply, so blexfer_data() in the ble task does not touch a block in use
+ */
+static void blectl_xfer_loop( void ) {
+    blectl_xfer_cmd_t cmd;
+
+    portENTER_CRITICAL(&blectlMux);
+    bool disconnected = blectl_xfer_disconnected;
+    blectl_xfer_disconnected = false;
+    portEXIT_CRITICAL(&blectlMux);
+
+    if ( disconnected ) {
+        blexfer_disconnect( blectl_xfer );
+        if ( blectl_xfer_restart ) {
+            log_i("firmware transfer complete, restart");
+            ESP.restart();
+        }
+    }
+    while ( xQueueReceive( blectl_xfer_queue, &cmd, 0 ) == pdTRUE ) {
+        blexfer_control( blectl_xfer, cmd.data, cmd.len );
+    }
+}
+
+static void blectl_xfer_reply( const uint8_t *data, size_t len ) {
+    pXferControlCharacteristic->setValue( (uint8_t *)data, len );
+    pXferControlCharacteristic->notify();
+}
+
+static void blectl_xfer_save( blexfer_t *xfer, size_t offset, const char *written_sha256 ) {
+    fs::File file = SPIFFS.open( BLECTL_XFER_JSON_FILE, FILE_WRITE );
+
+    if (!file) {
+        log_e("Can't open file: %s!", BLECTL_XFER_JSON_FILE );
+    }
+    else {
+        SpiRamJsonDocument doc( 1000 );
+
+        doc["target"] = xfer->target;
+        doc["name"] = xfer->name;
+        doc["size"] = xfer->size;
+        doc["crc"] = xfer->crc;
+        doc["offset"] = offset;
+        if ( written_sha256 ) {
+            doc["written_sha256"] = written_sha256;
+        }
+
+        if ( serializeJsonPretty( doc, file ) == 0) {
+            log_e("Failed to write blexfer file");
+        }
+        doc.clear();
+    }
+    file.close();
+}
+
+static bool blectl_xfer_crc_file( const char *filename, uint32_t *offset, uint32_t *crc ) {
+    uint8_t buf[ 512 ];
+
+    *offset = 0;
+    *crc = 0;
+    fs::File file = SPIFFS.open( filename, FILE_READ );
+    if ( !file ) {
+        return( false );
+    }
+    while( file.available() ) {
+        size_t len = file.read( buf, sizeof( buf ) );
+        if ( len == 0 ) {
+            break;
+        }
+        *crc = blexfer_crc32( *crc, buf, len );
+        *offset += len;
+    }
+    file.close();
+    return( true );
+}
+
+static bool blectl_xfer_crc_partition( size_t len, uint32_t *crc ) {
+    const esp_partition_t *partition = esp_ota_get_next_update_partition( NULL );
+    uint8_t buf[ 512 ];
+
+    *crc = 0;
+    if ( partition == NULL ) {
+        return( false );
+    }
+    for( size_t offset = 0 ; offset < len ; offset += sizeof( buf ) ) {
+        size_t part = len - offset > sizeof( buf ) ? sizeof( buf ) : len - offset;
+        if ( esp_partition_read( partition, offset, buf, part ) != ESP_OK ) {
+            return( false );
+        }
+        *crc = blexfer_crc32( *crc, buf, part );
+    }
+    return( true );
+}
+
+/*
+ * called from the ble stack next to the BLEServer handler
+ */
+static void blectl_gatts_event_handler( esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param ) {
+    if ( event == ESP_GATTS_MTU_EVT ) {
+        blectl_mtu = param->mtu.mtu;
+        log_i("BLE mtu %d", blectl_mtu );
+    }
+}
+
+/*
+ * the phone may give other parameters than requested, the stats use the real ones
+ */
+static void blectl_gap_event_handler( esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param ) {
+    if ( event == ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT ) {
+        if ( param->update_conn_params.status == ESP_BT_STATUS_SUCCESS ) {
+            portENTER_CRITICAL(&blectlMux);
+            bleconn_params( &blectl_conn, param->update_conn_params.conn_int, param->update_conn_params.latency, millis() );
+            portEXIT_CRITICAL(&blectlMux);
+        }
+        log_i("BLE connection interval %dms, latency %d, timeout %dms, status %d", param->update_conn_params.conn_int * 5 / 4,
+              param->update_conn_params.latency, param->update_conn_params.timeout * 10, param->update_conn_params.status );
+    }
+}
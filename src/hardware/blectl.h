@@ -61,9 +61,23 @@
 
     #define BLECTL_JSON_COFIG_FILE         "/blectl.json"
 
-    #define EndofText               0x03
-    #define LineFeed                0x0a
-    #define DataLinkEscape          0x10
+    #define BLECTL_DEFAULT_MTU             23          /** @brief mtu until the phone has done the exchange */
+    #define BLECTL_MTU                     247         /** @brief largest mtu that fits one 251 byte link layer packet */
+    #define BLECTL_DATA_LEN                251         /** @brief link layer payload with data length extension */
+
+    #define BLECTL_OUT_BATTERY_LEVEL                0           /** @brief bleout characteristic ids */
+    #define BLECTL_OUT_BATTERY_POWER_STATE          1
+    #define BLECTL_BATTERY_LEVEL_INTERVAL           60000       /** @brief ms between two battery level notifies */
+    #define BLECTL_BATTERY_POWER_STATE_INTERVAL     1000        /** @brief plug and charge changes are shown quickly */
+
+    // bulk transfer service, see blexfer.h and tools/blexfer.py
+    #define BLEXFER_SERVICE_UUID BLEUUID("8a4b0001-5f0e-4c4a-9d4e-2a3c7e1b6f10")
+    #define BLEXFER_CONTROL_CHARACTERISTIC_UUID BLEUUID("8a4b0002-5f0e-4c4a-9d4e-2a3c7e1b6f10")
+    #define BLEXFER_DATA_CHARACTERISTIC_UUID BLEUUID("8a4b0003-5f0e-4c4a-9d4e-2a3c7e1b6f10")
+
+    #define BLECTL_XFER_JSON_FILE          "/blexfer.json"     /** @brief the transfer to resume */
+    #define BLECTL_XFER_PART_FILE          "/blexfer.part"     /** @brief a file in transfer, renamed when complete */
+    #define BLECTL_XFER_QUEUE              4                   /** @brief control commands waiting for blectl_loop() */
 
     typedef struct {
         bool advertising = true;
@@ -88,11 +102,16 @@
     #define BLECTL_PAIRING               _BV(8)
     #define BLECTL_PAIRING_SUCCESS       _BV(9)
     #define BLECTL_PAIRING_ABORT         _BV(10)
+    #define BLECTL_CMD                   _BV(11)     /** @brief an espruino command line that is no GB() message, like setTime() */
 
     /*
      * @brief ble setup function
      */
     void blectl_setup( void );
+    /*
+     * @brief ble loop function, adapts the connection and advertising intervals
+     */
+    void blectl_loop( void );
     /*
      * @brief trigger a blectl managemt event
      * 
@@ -123,5 +142,46 @@
     void blectl_read_config( void );
     
     void blectl_update_battery( int32_t percent, bool charging, bool plug );
+    /*
+     * @brief get the number of bytes received over the uart characteristic since boot
+     *
+     * @return  bytes
+     */
+    uint32_t blectl_get_rx_bytes( void );
+    /*
+     * @brief get the number of writes on the uart characteristic since boot
+     *
+     * @return  writes
+     */
+    uint32_t blectl_get_rx_writes( void );
+    /*
+     * @brief get the number of complete messages from the uart characteristic since boot
+     *
+     * @return  messages
+     */
+    uint32_t blectl_get_rx_msgs( void );
+    /*
+     * @brief get the negotiated att mtu of the current connection
+     *
+     * @return  mtu, BLECTL_DEFAULT_MTU before the exchange
+     */
+    uint16_t blectl_get_mtu( void );
+    /*
+     * @brief queue a message for the uart tx characteristic, blectl_loop() sends it
+     * together with other pending notifies, split into parts of mtu - 3 bytes
+     *
+     * @param   msg     message to send
+     *
+     * @return  false if not connected or the queue is full
+     */
+    bool blectl_send_msg( const char *msg );
+    /*
+     * @brief queue a reply to gadgetbridge, a line feed is added
+     *
+     * @param   msg     json message, for example {"t":"status","bat":80}
+     *
+     * @return  false if not connected or the queue is full
+     */
+    bool blectl_send_gadgetbridge_msg( const char *msg );
 
 #endif // _BLECTL_H
\ No newline at end of file
@@ -0,0 +1,103 @@
+/****************************************************************************
+ *   Sep 27 11:02:44 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include "bleframer.h"
+
+static void bleframer_add( bleframer_t *framer, const char *data, size_t len );
+static void bleframer_clear( bleframer_t *framer );
+
+void bleframer_init( bleframer_t *framer, BLEFRAMER_MSG_FUNC msg_cb ) {
+    framer->msg_cb = msg_cb;
+    framer->msg = NULL;
+    framer->capacity = 0;
+    framer->msgs = 0;
+    bleframer_clear( framer );
+}
+
+void bleframer_feed( bleframer_t *framer, const char *data, size_t len ) {
+    size_t start = 0;
+
+    for ( size_t i = 0 ; i <= len ; i++ ) {
+        if ( i < len && data[ i ] != EndofText && data[ i ] != DataLinkEscape && data[ i ] != LineFeed ) {
+            continue;
+        }
+        if ( i > start ) {
+            bleframer_add( framer, &data[ start ], i - start );
+        }
+        start = i + 1;
+        if ( i == len ) {
+            break;
+        }
+        switch( data[ i ] ) {
+            case EndofText:         bleframer_clear( framer );
+                                    log_i("attention, new link establish");
+                                    break;
+            case DataLinkEscape:    bleframer_clear( framer );
+                                    log_i("attention, new message");
+                                    break;
+            case LineFeed:          log_i("message complete, fire BLTCTL_MSG callback");
+                                    framer->msgs++;
+                                    if( framer->size >= 4 && framer->msg[ 0 ] == 'G' && framer->msg[ 1 ] == 'B' ) {
+                                        log_i("gadgetbridge message identified, cut down to json");
+                                        framer->msg[ framer->size - 1 ] = '\0';
+                                        log_i("msg: %s", &framer->msg[ 3 ] );
+                                        framer->msg_cb( BLEFRAMER_MSG, &framer->msg[ 3 ] );
+                                    }
+                                    else if ( framer->msg[ 0 ] == '{' ) {
+                                        log_i("msg: %s", framer->msg );
+                                        framer->msg_cb( BLEFRAMER_MSG, framer->msg );
+                                    }
+                                    else {
+                                        log_i("cmd: %s", framer->msg );
+                                        framer->msg_cb( BLEFRAMER_CMD, framer->msg );
+                                    }
+                                    break;
+        }
+    }
+}
+
+/*
+ * the buffer only grows, with a large mtu a whole message comes in a few writes
+ */
+static void bleframer_add( bleframer_t *framer, const char *data, size_t len ) {
+    if ( framer->msg == NULL || framer->size + len + 1 > framer->capacity ) {
+        uint32_t capacity = framer->capacity ? framer->capacity : BLEFRAMER_BUFFER_SIZE;
+        while( framer->size + len + 1 > capacity ) {
+            capacity *= 2;
+        }
+        char *msg = (char *)ps_realloc( framer->msg, capacity );
+        if ( msg == NULL ) {
+            log_e("gadgetbridge_msg realloc fail");
+            while(true);
+        }
+        framer->msg = msg;
+        framer->capacity = capacity;
+    }
+    memcpy( &framer->msg[ framer->size ], data, len );
+    framer->size += len;
+    framer->msg[ framer->size ] = '\0';
+}
+
+static void bleframer_clear( bleframer_t *framer ) {
+    framer->size = 0;
+    bleframer_add( framer, "", 0 );
+}
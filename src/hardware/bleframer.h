@@ -0,0 +1,71 @@
+/****************************************************************************
+ *   Sep 27 11:02:44 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _BLEFRAMER_H
+    #define _BLEFRAMER_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    /*
+     * splits the gadgetbridge uart rx stream into messages. a message starts after
+     * DataLinkEscape or EndofText and ends with LineFeed, a write can hold any part
+     * of one or more messages
+     */
+    #define BLEFRAMER_BUFFER_SIZE       256         /** @brief first size of the message buffer, it doubles as needed */
+
+    #define BLEFRAMER_MSG               0           /** @brief a json message, "GB(...)" is cut down to the json */
+    #define BLEFRAMER_CMD               1           /** @brief anything else, like "setTime(...)" */
+
+    #define EndofText                   0x03
+    #define LineFeed                    0x0a
+    #define DataLinkEscape              0x10
+
+    /*
+     * @brief a complete message, msg is valid until the next feed
+     */
+    typedef void ( * BLEFRAMER_MSG_FUNC ) ( uint8_t type, char *msg );
+
+    typedef struct {
+        BLEFRAMER_MSG_FUNC msg_cb;
+        char *msg;                                  /** @brief message so far, '\0' terminated */
+        uint32_t size;
+        uint32_t capacity;                          /** @brief allocated size of msg */
+        uint32_t msgs;                              /** @brief complete messages, for the stats */
+    } bleframer_t;
+
+    /*
+     * @brief prepare a framer
+     *
+     * @param   framer      pointer to the framer state
+     * @param   msg_cb      called for each complete message
+     */
+    void bleframer_init( bleframer_t *framer, BLEFRAMER_MSG_FUNC msg_cb );
+    /*
+     * @brief add the data of one write, the text between the control chars is copied at once
+     *
+     * @param   framer      pointer to the framer state
+     * @param   data        pointer to the data
+     * @param   len         length of the data
+     */
+    void bleframer_feed( bleframer_t *framer, const char *data, size_t len );
+
+#endif // _BLEFRAMER_H
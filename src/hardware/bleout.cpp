@@ -0,0 +1,160 @@
+/****************************************************************************
+ *   Sep 13 16:20:45 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <string.h>
+
+#include "bleout.h"
+
+static bool bleout_add( bleout_batch_t *batch, uint8_t id, const uint8_t *data, uint16_t len );
+
+void bleout_init( bleout_t *out ) {
+    memset( out, 0, sizeof( bleout_t ) );
+}
+
+void bleout_char( bleout_t *out, uint8_t id, uint32_t min_interval ) {
+    if ( id < BLEOUT_CHARS ) {
+        out->chars[ id ].min_interval = min_interval;
+    }
+}
+
+void bleout_connect( bleout_t *out ) {
+    for ( int i = 0 ; i < BLEOUT_CHARS ; i++ ) {
+        bleout_char_t *c = &out->chars[ i ];
+        if ( c->send_once || c->pending ) {
+            if ( !c->pending ) {
+                memcpy( c->value, c->send_value, c->send_len );
+                c->len = c->send_len;
+            }
+            c->send_once = false;
+            c->pending = true;
+        }
+    }
+    out->tx_len = 0;
+}
+
+bool bleout_set( bleout_t *out, uint8_t id, const uint8_t *value, size_t len ) {
+    if ( id >= BLEOUT_CHARS || len > BLEOUT_VALUE_SIZE ) {
+        return( false );
+    }
+    bleout_char_t *c = &out->chars[ id ];
+
+    out->values++;
+    if ( c->send_once && c->send_len == len && !memcmp( c->send_value, value, len ) ) {
+        // back at the value the phone has, a pending change is not needed anymore
+        c->pending = false;
+        out->deduped++;
+        return( false );
+    }
+    if ( c->pending && c->len == len && !memcmp( c->value, value, len ) ) {
+        out->deduped++;
+        return( true );
+    }
+    memcpy( c->value, value, len );
+    c->len = len;
+    c->pending = true;
+    return( true );
+}
+
+bool bleout_send( bleout_t *out, const uint8_t *data, size_t len, uint32_t now ) {
+    if ( len > (size_t)( BLEOUT_TX_SIZE - out->tx_len ) ) {
+        out->tx_dropped += len;
+        return( false );
+    }
+    if ( out->tx_len == 0 ) {
+        out->tx_since = now;
+    }
+    memcpy( &out->tx[ out->tx_len ], data, len );
+    out->tx_len += len;
+    return( true );
+}
+
+uint8_t bleout_take( bleout_t *out, bleout_batch_t *batch, uint16_t part, uint32_t now ) {
+    bool due = false;
+
+    batch->count = 0;
+    batch->used = 0;
+    /*
+     * nothing is send before one of them is due
+     */
+    if ( out->tx_len && ( now - out->tx_since >= BLEOUT_TX_DELAY || out->tx_len >= part ) ) {
+        due = true;
+    }
+    for ( int i = 0 ; i < BLEOUT_CHARS && !due ; i++ ) {
+        bleout_char_t *c = &out->chars[ i ];
+        if ( c->pending && ( !c->send_once || now - c->last_send >= c->min_interval ) ) {
+            due = true;
+        }
+    }
+    if ( !due ) {
+        return( 0 );
+    }
+    /*
+     * values take the ride if at least half of their interval is over
+     */
+    for ( int i = 0 ; i < BLEOUT_CHARS ; i++ ) {
+        bleout_char_t *c = &out->chars[ i ];
+        if ( !c->pending || ( c->send_once && now - c->last_send < c->min_interval / 2 ) ) {
+            continue;
+        }
+        if ( !bleout_add( batch, i, c->value, c->len ) ) {
+            break;
+        }
+        memcpy( c->send_value, c->value, c->len );
+        c->send_len = c->len;
+        c->send_once = true;
+        c->pending = false;
+        c->last_send = now;
+    }
+    /*
+     * the tx stream in parts of one notify, what does not fit stays for the next batch
+     */
+    uint16_t taken = 0;
+    while ( taken < out->tx_len ) {
+        uint16_t len = out->tx_len - taken > part ? part : out->tx_len - taken;
+        if ( !bleout_add( batch, BLEOUT_TX, &out->tx[ taken ], len ) ) {
+            break;
+        }
+        taken += len;
+    }
+    if ( taken ) {
+        memmove( out->tx, &out->tx[ taken ], out->tx_len - taken );
+        out->tx_len -= taken;
+    }
+
+    if ( batch->count ) {
+        out->notifies += batch->count;
+        out->batches++;
+    }
+    return( batch->count );
+}
+
+static bool bleout_add( bleout_batch_t *batch, uint8_t id, const uint8_t *data, uint16_t len ) {
+    if ( batch->count >= BLEOUT_BATCH_ITEMS || len > BLEOUT_BATCH_SIZE - batch->used ) {
+        return( false );
+    }
+    batch->item[ batch->count ].id = id;
+    batch->item[ batch->count ].offset = batch->used;
+    batch->item[ batch->count ].len = len;
+    memcpy( &batch->data[ batch->used ], data, len );
+    batch->used += len;
+    batch->count++;
+    return( true );
+}
@@ -0,0 +1,131 @@
+/****************************************************************************
+ *   Sep 13 16:20:45 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _BLEOUT_H
+    #define _BLEOUT_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    /*
+     * outbound notifications. a value characteristic keeps only the newest value,
+     * a value equal to the last send one is dropped and a characteristic notifies
+     * not more often than its min_interval. the uart tx stream is collected for
+     * BLEOUT_TX_DELAY. when one of them is due, everything else that is pending
+     * is send with it, back to back, so the radio wakes up once for all
+     */
+    #define BLEOUT_CHARS                4           /** @brief value characteristics */
+    #define BLEOUT_VALUE_SIZE           20          /** @brief a value must fit the smallest mtu */
+    #define BLEOUT_TX                   0xff        /** @brief id of the uart tx stream in a batch */
+    #define BLEOUT_TX_SIZE              2048        /** @brief uart tx bytes waiting for the next batch */
+    #define BLEOUT_TX_DELAY             20          /** @brief ms to collect the parts of a reply */
+    #define BLEOUT_BATCH_ITEMS          16          /** @brief notifies in one batch */
+    #define BLEOUT_BATCH_SIZE           1024        /** @brief bytes in one batch, the rest follows in the next */
+
+    typedef struct {
+        uint32_t min_interval;                      /** @brief ms between two notifies */
+        uint32_t last_send;
+        bool send_once;
+        bool pending;
+        uint8_t len;
+        uint8_t send_len;
+        uint8_t value[ BLEOUT_VALUE_SIZE ];         /** @brief value to send */
+        uint8_t send_value[ BLEOUT_VALUE_SIZE ];    /** @brief value the phone has */
+    } bleout_char_t;
+
+    typedef struct {
+        bleout_char_t chars[ BLEOUT_CHARS ];
+        uint8_t tx[ BLEOUT_TX_SIZE ];
+        uint16_t tx_len;
+        uint32_t tx_since;                          /** @brief time of the oldest byte in tx */
+        uint32_t values;                            /** @brief values set, for the stats */
+        uint32_t deduped;                           /** @brief values dropped as unchanged */
+        uint32_t notifies;
+        uint32_t batches;
+        uint32_t tx_dropped;                        /** @brief bytes that did not fit into tx */
+    } bleout_t;
+
+    typedef struct {
+        uint8_t count;
+        uint16_t used;
+        struct {
+            uint8_t id;                             /** @brief characteristic or BLEOUT_TX */
+            uint16_t offset;
+            uint16_t len;
+        } item[ BLEOUT_BATCH_ITEMS ];
+        uint8_t data[ BLEOUT_BATCH_SIZE ];
+    } bleout_batch_t;
+
+    /*
+     * @brief clear the queue
+     *
+     * @param   out     pointer to the queue
+     */
+    void bleout_init( bleout_t *out );
+    /*
+     * @brief set the rate limit of a value characteristic
+     *
+     * @param   out             pointer to the queue
+     * @param   id              0 ... BLEOUT_CHARS - 1
+     * @param   min_interval    ms between two notifies
+     */
+    void bleout_char( bleout_t *out, uint8_t id, uint32_t min_interval );
+    /*
+     * @brief a new connection, the current values are send again and old tx data is dropped
+     *
+     * @param   out     pointer to the queue
+     */
+    void bleout_connect( bleout_t *out );
+    /*
+     * @brief set the value of a characteristic
+     *
+     * @param   out     pointer to the queue
+     * @param   id      0 ... BLEOUT_CHARS - 1
+     * @param   value   pointer to the value
+     * @param   len     length of the value, up to BLEOUT_VALUE_SIZE
+     *
+     * @return  false if the phone has this value already
+     */
+    bool bleout_set( bleout_t *out, uint8_t id, const uint8_t *value, size_t len );
+    /*
+     * @brief queue data for the uart tx stream
+     *
+     * @param   out     pointer to the queue
+     * @param   data    pointer to the data
+     * @param   len     length of the data
+     * @param   now     time in ms
+     *
+     * @return  false if the data does not fit, nothing is queued then
+     */
+    bool bleout_send( bleout_t *out, const uint8_t *data, size_t len, uint32_t now );
+    /*
+     * @brief take the next batch if something is due
+     *
+     * @param   out     pointer to the queue
+     * @param   batch   filled with the notifies to send
+     * @param   part    max bytes of one notify, mtu - 3
+     * @param   now     time in ms
+     *
+     * @return  number of notifies in batch
+     */
+    uint8_t bleout_take( bleout_t *out, bleout_batch_t *batch, uint16_t part, uint32_t now );
+
+#endif // _BLEOUT_H
@@ -0,0 +1,278 @@
+/****************************************************************************
+ *   Sep 12 10:21:37 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <string.h>
+
+#include "blexfer.h"
+
+/*
+ * no arduino or ble calls in here, blectl.cpp passes the control commands from
+ * blectl_loop() and the data chunks from the ble task through and the targets
+ * are behind the callbacks
+ */
+static const uint32_t blexfer_crc_table[ 16 ] = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c };
+
+static void blexfer_start( blexfer_t *xfer, const uint8_t *data, size_t len );
+static void blexfer_block( blexfer_t *xfer, const uint8_t *data, size_t len );
+static void blexfer_end( blexfer_t *xfer );
+static void blexfer_close( blexfer_t *xfer, uint8_t reason );
+static void blexfer_fail( blexfer_t *xfer, const char *error );
+static void blexfer_reply( blexfer_t *xfer, uint8_t reply, uint32_t value1, uint32_t value2 );
+static uint32_t blexfer_block_len( blexfer_t *xfer );
+static uint32_t blexfer_get_u32( const uint8_t *data );
+static void blexfer_put_u32( uint8_t *data, uint32_t value );
+
+void blexfer_init( blexfer_t *xfer, BLEXFER_OPEN_FUNC open_cb, BLEXFER_WRITE_FUNC write_cb, BLEXFER_CLOSE_FUNC close_cb, BLEXFER_REPLY_FUNC reply_cb ) {
+    memset( xfer, 0, sizeof( blexfer_t ) - sizeof( xfer->block ) );
+    xfer->open_cb = open_cb;
+    xfer->write_cb = write_cb;
+    xfer->close_cb = close_cb;
+    xfer->reply_cb = reply_cb;
+}
+
+void blexfer_control( blexfer_t *xfer, const uint8_t *data, size_t len ) {
+    if ( len == 0 ) {
+        return;
+    }
+    switch( data[ 0 ] ) {
+        case BLEXFER_CMD_START:     blexfer_start( xfer, data + 1, len - 1 );
+                                    break;
+        case BLEXFER_CMD_BLOCK:     blexfer_block( xfer, data + 1, len - 1 );
+                                    break;
+        case BLEXFER_CMD_END:       blexfer_end( xfer );
+                                    break;
+        case BLEXFER_CMD_ABORT:     if ( xfer->running ) {
+                                        blexfer_close( xfer, BLEXFER_CLOSE_ABORT );
+                                    }
+                                    blexfer_fail( xfer, "aborted" );
+                                    break;
+        default:                    blexfer_fail( xfer, "unknown command" );
+    }
+}
+
+void blexfer_data( blexfer_t *xfer, const uint8_t *data, size_t len ) {
+    if ( !xfer->running || len <= BLEXFER_DATA_HEADER ) {
+        return;
+    }
+    uint32_t offset = blexfer_get_u32( data );
+    data += BLEXFER_DATA_HEADER;
+    len -= BLEXFER_DATA_HEADER;
+
+    /*
+     * a chunk from a block before a lost ack or from a canceled block is dropped
+     */
+    if ( offset < xfer->offset || ( offset - xfer->offset ) % xfer->chunk ) {
+        return;
+    }
+    uint32_t index = ( offset - xfer->offset ) / xfer->chunk;
+    if ( index >= BLEXFER_WINDOW || len > xfer->chunk || offset + len > xfer->size ) {
+        return;
+    }
+    memcpy( xfer->block + index * xfer->chunk, data, len );
+    xfer->received |= 1ul << index;
+}
+
+void blexfer_disconnect( blexfer_t *xfer ) {
+    if ( xfer->running ) {
+        blexfer_close( xfer, BLEXFER_CLOSE_SUSPEND );
+    }
+}
+
+uint32_t blexfer_crc32( uint32_t crc, const uint8_t *data, size_t len ) {
+    crc = ~crc;
+    while( len-- ) {
+        crc ^= *data++;
+        crc = ( crc >> 4 ) ^ blexfer_crc_table[ crc & 15 ];
+        crc = ( crc >> 4 ) ^ blexfer_crc_table[ crc & 15 ];
+    }
+    return( ~crc );
+}
+
+/*
+ * a start while a transfer is running replaces it, the same transfer is
+ * suspended first so it continues where it was
+ */
+static void blexfer_start( blexfer_t *xfer, const uint8_t *data, size_t len ) {
+    uint32_t offset = 0;
+    uint32_t crc = 0;
+
+    if ( xfer->running ) {
+        blexfer_close( xfer, BLEXFER_CLOSE_SUSPEND );
+    }
+    if ( len < 11 || len - 11 >= BLEXFER_NAME_LEN ) {
+        blexfer_fail( xfer, "bad start" );
+        return;
+    }
+    xfer->target = data[ 0 ];
+    uint16_t mtu = data[ 1 ] | data[ 2 ] << 8;
+    xfer->size = blexfer_get_u32( data + 3 );
+    xfer->crc = blexfer_get_u32( data + 7 );
+    memcpy( xfer->name, data + 11, len - 11 );
+    xfer->name[ len - 11 ] = '\0';
+
+    if ( mtu < BLEXFER_MIN_MTU ) {
+        mtu = BLEXFER_MIN_MTU;
+    }
+    if ( mtu > BLEXFER_MAX_MTU ) {
+        mtu = BLEXFER_MAX_MTU;
+    }
+    xfer->chunk = mtu - 3 - BLEXFER_DATA_HEADER;
+    xfer->error = NULL;
+
+    if ( !xfer->open_cb( xfer, &offset, &crc ) ) {
+        blexfer_fail( xfer, xfer->error ? xfer->error : "open failed" );
+        return;
+    }
+    if ( offset > xfer->size ) {
+        offset = 0;
+        crc = 0;
+    }
+    xfer->offset = offset;
+    xfer->written_crc = crc;
+    xfer->received = 0;
+    xfer->running = true;
+
+    uint8_t reply[ 8 ] = { BLEXFER_REPLY_START, (uint8_t)xfer->chunk, (uint8_t)( xfer->chunk >> 8 ), BLEXFER_WINDOW };
+    blexfer_put_u32( reply + 4, offset );
+    xfer->reply_cb( reply, sizeof( reply ) );
+}
+
+/*
+ * the block is written when all chunks are there and the crc32 matches, a
+ * block before the current one was already written and its ack got lost
+ */
+static void blexfer_block( blexfer_t *xfer, const uint8_t *data, size_t len ) {
+    if ( !xfer->running ) {
+        blexfer_fail( xfer, "no transfer" );
+        return;
+    }
+    if ( len < 10 ) {
+        blexfer_fail( xfer, "bad block" );
+        return;
+    }
+    uint32_t offset = blexfer_get_u32( data );
+    uint32_t block_len = data[ 4 ] | data[ 5 ] << 8;
+    uint32_t crc = blexfer_get_u32( data + 6 );
+
+    if ( offset < xfer->offset ) {
+        blexfer_reply( xfer, BLEXFER_REPLY_ACK, xfer->offset, 0 );
+        return;
+    }
+    if ( offset != xfer->offset || block_len != blexfer_block_len( xfer ) ) {
+        blexfer_close( xfer, BLEXFER_CLOSE_SUSPEND );
+        blexfer_fail( xfer, "block out of order" );
+        return;
+    }
+
+    uint32_t chunks = ( block_len + xfer->chunk - 1 ) / xfer->chunk;
+    uint32_t all = chunks == 32 ? 0xffffffff : ( 1ul << chunks ) - 1;
+    if ( ( xfer->received & all ) != all ) {
+        blexfer_reply( xfer, BLEXFER_REPLY_NAK, offset, all & ~xfer->received );
+        return;
+    }
+    if ( blexfer_crc32( 0, xfer->block, block_len ) != crc ) {
+        xfer->received = 0;
+        blexfer_reply( xfer, BLEXFER_REPLY_NAK, offset, all );
+        return;
+    }
+    if ( !xfer->write_cb( xfer->block, block_len ) ) {
+        blexfer_close( xfer, BLEXFER_CLOSE_ABORT );
+        blexfer_fail( xfer, xfer->error ? xfer->error : "write failed" );
+        return;
+    }
+    xfer->written_crc = blexfer_crc32( xfer->written_crc, xfer->block, block_len );
+    xfer->offset += block_len;
+    xfer->received = 0;
+    blexfer_reply( xfer, BLEXFER_REPLY_ACK, xfer->offset, 0 );
+}
+
+static void blexfer_end( blexfer_t *xfer ) {
+    if ( !xfer->running ) {
+        blexfer_fail( xfer, "no transfer" );
+        return;
+    }
+    if ( xfer->offset != xfer->size ) {
+        blexfer_close( xfer, BLEXFER_CLOSE_SUSPEND );
+        blexfer_fail( xfer, "incomplete" );
+        return;
+    }
+    if ( xfer->written_crc != xfer->crc ) {
+        blexfer_close( xfer, BLEXFER_CLOSE_ABORT );
+        blexfer_fail( xfer, "crc32 mismatch" );
+        return;
+    }
+    xfer->running = false;
+    if ( !xfer->close_cb( xfer, BLEXFER_CLOSE_DONE ) ) {
+        blexfer_fail( xfer, xfer->error ? xfer->error : "close failed" );
+        return;
+    }
+    blexfer_reply( xfer, BLEXFER_REPLY_DONE, 0, 0 );
+}
+
+static void blexfer_close( blexfer_t *xfer, uint8_t reason ) {
+    xfer->running = false;
+    xfer->close_cb( xfer, reason );
+}
+
+static void blexfer_fail( blexfer_t *xfer, const char *error ) {
+    uint8_t reply[ BLEXFER_REPLY_LEN ] = { BLEXFER_REPLY_ERROR };
+    size_t len = strlen( error );
+
+    if ( len > sizeof( reply ) - 1 ) {
+        len = sizeof( reply ) - 1;
+    }
+    memcpy( reply + 1, error, len );
+    xfer->error = error;
+    xfer->reply_cb( reply, len + 1 );
+}
+
+static void blexfer_reply( blexfer_t *xfer, uint8_t reply, uint32_t value1, uint32_t value2 ) {
+    uint8_t data[ 9 ] = { reply };
+
+    blexfer_put_u32( data + 1, value1 );
+    blexfer_put_u32( data + 5, value2 );
+    xfer->reply_cb( data, reply == BLEXFER_REPLY_NAK ? 9 : reply == BLEXFER_REPLY_ACK ? 5 : 1 );
+}
+
+/*
+ * a block is always a full window, only the last one is shorter
+ */
+static uint32_t blexfer_block_len( blexfer_t *xfer ) {
+    uint32_t len = BLEXFER_WINDOW * xfer->chunk;
+
+    if ( len > xfer->size - xfer->offset ) {
+        len = xfer->size - xfer->offset;
+    }
+    return( len );
+}
+
+static uint32_t blexfer_get_u32( const uint8_t *data ) {
+    return( data[ 0 ] | data[ 1 ] << 8 | data[ 2 ] << 16 | (uint32_t)data[ 3 ] << 24 );
+}
+
+static void blexfer_put_u32( uint8_t *data, uint32_t value ) {
+    data[ 0 ] = value;
+    data[ 1 ] = value >> 8;
+    data[ 2 ] = value >> 16;
+    data[ 3 ] = value >> 24;
+}
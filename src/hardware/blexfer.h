@@ -0,0 +1,165 @@
+/****************************************************************************
+ *   Sep 12 10:21:37 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _BLEXFER_H
+    #define _BLEXFER_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    /*
+     * bulk transfer over two characteristics, made for tools/blexfer.py. all values
+     * are little endian.
+     *
+     * control, write with response from the client and notify from the watch:
+     *
+     * BLEXFER_CMD_START    u8 target, u16 mtu, u32 size, u32 crc32, name   start or resume a transfer
+     * BLEXFER_CMD_BLOCK    u32 offset, u16 len, u32 crc32                  all chunks of a block are send
+     * BLEXFER_CMD_END                                                      all blocks are send
+     * BLEXFER_CMD_ABORT                                                    drop the transfer
+     *
+     * BLEXFER_REPLY_START  u16 chunk, u8 window, u32 offset                send from offset in chunks of chunk bytes
+     * BLEXFER_REPLY_ACK    u32 offset                                      the block before offset is written
+     * BLEXFER_REPLY_NAK    u32 offset, u32 missing                         resend the chunks in the bitmap
+     * BLEXFER_REPLY_DONE                                                   the whole crc32 matches and the target is closed
+     * BLEXFER_REPLY_ERROR  message                                         the transfer is dropped
+     *
+     * data, write without response: u32 offset, chunk bytes
+     *
+     * a block is up to window chunks, it is collected in ram and only written if its
+     * crc32 matches. a transfer that is interrupted by a disconnect is suspended and
+     * the next start with the same target, name, size and crc32 continues it
+     */
+    #define BLEXFER_CMD_START           0x01
+    #define BLEXFER_CMD_BLOCK           0x02
+    #define BLEXFER_CMD_END             0x03
+    #define BLEXFER_CMD_ABORT           0x04
+
+    #define BLEXFER_REPLY_START         0x81
+    #define BLEXFER_REPLY_ACK           0x82
+    #define BLEXFER_REPLY_NAK           0x83
+    #define BLEXFER_REPLY_DONE          0x84
+    #define BLEXFER_REPLY_ERROR         0x85
+
+    #define BLEXFER_TARGET_FILE         0           /** @brief a file on spiffs */
+    #define BLEXFER_TARGET_FIRMWARE     1           /** @brief a firmware image, delta patch or .gz for otaupdate */
+
+    #define BLEXFER_CLOSE_DONE          0           /** @brief all data is written and checked */
+    #define BLEXFER_CLOSE_ABORT         1           /** @brief drop the written data */
+    #define BLEXFER_CLOSE_SUSPEND       2           /** @brief keep the written data for a resume */
+
+    #define BLEXFER_MAX_MTU             517
+    #define BLEXFER_MIN_MTU             23
+    #define BLEXFER_DATA_HEADER         4           /** @brief offset in front of each chunk */
+    #define BLEXFER_MAX_CHUNK           ( BLEXFER_MAX_MTU - 3 - BLEXFER_DATA_HEADER )
+    #define BLEXFER_WINDOW              32          /** @brief chunks per block, one bit each in a nak */
+    #define BLEXFER_NAME_LEN            32          /** @brief spiffs limit including the '\0' */
+    #define BLEXFER_REPLY_LEN           20          /** @brief a notify must fit the smallest mtu */
+    #define BLEXFER_MAX_CMD             ( 12 + BLEXFER_NAME_LEN )   /** @brief longest control command, a start with the longest name */
+
+    typedef struct blexfer_t blexfer_t;
+
+    /*
+     * @brief open the target, for a resume offset and crc32 are set to the part that
+     * is already written and can be kept
+     *
+     * @return  true if successful
+     */
+    typedef bool ( * BLEXFER_OPEN_FUNC ) ( blexfer_t *xfer, uint32_t *offset, uint32_t *crc );
+    /*
+     * @brief write the next checked block
+     *
+     * @return  true if successful
+     */
+    typedef bool ( * BLEXFER_WRITE_FUNC ) ( const uint8_t *data, size_t len );
+    /*
+     * @brief close the target, see BLEXFER_CLOSE_*
+     *
+     * @return  true if successful
+     */
+    typedef bool ( * BLEXFER_CLOSE_FUNC ) ( blexfer_t *xfer, uint8_t reason );
+    /*
+     * @brief send a reply as notify on the control characteristic
+     */
+    typedef void ( * BLEXFER_REPLY_FUNC ) ( const uint8_t *data, size_t len );
+
+    struct blexfer_t {
+        BLEXFER_OPEN_FUNC open_cb;
+        BLEXFER_WRITE_FUNC write_cb;
+        BLEXFER_CLOSE_FUNC close_cb;
+        BLEXFER_REPLY_FUNC reply_cb;
+        bool running;
+        uint8_t target;
+        char name[ BLEXFER_NAME_LEN ];
+        uint32_t size;
+        uint32_t crc;                               /** @brief crc32 of the whole transfer */
+        uint32_t written_crc;                       /** @brief crc32 of the written part */
+        uint32_t offset;                            /** @brief start of the current block */
+        uint16_t chunk;                             /** @brief chunk size for the negotiated mtu */
+        uint32_t received;                          /** @brief received chunks of the current block */
+        const char *error;                          /** @brief reason of the last fail or NULL */
+        uint8_t block[ BLEXFER_WINDOW * BLEXFER_MAX_CHUNK ];
+    };
+
+    /*
+     * @brief prepare a transfer state
+     *
+     * @param   xfer        pointer to the transfer state
+     * @param   open_cb     open the target
+     * @param   write_cb    write a checked block
+     * @param   close_cb    close the target
+     * @param   reply_cb    send a reply to the client
+     */
+    void blexfer_init( blexfer_t *xfer, BLEXFER_OPEN_FUNC open_cb, BLEXFER_WRITE_FUNC write_cb, BLEXFER_CLOSE_FUNC close_cb, BLEXFER_REPLY_FUNC reply_cb );
+    /*
+     * @brief handle a write on the control characteristic
+     *
+     * @param   xfer        pointer to the transfer state
+     * @param   data        pointer to the command
+     * @param   len         length of the command
+     */
+    void blexfer_control( blexfer_t *xfer, const uint8_t *data, size_t len );
+    /*
+     * @brief handle a write on the data characteristic, chunks outside the current block are dropped
+     *
+     * @param   xfer        pointer to the transfer state
+     * @param   data        pointer to the chunk with its offset
+     * @param   len         length of the chunk with its offset
+     */
+    void blexfer_data( blexfer_t *xfer, const uint8_t *data, size_t len );
+    /*
+     * @brief suspend a running transfer after the connection is lost
+     *
+     * @param   xfer        pointer to the transfer state
+     */
+    void blexfer_disconnect( blexfer_t *xfer );
+    /*
+     * @brief crc32 as used by zlib, crc is the result of the previous part or 0
+     *
+     * @param   crc         crc32 of the previous data or 0
+     * @param   data        pointer to the data
+     * @param   len         length of the data
+     *
+     * @return  crc32
+     */
+    uint32_t blexfer_crc32( uint32_t crc, const uint8_t *data, size_t len );
+
+#endif // _BLEXFER_H
@@ -26,6 +26,7 @@
 #include "bma.h"
 #include "powermgm.h"
 #include "json_psram_allocator.h"
+#include "configapi.h"
 
 #include "gui/statusbar.h"
 
@@ -38,10 +39,20 @@ __NOINIT_ATTR uint32_t stepcounter;
 
 void IRAM_ATTR bma_irq( void );
 
+/*
+ * settings for /api/config
+ */
+static const configapi_field_t bma_configapi_fields[] = {
+    CONFIGAPI_BOOL_FIELD( "stepcounter", []() -> bool { return( bma_get_config( BMA_STEPCOUNTER ) ); }, []( bool value ) { bma_set_config( BMA_STEPCOUNTER, value ); } ),
+    CONFIGAPI_BOOL_FIELD( "doubleclick", []() -> bool { return( bma_get_config( BMA_DOUBLECLICK ) ); }, []( bool value ) { bma_set_config( BMA_DOUBLECLICK, value ); } ),
+    CONFIGAPI_BOOL_FIELD( "tilt", []() -> bool { return( bma_get_config( BMA_TILT ) ); }, []( bool value ) { bma_set_config( BMA_TILT, value ); } ),
+};
+
 /*
  *
  */
 void bma_setup( void ) {
+    configapi_register( "bma", bma_configapi_fields, sizeof( bma_configapi_fields ) / sizeof( configapi_field_t ), bma_save_config );
     TTGOClass *ttgo = TTGOClass::getWatch();
 
     bma_event_handle = xEventGroupCreate();
@@ -152,6 +163,9 @@ void bma_loop( void ) {
  *
  */
 void bma_save_config( void ) {
+    if ( configapi_defer_save( bma_save_config ) ) {
+        return;
+    }
     if ( SPIFFS.exists( BMA_COFIG_FILE ) ) {
         SPIFFS.remove( BMA_COFIG_FILE );
         log_i("remove old binary bma config");
@@ -0,0 +1,344 @@
+/****************************************************************************
+ *   Sep 07 09:12:33 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include "configapi.h"
+#include "json_psram_allocator.h"
+
+portMUX_TYPE configapiMux = portMUX_INITIALIZER_UNLOCKED;
+
+static configapi_module_t *configapi_module_table = NULL;
+static uint32_t configapi_module_entrys = 0;
+
+static bool configapi_batch = false;
+static void ( * configapi_deferred[ CONFIGAPI_MAX_DEFERRED ] )( void );
+static uint32_t configapi_deferred_count = 0;
+
+static QueueHandle_t configapi_queue = NULL;
+static CONFIGAPI_CALLBACK_FUNC configapi_cb[ CONFIGAPI_MAX_CB ];
+static uint32_t configapi_cb_entrys = 0;
+
+static bool configapi_apply( JsonObjectConst patch );
+static const configapi_field_t *configapi_find_field( const configapi_module_t *module, const char *name );
+static bool configapi_check_field( const configapi_field_t *field, JsonVariantConst value );
+static bool configapi_equal_field( const configapi_field_t *field, JsonVariantConst value );
+static bool configapi_apply_field( const configapi_module_t *module, const configapi_field_t *field, JsonVariantConst value );
+
+void configapi_register( const char *name, const configapi_field_t *fields, size_t field_count, void ( * save )( void ) ) {
+    configapi_module_entrys++;
+
+    if ( configapi_module_table == NULL ) {
+        configapi_module_table = ( configapi_module_t * )ps_malloc( sizeof( configapi_module_t ) * configapi_module_entrys );
+        if ( configapi_module_table == NULL ) {
+            log_e("configapi_module_table malloc faild");
+            while(true);
+        }
+        configapi_queue = xQueueCreate( CONFIGAPI_MAX_QUEUED, sizeof( char * ) );
+        if ( configapi_queue == NULL ) {
+            log_e("configapi_queue create faild");
+            while(true);
+        }
+    }
+    else {
+        configapi_module_t *new_module_table = NULL;
+
+        new_module_table = ( configapi_module_t * )ps_realloc( configapi_module_table, sizeof( configapi_module_t ) * configapi_module_entrys );
+        if ( new_module_table == NULL ) {
+            log_e("configapi_module_table realloc faild");
+            while(true);
+        }
+        configapi_module_table = new_module_table;
+    }
+
+    configapi_module_table[ configapi_module_entrys - 1 ].name = name;
+    configapi_module_table[ configapi_module_entrys - 1 ].fields = fields;
+    configapi_module_table[ configapi_module_entrys - 1 ].field_count = field_count;
+    configapi_module_table[ configapi_module_entrys - 1 ].save = save;
+    log_i("register configapi module %s with %d fields", name, field_count );
+}
+
+void configapi_get( JsonObject root ) {
+    for ( int entry = 0 ; entry < configapi_module_entrys ; entry++ ) {
+        const configapi_module_t *module = &configapi_module_table[ entry ];
+        JsonObject object = root.createNestedObject( module->name );
+
+        for ( int i = 0 ; i < module->field_count ; i++ ) {
+            const configapi_field_t *field = &module->fields[ i ];
+            switch( field->type ) {
+                case CONFIGAPI_BOOL:    object[ field->name ] = field->get_bool();
+                                        break;
+                case CONFIGAPI_INT:     object[ field->name ] = field->get_int();
+                                        break;
+                case CONFIGAPI_STRING:  object[ field->name ] = field->get_string();
+                                        break;
+            }
+        }
+    }
+}
+
+configapi_result_t configapi_patch( JsonObjectConst patch, char *error, size_t size ) {
+    const configapi_module_t *module;
+    const configapi_field_t *field;
+    size_t len;
+    char *batch;
+
+    /*
+     * validate the whole batch before anything is changed
+     */
+    for ( JsonPairConst module_pair : patch ) {
+        module = NULL;
+        for ( int entry = 0 ; entry < configapi_module_entrys ; entry++ ) {
+            if ( !strcmp( configapi_module_table[ entry ].name, module_pair.key().c_str() ) ) {
+                module = &configapi_module_table[ entry ];
+                break;
+            }
+        }
+        if ( module == NULL ) {
+            snprintf( error, size, "unknown module %s", module_pair.key().c_str() );
+            return( CONFIGAPI_INVALID );
+        }
+        if ( !module_pair.value().is<JsonObjectConst>() ) {
+            snprintf( error, size, "%s: object expected", module->name );
+            return( CONFIGAPI_INVALID );
+        }
+        for ( JsonPairConst field_pair : module_pair.value().as<JsonObjectConst>() ) {
+            field = configapi_find_field( module, field_pair.key().c_str() );
+            if ( field == NULL ) {
+                snprintf( error, size, "%s.%s: unknown field", module->name, field_pair.key().c_str() );
+                return( CONFIGAPI_INVALID );
+            }
+            if ( !configapi_check_field( field, field_pair.value() ) ) {
+                snprintf( error, size, "%s.%s: invalid value", module->name, field->name );
+                return( CONFIGAPI_INVALID );
+            }
+            if ( field->set_bool == NULL && field->set_int == NULL && field->set_string == NULL && !configapi_equal_field( field, field_pair.value() ) ) {
+                snprintf( error, size, "%s.%s: read only", module->name, field->name );
+                return( CONFIGAPI_INVALID );
+            }
+        }
+    }
+
+    /*
+     * the setters touch the display, spi and i2c, so they run in the main loop
+     */
+    len = measureJson( patch ) + 1;
+    batch = ( char * )ps_malloc( len );
+    if ( batch == NULL ) {
+        snprintf( error, size, "out of memory" );
+        return( CONFIGAPI_BUSY );
+    }
+    serializeJson( patch, batch, len );
+    if ( xQueueSend( configapi_queue, &batch, 0 ) != pdTRUE ) {
+        free( batch );
+        snprintf( error, size, "busy, try again" );
+        return( CONFIGAPI_BUSY );
+    }
+    return( CONFIGAPI_QUEUED );
+}
+
+void configapi_loop( void ) {
+    bool changed = false;
+    char *batch = NULL;
+
+    if ( configapi_queue == NULL ) {
+        return;
+    }
+
+    while ( xQueueReceive( configapi_queue, &batch, 0 ) == pdTRUE ) {
+        SpiRamJsonDocument patch( 2048 );
+
+        if ( deserializeJson( patch, ( const char * )batch ) ) {
+            log_e("configapi: queued batch lost");
+        }
+        else if ( configapi_apply( patch.as<JsonObjectConst>() ) ) {
+            changed = true;
+        }
+        free( batch );
+    }
+
+    if ( changed ) {
+        for ( int entry = 0 ; entry < configapi_cb_entrys ; entry++ ) {
+            configapi_cb[ entry ]();
+        }
+    }
+}
+
+void configapi_register_cb( CONFIGAPI_CALLBACK_FUNC changed_cb ) {
+    if ( configapi_cb_entrys >= CONFIGAPI_MAX_CB ) {
+        log_e("configapi: no free callback entry");
+        return;
+    }
+    configapi_cb[ configapi_cb_entrys++ ] = changed_cb;
+}
+
+/*
+ * apply a validated batch with the module setters, saves called by the setters are deferred
+ */
+static bool configapi_apply( JsonObjectConst patch ) {
+    const configapi_module_t *module;
+    const configapi_field_t *field;
+    bool touched[ configapi_module_entrys ];
+    bool changed = false;
+
+    portENTER_CRITICAL( &configapiMux );
+    configapi_batch = true;
+    configapi_deferred_count = 0;
+    portEXIT_CRITICAL( &configapiMux );
+
+    for ( int entry = 0 ; entry < configapi_module_entrys ; entry++ ) {
+        module = &configapi_module_table[ entry ];
+        JsonObjectConst object = patch[ module->name ];
+        touched[ entry ] = false;
+
+        for ( JsonPairConst field_pair : object ) {
+            field = configapi_find_field( module, field_pair.key().c_str() );
+            if ( configapi_apply_field( module, field, field_pair.value() ) ) {
+                touched[ entry ] = true;
+                changed = true;
+            }
+        }
+    }
+
+    portENTER_CRITICAL( &configapiMux );
+    configapi_batch = false;
+    portEXIT_CRITICAL( &configapiMux );
+
+    /*
+     * one save per changed module and for saves deferred from other modules
+     */
+    for ( int entry = 0 ; entry < configapi_module_entrys ; entry++ ) {
+        if ( touched[ entry ] && configapi_module_table[ entry ].save ) {
+            configapi_module_table[ entry ].save();
+        }
+    }
+    for ( int i = 0 ; i < configapi_deferred_count ; i++ ) {
+        bool saved = false;
+        for ( int entry = 0 ; entry < configapi_module_entrys ; entry++ ) {
+            if ( touched[ entry ] && configapi_module_table[ entry ].save == configapi_deferred[ i ] ) {
+                saved = true;
+                break;
+            }
+        }
+        if ( !saved ) {
+            configapi_deferred[ i ]();
+        }
+    }
+
+    return( changed );
+}
+
+bool configapi_defer_save( void ( * save )( void ) ) {
+    bool deferred = false;
+
+    portENTER_CRITICAL( &configapiMux );
+    if ( configapi_batch ) {
+        deferred = true;
+        for ( int i = 0 ; i < configapi_deferred_count ; i++ ) {
+            if ( configapi_deferred[ i ] == save ) {
+                save = NULL;
+                break;
+            }
+        }
+        if ( save ) {
+            if ( configapi_deferred_count < CONFIGAPI_MAX_DEFERRED ) {
+                configapi_deferred[ configapi_deferred_count++ ] = save;
+            }
+            else {
+                deferred = false;
+            }
+        }
+    }
+    portEXIT_CRITICAL( &configapiMux );
+
+    return( deferred );
+}
+
+static const configapi_field_t *configapi_find_field( const configapi_module_t *module, const char *name ) {
+    for ( int i = 0 ; i < module->field_count ; i++ ) {
+        if ( !strcmp( module->fields[ i ].name, name ) ) {
+            return( &module->fields[ i ] );
+        }
+    }
+    return( NULL );
+}
+
+static bool configapi_check_field( const configapi_field_t *field, JsonVariantConst value ) {
+    int32_t number;
+
+    switch( field->type ) {
+        case CONFIGAPI_BOOL:
+            return( value.is<bool>() );
+        case CONFIGAPI_INT:
+            if ( !value.is<int32_t>() ) {
+                return( false );
+            }
+            number = value.as<int32_t>();
+            if ( number < field->min || number > field->max ) {
+                return( false );
+            }
+            return( field->step == 0 || ( number - field->min ) % field->step == 0 );
+        case CONFIGAPI_STRING:
+            return( value.is<const char *>() && strlen( value.as<const char *>() ) <= field->max );
+    }
+    return( false );
+}
+
+/*
+ * compare a checked value with what a GET returns
+ */
+static bool configapi_equal_field( const configapi_field_t *field, JsonVariantConst value ) {
+    switch( field->type ) {
+        case CONFIGAPI_BOOL:    return( field->get_bool() == value.as<bool>() );
+        case CONFIGAPI_INT:     return( field->get_int() == value.as<int32_t>() );
+        case CONFIGAPI_STRING:  return( !strcmp( field->get_string(), value.as<const char *>() ) );
+    }
+    return( false );
+}
+
+/*
+ * set a field only if it differs from what a GET returns, so a GET sent back as PATCH
+ * changes and saves nothing. the getter has to read back the value just set
+ */
+static bool configapi_apply_field( const configapi_module_t *module, const configapi_field_t *field, JsonVariantConst value ) {
+    /*
+     * a read only field may have changed since the batch was checked
+     */
+    if ( field->set_bool == NULL && field->set_int == NULL && field->set_string == NULL ) {
+        return( false );
+    }
+    if ( configapi_equal_field( field, value ) ) {
+        return( false );
+    }
+
+    switch( field->type ) {
+        case CONFIGAPI_BOOL:    field->set_bool( value.as<bool>() );
+                                break;
+        case CONFIGAPI_INT:     field->set_int( value.as<int32_t>() );
+                                break;
+        case CONFIGAPI_STRING:  field->set_string( value.as<const char *>() );
+                                break;
+    }
+
+    if ( !configapi_equal_field( field, value ) ) {
+        log_e("%s.%s: getter does not return the value set, GET/PATCH round trip broken", module->name, field->name );
+    }
+    return( true );
+}
@@ -0,0 +1,124 @@
+/****************************************************************************
+ *   Sep 07 09:12:33 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _CONFIGAPI_H
+    #define _CONFIGAPI_H
+
+    #include <ArduinoJson.h>
+
+    #define CONFIGAPI_MAX_DEFERRED      16          /** @brief max save functions deferred during a batch */
+    #define CONFIGAPI_MAX_QUEUED        4           /** @brief max validated batches waiting for configapi_loop() */
+    #define CONFIGAPI_MAX_CB            12          /** @brief max functions called after a batch is applied */
+
+    typedef enum {
+        CONFIGAPI_QUEUED = 0,                       /** @brief batch is valid and applied by configapi_loop() */
+        CONFIGAPI_INVALID,                          /** @brief batch rejected, see error message */
+        CONFIGAPI_BUSY                              /** @brief too many batches waiting, try again */
+    } configapi_result_t;
+
+    typedef void ( * CONFIGAPI_CALLBACK_FUNC ) ( void );
+
+    typedef enum {
+        CONFIGAPI_BOOL = 0,
+        CONFIGAPI_INT,
+        CONFIGAPI_STRING
+    } configapi_type_t;
+
+    /*
+     * @brief one setting of a module, a field without setter is read only
+     */
+    typedef struct {
+        const char *name;
+        configapi_type_t type;
+        int32_t min;                                /** @brief int: min value */
+        int32_t max;                                /** @brief int: max value, string: max length */
+        int32_t step;                               /** @brief int: value must be min + n * step, 0 for any value */
+        bool ( * get_bool )( void );
+        void ( * set_bool )( bool value );
+        int32_t ( * get_int )( void );
+        void ( * set_int )( int32_t value );
+        const char *( * get_string )( void );
+        void ( * set_string )( const char *value );
+    } configapi_field_t;
+
+    #define CONFIGAPI_BOOL_FIELD( name, get, set )                      { name, CONFIGAPI_BOOL, 0, 1, 0, get, set, NULL, NULL, NULL, NULL }
+    #define CONFIGAPI_INT_FIELD( name, min, max, step, get, set )       { name, CONFIGAPI_INT, min, max, step, NULL, NULL, get, set, NULL, NULL }
+    #define CONFIGAPI_STRING_FIELD( name, max_len, get, set )           { name, CONFIGAPI_STRING, 0, max_len, 0, NULL, NULL, NULL, NULL, get, set }
+
+    typedef struct {
+        const char *name;
+        const configapi_field_t *fields;
+        size_t field_count;
+        void ( * save )( void );                    /** @brief write the module config to spiffs */
+    } configapi_module_t;
+
+    /*
+     * @brief register the settings of a module
+     *
+     * @param   name        module name like "display", used as key in the json document
+     * @param   fields      pointer to the field table, must stay valid
+     * @param   field_count number of fields
+     * @param   save        function to write the module config
+     */
+    void configapi_register( const char *name, const configapi_field_t *fields, size_t field_count, void ( * save )( void ) );
+    /*
+     * @brief write the settings of all modules into a json object, { "display": { "brightness": 128, ... }, ... }
+     *
+     * @param   root        json object to fill
+     */
+    void configapi_get( JsonObject root );
+    /*
+     * @brief check a batch of changes and queue it for configapi_loop(). the whole batch is
+     * validated first and rejected if one field is unknown, read only, of the wrong type or
+     * out of range. a read only field with its current value is accepted, so the output of
+     * configapi_get can be sent back. safe to call from other tasks like the webserver
+     *
+     * @param   patch       json object like { "display": { "brightness": 128 }, "motor": { "vibe": false } }
+     * @param   error       destination for an error message
+     * @param   size        size of the error message
+     *
+     * @return  CONFIGAPI_QUEUED, CONFIGAPI_INVALID or CONFIGAPI_BUSY
+     */
+    configapi_result_t configapi_patch( JsonObjectConst patch, char *error, size_t size );
+    /*
+     * @brief apply the queued batches from the main loop. only fields that differ are applied
+     * with the module setters, each changed module is saved once and the registered callbacks
+     * are called when something has changed
+     */
+    void configapi_loop( void );
+    /*
+     * @brief register a function that is called from configapi_loop() after a batch has changed
+     * settings, to refresh the setup tiles
+     *
+     * @param   changed_cb  function to call
+     */
+    void configapi_register_cb( CONFIGAPI_CALLBACK_FUNC changed_cb );
+    /*
+     * @brief call at the beginning of a module save function. while a batch is applied
+     * the save is deferred and done once at the end of the batch
+     *
+     * @param   save        the save function itself
+     *
+     * @return  true if the save is deferred and the caller has to return
+     */
+    bool configapi_defer_save( void ( * save )( void ) );
+
+#endif // _CONFIGAPI_H
@@ -0,0 +1,128 @@
+/****************************************************************************
+ *   Aug 31 09:12:05 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include "datacache.h"
+
+bool datacache_load( const char *filename, datacache_t *cache, void *data, size_t size ) {
+    datacache_t header;
+
+    if ( !SPIFFS.exists( filename ) ) {
+        return( false );
+    }
+
+    fs::File file = SPIFFS.open( filename, FILE_READ );
+    if ( !file ) {
+        log_e("Can't open file: %s!", filename );
+        return( false );
+    }
+
+    if ( file.read( (uint8_t*)&header, sizeof( header ) ) != sizeof( header ) || header.magic != DATACACHE_MAGIC ) {
+        log_e("invalid cache file: %s", filename );
+        file.close();
+        return( false );
+    }
+
+    if ( header.version != cache->version || header.size != size || strcmp( header.key, cache->key ) ) {
+        log_i("outdated cache file: %s", filename );
+        file.close();
+        return( false );
+    }
+
+    if ( file.read( (uint8_t*)data, size ) != size ) {
+        log_e("truncated cache file: %s", filename );
+        file.close();
+        return( false );
+    }
+    file.close();
+
+    memcpy( cache, &header, sizeof( header ) );
+    log_i("load cache file: %s, age %lds", filename, time( NULL ) - cache->timestamp );
+    return( true );
+}
+
+bool datacache_save( const char *filename, datacache_t *cache, const void *data, size_t size ) {
+    cache->magic = DATACACHE_MAGIC;
+    cache->size = size;
+
+    fs::File file = SPIFFS.open( filename, FILE_WRITE );
+    if ( !file ) {
+        log_e("Can't open file: %s!", filename );
+        return( false );
+    }
+    bool retval = file.write( (const uint8_t*)cache, sizeof( datacache_t ) ) == sizeof( datacache_t ) &&
+                  file.write( (const uint8_t*)data, size ) == size;
+    file.close();
+
+    if ( !retval ) {
+        log_e("Failed to write cache file: %s", filename );
+        SPIFFS.remove( filename );
+    }
+    return( retval );
+}
+
+void datacache_set_key( datacache_t *cache, const char *key ) {
+    if ( !strncmp( cache->key, key, sizeof( cache->key ) - 1 ) ) {
+        return;
+    }
+    strlcpy( cache->key, key, sizeof( cache->key ) );
+    cache->timestamp = 0;
+    cache->etag[ 0 ] = '\0';
+    cache->last_modified[ 0 ] = '\0';
+}
+
+const char *datacache_get_conditional_headers( datacache_t *cache, char *headers, size_t size ) {
+    size_t len = 0;
+
+    headers[ 0 ] = '\0';
+    if ( cache->timestamp == 0 ) {
+        return( headers );
+    }
+    if ( cache->etag[ 0 ] ) {
+        len += snprintf( headers + len, size - len, "If-None-Match: %s\r\n", cache->etag );
+    }
+    if ( cache->last_modified[ 0 ] && len < size ) {
+        snprintf( headers + len, size - len, "If-Modified-Since: %s\r\n", cache->last_modified );
+    }
+    return( headers );
+}
+
+void datacache_update( datacache_t *cache, httpctl_response_t *response ) {
+    /*
+     * a 304 response may not repeat the validators
+     */
+    if ( response->httpcode != 304 || response->etag[ 0 ] ) {
+        strlcpy( cache->etag, response->etag, sizeof( cache->etag ) );
+    }
+    if ( response->httpcode != 304 || response->last_modified[ 0 ] ) {
+        strlcpy( cache->last_modified, response->last_modified, sizeof( cache->last_modified ) );
+    }
+    cache->timestamp = time( NULL );
+}
+
+bool datacache_is_stale( datacache_t *cache, time_t max_age ) {
+    time_t now = time( NULL );
+
+    if ( cache->timestamp == 0 || now < cache->timestamp ) {
+        return( true );
+    }
+    return( now - cache->timestamp > max_age );
+}
@@ -0,0 +1,100 @@
+/****************************************************************************
+ *   Aug 31 09:12:05 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _DATACACHE_H
+    #define _DATACACHE_H
+
+    #include "TTGO.h"
+    #include "httpctl.h"
+
+    #define DATACACHE_MAGIC             0x43444c4b  /** @brief file magic, "KLDC" */
+    #define DATACACHE_KEY_SIZE          48
+
+    /*
+     * @brief header of a cache file, followed by the raw data
+     */
+    typedef struct {
+        uint32_t magic = DATACACHE_MAGIC;
+        uint16_t version = 0;                                   /** @brief version of the data struct */
+        uint16_t size = 0;                                      /** @brief size of the data struct */
+        time_t timestamp = 0;                                   /** @brief time of the last successful fetch */
+        char key[ DATACACHE_KEY_SIZE ] = "";                    /** @brief source of the data like symbol or location */
+        char etag[ HTTPCTL_ETAG_SIZE ] = "";                    /** @brief ETag of the last response */
+        char last_modified[ HTTPCTL_LAST_MODIFIED_SIZE ] = "";  /** @brief Last-Modified of the last response */
+    } datacache_t;
+
+    /*
+     * @brief load cached data from flash
+     *
+     * @param   filename    cache file like "/weather.cache"
+     * @param   cache       pointer to the cache header, version and key must be set
+     * @param   data        pointer to the data
+     * @param   size        size of the data
+     *
+     * @return  true if data with the same version, size and key was loaded
+     */
+    bool datacache_load( const char *filename, datacache_t *cache, void *data, size_t size );
+    /*
+     * @brief save data and header to flash
+     *
+     * @param   filename    cache file like "/weather.cache"
+     * @param   cache       pointer to the cache header
+     * @param   data        pointer to the data
+     * @param   size        size of the data
+     *
+     * @return  true if success or false if fail
+     */
+    bool datacache_save( const char *filename, datacache_t *cache, const void *data, size_t size );
+    /*
+     * @brief set a new key, on change the timestamp and validators are cleared
+     *
+     * @param   cache       pointer to the cache header
+     * @param   key         source of the data like symbol or location
+     */
+    void datacache_set_key( datacache_t *cache, const char *key );
+    /*
+     * @brief build If-None-Match/If-Modified-Since header lines for a conditional request
+     *
+     * @param   cache       pointer to the cache header
+     * @param   headers     buffer for the header lines
+     * @param   size        size of the buffer
+     *
+     * @return  pointer to headers
+     */
+    const char *datacache_get_conditional_headers( datacache_t *cache, char *headers, size_t size );
+    /*
+     * @brief store the validators of an response and set the timestamp to now
+     *
+     * @param   cache       pointer to the cache header
+     * @param   response    pointer to the http response
+     */
+    void datacache_update( datacache_t *cache, httpctl_response_t *response );
+    /*
+     * @brief check if cached data is too old
+     *
+     * @param   cache       pointer to the cache header
+     * @param   max_age     max age in seconds
+     *
+     * @return  true if the data is stale or was never fetched
+     */
+    bool datacache_is_stale( datacache_t *cache, time_t max_age );
+
+#endif // _DATACACHE_H
@@ -0,0 +1,209 @@
+/****************************************************************************
+ *   Sep 01 18:42:17 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include "dataprovider.h"
+
+portMUX_TYPE dataproviderMux = portMUX_INITIALIZER_UNLOCKED;
+
+void dataprovider_send_event_cb( dataprovider_t *provider, EventBits_t event );
+void dataprovider_Task( void * pvParameters );
+static int dataprovider_update( dataprovider_t *provider, DATAPROVIDER_FETCH_FUNC update_cb );
+static void dataprovider_done( dataprovider_t *provider );
+
+dataprovider_t *dataprovider_create( const char *name, const char *filename, uint16_t version, void *data, size_t size, DATAPROVIDER_FETCH_FUNC fetch_cb, time_t ttl ) {
+    dataprovider_t *provider = ( dataprovider_t * )ps_calloc( sizeof( dataprovider_t ), 1 );
+    if ( provider == NULL ) {
+        log_e("dataprovider calloc faild");
+        while(true);
+    }
+
+    provider->name = name;
+    provider->filename = filename;
+    provider->data = data;
+    provider->size = size;
+    provider->scratch = ps_malloc( size );
+    if ( provider->scratch == NULL ) {
+        log_e("dataprovider scratch alloc faild");
+        while(true);
+    }
+    provider->fetch_cb = fetch_cb;
+    provider->ttl = ttl;
+    provider->cache.magic = DATACACHE_MAGIC;
+    provider->cache.version = version;
+
+    return( provider );
+}
+
+void dataprovider_register_cb( dataprovider_t *provider, EventBits_t event, DATAPROVIDER_CALLBACK_FUNC callback_func ) {
+    provider->event_cb_entrys++;
+
+    if ( provider->event_cb_table == NULL ) {
+        provider->event_cb_table = ( dataprovider_event_cb_t * )ps_malloc( sizeof( dataprovider_event_cb_t ) * provider->event_cb_entrys );
+        if ( provider->event_cb_table == NULL ) {
+            log_e("dataprovider_event_cb_table malloc faild");
+            while(true);
+        }
+    }
+    else {
+        dataprovider_event_cb_t *new_event_cb_table = NULL;
+
+        new_event_cb_table = ( dataprovider_event_cb_t * )ps_realloc( provider->event_cb_table, sizeof( dataprovider_event_cb_t ) * provider->event_cb_entrys );
+        if ( new_event_cb_table == NULL ) {
+            log_e("dataprovider_event_cb_table realloc faild");
+            while(true);
+        }
+        provider->event_cb_table = new_event_cb_table;
+    }
+
+    provider->event_cb_table[ provider->event_cb_entrys - 1 ].event = event;
+    provider->event_cb_table[ provider->event_cb_entrys - 1 ].event_cb = callback_func;
+    log_i("register %s dataprovider_event_cb success (%p)", provider->name, callback_func );
+}
+
+void dataprovider_send_event_cb( dataprovider_t *provider, EventBits_t event ) {
+    for ( int entry = 0 ; entry < provider->event_cb_entrys ; entry++ ) {
+        yield();
+        if ( event & provider->event_cb_table[ entry ].event ) {
+            provider->event_cb_table[ entry ].event_cb( event, provider->data );
+        }
+    }
+}
+
+bool dataprovider_load( dataprovider_t *provider, const char *key ) {
+    datacache_set_key( &provider->cache, key );
+    if ( !datacache_load( provider->filename, &provider->cache, provider->data, provider->size ) ) {
+        return( false );
+    }
+    dataprovider_send_event_cb( provider, DATAPROVIDER_UPDATE );
+    return( true );
+}
+
+bool dataprovider_request( dataprovider_t *provider, const char *key, bool force ) {
+    portENTER_CRITICAL( &dataproviderMux );
+    provider->request_count++;
+    if ( provider->fetching ) {
+        portEXIT_CRITICAL( &dataproviderMux );
+        log_i("%s: fetch already running", provider->name );
+        return( false );
+    }
+    provider->fetching = true;
+    portEXIT_CRITICAL( &dataproviderMux );
+
+    // the cache header is ours while fetching is set
+    datacache_set_key( &provider->cache, key );
+    if ( !force && !datacache_is_stale( &provider->cache, provider->ttl ) ) {
+        dataprovider_done( provider );
+        log_i("%s: data is fresh, skip fetch", provider->name );
+        return( false );
+    }
+
+    dataprovider_send_event_cb( provider, DATAPROVIDER_SYNC );
+    xTaskCreate(    dataprovider_Task,          /* Function to implement the task */
+                    provider->name,             /* Name of the task */
+                    5000,                       /* Stack size in words */
+                    provider,                   /* Task input parameter */
+                    1,                          /* Priority of the task */
+                    &provider->task );          /* Task handle. */
+    return( true );
+}
+
+void dataprovider_Task( void * pvParameters ) {
+    dataprovider_t *provider = ( dataprovider_t * )pvParameters;
+
+    log_i("start %s dataprovider task, heap: %d", provider->name, ESP.getFreeHeap() );
+
+    vTaskDelay( 250 );
+
+    uint32_t start = millis();
+    provider->fetch_count++;
+    int retval = dataprovider_update( provider, provider->fetch_cb );
+    provider->fetch_time += millis() - start;
+    if ( retval == 200 || retval == 304 ) {
+        datacache_save( provider->filename, &provider->cache, provider->data, provider->size );
+        dataprovider_send_event_cb( provider, retval == 200 ? DATAPROVIDER_UPDATE | DATAPROVIDER_DONE : DATAPROVIDER_DONE );
+    }
+    else {
+        dataprovider_send_event_cb( provider, DATAPROVIDER_FAIL );
+    }
+
+    dataprovider_done( provider );
+
+    log_i("finish %s dataprovider task, %d fetches for %d requests, heap: %d", provider->name, provider->fetch_count, provider->request_count, ESP.getFreeHeap() );
+    vTaskDelete( NULL );
+}
+
+bool dataprovider_push( dataprovider_t *provider, DATAPROVIDER_FETCH_FUNC push_cb ) {
+    portENTER_CRITICAL( &dataproviderMux );
+    if ( provider->fetching ) {
+        portEXIT_CRITICAL( &dataproviderMux );
+        log_i("%s: fetch running, push later", provider->name );
+        return( false );
+    }
+    provider->fetching = true;
+    portEXIT_CRITICAL( &dataproviderMux );
+
+    int retval = dataprovider_update( provider, push_cb );
+    if ( retval == 200 ) {
+        // the validators belong to the fetched data, not to the pushed one
+        provider->cache.etag[ 0 ] = '\0';
+        provider->cache.last_modified[ 0 ] = '\0';
+        provider->cache.timestamp = time( NULL );
+        provider->push_count++;
+        datacache_save( provider->filename, &provider->cache, provider->data, provider->size );
+        dataprovider_send_event_cb( provider, DATAPROVIDER_UPDATE | DATAPROVIDER_DONE );
+    }
+
+    dataprovider_done( provider );
+
+    return( retval == 200 );
+}
+
+/*
+ * write into a copy of data and cache header, a fetch that fails halfway leaves both untouched
+ */
+static int dataprovider_update( dataprovider_t *provider, DATAPROVIDER_FETCH_FUNC update_cb ) {
+    datacache_t cache = provider->cache;
+
+    memcpy( provider->scratch, provider->data, provider->size );
+    int retval = update_cb( provider->scratch, &cache );
+    if ( retval == 200 || retval == 304 ) {
+        if ( retval == 200 ) {
+            memcpy( provider->data, provider->scratch, provider->size );
+        }
+        provider->cache = cache;
+    }
+    return( retval );
+}
+
+static void dataprovider_done( dataprovider_t *provider ) {
+    portENTER_CRITICAL( &dataproviderMux );
+    provider->fetching = false;
+    portEXIT_CRITICAL( &dataproviderMux );
+}
+
+bool dataprovider_is_stale( dataprovider_t *provider, time_t max_age ) {
+    return( datacache_is_stale( &provider->cache, max_age ) );
+}
+
+time_t dataprovider_get_timestamp( dataprovider_t *provider ) {
+    return( provider->cache.timestamp );
+}
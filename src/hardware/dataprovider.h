@@ -0,0 +1,139 @@
+/****************************************************************************
+ *   Sep 01 18:42:17 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _DATAPROVIDER_H
+    #define _DATAPROVIDER_H
+
+    #include "TTGO.h"
+    #include "datacache.h"
+
+    #define DATAPROVIDER_SYNC           _BV(0)      /** @brief a fetch was started */
+    #define DATAPROVIDER_UPDATE         _BV(1)      /** @brief new data was fetched or loaded from flash */
+    #define DATAPROVIDER_DONE           _BV(2)      /** @brief a fetch was successful, send after DATAPROVIDER_UPDATE or alone if the data is unchanged */
+    #define DATAPROVIDER_FAIL           _BV(3)      /** @brief a fetch failed */
+
+    /*
+     * @brief fetch data into the provider buffer, conditional requests use the cache validators
+     *
+     * @param   data        pointer to the provider data
+     * @param   cache       pointer to the provider cache header
+     *
+     * @return  200 on new data, 304 if unchanged or -1 if fail
+     */
+    typedef int ( * DATAPROVIDER_FETCH_FUNC ) ( void *data, datacache_t *cache );
+    typedef void ( * DATAPROVIDER_CALLBACK_FUNC ) ( EventBits_t event, void *data );
+
+    typedef struct {
+        EventBits_t event;
+        DATAPROVIDER_CALLBACK_FUNC event_cb;
+    } dataprovider_event_cb_t;
+
+    typedef struct {
+        const char *name;                           /** @brief name for logging and the fetch task */
+        const char *filename;                       /** @brief cache file */
+        void *data;                                 /** @brief data shared by all subscribers */
+        void *scratch;                              /** @brief a fetch writes here, the data is only replaced on success */
+        size_t size;                                /** @brief size of the data */
+        time_t ttl;                                 /** @brief time in seconds the data is fresh and not fetched again */
+        DATAPROVIDER_FETCH_FUNC fetch_cb;
+        datacache_t cache;
+        bool fetching;                              /** @brief a fetch task is running, only it changes the cache header */
+        TaskHandle_t task;
+        dataprovider_event_cb_t *event_cb_table;
+        uint32_t event_cb_entrys;
+        uint32_t request_count;                     /** @brief number of requests */
+        uint32_t fetch_count;                       /** @brief number of fetches, the rest was fresh or in flight */
+        uint32_t fetch_time;                        /** @brief ms spent in all fetches */
+        uint32_t push_count;                        /** @brief number of updates pushed from an other source */
+    } dataprovider_t;
+
+    /*
+     * @brief create a provider for one remote data source
+     *
+     * @param   name        name of the source like "weather"
+     * @param   filename    cache file like "/weather.cache"
+     * @param   version     version of the data struct, used to drop outdated cache files
+     * @param   data        pointer to the data
+     * @param   size        size of the data
+     * @param   fetch_cb    function to fetch the data
+     * @param   ttl         time in seconds the data is fresh
+     *
+     * @return  pointer to the new provider
+     */
+    dataprovider_t *dataprovider_create( const char *name, const char *filename, uint16_t version, void *data, size_t size, DATAPROVIDER_FETCH_FUNC fetch_cb, time_t ttl );
+    /*
+     * @brief register an subscriber
+     *
+     * @param   provider    pointer to the provider
+     * @param   event       possible values: DATAPROVIDER_SYNC, DATAPROVIDER_UPDATE, DATAPROVIDER_DONE and DATAPROVIDER_FAIL
+     * @param   callback_func   pointer to the callback function
+     */
+    void dataprovider_register_cb( dataprovider_t *provider, EventBits_t event, DATAPROVIDER_CALLBACK_FUNC callback_func );
+    /*
+     * @brief load the last known data from flash, subscribers get an DATAPROVIDER_UPDATE
+     *
+     * @param   provider    pointer to the provider
+     * @param   key         source of the data like symbol or location
+     *
+     * @return  true if data was loaded
+     */
+    bool dataprovider_load( dataprovider_t *provider, const char *key );
+    /*
+     * @brief request a fetch. nothing is done if a fetch is already running or the data
+     * is younger than the ttl, a changed key always trigger a fetch
+     *
+     * @param   provider    pointer to the provider
+     * @param   key         source of the data like symbol or location
+     * @param   force       ignore the ttl
+     *
+     * @return  true if a new fetch was started
+     */
+    bool dataprovider_request( dataprovider_t *provider, const char *key, bool force );
+    /*
+     * @brief update the data from an other source, like data pushed by the phone.
+     * subscribers get an DATAPROVIDER_UPDATE | DATAPROVIDER_DONE, the timestamp is set
+     * to now and the validators of the last fetch are cleared
+     *
+     * @param   provider    pointer to the provider
+     * @param   push_cb     function that writes the data, called at once
+     *
+     * @return  true if pushed, false if a fetch is running or push_cb failed
+     */
+    bool dataprovider_push( dataprovider_t *provider, DATAPROVIDER_FETCH_FUNC push_cb );
+    /*
+     * @brief check if the data is too old to be shown as current
+     *
+     * @param   provider    pointer to the provider
+     * @param   max_age     max age in seconds
+     *
+     * @return  true if stale
+     */
+    bool dataprovider_is_stale( dataprovider_t *provider, time_t max_age );
+    /*
+     * @brief get the time of the last successful fetch
+     *
+     * @param   provider    pointer to the provider
+     *
+     * @return  time of the last fetch or 0 if never
+     */
+    time_t dataprovider_get_timestamp( dataprovider_t *provider );
+
+#endif // _DATAPROVIDER_H
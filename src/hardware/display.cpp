@@ -28,15 +28,27 @@
 #include "bma.h"
 
 #include "json_psram_allocator.h"
+#include "configapi.h"
 
 display_config_t display_config;
 
 static uint8_t dest_brightness = 0;
 static uint8_t brightness = 0;
+/*
+ * settings for /api/config
+ */
+static const configapi_field_t display_configapi_fields[] = {
+    CONFIGAPI_INT_FIELD( "brightness", DISPLAY_MIN_BRIGHTNESS, DISPLAY_MAX_BRIGHTNESS, 0, []() -> int32_t { return( display_get_brightness() ); }, []( int32_t value ) { display_set_brightness( value ); } ),
+    CONFIGAPI_INT_FIELD( "timeout", DISPLAY_MIN_TIMEOUT, DISPLAY_MAX_TIMEOUT, 0, []() -> int32_t { return( display_get_timeout() ); }, []( int32_t value ) { display_set_timeout( value ); } ),
+    CONFIGAPI_INT_FIELD( "rotation", DISPLAY_MIN_ROTATE, DISPLAY_MAX_ROTATE, 90, []() -> int32_t { return( display_get_rotation() ); }, []( int32_t value ) { display_set_rotation( value ); bma_set_rotate_tilt( value ); } ),
+    CONFIGAPI_BOOL_FIELD( "block_return_maintile", []() -> bool { return( display_get_block_return_maintile() ); }, []( bool value ) { display_set_block_return_maintile( value ); } ),
+};
+
 /*
  *
  */
 void display_setup( void ) {
+    configapi_register( "display", display_configapi_fields, sizeof( display_configapi_fields ) / sizeof( configapi_field_t ), display_save_config );
     display_read_config();
 
     TTGOClass *ttgo = TTGOClass::getWatch();
@@ -113,6 +125,9 @@ void display_wakeup( bool silence ) {
  *
  */
 void display_save_config( void ) {
+    if ( configapi_defer_save( display_save_config ) ) {
+        return;
+    }
     if ( SPIFFS.exists( DISPLAY_CONFIG_FILE ) ) {
         SPIFFS.remove( DISPLAY_CONFIG_FILE );
         log_i("remove old binary display config");
@@ -0,0 +1,159 @@
+/****************************************************************************
+ *   Sep 16 19:05:37 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <string.h>
+#include <stdio.h>
+
+#include "espruino.h"
+
+static bool espruino_call( const char *stmt, size_t len, const char *name, int64_t *value );
+static const char *espruino_skip_space( const char *pos, const char *end );
+
+uint8_t espruino_exec( const char *line, espruino_cmd_t *cmd ) {
+    const char *start = line;
+    const char *pos = line;
+    uint8_t depth = 0;
+    char quote = 0;
+
+    memset( cmd, 0, sizeof( espruino_cmd_t ) );
+
+    /*
+     * a ; only ends a statement outside of brackets and strings, the settings
+     * function of Gadgetbridge has its own ; inside
+     */
+    for (;;) {
+        char c = *pos;
+
+        if ( c == '\0' || ( !quote && depth == 0 && ( c == ';' || c == '\n' ) ) ) {
+            const char *end = pos;
+            int64_t value;
+
+            start = espruino_skip_space( start, end );
+            while( end > start && ( end[ -1 ] == ' ' || end[ -1 ] == '\t' || end[ -1 ] == '\r' ) ) {
+                end--;
+            }
+            if ( end > start ) {
+                cmd->statements++;
+                if ( espruino_call( start, end - start, "setTime", &value ) && value / 1000 >= ESPRUINO_MIN_TIME && value / 1000 < ESPRUINO_MAX_TIME ) {
+                    cmd->found |= ESPRUINO_TIME;
+                    cmd->time = value / 1000;
+                    cmd->time_ms = value % 1000;
+                }
+                else if ( espruino_call( start, end - start, "E.setTimeZone", &value ) && value * 60 / 1000 >= ESPRUINO_MIN_TIMEZONE && value * 60 / 1000 <= ESPRUINO_MAX_TIMEZONE ) {
+                    cmd->found |= ESPRUINO_TIMEZONE;
+                    // round to a minute, 5.75h is 345 minutes
+                    cmd->timezone = ( value * 60 + ( value < 0 ? -500 : 500 ) ) / 1000;
+                }
+                else {
+                    cmd->skipped++;
+                }
+            }
+            if ( c == '\0' ) {
+                break;
+            }
+            start = pos + 1;
+        }
+        else if ( quote ) {
+            if ( c == '\\' && pos[ 1 ] ) {
+                pos++;
+            }
+            else if ( c == quote ) {
+                quote = 0;
+            }
+        }
+        else if ( c == '\'' || c == '"' || c == '`' ) {
+            quote = c;
+        }
+        else if ( c == '(' || c == '[' || c == '{' ) {
+            depth++;
+        }
+        else if ( ( c == ')' || c == ']' || c == '}' ) && depth ) {
+            depth--;
+        }
+        pos++;
+    }
+    return( cmd->found );
+}
+
+void espruino_tz( int16_t timezone, char *tz, size_t size ) {
+    int16_t west = -timezone;
+
+    if ( west % 60 ) {
+        snprintf( tz, size, "UTC%s%d:%02d", west < 0 ? "-" : "", ( west < 0 ? -west : west ) / 60, ( west < 0 ? -west : west ) % 60 );
+    }
+    else {
+        snprintf( tz, size, "UTC%d", west / 60 );
+    }
+}
+
+/*
+ * match name( number ) and return the number in 1/1000, like 2.5 as 2500
+ */
+static bool espruino_call( const char *stmt, size_t len, const char *name, int64_t *value ) {
+    const char *end = stmt + len;
+    size_t name_len = strlen( name );
+    const char *pos;
+    bool negative = false;
+    bool digits = false;
+    int64_t scale = 1000;
+    int64_t result = 0;
+
+    if ( len <= name_len || strncmp( stmt, name, name_len ) ) {
+        return( false );
+    }
+    pos = espruino_skip_space( stmt + name_len, end );
+    if ( pos == end || *pos++ != '(' ) {
+        return( false );
+    }
+    pos = espruino_skip_space( pos, end );
+    if ( pos < end && ( *pos == '-' || *pos == '+' ) ) {
+        negative = *pos++ == '-';
+    }
+    while( pos < end && *pos >= '0' && *pos <= '9' ) {
+        // more than 15 digits are no time
+        if ( result > 100000000000000000LL ) {
+            return( false );
+        }
+        result = result * 10 + ( *pos++ - '0' ) * 1000;
+        digits = true;
+    }
+    if ( pos < end && *pos == '.' ) {
+        pos++;
+        while( pos < end && *pos >= '0' && *pos <= '9' ) {
+            scale /= 10;
+            result += ( *pos++ - '0' ) * scale;
+            digits = true;
+        }
+    }
+    pos = espruino_skip_space( pos, end );
+    if ( !digits || pos == end || *pos++ != ')' || espruino_skip_space( pos, end ) != end ) {
+        return( false );
+    }
+    *value = negative ? -result : result;
+    return( true );
+}
+
+static const char *espruino_skip_space( const char *pos, const char *end ) {
+    while( pos < end && ( *pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n' ) ) {
+        pos++;
+    }
+    return( pos );
+}
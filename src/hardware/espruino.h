@@ -0,0 +1,72 @@
+/****************************************************************************
+ *   Sep 16 19:05:37 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _ESPRUINO_H
+    #define _ESPRUINO_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    /*
+     * a small interpreter for the Espruino commands of the Bangle.js protocol that
+     * are not a GB() message. Gadgetbridge sends them after the connect, like
+     *
+     * setTime(1600275937);E.setTimeZone(2.0);(s=>{...})(require('Storage').readJSON('setting.json',1))
+     *
+     * the line is split into its statements, setTime() and E.setTimeZone() are
+     * taken, everything else is skipped
+     */
+    #define ESPRUINO_TIME               0x01        /** @brief setTime() found */
+    #define ESPRUINO_TIMEZONE           0x02        /** @brief E.setTimeZone() found */
+
+    #define ESPRUINO_MIN_TIME           1577836800  /** @brief 2020-01-01, an earlier time is a phone without time */
+    #define ESPRUINO_MAX_TIME           4102444800  /** @brief 2100-01-01 */
+    #define ESPRUINO_MIN_TIMEZONE       ( -12 * 60 )
+    #define ESPRUINO_MAX_TIMEZONE       ( 14 * 60 )
+
+    typedef struct {
+        uint8_t found;                              /** @brief ESPRUINO_TIME and ESPRUINO_TIMEZONE */
+        int64_t time;                               /** @brief utc seconds of setTime() */
+        uint16_t time_ms;                           /** @brief fraction of setTime() */
+        int16_t timezone;                           /** @brief minutes east of utc of E.setTimeZone() */
+        uint16_t statements;
+        uint16_t skipped;                           /** @brief statements without a meaning for the watch */
+    } espruino_cmd_t;
+
+    /*
+     * @brief run a command line
+     *
+     * @param   line        the line without the framing chars, NUL terminated
+     * @param   cmd         pointer to the result
+     *
+     * @return  the found commands, ESPRUINO_TIME and/or ESPRUINO_TIMEZONE
+     */
+    uint8_t espruino_exec( const char *line, espruino_cmd_t *cmd );
+    /*
+     * @brief write the posix TZ string of a timezone, posix counts west of utc
+     *
+     * @param   timezone    minutes east of utc
+     * @param   tz          buffer for the string
+     * @param   size        size of the buffer, 16 are enough
+     */
+    void espruino_tz( int16_t timezone, char *tz, size_t size );
+
+#endif // _ESPRUINO_H
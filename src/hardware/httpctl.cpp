@@ -0,0 +1,717 @@
+/****************************************************************************
+ *   Aug 30 11:04:21 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include <Arduino.h>
+#include <WiFi.h>
+
+#include "httpctl.h"
+#include "wifictl.h"
+
+/*
+ * body stream of the current response, removes chunked transfer encoding
+ * and ends at the end of the body
+ */
+class HTTPCtlStream : public Stream {
+    public:
+        httpctl_con_t *con = NULL;
+
+        int available( void );
+        int read( void );
+        int peek( void );
+        size_t readBytes( char *buffer, size_t length );
+        size_t write( uint8_t data ) { return( 0 ); }
+        void flush( void ) {}
+};
+
+struct httpctl_con_t {
+    char host[ HTTPCTL_HOSTNAME_SIZE ] = "";
+    uint16_t port = 0;
+    WiFiClient client;
+    SemaphoreHandle_t lock = NULL;
+    uint32_t users = 0;
+    uint32_t last_used = 0;                     /** @brief millis() of the last response, compared as age */
+    bool reset = true;
+    bool reused = false;
+    bool keepalive = false;
+    uint32_t pending = 0;
+    // state of the current body
+    bool in_body = false;
+    bool chunked = false;
+    bool first_chunk = false;
+    bool until_close = false;
+    bool body_complete = false;                 /** @brief the end of the body was received, not only the end of the connection */
+    int32_t body_left = 0;
+    int peek_char = -1;
+    // statistics
+    uint32_t requests = 0;
+    uint32_t handshakes = 0;
+    HTTPCtlStream stream;
+};
+
+typedef struct {
+    char host[ HTTPCTL_HOSTNAME_SIZE ] = "";
+    IPAddress ip;
+    bool valid = false;
+    uint32_t inserted = 0;                      /** @brief millis() of the lookup, compared as age so the wrap is harmless */
+} httpctl_dns_entry_t;
+
+static httpctl_con_t httpctl_pool[ HTTPCTL_MAX_HOSTS ];
+static httpctl_dns_entry_t httpctl_dns_cache[ HTTPCTL_MAX_DNS_ENTRYS ];
+static SemaphoreHandle_t httpctl_pool_lock = NULL;
+
+static int httpctl_read_raw( httpctl_con_t *con );
+static int httpctl_read_line( httpctl_con_t *con, char *line, size_t size );
+static const char *httpctl_skip_space( const char *str );
+static bool httpctl_next_chunk( httpctl_con_t *con );
+static void httpctl_skip_body( httpctl_con_t *con );
+static bool httpctl_connect( httpctl_con_t *con );
+static bool httpctl_send_all( httpctl_con_t *con, int count, const char **path, const char **headers );
+static void httpctl_dns_invalidate( const char *host );
+void httpctl_wifictl_event_cb( EventBits_t event, char* msg );
+
+/*
+ *
+ */
+void httpctl_setup( void ) {
+    httpctl_pool_lock = xSemaphoreCreateMutex();
+
+    for ( int i = 0 ; i < HTTPCTL_MAX_HOSTS ; i++ ) {
+        httpctl_pool[ i ].lock = xSemaphoreCreateMutex();
+        httpctl_pool[ i ].stream.con = &httpctl_pool[ i ];
+    }
+
+    wifictl_register_cb( WIFICTL_OFF | WIFICTL_DISCONNECT, httpctl_wifictl_event_cb );
+}
+
+/*
+ * connections do not survive a wifi off/disconnect, the dns cache does
+ */
+void httpctl_wifictl_event_cb( EventBits_t event, char* msg ) {
+    switch( event ) {
+        case WIFICTL_OFF:
+        case WIFICTL_DISCONNECT:    xSemaphoreTake( httpctl_pool_lock, portMAX_DELAY );
+                                    for ( int i = 0 ; i < HTTPCTL_MAX_HOSTS ; i++ ) {
+                                        httpctl_pool[ i ].reset = true;
+                                    }
+                                    xSemaphoreGive( httpctl_pool_lock );
+                                    break;
+    }
+}
+
+/*
+ *
+ */
+const char *httpctl_split_url( const char *url, char *host, size_t host_size, uint16_t *port ) {
+    if ( strncmp( url, "http://", 7 ) ) {
+        log_e("only http:// is supported: %s", url );
+        return( NULL );
+    }
+
+    const char *start = url + 7;
+    const char *path = strchr( start, '/' );
+    if ( path == NULL ) {
+        path = start + strlen( start );
+    }
+
+    const char *colon = (const char *)memchr( start, ':', path - start );
+    const char *host_end = colon ? colon : path;
+    if ( host_end == start || (size_t)( host_end - start ) >= host_size ) {
+        log_e("invalid hostname in url: %s", url );
+        return( NULL );
+    }
+    memcpy( host, start, host_end - start );
+    host[ host_end - start ] = '\0';
+    *port = colon ? atoi( colon + 1 ) : 80;
+
+    return( *path ? path : "/" );
+}
+
+/*
+ *
+ */
+bool httpctl_resolve( const char *host, IPAddress &ip ) {
+    if ( ip.fromString( host ) ) {
+        return( true );
+    }
+
+    xSemaphoreTake( httpctl_pool_lock, portMAX_DELAY );
+    for ( int i = 0 ; i < HTTPCTL_MAX_DNS_ENTRYS ; i++ ) {
+        if ( !strcmp( httpctl_dns_cache[ i ].host, host ) && httpctl_dns_cache[ i ].valid && millis() - httpctl_dns_cache[ i ].inserted < HTTPCTL_DNS_TTL * 1000ul ) {
+            ip = httpctl_dns_cache[ i ].ip;
+            xSemaphoreGive( httpctl_pool_lock );
+            return( true );
+        }
+    }
+    xSemaphoreGive( httpctl_pool_lock );
+
+    if ( !WiFi.hostByName( host, ip ) ) {
+        log_e("resolve %s failed", host );
+        return( false );
+    }
+    log_i("resolve %s -> %s", host, ip.toString().c_str() );
+
+    // store in a matching, unused or the oldest entry
+    xSemaphoreTake( httpctl_pool_lock, portMAX_DELAY );
+    uint32_t now = millis();
+    httpctl_dns_entry_t *entry = &httpctl_dns_cache[ 0 ];
+    for ( int i = 0 ; i < HTTPCTL_MAX_DNS_ENTRYS ; i++ ) {
+        if ( !strcmp( httpctl_dns_cache[ i ].host, host ) ) {
+            entry = &httpctl_dns_cache[ i ];
+            break;
+        }
+        if ( entry->valid && ( !httpctl_dns_cache[ i ].valid || now - httpctl_dns_cache[ i ].inserted > now - entry->inserted ) ) {
+            entry = &httpctl_dns_cache[ i ];
+        }
+    }
+    strlcpy( entry->host, host, sizeof( entry->host ) );
+    entry->ip = ip;
+    entry->valid = true;
+    entry->inserted = now;
+    xSemaphoreGive( httpctl_pool_lock );
+
+    return( true );
+}
+
+static void httpctl_dns_invalidate( const char *host ) {
+    xSemaphoreTake( httpctl_pool_lock, portMAX_DELAY );
+    for ( int i = 0 ; i < HTTPCTL_MAX_DNS_ENTRYS ; i++ ) {
+        if ( !strcmp( httpctl_dns_cache[ i ].host, host ) ) {
+            httpctl_dns_cache[ i ].valid = false;
+        }
+    }
+    xSemaphoreGive( httpctl_pool_lock );
+}
+
+/*
+ *
+ */
+httpctl_con_t *httpctl_open( const char *host, uint16_t port ) {
+    httpctl_con_t *con = NULL;
+
+    xSemaphoreTake( httpctl_pool_lock, portMAX_DELAY );
+    // first try a connection to the same host, otherwise take the oldest unused one
+    for ( int i = 0 ; i < HTTPCTL_MAX_HOSTS ; i++ ) {
+        if ( !strcmp( httpctl_pool[ i ].host, host ) && httpctl_pool[ i ].port == port ) {
+            con = &httpctl_pool[ i ];
+            break;
+        }
+        if ( httpctl_pool[ i ].users == 0 && ( con == NULL || httpctl_pool[ i ].last_used < con->last_used ) ) {
+            con = &httpctl_pool[ i ];
+        }
+    }
+    if ( con == NULL ) {
+        xSemaphoreGive( httpctl_pool_lock );
+        log_e("no free http connection for %s", host );
+        return( NULL );
+    }
+    if ( strcmp( con->host, host ) || con->port != port ) {
+        strlcpy( con->host, host, sizeof( con->host ) );
+        con->port = port;
+        con->reset = true;
+        con->requests = 0;
+        con->handshakes = 0;
+    }
+    con->users++;
+    xSemaphoreGive( httpctl_pool_lock );
+
+    if ( xSemaphoreTake( con->lock, pdMS_TO_TICKS( HTTPCTL_TIMEOUT * 2 ) ) != pdTRUE ) {
+        log_e("http connection to %s busy", host );
+        xSemaphoreTake( httpctl_pool_lock, portMAX_DELAY );
+        con->users--;
+        xSemaphoreGive( httpctl_pool_lock );
+        return( NULL );
+    }
+
+    con->pending = 0;
+    con->in_body = false;
+    con->peek_char = -1;
+
+    if ( !httpctl_connect( con ) ) {
+        httpctl_close( con );
+        return( NULL );
+    }
+    return( con );
+}
+
+/*
+ * reuse the current tcp connection if possible, otherwise (re)connect
+ */
+static bool httpctl_connect( httpctl_con_t *con ) {
+    IPAddress ip;
+
+    if ( !con->reset && con->keepalive && con->client.connected() && millis() - con->last_used < HTTPCTL_KEEPALIVE_TIMEOUT * 1000l ) {
+        // throw away unexpected data from a previous response
+        while( con->client.available() ) {
+            con->client.read();
+        }
+        con->reused = true;
+        return( true );
+    }
+
+    con->client.stop();
+    con->reset = false;
+    con->reused = false;
+    con->keepalive = false;
+
+    for ( int retry = 0 ; retry < 2 ; retry++ ) {
+        if ( !httpctl_resolve( con->host, ip ) ) {
+            return( false );
+        }
+        con->handshakes++;
+        if ( con->client.connect( ip, con->port, HTTPCTL_TIMEOUT ) ) {
+            con->keepalive = true;
+            return( true );
+        }
+        // maybe the cached address is no longer valid
+        log_w("connect to %s (%s) failed", con->host, ip.toString().c_str() );
+        httpctl_dns_invalidate( con->host );
+    }
+    return( false );
+}
+
+/*
+ *
+ */
+bool httpctl_send( httpctl_con_t *con, const char *path, const char *headers ) {
+    if ( con->pending >= HTTPCTL_MAX_PIPELINE ) {
+        log_e("too many outstanding requests");
+        return( false );
+    }
+
+    // build the whole request in one buffer to send it in one tcp segment
+    size_t size = strlen( path ) + strlen( con->host ) + ( headers ? strlen( headers ) : 0 ) + 128;
+    char *request = (char *)ps_malloc( size );
+    if ( request == NULL ) {
+        log_e("ps_malloc error");
+        return( false );
+    }
+    size_t len = snprintf( request, size,   "GET %s HTTP/1.1\r\n"
+                                            "Host: %s\r\n"
+                                            "User-Agent: " HTTPCTL_USER_AGENT "\r\n"
+                                            "Accept-Encoding: identity\r\n"
+                                            "Connection: keep-alive\r\n"
+                                            "%s\r\n", path, con->host, headers ? headers : "" );
+
+    bool retval = con->client.write( (const uint8_t *)request, len ) == len;
+    free( request );
+
+    if ( !retval ) {
+        log_e("send request failed");
+        con->keepalive = false;
+        return( false );
+    }
+    con->pending++;
+    con->requests++;
+    return( true );
+}
+
+/*
+ *
+ */
+int httpctl_receive( httpctl_con_t *con, httpctl_response_t *response ) {
+    char line[ 128 ];
+
+    response->httpcode = -1;
+    response->content_length = -1;
+    response->range_start = -1;
+    response->range_total = -1;
+    response->chunked = false;
+    response->keepalive = false;
+    response->etag[ 0 ] = '\0';
+    response->last_modified[ 0 ] = '\0';
+
+    if ( con->in_body ) {
+        httpctl_skip_body( con );
+    }
+
+    if ( con->pending == 0 || !con->keepalive ) {
+        log_e("no outstanding response");
+        return( -1 );
+    }
+    con->pending--;
+
+    // status line, skip informational responses
+    do {
+        if ( httpctl_read_line( con, line, sizeof( line ) ) < 0 || strncmp( line, "HTTP/1.", 7 ) ) {
+            log_e("invalid status line");
+            con->keepalive = false;
+            return( -1 );
+        }
+        response->keepalive = line[ 7 ] != '0';
+        response->httpcode = atoi( line + 9 );
+
+        while( true ) {
+            int len = httpctl_read_line( con, line, sizeof( line ) );
+            if ( len < 0 ) {
+                con->keepalive = false;
+                response->httpcode = -1;
+                return( -1 );
+            }
+            if ( len == 0 ) {
+                break;
+            }
+            if ( !strncasecmp( line, "Content-Length:", 15 ) ) {
+                response->content_length = atol( line + 15 );
+            }
+            else if ( !strncasecmp( line, "Content-Range:", 14 ) ) {
+                // bytes <first>-<last>/<total or *>
+                const char *range = strstr( line + 14, "bytes " );
+                if ( range ) {
+                    const char *total = strchr( range, '/' );
+                    response->range_start = atol( range + 6 );
+                    if ( total && isdigit( total[ 1 ] ) ) {
+                        response->range_total = atol( total + 1 );
+                    }
+                }
+            }
+            else if ( !strncasecmp( line, "Transfer-Encoding:", 18 ) ) {
+                response->chunked = strcasestr( line + 18, "chunked" ) != NULL;
+            }
+            else if ( !strncasecmp( line, "Connection:", 11 ) ) {
+                if ( strcasestr( line + 11, "close" ) ) {
+                    response->keepalive = false;
+                }
+                else if ( strcasestr( line + 11, "keep-alive" ) ) {
+                    response->keepalive = true;
+                }
+            }
+            else if ( !strncasecmp( line, "ETag:", 5 ) ) {
+                strlcpy( response->etag, httpctl_skip_space( line + 5 ), sizeof( response->etag ) );
+            }
+            else if ( !strncasecmp( line, "Last-Modified:", 14 ) ) {
+                strlcpy( response->last_modified, httpctl_skip_space( line + 14 ), sizeof( response->last_modified ) );
+            }
+        }
+    } while( response->httpcode >= 100 && response->httpcode < 200 );
+
+    con->in_body = true;
+    con->chunked = response->chunked;
+    con->first_chunk = true;
+    con->until_close = false;
+    con->body_complete = false;
+    con->body_left = 0;
+    con->peek_char = -1;
+
+    if ( response->httpcode == 204 || response->httpcode == 304 ) {
+        con->in_body = false;
+        con->body_complete = true;
+    }
+    else if ( !response->chunked ) {
+        if ( response->content_length >= 0 ) {
+            con->body_left = response->content_length;
+            con->in_body = response->content_length > 0;
+            con->body_complete = response->content_length == 0;
+        }
+        else {
+            // body ends when the server close the connection
+            con->until_close = true;
+            response->keepalive = false;
+        }
+    }
+
+    con->keepalive = response->keepalive;
+    return( response->httpcode );
+}
+
+/*
+ *
+ */
+Stream *httpctl_get_stream( httpctl_con_t *con ) {
+    return( &con->stream );
+}
+
+/*
+ *
+ */
+bool httpctl_body_complete( httpctl_con_t *con ) {
+    return( con->body_complete );
+}
+
+/*
+ *
+ */
+void httpctl_close( httpctl_con_t *con ) {
+    if ( con == NULL ) {
+        return;
+    }
+
+    // keep the connection only if all responses are complete received, a large unread body is not worth it
+    if ( con->in_body && !con->until_close && ( con->chunked || con->body_left <= HTTPCTL_MAX_SKIP ) ) {
+        httpctl_skip_body( con );
+    }
+    if ( con->in_body || con->pending || !con->keepalive ) {
+        con->client.stop();
+        con->keepalive = false;
+    }
+    con->last_used = millis();
+    log_i("%s:%d, requests: %d, handshakes: %d", con->host, con->port, con->requests, con->handshakes );
+
+    xSemaphoreGive( con->lock );
+
+    xSemaphoreTake( httpctl_pool_lock, portMAX_DELAY );
+    con->users--;
+    xSemaphoreGive( httpctl_pool_lock );
+}
+
+/*
+ *
+ */
+httpctl_con_t *httpctl_get( const char *url, const char *headers, httpctl_response_t *response ) {
+    char host[ HTTPCTL_HOSTNAME_SIZE ];
+    uint16_t port;
+
+    const char *path = httpctl_split_url( url, host, sizeof( host ), &port );
+    if ( path == NULL ) {
+        return( NULL );
+    }
+    return( httpctl_get_pipelined( host, port, 1, &path, &headers, response ) );
+}
+
+/*
+ *
+ */
+httpctl_con_t *httpctl_get_pipelined( const char *host, uint16_t port, int count, const char **path, const char **headers, httpctl_response_t *response ) {
+    if ( count < 1 || count > HTTPCTL_MAX_PIPELINE ) {
+        log_e("invalid number of requests: %d", count );
+        return( NULL );
+    }
+
+    httpctl_con_t *con = httpctl_open( host, port );
+    if ( con == NULL ) {
+        return( NULL );
+    }
+
+    if ( httpctl_send_all( con, count, path, headers ) && httpctl_receive( con, response ) > 0 ) {
+        return( con );
+    }
+
+    // the server may have closed the idle keep-alive connection in the meantime, try once with a fresh one
+    if ( con->reused ) {
+        log_i("reused connection to %s failed, reconnect", host );
+        con->reset = true;
+        con->pending = 0;
+        con->in_body = false;
+        if ( httpctl_connect( con ) && httpctl_send_all( con, count, path, headers ) && httpctl_receive( con, response ) > 0 ) {
+            return( con );
+        }
+    }
+
+    httpctl_close( con );
+    return( NULL );
+}
+
+/*
+ * send the requests one after another without waiting for a response
+ */
+static bool httpctl_send_all( httpctl_con_t *con, int count, const char **path, const char **headers ) {
+    for ( int i = 0 ; i < count ; i++ ) {
+        if ( !httpctl_send( con, path[ i ], headers ? headers[ i ] : NULL ) ) {
+            return( false );
+        }
+    }
+    return( true );
+}
+
+/*
+ * blocking read of one byte from the tcp connection
+ */
+static int httpctl_read_raw( httpctl_con_t *con ) {
+    uint32_t start = millis();
+
+    while( !con->client.available() ) {
+        if ( !con->client.connected() || millis() - start > HTTPCTL_TIMEOUT ) {
+            return( -1 );
+        }
+        delay( 1 );
+    }
+    return( con->client.read() );
+}
+
+/*
+ * read one line without "\r\n", too long lines are cut
+ */
+static int httpctl_read_line( httpctl_con_t *con, char *line, size_t size ) {
+    size_t len = 0;
+
+    while( true ) {
+        int c = httpctl_read_raw( con );
+        if ( c < 0 ) {
+            return( -1 );
+        }
+        if ( c == '\n' ) {
+            break;
+        }
+        if ( c != '\r' && len < size - 1 ) {
+            line[ len++ ] = c;
+        }
+    }
+    line[ len ] = '\0';
+    return( len );
+}
+
+/*
+ * skip leading spaces of a header value
+ */
+static const char *httpctl_skip_space( const char *str ) {
+    while( *str == ' ' || *str == '\t' ) {
+        str++;
+    }
+    return( str );
+}
+
+/*
+ * read the next chunk header, return false at the end of the body
+ */
+static bool httpctl_next_chunk( httpctl_con_t *con ) {
+    char line[ 32 ];
+
+    // every chunk except the first is terminated by "\r\n"
+    if ( !con->first_chunk && httpctl_read_line( con, line, sizeof( line ) ) != 0 ) {
+        con->keepalive = false;
+        return( false );
+    }
+    con->first_chunk = false;
+
+    if ( httpctl_read_line( con, line, sizeof( line ) ) <= 0 ) {
+        con->keepalive = false;
+        return( false );
+    }
+    if ( !isxdigit( line[ 0 ] ) ) {
+        con->keepalive = false;
+        return( false );
+    }
+    con->body_left = strtol( line, NULL, 16 );
+
+    if ( con->body_left <= 0 ) {
+        // the last chunk, skip trailer
+        con->body_complete = true;
+        int len;
+        do {
+            len = httpctl_read_line( con, line, sizeof( line ) );
+        } while( len > 0 );
+        if ( len < 0 ) {
+            con->keepalive = false;
+        }
+        return( false );
+    }
+    return( true );
+}
+
+/*
+ *
+ */
+static void httpctl_skip_body( httpctl_con_t *con ) {
+    char buffer[ 64 ];
+
+    while( con->stream.readBytes( buffer, sizeof( buffer ) ) > 0 );
+
+    if ( con->in_body ) {
+        con->keepalive = false;
+    }
+}
+
+int HTTPCtlStream::available( void ) {
+    if ( con->peek_char >= 0 ) {
+        return( 1 );
+    }
+    if ( !con->in_body ) {
+        return( 0 );
+    }
+    int avail = con->client.available();
+    if ( con->until_close ) {
+        return( avail );
+    }
+    return( avail < con->body_left ? avail : con->body_left );
+}
+
+int HTTPCtlStream::peek( void ) {
+    if ( con->peek_char < 0 ) {
+        con->peek_char = read();
+    }
+    return( con->peek_char );
+}
+
+int HTTPCtlStream::read( void ) {
+    if ( con->peek_char >= 0 ) {
+        int c = con->peek_char;
+        con->peek_char = -1;
+        return( c );
+    }
+    if ( !con->in_body ) {
+        return( -1 );
+    }
+    if ( con->until_close ) {
+        int c = httpctl_read_raw( con );
+        if ( c < 0 ) {
+            con->in_body = false;
+        }
+        return( c );
+    }
+    if ( con->body_left == 0 ) {
+        if ( !con->chunked || !httpctl_next_chunk( con ) ) {
+            con->in_body = false;
+            return( -1 );
+        }
+    }
+    int c = httpctl_read_raw( con );
+    if ( c < 0 ) {
+        con->in_body = false;
+        con->keepalive = false;
+        return( -1 );
+    }
+    con->body_left--;
+    if ( con->body_left == 0 && !con->chunked ) {
+        con->in_body = false;
+        con->body_complete = true;
+    }
+    return( c );
+}
+
+size_t HTTPCtlStream::readBytes( char *buffer, size_t length ) {
+    size_t count = 0;
+
+    while( count < length ) {
+        // copy directly from the tcp buffer if possible
+        if ( con->peek_char < 0 && con->in_body && !con->until_close && con->body_left > 0 && con->client.available() > 0 ) {
+            size_t len = length - count;
+            if ( len > (size_t)con->body_left ) {
+                len = con->body_left;
+            }
+            int read_len = con->client.read( (uint8_t *)&buffer[ count ], len );
+            if ( read_len > 0 ) {
+                count += read_len;
+                con->body_left -= read_len;
+                if ( con->body_left == 0 && !con->chunked ) {
+                    con->in_body = false;
+                    con->body_complete = true;
+                }
+                continue;
+            }
+        }
+        int c = read();
+        if ( c < 0 ) {
+            break;
+        }
+        buffer[ count++ ] = c;
+    }
+    return( count );
+}
@@ -0,0 +1,158 @@
+/****************************************************************************
+ *   Aug 30 11:04:21 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _HTTPCTL_H
+    #define _HTTPCTL_H
+
+    #include "TTGO.h"
+
+    #define HTTPCTL_MAX_HOSTS           4           /** @brief number of keep-alive connections in the pool */
+    #define HTTPCTL_MAX_DNS_ENTRYS      8           /** @brief number of cached hostnames */
+    #define HTTPCTL_DNS_TTL             3600        /** @brief time in seconds a resolved hostname is valid */
+    #define HTTPCTL_KEEPALIVE_TIMEOUT   30          /** @brief idle time in seconds after a connection is no longer reused */
+    #define HTTPCTL_TIMEOUT             5000        /** @brief connect/read timeout in ms */
+    #define HTTPCTL_MAX_PIPELINE        4           /** @brief max number of outstanding requests on one connection */
+    #define HTTPCTL_MAX_SKIP            4096        /** @brief max unread body in bytes that is skipped on close to keep the connection */
+    #define HTTPCTL_HOSTNAME_SIZE       64
+    #define HTTPCTL_ETAG_SIZE           64
+    #define HTTPCTL_LAST_MODIFIED_SIZE  32
+    #define HTTPCTL_USER_AGENT          "ESP32-" __FIRMWARE__
+
+    typedef struct {
+        int httpcode = -1;                          /** @brief http status code or -1 on error */
+        int32_t content_length = -1;                /** @brief size of the body, -1 if unknown */
+        int32_t range_start = -1;                   /** @brief first byte of a 206 partial response, -1 if not partial */
+        int32_t range_total = -1;                   /** @brief size of the whole file of a 206 partial response, -1 if unknown */
+        bool chunked = false;                       /** @brief body is send with chunked transfer encoding */
+        bool keepalive = false;                     /** @brief server allow to reuse the connection */
+        char etag[ HTTPCTL_ETAG_SIZE ] = "";        /** @brief ETag header for the next If-None-Match */
+        char last_modified[ HTTPCTL_LAST_MODIFIED_SIZE ] = "";   /** @brief Last-Modified header for the next If-Modified-Since */
+    } httpctl_response_t;
+
+    typedef struct httpctl_con_t httpctl_con_t;
+
+    /*
+     * @brief setup http controller, connection pool and dns cache
+     */
+    void httpctl_setup( void );
+    /*
+     * @brief split an http url into host, port and path
+     *
+     * @param   url         pointer to an url like "http://host:port/path"
+     * @param   host        buffer for the hostname
+     * @param   host_size   size of the hostname buffer
+     * @param   port        pointer to the port
+     *
+     * @return  pointer to the path inside the url or NULL if the url is not a valid http url
+     */
+    const char *httpctl_split_url( const char *url, char *host, size_t host_size, uint16_t *port );
+    /*
+     * @brief resolve a hostname over the dns cache
+     *
+     * @param   host    hostname to resolve
+     * @param   ip      resolved ip
+     *
+     * @return  true if success or false if fail
+     */
+    bool httpctl_resolve( const char *host, IPAddress &ip );
+    /*
+     * @brief get a connection from the pool and lock it for exclusive use.
+     * an existing keep-alive connection to the same host is reused
+     *
+     * @param   host    hostname
+     * @param   port    port
+     *
+     * @return  pointer to the connection or NULL if fail
+     */
+    httpctl_con_t *httpctl_open( const char *host, uint16_t port );
+    /*
+     * @brief send an GET request. multiple requests can be send before the first
+     * response is received (pipelining), the responses are received in the same order
+     *
+     * @param   con         pointer to the connection
+     * @param   path        path, example: "/data/2.5/weather?..."
+     * @param   headers     additional header lines terminated with "\r\n" or NULL
+     *
+     * @return  true if success or false if fail
+     */
+    bool httpctl_send( httpctl_con_t *con, const char *path, const char *headers );
+    /*
+     * @brief receive the status and header of the next outstanding response,
+     * the unread body of the previous response is skipped
+     *
+     * @param   con         pointer to the connection
+     * @param   response    pointer to the response struct
+     *
+     * @return  http status code or -1 if fail
+     */
+    int httpctl_receive( httpctl_con_t *con, httpctl_response_t *response );
+    /*
+     * @brief get a stream to the body of the current response. the stream ends
+     * at the end of the body and removes the chunked transfer encoding
+     *
+     * @param   con         pointer to the connection
+     *
+     * @return  pointer to the body stream
+     */
+    Stream *httpctl_get_stream( httpctl_con_t *con );
+    /*
+     * @brief check if the body of the current response was received up to its end, the
+     * last chunk or Content-Length. a lost connection also ends the stream but not the body,
+     * a body without length ends with the connection and is never complete
+     *
+     * @param   con         pointer to the connection
+     *
+     * @return  true if the body is complete
+     */
+    bool httpctl_body_complete( httpctl_con_t *con );
+    /*
+     * @brief release the connection, it stay open for the next request if possible
+     *
+     * @param   con         pointer to the connection
+     */
+    void httpctl_close( httpctl_con_t *con );
+    /*
+     * @brief open, send and receive a single GET request
+     *
+     * @param   url         url to fetch
+     * @param   headers     additional header lines terminated with "\r\n" or NULL
+     * @param   response    pointer to the response struct
+     *
+     * @return  pointer to the connection, it must be released with httpctl_close() or NULL if fail
+     */
+    httpctl_con_t *httpctl_get( const char *url, const char *headers, httpctl_response_t *response );
+    /*
+     * @brief open a connection and send several GET requests to one host at once (pipelining).
+     * the response of the first request is received, the next ones with httpctl_receive().
+     * a server that closes the connection after a response loses the requests behind it
+     *
+     * @param   host        hostname
+     * @param   port        port
+     * @param   count       number of requests, 1 to HTTPCTL_MAX_PIPELINE
+     * @param   path        path of each request
+     * @param   headers     additional header lines of each request or NULL
+     * @param   response    pointer to the response struct of the first request
+     *
+     * @return  pointer to the connection, it must be released with httpctl_close() or NULL if fail
+     */
+    httpctl_con_t *httpctl_get_pipelined( const char *host, uint16_t port, int count, const char **path, const char **headers, httpctl_response_t *response );
+
+#endif // _HTTPCTL_H
@@ -0,0 +1,471 @@
+/****************************************************************************
+ *   Aug 30 16:21:43 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include "json_extract.h"
+
+#define JSON_EXTRACT_READ_BUFFER    64
+
+typedef struct {
+    Stream *stream;
+    const json_extract_field_t *fields;
+    size_t field_count;
+    uint8_t *base;
+    char buffer[ JSON_EXTRACT_READ_BUFFER ];
+    size_t buffer_pos;
+    size_t buffer_len;
+    int peek;
+    char path[ JSON_EXTRACT_PATH_SIZE ];
+    size_t path_len;
+    int depth;
+    int found;
+} json_extract_ctx_t;
+
+static bool json_extract_value( json_extract_ctx_t *ctx );
+
+/*
+ * read the next char, never read behind the available data so the stream is not
+ * blocked at the end of the document
+ */
+static int json_extract_read( json_extract_ctx_t *ctx ) {
+    if ( ctx->peek >= 0 ) {
+        int c = ctx->peek;
+        ctx->peek = -1;
+        return( c );
+    }
+    if ( ctx->buffer_pos >= ctx->buffer_len ) {
+        int avail = ctx->stream->available();
+        size_t len = ( avail > JSON_EXTRACT_READ_BUFFER ) ? JSON_EXTRACT_READ_BUFFER : ( avail > 1 ? avail : 1 );
+        ctx->buffer_len = ctx->stream->readBytes( ctx->buffer, len );
+        ctx->buffer_pos = 0;
+        if ( ctx->buffer_len == 0 ) {
+            return( -1 );
+        }
+    }
+    return( (uint8_t)ctx->buffer[ ctx->buffer_pos++ ] );
+}
+
+static void json_extract_unread( json_extract_ctx_t *ctx, int c ) {
+    ctx->peek = c;
+}
+
+static int json_extract_skip_ws( json_extract_ctx_t *ctx ) {
+    int c;
+    do {
+        c = json_extract_read( ctx );
+    } while ( c == ' ' || c == '\t' || c == '\r' || c == '\n' );
+    return( c );
+}
+
+/*
+ * match the current path against a field path. "[]" match any index, the index
+ * of the first "[]" is returned in index or -1 if there is none
+ */
+static bool json_extract_match( const char *pattern, const char *path, int32_t *index ) {
+    *index = -1;
+    while ( *pattern && *path ) {
+        if ( pattern[0] == '[' && pattern[1] == ']' ) {
+            if ( *path != '[' ) {
+                return( false );
+            }
+            path++;
+            int32_t value = 0;
+            while ( *path >= '0' && *path <= '9' ) {
+                value = value * 10 + ( *path++ - '0' );
+            }
+            if ( *path != ']' ) {
+                return( false );
+            }
+            if ( *index == -1 ) {
+                *index = value;
+            }
+            pattern += 2;
+            path++;
+            continue;
+        }
+        if ( *pattern++ != *path++ ) {
+            return( false );
+        }
+    }
+    return( *pattern == '\0' && *path == '\0' );
+}
+
+/*
+ * get the destination for the current path, starting with field number start
+ */
+static void *json_extract_find( json_extract_ctx_t *ctx, size_t start, size_t *field_nr ) {
+    for ( size_t i = start ; i < ctx->field_count ; i++ ) {
+        const json_extract_field_t *field = &ctx->fields[ i ];
+        int32_t index;
+        if ( !json_extract_match( field->path, ctx->path, &index ) ) {
+            continue;
+        }
+        if ( index < 0 ) {
+            index = 0;
+        }
+        if ( (size_t)index >= field->count ) {
+            continue;
+        }
+        *field_nr = i;
+        return( ctx->base + field->offset + index * field->stride );
+    }
+    return( NULL );
+}
+
+static bool json_extract_path_append( json_extract_ctx_t *ctx, const char *segment ) {
+    size_t len = strlen( segment );
+    if ( ctx->path_len + len >= sizeof( ctx->path ) ) {
+        log_e("json path too long");
+        return( false );
+    }
+    memcpy( &ctx->path[ ctx->path_len ], segment, len + 1 );
+    ctx->path_len += len;
+    return( true );
+}
+
+static void json_extract_path_truncate( json_extract_ctx_t *ctx, size_t len ) {
+    ctx->path_len = len;
+    ctx->path[ len ] = '\0';
+}
+
+static size_t json_extract_put_utf8( char *dest, uint32_t codepoint ) {
+    if ( codepoint < 0x80 ) {
+        dest[0] = codepoint;
+        return( 1 );
+    }
+    else if ( codepoint < 0x800 ) {
+        dest[0] = 0xc0 | ( codepoint >> 6 );
+        dest[1] = 0x80 | ( codepoint & 0x3f );
+        return( 2 );
+    }
+    else if ( codepoint < 0x10000 ) {
+        dest[0] = 0xe0 | ( codepoint >> 12 );
+        dest[1] = 0x80 | ( ( codepoint >> 6 ) & 0x3f );
+        dest[2] = 0x80 | ( codepoint & 0x3f );
+        return( 3 );
+    }
+    dest[0] = 0xf0 | ( codepoint >> 18 );
+    dest[1] = 0x80 | ( ( codepoint >> 12 ) & 0x3f );
+    dest[2] = 0x80 | ( ( codepoint >> 6 ) & 0x3f );
+    dest[3] = 0x80 | ( codepoint & 0x3f );
+    return( 4 );
+}
+
+static bool json_extract_hex4( json_extract_ctx_t *ctx, uint32_t *codepoint ) {
+    *codepoint = 0;
+    for ( int i = 0 ; i < 4 ; i++ ) {
+        int h = json_extract_read( ctx );
+        if ( h >= '0' && h <= '9' ) *codepoint = ( *codepoint << 4 ) | ( h - '0' );
+        else if ( h >= 'a' && h <= 'f' ) *codepoint = ( *codepoint << 4 ) | ( h - 'a' + 10 );
+        else if ( h >= 'A' && h <= 'F' ) *codepoint = ( *codepoint << 4 ) | ( h - 'A' + 10 );
+        else return( false );
+    }
+    return( true );
+}
+
+/*
+ * copy a char as long as it fits, after the first char that does not fit nothing more is copied
+ */
+static void json_extract_copy( char *dest, size_t size, size_t *len, bool *truncated, const char *utf8, size_t utf8_len ) {
+    if ( dest == NULL || *truncated ) {
+        return;
+    }
+    if ( *len + utf8_len < size ) {
+        memcpy( &dest[ *len ], utf8, utf8_len );
+        *len += utf8_len;
+    }
+    else {
+        *truncated = true;
+    }
+}
+
+/*
+ * read a string after the opening quote. if dest is NULL the string is skipped,
+ * otherwise it is copied and truncated to size. \uXXXX is written as utf-8, a
+ * surrogate pair as one 4 byte char and a lone surrogate as U+FFFD
+ */
+static bool json_extract_string( json_extract_ctx_t *ctx, char *dest, size_t size ) {
+    static const char replacement[] = "\xef\xbf\xbd";
+    uint32_t high_surrogate = 0;
+    bool truncated = false;
+    size_t len = 0;
+
+    while( true ) {
+        int c = json_extract_read( ctx );
+        uint32_t codepoint = 0;
+        bool unicode = false;
+        char utf8[4];
+        size_t utf8_len = 1;
+
+        if ( c < 0 || c == '\n' ) {
+            return( false );
+        }
+        if ( c == '\\' ) {
+            c = json_extract_read( ctx );
+            switch( c ) {
+                case 'b':   c = '\b'; break;
+                case 'f':   c = '\f'; break;
+                case 'n':   c = '\n'; break;
+                case 'r':   c = '\r'; break;
+                case 't':   c = '\t'; break;
+                case 'u':   if ( !json_extract_hex4( ctx, &codepoint ) ) {
+                                return( false );
+                            }
+                            unicode = true;
+                            break;
+                case -1:    return( false );
+                default:    break;
+            }
+        }
+        else if ( c == '"' ) {
+            c = -1;
+        }
+        /*
+         * a high surrogate only counts together with the low surrogate right after it
+         */
+        if ( high_surrogate && !( unicode && codepoint >= 0xdc00 && codepoint < 0xe000 ) ) {
+            json_extract_copy( dest, size, &len, &truncated, replacement, 3 );
+            high_surrogate = 0;
+        }
+        if ( c == -1 ) {
+            break;
+        }
+        if ( unicode ) {
+            if ( codepoint >= 0xd800 && codepoint < 0xdc00 ) {
+                high_surrogate = codepoint;
+                continue;
+            }
+            if ( codepoint >= 0xdc00 && codepoint < 0xe000 ) {
+                codepoint = high_surrogate ? 0x10000 + ( ( high_surrogate - 0xd800 ) << 10 ) + ( codepoint - 0xdc00 ) : 0xfffd;
+                high_surrogate = 0;
+            }
+            utf8_len = json_extract_put_utf8( utf8, codepoint );
+        }
+        else {
+            utf8[0] = c;
+        }
+        json_extract_copy( dest, size, &len, &truncated, utf8, utf8_len );
+    }
+
+    /*
+     * don't leave a half utf-8 char from the stream at the end of a truncated string
+     */
+    if ( truncated ) {
+        size_t lead = len;
+        while( lead > 0 && ( dest[ lead - 1 ] & 0xc0 ) == 0x80 ) {
+            lead--;
+        }
+        if ( lead > 0 && ( dest[ lead - 1 ] & 0x80 ) ) {
+            uint8_t first = dest[ lead - 1 ];
+            size_t need = ( first >= 0xf0 ) ? 4 : ( first >= 0xe0 ) ? 3 : 2;
+            if ( len - lead + 1 < need ) {
+                len = lead - 1;
+            }
+        }
+    }
+
+    if ( dest && size ) {
+        dest[ len ] = '\0';
+    }
+    return( true );
+}
+
+/*
+ * store a number, literal or string value in all matching fields, starting with field number start
+ */
+static void json_extract_store( json_extract_ctx_t *ctx, size_t start, const char *token, bool is_string ) {
+    size_t field_nr = 0;
+    void *dest;
+
+    if ( !is_string && !strcmp( token, "null" ) ) {
+        return;
+    }
+
+    for ( ; ( dest = json_extract_find( ctx, start, &field_nr ) ) != NULL ; start = field_nr + 1 ) {
+        const json_extract_field_t *field = &ctx->fields[ field_nr ];
+
+        switch( field->type ) {
+            case JSON_EXTRACT_STRING:   strlcpy( (char*)dest, token, field->size );
+                                        break;
+            case JSON_EXTRACT_INT:      *(int32_t*)dest = atol( token );
+                                        break;
+            case JSON_EXTRACT_FLOAT:    *(float*)dest = atof( token );
+                                        break;
+            case JSON_EXTRACT_BOOL:     *(bool*)dest = !strcmp( token, "true" ) || ( is_string && atol( token ) );
+                                        break;
+        }
+        ctx->found++;
+    }
+}
+
+static bool json_extract_object( json_extract_ctx_t *ctx ) {
+    size_t path_len = ctx->path_len;
+    int c = json_extract_skip_ws( ctx );
+
+    if ( c == '}' ) {
+        return( true );
+    }
+
+    while( true ) {
+        if ( c != '"' ) {
+            return( false );
+        }
+        /*
+         * read the key direct into the path, a truncated key just never match
+         */
+        if ( path_len ) {
+            json_extract_path_append( ctx, "." );
+        }
+        if ( !json_extract_string( ctx, &ctx->path[ ctx->path_len ], sizeof( ctx->path ) - ctx->path_len ) ) {
+            return( false );
+        }
+        ctx->path_len += strlen( &ctx->path[ ctx->path_len ] );
+        if ( json_extract_skip_ws( ctx ) != ':' ) {
+            return( false );
+        }
+        if ( !json_extract_value( ctx ) ) {
+            return( false );
+        }
+        json_extract_path_truncate( ctx, path_len );
+
+        c = json_extract_skip_ws( ctx );
+        if ( c == '}' ) {
+            return( true );
+        }
+        if ( c != ',' ) {
+            return( false );
+        }
+        c = json_extract_skip_ws( ctx );
+    }
+}
+
+static bool json_extract_array( json_extract_ctx_t *ctx ) {
+    size_t path_len = ctx->path_len;
+    char index[ 16 ];
+    int c = json_extract_skip_ws( ctx );
+
+    if ( c == ']' ) {
+        return( true );
+    }
+    json_extract_unread( ctx, c );
+
+    for ( uint32_t i = 0 ;; i++ ) {
+        snprintf( index, sizeof( index ), "[%d]", i );
+        if ( !json_extract_path_append( ctx, index ) ) {
+            return( false );
+        }
+        if ( !json_extract_value( ctx ) ) {
+            return( false );
+        }
+        json_extract_path_truncate( ctx, path_len );
+
+        c = json_extract_skip_ws( ctx );
+        if ( c == ']' ) {
+            return( true );
+        }
+        if ( c != ',' ) {
+            return( false );
+        }
+    }
+}
+
+static bool json_extract_value( json_extract_ctx_t *ctx ) {
+    char token[ JSON_EXTRACT_TOKEN_SIZE ];
+    bool retval = false;
+    int c = json_extract_skip_ws( ctx );
+
+    switch( c ) {
+        case '{':
+        case '[':   if ( ctx->depth >= JSON_EXTRACT_MAX_DEPTH ) {
+                        log_e("json nested too deep");
+                        return( false );
+                    }
+                    ctx->depth++;
+                    retval = ( c == '{' ) ? json_extract_object( ctx ) : json_extract_array( ctx );
+                    ctx->depth--;
+                    return( retval );
+        case '"':   {
+                        /*
+                         * copy strings direct into the first matching destination
+                         */
+                        size_t field_nr;
+                        void *dest = json_extract_find( ctx, 0, &field_nr );
+                        if ( dest && ctx->fields[ field_nr ].type == JSON_EXTRACT_STRING ) {
+                            if ( !json_extract_string( ctx, (char*)dest, ctx->fields[ field_nr ].size ) ) {
+                                return( false );
+                            }
+                            ctx->found++;
+                            json_extract_store( ctx, field_nr + 1, (const char*)dest, true );
+                            return( true );
+                        }
+                        if ( !json_extract_string( ctx, dest ? token : NULL, sizeof( token ) ) ) {
+                            return( false );
+                        }
+                        if ( dest ) {
+                            json_extract_store( ctx, field_nr, token, true );
+                        }
+                        return( true );
+                    }
+        case -1:    return( false );
+        default:    {
+                        size_t len = 0;
+                        while( c == '-' || c == '+' || c == '.' || ( c >= '0' && c <= '9' ) || ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) ) {
+                            if ( len < sizeof( token ) - 1 ) {
+                                token[ len++ ] = c;
+                            }
+                            c = json_extract_read( ctx );
+                        }
+                        token[ len ] = '\0';
+                        if ( len == 0 ) {
+                            return( false );
+                        }
+                        json_extract_unread( ctx, c );
+                        json_extract_store( ctx, 0, token, false );
+                        return( true );
+                    }
+    }
+}
+
+int json_extract( Stream &stream, const json_extract_field_t *fields, size_t field_count, void *base ) {
+    json_extract_ctx_t *ctx = (json_extract_ctx_t*)calloc( sizeof( json_extract_ctx_t ), 1 );
+    int retval = -1;
+
+    if ( ctx == NULL ) {
+        log_e("json_extract_ctx_t alloc failed");
+        return( -1 );
+    }
+
+    ctx->stream = &stream;
+    ctx->fields = fields;
+    ctx->field_count = field_count;
+    ctx->base = (uint8_t*)base;
+    ctx->peek = -1;
+
+    if ( json_extract_value( ctx ) ) {
+        retval = ctx->found;
+    }
+    else {
+        log_e("json parse error at \"%s\"", ctx->path );
+    }
+
+    free( ctx );
+    return( retval );
+}
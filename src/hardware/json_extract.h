@@ -0,0 +1,77 @@
+/****************************************************************************
+ *   Aug 30 16:21:43 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _JSON_EXTRACT_H
+    #define _JSON_EXTRACT_H
+
+    #include "TTGO.h"
+    #include <stddef.h>
+
+    #define JSON_EXTRACT_MAX_DEPTH      12          /** @brief max nesting of objects and arrays */
+    #define JSON_EXTRACT_PATH_SIZE      96          /** @brief max length of a path like "list[12].weather[0].icon" */
+    #define JSON_EXTRACT_TOKEN_SIZE     32          /** @brief max length of a number or literal */
+
+    typedef enum {
+        JSON_EXTRACT_STRING = 0,                    /** @brief char array, numbers are copied as text */
+        JSON_EXTRACT_INT,                           /** @brief int32_t */
+        JSON_EXTRACT_FLOAT,                         /** @brief float */
+        JSON_EXTRACT_BOOL                           /** @brief bool */
+    } json_extract_type_t;
+
+    /*
+     * @brief describe one field to extract. "[]" in the path match any array index, the
+     * first "[]" select the destination element: dest = base + offset + index * stride
+     */
+    typedef struct {
+        const char *path;                           /** @brief path like "list[].main.temp" */
+        json_extract_type_t type;                   /** @brief type of the destination */
+        size_t offset;                              /** @brief offset of the destination in the base struct */
+        size_t size;                                /** @brief size of the destination */
+        size_t stride;                              /** @brief distance between two array elements */
+        size_t count;                               /** @brief number of array elements, later indices are skipped */
+    } json_extract_field_t;
+
+    /*
+     * @brief declare a field in a struct
+     */
+    #define JSON_EXTRACT_FIELD( path, type, struct_t, member ) \
+        { path, type, offsetof( struct_t, member ), sizeof( ((struct_t*)0)->member ), 0, 1 }
+    /*
+     * @brief declare a member of an struct array in a struct, used with "[]" in the path
+     */
+    #define JSON_EXTRACT_ARRAY_FIELD( path, type, struct_t, array, member ) \
+        { path, type, offsetof( struct_t, array[0].member ), sizeof( ((struct_t*)0)->array[0].member ), \
+          sizeof( ((struct_t*)0)->array[0] ), sizeof( ((struct_t*)0)->array ) / sizeof( ((struct_t*)0)->array[0] ) }
+
+    /*
+     * @brief read a json document from a stream and copy only declared fields into the
+     * destination struct. no document is build, memory use is constant
+     *
+     * @param   stream          stream to read from
+     * @param   fields          pointer to the field table
+     * @param   field_count     number of fields in the table
+     * @param   base            pointer to the destination struct
+     *
+     * @return  number of extracted values or -1 on a parse error
+     */
+    int json_extract( Stream &stream, const json_extract_field_t *fields, size_t field_count, void *base );
+
+#endif // _JSON_EXTRACT_H
@@ -0,0 +1,247 @@
+/****************************************************************************
+ *   Sep 07 18:44:02 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include <WiFi.h>
+#include <esp_heap_caps.h>
+
+#include "metrics.h"
+#include "pmu.h"
+#include "powermgm.h"
+#include "wifictl.h"
+#include "blectl.h"
+#include "notifyctl.h"
+
+portMUX_TYPE metricsMux = portMUX_INITIALIZER_UNLOCKED;
+
+/*
+ * upper bounds of the main loop histogram in us
+ */
+static const uint32_t metrics_loop_bounds[ METRICS_LOOP_BUCKETS ] = { 1000, 2000, 5000, 10000, 20000, 50000, 100000, 250000, 500000, 1000000 };
+static uint32_t metrics_loop_buckets[ METRICS_LOOP_BUCKETS + 1 ];
+static uint64_t metrics_loop_sum = 0;
+static uint32_t metrics_loop_count = 0;
+static TaskHandle_t metrics_loop_task = NULL;
+
+static uint32_t metrics_wifi_connects = 0;
+static uint32_t metrics_wifi_disconnects = 0;
+static uint32_t metrics_ble_connects = 0;
+
+/*
+ * values read in the main loop, lvgl and the pmu i2c bus are not touched from the webserver
+ */
+static uint32_t metrics_sample_time = 0;
+static lv_mem_monitor_t metrics_lv_mem;
+static float metrics_battery_voltage = 0;
+static float metrics_battery_charge_current = 0;
+static float metrics_battery_discharge_current = 0;
+static float metrics_vbus_voltage = 0;
+
+static void metrics_wifictl_event_cb( EventBits_t event, char *msg );
+static void metrics_blectl_event_cb( EventBits_t event, char *msg );
+static void metrics_write_header( Print &out, const char *name, const char *type, const char *help );
+
+void metrics_setup( void ) {
+    wifictl_register_cb( WIFICTL_CONNECT | WIFICTL_DISCONNECT, metrics_wifictl_event_cb );
+    blectl_register_cb( BLECTL_CONNECT, metrics_blectl_event_cb );
+}
+
+static void metrics_wifictl_event_cb( EventBits_t event, char *msg ) {
+    portENTER_CRITICAL( &metricsMux );
+    switch( event ) {
+        case WIFICTL_CONNECT:       metrics_wifi_connects++;
+                                    break;
+        case WIFICTL_DISCONNECT:    metrics_wifi_disconnects++;
+                                    break;
+    }
+    portEXIT_CRITICAL( &metricsMux );
+}
+
+static void metrics_blectl_event_cb( EventBits_t event, char *msg ) {
+    portENTER_CRITICAL( &metricsMux );
+    metrics_ble_connects++;
+    portEXIT_CRITICAL( &metricsMux );
+}
+
+void metrics_loop( uint32_t duration ) {
+    int bucket;
+
+    /*
+     * the loop sleeps in standby, that is not latency
+     */
+    if ( powermgm_get_event( POWERMGM_STANDBY ) ) {
+        return;
+    }
+
+    for( bucket = 0 ; bucket < METRICS_LOOP_BUCKETS && duration > metrics_loop_bounds[ bucket ] ; bucket++ );
+
+    portENTER_CRITICAL( &metricsMux );
+    metrics_loop_buckets[ bucket ]++;
+    metrics_loop_sum += duration;
+    metrics_loop_count++;
+    portEXIT_CRITICAL( &metricsMux );
+
+    if ( metrics_loop_task == NULL ) {
+        metrics_loop_task = xTaskGetCurrentTaskHandle();
+    }
+
+    if ( metrics_sample_time != 0 && millis() - metrics_sample_time < METRICS_SAMPLE_INTERVAL ) {
+        return;
+    }
+    metrics_sample_time = millis();
+
+    lv_mem_monitor( &metrics_lv_mem );
+    metrics_battery_voltage = pmu_get_battery_voltage() / 1000;
+    metrics_battery_charge_current = pmu_get_battery_charge_current() / 1000;
+    metrics_battery_discharge_current = pmu_get_battery_discharge_current() / 1000;
+    metrics_vbus_voltage = pmu_get_vbus_voltage() / 1000;
+}
+
+static void metrics_write_header( Print &out, const char *name, const char *type, const char *help ) {
+    out.printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type );
+}
+
+void metrics_write( Print &out ) {
+    uint32_t loop_buckets[ METRICS_LOOP_BUCKETS + 1 ];
+    uint64_t loop_sum;
+    uint32_t loop_count;
+    uint32_t wifi_connects, wifi_disconnects, ble_connects;
+    uint32_t cumulative = 0;
+
+    portENTER_CRITICAL( &metricsMux );
+    memcpy( loop_buckets, metrics_loop_buckets, sizeof( loop_buckets ) );
+    loop_sum = metrics_loop_sum;
+    loop_count = metrics_loop_count;
+    wifi_connects = metrics_wifi_connects;
+    wifi_disconnects = metrics_wifi_disconnects;
+    ble_connects = metrics_ble_connects;
+    portEXIT_CRITICAL( &metricsMux );
+
+    metrics_write_header( out, "watch_uptime_seconds", "gauge", "Time since boot" );
+    out.printf("watch_uptime_seconds %lu\n", millis() / 1000 );
+
+    /*
+     * memory
+     */
+    metrics_write_header( out, "watch_heap_free_bytes", "gauge", "Free internal heap" );
+    out.printf("watch_heap_free_bytes %u\n", heap_caps_get_free_size( MALLOC_CAP_INTERNAL ) );
+    metrics_write_header( out, "watch_heap_min_free_bytes", "gauge", "Lowest free internal heap since boot" );
+    out.printf("watch_heap_min_free_bytes %u\n", heap_caps_get_minimum_free_size( MALLOC_CAP_INTERNAL ) );
+    metrics_write_header( out, "watch_heap_largest_free_block_bytes", "gauge", "Largest free internal heap block" );
+    out.printf("watch_heap_largest_free_block_bytes %u\n", heap_caps_get_largest_free_block( MALLOC_CAP_INTERNAL ) );
+    metrics_write_header( out, "watch_psram_free_bytes", "gauge", "Free PSRAM" );
+    out.printf("watch_psram_free_bytes %u\n", heap_caps_get_free_size( MALLOC_CAP_SPIRAM ) );
+    metrics_write_header( out, "watch_psram_largest_free_block_bytes", "gauge", "Largest free PSRAM block" );
+    out.printf("watch_psram_largest_free_block_bytes %u\n", heap_caps_get_largest_free_block( MALLOC_CAP_SPIRAM ) );
+
+    metrics_write_header( out, "watch_lv_mem_total_bytes", "gauge", "Size of the lvgl heap" );
+    out.printf("watch_lv_mem_total_bytes %u\n", metrics_lv_mem.total_size );
+    metrics_write_header( out, "watch_lv_mem_free_bytes", "gauge", "Free lvgl heap" );
+    out.printf("watch_lv_mem_free_bytes %u\n", metrics_lv_mem.free_size );
+    metrics_write_header( out, "watch_lv_mem_max_used_bytes", "gauge", "Max used lvgl heap" );
+    out.printf("watch_lv_mem_max_used_bytes %u\n", metrics_lv_mem.max_used );
+    metrics_write_header( out, "watch_lv_mem_fragmentation_percent", "gauge", "Fragmentation of the lvgl heap" );
+    out.printf("watch_lv_mem_fragmentation_percent %u\n", metrics_lv_mem.frag_pct );
+
+    /*
+     * free stack of each task, esp-idf returns bytes
+     */
+    metrics_write_header( out, "watch_task_stack_free_bytes", "gauge", "Stack high water mark per task" );
+#if ( configUSE_TRACE_FACILITY == 1 )
+    UBaseType_t task_count = uxTaskGetNumberOfTasks();
+    TaskStatus_t *task_status = ( TaskStatus_t * )ps_malloc( sizeof( TaskStatus_t ) * task_count );
+    if ( task_status ) {
+        task_count = uxTaskGetSystemState( task_status, task_count, NULL );
+        for ( int i = 0 ; i < task_count ; i++ ) {
+            out.printf("watch_task_stack_free_bytes{task=\"%s\"} %u\n", task_status[ i ].pcTaskName, task_status[ i ].usStackHighWaterMark );
+        }
+        free( task_status );
+    }
+#else
+    if ( metrics_loop_task ) {
+        out.printf("watch_task_stack_free_bytes{task=\"%s\"} %u\n", pcTaskGetTaskName( metrics_loop_task ), uxTaskGetStackHighWaterMark( metrics_loop_task ) );
+    }
+    out.printf("watch_task_stack_free_bytes{task=\"%s\"} %u\n", pcTaskGetTaskName( NULL ), uxTaskGetStackHighWaterMark( NULL ) );
+#endif
+
+    /*
+     * main loop
+     */
+    metrics_write_header( out, "watch_loop_duration_seconds", "histogram", "Duration of one main loop iteration" );
+    for ( int bucket = 0 ; bucket < METRICS_LOOP_BUCKETS ; bucket++ ) {
+        cumulative += loop_buckets[ bucket ];
+        out.printf("watch_loop_duration_seconds_bucket{le=\"%g\"} %u\n", metrics_loop_bounds[ bucket ] / 1000000.0, cumulative );
+    }
+    out.printf("watch_loop_duration_seconds_bucket{le=\"+Inf\"} %u\n", loop_count );
+    out.printf("watch_loop_duration_seconds_sum %.6f\n", loop_sum / 1000000.0 );
+    out.printf("watch_loop_duration_seconds_count %u\n", loop_count );
+
+    /*
+     * wifi and ble
+     */
+    metrics_write_header( out, "watch_wifi_rssi_dbm", "gauge", "WiFi signal strength" );
+    out.printf("watch_wifi_rssi_dbm %d\n", WiFi.isConnected() ? WiFi.RSSI() : 0 );
+    metrics_write_header( out, "watch_wifi_connects_total", "counter", "WiFi connections since boot" );
+    out.printf("watch_wifi_connects_total %u\n", wifi_connects );
+    metrics_write_header( out, "watch_wifi_disconnects_total", "counter", "WiFi disconnects since boot" );
+    out.printf("watch_wifi_disconnects_total %u\n", wifi_disconnects );
+
+    metrics_write_header( out, "watch_ble_connected", "gauge", "1 if a phone is connected" );
+    out.printf("watch_ble_connected %d\n", blectl_get_event( BLECTL_CONNECT ) ? 1 : 0 );
+    metrics_write_header( out, "watch_ble_connects_total", "counter", "BLE connections since boot" );
+    out.printf("watch_ble_connects_total %u\n", ble_connects );
+    metrics_write_header( out, "watch_ble_rx_bytes_total", "counter", "Bytes received over the BLE uart" );
+    out.printf("watch_ble_rx_bytes_total %u\n", blectl_get_rx_bytes() );
+    metrics_write_header( out, "watch_ble_rx_writes_total", "counter", "Writes on the BLE uart" );
+    out.printf("watch_ble_rx_writes_total %u\n", blectl_get_rx_writes() );
+    metrics_write_header( out, "watch_ble_rx_messages_total", "counter", "Messages received over the BLE uart" );
+    out.printf("watch_ble_rx_messages_total %u\n", blectl_get_rx_msgs() );
+    metrics_write_header( out, "watch_ble_mtu_bytes", "gauge", "Negotiated ATT MTU" );
+    out.printf("watch_ble_mtu_bytes %u\n", blectl_get_mtu() );
+
+    /*
+     * notifications
+     */
+    metrics_write_header( out, "watch_notifications_total", "counter", "Notifications since boot by the action of the rules" );
+    out.printf("watch_notifications_total{action=\"wake\"} %u\n", notifyctl_get_count( NOTIFYRULES_WAKE ) );
+    out.printf("watch_notifications_total{action=\"vibe\"} %u\n", notifyctl_get_count( NOTIFYRULES_VIBE ) );
+    out.printf("watch_notifications_total{action=\"silent\"} %u\n", notifyctl_get_count( NOTIFYRULES_SILENT ) );
+    metrics_write_header( out, "watch_notification_alerts_total", "counter", "Alerts since boot, one per burst of notifications" );
+    out.printf("watch_notification_alerts_total %u\n", notifyctl_get_alerts() );
+    metrics_write_header( out, "watch_notifications_coalesced_total", "counter", "Notifications merged into an other one of their burst" );
+    out.printf("watch_notifications_coalesced_total %u\n", notifyctl_get_coalesced() );
+    metrics_write_header( out, "watch_notification_wakeups_avoided_total", "counter", "Notifications in standby that did not wake the watch" );
+    out.printf("watch_notification_wakeups_avoided_total %u\n", notifyctl_get_avoided_wakeups() );
+    metrics_write_header( out, "watch_notification_wakeups_avoided_today", "gauge", "Notifications in standby that did not wake the watch today" );
+    out.printf("watch_notification_wakeups_avoided_today %u\n", notifyctl_get_avoided_wakeups_today() );
+
+    /*
+     * pmu
+     */
+    metrics_write_header( out, "watch_battery_voltage_volts", "gauge", "Battery voltage" );
+    out.printf("watch_battery_voltage_volts %.3f\n", metrics_battery_voltage );
+    metrics_write_header( out, "watch_battery_charge_current_amperes", "gauge", "Battery charge current" );
+    out.printf("watch_battery_charge_current_amperes %.3f\n", metrics_battery_charge_current );
+    metrics_write_header( out, "watch_battery_discharge_current_amperes", "gauge", "Battery discharge current" );
+    out.printf("watch_battery_discharge_current_amperes %.3f\n", metrics_battery_discharge_current );
+    metrics_write_header( out, "watch_vbus_voltage_volts", "gauge", "USB voltage" );
+    out.printf("watch_vbus_voltage_volts %.3f\n", metrics_vbus_voltage );
+}
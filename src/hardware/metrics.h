@@ -0,0 +1,47 @@
+/****************************************************************************
+ *   Sep 07 18:44:02 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _METRICS_H
+    #define _METRICS_H
+
+    #include <Print.h>
+
+    #define METRICS_SAMPLE_INTERVAL     5000        /** @brief lv_mem and pmu are sampled in the main loop every 5s */
+    #define METRICS_LOOP_BUCKETS        10          /** @brief number of main loop histogram buckets without +Inf */
+
+    /*
+     * @brief setup metrics, call after wifictl and blectl are set up
+     */
+    void metrics_setup( void );
+    /*
+     * @brief count one main loop iteration and sample values that are only safe to read from the main loop
+     *
+     * @param   duration    duration of the iteration in us
+     */
+    void metrics_loop( uint32_t duration );
+    /*
+     * @brief write all metrics in prometheus text format
+     *
+     * @param   out         destination like an AsyncResponseStream
+     */
+    void metrics_write( Print &out );
+
+#endif // _METRICS_H
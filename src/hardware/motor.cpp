@@ -22,6 +22,7 @@
 #include "config.h"
 #include <TTGO.h>
 #include "json_psram_allocator.h"
+#include "configapi.h"
 
 #include "motor.h"
 #include "powermgm.h"
@@ -49,10 +50,18 @@ void IRAM_ATTR onTimer() {
     portEXIT_CRITICAL_ISR(&timerMux);
 }
 
+/*
+ * settings for /api/config
+ */
+static const configapi_field_t motor_configapi_fields[] = {
+    CONFIGAPI_BOOL_FIELD( "vibe", []() -> bool { return( motor_get_vibe_config() ); }, []( bool value ) { motor_set_vibe_config( value ); } ),
+};
+
 /*
  *
  */
 void motor_setup( void ) {
+    configapi_register( "motor", motor_configapi_fields, sizeof( motor_configapi_fields ) / sizeof( configapi_field_t ), motor_save_config );
     if ( motor_init == true )
         return;
 
@@ -95,6 +104,9 @@ void motor_set_vibe_config( bool enable ) {
  *
  */
 void motor_save_config( void ) {
+    if ( configapi_defer_save( motor_save_config ) ) {
+        return;
+    }
     if ( SPIFFS.exists( MOTOR_CONFIG_FILE ) ) {
         SPIFFS.remove( MOTOR_CONFIG_FILE );
         log_i("remove old binary motor config");
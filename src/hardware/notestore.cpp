@@ -0,0 +1,394 @@
+/****************************************************************************
+ *   Sep 14 11:05:37 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include "notestore.h"
+
+#define NOTESTORE_MAGIC     0x45544f4e      /** @brief file record magic, "NOTE" */
+
+/*
+ * on flash the app is stored by name, the app index is only valid in ram
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t id;
+    uint32_t timestamp;
+    char app[ NOTESTORE_APP_SIZE ];
+    char title[ NOTESTORE_TITLE_SIZE ];
+    char body[ NOTESTORE_BODY_SIZE ];
+    uint8_t flags;
+    uint8_t reserved;
+} notestore_file_record_t;
+
+/*
+ * a mutex and not a spinlock, the insert scans and shifts the time index
+ */
+static SemaphoreHandle_t notestore_mutex = NULL;
+
+static notestore_record_t *notestore_records = NULL;
+static uint16_t *notestore_by_time = NULL;          /** @brief slots sorted by timestamp and id */
+static uint32_t notestore_records_count = 0;
+static uint32_t notestore_next_id = 1;
+static uint32_t notestore_serial = 0;
+static uint32_t notestore_file_records = 0;         /** @brief records in the file, some of them are overwritten in the ring */
+static uint32_t notestore_file_next_id = 1;         /** @brief first id that is not in the file yet */
+static uint32_t notestore_clear_id = 0;             /** @brief ids below were cleared, the file is removed from notestore_loop() */
+static char notestore_app_name[ NOTESTORE_APPS ][ NOTESTORE_APP_SIZE ];
+static uint32_t notestore_app_records[ NOTESTORE_APPS ];
+static uint32_t notestore_app_last[ NOTESTORE_APPS ];  /** @brief id of the newest notification of an app */
+
+static void notestore_insert( uint32_t id, uint8_t app, const char *title, const char *body, uint32_t timestamp, uint8_t flags );
+static uint8_t notestore_intern_app( const char *src );
+static bool notestore_before( const notestore_record_t *a, const notestore_record_t *b );
+static void notestore_load( void );
+static bool notestore_get_file_record( uint32_t id, notestore_file_record_t *file_record );
+static void notestore_append( uint32_t next_id );
+static void notestore_compact( uint32_t next_id );
+static void notestore_to_file_record( const notestore_record_t *record, notestore_file_record_t *file_record );
+
+void notestore_setup( void ) {
+    notestore_records = (notestore_record_t *)ps_calloc( NOTESTORE_SIZE, sizeof( notestore_record_t ) );
+    notestore_by_time = (uint16_t *)ps_calloc( NOTESTORE_SIZE, sizeof( uint16_t ) );
+    notestore_mutex = xSemaphoreCreateMutex();
+    if ( notestore_records == NULL || notestore_by_time == NULL || notestore_mutex == NULL ) {
+        log_e("notestore malloc faild");
+        while(true);
+    }
+    notestore_load();
+    notestore_file_next_id = notestore_next_id;
+}
+
+/*
+ * the file is only touched from here, notestore_add() and notestore_clear() are called
+ * from the ble task and the gui and only change the ring
+ */
+void notestore_loop( void ) {
+    xSemaphoreTake( notestore_mutex, portMAX_DELAY );
+    uint32_t next_id = notestore_next_id;
+    uint32_t clear_id = notestore_clear_id;
+    notestore_clear_id = 0;
+    xSemaphoreGive( notestore_mutex );
+
+    if ( clear_id ) {
+        SPIFFS.remove( NOTESTORE_FILE );
+        notestore_file_records = 0;
+        if ( notestore_file_next_id < clear_id ) {
+            notestore_file_next_id = clear_id;
+        }
+    }
+    if ( notestore_file_next_id == next_id ) {
+        return;
+    }
+    /*
+     * rewrite the file when it is full or when the ring went around before the records were written
+     */
+    if ( notestore_file_records >= NOTESTORE_SIZE * 2 || next_id - notestore_file_next_id > NOTESTORE_SIZE ) {
+        notestore_compact( next_id );
+    }
+    else {
+        notestore_append( next_id );
+    }
+}
+
+uint32_t notestore_add( const char *src, const char *title, const char *body, time_t timestamp ) {
+    xSemaphoreTake( notestore_mutex, portMAX_DELAY );
+    uint32_t id = notestore_next_id++;
+    uint8_t app = notestore_intern_app( src );
+    notestore_insert( id, app, title, body, timestamp, 0 );
+    xSemaphoreGive( notestore_mutex );
+    return( id );
+}
+
+void notestore_clear( void ) {
+    xSemaphoreTake( notestore_mutex, portMAX_DELAY );
+    memset( notestore_records, 0, NOTESTORE_SIZE * sizeof( notestore_record_t ) );
+    memset( notestore_app_name, 0, sizeof( notestore_app_name ) );
+    memset( notestore_app_records, 0, sizeof( notestore_app_records ) );
+    memset( notestore_app_last, 0, sizeof( notestore_app_last ) );
+    notestore_records_count = 0;
+    notestore_clear_id = notestore_next_id;
+    notestore_serial++;
+    xSemaphoreGive( notestore_mutex );
+}
+
+uint32_t notestore_count( void ) {
+    return( notestore_records_count );
+}
+
+uint32_t notestore_get_serial( void ) {
+    return( notestore_serial );
+}
+
+bool notestore_get( uint32_t n, notestore_record_t *record ) {
+    bool retval = false;
+
+    xSemaphoreTake( notestore_mutex, portMAX_DELAY );
+    if ( n < notestore_records_count ) {
+        *record = notestore_records[ ( notestore_next_id - 1 - n ) % NOTESTORE_SIZE ];
+        retval = true;
+    }
+    xSemaphoreGive( notestore_mutex );
+    return( retval );
+}
+
+int notestore_find_app( const char *src ) {
+    for ( int app = 1 ; app < NOTESTORE_APPS ; app++ ) {
+        if ( notestore_app_name[ app ][ 0 ] && !strncmp( notestore_app_name[ app ], src, NOTESTORE_APP_SIZE - 1 ) ) {
+            return( app );
+        }
+    }
+    return( -1 );
+}
+
+const char *notestore_get_app_name( uint8_t app ) {
+    return( app < NOTESTORE_APPS ? notestore_app_name[ app ] : "" );
+}
+
+uint32_t notestore_app_count( uint8_t app ) {
+    return( app < NOTESTORE_APPS ? notestore_app_records[ app ] : 0 );
+}
+
+bool notestore_get_app( uint8_t app, uint32_t n, notestore_record_t *record ) {
+    bool retval = false;
+
+    if ( app >= NOTESTORE_APPS ) {
+        return( false );
+    }
+    /*
+     * follow the chain of the app, a link to an overwritten slot ends it
+     */
+    xSemaphoreTake( notestore_mutex, portMAX_DELAY );
+    uint32_t id = notestore_app_last[ app ];
+    while ( id && notestore_records[ id % NOTESTORE_SIZE ].id == id ) {
+        if ( n-- == 0 ) {
+            *record = notestore_records[ id % NOTESTORE_SIZE ];
+            retval = true;
+            break;
+        }
+        id = notestore_records[ id % NOTESTORE_SIZE ].prev_app_id;
+    }
+    xSemaphoreGive( notestore_mutex );
+    return( retval );
+}
+
+uint32_t notestore_count_since( time_t timestamp ) {
+    xSemaphoreTake( notestore_mutex, portMAX_DELAY );
+    uint32_t low = 0, high = notestore_records_count;
+    while ( low < high ) {
+        uint32_t mid = ( low + high ) / 2;
+        if ( notestore_records[ notestore_by_time[ mid ] ].timestamp < (uint32_t)timestamp ) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    uint32_t retval = notestore_records_count - low;
+    xSemaphoreGive( notestore_mutex );
+    return( retval );
+}
+
+/*
+ * put a record into its slot, drop the one it overwrites from the counters and the time index
+ */
+static void notestore_insert( uint32_t id, uint8_t app, const char *title, const char *body, uint32_t timestamp, uint8_t flags ) {
+    uint16_t slot = id % NOTESTORE_SIZE;
+    notestore_record_t *record = &notestore_records[ slot ];
+
+    if ( record->id ) {
+        notestore_app_records[ record->app ]--;
+        for ( uint32_t i = 0 ; i < notestore_records_count ; i++ ) {
+            if ( notestore_by_time[ i ] == slot ) {
+                memmove( &notestore_by_time[ i ], &notestore_by_time[ i + 1 ], ( notestore_records_count - i - 1 ) * sizeof( uint16_t ) );
+                break;
+            }
+        }
+        notestore_records_count--;
+    }
+
+    memset( record, 0, sizeof( notestore_record_t ) );
+    record->id = id;
+    record->timestamp = timestamp;
+    record->app = app;
+    record->flags = flags;
+    record->prev_app_id = notestore_app_last[ app ];
+    strncpy( record->title, title ? title : "", NOTESTORE_TITLE_SIZE - 1 );
+    strncpy( record->body, body ? body : "", NOTESTORE_BODY_SIZE - 1 );
+    notestore_app_last[ app ] = id;
+    notestore_app_records[ app ]++;
+
+    /*
+     * notifications come in time order, the new one goes to the end unless the clock was set back
+     */
+    uint32_t pos = notestore_records_count;
+    while ( pos > 0 && notestore_before( record, &notestore_records[ notestore_by_time[ pos - 1 ] ] ) ) {
+        pos--;
+    }
+    memmove( &notestore_by_time[ pos + 1 ], &notestore_by_time[ pos ], ( notestore_records_count - pos ) * sizeof( uint16_t ) );
+    notestore_by_time[ pos ] = slot;
+    notestore_records_count++;
+    notestore_serial++;
+}
+
+/*
+ * an unknown app takes a free name or the name of an app without notifications in the ring
+ */
+static uint8_t notestore_intern_app( const char *src ) {
+    int app = -1;
+
+    if ( src == NULL || *src == '\0' ) {
+        return( 0 );
+    }
+    app = notestore_find_app( src );
+    if ( app > 0 ) {
+        return( app );
+    }
+    for ( app = 1 ; app < NOTESTORE_APPS ; app++ ) {
+        if ( notestore_app_records[ app ] == 0 ) {
+            strncpy( notestore_app_name[ app ], src, NOTESTORE_APP_SIZE - 1 );
+            notestore_app_name[ app ][ NOTESTORE_APP_SIZE - 1 ] = '\0';
+            notestore_app_last[ app ] = 0;
+            return( app );
+        }
+    }
+    return( 0 );
+}
+
+static bool notestore_before( const notestore_record_t *a, const notestore_record_t *b ) {
+    return( a->timestamp < b->timestamp || ( a->timestamp == b->timestamp && a->id < b->id ) );
+}
+
+/*
+ * replay the file into the ring, a torn record at the end from a reset while writing is dropped
+ */
+static void notestore_load( void ) {
+    notestore_file_record_t file_record;
+    bool torn = false;
+
+    if ( !SPIFFS.exists( NOTESTORE_FILE ) ) {
+        return;
+    }
+    fs::File file = SPIFFS.open( NOTESTORE_FILE, FILE_READ );
+    if ( !file ) {
+        log_e("Can't open file: %s!", NOTESTORE_FILE );
+        return;
+    }
+    while ( file.available() ) {
+        if ( file.read( (uint8_t *)&file_record, sizeof( file_record ) ) != sizeof( file_record ) || file_record.magic != NOTESTORE_MAGIC || file_record.id < notestore_next_id ) {
+            torn = true;
+            break;
+        }
+        file_record.app[ NOTESTORE_APP_SIZE - 1 ] = '\0';
+        file_record.title[ NOTESTORE_TITLE_SIZE - 1 ] = '\0';
+        file_record.body[ NOTESTORE_BODY_SIZE - 1 ] = '\0';
+        notestore_insert( file_record.id, notestore_intern_app( file_record.app ), file_record.title, file_record.body, file_record.timestamp, file_record.flags );
+        notestore_next_id = file_record.id + 1;
+        notestore_file_records++;
+    }
+    file.close();
+    log_i("notestore: %d notifications loaded", notestore_records_count );
+
+    if ( torn || notestore_file_records > notestore_records_count ) {
+        notestore_compact( notestore_next_id );
+    }
+}
+
+/*
+ * the app name is copied under the lock too, its index may be taken by another app after a clear
+ */
+static bool notestore_get_file_record( uint32_t id, notestore_file_record_t *file_record ) {
+    bool retval = false;
+
+    xSemaphoreTake( notestore_mutex, portMAX_DELAY );
+    if ( notestore_records[ id % NOTESTORE_SIZE ].id == id ) {
+        notestore_to_file_record( &notestore_records[ id % NOTESTORE_SIZE ], file_record );
+        retval = true;
+    }
+    xSemaphoreGive( notestore_mutex );
+    return( retval );
+}
+
+/*
+ * append the records up to next_id, a record that is cleared or overwritten meanwhile is left out
+ */
+static void notestore_append( uint32_t next_id ) {
+    notestore_file_record_t file_record;
+
+    fs::File file = SPIFFS.open( NOTESTORE_FILE, FILE_APPEND );
+    if ( !file ) {
+        log_e("Can't open file: %s!", NOTESTORE_FILE );
+        return;
+    }
+    for ( uint32_t id = notestore_file_next_id ; id < next_id ; id++ ) {
+        if ( !notestore_get_file_record( id, &file_record ) ) {
+            continue;
+        }
+        if ( file.write( (uint8_t *)&file_record, sizeof( file_record ) ) != sizeof( file_record ) ) {
+            log_e("notestore: append failed");
+            break;
+        }
+        notestore_file_records++;
+    }
+    file.close();
+    notestore_file_next_id = next_id;
+}
+
+/*
+ * write the ring up to next_id oldest first into a new file and replace the old one with it
+ */
+static void notestore_compact( uint32_t next_id ) {
+    notestore_file_record_t file_record;
+    uint32_t written = 0;
+
+    fs::File file = SPIFFS.open( NOTESTORE_TMP_FILE, FILE_WRITE );
+    if ( !file ) {
+        log_e("Can't open file: %s!", NOTESTORE_TMP_FILE );
+        return;
+    }
+    for ( uint32_t id = next_id > NOTESTORE_SIZE ? next_id - NOTESTORE_SIZE : 1 ; id < next_id ; id++ ) {
+        if ( !notestore_get_file_record( id, &file_record ) ) {
+            continue;
+        }
+        if ( file.write( (uint8_t *)&file_record, sizeof( file_record ) ) != sizeof( file_record ) ) {
+            log_e("notestore: compact failed");
+            file.close();
+            SPIFFS.remove( NOTESTORE_TMP_FILE );
+            return;
+        }
+        written++;
+    }
+    file.close();
+    SPIFFS.remove( NOTESTORE_FILE );
+    SPIFFS.rename( NOTESTORE_TMP_FILE, NOTESTORE_FILE );
+    notestore_file_records = written;
+    notestore_file_next_id = next_id;
+}
+
+static void notestore_to_file_record( const notestore_record_t *record, notestore_file_record_t *file_record ) {
+    memset( file_record, 0, sizeof( notestore_file_record_t ) );
+    file_record->magic = NOTESTORE_MAGIC;
+    file_record->id = record->id;
+    file_record->timestamp = record->timestamp;
+    file_record->flags = record->flags;
+    strncpy( file_record->app, notestore_get_app_name( record->app ), NOTESTORE_APP_SIZE - 1 );
+    memcpy( file_record->title, record->title, NOTESTORE_TITLE_SIZE );
+    memcpy( file_record->body, record->body, NOTESTORE_BODY_SIZE );
+}
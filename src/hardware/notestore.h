@@ -0,0 +1,134 @@
+/****************************************************************************
+ *   Sep 14 11:05:37 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NOTESTORE_H
+    #define _NOTESTORE_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <time.h>
+
+    /*
+     * notification history. the last NOTESTORE_SIZE notifications are kept as fixed
+     * size records in a ring in psram, each one is also appended to NOTESTORE_FILE.
+     * the file is rewritten from the ring when it holds twice as many records, so
+     * ram and flash stay the same however many notifications come in. only the ring
+     * is changed by the callers, the file is written from notestore_loop()
+     */
+    #define NOTESTORE_FILE              "/notestore.log"
+    #define NOTESTORE_TMP_FILE          "/notestore.tmp"
+    #define NOTESTORE_SIZE              256         /** @brief records in the ring */
+    #define NOTESTORE_APPS              32          /** @brief source apps, 0 is used for unknown or too many */
+    #define NOTESTORE_APP_SIZE          24
+    #define NOTESTORE_TITLE_SIZE        38
+    #define NOTESTORE_BODY_SIZE         76
+
+    /*
+     * @brief one notification, 128 bytes
+     */
+    typedef struct {
+        uint32_t id;                                /** @brief 1, 2, 3 ... 0 is an empty slot */
+        uint32_t timestamp;                         /** @brief time of arrival */
+        uint32_t prev_app_id;                       /** @brief previous notification of the same app or 0 */
+        uint8_t app;                                /** @brief index of the source app */
+        uint8_t flags;
+        char title[ NOTESTORE_TITLE_SIZE ];
+        char body[ NOTESTORE_BODY_SIZE ];
+    } notestore_record_t;
+
+    /*
+     * @brief allocate the ring and load the history from NOTESTORE_FILE
+     */
+    void notestore_setup( void );
+    /*
+     * @brief append new notifications to the file or rewrite it, called from powermgm_loop()
+     */
+    void notestore_loop( void );
+    /*
+     * @brief add a notification, the oldest is dropped when the ring is full
+     *
+     * @param   src         source app like "Telegram" or NULL
+     * @param   title       title or sender, may be NULL
+     * @param   body        message text, may be NULL
+     * @param   timestamp   time of arrival
+     *
+     * @return  id of the new notification
+     */
+    uint32_t notestore_add( const char *src, const char *title, const char *body, time_t timestamp );
+    /*
+     * @brief drop all notifications and the file
+     */
+    void notestore_clear( void );
+    /*
+     * @brief number of stored notifications
+     */
+    uint32_t notestore_count( void );
+    /*
+     * @brief changes with every add or clear, to see if a view is outdated
+     */
+    uint32_t notestore_get_serial( void );
+    /*
+     * @brief get a notification, 0 is the newest
+     *
+     * @param   n           position from the newest
+     * @param   record      copy of the notification
+     *
+     * @return  false if n >= notestore_count()
+     */
+    bool notestore_get( uint32_t n, notestore_record_t *record );
+    /*
+     * @brief find the index of a source app
+     *
+     * @param   src         source app like "Telegram"
+     *
+     * @return  index or -1 if no notification of it was stored
+     */
+    int notestore_find_app( const char *src );
+    /*
+     * @brief get the name of a source app
+     *
+     * @param   app         index of the app
+     *
+     * @return  name, "" for unknown
+     */
+    const char *notestore_get_app_name( uint8_t app );
+    /*
+     * @brief number of stored notifications of one app
+     */
+    uint32_t notestore_app_count( uint8_t app );
+    /*
+     * @brief get a notification of one app, 0 is the newest
+     *
+     * @param   app         index of the app
+     * @param   n           position from the newest of this app
+     * @param   record      copy of the notification
+     *
+     * @return  false if n >= notestore_app_count( app )
+     */
+    bool notestore_get_app( uint8_t app, uint32_t n, notestore_record_t *record );
+    /*
+     * @brief number of notifications that arrived at or after a time
+     *
+     * @param   timestamp   time like the last midnight
+     */
+    uint32_t notestore_count_since( time_t timestamp );
+
+#endif // _NOTESTORE_H
@@ -0,0 +1,153 @@
+/****************************************************************************
+ *   Sep 15 08:14:26 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "notifyburst.h"
+#include "notifyrules.h"
+
+static void notifyburst_copy( char *dest, const char *src, size_t size );
+
+void notifyburst_init( notifyburst_t *burst, uint32_t window ) {
+    memset( burst, 0, sizeof( notifyburst_t ) );
+    burst->window = window;
+}
+
+void notifyburst_add( notifyburst_t *burst, uint32_t id, const char *src, const char *title, const char *body, uint8_t action, uint32_t now ) {
+    uint32_t conversation = notifyrules_hash( src ) * 31 + notifyrules_hash( title );
+    notifyburst_entry_t *entry = NULL;
+    int found = -1;
+
+    burst->received++;
+    burst->last = now;
+    if ( !burst->open ) {
+        burst->open = true;
+        burst->since = now;
+        burst->action = action;
+        burst->total = 0;
+        burst->others = 0;
+        burst->entries = 0;
+    }
+    if ( action < burst->action ) {
+        burst->action = action;
+    }
+
+    /*
+     * the same id is an update of a notification, it is not counted again
+     */
+    for ( int i = 0 ; i < burst->entries && found < 0 ; i++ ) {
+        if ( id && burst->entry[ i ].id == id ) {
+            found = i;
+            burst->merged++;
+        }
+    }
+    for ( int i = 0 ; i < burst->entries && found < 0 ; i++ ) {
+        if ( burst->entry[ i ].conversation == conversation ) {
+            found = i;
+            burst->entry[ i ].count++;
+            burst->total++;
+            burst->merged++;
+        }
+    }
+    if ( found >= 0 ) {
+        // the updated conversation moves to the end, it is the latest
+        notifyburst_entry_t tmp = burst->entry[ found ];
+        memmove( &burst->entry[ found ], &burst->entry[ found + 1 ], ( burst->entries - found - 1 ) * sizeof( notifyburst_entry_t ) );
+        burst->entry[ burst->entries - 1 ] = tmp;
+        entry = &burst->entry[ burst->entries - 1 ];
+    }
+    else if ( burst->entries < NOTIFYBURST_ENTRIES ) {
+        entry = &burst->entry[ burst->entries++ ];
+        memset( entry, 0, sizeof( notifyburst_entry_t ) );
+        entry->conversation = conversation;
+        entry->count = 1;
+        notifyburst_copy( entry->src, src, sizeof( entry->src ) );
+        notifyburst_copy( entry->title, title, sizeof( entry->title ) );
+        burst->total++;
+    }
+    else {
+        burst->others++;
+        burst->total++;
+        burst->merged++;
+        return;
+    }
+    entry->id = id;
+    notifyburst_copy( entry->body, body, sizeof( entry->body ) );
+}
+
+bool notifyburst_due( notifyburst_t *burst, uint32_t now ) {
+    return( burst->open && ( now - burst->last >= burst->window || now - burst->since >= burst->window * NOTIFYBURST_MAX_WINDOWS ) );
+}
+
+void notifyburst_take( notifyburst_t *burst, notifyburst_summary_t *summary ) {
+    notifyburst_entry_t *latest = &burst->entry[ burst->entries - 1 ];
+
+    memset( summary, 0, sizeof( notifyburst_summary_t ) );
+    summary->action = burst->action;
+    summary->total = burst->total;
+    summary->conversations = burst->entries + ( burst->others ? 1 : 0 );
+
+    // the app is shown if all are from the same one
+    notifyburst_copy( summary->src, latest->src, sizeof( summary->src ) );
+    for ( int i = 0 ; i < burst->entries ; i++ ) {
+        if ( strcmp( burst->entry[ i ].src, latest->src ) ) {
+            summary->src[ 0 ] = '\0';
+        }
+    }
+
+    if ( burst->entries == 1 && burst->others == 0 ) {
+        if ( latest->count > 1 ) {
+            snprintf( summary->title, sizeof( summary->title ), "%s (%d)", latest->title, latest->count );
+        }
+        else {
+            notifyburst_copy( summary->title, latest->title, sizeof( summary->title ) );
+        }
+        notifyburst_copy( summary->body, latest->body, sizeof( summary->body ) );
+    }
+    else {
+        size_t len = 0;
+
+        snprintf( summary->title, sizeof( summary->title ), "%d messages in %d chats", summary->total, summary->conversations );
+        // latest first, one line each
+        for ( int i = burst->entries - 1 ; i >= 0 && len < sizeof( summary->body ) - 1 ; i-- ) {
+            notifyburst_entry_t *entry = &burst->entry[ i ];
+            const char *name = *entry->title ? entry->title : entry->src;
+
+            if ( entry->count > 1 ) {
+                len += snprintf( &summary->body[ len ], sizeof( summary->body ) - len, "%s (%d): %s\n", name, entry->count, entry->body );
+            }
+            else {
+                len += snprintf( &summary->body[ len ], sizeof( summary->body ) - len, "%s: %s\n", name, entry->body );
+            }
+        }
+        if ( burst->others && len < sizeof( summary->body ) - 1 ) {
+            snprintf( &summary->body[ len ], sizeof( summary->body ) - len, "and %d more\n", burst->others );
+        }
+    }
+    burst->open = false;
+    burst->alerts++;
+}
+
+static void notifyburst_copy( char *dest, const char *src, size_t size ) {
+    strncpy( dest, src ? src : "", size - 1 );
+    dest[ size - 1 ] = '\0';
+}
@@ -0,0 +1,112 @@
+/****************************************************************************
+ *   Sep 15 08:14:26 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NOTIFYBURST_H
+    #define _NOTIFYBURST_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    /*
+     * collect the notifications of a burst, like a busy group chat, and alert once.
+     * a burst ends after window ms without a new notification, but not later than
+     * NOTIFYBURST_MAX_WINDOWS windows after its first one. a notification with the
+     * id of one in the burst replaces it, one from the same app and title is merged
+     * into it
+     */
+    #define NOTIFYBURST_ENTRIES         6           /** @brief conversations in one burst, more are only counted */
+    #define NOTIFYBURST_SRC_SIZE        24
+    #define NOTIFYBURST_TITLE_SIZE      38
+    #define NOTIFYBURST_BODY_SIZE       76
+    #define NOTIFYBURST_SUMMARY_SIZE    512
+    #define NOTIFYBURST_MAX_WINDOWS     2           /** @brief a long burst is alerted in parts */
+
+    typedef struct {
+        uint32_t id;                                /** @brief gadgetbridge id of the latest notification, 0 if none */
+        uint32_t conversation;                      /** @brief hash of src and title */
+        uint16_t count;                             /** @brief merged notifications */
+        char src[ NOTIFYBURST_SRC_SIZE ];
+        char title[ NOTIFYBURST_TITLE_SIZE ];
+        char body[ NOTIFYBURST_BODY_SIZE ];         /** @brief body of the latest notification */
+    } notifyburst_entry_t;
+
+    typedef struct {
+        uint32_t window;                            /** @brief ms to collect, 0 alerts every notification at once */
+        bool open;
+        uint32_t since;                             /** @brief arrival of the first notification */
+        uint32_t last;                              /** @brief arrival of the latest notification */
+        uint8_t action;                             /** @brief loudest action in the burst */
+        uint16_t total;                             /** @brief notifications in the burst */
+        uint16_t others;                            /** @brief notifications that found no free entry */
+        uint8_t entries;
+        notifyburst_entry_t entry[ NOTIFYBURST_ENTRIES ];   /** @brief the latest conversation is the last */
+        uint32_t received;                          /** @brief stats since init */
+        uint32_t merged;
+        uint32_t alerts;
+    } notifyburst_t;
+
+    /*
+     * @brief one alert for a whole burst
+     */
+    typedef struct {
+        uint8_t action;
+        uint16_t total;                             /** @brief notifications */
+        uint16_t conversations;
+        char src[ NOTIFYBURST_SRC_SIZE ];           /** @brief app of all of them or "" if mixed */
+        char title[ NOTIFYBURST_TITLE_SIZE + 8 ];   /** @brief title with the count or "5 messages in 3 chats" */
+        char body[ NOTIFYBURST_SUMMARY_SIZE ];      /** @brief latest body or one line per conversation */
+    } notifyburst_summary_t;
+
+    /*
+     * @brief clear the burst and the stats
+     *
+     * @param   burst       pointer to the burst
+     * @param   window      ms to collect
+     */
+    void notifyburst_init( notifyburst_t *burst, uint32_t window );
+    /*
+     * @brief add a notification
+     *
+     * @param   burst       pointer to the burst
+     * @param   id          gadgetbridge id or 0
+     * @param   src         source app or NULL
+     * @param   title       title or sender or NULL
+     * @param   body        message or NULL
+     * @param   action      NOTIFYRULES_WAKE or NOTIFYRULES_VIBE, lower is louder
+     * @param   now         time in ms
+     */
+    void notifyburst_add( notifyburst_t *burst, uint32_t id, const char *src, const char *title, const char *body, uint8_t action, uint32_t now );
+    /*
+     * @brief check if the window of a burst is over
+     *
+     * @param   burst       pointer to the burst
+     * @param   now         time in ms
+     */
+    bool notifyburst_due( notifyburst_t *burst, uint32_t now );
+    /*
+     * @brief build the alert and close the burst
+     *
+     * @param   burst       pointer to the burst
+     * @param   summary     the alert
+     */
+    void notifyburst_take( notifyburst_t *burst, notifyburst_summary_t *summary );
+
+#endif // _NOTIFYBURST_H
@@ -0,0 +1,313 @@
+/****************************************************************************
+ *   Sep 14 19:32:11 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include "json_psram_allocator.h"
+#include "configapi.h"
+
+#include "notifyctl.h"
+#include "powermgm.h"
+
+static notifyctl_config_t notifyctl_config;
+static notifyrules_t notifyctl_rules;
+static notifyburst_t notifyctl_burst;
+static NOTIFYCTL_CALLBACK_FUNC notifyctl_cb[ NOTIFYCTL_MAX_CB ];
+static uint32_t notifyctl_cb_entrys = 0;
+static portMUX_TYPE notifyctlMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t notifyctl_count[ NOTIFYRULES_SILENT + 1 ] = { 0, 0, 0 };
+static uint32_t notifyctl_avoided = 0;
+static uint32_t notifyctl_avoided_today = 0;
+static uint32_t notifyctl_today_count = 0;
+static int notifyctl_today = -1;                    /** @brief day of the year of the today counters */
+
+static const char *notifyctl_action_name[] = { "wake", "vibe", "silent" };
+
+static void notifyctl_compile( void );
+static uint8_t notifyctl_parse_action( const char *action, uint8_t fallback );
+static uint16_t notifyctl_parse_time( const char *time, uint16_t fallback );
+
+/*
+ * settings for /api/config, the rules are only in the file
+ */
+static const configapi_field_t notifyctl_configapi_fields[] = {
+    CONFIGAPI_INT_FIELD( "burst_window", 0, NOTIFYCTL_MAX_BURST_WINDOW, 0, []() -> int32_t { return( notifyctl_get_burst_window() ); }, []( int32_t value ) { notifyctl_set_burst_window( value ); } ),
+    CONFIGAPI_BOOL_FIELD( "dnd", []() -> bool { return( notifyctl_get_dnd() ); }, []( bool value ) { notifyctl_set_dnd( value ); } ),
+    CONFIGAPI_INT_FIELD( "dnd_from", 0, NOTIFYRULES_DAY - 1, 0, []() -> int32_t { return( notifyctl_config.dnd_window.from ); }, []( int32_t value ) { notifyctl_config.dnd_window.from = value; notifyctl_compile(); notifyctl_save_config(); } ),
+    CONFIGAPI_INT_FIELD( "dnd_to", 0, NOTIFYRULES_DAY - 1, 0, []() -> int32_t { return( notifyctl_config.dnd_window.to ); }, []( int32_t value ) { notifyctl_config.dnd_window.to = value; notifyctl_compile(); notifyctl_save_config(); } ),
+    CONFIGAPI_INT_FIELD( "dnd_action", NOTIFYRULES_VIBE, NOTIFYRULES_SILENT, 0, []() -> int32_t { return( notifyctl_config.dnd_window.action ); }, []( int32_t value ) { notifyctl_config.dnd_window.action = value; notifyctl_compile(); notifyctl_save_config(); } ),
+};
+
+void notifyctl_setup( void ) {
+    configapi_register( "notify", notifyctl_configapi_fields, sizeof( notifyctl_configapi_fields ) / sizeof( configapi_field_t ), notifyctl_save_config );
+    notifyctl_read_config();
+    notifyctl_compile();
+    notifyburst_init( &notifyctl_burst, notifyctl_config.burst_window );
+}
+
+void notifyctl_loop( void ) {
+    notifyburst_summary_t summary;
+
+    portENTER_CRITICAL(&notifyctlMux);
+    if ( !notifyburst_due( &notifyctl_burst, millis() ) ) {
+        portEXIT_CRITICAL(&notifyctlMux);
+        return;
+    }
+    notifyburst_take( &notifyctl_burst, &summary );
+    portEXIT_CRITICAL(&notifyctlMux);
+
+    log_i("notifyctl: alert %s, %d notifications in %d conversations", notifyctl_action_name[ summary.action ], summary.total, summary.conversations );
+    for ( int entry = 0 ; entry < notifyctl_cb_entrys ; entry++ ) {
+        notifyctl_cb[ entry ]( &summary );
+    }
+}
+
+void notifyctl_register_cb( NOTIFYCTL_CALLBACK_FUNC alert_cb ) {
+    if ( notifyctl_cb_entrys >= NOTIFYCTL_MAX_CB ) {
+        log_e("notifyctl: no free callback entry");
+        return;
+    }
+    notifyctl_cb[ notifyctl_cb_entrys++ ] = alert_cb;
+}
+
+/*
+ * the notification is alerted with the others of its burst from notifyctl_loop()
+ */
+uint8_t notifyctl_notify( uint32_t id, const char *src, const char *sender, const char *body ) {
+    uint8_t action = notifyctl_check( src, sender );
+
+    if ( action != NOTIFYRULES_SILENT ) {
+        portENTER_CRITICAL(&notifyctlMux);
+        notifyburst_add( &notifyctl_burst, id, src, sender, body, action, millis() );
+        portEXIT_CRITICAL(&notifyctlMux);
+    }
+    return( action );
+}
+
+uint8_t notifyctl_check( const char *src, const char *sender ) {
+    struct tm info;
+    time_t now;
+
+    time( &now );
+    localtime_r( &now, &info );
+
+    portENTER_CRITICAL(&notifyctlMux);
+    uint8_t action = notifyrules_match( &notifyctl_rules, src, sender, info.tm_hour * 60 + info.tm_min );
+    portEXIT_CRITICAL(&notifyctlMux);
+
+    if ( info.tm_yday != notifyctl_today ) {
+        if ( notifyctl_today >= 0 ) {
+            log_i("notifyctl: %d notifications the day before, %d of them did not wake the watch", notifyctl_today_count, notifyctl_avoided_today );
+        }
+        notifyctl_today = info.tm_yday;
+        notifyctl_today_count = 0;
+        notifyctl_avoided_today = 0;
+    }
+    notifyctl_count[ action ]++;
+    notifyctl_today_count++;
+    // only a notification in standby would have woken the watch
+    if ( action != NOTIFYRULES_WAKE && powermgm_get_event( POWERMGM_STANDBY ) ) {
+        notifyctl_avoided++;
+        notifyctl_avoided_today++;
+    }
+    log_i("notifyctl: %s from %s -> %s, %d wakeups avoided today", sender ? sender : "n/a", src ? src : "n/a", notifyctl_action_name[ action ], notifyctl_avoided_today );
+    return( action );
+}
+
+uint32_t notifyctl_get_avoided_wakeups_today( void ) {
+    struct tm info;
+    time_t now;
+
+    time( &now );
+    localtime_r( &now, &info );
+    return( info.tm_yday == notifyctl_today ? notifyctl_avoided_today : 0 );
+}
+
+uint32_t notifyctl_get_avoided_wakeups( void ) {
+    return( notifyctl_avoided );
+}
+
+uint32_t notifyctl_get_count( uint8_t action ) {
+    return( action <= NOTIFYRULES_SILENT ? notifyctl_count[ action ] : 0 );
+}
+
+uint32_t notifyctl_get_alerts( void ) {
+    return( notifyctl_burst.alerts );
+}
+
+uint32_t notifyctl_get_coalesced( void ) {
+    return( notifyctl_burst.merged );
+}
+
+void notifyctl_set_burst_window( uint32_t window ) {
+    notifyctl_config.burst_window = window > NOTIFYCTL_MAX_BURST_WINDOW ? NOTIFYCTL_MAX_BURST_WINDOW : window;
+    portENTER_CRITICAL(&notifyctlMux);
+    notifyctl_burst.window = notifyctl_config.burst_window;
+    portEXIT_CRITICAL(&notifyctlMux);
+    notifyctl_save_config();
+}
+
+uint32_t notifyctl_get_burst_window( void ) {
+    return( notifyctl_config.burst_window );
+}
+
+void notifyctl_set_dnd( bool dnd ) {
+    notifyctl_config.dnd = dnd;
+    notifyctl_compile();
+    notifyctl_save_config();
+}
+
+bool notifyctl_get_dnd( void ) {
+    return( notifyctl_config.dnd );
+}
+
+/*
+ * the lookup is compiled once after every change of the config
+ */
+static void notifyctl_compile( void ) {
+    notifyrules_t rules;
+
+    notifyrules_compile( &rules, notifyctl_config.rule, notifyctl_config.rule_count, notifyctl_config.dnd ? &notifyctl_config.dnd_window : NULL );
+    portENTER_CRITICAL(&notifyctlMux);
+    notifyctl_rules = rules;
+    portEXIT_CRITICAL(&notifyctlMux);
+    log_i("notifyctl: %d rules, do not disturb %s", notifyctl_config.rule_count, notifyctl_config.dnd ? "on" : "off" );
+}
+
+static uint8_t notifyctl_parse_action( const char *action, uint8_t fallback ) {
+    for ( int i = 0 ; action && i <= NOTIFYRULES_SILENT ; i++ ) {
+        if ( !strcmp( action, notifyctl_action_name[ i ] ) ) {
+            return( i );
+        }
+    }
+    return( fallback );
+}
+
+static uint16_t notifyctl_parse_time( const char *time, uint16_t fallback ) {
+    int hour, min;
+
+    if ( time == NULL || sscanf( time, "%d:%d", &hour, &min ) != 2 || hour < 0 || hour > 24 || min < 0 || min > 59 ) {
+        return( fallback );
+    }
+    return( ( hour * 60 + min ) % NOTIFYRULES_DAY );
+}
+
+/*
+ *
+ */
+void notifyctl_save_config( void ) {
+    if ( configapi_defer_save( notifyctl_save_config ) ) {
+        return;
+    }
+    fs::File file = SPIFFS.open( NOTIFYCTL_JSON_CONFIG_FILE, FILE_WRITE );
+
+    if (!file) {
+        log_e("Can't open file: %s!", NOTIFYCTL_JSON_CONFIG_FILE );
+    }
+    else {
+        SpiRamJsonDocument doc( 1000 + notifyctl_config.rule_count * 200 );
+        char time[ 8 ];
+
+        doc["burst_window"] = notifyctl_config.burst_window;
+        doc["dnd"] = notifyctl_config.dnd;
+        snprintf( time, sizeof( time ), "%02d:%02d", notifyctl_config.dnd_window.from / 60, notifyctl_config.dnd_window.from % 60 );
+        doc["dnd_from"] = time;
+        snprintf( time, sizeof( time ), "%02d:%02d", notifyctl_config.dnd_window.to / 60, notifyctl_config.dnd_window.to % 60 );
+        doc["dnd_to"] = time;
+        doc["dnd_action"] = notifyctl_action_name[ notifyctl_config.dnd_window.action ];
+
+        JsonArray rules = doc.createNestedArray("rules");
+        for ( int i = 0 ; i < notifyctl_config.rule_count ; i++ ) {
+            notifyrules_rule_t *rule = &notifyctl_config.rule[ i ];
+            JsonObject entry = rules.createNestedObject();
+            if ( *rule->src ) {
+                entry["src"] = rule->src;
+            }
+            if ( *rule->sender ) {
+                entry["sender"] = rule->sender;
+            }
+            if ( rule->from != rule->to ) {
+                snprintf( time, sizeof( time ), "%02d:%02d", rule->from / 60, rule->from % 60 );
+                entry["from"] = time;
+                snprintf( time, sizeof( time ), "%02d:%02d", rule->to / 60, rule->to % 60 );
+                entry["to"] = time;
+            }
+            entry["action"] = notifyctl_action_name[ rule->action ];
+            if ( rule->override ) {
+                entry["override"] = true;
+            }
+        }
+
+        if ( serializeJsonPretty( doc, file ) == 0) {
+            log_e("Failed to write config file");
+        }
+        doc.clear();
+    }
+    file.close();
+}
+
+/*
+ *
+ */
+void notifyctl_read_config( void ) {
+    if ( SPIFFS.exists( NOTIFYCTL_JSON_CONFIG_FILE ) ) {
+        fs::File file = SPIFFS.open( NOTIFYCTL_JSON_CONFIG_FILE, FILE_READ );
+        if (!file) {
+            log_e("Can't open file: %s!", NOTIFYCTL_JSON_CONFIG_FILE );
+        }
+        else {
+            int filesize = file.size();
+            SpiRamJsonDocument doc( filesize * 2 );
+
+            DeserializationError error = deserializeJson( doc, file );
+            if ( error ) {
+                log_e("notifyctl deserializeJson() failed: %s", error.c_str() );
+            }
+            else {
+                notifyctl_config.burst_window = doc["burst_window"] | NOTIFYCTL_BURST_WINDOW;
+                if ( notifyctl_config.burst_window > NOTIFYCTL_MAX_BURST_WINDOW ) {
+                    notifyctl_config.burst_window = NOTIFYCTL_MAX_BURST_WINDOW;
+                }
+                notifyctl_config.dnd = doc["dnd"] | false;
+                notifyctl_config.dnd_window.from = notifyctl_parse_time( doc["dnd_from"], 22 * 60 );
+                notifyctl_config.dnd_window.to = notifyctl_parse_time( doc["dnd_to"], 7 * 60 );
+                notifyctl_config.dnd_window.action = notifyctl_parse_action( doc["dnd_action"], NOTIFYRULES_SILENT );
+
+                notifyctl_config.rule_count = 0;
+                for ( JsonObject entry : doc["rules"].as<JsonArray>() ) {
+                    if ( notifyctl_config.rule_count >= NOTIFYRULES_MAX ) {
+                        log_e("notifyctl: more than %d rules", NOTIFYRULES_MAX );
+                        break;
+                    }
+                    notifyrules_rule_t *rule = &notifyctl_config.rule[ notifyctl_config.rule_count++ ];
+                    strlcpy( rule->src, entry["src"] | "", sizeof( rule->src ) );
+                    strlcpy( rule->sender, entry["sender"] | "", sizeof( rule->sender ) );
+                    rule->from = notifyctl_parse_time( entry["from"], 0 );
+                    rule->to = notifyctl_parse_time( entry["to"], 0 );
+                    rule->action = notifyctl_parse_action( entry["action"], NOTIFYRULES_WAKE );
+                    rule->override = entry["override"] | false;
+                }
+            }
+            doc.clear();
+        }
+        file.close();
+    }
+}
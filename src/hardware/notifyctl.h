@@ -0,0 +1,120 @@
+/****************************************************************************
+ *   Sep 14 19:32:11 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NOTIFYCTL_H
+    #define _NOTIFYCTL_H
+
+    #include "TTGO.h"
+    #include "notifyrules.h"
+    #include "notifyburst.h"
+
+    #define NOTIFYCTL_JSON_CONFIG_FILE      "/notifyctl.json"
+    #define NOTIFYCTL_BURST_WINDOW          2000        /** @brief default ms to collect a burst */
+    #define NOTIFYCTL_MAX_BURST_WINDOW      10000
+    #define NOTIFYCTL_MAX_CB                4
+
+    /*
+     * /notifyctl.json, times are "hh:mm" and action is "wake", "vibe" or "silent"
+     *
+     * {
+     *   "burst_window": 2000,
+     *   "dnd": true, "dnd_from": "22:00", "dnd_to": "07:00", "dnd_action": "silent",
+     *   "rules": [
+     *     { "src": "Telegram", "sender": "Mom", "action": "wake", "override": true },
+     *     { "src": "Gmail", "action": "silent" },
+     *     { "src": "Whatsapp", "from": "09:00", "to": "17:00", "action": "vibe" }
+     *   ]
+     * }
+     */
+    typedef struct {
+        uint32_t burst_window = NOTIFYCTL_BURST_WINDOW;
+        bool dnd = false;
+        notifyrules_rule_t dnd_window = { "", "", 22 * 60, 7 * 60, NOTIFYRULES_SILENT, false };
+        uint8_t rule_count = 0;
+        notifyrules_rule_t rule[ NOTIFYRULES_MAX ];
+    } notifyctl_config_t;
+
+    typedef void ( * NOTIFYCTL_CALLBACK_FUNC ) ( notifyburst_summary_t *summary );
+
+    /*
+     * @brief read the rules and compile them
+     */
+    void notifyctl_setup( void );
+    /*
+     * @brief alert the bursts that are due, called from powermgm_loop()
+     */
+    void notifyctl_loop( void );
+    /*
+     * @brief register a function that alerts the user, it is called from notifyctl_loop()
+     *
+     * @param   alert_cb    alert function
+     */
+    void notifyctl_register_cb( NOTIFYCTL_CALLBACK_FUNC alert_cb );
+    /*
+     * @brief check a notification and add it to the current burst if it is not silent
+     *
+     * @param   id          gadgetbridge id or 0
+     * @param   src         source app or NULL
+     * @param   sender      title or sender or NULL
+     * @param   body        message or NULL
+     *
+     * @return  NOTIFYRULES_WAKE, NOTIFYRULES_VIBE or NOTIFYRULES_SILENT
+     */
+    uint8_t notifyctl_notify( uint32_t id, const char *src, const char *sender, const char *body );
+    /*
+     * @brief decide what to do with a notification and count it
+     *
+     * @param   src         source app or NULL
+     * @param   sender      title or sender or NULL
+     *
+     * @return  NOTIFYRULES_WAKE, NOTIFYRULES_VIBE or NOTIFYRULES_SILENT
+     */
+    uint8_t notifyctl_check( const char *src, const char *sender );
+    /*
+     * @brief notifications that did not wake the watch from standby today
+     */
+    uint32_t notifyctl_get_avoided_wakeups_today( void );
+    /*
+     * @brief notifications that did not wake the watch from standby since boot
+     */
+    uint32_t notifyctl_get_avoided_wakeups( void );
+    /*
+     * @brief notifications per action since boot
+     *
+     * @param   action      NOTIFYRULES_WAKE, NOTIFYRULES_VIBE or NOTIFYRULES_SILENT
+     */
+    uint32_t notifyctl_get_count( uint8_t action );
+    /*
+     * @brief alerts since boot, one per burst
+     */
+    uint32_t notifyctl_get_alerts( void );
+    /*
+     * @brief notifications since boot that were merged into an other one of their burst
+     */
+    uint32_t notifyctl_get_coalesced( void );
+    void notifyctl_set_burst_window( uint32_t window );
+    uint32_t notifyctl_get_burst_window( void );
+    void notifyctl_set_dnd( bool dnd );
+    bool notifyctl_get_dnd( void );
+    void notifyctl_save_config( void );
+    void notifyctl_read_config( void );
+
+#endif // _NOTIFYCTL_H
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *   Sep 14 19:32:11 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <string.h>
+
+#include "notifyrules.h"
+
+static uint8_t notifyrules_bucket( uint32_t src_hash );
+static uint8_t notifyrules_rank( const notifyrules_entry_t *entry );
+
+uint32_t notifyrules_hash( const char *name ) {
+    uint32_t hash = 2166136261u;                    // fnv-1a
+
+    if ( name == NULL || *name == '\0' ) {
+        return( 0 );
+    }
+    for ( ; *name ; name++ ) {
+        char c = *name;
+        if ( c >= 'A' && c <= 'Z' ) {
+            c += 'a' - 'A';
+        }
+        hash = ( hash ^ (uint8_t)c ) * 16777619u;
+    }
+    return( hash ? hash : 1 );
+}
+
+void notifyrules_compile( notifyrules_t *rules, const notifyrules_rule_t *config, size_t count, const notifyrules_rule_t *dnd ) {
+    notifyrules_entry_t entry[ NOTIFYRULES_MAX ];
+    uint8_t bucket_count[ NOTIFYRULES_BUCKETS + 1 ] = { 0 };
+
+    memset( rules, 0, sizeof( notifyrules_t ) );
+    if ( count > NOTIFYRULES_MAX ) {
+        count = NOTIFYRULES_MAX;
+    }
+    for ( size_t i = 0 ; i < count ; i++ ) {
+        entry[ i ].src_hash = notifyrules_hash( config[ i ].src );
+        entry[ i ].sender_hash = notifyrules_hash( config[ i ].sender );
+        entry[ i ].from = config[ i ].from % NOTIFYRULES_DAY;
+        entry[ i ].to = config[ i ].to % NOTIFYRULES_DAY;
+        entry[ i ].action = config[ i ].action > NOTIFYRULES_SILENT ? NOTIFYRULES_SILENT : config[ i ].action;
+        entry[ i ].override = config[ i ].override;
+        bucket_count[ notifyrules_bucket( entry[ i ].src_hash ) ]++;
+    }
+    /*
+     * one range per src bucket and one for rules without src, sorted by rank and
+     * then config order. a lookup only tries two short ranges
+     */
+    rules->start[ 0 ] = 0;
+    for ( int b = 0 ; b <= NOTIFYRULES_BUCKETS ; b++ ) {
+        rules->start[ b + 1 ] = rules->start[ b ] + bucket_count[ b ];
+    }
+    for ( int b = 0 ; b <= NOTIFYRULES_BUCKETS ; b++ ) {
+        uint8_t pos = rules->start[ b ];
+        for ( int rank = 0 ; rank < 4 ; rank++ ) {
+            for ( size_t i = 0 ; i < count ; i++ ) {
+                if ( notifyrules_bucket( entry[ i ].src_hash ) == b && notifyrules_rank( &entry[ i ] ) == rank ) {
+                    rules->entry[ pos++ ] = entry[ i ];
+                }
+            }
+        }
+    }
+    rules->count = count;
+
+    if ( dnd ) {
+        rules->dnd = true;
+        rules->dnd_from = dnd->from % NOTIFYRULES_DAY;
+        rules->dnd_to = dnd->to % NOTIFYRULES_DAY;
+        rules->dnd_action = dnd->action > NOTIFYRULES_SILENT ? NOTIFYRULES_SILENT : dnd->action;
+    }
+}
+
+uint8_t notifyrules_match( const notifyrules_t *rules, const char *src, const char *sender, uint16_t minute ) {
+    uint32_t src_hash = notifyrules_hash( src );
+    uint32_t sender_hash = notifyrules_hash( sender );
+    const notifyrules_entry_t *match = NULL;
+    uint8_t action = NOTIFYRULES_WAKE;
+
+    /*
+     * the src bucket holds the more specific rules, the first match in it wins
+     * over anything in the bucket without src
+     */
+    uint8_t buckets[ 2 ] = { notifyrules_bucket( src_hash ), NOTIFYRULES_BUCKETS };
+    for ( int b = src_hash ? 0 : 1 ; b < 2 && match == NULL ; b++ ) {
+        for ( uint8_t i = rules->start[ buckets[ b ] ] ; i < rules->start[ buckets[ b ] + 1 ] ; i++ ) {
+            const notifyrules_entry_t *entry = &rules->entry[ i ];
+            if ( ( entry->src_hash == 0 || entry->src_hash == src_hash ) &&
+                 ( entry->sender_hash == 0 || entry->sender_hash == sender_hash ) &&
+                 notifyrules_in_window( entry->from, entry->to, minute ) ) {
+                match = entry;
+                break;
+            }
+        }
+    }
+    if ( match ) {
+        action = match->action;
+    }
+    if ( rules->dnd && !( match && match->override ) && notifyrules_in_window( rules->dnd_from, rules->dnd_to, minute ) ) {
+        if ( action < rules->dnd_action ) {
+            action = rules->dnd_action;
+        }
+    }
+    return( action );
+}
+
+bool notifyrules_in_window( uint16_t from, uint16_t to, uint16_t minute ) {
+    if ( from == to ) {
+        return( true );
+    }
+    if ( from < to ) {
+        return( minute >= from && minute < to );
+    }
+    return( minute >= from || minute < to );
+}
+
+static uint8_t notifyrules_bucket( uint32_t src_hash ) {
+    return( src_hash ? src_hash % NOTIFYRULES_BUCKETS : NOTIFYRULES_BUCKETS );
+}
+
+/*
+ * 0 is tried first: src and sender, src, sender, none
+ */
+static uint8_t notifyrules_rank( const notifyrules_entry_t *entry ) {
+    return( ( entry->src_hash ? 0 : 2 ) + ( entry->sender_hash ? 0 : 1 ) );
+}
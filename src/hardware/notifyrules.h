@@ -0,0 +1,115 @@
+/****************************************************************************
+ *   Sep 14 19:32:11 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NOTIFYRULES_H
+    #define _NOTIFYRULES_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    /*
+     * decide per notification what it is worth. a rule matches on the source app,
+     * the sender and the time of the day, an empty src or sender matches all.
+     * the most specific match wins: src and sender, src, sender, none of them.
+     * within do not disturb the action is not louder than the dnd action, except
+     * for rules with override set
+     */
+    #define NOTIFYRULES_WAKE            0           /** @brief wake up, vibrate and show it */
+    #define NOTIFYRULES_VIBE            1           /** @brief vibrate, the watch stays in standby */
+    #define NOTIFYRULES_SILENT          2           /** @brief only store it in the history */
+
+    #define NOTIFYRULES_MAX             32
+    #define NOTIFYRULES_NAME_SIZE       24
+    #define NOTIFYRULES_BUCKETS         16          /** @brief src hash buckets, one more for rules without src */
+    #define NOTIFYRULES_DAY             ( 24 * 60 )
+
+    /*
+     * @brief a rule as it is written in the config
+     */
+    typedef struct {
+        char src[ NOTIFYRULES_NAME_SIZE ];          /** @brief source app like "Telegram", "" for all */
+        char sender[ NOTIFYRULES_NAME_SIZE ];       /** @brief title or sender, "" for all */
+        uint16_t from;                              /** @brief minute of the day the rule starts */
+        uint16_t to;                                /** @brief minute of the day the rule ends, from == to is all day */
+        uint8_t action;
+        bool override;                              /** @brief also within do not disturb */
+    } notifyrules_rule_t;
+
+    typedef struct {
+        uint32_t src_hash;                          /** @brief 0 for all */
+        uint32_t sender_hash;                       /** @brief 0 for all */
+        uint16_t from;
+        uint16_t to;
+        uint8_t action;
+        bool override;
+    } notifyrules_entry_t;
+
+    /*
+     * @brief compiled rules, the entries of a bucket are in the order they are tried
+     */
+    typedef struct {
+        uint8_t count;
+        uint8_t start[ NOTIFYRULES_BUCKETS + 2 ];   /** @brief first entry of each bucket, the last one is the end */
+        notifyrules_entry_t entry[ NOTIFYRULES_MAX ];
+        bool dnd;
+        uint16_t dnd_from;
+        uint16_t dnd_to;
+        uint8_t dnd_action;
+    } notifyrules_t;
+
+    /*
+     * @brief hash of a src or sender, not case sensitive
+     *
+     * @param   name    name or NULL
+     *
+     * @return  hash, 0 for NULL or ""
+     */
+    uint32_t notifyrules_hash( const char *name );
+    /*
+     * @brief compile rules into the lookup
+     *
+     * @param   rules       pointer to the compiled rules
+     * @param   config      rules from the config
+     * @param   count       number of rules, more than NOTIFYRULES_MAX are ignored
+     * @param   dnd         do not disturb window and action, src, sender and override unused, NULL if off
+     */
+    void notifyrules_compile( notifyrules_t *rules, const notifyrules_rule_t *config, size_t count, const notifyrules_rule_t *dnd );
+    /*
+     * @brief find the action for a notification
+     *
+     * @param   rules       pointer to the compiled rules
+     * @param   src         source app or NULL
+     * @param   sender      title or sender or NULL
+     * @param   minute      minute of the day, local time
+     *
+     * @return  NOTIFYRULES_WAKE, NOTIFYRULES_VIBE or NOTIFYRULES_SILENT
+     */
+    uint8_t notifyrules_match( const notifyrules_t *rules, const char *src, const char *sender, uint16_t minute );
+    /*
+     * @brief check if a minute is within a window
+     *
+     * @param   from        first minute
+     * @param   to          first minute after the window, before from if it goes over midnight
+     * @param   minute      minute of the day
+     */
+    bool notifyrules_in_window( uint16_t from, uint16_t to, uint16_t minute );
+
+#endif // _NOTIFYRULES_H
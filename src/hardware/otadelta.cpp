@@ -0,0 +1,303 @@
+/****************************************************************************
+ *   Sep 09 20:12:45 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <string.h>
+
+#include "otadelta.h"
+
+/*
+ * no arduino or esp-idf calls in here, the old image and the flash
+ * are only reached through the callbacks
+ */
+enum {
+    OTADELTA_STATE_HEADER = 0,
+    OTADELTA_STATE_OPCODE,
+    OTADELTA_STATE_OFFSET,
+    OTADELTA_STATE_LEN,
+    OTADELTA_STATE_ZEROS,
+    OTADELTA_STATE_COUNT,
+    OTADELTA_STATE_DIFF,
+    OTADELTA_STATE_INSERT,
+    OTADELTA_STATE_END,
+    OTADELTA_STATE_ERROR
+};
+
+static bool otadelta_fail( otadelta_t *delta, const char *error );
+static int otadelta_varint( otadelta_t *delta, uint8_t byte );
+static bool otadelta_header( otadelta_t *delta );
+static bool otadelta_arg( otadelta_t *delta, uint32_t value );
+static bool otadelta_old( otadelta_t *delta, uint32_t len, const uint8_t *diff );
+static uint32_t otadelta_le32( const uint8_t *data );
+
+bool otadelta_is_delta( const uint8_t *data, size_t len ) {
+    return( len >= 4 && !memcmp( data, OTADELTA_MAGIC, 4 ) );
+}
+
+void otadelta_init( otadelta_t *delta, OTADELTA_READ_FUNC read_cb, OTADELTA_WRITE_FUNC write_cb, OTADELTA_HEADER_FUNC header_cb ) {
+    memset( delta, 0, sizeof( otadelta_t ) );
+    delta->read_cb = read_cb;
+    delta->write_cb = write_cb;
+    delta->header_cb = header_cb;
+    delta->state = OTADELTA_STATE_HEADER;
+}
+
+bool otadelta_feed( otadelta_t *delta, const uint8_t *data, size_t len ) {
+    while ( len > 0 ) {
+        size_t n;
+        int varint;
+
+        switch( delta->state ) {
+            case OTADELTA_STATE_HEADER:
+                n = OTADELTA_HEADER_SIZE - delta->header_len;
+                if ( n > len ) {
+                    n = len;
+                }
+                memcpy( delta->header + delta->header_len, data, n );
+                delta->header_len += n;
+                data += n;
+                len -= n;
+                if ( delta->header_len == OTADELTA_HEADER_SIZE && !otadelta_header( delta ) ) {
+                    return( false );
+                }
+                break;
+            case OTADELTA_STATE_OPCODE:
+                delta->op = *data++;
+                len--;
+                switch( delta->op ) {
+                    case OTADELTA_OP_END:       delta->state = OTADELTA_STATE_END;
+                                                break;
+                    case OTADELTA_OP_COPY:
+                    case OTADELTA_OP_ADD:       delta->state = OTADELTA_STATE_OFFSET;
+                                                break;
+                    case OTADELTA_OP_INSERT:    delta->state = OTADELTA_STATE_LEN;
+                                                break;
+                    default:                    return( otadelta_fail( delta, "unknown op" ) );
+                }
+                break;
+            case OTADELTA_STATE_OFFSET:
+            case OTADELTA_STATE_LEN:
+            case OTADELTA_STATE_ZEROS:
+            case OTADELTA_STATE_COUNT:
+                varint = otadelta_varint( delta, *data++ );
+                len--;
+                if ( varint < 0 ) {
+                    return( false );
+                }
+                if ( varint > 0 && !otadelta_arg( delta, delta->varint ) ) {
+                    return( false );
+                }
+                break;
+            case OTADELTA_STATE_DIFF:
+                n = delta->count;
+                if ( n > len ) {
+                    n = len;
+                }
+                if ( n > OTADELTA_BUFFER_SIZE ) {
+                    n = OTADELTA_BUFFER_SIZE;
+                }
+                if ( !otadelta_old( delta, n, data ) ) {
+                    return( false );
+                }
+                data += n;
+                len -= n;
+                delta->count -= n;
+                delta->remaining -= n;
+                if ( delta->count == 0 ) {
+                    delta->state = delta->remaining ? OTADELTA_STATE_ZEROS : OTADELTA_STATE_OPCODE;
+                }
+                break;
+            case OTADELTA_STATE_INSERT:
+                n = delta->remaining;
+                if ( n > len ) {
+                    n = len;
+                }
+                if ( !delta->write_cb( data, n ) ) {
+                    return( otadelta_fail( delta, "write failed" ) );
+                }
+                data += n;
+                len -= n;
+                delta->new_pos += n;
+                delta->remaining -= n;
+                if ( delta->remaining == 0 ) {
+                    delta->state = OTADELTA_STATE_OPCODE;
+                }
+                break;
+            case OTADELTA_STATE_END:
+                return( otadelta_fail( delta, "data after the end" ) );
+            default:
+                return( false );
+        }
+    }
+    return( true );
+}
+
+bool otadelta_finish( otadelta_t *delta ) {
+    if ( delta->state == OTADELTA_STATE_ERROR ) {
+        return( false );
+    }
+    if ( delta->state != OTADELTA_STATE_END || delta->new_pos != delta->new_size ) {
+        return( otadelta_fail( delta, "patch truncated" ) );
+    }
+    return( true );
+}
+
+static bool otadelta_fail( otadelta_t *delta, const char *error ) {
+    delta->state = OTADELTA_STATE_ERROR;
+    delta->error = error;
+    return( false );
+}
+
+/*
+ * @return  1 if the varint is complete, 0 if more bytes are needed, -1 on an overflow
+ */
+static int otadelta_varint( otadelta_t *delta, uint8_t byte ) {
+    if ( delta->varint_shift == 0 ) {
+        delta->varint = 0;
+    }
+    if ( delta->varint_shift > 28 || ( delta->varint_shift == 28 && ( byte & 0x70 ) ) ) {
+        otadelta_fail( delta, "varint overflow" );
+        return( -1 );
+    }
+    delta->varint |= (uint32_t)( byte & 0x7f ) << delta->varint_shift;
+    if ( byte & 0x80 ) {
+        delta->varint_shift += 7;
+        return( 0 );
+    }
+    delta->varint_shift = 0;
+    return( 1 );
+}
+
+static bool otadelta_header( otadelta_t *delta ) {
+    if ( memcmp( delta->header, OTADELTA_MAGIC, 4 ) ) {
+        return( otadelta_fail( delta, "not a delta patch" ) );
+    }
+    if ( delta->header[ 4 ] != OTADELTA_VERSION ) {
+        return( otadelta_fail( delta, "unknown patch version" ) );
+    }
+    delta->old_size = otadelta_le32( delta->header + 8 );
+    delta->new_size = otadelta_le32( delta->header + 12 );
+    memcpy( delta->old_sha256, delta->header + 16, 32 );
+    memcpy( delta->new_sha256, delta->header + 48, 32 );
+
+    if ( delta->header_cb && !delta->header_cb( delta ) ) {
+        return( otadelta_fail( delta, "patch does not fit the running image" ) );
+    }
+    delta->state = OTADELTA_STATE_OPCODE;
+    return( true );
+}
+
+/*
+ * one varint of the current op is complete
+ */
+static bool otadelta_arg( otadelta_t *delta, uint32_t value ) {
+    int64_t old_pos;
+
+    switch( delta->state ) {
+        case OTADELTA_STATE_OFFSET:
+            delta->offset = (int32_t)( value >> 1 ) ^ -(int32_t)( value & 1 );
+            old_pos = (int64_t)delta->old_pos + delta->offset;
+            if ( old_pos < 0 || old_pos > delta->old_size ) {
+                return( otadelta_fail( delta, "offset out of range" ) );
+            }
+            delta->old_pos = old_pos;
+            delta->state = OTADELTA_STATE_LEN;
+            break;
+        case OTADELTA_STATE_LEN:
+            if ( value > delta->new_size - delta->new_pos ) {
+                return( otadelta_fail( delta, "new image too long" ) );
+            }
+            if ( delta->op != OTADELTA_OP_INSERT && value > delta->old_size - delta->old_pos ) {
+                return( otadelta_fail( delta, "read beyond the old image" ) );
+            }
+            delta->remaining = value;
+            if ( delta->op == OTADELTA_OP_COPY ) {
+                if ( !otadelta_old( delta, value, NULL ) ) {
+                    return( false );
+                }
+                delta->remaining = 0;
+                delta->state = OTADELTA_STATE_OPCODE;
+            }
+            else if ( value == 0 ) {
+                delta->state = OTADELTA_STATE_OPCODE;
+            }
+            else {
+                delta->state = delta->op == OTADELTA_OP_ADD ? OTADELTA_STATE_ZEROS : OTADELTA_STATE_INSERT;
+            }
+            break;
+        case OTADELTA_STATE_ZEROS:
+            if ( value > delta->remaining ) {
+                return( otadelta_fail( delta, "diff too long" ) );
+            }
+            if ( !otadelta_old( delta, value, NULL ) ) {
+                return( false );
+            }
+            delta->remaining -= value;
+            delta->count = value;
+            delta->state = OTADELTA_STATE_COUNT;
+            break;
+        case OTADELTA_STATE_COUNT:
+            if ( value > delta->remaining ) {
+                return( otadelta_fail( delta, "diff too long" ) );
+            }
+            if ( value == 0 && delta->count == 0 ) {
+                return( otadelta_fail( delta, "empty diff" ) );
+            }
+            delta->count = value;
+            if ( value ) {
+                delta->state = OTADELTA_STATE_DIFF;
+            }
+            else {
+                delta->state = delta->remaining ? OTADELTA_STATE_ZEROS : OTADELTA_STATE_OPCODE;
+            }
+            break;
+    }
+    return( true );
+}
+
+/*
+ * write len bytes from old, plus diff if not NULL
+ */
+static bool otadelta_old( otadelta_t *delta, uint32_t len, const uint8_t *diff ) {
+    while ( len > 0 ) {
+        size_t n = len > OTADELTA_BUFFER_SIZE ? OTADELTA_BUFFER_SIZE : len;
+
+        if ( !delta->read_cb( delta->old_pos, delta->buf, n ) ) {
+            return( otadelta_fail( delta, "read failed" ) );
+        }
+        if ( diff ) {
+            for( size_t i = 0 ; i < n ; i++ ) {
+                delta->buf[ i ] += diff[ i ];
+            }
+            diff += n;
+        }
+        if ( !delta->write_cb( delta->buf, n ) ) {
+            return( otadelta_fail( delta, "write failed" ) );
+        }
+        delta->old_pos += n;
+        delta->new_pos += n;
+        len -= n;
+    }
+    return( true );
+}
+
+static uint32_t otadelta_le32( const uint8_t *data ) {
+    return( data[ 0 ] | data[ 1 ] << 8 | data[ 2 ] << 16 | (uint32_t)data[ 3 ] << 24 );
+}
@@ -0,0 +1,140 @@
+/****************************************************************************
+ *   Sep 09 20:12:45 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _OTADELTA_H
+    #define _OTADELTA_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    /*
+     * delta patch, made with tools/mkdelta.py, all values little endian:
+     *
+     * char     magic[4]        "TWDP"
+     * uint8_t  version         OTADELTA_VERSION
+     * uint8_t  reserved[3]
+     * uint32_t old_size        size of the image the patch is made for
+     * uint32_t new_size        size of the new image
+     * uint8_t  old_sha256[32]  sha256 of the old image, checked before anything is written
+     * uint8_t  new_sha256[32]  sha256 of the new image
+     * ...                      ops up to OTADELTA_OP_END, numbers are LEB128 varints:
+     *
+     * OTADELTA_OP_COPY         offset, len                 copy len bytes from old
+     * OTADELTA_OP_ADD          offset, len, pairs...       old bytes plus a sparse diff, each pair is
+     *                                                      zeros, count, count diff bytes
+     *                                                      until len bytes are covered
+     * OTADELTA_OP_INSERT       len, len bytes              new bytes
+     *
+     * offset is zigzag encoded and relative to the end of the last COPY or ADD in old
+     */
+    #define OTADELTA_MAGIC              "TWDP"
+    #define OTADELTA_VERSION            1
+    #define OTADELTA_HEADER_SIZE        80
+    #define OTADELTA_BUFFER_SIZE        512         /** @brief old bytes read at once */
+
+    #define OTADELTA_OP_END             0
+    #define OTADELTA_OP_COPY            1
+    #define OTADELTA_OP_ADD             2
+    #define OTADELTA_OP_INSERT          3
+
+    typedef struct otadelta_t otadelta_t;
+
+    /*
+     * @brief read from the old image
+     *
+     * @return  true if successful
+     */
+    typedef bool ( * OTADELTA_READ_FUNC ) ( size_t offset, uint8_t *data, size_t len );
+    /*
+     * @brief write the next part of the new image
+     *
+     * @return  true if successful
+     */
+    typedef bool ( * OTADELTA_WRITE_FUNC ) ( const uint8_t *data, size_t len );
+    /*
+     * @brief check the header before the first byte is written, old_size, new_size and
+     * both sha256 are valid
+     *
+     * @return  true if the patch fits the old image
+     */
+    typedef bool ( * OTADELTA_HEADER_FUNC ) ( otadelta_t *delta );
+
+    struct otadelta_t {
+        OTADELTA_READ_FUNC read_cb;
+        OTADELTA_WRITE_FUNC write_cb;
+        OTADELTA_HEADER_FUNC header_cb;
+        uint8_t state;
+        uint8_t op;
+        uint32_t varint;                            /** @brief varint in progress */
+        uint8_t varint_shift;
+        int32_t offset;                             /** @brief offset of the current op */
+        uint32_t remaining;                         /** @brief bytes left in the current op */
+        uint32_t count;                             /** @brief bytes left in the current diff pair */
+        uint32_t old_pos;                           /** @brief read position in old */
+        uint32_t new_pos;                           /** @brief bytes written */
+        uint32_t old_size;
+        uint32_t new_size;
+        uint8_t old_sha256[ 32 ];
+        uint8_t new_sha256[ 32 ];
+        uint8_t header[ OTADELTA_HEADER_SIZE ];
+        uint32_t header_len;
+        const char *error;                          /** @brief reason of a fail or NULL */
+        uint8_t buf[ OTADELTA_BUFFER_SIZE ];
+    };
+
+    /*
+     * @brief check if data starts with a delta patch
+     *
+     * @param   data        pointer to the first bytes
+     * @param   len         number of bytes
+     *
+     * @return  true if it is a delta patch
+     */
+    bool otadelta_is_delta( const uint8_t *data, size_t len );
+    /*
+     * @brief prepare a delta for a new patch
+     *
+     * @param   delta       pointer to the delta state
+     * @param   read_cb     read from the old image
+     * @param   write_cb    write the new image
+     * @param   header_cb   check the header, can be NULL
+     */
+    void otadelta_init( otadelta_t *delta, OTADELTA_READ_FUNC read_cb, OTADELTA_WRITE_FUNC write_cb, OTADELTA_HEADER_FUNC header_cb );
+    /*
+     * @brief apply the next part of the patch, the patch can be split at any byte
+     *
+     * @param   delta       pointer to the delta state
+     * @param   data        pointer to the patch data
+     * @param   len         length of the patch data
+     *
+     * @return  false if the patch is broken or a callback failed, see delta->error
+     */
+    bool otadelta_feed( otadelta_t *delta, const uint8_t *data, size_t len );
+    /*
+     * @brief check if the patch was complete
+     *
+     * @param   delta       pointer to the delta state
+     *
+     * @return  true if the end op was read and new_size bytes written
+     */
+    bool otadelta_finish( otadelta_t *delta );
+
+#endif // _OTADELTA_H
@@ -0,0 +1,564 @@
+/****************************************************************************
+ *   Sep 11 18:42:10 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <string.h>
+
+#include "otainflate.h"
+
+/*
+ * no arduino or esp-idf calls in here. each step (header, block header, one
+ * symbol, trailer) is only started when enough input for the worst case is
+ * buffered, so the decoder never has to stop in the middle of a step
+ */
+enum {
+    OTAINFLATE_STATE_HEADER = 0,
+    OTAINFLATE_STATE_EXTRA_LEN,
+    OTAINFLATE_STATE_EXTRA,
+    OTAINFLATE_STATE_NAME,
+    OTAINFLATE_STATE_COMMENT,
+    OTAINFLATE_STATE_HCRC,
+    OTAINFLATE_STATE_BLOCK,
+    OTAINFLATE_STATE_STORED,
+    OTAINFLATE_STATE_CODES,
+    OTAINFLATE_STATE_TRAILER,
+    OTAINFLATE_STATE_END,
+    OTAINFLATE_STATE_ERROR
+};
+
+#define OTAINFLATE_FHCRC            0x02
+#define OTAINFLATE_FEXTRA           0x04
+#define OTAINFLATE_FNAME            0x08
+#define OTAINFLATE_FCOMMENT         0x10
+
+#define OTAINFLATE_MAX_BITS         15
+#define OTAINFLATE_HEADER_BITS      ( 10 * 8 )
+#define OTAINFLATE_BLOCK_BITS       ( 3 + 14 + 19 * 3 + ( 286 + 30 ) * ( 7 + 7 ) )     /** @brief worst dynamic block header */
+#define OTAINFLATE_CODE_BITS        ( 15 + 5 + 15 + 13 )                            /** @brief worst length/distance pair */
+#define OTAINFLATE_TRAILER_BITS     ( 7 + 8 * 8 )
+
+static const uint16_t otainflate_len_base[ 29 ] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t otainflate_len_extra[ 29 ] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t otainflate_dist_base[ 30 ] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t otainflate_dist_extra[ 30 ] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const uint8_t otainflate_code_order[ 19 ] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+static const uint32_t otainflate_crc_table[ 16 ] = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c };
+
+static bool otainflate_fail( otainflate_t *inflate, const char *error );
+static bool otainflate_run( otainflate_t *inflate );
+static bool otainflate_ready( otainflate_t *inflate, uint32_t bits );
+static uint32_t otainflate_bits( otainflate_t *inflate, int need );
+static int otainflate_decode( otainflate_t *inflate, const uint16_t *count, const uint16_t *symbol );
+static int otainflate_construct( uint16_t *count, uint16_t *symbol, const uint8_t *length, int n );
+static bool otainflate_block( otainflate_t *inflate );
+static bool otainflate_dynamic( otainflate_t *inflate );
+static bool otainflate_codes( otainflate_t *inflate );
+static bool otainflate_put( otainflate_t *inflate, uint8_t byte );
+static bool otainflate_flush( otainflate_t *inflate );
+static void otainflate_next_header( otainflate_t *inflate );
+
+bool otainflate_is_gzip( const uint8_t *data, size_t len ) {
+    return( len >= 3 && data[ 0 ] == 0x1f && data[ 1 ] == 0x8b && data[ 2 ] == 8 );
+}
+
+void otainflate_init( otainflate_t *inflate, OTAINFLATE_WRITE_FUNC write_cb ) {
+    memset( inflate, 0, sizeof( otainflate_t ) - OTAINFLATE_WINDOW_SIZE );
+    inflate->write_cb = write_cb;
+    inflate->state = OTAINFLATE_STATE_HEADER;
+    inflate->crc = 0xffffffff;
+}
+
+bool otainflate_feed( otainflate_t *inflate, const uint8_t *data, size_t len ) {
+    while ( len > 0 ) {
+        if ( inflate->state == OTAINFLATE_STATE_ERROR ) {
+            return( false );
+        }
+        if ( inflate->in_pos ) {
+            memmove( inflate->in, inflate->in + inflate->in_pos, inflate->in_len - inflate->in_pos );
+            inflate->in_len -= inflate->in_pos;
+            inflate->in_pos = 0;
+        }
+        size_t n = OTAINFLATE_INPUT_SIZE - inflate->in_len;
+        if ( n > len ) {
+            n = len;
+        }
+        memcpy( inflate->in + inflate->in_len, data, n );
+        inflate->in_len += n;
+        data += n;
+        len -= n;
+        if ( !otainflate_run( inflate ) ) {
+            return( false );
+        }
+    }
+    return( otainflate_flush( inflate ) );
+}
+
+bool otainflate_finish( otainflate_t *inflate ) {
+    if ( inflate->state == OTAINFLATE_STATE_ERROR ) {
+        return( false );
+    }
+    inflate->finishing = true;
+    if ( !otainflate_run( inflate ) || !otainflate_flush( inflate ) ) {
+        return( false );
+    }
+    if ( inflate->state != OTAINFLATE_STATE_END ) {
+        return( otainflate_fail( inflate, "gzip stream truncated" ) );
+    }
+    return( true );
+}
+
+static bool otainflate_fail( otainflate_t *inflate, const char *error ) {
+    inflate->state = OTAINFLATE_STATE_ERROR;
+    inflate->error = error;
+    return( false );
+}
+
+/*
+ * decode as long as the buffered input is enough for the next step
+ *
+ * @return  false on an error
+ */
+static bool otainflate_run( otainflate_t *inflate ) {
+    while( true ) {
+        switch( inflate->state ) {
+            case OTAINFLATE_STATE_HEADER:
+                if ( !otainflate_ready( inflate, OTAINFLATE_HEADER_BITS ) ) {
+                    return( true );
+                }
+                if ( otainflate_bits( inflate, 16 ) != 0x8b1f || otainflate_bits( inflate, 8 ) != 8 ) {
+                    return( otainflate_fail( inflate, inflate->overrun ? "gzip stream truncated" : "not a gzip stream" ) );
+                }
+                inflate->flags = otainflate_bits( inflate, 8 );
+                // mtime, xfl and os
+                otainflate_bits( inflate, 16 );
+                otainflate_bits( inflate, 16 );
+                otainflate_bits( inflate, 16 );
+                otainflate_next_header( inflate );
+                break;
+            case OTAINFLATE_STATE_EXTRA_LEN:
+                if ( !otainflate_ready( inflate, 16 ) ) {
+                    return( true );
+                }
+                inflate->left = otainflate_bits( inflate, 16 );
+                inflate->state = OTAINFLATE_STATE_EXTRA;
+                break;
+            case OTAINFLATE_STATE_EXTRA:
+                while( inflate->left && otainflate_ready( inflate, 8 ) ) {
+                    otainflate_bits( inflate, 8 );
+                    inflate->left--;
+                }
+                if ( inflate->left && !inflate->overrun ) {
+                    return( true );
+                }
+                inflate->flags &= ~OTAINFLATE_FEXTRA;
+                otainflate_next_header( inflate );
+                break;
+            case OTAINFLATE_STATE_NAME:
+            case OTAINFLATE_STATE_COMMENT:
+                while( true ) {
+                    if ( !otainflate_ready( inflate, 8 ) ) {
+                        return( true );
+                    }
+                    if ( otainflate_bits( inflate, 8 ) == 0 || inflate->overrun ) {
+                        break;
+                    }
+                }
+                inflate->flags &= inflate->state == OTAINFLATE_STATE_NAME ? ~OTAINFLATE_FNAME : ~OTAINFLATE_FCOMMENT;
+                otainflate_next_header( inflate );
+                break;
+            case OTAINFLATE_STATE_HCRC:
+                if ( !otainflate_ready( inflate, 16 ) ) {
+                    return( true );
+                }
+                otainflate_bits( inflate, 16 );
+                inflate->flags &= ~OTAINFLATE_FHCRC;
+                otainflate_next_header( inflate );
+                break;
+            case OTAINFLATE_STATE_BLOCK:
+                if ( inflate->last_block ) {
+                    inflate->state = OTAINFLATE_STATE_TRAILER;
+                    break;
+                }
+                if ( !otainflate_ready( inflate, OTAINFLATE_BLOCK_BITS ) ) {
+                    return( true );
+                }
+                if ( !otainflate_block( inflate ) ) {
+                    return( false );
+                }
+                break;
+            case OTAINFLATE_STATE_STORED:
+                while( inflate->left && inflate->in_pos < inflate->in_len ) {
+                    if ( !otainflate_put( inflate, inflate->in[ inflate->in_pos++ ] ) ) {
+                        return( false );
+                    }
+                    inflate->left--;
+                }
+                if ( inflate->left ) {
+                    if ( inflate->finishing ) {
+                        return( otainflate_fail( inflate, "gzip stream truncated" ) );
+                    }
+                    return( true );
+                }
+                inflate->state = OTAINFLATE_STATE_BLOCK;
+                break;
+            case OTAINFLATE_STATE_CODES:
+                if ( !otainflate_codes( inflate ) ) {
+                    return( false );
+                }
+                if ( inflate->state == OTAINFLATE_STATE_CODES ) {
+                    return( true );
+                }
+                break;
+            case OTAINFLATE_STATE_TRAILER: {
+                if ( !otainflate_ready( inflate, OTAINFLATE_TRAILER_BITS ) ) {
+                    return( true );
+                }
+                // the trailer starts at a byte boundary
+                inflate->bitbuf = 0;
+                inflate->bitcnt = 0;
+                if ( !otainflate_flush( inflate ) ) {
+                    return( false );
+                }
+                uint32_t crc = otainflate_bits( inflate, 16 );
+                crc |= otainflate_bits( inflate, 16 ) << 16;
+                uint32_t size = otainflate_bits( inflate, 16 );
+                size |= otainflate_bits( inflate, 16 ) << 16;
+                if ( inflate->overrun ) {
+                    return( otainflate_fail( inflate, "gzip stream truncated" ) );
+                }
+                if ( crc != ~inflate->crc ) {
+                    return( otainflate_fail( inflate, "gzip crc32 mismatch" ) );
+                }
+                if ( size != inflate->total_out ) {
+                    return( otainflate_fail( inflate, "gzip size mismatch" ) );
+                }
+                inflate->state = OTAINFLATE_STATE_END;
+                break;
+            }
+            case OTAINFLATE_STATE_END:
+                if ( inflate->in_pos < inflate->in_len ) {
+                    return( otainflate_fail( inflate, "data after the gzip stream" ) );
+                }
+                return( true );
+            default:
+                return( false );
+        }
+        if ( inflate->overrun ) {
+            return( otainflate_fail( inflate, "gzip stream truncated" ) );
+        }
+    }
+}
+
+/*
+ * true if the buffered input has the given number of bits or no more input follows
+ */
+static bool otainflate_ready( otainflate_t *inflate, uint32_t bits ) {
+    return( inflate->finishing || inflate->bitcnt + ( inflate->in_len - inflate->in_pos ) * 8u >= bits );
+}
+
+static uint32_t otainflate_bits( otainflate_t *inflate, int need ) {
+    uint32_t val = inflate->bitbuf;
+
+    while( inflate->bitcnt < need ) {
+        if ( inflate->in_pos == inflate->in_len ) {
+            inflate->overrun = true;
+            return( 0 );
+        }
+        val |= (uint32_t)inflate->in[ inflate->in_pos++ ] << inflate->bitcnt;
+        inflate->bitcnt += 8;
+    }
+    inflate->bitbuf = val >> need;
+    inflate->bitcnt -= need;
+    return( val & ( ( 1ul << need ) - 1 ) );
+}
+
+/*
+ * canonical huffman decode, one bit at a time
+ */
+static int otainflate_decode( otainflate_t *inflate, const uint16_t *count, const uint16_t *symbol ) {
+    int code = 0;
+    int first = 0;
+    int index = 0;
+
+    for( int len = 1 ; len <= OTAINFLATE_MAX_BITS ; len++ ) {
+        code |= otainflate_bits( inflate, 1 );
+        int n = count[ len ];
+        if ( code - n < first ) {
+            return( symbol[ index + ( code - first ) ] );
+        }
+        index += n;
+        first += n;
+        first <<= 1;
+        code <<= 1;
+    }
+    return( -1 );
+}
+
+/*
+ * @return  0 for a complete code, > 0 for an incomplete code and < 0 for an over-subscribed code
+ */
+static int otainflate_construct( uint16_t *count, uint16_t *symbol, const uint8_t *length, int n ) {
+    uint16_t offs[ OTAINFLATE_MAX_BITS + 1 ];
+    int left = 1;
+
+    memset( count, 0, sizeof( uint16_t ) * ( OTAINFLATE_MAX_BITS + 1 ) );
+    for( int sym = 0 ; sym < n ; sym++ ) {
+        count[ length[ sym ] ]++;
+    }
+    if ( count[ 0 ] == n ) {
+        return( 0 );
+    }
+    for( int len = 1 ; len <= OTAINFLATE_MAX_BITS ; len++ ) {
+        left <<= 1;
+        left -= count[ len ];
+        if ( left < 0 ) {
+            return( left );
+        }
+    }
+    offs[ 1 ] = 0;
+    for( int len = 1 ; len < OTAINFLATE_MAX_BITS ; len++ ) {
+        offs[ len + 1 ] = offs[ len ] + count[ len ];
+    }
+    for( int sym = 0 ; sym < n ; sym++ ) {
+        if ( length[ sym ] ) {
+            symbol[ offs[ length[ sym ] ]++ ] = sym;
+        }
+    }
+    return( left );
+}
+
+static bool otainflate_block( otainflate_t *inflate ) {
+    uint8_t length[ 288 ];
+
+    inflate->last_block = otainflate_bits( inflate, 1 );
+    switch( otainflate_bits( inflate, 2 ) ) {
+        case 0:
+            // stored, LEN and NLEN start at a byte boundary
+            inflate->bitbuf = 0;
+            inflate->bitcnt = 0;
+            inflate->left = otainflate_bits( inflate, 16 );
+            if ( ( otainflate_bits( inflate, 16 ) ^ 0xffff ) != inflate->left ) {
+                return( otainflate_fail( inflate, "stored block length mismatch" ) );
+            }
+            inflate->state = OTAINFLATE_STATE_STORED;
+            return( true );
+        case 1:
+            memset( length, 8, 144 );
+            memset( length + 144, 9, 112 );
+            memset( length + 256, 7, 24 );
+            memset( length + 280, 8, 8 );
+            otainflate_construct( inflate->len_count, inflate->len_symbol, length, 288 );
+            memset( length, 5, 30 );
+            otainflate_construct( inflate->dist_count, inflate->dist_symbol, length, 30 );
+            inflate->state = OTAINFLATE_STATE_CODES;
+            return( true );
+        case 2:
+            if ( !otainflate_dynamic( inflate ) ) {
+                return( false );
+            }
+            inflate->state = OTAINFLATE_STATE_CODES;
+            return( true );
+        default:
+            return( otainflate_fail( inflate, "invalid block type" ) );
+    }
+}
+
+static bool otainflate_dynamic( otainflate_t *inflate ) {
+    uint8_t length[ 286 + 30 ];
+    int nlen = otainflate_bits( inflate, 5 ) + 257;
+    int ndist = otainflate_bits( inflate, 5 ) + 1;
+    int ncode = otainflate_bits( inflate, 4 ) + 4;
+    int index;
+    int err;
+
+    if ( nlen > 286 || ndist > 30 ) {
+        return( otainflate_fail( inflate, "bad code lengths" ) );
+    }
+
+    memset( length, 0, 19 );
+    for( index = 0 ; index < ncode ; index++ ) {
+        length[ otainflate_code_order[ index ] ] = otainflate_bits( inflate, 3 );
+    }
+    // the code length code is build in the literal/length table
+    if ( otainflate_construct( inflate->len_count, inflate->len_symbol, length, 19 ) != 0 ) {
+        return( otainflate_fail( inflate, "bad code lengths" ) );
+    }
+
+    index = 0;
+    while( index < nlen + ndist ) {
+        int symbol = otainflate_decode( inflate, inflate->len_count, inflate->len_symbol );
+        int repeat;
+        uint8_t len = 0;
+
+        if ( symbol < 0 ) {
+            return( otainflate_fail( inflate, "bad code lengths" ) );
+        }
+        if ( symbol < 16 ) {
+            length[ index++ ] = symbol;
+            continue;
+        }
+        if ( symbol == 16 ) {
+            if ( index == 0 ) {
+                return( otainflate_fail( inflate, "bad code lengths" ) );
+            }
+            len = length[ index - 1 ];
+            repeat = 3 + otainflate_bits( inflate, 2 );
+        }
+        else if ( symbol == 17 ) {
+            repeat = 3 + otainflate_bits( inflate, 3 );
+        }
+        else {
+            repeat = 11 + otainflate_bits( inflate, 7 );
+        }
+        if ( index + repeat > nlen + ndist ) {
+            return( otainflate_fail( inflate, "bad code lengths" ) );
+        }
+        while( repeat-- ) {
+            length[ index++ ] = len;
+        }
+    }
+
+    if ( length[ 256 ] == 0 ) {
+        return( otainflate_fail( inflate, "no end of block code" ) );
+    }
+    // only a single code may be incomplete
+    err = otainflate_construct( inflate->len_count, inflate->len_symbol, length, nlen );
+    if ( err < 0 || ( err > 0 && nlen - inflate->len_count[ 0 ] != 1 ) ) {
+        return( otainflate_fail( inflate, "bad literal/length code" ) );
+    }
+    err = otainflate_construct( inflate->dist_count, inflate->dist_symbol, length + nlen, ndist );
+    if ( err < 0 || ( err > 0 && ndist - inflate->dist_count[ 0 ] != 1 ) ) {
+        return( otainflate_fail( inflate, "bad distance code" ) );
+    }
+    return( true );
+}
+
+/*
+ * decode literals and matches until the end of the block or the buffered input
+ */
+static bool otainflate_codes( otainflate_t *inflate ) {
+    while( otainflate_ready( inflate, OTAINFLATE_CODE_BITS ) ) {
+        int symbol = otainflate_decode( inflate, inflate->len_count, inflate->len_symbol );
+
+        if ( symbol < 0 || inflate->overrun ) {
+            return( otainflate_fail( inflate, inflate->overrun ? "gzip stream truncated" : "bad literal/length code" ) );
+        }
+        if ( symbol < 256 ) {
+            if ( !otainflate_put( inflate, symbol ) ) {
+                return( false );
+            }
+            continue;
+        }
+        if ( symbol == 256 ) {
+            inflate->state = OTAINFLATE_STATE_BLOCK;
+            return( true );
+        }
+
+        symbol -= 257;
+        if ( symbol >= 29 ) {
+            return( otainflate_fail( inflate, "bad length symbol" ) );
+        }
+        uint32_t len = otainflate_len_base[ symbol ] + otainflate_bits( inflate, otainflate_len_extra[ symbol ] );
+        symbol = otainflate_decode( inflate, inflate->dist_count, inflate->dist_symbol );
+        if ( symbol < 0 || symbol >= 30 ) {
+            return( otainflate_fail( inflate, "bad distance symbol" ) );
+        }
+        uint32_t dist = otainflate_dist_base[ symbol ] + otainflate_bits( inflate, otainflate_dist_extra[ symbol ] );
+        if ( inflate->overrun ) {
+            return( otainflate_fail( inflate, "gzip stream truncated" ) );
+        }
+        if ( dist > inflate->total_out || dist > OTAINFLATE_WINDOW_SIZE ) {
+            return( otainflate_fail( inflate, "distance too far back" ) );
+        }
+        while( len-- ) {
+            if ( !otainflate_put( inflate, inflate->window[ ( inflate->window_pos - dist ) & ( OTAINFLATE_WINDOW_SIZE - 1 ) ] ) ) {
+                return( false );
+            }
+        }
+    }
+    return( true );
+}
+
+static bool otainflate_put( otainflate_t *inflate, uint8_t byte ) {
+    inflate->window[ inflate->window_pos++ ] = byte;
+    inflate->total_out++;
+    if ( inflate->window_pos == OTAINFLATE_WINDOW_SIZE ) {
+        if ( !otainflate_flush( inflate ) ) {
+            return( false );
+        }
+        inflate->window_pos = 0;
+        inflate->flushed = 0;
+    }
+    return( true );
+}
+
+/*
+ * write the new part of the window and update the crc32
+ */
+static bool otainflate_flush( otainflate_t *inflate ) {
+    uint32_t crc = inflate->crc;
+
+    if ( inflate->flushed == inflate->window_pos ) {
+        return( true );
+    }
+    for( uint32_t i = inflate->flushed ; i < inflate->window_pos ; i++ ) {
+        crc ^= inflate->window[ i ];
+        crc = ( crc >> 4 ) ^ otainflate_crc_table[ crc & 15 ];
+        crc = ( crc >> 4 ) ^ otainflate_crc_table[ crc & 15 ];
+    }
+    inflate->crc = crc;
+    if ( !inflate->write_cb( inflate->window + inflate->flushed, inflate->window_pos - inflate->flushed ) ) {
+        return( otainflate_fail( inflate, "write failed" ) );
+    }
+    inflate->flushed = inflate->window_pos;
+    return( true );
+}
+
+/*
+ * the optional gzip header fields in their order, each flag is cleared when its field is done
+ */
+static void otainflate_next_header( otainflate_t *inflate ) {
+    if ( inflate->flags & OTAINFLATE_FEXTRA ) {
+        inflate->state = OTAINFLATE_STATE_EXTRA_LEN;
+    }
+    else if ( inflate->flags & OTAINFLATE_FNAME ) {
+        inflate->state = OTAINFLATE_STATE_NAME;
+    }
+    else if ( inflate->flags & OTAINFLATE_FCOMMENT ) {
+        inflate->state = OTAINFLATE_STATE_COMMENT;
+    }
+    else if ( inflate->flags & OTAINFLATE_FHCRC ) {
+        inflate->state = OTAINFLATE_STATE_HCRC;
+    }
+    else {
+        inflate->state = OTAINFLATE_STATE_BLOCK;
+    }
+}
@@ -0,0 +1,105 @@
+/****************************************************************************
+ *   Sep 11 18:42:10 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _OTAINFLATE_H
+    #define _OTAINFLATE_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    /*
+     * streaming gzip decoder (RFC 1951/1952) for compressed update images, the
+     * input can be split at any byte. the output is collected in the 32k window
+     * that deflate needs anyway and written out when it is full
+     */
+    #define OTAINFLATE_WINDOW_SIZE      32768       /** @brief max distance of a deflate match */
+    #define OTAINFLATE_INPUT_SIZE       1024        /** @brief input collected until one step can be decoded */
+
+    typedef struct otainflate_t otainflate_t;
+
+    /*
+     * @brief write the next part of the decompressed data
+     *
+     * @return  true if successful
+     */
+    typedef bool ( * OTAINFLATE_WRITE_FUNC ) ( const uint8_t *data, size_t len );
+
+    struct otainflate_t {
+        OTAINFLATE_WRITE_FUNC write_cb;
+        uint8_t state;
+        uint8_t flags;                              /** @brief gzip header flags */
+        bool last_block;
+        bool finishing;                             /** @brief no more input will follow */
+        bool overrun;                               /** @brief a step has read beyond the input */
+        uint32_t bitbuf;
+        uint8_t bitcnt;
+        uint16_t in_pos;
+        uint16_t in_len;
+        uint32_t left;                              /** @brief bytes left in a stored block or gzip extra field */
+        uint16_t len_count[ 16 ];                   /** @brief canonical huffman tables of the current block */
+        uint16_t len_symbol[ 288 ];
+        uint16_t dist_count[ 16 ];
+        uint16_t dist_symbol[ 30 ];
+        uint32_t crc;
+        uint32_t total_out;
+        uint32_t window_pos;
+        uint32_t flushed;                           /** @brief window position up to the data is written */
+        const char *error;                          /** @brief reason of a fail or NULL */
+        uint8_t in[ OTAINFLATE_INPUT_SIZE ];
+        uint8_t window[ OTAINFLATE_WINDOW_SIZE ];
+    };
+
+    /*
+     * @brief check if data starts with a gzip header
+     *
+     * @param   data        pointer to the first bytes
+     * @param   len         number of bytes
+     *
+     * @return  true if it is gzip compressed
+     */
+    bool otainflate_is_gzip( const uint8_t *data, size_t len );
+    /*
+     * @brief prepare a decoder for a new gzip stream
+     *
+     * @param   inflate     pointer to the decoder state
+     * @param   write_cb    write the decompressed data
+     */
+    void otainflate_init( otainflate_t *inflate, OTAINFLATE_WRITE_FUNC write_cb );
+    /*
+     * @brief decompress the next part of the stream
+     *
+     * @param   inflate     pointer to the decoder state
+     * @param   data        pointer to the compressed data
+     * @param   len         length of the compressed data
+     *
+     * @return  false if the stream is broken or write_cb failed, see inflate->error
+     */
+    bool otainflate_feed( otainflate_t *inflate, const uint8_t *data, size_t len );
+    /*
+     * @brief decode the rest and check the gzip trailer
+     *
+     * @param   inflate     pointer to the decoder state
+     *
+     * @return  true if the stream was complete and crc32 and size match
+     */
+    bool otainflate_finish( otainflate_t *inflate );
+
+#endif // _OTAINFLATE_H
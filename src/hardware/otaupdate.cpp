@@ -0,0 +1,690 @@
+/****************************************************************************
+ *   Sep 08 19:36:12 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include <Update.h>
+#include "mbedtls/sha256.h"
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "esp_image_format.h"
+
+#include "otaupdate.h"
+#include "otadelta.h"
+#include "otainflate.h"
+
+/*
+ * one buffer is filled by otaupdate_write while the other one waits in
+ * otaupdate_full_queue for the writer task. a chunk with data == NULL
+ * stops the writer task
+ */
+typedef struct {
+    uint8_t *data;
+    size_t len;
+} otaupdate_chunk_t;
+
+portMUX_TYPE otaupdateMux = portMUX_INITIALIZER_UNLOCKED;
+
+static bool otaupdate_running = false;
+static volatile bool otaupdate_failed = false;
+static char otaupdate_error[ 64 ] = "";
+static char otaupdate_sha256[ OTAUPDATE_SHA256_LEN + 1 ] = "";
+static mbedtls_sha256_context otaupdate_sha256_ctx;
+static int otaupdate_command = U_FLASH;
+static bool otaupdate_first_chunk = true;
+static bool otaupdate_first_payload = true;
+
+/*
+ * the image is written straight into the partition, one sector is erased
+ * before the first write into it. so an update can continue at any sector
+ */
+static const esp_partition_t *otaupdate_partition = NULL;
+static size_t otaupdate_flash_offset = 0;
+
+/*
+ * a delta patch is detected by the magic in the first chunk, the new image
+ * is build from the running partition and the patch
+ */
+static otadelta_t *otaupdate_delta = NULL;
+static mbedtls_sha256_context otaupdate_image_sha256_ctx;
+
+/*
+ * a gzip compressed image is detected by the magic in the first chunk and
+ * decompressed in front of the delta patch or flash write
+ */
+static otainflate_t *otaupdate_inflate = NULL;
+
+static uint8_t *otaupdate_buffer[ 2 ] = { NULL, NULL };
+static otaupdate_chunk_t otaupdate_fill;
+static QueueHandle_t otaupdate_full_queue = NULL;
+static QueueHandle_t otaupdate_free_queue = NULL;
+static SemaphoreHandle_t otaupdate_writer_done = NULL;
+static TaskHandle_t _otaupdate_Task = NULL;
+
+static size_t otaupdate_written = 0;
+static size_t otaupdate_total = 0;
+static size_t otaupdate_next_progress = 0;
+static uint32_t otaupdate_start_time = 0;
+
+otaupdate_event_cb_t *otaupdate_event_cb_table = NULL;
+uint32_t otaupdate_event_cb_entrys = 0;
+
+static void otaupdate_send_event_cb( EventBits_t event, const char *msg );
+static void otaupdate_set_error( const char *msg );
+static bool otaupdate_start( int command, size_t offset, size_t total, const char *sha256, const char *written_sha256 );
+static void otaupdate_fail( void );
+static bool otaupdate_hash_flash( mbedtls_sha256_context *ctx, size_t len, char *hex );
+static void otaupdate_hex( const uint8_t *digest, char *hex );
+static void otaupdate_stop_writer( void );
+static void otaupdate_cleanup( void );
+static void otaupdate_Task( void * pvParameters );
+static bool otaupdate_payload_write( const uint8_t *data, size_t len );
+static bool otaupdate_flash_write( const uint8_t *data, size_t len );
+static void otaupdate_inflate_begin( void );
+static void otaupdate_delta_begin( void );
+static bool otaupdate_delta_read( size_t offset, uint8_t *data, size_t len );
+static bool otaupdate_delta_header( otadelta_t *delta );
+
+void otaupdate_register_cb( EventBits_t event, OTAUPDATE_CALLBACK_FUNC callback_func ) {
+    otaupdate_event_cb_entrys++;
+
+    if ( otaupdate_event_cb_table == NULL ) {
+        otaupdate_event_cb_table = ( otaupdate_event_cb_t * )ps_malloc( sizeof( otaupdate_event_cb_t ) * otaupdate_event_cb_entrys );
+        if ( otaupdate_event_cb_table == NULL ) {
+            log_e("otaupdate_event_cb_table malloc faild");
+            while(true);
+        }
+    }
+    else {
+        otaupdate_event_cb_t *new_otaupdate_event_cb_table = NULL;
+
+        new_otaupdate_event_cb_table = ( otaupdate_event_cb_t * )ps_realloc( otaupdate_event_cb_table, sizeof( otaupdate_event_cb_t ) * otaupdate_event_cb_entrys );
+        if ( new_otaupdate_event_cb_table == NULL ) {
+            log_e("otaupdate_event_cb_table realloc faild");
+            while(true);
+        }
+        otaupdate_event_cb_table = new_otaupdate_event_cb_table;
+    }
+
+    otaupdate_event_cb_table[ otaupdate_event_cb_entrys - 1 ].event = event;
+    otaupdate_event_cb_table[ otaupdate_event_cb_entrys - 1 ].event_cb = callback_func;
+    log_i("register otaupdate_event_cb success (%p)", otaupdate_event_cb_table[ otaupdate_event_cb_entrys - 1 ].event_cb );
+}
+
+static void otaupdate_send_event_cb( EventBits_t event, const char *msg ) {
+    for ( int entry = 0 ; entry < otaupdate_event_cb_entrys ; entry++ ) {
+        if ( event & otaupdate_event_cb_table[ entry ].event ) {
+            otaupdate_event_cb_table[ entry ].event_cb( event, otaupdate_written, otaupdate_total, msg );
+        }
+    }
+}
+
+/*
+ * the first error wins, later errors are only a result of it
+ */
+static void otaupdate_set_error( const char *msg ) {
+    portENTER_CRITICAL( &otaupdateMux );
+    if ( otaupdate_failed ) {
+        portEXIT_CRITICAL( &otaupdateMux );
+        return;
+    }
+    otaupdate_failed = true;
+    strlcpy( otaupdate_error, msg, sizeof( otaupdate_error ) );
+    portEXIT_CRITICAL( &otaupdateMux );
+    log_e("update failed: %s", msg );
+}
+
+bool otaupdate_begin( int command, size_t total, const char *sha256 ) {
+    return( otaupdate_start( command, 0, total, sha256, NULL ) );
+}
+
+bool otaupdate_resume( int command, size_t offset, size_t total, const char *sha256, const char *written_sha256 ) {
+    return( otaupdate_start( command, offset, total, sha256, written_sha256 ) );
+}
+
+static bool otaupdate_start( int command, size_t offset, size_t total, const char *sha256, const char *written_sha256 ) {
+    portENTER_CRITICAL( &otaupdateMux );
+    if ( otaupdate_running ) {
+        portEXIT_CRITICAL( &otaupdateMux );
+        log_e("update already running");
+        return( false );
+    }
+    otaupdate_running = true;
+    otaupdate_failed = false;
+    otaupdate_error[ 0 ] = '\0';
+    portEXIT_CRITICAL( &otaupdateMux );
+
+    otaupdate_written = offset;
+    otaupdate_flash_offset = offset;
+    otaupdate_total = total;
+    otaupdate_command = command;
+    otaupdate_first_chunk = ( offset == 0 );
+    otaupdate_first_payload = ( offset == 0 );
+    otaupdate_next_progress = offset + OTAUPDATE_PROGRESS_STEP;
+    otaupdate_start_time = millis();
+
+    if ( sha256 && *sha256 ) {
+        if ( strlen( sha256 ) != OTAUPDATE_SHA256_LEN ) {
+            otaupdate_set_error("sha256 must be 64 hex digits");
+            otaupdate_fail();
+            return( false );
+        }
+        strlcpy( otaupdate_sha256, sha256, sizeof( otaupdate_sha256 ) );
+    }
+    else {
+        otaupdate_sha256[ 0 ] = '\0';
+    }
+
+    if ( command == U_FLASH ) {
+        otaupdate_partition = esp_ota_get_next_update_partition( NULL );
+    }
+    else {
+        otaupdate_partition = esp_partition_find_first( ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, NULL );
+    }
+    if ( otaupdate_partition == NULL ) {
+        otaupdate_set_error("no partition for the update");
+        otaupdate_fail();
+        return( false );
+    }
+    if ( total > otaupdate_partition->size || offset > otaupdate_partition->size || offset % OTAUPDATE_SECTOR_SIZE ) {
+        otaupdate_set_error("image does not fit the partition");
+        otaupdate_fail();
+        return( false );
+    }
+
+    otaupdate_buffer[ 0 ] = (uint8_t *)ps_malloc( OTAUPDATE_BUFFER_SIZE );
+    otaupdate_buffer[ 1 ] = (uint8_t *)ps_malloc( OTAUPDATE_BUFFER_SIZE );
+    otaupdate_full_queue = xQueueCreate( 3, sizeof( otaupdate_chunk_t ) );
+    otaupdate_free_queue = xQueueCreate( 2, sizeof( otaupdate_chunk_t ) );
+    otaupdate_writer_done = xSemaphoreCreateBinary();
+    if ( otaupdate_buffer[ 0 ] == NULL || otaupdate_buffer[ 1 ] == NULL || otaupdate_full_queue == NULL || otaupdate_free_queue == NULL || otaupdate_writer_done == NULL ) {
+        log_e("otaupdate malloc faild");
+        while(true);
+    }
+
+    otaupdate_chunk_t chunk = { otaupdate_buffer[ 1 ], 0 };
+    xQueueSend( otaupdate_free_queue, &chunk, 0 );
+    otaupdate_fill.data = otaupdate_buffer[ 0 ];
+    otaupdate_fill.len = 0;
+
+    mbedtls_sha256_init( &otaupdate_sha256_ctx );
+    mbedtls_sha256_starts_ret( &otaupdate_sha256_ctx, 0 );
+
+    /*
+     * the part written before the suspend is hashed again from flash, if
+     * something else has written the partition in the meantime it is lost
+     */
+    if ( offset ) {
+        char hex[ OTAUPDATE_SHA256_LEN + 1 ];
+
+        if ( !written_sha256 || !otaupdate_hash_flash( &otaupdate_sha256_ctx, offset, hex ) || strcasecmp( hex, written_sha256 ) ) {
+            mbedtls_sha256_free( &otaupdate_sha256_ctx );
+            otaupdate_set_error("written part has changed");
+            otaupdate_fail();
+            return( false );
+        }
+    }
+
+    xTaskCreate(    otaupdate_Task,             /* Function to implement the task */
+                    "otaupdate Task",           /* Name of the task */
+                    3000,                       /* Stack size in words */
+                    NULL,                       /* Task input parameter */
+                    2,                          /* Priority of the task */
+                    &_otaupdate_Task );         /* Task handle. */
+
+    log_i("update %s at %d, %d bytes, sha256 %s", offset ? "resumed" : "started", offset, total, otaupdate_sha256[ 0 ] ? otaupdate_sha256 : "not checked" );
+    otaupdate_send_event_cb( OTAUPDATE_START, offset ? "resume" : "start" );
+    return( true );
+}
+
+bool otaupdate_write( const uint8_t *data, size_t len ) {
+    while ( len > 0 ) {
+        if ( otaupdate_failed ) {
+            return( false );
+        }
+
+        size_t part = OTAUPDATE_BUFFER_SIZE - otaupdate_fill.len;
+        if ( part > len ) {
+            part = len;
+        }
+        memcpy( otaupdate_fill.data + otaupdate_fill.len, data, part );
+        otaupdate_fill.len += part;
+        data += part;
+        len -= part;
+
+        if ( otaupdate_fill.len == OTAUPDATE_BUFFER_SIZE ) {
+            xQueueSend( otaupdate_full_queue, &otaupdate_fill, portMAX_DELAY );
+            /*
+             * wait until the writer task has finished the other buffer
+             */
+            if ( xQueueReceive( otaupdate_free_queue, &otaupdate_fill, OTAUPDATE_WRITE_TIMEOUT / portTICK_PERIOD_MS ) != pdTRUE ) {
+                otaupdate_fill.data = NULL;
+                otaupdate_fill.len = 0;
+                otaupdate_set_error("flash write timeout");
+                return( false );
+            }
+            otaupdate_fill.len = 0;
+        }
+    }
+    return( !otaupdate_failed );
+}
+
+bool otaupdate_end( void ) {
+    uint8_t digest[ 32 ];
+    char hex[ OTAUPDATE_SHA256_LEN + 1 ];
+
+    if ( otaupdate_fill.data && otaupdate_fill.len ) {
+        xQueueSend( otaupdate_full_queue, &otaupdate_fill, portMAX_DELAY );
+    }
+    otaupdate_stop_writer();
+
+    mbedtls_sha256_finish_ret( &otaupdate_sha256_ctx, digest );
+    mbedtls_sha256_free( &otaupdate_sha256_ctx );
+    otaupdate_hex( digest, hex );
+
+    if ( !otaupdate_failed && otaupdate_sha256[ 0 ] && strcasecmp( hex, otaupdate_sha256 ) ) {
+        log_e("sha256 is %s, expected %s", hex, otaupdate_sha256 );
+        otaupdate_set_error("sha256 mismatch");
+    }
+    /*
+     * the rest of the compressed stream is written before the patch is checked
+     */
+    if ( !otaupdate_failed && otaupdate_inflate ) {
+        if ( !otainflate_finish( otaupdate_inflate ) ) {
+            otaupdate_set_error( otaupdate_inflate->error );
+        }
+        else {
+            log_i("gzip image, %d bytes received, %d bytes decompressed", otaupdate_written, otaupdate_inflate->total_out );
+        }
+    }
+    /*
+     * a patch must be complete and give exactly the image it was made for
+     */
+    if ( !otaupdate_failed && otaupdate_delta ) {
+        if ( !otadelta_finish( otaupdate_delta ) ) {
+            otaupdate_set_error( otaupdate_delta->error );
+        }
+        else {
+            mbedtls_sha256_finish_ret( &otaupdate_image_sha256_ctx, digest );
+            if ( memcmp( digest, otaupdate_delta->new_sha256, sizeof( digest ) ) ) {
+                otaupdate_set_error("patched image sha256 mismatch");
+            }
+        }
+    }
+    if ( !otaupdate_failed && otaupdate_flash_offset == 0 ) {
+        otaupdate_set_error("no data");
+    }
+    /*
+     * the new image is only activated if everything is fine, the bootloader
+     * checks the image again before it is marked as boot partition
+     */
+    if ( !otaupdate_failed && otaupdate_command == U_FLASH ) {
+        esp_err_t err = esp_ota_set_boot_partition( otaupdate_partition );
+        if ( err != ESP_OK ) {
+            otaupdate_set_error( esp_err_to_name( err ) );
+        }
+    }
+
+    if ( otaupdate_failed ) {
+        otaupdate_fail();
+        return( false );
+    }
+
+    uint32_t duration = millis() - otaupdate_start_time;
+    log_i("update done, %d bytes in %dms (%d kB/s), sha256 %s", otaupdate_written, duration, duration ? otaupdate_written / duration : 0, hex );
+    otaupdate_send_event_cb( OTAUPDATE_DONE, hex );
+    otaupdate_cleanup();
+    return( true );
+}
+
+void otaupdate_abort( void ) {
+    if ( !otaupdate_is_running() ) {
+        return;
+    }
+    otaupdate_set_error("aborted");
+    otaupdate_stop_writer();
+    mbedtls_sha256_free( &otaupdate_sha256_ctx );
+    otaupdate_fail();
+}
+
+size_t otaupdate_suspend( char *written_sha256 ) {
+    mbedtls_sha256_context written_sha256_ctx;
+
+    if ( !otaupdate_is_running() ) {
+        return( 0 );
+    }
+    if ( otaupdate_fill.data && otaupdate_fill.len ) {
+        xQueueSend( otaupdate_full_queue, &otaupdate_fill, portMAX_DELAY );
+        otaupdate_fill.data = NULL;
+    }
+    otaupdate_stop_writer();
+    mbedtls_sha256_free( &otaupdate_sha256_ctx );
+
+    /*
+     * the state of a patch is not saved, a patch is small enough to start again
+     */
+    if ( otaupdate_delta ) {
+        otaupdate_set_error("a delta patch can not be resumed");
+    }
+    /*
+     * the decoder needs the last 32k of output, the received part does not
+     * end at a point where it could start again
+     */
+    if ( otaupdate_inflate ) {
+        otaupdate_set_error("a compressed image can not be resumed");
+    }
+    if ( otaupdate_failed ) {
+        otaupdate_fail();
+        return( 0 );
+    }
+
+    /*
+     * the last sector may be incomplete, it is erased and written again on resume
+     */
+    size_t offset = otaupdate_flash_offset - otaupdate_flash_offset % OTAUPDATE_SECTOR_SIZE;
+    mbedtls_sha256_init( &written_sha256_ctx );
+    mbedtls_sha256_starts_ret( &written_sha256_ctx, 0 );
+    bool retval = otaupdate_hash_flash( &written_sha256_ctx, offset, written_sha256 );
+    mbedtls_sha256_free( &written_sha256_ctx );
+    if ( !retval ) {
+        otaupdate_set_error("flash read failed");
+        otaupdate_fail();
+        return( 0 );
+    }
+
+    otaupdate_written = offset;
+    log_i("update suspended at %d, sha256 %s", offset, written_sha256 );
+    otaupdate_send_event_cb( OTAUPDATE_SUSPEND, written_sha256 );
+    otaupdate_cleanup();
+    return( offset );
+}
+
+bool otaupdate_is_running( void ) {
+    portENTER_CRITICAL( &otaupdateMux );
+    bool running = otaupdate_running;
+    portEXIT_CRITICAL( &otaupdateMux );
+    return( running );
+}
+
+const char *otaupdate_get_error( void ) {
+    return( otaupdate_error );
+}
+
+/*
+ * send the stop chunk and wait until the writer task has written all queued buffers
+ */
+static void otaupdate_stop_writer( void ) {
+    otaupdate_chunk_t chunk = { NULL, 0 };
+
+    if ( _otaupdate_Task == NULL ) {
+        return;
+    }
+    xQueueSend( otaupdate_full_queue, &chunk, portMAX_DELAY );
+    xSemaphoreTake( otaupdate_writer_done, portMAX_DELAY );
+    _otaupdate_Task = NULL;
+}
+
+/*
+ * send the fail event and release the update
+ */
+static void otaupdate_fail( void ) {
+    otaupdate_send_event_cb( OTAUPDATE_FAIL, otaupdate_error );
+    otaupdate_cleanup();
+}
+
+/*
+ * hash the first len bytes of the update partition, the digest is
+ * written to hex if not NULL
+ */
+static bool otaupdate_hash_flash( mbedtls_sha256_context *ctx, size_t len, char *hex ) {
+    mbedtls_sha256_context copy;
+    uint8_t digest[ 32 ];
+    uint8_t buf[ 512 ];
+
+    for( size_t offset = 0 ; offset < len ; offset += sizeof( buf ) ) {
+        size_t part = len - offset > sizeof( buf ) ? sizeof( buf ) : len - offset;
+        if ( esp_partition_read( otaupdate_partition, offset, buf, part ) != ESP_OK ) {
+            return( false );
+        }
+        mbedtls_sha256_update_ret( ctx, buf, part );
+    }
+
+    if ( hex ) {
+        mbedtls_sha256_init( &copy );
+        mbedtls_sha256_clone( &copy, ctx );
+        mbedtls_sha256_finish_ret( &copy, digest );
+        mbedtls_sha256_free( &copy );
+        otaupdate_hex( digest, hex );
+    }
+    return( true );
+}
+
+static void otaupdate_hex( const uint8_t *digest, char *hex ) {
+    for( int i = 0 ; i < 32 ; i++ ) {
+        snprintf( &hex[ i * 2 ], 3, "%02x", digest[ i ] );
+    }
+}
+
+static void otaupdate_cleanup( void ) {
+    if ( otaupdate_full_queue ) {
+        vQueueDelete( otaupdate_full_queue );
+        otaupdate_full_queue = NULL;
+    }
+    if ( otaupdate_free_queue ) {
+        vQueueDelete( otaupdate_free_queue );
+        otaupdate_free_queue = NULL;
+    }
+    if ( otaupdate_writer_done ) {
+        vSemaphoreDelete( otaupdate_writer_done );
+        otaupdate_writer_done = NULL;
+    }
+    free( otaupdate_buffer[ 0 ] );
+    free( otaupdate_buffer[ 1 ] );
+    otaupdate_buffer[ 0 ] = NULL;
+    otaupdate_buffer[ 1 ] = NULL;
+    otaupdate_fill.data = NULL;
+    otaupdate_fill.len = 0;
+    if ( otaupdate_delta ) {
+        mbedtls_sha256_free( &otaupdate_image_sha256_ctx );
+        free( otaupdate_delta );
+        otaupdate_delta = NULL;
+    }
+    if ( otaupdate_inflate ) {
+        free( otaupdate_inflate );
+        otaupdate_inflate = NULL;
+    }
+
+    portENTER_CRITICAL( &otaupdateMux );
+    otaupdate_running = false;
+    portEXIT_CRITICAL( &otaupdateMux );
+}
+
+/*
+ * hash and write one buffer while the next one is received, after a fail
+ * the buffers are only returned so otaupdate_write never blocks forever
+ */
+static void otaupdate_Task( void * pvParameters ) {
+    otaupdate_chunk_t chunk;
+
+    while( true ) {
+        xQueueReceive( otaupdate_full_queue, &chunk, portMAX_DELAY );
+        if ( chunk.data == NULL ) {
+            break;
+        }
+
+        if ( !otaupdate_failed ) {
+            mbedtls_sha256_update_ret( &otaupdate_sha256_ctx, chunk.data, chunk.len );
+            if ( otaupdate_first_chunk ) {
+                otaupdate_first_chunk = false;
+                if ( otainflate_is_gzip( chunk.data, chunk.len ) ) {
+                    otaupdate_inflate_begin();
+                }
+            }
+            /*
+             * the first error wins, a failed write behind the decoder is already set
+             */
+            if ( otaupdate_inflate ) {
+                if ( !otainflate_feed( otaupdate_inflate, chunk.data, chunk.len ) ) {
+                    otaupdate_set_error( otaupdate_inflate->error );
+                }
+            }
+            else {
+                otaupdate_payload_write( chunk.data, chunk.len );
+            }
+            if ( !otaupdate_failed ) {
+                otaupdate_written += chunk.len;
+                if ( otaupdate_written >= otaupdate_next_progress ) {
+                    otaupdate_next_progress = otaupdate_written + OTAUPDATE_PROGRESS_STEP;
+                    otaupdate_send_event_cb( OTAUPDATE_PROGRESS, "progress" );
+                }
+            }
+        }
+
+        chunk.len = 0;
+        xQueueSend( otaupdate_free_queue, &chunk, portMAX_DELAY );
+    }
+
+    xSemaphoreGive( otaupdate_writer_done );
+    vTaskDelete( NULL );
+}
+
+/*
+ * the uncompressed update, a delta patch or the image itself
+ */
+static bool otaupdate_payload_write( const uint8_t *data, size_t len ) {
+    if ( otaupdate_first_payload && len ) {
+        otaupdate_first_payload = false;
+        if ( otadelta_is_delta( data, len ) ) {
+            otaupdate_delta_begin();
+        }
+    }
+    if ( otaupdate_failed ) {
+        return( false );
+    }
+    if ( otaupdate_delta ) {
+        if ( !otadelta_feed( otaupdate_delta, data, len ) ) {
+            otaupdate_set_error( otaupdate_delta->error );
+            return( false );
+        }
+        return( true );
+    }
+    return( otaupdate_flash_write( data, len ) );
+}
+
+/*
+ * write the next part of the new image, each sector is erased before the first
+ * write into it. a resumed update starts at a sector boundary
+ */
+static bool otaupdate_flash_write( const uint8_t *data, size_t len ) {
+    size_t erase_start = ( otaupdate_flash_offset + OTAUPDATE_SECTOR_SIZE - 1 ) / OTAUPDATE_SECTOR_SIZE * OTAUPDATE_SECTOR_SIZE;
+    size_t erase_end = ( otaupdate_flash_offset + len + OTAUPDATE_SECTOR_SIZE - 1 ) / OTAUPDATE_SECTOR_SIZE * OTAUPDATE_SECTOR_SIZE;
+
+    if ( len == 0 ) {
+        return( true );
+    }
+    if ( otaupdate_flash_offset + len > otaupdate_partition->size ) {
+        otaupdate_set_error("image does not fit the partition");
+        return( false );
+    }
+    if ( otaupdate_flash_offset == 0 && otaupdate_command == U_FLASH && data[ 0 ] != ESP_IMAGE_HEADER_MAGIC ) {
+        otaupdate_set_error("no firmware image");
+        return( false );
+    }
+    if ( erase_end > erase_start && esp_partition_erase_range( otaupdate_partition, erase_start, erase_end - erase_start ) != ESP_OK ) {
+        otaupdate_set_error("flash erase failed");
+        return( false );
+    }
+    if ( esp_partition_write( otaupdate_partition, otaupdate_flash_offset, data, len ) != ESP_OK ) {
+        otaupdate_set_error("flash write failed");
+        return( false );
+    }
+    otaupdate_flash_offset += len;
+    if ( otaupdate_delta ) {
+        mbedtls_sha256_update_ret( &otaupdate_image_sha256_ctx, data, len );
+    }
+    return( true );
+}
+
+static void otaupdate_delta_begin( void ) {
+    if ( otaupdate_command != U_FLASH ) {
+        otaupdate_set_error("delta patches are only for the firmware");
+        return;
+    }
+
+    otaupdate_delta = (otadelta_t *)ps_malloc( sizeof( otadelta_t ) );
+    if ( otaupdate_delta == NULL ) {
+        log_e("otaupdate_delta malloc faild");
+        while(true);
+    }
+    otadelta_init( otaupdate_delta, otaupdate_delta_read, otaupdate_flash_write, otaupdate_delta_header );
+    mbedtls_sha256_init( &otaupdate_image_sha256_ctx );
+    mbedtls_sha256_starts_ret( &otaupdate_image_sha256_ctx, 0 );
+    log_i("update is a delta patch");
+}
+
+static void otaupdate_inflate_begin( void ) {
+    otaupdate_inflate = (otainflate_t *)ps_malloc( sizeof( otainflate_t ) );
+    if ( otaupdate_inflate == NULL ) {
+        log_e("otaupdate_inflate malloc faild");
+        while(true);
+    }
+    otainflate_init( otaupdate_inflate, otaupdate_payload_write );
+    log_i("update is gzip compressed");
+}
+
+static bool otaupdate_delta_read( size_t offset, uint8_t *data, size_t len ) {
+    return( esp_partition_read( esp_ota_get_running_partition(), offset, data, len ) == ESP_OK );
+}
+
+/*
+ * the patch is only applied on the exact image it was made for, after a flash
+ * over serial esptool may have changed the image header and the full image is needed
+ */
+static bool otaupdate_delta_header( otadelta_t *delta ) {
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    mbedtls_sha256_context old_sha256_ctx;
+    uint8_t digest[ 32 ];
+    uint8_t buf[ 512 ];
+
+    if ( running == NULL || delta->old_size > running->size ) {
+        log_e("patch base is larger than the running partition");
+        return( false );
+    }
+
+    mbedtls_sha256_init( &old_sha256_ctx );
+    mbedtls_sha256_starts_ret( &old_sha256_ctx, 0 );
+    for( size_t offset = 0 ; offset < delta->old_size ; offset += sizeof( buf ) ) {
+        size_t len = delta->old_size - offset > sizeof( buf ) ? sizeof( buf ) : delta->old_size - offset;
+        if ( esp_partition_read( running, offset, buf, len ) != ESP_OK ) {
+            mbedtls_sha256_free( &old_sha256_ctx );
+            return( false );
+        }
+        mbedtls_sha256_update_ret( &old_sha256_ctx, buf, len );
+    }
+    mbedtls_sha256_finish_ret( &old_sha256_ctx, digest );
+    mbedtls_sha256_free( &old_sha256_ctx );
+
+    if ( memcmp( digest, delta->old_sha256, sizeof( digest ) ) ) {
+        log_e("running image is not the patch base");
+        return( false );
+    }
+    log_i("patch %d -> %d bytes", delta->old_size, delta->new_size );
+    return( true );
+}
@@ -0,0 +1,123 @@
+/****************************************************************************
+ *   Sep 08 19:36:12 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _OTAUPDATE_H
+    #define _OTAUPDATE_H
+
+    #include "TTGO.h"
+
+    #define OTAUPDATE_BUFFER_SIZE       8192        /** @brief size of each of the two receive buffers, a multiple of the flash sector size */
+    #define OTAUPDATE_WRITE_TIMEOUT     10000       /** @brief max time in ms to wait for a free buffer */
+    #define OTAUPDATE_PROGRESS_STEP     32768       /** @brief bytes between two OTAUPDATE_PROGRESS events */
+    #define OTAUPDATE_SHA256_LEN        64          /** @brief length of a sha256 as hex string */
+    #define OTAUPDATE_SECTOR_SIZE       4096        /** @brief flash sector size, a resumed update starts at a sector */
+
+    #define OTAUPDATE_START             _BV(0)      /** @brief an update was started */
+    #define OTAUPDATE_PROGRESS          _BV(1)      /** @brief more of the update was written, written counts the received bytes */
+    #define OTAUPDATE_DONE              _BV(2)      /** @brief the image is verified and activated */
+    #define OTAUPDATE_FAIL              _BV(3)      /** @brief the update failed or was aborted, msg is the reason */
+    #define OTAUPDATE_SUSPEND           _BV(4)      /** @brief the update was suspended, written is the offset to resume */
+
+    typedef void ( * OTAUPDATE_CALLBACK_FUNC ) ( EventBits_t event, size_t written, size_t total, const char *msg );
+
+    typedef struct {
+        EventBits_t event;
+        OTAUPDATE_CALLBACK_FUNC event_cb;
+    } otaupdate_event_cb_t;
+
+    /*
+     * @brief register an callback function for update events, the callbacks are called from the writer task
+     * or from the task that calls otaupdate_begin/end/abort, keep them short
+     *
+     * @param   event       possible values: OTAUPDATE_START, OTAUPDATE_PROGRESS, OTAUPDATE_DONE, OTAUPDATE_FAIL and OTAUPDATE_SUSPEND
+     * @param   callback_func   pointer to the callback function
+     */
+    void otaupdate_register_cb( EventBits_t event, OTAUPDATE_CALLBACK_FUNC callback_func );
+    /*
+     * @brief start an update. the data is collected in two buffers, while one is received
+     * the other one is hashed and written to flash by the writer task. a firmware update
+     * can also be a delta patch from tools/mkdelta.py, it is detected by the magic and
+     * applied on the running image. a gzip compressed image or patch is decompressed on
+     * the fly, the sha256 is the one of the compressed data
+     *
+     * @param   command     U_FLASH or U_SPIFFS
+     * @param   total       size of the image if known or 0, only used for progress events
+     * @param   sha256      expected sha256 of the received data as hex string or NULL to skip the check
+     *
+     * @return  true if the update was started, false if another update is running or the partition is not ready
+     */
+    bool otaupdate_begin( int command, size_t total, const char *sha256 );
+    /*
+     * @brief continue a suspended update. the written part is read back from flash, it must
+     * match the sha256 from otaupdate_suspend() and is included in the sha256 of the image
+     *
+     * @param   command     U_FLASH or U_SPIFFS
+     * @param   offset      offset from otaupdate_suspend(), the next otaupdate_write() starts there
+     * @param   total       size of the whole image if known or 0
+     * @param   sha256      expected sha256 of the whole image as hex string or NULL to skip the check
+     * @param   written_sha256  sha256 of the written part from otaupdate_suspend()
+     *
+     * @return  true if the update was resumed, false if the written part has changed or another update is running
+     */
+    bool otaupdate_resume( int command, size_t offset, size_t total, const char *sha256, const char *written_sha256 );
+    /*
+     * @brief feed the next part of the image, blocks while both buffers are in use
+     *
+     * @param   data        pointer to the data
+     * @param   len         length of the data
+     *
+     * @return  false if the update failed, the update must be closed with otaupdate_abort()
+     */
+    bool otaupdate_write( const uint8_t *data, size_t len );
+    /*
+     * @brief write the rest, compare the sha256 and activate the new image
+     *
+     * @return  true if the image was verified and activated, the device can be restarted
+     */
+    bool otaupdate_end( void );
+    /*
+     * @brief stop an update, the written part is dropped
+     */
+    void otaupdate_abort( void );
+    /*
+     * @brief stop an update but keep the written part for otaupdate_resume(), all data from
+     * otaupdate_write() is written first. a delta patch or a compressed image can not be
+     * resumed and is aborted
+     *
+     * @param   written_sha256  buffer for the sha256 of the written part, OTAUPDATE_SHA256_LEN + 1 bytes
+     *
+     * @return  offset to resume at, a multiple of OTAUPDATE_SECTOR_SIZE, or 0 if nothing can be kept
+     */
+    size_t otaupdate_suspend( char *written_sha256 );
+    /*
+     * @brief check if an update is running
+     *
+     * @return  true if running
+     */
+    bool otaupdate_is_running( void );
+    /*
+     * @brief get the reason of the last fail
+     *
+     * @return  error message or an empty string
+     */
+    const char *otaupdate_get_error( void );
+
+#endif // _OTAUPDATE_H
@@ -2,6 +2,7 @@
 #include <TTGO.h>
 #include <soc/rtc.h>
 #include "json_psram_allocator.h"
+#include "configapi.h"
 
 #include "display.h"
 #include "pmu.h"
@@ -16,10 +17,21 @@ EventGroupHandle_t pmu_event_handle = NULL;
 void IRAM_ATTR pmu_irq( void );
 pmu_config_t pmu_config;
 
+/*
+ * settings for /api/config
+ */
+static const configapi_field_t pmu_configapi_fields[] = {
+    CONFIGAPI_BOOL_FIELD( "silence_wakeup", []() -> bool { return( pmu_get_silence_wakeup() ); }, []( bool value ) { pmu_set_silence_wakeup( value ); } ),
+    CONFIGAPI_BOOL_FIELD( "compute_percent", []() -> bool { return( pmu_get_calculated_percent() ); }, []( bool value ) { pmu_set_calculated_percent( value ); } ),
+    CONFIGAPI_BOOL_FIELD( "experimental_power_save", []() -> bool { return( pmu_get_experimental_power_save() ); }, []( bool value ) { pmu_set_experimental_power_save( value ); } ),
+    CONFIGAPI_INT_FIELD( "designed_battery_cap", 0, INT32_MAX, 0, []() -> int32_t { return( pmu_get_designed_battery_cap() ); }, NULL ),
+};
+
 /*
  * init the pmu: AXP202 
  */
 void pmu_setup( void ) {
+    configapi_register( "pmu", pmu_configapi_fields, sizeof( pmu_configapi_fields ) / sizeof( configapi_field_t ), pmu_save_config );
     pmu_event_handle = xEventGroupCreate();
 
     pmu_read_config();
@@ -125,6 +137,9 @@ void pmu_wakeup( void ) {
  *
  */
 void pmu_save_config( void ) {
+    if ( configapi_defer_save( pmu_save_config ) ) {
+        return;
+    }
     if ( SPIFFS.exists( PMU_CONFIG_FILE ) ) {
         SPIFFS.remove( PMU_CONFIG_FILE );
         log_i("remove old binary pmu config");
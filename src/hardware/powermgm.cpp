@@ -31,7 +31,11 @@
 #include "bma.h"
 #include "powermgm.h"
 #include "wifictl.h"
+#include "httpctl.h"
 #include "blectl.h"
+#include "notifyctl.h"
+#include "notestore.h"
+#include "configapi.h"
 #include "timesync.h"
 #include "motor.h"
 #include "touch.h"
@@ -53,6 +57,7 @@ void powermgm_setup( void ) {
     pmu_setup();
     bma_setup();
     wifictl_setup();
+    httpctl_setup();
     blectl_read_config();
     timesync_setup();
     touch_setup();
@@ -167,12 +172,20 @@ void powermgm_loop( void ) {
         vTaskDelay( 100 );
         pmu_loop();
         bma_loop();
+        blectl_loop();
+        notifyctl_loop();
+        notestore_loop();
+        configapi_loop();
     }
     else {
         pmu_loop();
         bma_loop();
         display_loop();
         rtcctl_loop();
+        blectl_loop();
+        notifyctl_loop();
+        notestore_loop();
+        configapi_loop();
     }
 }
 
@@ -24,25 +24,41 @@
 
 #include "time.h"
 #include "wifictl.h"
+#include "blectl.h"
 #include "config.h"
 #include "timesync.h"
 #include "powermgm.h"
 #include "json_psram_allocator.h"
+#include "configapi.h"
 
 EventGroupHandle_t time_event_handle = NULL;
 TaskHandle_t _timesync_Task;
 void timesync_Task( void * pvParameters );
 
 timesync_config_t timesync_config;
+static uint32_t timesync_phone_time = 0;
+static bool timesync_phone = false;
 
 void timesync_wifictl_event_cb( EventBits_t event, char* msg );
+void timesync_blectl_event_cb( EventBits_t event, char* msg );
+
+/*
+ * settings for /api/config
+ */
+static const configapi_field_t timesync_configapi_fields[] = {
+    CONFIGAPI_BOOL_FIELD( "timesync", []() -> bool { return( timesync_get_timesync() ); }, []( bool value ) { timesync_set_timesync( value ); } ),
+    CONFIGAPI_BOOL_FIELD( "daylightsave", []() -> bool { return( timesync_get_daylightsave() ); }, []( bool value ) { timesync_set_daylightsave( value ); } ),
+    CONFIGAPI_INT_FIELD( "timezone", -12, 12, 0, []() -> int32_t { return( timesync_get_timezone() ); }, []( int32_t value ) { timesync_set_timezone( value ); } ),
+};
 
 void timesync_setup( void ) {
+    configapi_register( "timesync", timesync_configapi_fields, sizeof( timesync_configapi_fields ) / sizeof( configapi_field_t ), timesync_save_config );
 
     timesync_read_config();
     time_event_handle = xEventGroupCreate();
 
     wifictl_register_cb( WIFICTL_CONNECT, timesync_wifictl_event_cb );
+    blectl_register_cb( BLECTL_CMD, timesync_blectl_event_cb );
 }
 
 void timesync_wifictl_event_cb( EventBits_t event, char* msg ) {
@@ -50,6 +66,10 @@ void timesync_wifictl_event_cb( EventBits_t event, char* msg ) {
 
     switch ( event ) {
         case WIFICTL_CONNECT:       if ( timesync_config.timesync ) {
+                                        if ( timesync_get_phone_age() < TIMESYNC_PHONE_VALID ) {
+                                            log_i("time from the phone is %ds old, skip ntp", timesync_get_phone_age() / 1000 );
+                                            return;
+                                        }
                                         if ( xEventGroupGetBits( time_event_handle ) & TIME_SYNC_REQUEST ) {
                                             return;
                                         }
@@ -67,7 +87,24 @@ void timesync_wifictl_event_cb( EventBits_t event, char* msg ) {
     }
 }
 
+/*
+ * Gadgetbridge sends setTime() and E.setTimeZone() on every connect
+ */
+void timesync_blectl_event_cb( EventBits_t event, char* msg ) {
+    espruino_cmd_t cmd;
+
+    switch ( event ) {
+        case BLECTL_CMD:            if ( espruino_exec( msg, &cmd ) && timesync_config.timesync ) {
+                                        timesync_set_from_phone( &cmd );
+                                    }
+                                    break;
+    }
+}
+
 void timesync_save_config( void ) {
+    if ( configapi_defer_save( timesync_save_config ) ) {
+        return;
+    }
     if ( SPIFFS.exists( TIMESYNC_CONFIG_FILE ) ) {
         SPIFFS.remove( TIMESYNC_CONFIG_FILE );
         log_i("remove old binary timesync config");
@@ -166,6 +203,32 @@ void timesync_set_timezone( int32_t timezone ) {
     timesync_save_config();
 }
 
+void timesync_set_from_phone( espruino_cmd_t *cmd ) {
+    if ( cmd->found & ESPRUINO_TIMEZONE ) {
+        char tz[ 16 ];
+        espruino_tz( cmd->timezone, tz, sizeof( tz ) );
+        setenv( "TZ", tz, 1 );
+        tzset();
+        log_i("timezone from phone: %s", tz );
+    }
+    if ( cmd->found & ESPRUINO_TIME ) {
+        struct timeval now = { (time_t)cmd->time, (suseconds_t)cmd->time_ms * 1000 };
+        struct timeval old;
+
+        gettimeofday( &old, NULL );
+        settimeofday( &now, NULL );
+        timesync_phone_time = millis();
+        timesync_phone = true;
+        log_i("time from phone, %lds off", (long)( old.tv_sec - now.tv_sec ) );
+    }
+    // the rtc holds the local time
+    timesyncToRTC();
+}
+
+uint32_t timesync_get_phone_age( void ) {
+    return( timesync_phone ? millis() - timesync_phone_time : UINT32_MAX );
+}
+
 void timesyncToSystem( void ) {
   TTGOClass *ttgo = TTGOClass::getWatch();
   ttgo->rtc->syncToSystem();
@@ -23,11 +23,13 @@
     #define _TIME_SYNC_H
 
     #include <TTGO.h>
+    #include "espruino.h"
 
     #define TIME_SYNC_REQUEST       _BV(0)
 
     #define TIMESYNC_CONFIG_FILE        "/timesync.cfg"
     #define TIMESYNC_JSON_CONFIG_FILE   "/timesync.json"
+    #define TIMESYNC_PHONE_VALID        ( 24 * 60 * 60 * 1000 )     /** @brief ms a time from the phone makes ntp needless */
 
     typedef struct {
         bool timesync = true;
@@ -83,6 +85,18 @@
      * @param timezone  timezone from UTC-12 to UTC+12
      */
     void timesync_set_timezone( int32_t timezone );
+    /*
+     * @brief set system time, timezone and rtc from the phone
+     *
+     * @param   cmd     setTime() and E.setTimeZone() of an espruino command line
+     */
+    void timesync_set_from_phone( espruino_cmd_t *cmd );
+    /*
+     * @brief get the ms since the last time from the phone
+     *
+     * @return  ms or UINT32_MAX if there was none since boot
+     */
+    uint32_t timesync_get_phone_age( void );
     /*
      * @brief wrapper function to sync the system with rtc
      */
@@ -27,6 +27,7 @@
 
 #include "wifictl.h"
 #include "json_psram_allocator.h"
+#include "configapi.h"
 
 #include "gui/statusbar.h"
 #include "webserver/webserver.h"
@@ -61,6 +62,14 @@ void wifictl_save_config( void );
 void wifictl_load_config( void );
 void wifictl_Task( void * pvParameters );
 
+/*
+ * settings for /api/config
+ */
+static const configapi_field_t wifictl_configapi_fields[] = {
+    CONFIGAPI_BOOL_FIELD( "autoon", []() -> bool { return( wifictl_get_autoon() ); }, []( bool value ) { wifictl_set_autoon( value ); } ),
+    CONFIGAPI_BOOL_FIELD( "webserver", []() -> bool { return( wifictl_get_webserver() ); }, []( bool value ) { wifictl_set_webserver( value ); } ),
+};
+
 /*
  *
  */
@@ -68,6 +77,8 @@ void wifictl_setup( void ) {
     if ( wifi_init == true )
         return;
 
+    configapi_register( "wifictl", wifictl_configapi_fields, sizeof( wifictl_configapi_fields ) / sizeof( configapi_field_t ), wifictl_save_config );
+
     wifictl_status = xEventGroupCreate();
 
     wifi_init = true;
@@ -176,6 +187,9 @@ void wifictl_setup( void ) {
 }
 
 void wifictl_save_config( void ) {
+    if ( configapi_defer_save( wifictl_save_config ) ) {
+        return;
+    }
     if ( SPIFFS.exists( WIFICTL_CONFIG_FILE ) ) {
         SPIFFS.remove( WIFICTL_CONFIG_FILE );
         log_i("remove old binary wificfg config");
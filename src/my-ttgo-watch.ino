@@ -36,6 +36,9 @@
 #include "hardware/blectl.h"
 #include "hardware/pmu.h"
 #include "hardware/timesync.h"
+#include "hardware/metrics.h"
+#include "hardware/notestore.h"
+#include "hardware/notifyctl.h"
 
 #include "app/weather/weather.h"
 #include "app/stopwatch/stopwatch_app.h"
@@ -73,6 +76,9 @@ void setup()
     timesyncToSystem();
     splash_screen_stage_update( "init powermgm", 60 );
     powermgm_setup();
+    splash_screen_stage_update( "init notes", 70 );
+    notestore_setup();
+    notifyctl_setup();
     splash_screen_stage_update( "init gui", 80 );
     splash_screen_stage_finish();
     gui_setup(); 
@@ -93,6 +99,7 @@ void setup()
     // enable to store data in normal heap
     heap_caps_malloc_extmem_enable( 16*1024 );
     blectl_setup();
+    metrics_setup();
 
     display_set_brightness( display_get_brightness() );
 
@@ -109,6 +116,8 @@ void setup()
 void loop()
 {
     delay(5);
+    uint32_t loop_start = micros();
     gui_loop();
     powermgm_loop();
+    metrics_loop( micros() - loop_start );
 }
@@ -0,0 +1,333 @@
+/****************************************************************************
+ *   Sep 05 19:37:12 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include "screenmirror.h"
+#include "gui/screenshot.h"
+
+#ifdef SCREENSHOT_SHADOW_FRAMEBUFFER
+
+static AsyncWebSocket screenmirror_ws( SCREENMIRROR_URL );
+portMUX_TYPE screenmirrorMux = portMUX_INITIALIZER_UNLOCKED;
+TaskHandle_t _screenmirror_Task = NULL;
+
+static lv_area_t screenmirror_dirty[ SCREENMIRROR_MAX_DIRTY ];
+static uint32_t screenmirror_dirty_count = 0;
+static uint32_t screenmirror_client = 0;            /** @brief websocket client id of the viewer, 0 if none */
+static uint16_t screenmirror_seq = 0;               /** @brief last frame send */
+static uint16_t screenmirror_acked = 0;             /** @brief last frame acknowledged by the viewer */
+static uint16_t screenmirror_skipped = 0;           /** @brief frames merged while the viewer is behind */
+static uint32_t screenmirror_ack_time = 0;
+
+static uint16_t *screenmirror_pixels = NULL;        /** @brief one band of pixels copied from the shadow framebuffer */
+static uint8_t *screenmirror_msg = NULL;            /** @brief one encoded message */
+
+static void screenmirror_event_cb( AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len );
+static void screenmirror_flush_cb( const lv_area_t *area );
+static void screenmirror_add_dirty( const lv_area_t *area );
+static bool screenmirror_send_area( uint32_t client_id, const lv_area_t *area, uint16_t seq, uint16_t skipped, bool last );
+static size_t screenmirror_rle_encode( uint8_t *dest, const uint16_t *pixels, size_t count );
+void screenmirror_Task( void * pvParameters );
+
+void screenmirror_setup( AsyncWebServer *server ) {
+    /*
+     * asyncwebserver_start is called on every wifi connect, add the handler only once
+     */
+    if ( screenmirror_msg != NULL ) {
+        return;
+    }
+
+    screenmirror_pixels = (uint16_t *)ps_malloc( lv_disp_get_hor_res( NULL ) * SCREENMIRROR_BAND_HEIGHT * sizeof( uint16_t ) );
+    screenmirror_msg = (uint8_t *)ps_malloc( SCREENMIRROR_HEADER_SIZE + lv_disp_get_hor_res( NULL ) * SCREENMIRROR_BAND_HEIGHT * 3 );
+    if ( screenmirror_pixels == NULL || screenmirror_msg == NULL ) {
+        log_e("screenmirror malloc faild");
+        while(true);
+    }
+
+    screenmirror_ws.onEvent( screenmirror_event_cb );
+    server->addHandler( &screenmirror_ws );
+}
+
+static void screenmirror_event_cb( AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len ) {
+    AwsFrameInfo *info;
+    lv_area_t screen;
+    char msg[ 16 ];
+
+    switch( type ) {
+        case WS_EVT_CONNECT:
+            lv_area_set( &screen, 0, 0, lv_disp_get_hor_res( NULL ) - 1, lv_disp_get_ver_res( NULL ) - 1 );
+
+            portENTER_CRITICAL( &screenmirrorMux );
+            if ( screenmirror_client != 0 ) {
+                portEXIT_CRITICAL( &screenmirrorMux );
+                log_i("screenmirror busy, close client %u", client->id() );
+                client->text("busy");
+                client->close();
+                return;
+            }
+            screenmirror_client = client->id();
+            screenmirror_seq = 0;
+            screenmirror_acked = 0;
+            screenmirror_skipped = 0;
+            screenmirror_ack_time = millis();
+            /*
+             * a new viewer needs the whole screen
+             */
+            screenmirror_dirty_count = 0;
+            screenmirror_add_dirty( &screen );
+            portEXIT_CRITICAL( &screenmirrorMux );
+
+            screenshot_register_flush_cb( screenmirror_flush_cb );
+            if ( _screenmirror_Task == NULL ) {
+                xTaskCreate(    screenmirror_Task,      /* Function to implement the task */
+                                "screenmirror Task",    /* Name of the task */
+                                3000,                   /* Stack size in words */
+                                NULL,                   /* Task input parameter */
+                                1,                      /* Priority of the task */
+                                &_screenmirror_Task );  /* Task handle. */
+            }
+            log_i("screenmirror client %u connected", client->id() );
+            break;
+        case WS_EVT_DISCONNECT:
+            portENTER_CRITICAL( &screenmirrorMux );
+            if ( screenmirror_client != client->id() ) {
+                portEXIT_CRITICAL( &screenmirrorMux );
+                return;
+            }
+            screenmirror_client = 0;
+            portEXIT_CRITICAL( &screenmirrorMux );
+            screenshot_register_flush_cb( NULL );
+            log_i("screenmirror client %u disconnected", client->id() );
+            break;
+        case WS_EVT_DATA:
+            /*
+             * the viewer acknowledge each frame with "ack <seq>"
+             */
+            info = (AwsFrameInfo*)arg;
+            if ( info->opcode != WS_TEXT || !info->final || info->index != 0 || info->len != len || len >= sizeof( msg ) ) {
+                return;
+            }
+            memcpy( msg, data, len );
+            msg[ len ] = '\0';
+            if ( strncmp( msg, "ack ", 4 ) == 0 ) {
+                portENTER_CRITICAL( &screenmirrorMux );
+                screenmirror_acked = atoi( msg + 4 );
+                screenmirror_ack_time = millis();
+                portEXIT_CRITICAL( &screenmirrorMux );
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/*
+ * called from the lvgl task for every flushed area, only remember it
+ */
+static void screenmirror_flush_cb( const lv_area_t *area ) {
+    portENTER_CRITICAL( &screenmirrorMux );
+    screenmirror_add_dirty( area );
+    portEXIT_CRITICAL( &screenmirrorMux );
+}
+
+/*
+ * merge overlapping areas, if the list is full everything is merged into one area
+ */
+static void screenmirror_add_dirty( const lv_area_t *area ) {
+    lv_area_t *dirty;
+
+    for ( int i = 0 ; i < screenmirror_dirty_count ; i++ ) {
+        dirty = &screenmirror_dirty[ i ];
+        if ( area->x1 <= dirty->x2 && area->x2 >= dirty->x1 && area->y1 <= dirty->y2 && area->y2 >= dirty->y1 ) {
+            dirty->x1 = MIN( dirty->x1, area->x1 );
+            dirty->y1 = MIN( dirty->y1, area->y1 );
+            dirty->x2 = MAX( dirty->x2, area->x2 );
+            dirty->y2 = MAX( dirty->y2, area->y2 );
+            return;
+        }
+    }
+
+    if ( screenmirror_dirty_count == SCREENMIRROR_MAX_DIRTY ) {
+        dirty = &screenmirror_dirty[ 0 ];
+        for ( int i = 1 ; i < screenmirror_dirty_count ; i++ ) {
+            dirty->x1 = MIN( dirty->x1, screenmirror_dirty[ i ].x1 );
+            dirty->y1 = MIN( dirty->y1, screenmirror_dirty[ i ].y1 );
+            dirty->x2 = MAX( dirty->x2, screenmirror_dirty[ i ].x2 );
+            dirty->y2 = MAX( dirty->y2, screenmirror_dirty[ i ].y2 );
+        }
+        screenmirror_dirty_count = 1;
+        screenmirror_add_dirty( area );
+        return;
+    }
+
+    screenmirror_dirty[ screenmirror_dirty_count++ ] = *area;
+}
+
+void screenmirror_Task( void * pvParameters ) {
+    lv_area_t dirty[ SCREENMIRROR_MAX_DIRTY ];
+    uint32_t dirty_count;
+    uint32_t client_id;
+    uint16_t seq;
+    uint16_t skipped;
+
+    log_i("start screenmirror task, heap: %d", ESP.getFreeHeap() );
+
+    while( true ) {
+        vTaskDelay( SCREENMIRROR_FRAME_INTERVAL );
+
+        portENTER_CRITICAL( &screenmirrorMux );
+        client_id = screenmirror_client;
+        if ( client_id == 0 ) {
+            _screenmirror_Task = NULL;
+            portEXIT_CRITICAL( &screenmirrorMux );
+            break;
+        }
+        if ( screenmirror_dirty_count == 0 ) {
+            portEXIT_CRITICAL( &screenmirrorMux );
+            continue;
+        }
+        /*
+         * the viewer is behind, keep merging the dirty areas until it catch up.
+         * a lost ack is forgiven after one second
+         */
+        if ( (uint16_t)( screenmirror_seq - screenmirror_acked ) >= SCREENMIRROR_MAX_IN_FLIGHT ) {
+            if ( millis() - screenmirror_ack_time < 1000 ) {
+                screenmirror_skipped++;
+                portEXIT_CRITICAL( &screenmirrorMux );
+                continue;
+            }
+            screenmirror_acked = screenmirror_seq;
+        }
+        dirty_count = screenmirror_dirty_count;
+        memcpy( dirty, screenmirror_dirty, sizeof( lv_area_t ) * dirty_count );
+        screenmirror_dirty_count = 0;
+        seq = ++screenmirror_seq;
+        skipped = screenmirror_skipped;
+        screenmirror_skipped = 0;
+        portEXIT_CRITICAL( &screenmirrorMux );
+
+        for ( int i = 0 ; i < dirty_count ; i++ ) {
+            if ( !screenmirror_send_area( client_id, &dirty[ i ], seq, skipped, i == dirty_count - 1 ) ) {
+                break;
+            }
+        }
+    }
+
+    log_i("finish screenmirror task, heap: %d", ESP.getFreeHeap() );
+    vTaskDelete( NULL );
+}
+
+/*
+ * send an area in bands of SCREENMIRROR_BAND_HEIGHT rows
+ */
+static bool screenmirror_send_area( uint32_t client_id, const lv_area_t *area, uint16_t seq, uint16_t skipped, bool last ) {
+    AsyncWebSocketClient *client;
+    lv_area_t band;
+    uint16_t band_values[ 6 ];
+    size_t len;
+
+    band.x1 = area->x1;
+    band.x2 = area->x2;
+
+    for( band.y1 = area->y1 ; band.y1 <= area->y2 ; band.y1 = band.y2 + 1 ) {
+        band.y2 = MIN( band.y1 + SCREENMIRROR_BAND_HEIGHT - 1, area->y2 );
+
+        screenshot_shadow_read( &band, screenmirror_pixels );
+
+        screenmirror_msg[ 0 ] = SCREENMIRROR_MSG_RECT;
+        screenmirror_msg[ 1 ] = ( ( last && band.y2 == area->y2 ) ? SCREENMIRROR_FLAG_LAST : 0 ) | ( LV_COLOR_16_SWAP ? SCREENMIRROR_FLAG_SWAP : 0 );
+        band_values[ 0 ] = seq;
+        band_values[ 1 ] = skipped;
+        band_values[ 2 ] = band.x1;
+        band_values[ 3 ] = band.y1;
+        band_values[ 4 ] = band.x2 - band.x1 + 1;
+        band_values[ 5 ] = band.y2 - band.y1 + 1;
+        for ( int i = 0 ; i < 6 ; i++ ) {
+            screenmirror_msg[ 2 + i * 2 ] = band_values[ i ] & 0xff;
+            screenmirror_msg[ 3 + i * 2 ] = band_values[ i ] >> 8;
+        }
+        len = SCREENMIRROR_HEADER_SIZE + screenmirror_rle_encode( screenmirror_msg + SCREENMIRROR_HEADER_SIZE, screenmirror_pixels, band_values[ 4 ] * band_values[ 5 ] );
+
+        /*
+         * the client is looked up for each band, it is gone after a disconnect.
+         * wait up to one second for room in the send queue
+         */
+        for ( int wait = 0 ; ; wait++ ) {
+            client = screenmirror_ws.client( client_id );
+            if ( client == NULL || client->status() != WS_CONNECTED ) {
+                return( false );
+            }
+            if ( !client->queueIsFull() ) {
+                break;
+            }
+            if ( wait == 100 ) {
+                log_e("screenmirror client %u hangs, close", client_id );
+                client->close();
+                return( false );
+            }
+            vTaskDelay( 10 );
+        }
+        client->binary( screenmirror_msg, len );
+    }
+    return( true );
+}
+
+/*
+ * rle packets: 0x80 | (n-1) + one pixel for runs, (n-1) + n pixels for literals, n <= 128
+ */
+static size_t screenmirror_rle_encode( uint8_t *dest, const uint16_t *pixels, size_t count ) {
+    uint8_t *start = dest;
+    size_t i = 0;
+    size_t n;
+
+    while ( i < count ) {
+        n = 1;
+        while ( i + n < count && n < 128 && pixels[ i + n ] == pixels[ i ] ) {
+            n++;
+        }
+        if ( n > 1 ) {
+            *dest++ = 0x80 | ( n - 1 );
+            memcpy( dest, &pixels[ i ], sizeof( uint16_t ) );
+            dest += sizeof( uint16_t );
+            i += n;
+            continue;
+        }
+        /*
+         * collect pixels until the next run starts
+         */
+        while ( i + n < count && n < 128 && ( i + n + 1 >= count || pixels[ i + n ] != pixels[ i + n + 1 ] ) ) {
+            n++;
+        }
+        *dest++ = n - 1;
+        memcpy( dest, &pixels[ i ], n * sizeof( uint16_t ) );
+        dest += n * sizeof( uint16_t );
+        i += n;
+    }
+    return( dest - start );
+}
+
+#else
+
+void screenmirror_setup( AsyncWebServer *server ) {
+    log_e("screenmirror needs SCREENSHOT_SHADOW_FRAMEBUFFER");
+}
+
+#endif // SCREENSHOT_SHADOW_FRAMEBUFFER
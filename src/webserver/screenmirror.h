@@ -0,0 +1,58 @@
+/****************************************************************************
+ *   Sep 05 19:37:12 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _SCREENMIRROR_H
+    #define _SCREENMIRROR_H
+
+    #include <ESPAsyncWebServer.h>
+
+    #define SCREENMIRROR_URL                "/mirror/ws"    /** @brief websocket url, the viewer is /mirror.htm */
+    #define SCREENMIRROR_MAX_DIRTY          8               /** @brief dirty areas before they are merged into one */
+    #define SCREENMIRROR_BAND_HEIGHT        40              /** @brief max rows per message */
+    #define SCREENMIRROR_FRAME_INTERVAL     40              /** @brief min time between frames in ms */
+    #define SCREENMIRROR_MAX_IN_FLIGHT      2               /** @brief frames send but not acknowledged by the viewer */
+
+    /*
+     * frame message, all values little endian:
+     *
+     * uint8_t  type            SCREENMIRROR_MSG_RECT
+     * uint8_t  flags           SCREENMIRROR_FLAG_LAST on the last rect of a frame, SCREENMIRROR_FLAG_SWAP
+     * uint16_t seq             frame number, the viewer send "ack <seq>" after the last rect
+     * uint16_t skipped         frames merged into this one since the last frame
+     * uint16_t x, y, w, h      rect on the screen
+     * ...                      rle packets up to the end of the message:
+     *                          0x80 | (n-1) followed by one pixel, n times the same pixel
+     *                          (n-1) followed by n pixels
+     *                          pixels are RGB565, byte swapped if SCREENMIRROR_FLAG_SWAP is set
+     */
+    #define SCREENMIRROR_MSG_RECT           1
+    #define SCREENMIRROR_FLAG_LAST          _BV(0)
+    #define SCREENMIRROR_FLAG_SWAP          _BV(1)
+    #define SCREENMIRROR_HEADER_SIZE        14
+
+    /*
+     * @brief add the screen mirror websocket to the webserver, needs SCREENSHOT_SHADOW_FRAMEBUFFER
+     *
+     * @param   server      pointer to the webserver
+     */
+    void screenmirror_setup( AsyncWebServer *server );
+
+#endif // _SCREENMIRROR_H
@@ -22,7 +22,6 @@
 
 #include <WiFi.h>
 #include <WiFiClient.h>
-#include <Update.h>
 #include <SPIFFS.h>
 #include <AsyncTCP.h>
 #include <ESPAsyncWebServer.h>
@@ -32,106 +31,225 @@
 #include "webserver.h"
 #include "config.h"
 #include "gui/screenshot.h"
+#include "screenmirror.h"
+#include "webtemplate.h"
+#include "webstatic.h"
+#include "webupdate.h"
+#include "hardware/configapi.h"
+#include "hardware/metrics.h"
+#include "hardware/json_psram_allocator.h"
 
 AsyncWebServer asyncserver( WEBSERVERPORT );
 TaskHandle_t _WEBSERVER_Task;
 
+static const char index_html[] PROGMEM =
+    "<!DOCTYPE html>"
+    "<html>"
+    "<frameset cols=\"300, *\">"
+    "<frame src=\"/nav.htm\" name=\"nav\">"
+    "<frame name=\"cont\">"
+    "</frameset>"
+    "</html>";
+
+static const char nav_html[] PROGMEM =
+    "<!DOCTYPE html>"
+    "<html><head>"
+    "<meta http-equiv='Content-type' content='text/html; charset=utf-8'>"
+    "<title>Web Interface</title>"
+    "</head><body>"
+    "<h1>TTGo Watch Web Server</h1>"
+    "<p>This is your device, program it as you see fit."
+    "<p>Here are some URLs the device already supports, which you might find helpful:"
+    "<ul>"
+    "<li><a target=\"cont\" href=\"/info\">/info</a> - Display information about the device"
+    "<li><a target=\"cont\" href=\"/network\">/network</a> - Display network information"
+    "<li><a target=\"cont\" href=\"/shot\">/shot</a> - Capture a screen shot as png"
+    "<li><a target=\"cont\" href=\"/shot?format=qoi\">/shot?format=qoi</a> - Capture a screen shot as qoi"
+    "<li><a target=\"cont\" href=\"/shot?format=raw\">/shot?format=raw</a> - Capture a screen shot in RGB565 format, open it with gimp"
+    "<li><a target=\"cont\" href=\"/metrics\">/metrics</a> - Health metrics in prometheus format"
+    "<li><a target=\"cont\" href=\"/api/config\">/api/config</a> - All settings as json, change them with PATCH"
+    "<li><a target=\"cont\" href=\"/mirror.htm\">/mirror.htm</a> - Watch the screen live"
+    "<li><a target=\"_blank\" href=\"/edit\">/edit</a> - View, edit, upload, and delete files"
+    "</ul>"
+    "<p><div style=\"color:red;\">Caution:</div> Use these with care:"
+    "<ul><li><a target=\"cont\"  href=\"/reset\">/reset</a> Reboot the device"
+    "<li><a target=\"_top\" href=\"/update\">/update</a> Transmit a firmware update through POST request"
+    "</body></html>";
 
-  static const char* serverIndex =
-    "<!DOCTYPE html>\n <html><head>\n <script src='https://ajax.googleapis.com/ajax/libs/jquery/3.2.1/jquery.min.js'></script>"
-    "\n <script src='/jquery.min.js'></script>"
-
-    "\n <style>"
-    "\n #progressbarfull {"
-    "\n background-color: #20201F;"
-    "\n border-radius: 20px;"
-    "\n width: 320px;"
-    "\n padding: 4px;"
-    "\n}"
-    "\n #progressbar {"
-    "\n background-color: #20CC00;"
-    "\n width: 3%;"
-    "\n height: 16px;"
-    "\n border-radius: 10px;"
-    "\n}"
-    "\n</style>"
-    "\n </head><body>"
-    "<h2>Update by Browser</h2>"
-    "\n <form method='POST' action='#' enctype='multipart/form-data' id='upload_form'>"
-    "\n <input type='file' name='update'>"
-    "\n <br><br><input type='submit' value='Update'>"
-    "\n </form>"
-    "\n <div id='prg'>Progress: 0%</div>"
-    "\n <div id=\"progressbarfull\"><div id=\"progressbar\"></div></div>"
-    "\n <script>"
-    "\n $('form').submit(function(e){"
-    "\n e.preventDefault();"
-    "\n var form = $('#upload_form')[0];"
-    "\n var data = new FormData(form);"
-    "\n $.ajax({"
-    "\n url: '/update',"
-    "\n type: 'POST',"
-    "\n data: data,"
-    "\n contentType: false,"
-    "\n processData:false,"
-    "\n xhr: function() {"
-    "\n var xhr = new window.XMLHttpRequest();"
-    "\n xhr.upload.addEventListener('progress', function(evt) {"
-    "\n if (evt.lengthComputable) {"
-    "\n var per = evt.loaded / evt.total;"
-    "\n document.getElementById(\"prg\").innerHTML = 'Progress: ' + Math.round(per*100) + '%';"
-    "\n document.getElementById(\"progressbar\").style.width=Math.round(per*100)+ '%';"
-    "}"
-    "}, false);"
-    "return xhr;"
-    "},"
-    "\n success:function(d, s) {"
-    "\n document.getElementById(\"prg\").innerHTML = 'Progress: success';"
-    "\n console.log('success!')"
-    "},"
-    "\n error: function (a, b, c) {"
-    "\n document.getElementById(\"prg\").innerHTML = 'Progress: error';"
-    "}"
-    "});"
-    "});"
-    "\n </script>"
-    "\n </body></html>";
-
-void handleUpdate( AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final) {
-
-  if (!index){
-    /*
-     * if filename includes spiffs, update the spiffs partition
-     */
-    int cmd = (filename.indexOf("spiffs") > 0) ? U_SPIFFS : U_FLASH;
-    if (!Update.begin(UPDATE_SIZE_UNKNOWN, cmd)) {
-      Update.printError(Serial);
+/*
+ * %FIELD% is filled in by webserver_info_field while the page is send
+ */
+static const char info_html[] PROGMEM =
+    "<html><head><meta charset=\"utf-8\"></head><body><h3>Information</h3>"
+    "<b><u>Memory</u></b><br>"
+    "<b>Heap size: </b>%HEAP_SIZE%<br>"
+    "<b>Heap free: </b>%HEAP_FREE%<br>"
+    "<b>Heap free min: </b>%HEAP_FREE_MIN%<br>"
+    "<b>Heap size: </b>%HEAP_SIZE%<br>"
+    "<b>Psram size: </b>%PSRAM_SIZE%<br>"
+    "<b>Psram free: </b>%PSRAM_FREE%<br>"
+
+    "<br><b><u>System</u></b><br>"
+    "\t<b>Battery voltage: </b>%BATTERY_VOLTAGE% Volts<br>"
+
+    "\t<b>Uptime: </b>%UPTIME%<br>"
+    "<br><b><u>Chip</u></b>"
+    "<br><b>SdkVersion: </b>%SDK_VERSION%<br>"
+    "<b>CpuFreq: </b>%CPU_FREQ% MHz<br>"
+
+    "<br><b><u>Flash</u></b><br>"
+    "<b>FlashChipSpeed: </b>%FLASH_SPEED% MHz<br>"
+    "<b>Flash mode: </b>%FLASH_MODE_NAME%</b><br>"
+    "<b>Flash sector size: </b>%FLASH_SECTOR_SIZE%<br>"
+    "<b>FlashChipMode: </b>%FLASH_MODE%<br>"
+    "<b>FlashChipSize (SDK): </b>%FLASH_SIZE%<br>"
+
+    "<br><b><u>Firmware</u></b><br>"
+    "<b>SketchSpace free: </b>%SKETCH_FREE% (%SKETCH_FREE_PERCENT%%%)<br>"
+    "<b>BuildTime: </b>" __DATE__ " " __TIME__ "<br>"
+    "<b>Version: </b>" __FIRMWARE__ "<br>"
+    "<b>GCC-Version: </b>" __VERSION__ "<br>"
+    "<b>SketchMD5: </b>%SKETCH_MD5%<br>"
+
+    "<br><b><u>Filesystem</u></b><br>"
+    "<b>Total size: </b>%SPIFFS_TOTAL%<br>"
+    "<b>Used size: </b>%SPIFFS_USED%<br>"
+
+    "<br>";
+
+static const char network_html[] PROGMEM =
+    "<html><head><meta charset=\"utf-8\"></head><body><h3>Network</h3>"
+    "<b>IP Addr: </b>%IP%<br>"
+    "<b>MAC: </b>%MAC%<br>"
+    "<b>SNMask: </b>%SUBNET_MASK%<br>"
+    "<b>GW IP: </b>%GATEWAY%<br>"
+    "<b>DNS 1: </b>%DNS1%<br>"
+    "<b>DNS 2: </b>%DNS2%<br>"
+    "<b>RSSI: </b>%RSSI%dB<br>"
+    "<b>Hostname: </b>%HOSTNAME%<br>"
+    "<b>SSID: </b>%SSID%<br>"
+    "<br>Upnp Info: <a target=\"_blank\" href='/description.xml'>description.xml</a><br>"
+    "</body></head></html>";
+
+static void webserver_info_field( const char *field, char *value, size_t size ) {
+    if ( !strcmp( field, "HEAP_SIZE" ) ) {
+        snprintf( value, size, "%d", ESP.getHeapSize() );
     }
-  }
+    else if ( !strcmp( field, "HEAP_FREE" ) ) {
+        snprintf( value, size, "%d", ESP.getFreeHeap() );
+    }
+    else if ( !strcmp( field, "HEAP_FREE_MIN" ) ) {
+        snprintf( value, size, "%d", ESP.getMinFreeHeap() );
+    }
+    else if ( !strcmp( field, "PSRAM_SIZE" ) ) {
+        snprintf( value, size, "%d", ESP.getPsramSize() );
+    }
+    else if ( !strcmp( field, "PSRAM_FREE" ) ) {
+        snprintf( value, size, "%d", ESP.getFreePsram() );
+    }
+    else if ( !strcmp( field, "BATTERY_VOLTAGE" ) ) {
+        snprintf( value, size, "%.2f", TTGOClass::getWatch()->power->getBattVoltage() / 1000 );
+    }
+    else if ( !strcmp( field, "UPTIME" ) ) {
+        snprintf( value, size, "%lu", millis() / 1000 );
+    }
+    else if ( !strcmp( field, "SDK_VERSION" ) ) {
+        snprintf( value, size, "%s", ESP.getSdkVersion() );
+    }
+    else if ( !strcmp( field, "CPU_FREQ" ) ) {
+        snprintf( value, size, "%d", ESP.getCpuFreqMHz() );
+    }
+    else if ( !strcmp( field, "FLASH_SPEED" ) ) {
+        snprintf( value, size, "%d", ESP.getFlashChipSpeed() / 1000000 );
+    }
+    else if ( !strcmp( field, "FLASH_MODE_NAME" ) ) {
+        FlashMode_t mode = ESP.getFlashChipMode();
+        snprintf( value, size, "%s", mode == FM_QIO ? "QIO" : mode == FM_QOUT ? "QOUT" : mode == FM_DIO ? "DIO" : mode == FM_DOUT ? "DOUT" : "UNKNOWN" );
+    }
+    else if ( !strcmp( field, "FLASH_SECTOR_SIZE" ) ) {
+        snprintf( value, size, "%d", SPI_FLASH_SEC_SIZE );
+    }
+    else if ( !strcmp( field, "FLASH_MODE" ) ) {
+        snprintf( value, size, "%d", ESP.getFlashChipMode() );
+    }
+    else if ( !strcmp( field, "FLASH_SIZE" ) ) {
+        snprintf( value, size, "%d", ESP.getFlashChipSize() );
+    }
+    else if ( !strcmp( field, "SKETCH_FREE" ) ) {
+        snprintf( value, size, "%d", ESP.getFreeSketchSpace() );
+    }
+    else if ( !strcmp( field, "SKETCH_FREE_PERCENT" ) ) {
+        int SketchFull = ESP.getSketchSize() + ESP.getFreeSketchSpace();
+        snprintf( value, size, "%d", ESP.getFreeSketchSpace() / ( SketchFull / 100 ) );
+    }
+    else if ( !strcmp( field, "SKETCH_MD5" ) ) {
+        snprintf( value, size, "%s", ESP.getSketchMD5().c_str() );
+    }
+    else if ( !strcmp( field, "SPIFFS_TOTAL" ) ) {
+        snprintf( value, size, "%d", SPIFFS.totalBytes() );
+    }
+    else if ( !strcmp( field, "SPIFFS_USED" ) ) {
+        snprintf( value, size, "%d", SPIFFS.usedBytes() );
+    }
+}
 
-  /*
-   * Write Data an type message if fail
-   */
-  if (Update.write(data, len) != len) {
-    Update.printError(Serial);
-  }
+static void webserver_ip_field( IPAddress ip, char *value, size_t size ) {
+    snprintf( value, size, "%d.%d.%d.%d", ip[ 0 ], ip[ 1 ], ip[ 2 ], ip[ 3 ] );
+}
 
-  /*
-   * After write Update restart
-   */
-  if (final) {
-    AsyncWebServerResponse *response = request->beginResponse(302, "text/plain", "Please wait while the switch reboots");
-    response->addHeader("Refresh", "20");  
-    response->addHeader("Location", "/");
-    request->send(response);
-    if (!Update.end(true)){
-      Update.printError(Serial);
-    } else {
-      Serial.println("Update complete");
-      Serial.flush();
-      ESP.restart();
+static void webserver_network_field( const char *field, char *value, size_t size ) {
+    if ( !strcmp( field, "IP" ) ) {
+        webserver_ip_field( WiFi.localIP(), value, size );
+    }
+    else if ( !strcmp( field, "MAC" ) ) {
+        uint8_t mac[ 6 ];
+        WiFi.macAddress( mac );
+        snprintf( value, size, "%02X:%02X:%02X:%02X:%02X:%02X", mac[ 0 ], mac[ 1 ], mac[ 2 ], mac[ 3 ], mac[ 4 ], mac[ 5 ] );
+    }
+    else if ( !strcmp( field, "SUBNET_MASK" ) ) {
+        webserver_ip_field( WiFi.subnetMask(), value, size );
+    }
+    else if ( !strcmp( field, "GATEWAY" ) ) {
+        webserver_ip_field( WiFi.gatewayIP(), value, size );
+    }
+    else if ( !strcmp( field, "DNS1" ) ) {
+        webserver_ip_field( WiFi.dnsIP( 0 ), value, size );
+    }
+    else if ( !strcmp( field, "DNS2" ) ) {
+        webserver_ip_field( WiFi.dnsIP( 1 ), value, size );
+    }
+    else if ( !strcmp( field, "RSSI" ) ) {
+        snprintf( value, size, "%d", WiFi.RSSI() );
+    }
+    else if ( !strcmp( field, "HOSTNAME" ) ) {
+        snprintf( value, size, "%s", WiFi.getHostname() );
+    }
+    else if ( !strcmp( field, "SSID" ) ) {
+        wifi_ap_record_t ap_info;
+        if ( esp_wifi_sta_get_ap_info( &ap_info ) == ESP_OK ) {
+            snprintf( value, size, "%s", (const char *)ap_info.ssid );
+        }
     }
+}
+
+/*
+ * send all settings or an error as json
+ */
+static void webserver_send_config( AsyncWebServerRequest *request, int code, const char *error ) {
+  SpiRamJsonDocument doc( 4096 );
+
+  if ( error ) {
+    doc["error"] = error;
   }
+  else {
+    configapi_get( doc.to<JsonObject>() );
+  }
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  response->setCode( code );
+  response->addHeader("Cache-Control", "no-store");
+  serializeJson( doc, *response );
+  request->send( response );
 }
 
 /*
@@ -140,105 +258,109 @@ void handleUpdate( AsyncWebServerRequest *request, const String& filename, size_
 void asyncwebserver_start(void){
 
   asyncserver.on("/index.htm", HTTP_GET, [](AsyncWebServerRequest *request) {
-    String html = (String) "<!DOCTYPE html>"
-      "<html>"
-      "<frameset cols=\"300, *\">"
-      "<frame src=\"/nav.htm\" name=\"nav\">"
-      "<frame name=\"cont\">"
-      "</frameset>"
-      "</html>";
-    request->send(200, "text/html", html);
+    request->send_P(200, "text/html", index_html);
   });
 
   asyncserver.on("/nav.htm", HTTP_GET, [](AsyncWebServerRequest *request) {
-    String html = (String) "<!DOCTYPE html>"
-      "<html><head>"
-      "<meta http-equiv='Content-type' content='text/html; charset=utf-8'>"
-      "<title>Web Interface</title>"
-      "</head><body>"
-      "<h1>TTGo Watch Web Server</h1>"
-      "<p>This is your device, program it as you see fit."
-      "<p>Here are some URLs the device already supports, which you might find helpful:"
-      "<ul>"
-      "<li><a target=\"cont\" href=\"/info\">/info</a> - Display information about the device"
-      "<li><a target=\"cont\" href=\"/network\">/network</a> - Display network information"
-      "<li><a target=\"cont\" href=\"/shot\">/shot</a> - Capture a screen shot"
-      "<li><a target=\"cont\" href=\"/screen.data\">/screen.data</a> - Retrieve the image in RGB565 format, open it with gimp"
-      "<li><a target=\"_blank\" href=\"/edit\">/edit</a> - View, edit, upload, and delete files"
-      "</ul>"
-      "<p><div style=\"color:red;\">Caution:</div> Use these with care:"
-      "<ul><li><a target=\"cont\"  href=\"/reset\">/reset</a> Reboot the device"
-      "<li><a target=\"_top\" href=\"/update\">/update</a> Transmit a firmware update through POST request"
-      "</body></html>";
-    request->send(200, "text/html", html);
+    request->send_P(200, "text/html", nav_html);
   });
 
   asyncserver.on("/info", HTTP_GET, [](AsyncWebServerRequest *request) {
-    FlashMode_t mode = ESP.getFlashChipMode();
-    int SketchFull = ESP.getSketchSize() + ESP.getFreeSketchSpace();
-
-    String html = (String) "<html><head><meta charset=\"utf-8\"></head><body><h3>Information</h3>" +
-                  "<b><u>Memory</u></b><br>" +
-                  "<b>Heap size: </b>" + ESP.getHeapSize() + "<br>" +
-                  "<b>Heap free: </b>" + ESP.getFreeHeap() + "<br>" +
-                  "<b>Heap free min: </b>" + ESP.getMinFreeHeap() + "<br>" +
-                  "<b>Heap size: </b>" + ESP.getHeapSize() + "<br>" +
-                  "<b>Psram size: </b>" + ESP.getPsramSize() + "<br>" +
-                  "<b>Psram free: </b>" + ESP.getFreePsram() + "<br>" +
-
-                  "<br><b><u>System</u></b><br>" +
-                  "\t<b>Battery voltage: </b>" + TTGOClass::getWatch()->power->getBattVoltage() / 1000 + " Volts" + "<br>" +
-
-                  "\t<b>Uptime: </b>" + millis() / 1000 + "<br>" +
-                  "<br><b><u>Chip</u></b>" +
-                  "<br><b>SdkVersion: </b>" + String(ESP.getSdkVersion()) + "<br>" +
-                  "<b>CpuFreq: </b>" + String(ESP.getCpuFreqMHz()) + " MHz<br>" +
-                  
-                  "<br><b><u>Flash</u></b><br>" +
-                  "<b>FlashChipSpeed: </b>" + String(ESP.getFlashChipSpeed() / 1000000) + " MHz<br>" +
-                  "<b>Flash mode: </b>" + String( mode == FM_QIO ? "QIO" : mode == FM_QOUT ? "QOUT" : mode == FM_DIO ? "DIO" : mode == FM_DOUT ? "DOUT" : "UNKNOWN") + "</b><br>" +
-                  "<b>Flash sector size: </b>" + String( SPI_FLASH_SEC_SIZE) + "<br>" +
-                  "<b>FlashChipMode: </b>" + ESP.getFlashChipMode() + "<br>" +
-                  "<b>FlashChipSize (SDK): </b>" + ESP.getFlashChipSize() + "<br>" +
-                  
-                  "<br><b><u>Firmware</u></b><br>" +
-                  "<b>SketchSpace free: </b>" + ESP.getFreeSketchSpace() + " (" + (ESP.getFreeSketchSpace() / (SketchFull / 100)) + "%)<br>" +
-                  "<b>BuildTime: </b>" +  __DATE__ + " " + __TIME__  + "<br>" +
-                  "<b>Version: </b>" + __FIRMWARE__ + "<br>" +
-                  "<b>GCC-Version: </b>" + __VERSION__ + "<br>" +
-                  "<b>SketchMD5: </b>" + String(ESP.getSketchMD5()) + "<br>" +
-                  
-                  "<br><b><u>Filesystem</u></b><br>" +
-                  "<b>Total size: </b>" + SPIFFS.totalBytes() + "<br>" +
-                  "<b>Used size: </b>" + SPIFFS.usedBytes() + "<br>" +
-
-                  "<br>";
-    request->send(200, "text/html", html);
+    webtemplate_send( request, "text/html", info_html, webserver_info_field );
   });
 
   asyncserver.on("/network", HTTP_GET, [](AsyncWebServerRequest *request) {
-    String html = (String) "<html><head><meta charset=\"utf-8\"></head><body><h3>Network</h3>" +
-                  "<b>IP Addr: </b>" + WiFi.localIP().toString() + "<br>" +
-                  "<b>MAC: </b>" + WiFi.macAddress() + "<br>" +
-                  "<b>SNMask: </b>" + WiFi.subnetMask().toString() + "<br>" +
-                  "<b>GW IP: </b>" + WiFi.gatewayIP().toString() + "<br>" +
-                  "<b>DNS 1: </b>" + WiFi.dnsIP(0).toString() + "<br>" +
-                  "<b>DNS 2: </b>" + WiFi.dnsIP(1).toString() + "<br>" +
-                  "<b>RSSI: </b>" + String(WiFi.RSSI()) + "dB<br>" +
-                  "<b>Hostname: </b>" + WiFi.getHostname() + "<br>" +
-                  "<b>SSID: </b>" + WiFi.SSID() + "<br>" +
-                  "<br>Upnp Info: <a target=\"_blank\" href='/description.xml'>description.xml</a>" + "<br>" +
-                  "</body></head></html>";
-    request->send(200, "text/html", html);
+    webtemplate_send( request, "text/html", network_html, webserver_network_field );
   });
 
+  /*
+   * the screenshot is encoded row by row from psram while it is send, nothing is stored
+   */
   asyncserver.on("/shot", HTTP_GET, [](AsyncWebServerRequest * request) {
-    request->send(200, "text/plain", "screen is taken\r\n" );
-    screenshot_take();
-    screenshot_save();
+    screenshot_format_t format = SCREENSHOT_PNG;
+
+    if ( request->hasParam("format") && !screenshot_encoder_get_format( request->getParam("format")->value().c_str(), &format ) ) {
+      request->send(400, "text/plain", "unknown format, use raw, png or qoi\r\n" );
+      return;
+    }
+
+    screenshot_encoder_t *encoder = screenshot_stream_open( format );
+    if ( encoder == NULL ) {
+      request->send(503, "text/plain", "screenshot busy\r\n" );
+      return;
+    }
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse( screenshot_encoder_get_mime_type( format ), [encoder](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+      return( screenshot_encoder_read( encoder, buffer, maxLen ) );
+    });
+    response->addHeader("Cache-Control", "no-store");
+    request->onDisconnect( [encoder]() {
+      screenshot_stream_close( encoder );
+    });
+    request->send(response);
   });
 
+  asyncserver.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request) {
+    AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
+    response->addHeader("Cache-Control", "no-store");
+    metrics_write( *response );
+    request->send( response );
+  });
+
+  asyncserver.on("/api/config", HTTP_GET, [](AsyncWebServerRequest *request) {
+    webserver_send_config( request, 200, NULL );
+  });
+
+  /*
+   * the body is collected in _tempObject, it is freed with the request
+   */
+  asyncserver.on("/api/config", HTTP_PATCH, [](AsyncWebServerRequest *request) {
+    char error[ 64 ] = "";
+
+    if ( request->_tempObject == NULL ) {
+      webserver_send_config( request, 400, "json body expected" );
+      return;
+    }
+
+    SpiRamJsonDocument patch( 2048 );
+    DeserializationError json_error = deserializeJson( patch, (const char *)request->_tempObject );
+    if ( json_error ) {
+      webserver_send_config( request, 400, json_error.c_str() );
+      return;
+    }
+    if ( !patch.is<JsonObject>() ) {
+      webserver_send_config( request, 400, "json object expected" );
+      return;
+    }
+
+    /*
+     * the batch is applied and saved by the main loop, a following GET shows it
+     */
+    switch( configapi_patch( patch.as<JsonObjectConst>(), error, sizeof( error ) ) ) {
+      case CONFIGAPI_QUEUED:    request->send( 202, "application/json", "{\"status\":\"queued\"}" );
+                                break;
+      case CONFIGAPI_BUSY:      webserver_send_config( request, 503, error );
+                                break;
+      default:                  webserver_send_config( request, 400, error );
+                                break;
+    }
+  }, NULL, [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+    if ( total > 2048 ) {
+      return;
+    }
+    if ( index == 0 ) {
+      request->_tempObject = calloc( total + 1, 1 );
+    }
+    if ( request->_tempObject ) {
+      memcpy( (uint8_t *)request->_tempObject + index, data, len );
+    }
+  });
+
+  screenmirror_setup( &asyncserver );
+  webupdate_setup( &asyncserver );
+
   asyncserver.addHandler(new SPIFFSEditor(SPIFFS));
+  asyncserver.addHandler(new WebStaticHandler());
   asyncserver.rewrite("/", "/index.htm");
   asyncserver.serveStatic("/", SPIFFS, "/");
 
@@ -312,16 +434,6 @@ void asyncwebserver_start(void){
     ESP.restart();    
   });
 
-  asyncserver.on("/update", HTTP_GET, [](AsyncWebServerRequest * request) {
-    request->send(200, "text/html", serverIndex);
-  });
-
-  asyncserver.on(
-    "/update", HTTP_POST,
-    [](AsyncWebServerRequest *request) {},
-    [](AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len, bool final) { handleUpdate(request, filename, index, data, len, final); }
-  );
-
   asyncserver.on("/description.xml", HTTP_GET, [](AsyncWebServerRequest *request) {
     byte mac[6];
     WiFi.macAddress(mac);
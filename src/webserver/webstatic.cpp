@@ -0,0 +1,91 @@
+/****************************************************************************
+ *   Sep 06 16:21:08 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <SPIFFS.h>
+
+#include "config.h"
+#include "webstatic.h"
+
+/*
+ * get the ETag from the gzip trailer, crc32 and size of the uncompressed data
+ */
+static bool webstatic_get_etag( File &file, char *etag, size_t size ) {
+    uint8_t trailer[ 8 ];
+
+    if ( file.size() < 18 + sizeof( trailer ) || !file.seek( file.size() - sizeof( trailer ) ) || file.read( trailer, sizeof( trailer ) ) != sizeof( trailer ) ) {
+        return( false );
+    }
+    file.seek( 0 );
+
+    snprintf( etag, size, "\"%02x%02x%02x%02x-%u\"", trailer[ 3 ], trailer[ 2 ], trailer[ 1 ], trailer[ 0 ],
+                                                      trailer[ 4 ] | trailer[ 5 ] << 8 | trailer[ 6 ] << 16 | trailer[ 7 ] << 24 );
+    return( true );
+}
+
+bool WebStaticHandler::canHandle( AsyncWebServerRequest *request ) {
+    if ( request->method() != HTTP_GET || request->url().endsWith("/") || request->url().endsWith(".gz") ) {
+        return( false );
+    }
+    if ( !SPIFFS.exists( request->url() + ".gz" ) ) {
+        return( false );
+    }
+    /*
+     * canHandle is called before the headers are parsed, only interesting headers are kept
+     */
+    request->addInterestingHeader("If-None-Match");
+    return( true );
+}
+
+void WebStaticHandler::handleRequest( AsyncWebServerRequest *request ) {
+    char etag[ 24 ];
+
+    File file = SPIFFS.open( request->url() + ".gz", "r" );
+    if ( !file ) {
+        request->send( 404 );
+        return;
+    }
+
+    if ( !webstatic_get_etag( file, etag, sizeof( etag ) ) ) {
+        log_e("%s.gz is not a gzip file", request->url().c_str() );
+        file.close();
+        request->send( 500 );
+        return;
+    }
+
+    if ( request->hasHeader("If-None-Match") && request->header("If-None-Match").indexOf( etag ) >= 0 ) {
+        file.close();
+        AsyncWebServerResponse *response = request->beginResponse( 304 );
+        response->addHeader( "ETag", etag );
+        response->addHeader( "Cache-Control", WEBSTATIC_CACHE_CONTROL );
+        request->send( response );
+        return;
+    }
+
+    /*
+     * a .gz file with an url without .gz is send with Content-Encoding: gzip and
+     * the content type of the url
+     */
+    AsyncWebServerResponse *response = request->beginResponse( file, request->url() );
+    response->addHeader( "ETag", etag );
+    response->addHeader( "Cache-Control", WEBSTATIC_CACHE_CONTROL );
+    response->addHeader( "Vary", "Accept-Encoding" );
+    request->send( response );
+}
@@ -0,0 +1,40 @@
+/****************************************************************************
+ *   Sep 06 16:21:08 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _WEBSTATIC_H
+    #define _WEBSTATIC_H
+
+    #include <ESPAsyncWebServer.h>
+
+    #define WEBSTATIC_CACHE_CONTROL     "no-cache"      /** @brief browsers keep the file but revalidate it with the ETag */
+
+    /*
+     * @brief serve precompressed files from spiffs. a request for /file is answered with /file.gz
+     * if it exists, the crc32 and size from the gzip trailer are used as ETag and a matching
+     * If-None-Match is answered with 304. files without .gz are left to serveStatic
+     */
+    class WebStaticHandler: public AsyncWebHandler {
+        public:
+            bool canHandle( AsyncWebServerRequest *request ) override;
+            void handleRequest( AsyncWebServerRequest *request ) override;
+    };
+
+#endif // _WEBSTATIC_H
@@ -0,0 +1,102 @@
+/****************************************************************************
+ *   Sep 06 11:02:45 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "config.h"
+#include "webtemplate.h"
+
+void webtemplate_send( AsyncWebServerRequest *request, const char *content_type, const char *tmpl, WEBTEMPLATE_FIELD_FUNC field_cb ) {
+    webtemplate_t *webtemplate = ( webtemplate_t * )calloc( sizeof( webtemplate_t ), 1 );
+    if ( webtemplate == NULL ) {
+        log_e("webtemplate calloc faild");
+        request->send( 503 );
+        return;
+    }
+    webtemplate->tmpl = tmpl;
+    webtemplate->field_cb = field_cb;
+    webtemplate->start = millis();
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse( content_type, [webtemplate](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+        return( webtemplate_read( webtemplate, buffer, maxLen ) );
+    });
+    response->addHeader("Cache-Control", "no-store");
+    request->onDisconnect( [request, webtemplate]() {
+        log_i("%s: %d bytes in %lums, heap: %d", request->url().c_str(), webtemplate->sent, millis() - webtemplate->start, ESP.getFreeHeap() );
+        free( webtemplate );
+    });
+    request->send( response );
+}
+
+size_t webtemplate_read( webtemplate_t *webtemplate, uint8_t *buf, size_t size ) {
+    char field[ WEBTEMPLATE_FIELD_SIZE ];
+    const char *tmpl = webtemplate->tmpl;
+    size_t written = 0;
+    size_t len;
+
+    while ( written < size ) {
+        /*
+         * rest of the last field value
+         */
+        if ( webtemplate->value_pos < webtemplate->value_len ) {
+            len = MIN( webtemplate->value_len - webtemplate->value_pos, size - written );
+            memcpy( buf + written, webtemplate->value + webtemplate->value_pos, len );
+            webtemplate->value_pos += len;
+            written += len;
+            continue;
+        }
+        if ( tmpl[ webtemplate->pos ] == '\0' ) {
+            break;
+        }
+        /*
+         * static text up to the next field
+         */
+        if ( tmpl[ webtemplate->pos ] != '%' ) {
+            const char *end = strchr( tmpl + webtemplate->pos, '%' );
+            len = end ? end - ( tmpl + webtemplate->pos ) : strlen( tmpl + webtemplate->pos );
+            len = MIN( len, size - written );
+            memcpy( buf + written, tmpl + webtemplate->pos, len );
+            webtemplate->pos += len;
+            written += len;
+            continue;
+        }
+        /*
+         * %FIELD% with A-Z, 0-9 and _ or %%, any other % is send as it is
+         */
+        len = strspn( tmpl + webtemplate->pos + 1, "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_" );
+        const char *end = tmpl + webtemplate->pos + 1 + len;
+        if ( *end != '%' || len == 0 || len >= sizeof( field ) ) {
+            webtemplate->value[ 0 ] = '%';
+            webtemplate->value_len = 1;
+            webtemplate->pos += ( *end == '%' && len == 0 ) ? 2 : 1;
+        }
+        else {
+            memcpy( field, tmpl + webtemplate->pos + 1, len );
+            field[ len ] = '\0';
+            webtemplate->value[ 0 ] = '\0';
+            webtemplate->field_cb( field, webtemplate->value, sizeof( webtemplate->value ) );
+            webtemplate->value_len = strlen( webtemplate->value );
+            webtemplate->pos += len + 2;
+        }
+        webtemplate->value_pos = 0;
+    }
+
+    webtemplate->sent += written;
+    return( written );
+}
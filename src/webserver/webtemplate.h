@@ -0,0 +1,71 @@
+/****************************************************************************
+ *   Sep 06 11:02:45 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _WEBTEMPLATE_H
+    #define _WEBTEMPLATE_H
+
+    #include <ESPAsyncWebServer.h>
+
+    #define WEBTEMPLATE_FIELD_SIZE      32          /** @brief max length of a field name */
+    #define WEBTEMPLATE_VALUE_SIZE      64          /** @brief max length of a field value */
+
+    /*
+     * @brief write the value of a template field
+     *
+     * @param   field       name of the field without the %
+     * @param   value       destination for the value
+     * @param   size        size of the destination
+     */
+    typedef void ( * WEBTEMPLATE_FIELD_FUNC ) ( const char *field, char *value, size_t size );
+
+    typedef struct {
+        const char *tmpl;                           /** @brief template, stays in flash */
+        size_t pos;                                 /** @brief read position in the template */
+        WEBTEMPLATE_FIELD_FUNC field_cb;
+        char value[ WEBTEMPLATE_VALUE_SIZE ];       /** @brief current field value */
+        size_t value_len;
+        size_t value_pos;
+        size_t sent;                                /** @brief bytes send so far */
+        uint32_t start;                             /** @brief time in ms the response was started */
+    } webtemplate_t;
+
+    /*
+     * @brief send a template as chunked response. static text is copied straight from the template,
+     * fields like %HEAP_FREE% are filled in by field_cb while the response is send and %% is a single %
+     *
+     * @param   request         pointer to the request
+     * @param   content_type    content type like "text/html"
+     * @param   tmpl            pointer to the template
+     * @param   field_cb        function to write the field values
+     */
+    void webtemplate_send( AsyncWebServerRequest *request, const char *content_type, const char *tmpl, WEBTEMPLATE_FIELD_FUNC field_cb );
+    /*
+     * @brief read the next part of the filled template
+     *
+     * @param   webtemplate     pointer to the template state
+     * @param   buf             destination buffer
+     * @param   size            size of the destination buffer
+     *
+     * @return  number of bytes written to buf, 0 at the end of the template
+     */
+    size_t webtemplate_read( webtemplate_t *webtemplate, uint8_t *buf, size_t size );
+
+#endif // _WEBTEMPLATE_H
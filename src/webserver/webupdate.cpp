@@ -0,0 +1,381 @@
+/****************************************************************************
+ *   Sep 08 19:36:12 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <Update.h>
+
+#include "config.h"
+#include "webupdate.h"
+#include "hardware/otaupdate.h"
+
+/*
+ * plain XMLHttpRequest, no jquery from a cdn so it also works without internet.
+ * the upload bar shows what is send, the flash bar what the watch has written
+ */
+static const char update_html[] PROGMEM =
+    "<!DOCTYPE html>"
+    "\n<html><head>"
+    "\n<style>"
+    "\n.bar { background-color: #20201F; border-radius: 20px; width: 320px; padding: 4px; margin-bottom: 8px; }"
+    "\n.bar div { background-color: #20CC00; width: 0%; height: 16px; border-radius: 10px; }"
+    "\n</style>"
+    "\n</head><body>"
+    "\n<h2>Update by Browser</h2>"
+    "\n<form id='upload_form'>"
+    "\n<input type='file' name='update' id='file'>"
+    "\n<br><br><input type='submit' value='Update'>"
+    "\n</form>"
+    "\n<div id='prg'>Select a firmware.bin or spiffs.bin</div>"
+    "\nUpload<div class='bar'><div id='upload'></div></div>"
+    "\nFlash<div class='bar'><div id='flash'></div></div>"
+    "\n<script>"
+    "\nfunction $(id) { return document.getElementById(id); }"
+    "\nfunction status(msg) { $('prg').innerHTML = msg; }"
+    "\nfunction bar(id, per) { $(id).style.width = Math.round(per * 100) + '%'; }"
+    "\n/* crypto.subtle is only available on https, so the sha256 is done here */"
+    "\nfunction sha256(buf){"
+    "\nvar k=[],h=[],w=new Uint32Array(64),n=2,p=0,i,j;"
+    "\nfunction frac(x){return (x-Math.floor(x))*4294967296|0;}"
+    "\nwhile(p<64){for(j=2;j*j<=n;j++)if(n%j==0)break;if(j*j>n){if(p<8)h[p]=frac(Math.pow(n,1/2));k[p++]=frac(Math.pow(n,1/3));}n++;}"
+    "\nvar l=buf.byteLength,len=((l+72)>>6)<<6,m=new Uint8Array(len),dv=new DataView(m.buffer);"
+    "\nm.set(new Uint8Array(buf));m[l]=0x80;dv.setUint32(len-8,Math.floor(l/0x20000000));dv.setUint32(len-4,(l*8)>>>0);"
+    "\nfor(i=0;i<len;i+=64){"
+    "\nfor(j=0;j<64;j++){if(j<16)w[j]=dv.getUint32(i+j*4);else{var x=w[j-15],y=w[j-2];"
+    "\nw[j]=((x>>>7|x<<25)^(x>>>18|x<<14)^(x>>>3))+w[j-7]+((y>>>17|y<<15)^(y>>>19|y<<13)^(y>>>10))+w[j-16];}}"
+    "\nvar a=h[0],b=h[1],c=h[2],d=h[3],e=h[4],f=h[5],g=h[6],o=h[7];"
+    "\nfor(j=0;j<64;j++){var t1=o+((e>>>6|e<<26)^(e>>>11|e<<21)^(e>>>25|e<<7))+((e&f)^(~e&g))+k[j]+w[j]|0;"
+    "\nvar t2=((a>>>2|a<<30)^(a>>>13|a<<19)^(a>>>22|a<<10))+((a&b)^(a&c)^(b&c))|0;o=g;g=f;f=e;e=d+t1|0;d=c;c=b;b=a;a=t1+t2|0;}"
+    "\nh[0]=h[0]+a|0;h[1]=h[1]+b|0;h[2]=h[2]+c|0;h[3]=h[3]+d|0;h[4]=h[4]+e|0;h[5]=h[5]+f|0;h[6]=h[6]+g|0;h[7]=h[7]+o|0;}"
+    "\nreturn h.map(function(v){return ('0000000'+(v>>>0).toString(16)).slice(-8);}).join('');}"
+    "\n$('upload_form').addEventListener('submit', function(e) {"
+    "\ne.preventDefault();"
+    "\nvar file = $('file').files[0];"
+    "\nif (!file) return;"
+    "\nstatus('Hashing ...');"
+    "\nvar reader = new FileReader();"
+    "\nreader.onload = function() {"
+    "\nvar sha = sha256(reader.result);"
+    "\nvar events = new EventSource('/update/events');"
+    "\nevents.addEventListener('progress', function(e) {"
+    "\nvar p = JSON.parse(e.data);"
+    "\nif (p.total) bar('flash', p.written / p.total);"
+    "\nstatus('Flash: ' + Math.round(p.written / 1024) + ' kB');"
+    "\n});"
+    "\nevents.addEventListener('done', function(e) { bar('flash', 1); status('Verified, sha256 ' + JSON.parse(e.data).msg + ', restarting ...'); events.close(); });"
+    "\nevents.addEventListener('fail', function(e) { status('Error: ' + JSON.parse(e.data).msg); events.close(); });"
+    "\nvar data = new FormData();"
+    "\ndata.append('update', file);"
+    "\nvar xhr = new XMLHttpRequest();"
+    "\nxhr.upload.addEventListener('progress', function(e) { if (e.lengthComputable) bar('upload', e.loaded / e.total); });"
+    "\nxhr.onload = function() { if (xhr.status >= 400) status('Error: ' + xhr.responseText); };"
+    "\nxhr.onerror = function() { status('Error: connection lost'); events.close(); };"
+    "\nxhr.open('POST', '/update?sha256=' + sha + '&size=' + file.size);"
+    "\nxhr.send(data);"
+    "\n};"
+    "\nreader.readAsArrayBuffer(file);"
+    "\n});"
+    "\n</script>"
+    "\n</body></html>";
+
+static AsyncEventSource webupdate_events( WEBUPDATE_EVENTS_URL );
+static AsyncWebServerRequest *webupdate_request = NULL;    /** @brief request that is sending the running update */
+static AsyncWebServerRequest *webupdate_owner = NULL;      /** @brief request that has started the running update */
+static AsyncWebServerRequest *webupdate_last = NULL;       /** @brief last request that has send a file */
+static bool webupdate_registered = false;
+
+/*
+ * the upload arrives on the async_tcp task, it must never wait for the flash. the
+ * file is copied into the ring and the webupdate task writes it with otaupdate and
+ * verifies it at the end. when the ring is full up to WEBUPDATE_HOLD_ACK the received
+ * data is not acked, so the sender waits until the webupdate task has caught up
+ */
+static SemaphoreHandle_t webupdate_mutex = NULL;
+static SemaphoreHandle_t webupdate_data = NULL;
+static TaskHandle_t _webupdate_Task = NULL;
+static uint8_t *webupdate_ring = NULL;
+static size_t webupdate_ring_head = 0;
+static size_t webupdate_ring_fill = 0;
+static bool webupdate_final = false;                        /** @brief the whole file is in the ring */
+static bool webupdate_failed = false;                       /** @brief the update is aborted, the rest of the file is dropped */
+static AsyncClient *webupdate_client = NULL;                /** @brief connection with acks held back or NULL */
+
+static void webupdate_event_cb( EventBits_t event, size_t written, size_t total, const char *msg );
+static void webupdate_upload( AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final );
+static void webupdate_result( AsyncWebServerRequest *request );
+static bool webupdate_start( AsyncWebServerRequest *request, const String& filename );
+static void webupdate_release_client( void );
+static void webupdate_Task( void * pvParameters );
+
+void webupdate_setup( AsyncWebServer *server ) {
+    /*
+     * asyncwebserver_start is called on every wifi connect, add the handler only once
+     */
+    if ( webupdate_registered ) {
+        return;
+    }
+    webupdate_registered = true;
+
+    webupdate_mutex = xSemaphoreCreateMutex();
+    webupdate_data = xSemaphoreCreateBinary();
+    if ( webupdate_mutex == NULL || webupdate_data == NULL ) {
+        log_e("webupdate semaphore create faild");
+        while(true);
+    }
+
+    otaupdate_register_cb( OTAUPDATE_PROGRESS | OTAUPDATE_DONE | OTAUPDATE_FAIL, webupdate_event_cb );
+
+    /*
+     * the event source first, the /update handler also matches /update/...
+     */
+    server->addHandler( &webupdate_events );
+    server->on( WEBUPDATE_URL, HTTP_GET, [](AsyncWebServerRequest *request) {
+        request->send_P( 200, "text/html", update_html );
+    });
+    server->on( WEBUPDATE_URL, HTTP_POST, webupdate_result, webupdate_upload );
+}
+
+static void webupdate_event_cb( EventBits_t event, size_t written, size_t total, const char *msg ) {
+    char json[ 128 ];
+
+    snprintf( json, sizeof( json ), "{\"written\":%d,\"total\":%d,\"msg\":\"%s\"}", written, total, msg );
+    switch( event ) {
+        case OTAUPDATE_PROGRESS:    webupdate_events.send( json, "progress", millis() );
+                                    break;
+        case OTAUPDATE_DONE:        webupdate_events.send( json, "done", millis() );
+                                    break;
+        case OTAUPDATE_FAIL:        webupdate_events.send( json, "fail", millis() );
+                                    break;
+    }
+}
+
+/*
+ * called for each part of the uploaded file on the async_tcp task, the image size
+ * comes from the client next to the sha256. the multipart content length is bigger
+ * than the image, without the size it is unknown
+ */
+static void webupdate_upload( AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final ) {
+    if ( index == 0 ) {
+        webupdate_last = request;
+        if ( !webupdate_start( request, filename ) ) {
+            return;
+        }
+        /*
+         * a lost connection before the end of the file drops the written part
+         */
+        request->onDisconnect( [request]() {
+            xSemaphoreTake( webupdate_mutex, portMAX_DELAY );
+            if ( webupdate_request == request ) {
+                webupdate_request = NULL;
+                webupdate_failed = true;
+            }
+            if ( webupdate_owner == request ) {
+                webupdate_owner = NULL;
+                webupdate_client = NULL;
+            }
+            xSemaphoreGive( webupdate_mutex );
+            xSemaphoreGive( webupdate_data );
+        });
+    }
+
+    xSemaphoreTake( webupdate_mutex, portMAX_DELAY );
+    if ( webupdate_request != request ) {
+        xSemaphoreGive( webupdate_mutex );
+        return;
+    }
+    /*
+     * the held back window limits what can arrive, a full ring is an error
+     */
+    if ( len > WEBUPDATE_RING_SIZE - webupdate_ring_fill ) {
+        log_e("upload ring overflow");
+        webupdate_request = NULL;
+        webupdate_failed = true;
+    }
+    else {
+        size_t part = WEBUPDATE_RING_SIZE - webupdate_ring_head;
+        if ( part > len ) {
+            part = len;
+        }
+        memcpy( webupdate_ring + webupdate_ring_head, data, part );
+        memcpy( webupdate_ring, data + part, len - part );
+        webupdate_ring_head = ( webupdate_ring_head + len ) % WEBUPDATE_RING_SIZE;
+        webupdate_ring_fill += len;
+        if ( webupdate_ring_fill >= WEBUPDATE_HOLD_ACK ) {
+            request->client()->ackLater();
+            webupdate_client = request->client();
+        }
+        if ( final ) {
+            webupdate_request = NULL;
+            webupdate_final = true;
+        }
+    }
+    xSemaphoreGive( webupdate_mutex );
+    xSemaphoreGive( webupdate_data );
+}
+
+/*
+ * start otaupdate and the webupdate task, an update that is still verified counts as running
+ */
+static bool webupdate_start( AsyncWebServerRequest *request, const String& filename ) {
+    /*
+     * if filename includes spiffs, update the spiffs partition
+     */
+    int cmd = ( filename.indexOf("spiffs") >= 0 ) ? U_SPIFFS : U_FLASH;
+    const char *sha256 = request->hasParam( WEBUPDATE_SHA256_PARAM ) ? request->getParam( WEBUPDATE_SHA256_PARAM )->value().c_str() : NULL;
+    size_t total = request->hasParam( WEBUPDATE_SIZE_PARAM ) ? request->getParam( WEBUPDATE_SIZE_PARAM )->value().toInt() : 0;
+
+    xSemaphoreTake( webupdate_mutex, portMAX_DELAY );
+    if ( _webupdate_Task ) {
+        xSemaphoreGive( webupdate_mutex );
+        log_e("update already running");
+        return( false );
+    }
+    if ( !otaupdate_begin( cmd, total, sha256 ) ) {
+        xSemaphoreGive( webupdate_mutex );
+        return( false );
+    }
+    webupdate_ring = (uint8_t *)ps_malloc( WEBUPDATE_RING_SIZE );
+    if ( webupdate_ring == NULL ) {
+        log_e("webupdate_ring malloc faild");
+        while(true);
+    }
+    webupdate_ring_head = 0;
+    webupdate_ring_fill = 0;
+    webupdate_final = false;
+    webupdate_failed = false;
+    webupdate_client = NULL;
+    webupdate_request = request;
+    webupdate_owner = request;
+    xSemaphoreTake( webupdate_data, 0 );
+
+    xTaskCreate(    webupdate_Task,             /* Function to implement the task */
+                    "webupdate Task",           /* Name of the task */
+                    3000,                       /* Stack size in words */
+                    NULL,                       /* Task input parameter */
+                    1,                          /* Priority of the task */
+                    &_webupdate_Task );         /* Task handle. */
+    xSemaphoreGive( webupdate_mutex );
+    return( true );
+}
+
+/*
+ * ack what was held back, the sender can go on. the client stays set until the
+ * connection is closed, a packet may be added to the held back bytes after the
+ * upload callback. called with webupdate_mutex taken
+ */
+static void webupdate_release_client( void ) {
+    if ( webupdate_client ) {
+        webupdate_client->ack( WEBUPDATE_RING_SIZE );
+    }
+}
+
+/*
+ * called after the whole body is received, the image is verified in the background
+ */
+static void webupdate_result( AsyncWebServerRequest *request ) {
+    xSemaphoreTake( webupdate_mutex, portMAX_DELAY );
+    bool started = webupdate_owner == request;
+    bool failed = webupdate_failed;
+    bool busy = _webupdate_Task != NULL;
+    xSemaphoreGive( webupdate_mutex );
+
+    if ( webupdate_last != request ) {
+        request->send( 400, "text/plain", "no file uploaded\r\n" );
+    }
+    else if ( started && !failed ) {
+        request->send( 202, "text/plain", "update received, verifying\r\n" );
+    }
+    else if ( !started && ( otaupdate_is_running() || busy ) ) {
+        request->send( 409, "text/plain", "another update is running\r\n" );
+    }
+    else {
+        request->send( 500, "text/plain", String( otaupdate_get_error() ) + "\r\n" );
+    }
+}
+
+/*
+ * write the ring with otaupdate, blocking while otaupdate waits for the flash is fine here.
+ * after a verified image the device restarts
+ */
+static void webupdate_Task( void * pvParameters ) {
+    bool success = false;
+
+    uint8_t *chunk = (uint8_t *)ps_malloc( WEBUPDATE_CHUNK_SIZE );
+    if ( chunk == NULL ) {
+        log_e("webupdate chunk malloc faild");
+        while(true);
+    }
+
+    while( true ) {
+        xSemaphoreTake( webupdate_mutex, portMAX_DELAY );
+        size_t tail = ( webupdate_ring_head + WEBUPDATE_RING_SIZE - webupdate_ring_fill ) % WEBUPDATE_RING_SIZE;
+        size_t len = WEBUPDATE_RING_SIZE - tail;
+        if ( len > webupdate_ring_fill ) {
+            len = webupdate_ring_fill;
+        }
+        if ( len > WEBUPDATE_CHUNK_SIZE ) {
+            len = WEBUPDATE_CHUNK_SIZE;
+        }
+        memcpy( chunk, webupdate_ring + tail, len );
+        webupdate_ring_fill -= len;
+        if ( webupdate_ring_fill < WEBUPDATE_HOLD_ACK / 2 ) {
+            webupdate_release_client();
+        }
+        bool failed = webupdate_failed;
+        bool final = webupdate_final && webupdate_ring_fill == 0;
+        xSemaphoreGive( webupdate_mutex );
+
+        if ( failed ) {
+            otaupdate_abort();
+            break;
+        }
+        if ( len && !otaupdate_write( chunk, len ) ) {
+            otaupdate_abort();
+            break;
+        }
+        if ( final ) {
+            success = otaupdate_end();
+            break;
+        }
+        if ( len == 0 ) {
+            xSemaphoreTake( webupdate_data, portMAX_DELAY );
+        }
+    }
+    free( chunk );
+
+    /*
+     * the rest of a failed upload is dropped, the sender must not wait for acks
+     */
+    xSemaphoreTake( webupdate_mutex, portMAX_DELAY );
+    webupdate_request = NULL;
+    webupdate_failed = !success;
+    webupdate_release_client();
+    webupdate_client = NULL;
+    free( webupdate_ring );
+    webupdate_ring = NULL;
+    _webupdate_Task = NULL;
+    xSemaphoreGive( webupdate_mutex );
+
+    if ( success ) {
+        log_i("update complete, restart");
+        delay( WEBUPDATE_RESTART_DELAY );
+        ESP.restart();
+    }
+    vTaskDelete( NULL );
+}
@@ -0,0 +1,46 @@
+/****************************************************************************
+ *   Sep 08 19:36:12 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _WEBUPDATE_H
+    #define _WEBUPDATE_H
+
+    #include <ESPAsyncWebServer.h>
+
+    #define WEBUPDATE_URL               "/update"           /** @brief GET for the upload page, POST the image as multipart form */
+    #define WEBUPDATE_EVENTS_URL        "/update/events"    /** @brief server-sent events: progress, done and fail */
+    #define WEBUPDATE_SHA256_PARAM      "sha256"            /** @brief query parameter with the expected sha256 */
+    #define WEBUPDATE_SIZE_PARAM        "size"              /** @brief query parameter with the image size, optional */
+    #define WEBUPDATE_RING_SIZE         32768               /** @brief upload buffer between the async_tcp task and the webupdate task */
+    #define WEBUPDATE_HOLD_ACK          16384               /** @brief buffered bytes from which the tcp window is held back, the rest takes what is already on the way */
+    #define WEBUPDATE_CHUNK_SIZE        4096                /** @brief bytes the webupdate task takes from the ring at once */
+    #define WEBUPDATE_RESTART_DELAY     1000                /** @brief time in ms to send the last events before the restart */
+
+    /*
+     * @brief add the firmware and spiffs upload to the webserver. the image is written
+     * with otaupdate while it is received and only activated if the sha256 matches.
+     * the POST is answered with 202 when the file is received, the result of the
+     * verify is send as server-sent event
+     *
+     * @param   server      pointer to the webserver
+     */
+    void webupdate_setup( AsyncWebServer *server );
+
+#endif // _WEBUPDATE_H
@@ -0,0 +1,272 @@
+/****************************************************************************
+ *   Sep 22 20:14:36 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NATIVE_ARDUINO_H
+    #define _NATIVE_ARDUINO_H
+
+    /*
+     * host stand-ins for the arduino, esp32 and freertos parts the tested modules use,
+     * only for the native test env. the clock is virtual, delay() moves it forward
+     * without waiting, so timeouts are tested in no time
+     */
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <stdio.h>
+    #include <stdlib.h>
+    #include <string.h>
+    #include <strings.h>
+    #include <ctype.h>
+    #include <math.h>
+    #include <time.h>
+    #include <string>
+    #include <vector>
+    #include <algorithm>
+    #include <functional>
+    #include <deque>
+    #include <atomic>
+    #include <mutex>
+    #include <thread>
+    #include <chrono>
+    #include <condition_variable>
+
+    /*
+     * log output only with NATIVE_LOG=1 in the environment
+     */
+    #define native_log( level, ... )    do { if ( getenv( "NATIVE_LOG" ) ) { fprintf( stderr, "[" level "] " __VA_ARGS__ ); fputc( '\n', stderr ); } } while( 0 )
+    #define log_d( ... )                native_log( "D", __VA_ARGS__ )
+    #define log_i( ... )                native_log( "I", __VA_ARGS__ )
+    #define log_w( ... )                native_log( "W", __VA_ARGS__ )
+    #define log_e( ... )                native_log( "E", __VA_ARGS__ )
+
+    #define _BV( b )                    ( 1UL << ( b ) )
+    #ifndef MIN
+        #define MIN( a, b )             ( ( a ) < ( b ) ? ( a ) : ( b ) )
+    #endif
+    #define PROGMEM
+
+    /*
+     * millis() is 32 bit like on the esp32, so the wrap after 49 days can be tested
+     */
+    inline std::atomic<uint32_t> native_clock( 0 );
+
+    static inline uint32_t millis( void ) { return( native_clock ); }
+    static inline void delay( uint32_t ms ) { native_clock += ms; std::this_thread::yield(); }
+
+    static inline void *ps_malloc( size_t size ) { return( malloc( size ) ); }
+    static inline void *ps_calloc( size_t count, size_t size ) { return( calloc( count, size ) ); }
+    static inline void *ps_realloc( void *ptr, size_t size ) { return( realloc( ptr, size ) ); }
+
+    static inline size_t native_strlcpy( char *dst, const char *src, size_t size ) {
+        size_t len = strlen( src );
+        if ( size ) {
+            size_t copy = len < size - 1 ? len : size - 1;
+            memcpy( dst, src, copy );
+            dst[ copy ] = '\0';
+        }
+        return( len );
+    }
+    #define strlcpy                     native_strlcpy
+
+    /*
+     * freertos, tasks are threads and the ticks are real ms
+     */
+    typedef uint32_t TickType_t;
+    typedef uint32_t EventBits_t;
+    typedef int BaseType_t;
+    typedef unsigned int UBaseType_t;
+    typedef void *TaskHandle_t;
+
+    #define pdTRUE                      1
+    #define pdFALSE                     0
+    #define pdPASS                      1
+    #define pdFAIL                      0
+    #define portMAX_DELAY               0xffffffff
+    #define portTICK_PERIOD_MS          1
+    #define pdMS_TO_TICKS( ms )         ( ms )
+
+    typedef std::recursive_mutex portMUX_TYPE;
+    #define portMUX_INITIALIZER_UNLOCKED {}
+    #define portENTER_CRITICAL( mux )   ( mux )->lock()
+    #define portEXIT_CRITICAL( mux )    ( mux )->unlock()
+
+    struct native_queue_t {
+        std::mutex lock;
+        std::condition_variable changed;
+        std::deque< std::vector< uint8_t > > items;
+        size_t item_size = 0;
+        size_t length = 0;
+    };
+    typedef native_queue_t *QueueHandle_t;
+    typedef native_queue_t *SemaphoreHandle_t;
+
+    static inline bool native_wait( native_queue_t *queue, std::unique_lock< std::mutex > &lock, TickType_t ticks, bool for_space ) {
+        auto ready = [ queue, for_space ]() { return( for_space ? queue->items.size() < queue->length : !queue->items.empty() ); };
+        if ( ticks == portMAX_DELAY ) {
+            queue->changed.wait( lock, ready );
+            return( true );
+        }
+        return( queue->changed.wait_for( lock, std::chrono::milliseconds( ticks ), ready ) );
+    }
+    static inline QueueHandle_t xQueueCreate( UBaseType_t length, UBaseType_t item_size ) {
+        native_queue_t *queue = new native_queue_t;
+        queue->length = length;
+        queue->item_size = item_size;
+        return( queue );
+    }
+    static inline void vQueueDelete( QueueHandle_t queue ) { delete queue; }
+    static inline BaseType_t xQueueSend( QueueHandle_t queue, const void *item, TickType_t ticks ) {
+        std::unique_lock< std::mutex > lock( queue->lock );
+        if ( !native_wait( queue, lock, ticks, true ) ) {
+            return( pdFALSE );
+        }
+        queue->items.emplace_back( (const uint8_t *)item, (const uint8_t *)item + queue->item_size );
+        queue->changed.notify_all();
+        return( pdTRUE );
+    }
+    static inline BaseType_t xQueueReceive( QueueHandle_t queue, void *item, TickType_t ticks ) {
+        std::unique_lock< std::mutex > lock( queue->lock );
+        if ( !native_wait( queue, lock, ticks, false ) ) {
+            return( pdFALSE );
+        }
+        memcpy( item, queue->items.front().data(), queue->item_size );
+        queue->items.pop_front();
+        queue->changed.notify_all();
+        return( pdTRUE );
+    }
+    static inline BaseType_t xQueueReset( QueueHandle_t queue ) {
+        std::unique_lock< std::mutex > lock( queue->lock );
+        queue->items.clear();
+        queue->changed.notify_all();
+        return( pdPASS );
+    }
+    static inline UBaseType_t uxQueueMessagesWaiting( QueueHandle_t queue ) {
+        std::unique_lock< std::mutex > lock( queue->lock );
+        return( queue->items.size() );
+    }
+    static inline SemaphoreHandle_t xSemaphoreCreateBinary( void ) { return( xQueueCreate( 1, 0 ) ); }
+    static inline BaseType_t xSemaphoreGive( SemaphoreHandle_t semaphore ) { return( xQueueSend( semaphore, NULL, 0 ) ); }
+    static inline BaseType_t xSemaphoreTake( SemaphoreHandle_t semaphore, TickType_t ticks ) {
+        uint8_t dummy;
+        return( xQueueReceive( semaphore, &dummy, ticks ) );
+    }
+    static inline SemaphoreHandle_t xSemaphoreCreateMutex( void ) {
+        SemaphoreHandle_t mutex = xSemaphoreCreateBinary();
+        xSemaphoreGive( mutex );
+        return( mutex );
+    }
+    static inline void vSemaphoreDelete( SemaphoreHandle_t semaphore ) { vQueueDelete( semaphore ); }
+
+    /*
+     * like freertos the handle is set before the task runs, a task may clear it itself
+     */
+    static inline BaseType_t xTaskCreate( void ( *task )( void * ), const char *name, uint32_t stack, void *param, UBaseType_t prio, TaskHandle_t *handle ) {
+        if ( handle ) {
+            *handle = (TaskHandle_t)1;
+        }
+        std::thread( task, param ).detach();
+        return( pdPASS );
+    }
+    /*
+     * a task ends with vTaskDelete( NULL ), here the thread ends when the task function returns
+     */
+    static inline void vTaskDelete( TaskHandle_t task ) {}
+    static inline void vTaskDelay( TickType_t ticks ) { std::this_thread::sleep_for( std::chrono::milliseconds( ticks ) ); }
+
+    class String : public std::string {
+        public:
+            String( const char *str = "" ) : std::string( str ) {}
+            String( const std::string &str ) : std::string( str ) {}
+            int indexOf( const char *str ) const {
+                size_t pos = find( str );
+                return( pos == npos ? -1 : (int)pos );
+            }
+            long toInt( void ) const { return( atol( c_str() ) ); }
+    };
+
+    /*
+     * a restart is only counted
+     */
+    class EspClass {
+        public:
+            std::atomic<int> restarts{ 0 };
+            void restart( void ) { restarts++; }
+            uint32_t getFreeHeap( void ) { return( 160000 ); }
+    };
+    inline EspClass ESP;
+
+    class Print {
+        public:
+            virtual ~Print() {}
+            virtual size_t write( uint8_t data ) = 0;
+            virtual size_t write( const uint8_t *buffer, size_t size ) {
+                size_t n = 0;
+                while( n < size && write( buffer[ n ] ) ) {
+                    n++;
+                }
+                return( n );
+            }
+            size_t print( const char *str ) { return( write( (const uint8_t *)str, strlen( str ) ) ); }
+            virtual void flush( void ) {}
+    };
+
+    class Stream : public Print {
+        public:
+            virtual int available( void ) = 0;
+            virtual int read( void ) = 0;
+            virtual int peek( void ) = 0;
+            virtual size_t readBytes( char *buffer, size_t length ) {
+                size_t n = 0;
+                while( n < length ) {
+                    int c = read();
+                    if ( c < 0 ) {
+                        break;
+                    }
+                    buffer[ n++ ] = c;
+                }
+                return( n );
+            }
+            using Print::write;
+    };
+
+    class IPAddress {
+        public:
+            uint32_t addr = 0;
+
+            IPAddress( void ) {}
+            IPAddress( uint32_t a ) : addr( a ) {}
+            operator uint32_t( void ) const { return( addr ); }
+            bool fromString( const char *str ) {
+                unsigned int a, b, c, d;
+                char end;
+                if ( sscanf( str, "%u.%u.%u.%u%c", &a, &b, &c, &d, &end ) != 4 || a > 255 || b > 255 || c > 255 || d > 255 ) {
+                    return( false );
+                }
+                addr = a << 24 | b << 16 | c << 8 | d;
+                return( true );
+            }
+            String toString( void ) const {
+                char str[ 16 ];
+                snprintf( str, sizeof( str ), "%d.%d.%d.%d", addr >> 24, ( addr >> 16 ) & 0xff, ( addr >> 8 ) & 0xff, addr & 0xff );
+                return( String( str ) );
+            }
+    };
+
+#endif // _NATIVE_ARDUINO_H
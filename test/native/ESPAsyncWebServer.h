@@ -0,0 +1,211 @@
+/****************************************************************************
+ *   Sep 23 19:02:11 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NATIVE_ESPASYNCWEBSERVER_H
+    #define _NATIVE_ESPASYNCWEBSERVER_H
+
+    /*
+     * the parts of the async webserver the tested modules use. the test plays the
+     * async_tcp task and the sender: it calls the handlers that were registered and
+     * counts the bytes the handler has held back with ackLater() as not acked
+     */
+    #include "Arduino.h"
+    #include <map>
+
+    typedef enum {
+        HTTP_GET     = 0b00000001,
+        HTTP_POST    = 0b00000010
+    } WebRequestMethod;
+
+    class AsyncClient {
+        public:
+            size_t held_total = 0;                  /** @brief bytes that were held back at any time */
+
+            void ackLater( void ) { ack_pcb = false; }
+            size_t ack( size_t len ) {
+                std::lock_guard< std::mutex > guard( lock );
+                if ( len > rx_ack_len ) {
+                    len = rx_ack_len;
+                }
+                rx_ack_len -= len;
+                return( len );
+            }
+            /*
+             * after the receive callback of a packet, like AsyncClient::_recv()
+             */
+            void native_received( size_t len ) {
+                std::lock_guard< std::mutex > guard( lock );
+                if ( !ack_pcb ) {
+                    rx_ack_len += len;
+                    held_total += len;
+                }
+                ack_pcb = true;
+            }
+            size_t native_unacked( void ) {
+                std::lock_guard< std::mutex > guard( lock );
+                return( rx_ack_len );
+            }
+
+        private:
+            std::mutex lock;
+            size_t rx_ack_len = 0;
+            bool ack_pcb = true;
+    };
+
+    class AsyncWebParameter {
+        public:
+            AsyncWebParameter( const String &value ) : param_value( value ) {}
+            const String &value( void ) const { return( param_value ); }
+
+        private:
+            String param_value;
+    };
+
+    typedef std::function< size_t( uint8_t *buffer, size_t maxLen, size_t index ) > AwsResponseFiller;
+
+    /*
+     * a chunked response keeps its filler, the test calls it like the tcp sender does
+     */
+    class AsyncWebServerResponse {
+        public:
+            std::string content_type;
+            std::map< std::string, std::string > headers;
+            AwsResponseFiller filler;
+            size_t index = 0;
+
+            void addHeader( const char *name, const char *value ) { headers[ name ] = value; }
+    };
+
+    class AsyncWebServerRequest {
+        public:
+            std::map< std::string, AsyncWebParameter > params;
+            int response_code = 0;
+            std::string response_body;
+            AsyncWebServerResponse *response = NULL;
+            String url_path = "/";
+
+            ~AsyncWebServerRequest() { delete response; }
+
+            bool hasParam( const char *name ) { return( params.count( name ) != 0 ); }
+            AsyncWebParameter *getParam( const char *name ) { return( &params.at( name ) ); }
+            AsyncClient *client( void ) { return( &tcp_client ); }
+            void onDisconnect( std::function< void( void ) > fn ) { disconnect_fn = fn; }
+            const String &url( void ) const { return( url_path ); }
+            void send( int code ) { response_code = code; }
+            void send( int code, const char *type, const String &body ) {
+                response_code = code;
+                response_body = body;
+            }
+            void send_P( int code, const char *type, const char *body ) { send( code, type, body ); }
+            AsyncWebServerResponse *beginChunkedResponse( const char *type, AwsResponseFiller filler ) {
+                AsyncWebServerResponse *chunked = new AsyncWebServerResponse();
+                chunked->content_type = type;
+                chunked->filler = filler;
+                return( chunked );
+            }
+            void send( AsyncWebServerResponse *chunked ) {
+                delete response;
+                response = chunked;
+                response_code = 200;
+            }
+            /*
+             * fill chunks of max_len until the filler returns 0, like the sender with a
+             * window of max_len bytes
+             */
+            size_t native_fill( size_t max_len, size_t *chunks = NULL ) {
+                std::vector< uint8_t > buffer( max_len );
+                size_t len, n = 0;
+                while( response && ( len = response->filler( buffer.data(), max_len, response->index ) ) > 0 ) {
+                    response_body.append( (const char *)buffer.data(), len );
+                    response->index += len;
+                    n++;
+                }
+                if ( chunks ) {
+                    *chunks = n;
+                }
+                return( response_body.size() );
+            }
+            void native_disconnect( void ) {
+                if ( disconnect_fn ) {
+                    disconnect_fn();
+                }
+            }
+
+        private:
+            AsyncClient tcp_client;
+            std::function< void( void ) > disconnect_fn;
+    };
+
+    typedef std::function< void( AsyncWebServerRequest *request ) > ArRequestHandlerFunction;
+    typedef std::function< void( AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len, bool final ) > ArUploadHandlerFunction;
+
+    /*
+     * events are kept as "event: data" lines, they are send from several tasks
+     */
+    class AsyncEventSource {
+        public:
+            AsyncEventSource( const char *url ) {}
+            void send( const char *message, const char *event, uint32_t id ) {
+                std::lock_guard< std::mutex > guard( lock );
+                events.push_back( std::string( event ) + ": " + message );
+            }
+            std::vector< std::string > native_events( void ) {
+                std::lock_guard< std::mutex > guard( lock );
+                return( events );
+            }
+            void native_clear( void ) {
+                std::lock_guard< std::mutex > guard( lock );
+                events.clear();
+            }
+
+        private:
+            std::mutex lock;
+            std::vector< std::string > events;
+    };
+
+    typedef struct {
+        std::string url;
+        int method;
+        ArRequestHandlerFunction on_request;
+        ArUploadHandlerFunction on_upload;
+    } native_web_handler_t;
+
+    class AsyncWebServer {
+        public:
+            std::vector< native_web_handler_t > handlers;
+            std::vector< AsyncEventSource * > event_sources;
+
+            AsyncWebServer( uint16_t port ) {}
+            void addHandler( AsyncEventSource *source ) { event_sources.push_back( source ); }
+            void on( const char *url, int method, ArRequestHandlerFunction on_request, ArUploadHandlerFunction on_upload = NULL ) {
+                handlers.push_back( { url, method, on_request, on_upload } );
+            }
+            native_web_handler_t *native_handler( const char *url, int method ) {
+                for ( auto &handler : handlers ) {
+                    if ( handler.url == url && handler.method == method ) {
+                        return( &handler );
+                    }
+                }
+                return( NULL );
+            }
+    };
+
+#endif // _NATIVE_ESPASYNCWEBSERVER_H
@@ -0,0 +1,110 @@
+/****************************************************************************
+ *   Sep 22 20:14:36 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NATIVE_SPIFFS_H
+    #define _NATIVE_SPIFFS_H
+
+    /*
+     * SPIFFS in ram, the files are in native_files and can be checked by the test
+     */
+    #include "Arduino.h"
+    #include <map>
+    #include <memory>
+
+    #define FILE_READ               "r"
+    #define FILE_WRITE              "w"
+    #define FILE_APPEND             "a"
+
+    inline std::map< std::string, std::shared_ptr< std::string > > native_files;
+
+    namespace fs {
+        class File : public Stream {
+            public:
+                File( void ) {}
+                File( std::shared_ptr< std::string > data, bool writeable ) : data( data ), writeable( writeable ) {}
+
+                operator bool( void ) const { return( data != NULL ); }
+                int available( void ) { return( data ? data->size() - pos : 0 ); }
+                int read( void ) { return( available() > 0 ? (uint8_t)( *data )[ pos++ ] : -1 ); }
+                int peek( void ) { return( available() > 0 ? (uint8_t)( *data )[ pos ] : -1 ); }
+                size_t read( uint8_t *buffer, size_t size ) {
+                    size_t len = available() < (int)size ? available() : size;
+                    memcpy( buffer, data->data() + pos, len );
+                    pos += len;
+                    return( len );
+                }
+                size_t write( uint8_t c ) { return( write( &c, 1 ) ); }
+                size_t write( const uint8_t *buffer, size_t size ) {
+                    if ( !data || !writeable ) {
+                        return( 0 );
+                    }
+                    data->replace( pos, std::min( size, data->size() - pos ), (const char *)buffer, size );
+                    pos += size;
+                    return( size );
+                }
+                bool seek( size_t position ) {
+                    if ( !data || position > data->size() ) {
+                        return( false );
+                    }
+                    pos = position;
+                    return( true );
+                }
+                size_t position( void ) { return( pos ); }
+                size_t size( void ) { return( data ? data->size() : 0 ); }
+                void close( void ) { data.reset(); }
+
+            private:
+                std::shared_ptr< std::string > data;
+                size_t pos = 0;
+                bool writeable = false;
+        };
+    }
+
+    class SPIFFSClass {
+        public:
+            bool exists( const char *path ) { return( native_files.count( path ) != 0 ); }
+            fs::File open( const char *path, const char *mode = FILE_READ ) {
+                if ( !strcmp( mode, FILE_READ ) ) {
+                    return( exists( path ) ? fs::File( native_files[ path ], false ) : fs::File() );
+                }
+                if ( !strcmp( mode, FILE_WRITE ) || !exists( path ) ) {
+                    native_files[ path ] = std::make_shared< std::string >();
+                }
+                fs::File file( native_files[ path ], true );
+                if ( !strcmp( mode, FILE_APPEND ) ) {
+                    file.seek( file.size() );
+                }
+                return( file );
+            }
+            bool remove( const char *path ) { return( native_files.erase( path ) != 0 ); }
+            bool rename( const char *from, const char *to ) {
+                if ( !exists( from ) ) {
+                    return( false );
+                }
+                native_files[ to ] = native_files[ from ];
+                native_files.erase( from );
+                return( true );
+            }
+    };
+
+    inline SPIFFSClass SPIFFS;
+
+#endif // _NATIVE_SPIFFS_H
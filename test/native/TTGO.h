@@ -0,0 +1,34 @@
+/****************************************************************************
+ *   Sep 22 20:14:36 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NATIVE_TTGO_H
+    #define _NATIVE_TTGO_H
+
+    #include "Arduino.h"
+
+    /*
+     * only the lvgl types a tested header needs for its prototypes
+     */
+    typedef struct _lv_obj_t lv_obj_t;
+    typedef struct _lv_style_t lv_style_t;
+    typedef int16_t lv_coord_t;
+
+#endif // _NATIVE_TTGO_H
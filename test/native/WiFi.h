@@ -0,0 +1,143 @@
+/****************************************************************************
+ *   Sep 22 20:14:36 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NATIVE_WIFI_H
+    #define _NATIVE_WIFI_H
+
+    /*
+     * WiFiClient on an in-process network, the servers are objects in the test that
+     * see every connect, every byte the client sends and can close the connection
+     */
+    #include "Arduino.h"
+    #include <map>
+    #include <memory>
+
+    #define WL_CONNECTED            3
+    #define WL_DISCONNECTED         6
+
+    struct native_socket_t {
+        std::string to_client;                      /** @brief data send by the server */
+        size_t to_client_pos = 0;                   /** @brief read position of the client */
+        std::string from_client;                    /** @brief data send by the client, consumed by the server */
+        bool server_closed = false;
+        bool client_closed = false;
+    };
+
+    class NativeServer {
+        public:
+            virtual ~NativeServer() {}
+            virtual void accept( std::shared_ptr< native_socket_t > socket ) = 0;
+            virtual void receive( native_socket_t *socket ) = 0;
+    };
+
+    inline std::map< uint16_t, NativeServer * > native_servers;
+    inline bool native_wifi_connected = true;
+    inline uint32_t native_dns_lookups = 0;
+
+    class WiFiClient {
+        public:
+            int connect( IPAddress ip, uint16_t port, int32_t timeout = 0 ) {
+                stop();
+                auto server = native_servers.find( port );
+                if ( !native_wifi_connected || ip == 0 || server == native_servers.end() ) {
+                    return( 0 );
+                }
+                socket = std::make_shared< native_socket_t >();
+                owner = server->second;
+                owner->accept( socket );
+                return( 1 );
+            }
+            /*
+             * like on the esp32 a connection closed by the server is connected until everything is read
+             */
+            uint8_t connected( void ) {
+                return( socket && native_wifi_connected && !socket->client_closed && ( !socket->server_closed || available() ) );
+            }
+            int available( void ) {
+                return( socket && native_wifi_connected ? socket->to_client.size() - socket->to_client_pos : 0 );
+            }
+            int read( void ) {
+                if ( available() <= 0 ) {
+                    return( -1 );
+                }
+                return( (uint8_t)socket->to_client[ socket->to_client_pos++ ] );
+            }
+            int read( uint8_t *buffer, size_t size ) {
+                int len = available();
+                if ( len <= 0 ) {
+                    return( -1 );
+                }
+                len = (size_t)len < size ? len : size;
+                memcpy( buffer, socket->to_client.data() + socket->to_client_pos, len );
+                socket->to_client_pos += len;
+                return( len );
+            }
+            int peek( void ) {
+                return( available() > 0 ? (uint8_t)socket->to_client[ socket->to_client_pos ] : -1 );
+            }
+            /*
+             * like tcp, data send after the server has closed is accepted and lost
+             */
+            size_t write( const uint8_t *buffer, size_t size ) {
+                if ( !socket || !native_wifi_connected || socket->client_closed ) {
+                    return( 0 );
+                }
+                if ( socket->server_closed ) {
+                    return( size );
+                }
+                socket->from_client.append( (const char *)buffer, size );
+                owner->receive( socket.get() );
+                return( size );
+            }
+            size_t write( uint8_t data ) { return( write( &data, 1 ) ); }
+            void stop( void ) {
+                if ( socket ) {
+                    socket->client_closed = true;
+                }
+                socket.reset();
+            }
+
+        private:
+            std::shared_ptr< native_socket_t > socket;
+            NativeServer *owner = NULL;
+    };
+
+    class WiFiClass {
+        public:
+            int status( void ) { return( native_wifi_connected ? WL_CONNECTED : WL_DISCONNECTED ); }
+            bool isConnected( void ) { return( native_wifi_connected ); }
+            /*
+             * every name but "invalid" is the local host
+             */
+            int hostByName( const char *host, IPAddress &ip ) {
+                native_dns_lookups++;
+                if ( !native_wifi_connected || !strcmp( host, "invalid" ) ) {
+                    ip = IPAddress( 0 );
+                    return( 0 );
+                }
+                ip = IPAddress( 0x7f000001 );
+                return( 1 );
+            }
+    };
+
+    inline WiFiClass WiFi;
+
+#endif // _NATIVE_WIFI_H
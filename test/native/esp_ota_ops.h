@@ -0,0 +1,45 @@
+/****************************************************************************
+ *   Sep 23 19:02:11 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NATIVE_ESP_OTA_OPS_H
+    #define _NATIVE_ESP_OTA_OPS_H
+
+    /*
+     * app0 is running, app1 is the next update partition
+     */
+    #include "esp_partition.h"
+
+    inline const esp_partition_t *native_boot_partition = &native_partitions[ 0 ];
+
+    static inline const esp_partition_t *esp_ota_get_running_partition( void ) {
+        return( &native_partitions[ 0 ] );
+    }
+
+    static inline const esp_partition_t *esp_ota_get_next_update_partition( const esp_partition_t *start ) {
+        return( &native_partitions[ 1 ] );
+    }
+
+    static inline esp_err_t esp_ota_set_boot_partition( const esp_partition_t *partition ) {
+        native_boot_partition = partition;
+        return( ESP_OK );
+    }
+
+#endif // _NATIVE_ESP_OTA_OPS_H
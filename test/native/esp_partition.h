@@ -0,0 +1,124 @@
+/****************************************************************************
+ *   Sep 23 19:02:11 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NATIVE_ESP_PARTITION_H
+    #define _NATIVE_ESP_PARTITION_H
+
+    /*
+     * the flash partitions in ram. an erase costs native_flash_sector_us of real time
+     * per sector and waits while native_flash_stalled is set, like a busy flash. a write
+     * into bytes that are not erased is counted in native_flash_violations
+     */
+    #include "Arduino.h"
+
+    typedef int esp_err_t;
+
+    #define ESP_OK                              0
+    #define ESP_FAIL                            -1
+    #define ESP_ERR_INVALID_SIZE                0x104
+
+    typedef enum {
+        ESP_PARTITION_TYPE_APP = 0x00,
+        ESP_PARTITION_TYPE_DATA = 0x01
+    } esp_partition_type_t;
+
+    typedef enum {
+        ESP_PARTITION_SUBTYPE_APP_OTA_0 = 0x10,
+        ESP_PARTITION_SUBTYPE_APP_OTA_1 = 0x11,
+        ESP_PARTITION_SUBTYPE_DATA_SPIFFS = 0x82
+    } esp_partition_subtype_t;
+
+    typedef struct {
+        esp_partition_type_t type;
+        esp_partition_subtype_t subtype;
+        uint32_t address;
+        uint32_t size;
+        char label[ 17 ];
+    } esp_partition_t;
+
+    #define NATIVE_FLASH_SECTOR_SIZE            4096
+
+    inline esp_partition_t native_partitions[] = {
+        { ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, 0x010000, 0x1E0000, "app0" },
+        { ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_1, 0x1F0000, 0x1E0000, "app1" },
+        { ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, 0x3D0000, 0x030000, "spiffs" }
+    };
+    inline std::vector< uint8_t > native_partition_data[ 3 ];
+    inline std::atomic<uint32_t> native_flash_sector_us( 0 );
+    inline std::atomic<bool> native_flash_stalled( false );
+    inline std::atomic<size_t> native_flash_violations( 0 );
+
+    static inline std::vector< uint8_t > &native_partition( const esp_partition_t *partition ) {
+        std::vector< uint8_t > &data = native_partition_data[ partition - native_partitions ];
+        if ( data.size() != partition->size ) {
+            data.assign( partition->size, 0x00 );
+        }
+        return( data );
+    }
+
+    static inline const esp_partition_t *esp_partition_find_first( esp_partition_type_t type, esp_partition_subtype_t subtype, const char *label ) {
+        for ( auto &partition : native_partitions ) {
+            if ( partition.type == type && partition.subtype == subtype && ( label == NULL || !strcmp( label, partition.label ) ) ) {
+                return( &partition );
+            }
+        }
+        return( NULL );
+    }
+
+    static inline esp_err_t esp_partition_read( const esp_partition_t *partition, size_t offset, void *dst, size_t size ) {
+        if ( offset + size > partition->size ) {
+            return( ESP_ERR_INVALID_SIZE );
+        }
+        memcpy( dst, native_partition( partition ).data() + offset, size );
+        return( ESP_OK );
+    }
+
+    static inline esp_err_t esp_partition_write( const esp_partition_t *partition, size_t offset, const void *src, size_t size ) {
+        if ( offset + size > partition->size ) {
+            return( ESP_ERR_INVALID_SIZE );
+        }
+        uint8_t *data = native_partition( partition ).data() + offset;
+        for ( size_t i = 0 ; i < size ; i++ ) {
+            if ( data[ i ] != 0xff ) {
+                native_flash_violations++;
+            }
+        }
+        memcpy( data, src, size );
+        return( ESP_OK );
+    }
+
+    static inline esp_err_t esp_partition_erase_range( const esp_partition_t *partition, size_t offset, size_t size ) {
+        if ( offset + size > partition->size || offset % NATIVE_FLASH_SECTOR_SIZE || size % NATIVE_FLASH_SECTOR_SIZE ) {
+            return( ESP_ERR_INVALID_SIZE );
+        }
+        while( native_flash_stalled ) {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+        std::this_thread::sleep_for( std::chrono::microseconds( native_flash_sector_us * ( size / NATIVE_FLASH_SECTOR_SIZE ) ) );
+        memset( native_partition( partition ).data() + offset, 0xff, size );
+        return( ESP_OK );
+    }
+
+    static inline const char *esp_err_to_name( esp_err_t err ) {
+        return( err == ESP_OK ? "ESP_OK" : "ESP_FAIL" );
+    }
+
+#endif // _NATIVE_ESP_PARTITION_H
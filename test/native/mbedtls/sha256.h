@@ -0,0 +1,115 @@
+/****************************************************************************
+ *   Sep 23 19:02:11 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NATIVE_MBEDTLS_SHA256_H
+    #define _NATIVE_MBEDTLS_SHA256_H
+
+    /*
+     * plain sha256 with the mbedtls interface, the native env has no mbedtls
+     */
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <string.h>
+
+    typedef struct {
+        uint32_t state[ 8 ];
+        uint64_t total;
+        uint8_t buffer[ 64 ];
+    } mbedtls_sha256_context;
+
+    static inline uint32_t native_sha256_ror( uint32_t x, int n ) { return( x >> n | x << ( 32 - n ) ); }
+
+    static inline void native_sha256_block( mbedtls_sha256_context *ctx, const uint8_t *block ) {
+        static const uint32_t k[ 64 ] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+        uint32_t w[ 64 ], s[ 8 ];
+
+        for ( int i = 0 ; i < 16 ; i++ ) {
+            w[ i ] = (uint32_t)block[ i * 4 ] << 24 | block[ i * 4 + 1 ] << 16 | block[ i * 4 + 2 ] << 8 | block[ i * 4 + 3 ];
+        }
+        for ( int i = 16 ; i < 64 ; i++ ) {
+            uint32_t s0 = native_sha256_ror( w[ i - 15 ], 7 ) ^ native_sha256_ror( w[ i - 15 ], 18 ) ^ ( w[ i - 15 ] >> 3 );
+            uint32_t s1 = native_sha256_ror( w[ i - 2 ], 17 ) ^ native_sha256_ror( w[ i - 2 ], 19 ) ^ ( w[ i - 2 ] >> 10 );
+            w[ i ] = w[ i - 16 ] + s0 + w[ i - 7 ] + s1;
+        }
+        memcpy( s, ctx->state, sizeof( s ) );
+        for ( int i = 0 ; i < 64 ; i++ ) {
+            uint32_t t1 = s[ 7 ] + ( native_sha256_ror( s[ 4 ], 6 ) ^ native_sha256_ror( s[ 4 ], 11 ) ^ native_sha256_ror( s[ 4 ], 25 ) ) + ( ( s[ 4 ] & s[ 5 ] ) ^ ( ~s[ 4 ] & s[ 6 ] ) ) + k[ i ] + w[ i ];
+            uint32_t t2 = ( native_sha256_ror( s[ 0 ], 2 ) ^ native_sha256_ror( s[ 0 ], 13 ) ^ native_sha256_ror( s[ 0 ], 22 ) ) + ( ( s[ 0 ] & s[ 1 ] ) ^ ( s[ 0 ] & s[ 2 ] ) ^ ( s[ 1 ] & s[ 2 ] ) );
+            memmove( &s[ 1 ], &s[ 0 ], sizeof( uint32_t ) * 7 );
+            s[ 4 ] += t1;
+            s[ 0 ] = t1 + t2;
+        }
+        for ( int i = 0 ; i < 8 ; i++ ) {
+            ctx->state[ i ] += s[ i ];
+        }
+    }
+
+    static inline void mbedtls_sha256_init( mbedtls_sha256_context *ctx ) { memset( ctx, 0, sizeof( *ctx ) ); }
+    static inline void mbedtls_sha256_free( mbedtls_sha256_context *ctx ) {}
+    static inline void mbedtls_sha256_clone( mbedtls_sha256_context *dst, const mbedtls_sha256_context *src ) { *dst = *src; }
+
+    static inline int mbedtls_sha256_starts_ret( mbedtls_sha256_context *ctx, int is224 ) {
+        static const uint32_t init[ 8 ] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+        memcpy( ctx->state, init, sizeof( init ) );
+        ctx->total = 0;
+        return( 0 );
+    }
+
+    static inline int mbedtls_sha256_update_ret( mbedtls_sha256_context *ctx, const unsigned char *data, size_t len ) {
+        while( len > 0 ) {
+            size_t used = ctx->total % 64;
+            size_t part = 64 - used < len ? 64 - used : len;
+            memcpy( ctx->buffer + used, data, part );
+            ctx->total += part;
+            data += part;
+            len -= part;
+            if ( ctx->total % 64 == 0 ) {
+                native_sha256_block( ctx, ctx->buffer );
+            }
+        }
+        return( 0 );
+    }
+
+    static inline int mbedtls_sha256_finish_ret( mbedtls_sha256_context *ctx, unsigned char *output ) {
+        uint64_t bits = ctx->total * 8;
+        uint8_t pad[ 72 ] = { 0x80 };
+        size_t padlen = ( ctx->total % 64 < 56 ? 56 : 120 ) - ctx->total % 64;
+
+        for ( int i = 0 ; i < 8 ; i++ ) {
+            pad[ padlen + i ] = bits >> ( 56 - i * 8 );
+        }
+        mbedtls_sha256_update_ret( ctx, pad, padlen + 8 );
+        for ( int i = 0 ; i < 32 ; i++ ) {
+            output[ i ] = ctx->state[ i / 4 ] >> ( 24 - ( i % 4 ) * 8 );
+        }
+        return( 0 );
+    }
+
+#endif // _NATIVE_MBEDTLS_SHA256_H
@@ -0,0 +1,36 @@
+/****************************************************************************
+ *   Sep 22 20:14:36 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _NATIVE_H
+    #define _NATIVE_H
+
+    /*
+     * include this first in a test. it takes the place of src/config.h, the include
+     * guard is set so the module under test gets this one and not the watch headers
+     */
+    #define _CONFIG_H
+
+    #define __FIRMWARE__            "2020092201"
+
+    #include "TTGO.h"
+    #include "SPIFFS.h"
+
+#endif // _NATIVE_H
@@ -0,0 +1,176 @@
+/****************************************************************************
+ *   Sep 22 20:14:36 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _STANDIN_HTTP_H
+    #define _STANDIN_HTTP_H
+
+    /*
+     * stand-in http/1.1 server on the native network. it counts tcp handshakes and
+     * requests, answers pipelined requests in order and can close a connection after
+     * a response or in the middle of a body to test lost connections
+     */
+    #include "WiFi.h"
+
+    typedef struct {
+        std::string path;
+        std::string headers;                        /** @brief all header lines */
+        uint32_t connection;                        /** @brief number of the tcp connection, 1 is the first */
+        bool pipelined;                             /** @brief send before the previous response was read */
+    } standin_http_request_t;
+
+    typedef struct {
+        int status = 200;
+        std::string headers;                        /** @brief additional header lines terminated with "\r\n" */
+        std::string body;
+        bool chunked = false;                       /** @brief send the body in chunks of chunk_size */
+        size_t chunk_size = 1000;
+        bool close = false;                         /** @brief send "Connection: close" and close after the response */
+        int32_t drop_after = -1;                    /** @brief close after that many bytes of the body */
+        bool no_response = false;                   /** @brief never answer, with close the connection is closed instead */
+    } standin_http_response_t;
+
+    typedef std::function< standin_http_response_t ( const standin_http_request_t &request ) > STANDIN_HTTP_HANDLER;
+
+    class StandinHttp : public NativeServer {
+        public:
+            uint32_t handshakes = 0;                /** @brief tcp connections accepted */
+            uint32_t requests = 0;
+            std::vector< standin_http_request_t > log;
+            STANDIN_HTTP_HANDLER handler;
+
+            StandinHttp( uint16_t port, STANDIN_HTTP_HANDLER handler ) : handler( handler ), port( port ) {
+                native_servers[ port ] = this;
+            }
+            ~StandinHttp() {
+                close_all();
+                native_servers.erase( port );
+            }
+            void accept( std::shared_ptr< native_socket_t > socket ) {
+                handshakes++;
+                connections.push_back( socket );
+            }
+            /*
+             * like a server that drops idle keep-alive connections
+             */
+            void close_all( void ) {
+                for ( auto &socket : connections ) {
+                    socket->server_closed = true;
+                }
+            }
+            /*
+             * get the value of a request header or "" if not found
+             */
+            static std::string header( const standin_http_request_t &request, const char *name ) {
+                size_t len = strlen( name );
+                size_t pos = 0;
+                while( pos < request.headers.size() ) {
+                    size_t end = request.headers.find( "\r\n", pos );
+                    std::string line = request.headers.substr( pos, end - pos );
+                    if ( line.size() > len && !strncasecmp( line.c_str(), name, len ) && line[ len ] == ':' ) {
+                        size_t value = line.find_first_not_of( ' ', len + 1 );
+                        return( value == std::string::npos ? "" : line.substr( value ) );
+                    }
+                    pos = end == std::string::npos ? end : end + 2;
+                }
+                return( "" );
+            }
+
+            void receive( native_socket_t *socket ) {
+                size_t end;
+
+                while( !socket->server_closed && ( end = socket->from_client.find( "\r\n\r\n" ) ) != std::string::npos ) {
+                    std::string head = socket->from_client.substr( 0, end + 2 );
+                    socket->from_client.erase( 0, end + 4 );
+
+                    standin_http_request_t request;
+                    size_t path = head.find( ' ' ) + 1;
+                    size_t line_end = head.find( "\r\n" );
+                    request.path = head.substr( path, head.find( ' ', path ) - path );
+                    request.headers = head.substr( line_end + 2 );
+                    request.connection = connection_number( socket );
+                    request.pipelined = socket->to_client_pos < socket->to_client.size();
+                    requests++;
+                    log.push_back( request );
+
+                    standin_http_response_t response = handler( request );
+                    if ( !response.no_response ) {
+                        send( socket, response );
+                    }
+                    else if ( response.close ) {
+                        socket->server_closed = true;
+                    }
+                }
+            }
+
+        private:
+            uint16_t port;
+            std::vector< std::shared_ptr< native_socket_t > > connections;
+
+            uint32_t connection_number( native_socket_t *socket ) {
+                for ( size_t i = 0 ; i < connections.size() ; i++ ) {
+                    if ( connections[ i ].get() == socket ) {
+                        return( i + 1 );
+                    }
+                }
+                return( 0 );
+            }
+
+            void send( native_socket_t *socket, const standin_http_response_t &response ) {
+                char line[ 64 ];
+                std::string body;
+
+                if ( response.chunked ) {
+                    for ( size_t pos = 0 ; pos < response.body.size() ; pos += response.chunk_size ) {
+                        std::string chunk = response.body.substr( pos, response.chunk_size );
+                        snprintf( line, sizeof( line ), "%zx\r\n", chunk.size() );
+                        body += line + chunk + "\r\n";
+                    }
+                    body += "0\r\n\r\n";
+                }
+                else {
+                    body = response.body;
+                }
+
+                snprintf( line, sizeof( line ), "HTTP/1.1 %d %s\r\n", response.status, response.status < 400 ? "OK" : "Error" );
+                socket->to_client += line;
+                if ( response.chunked ) {
+                    socket->to_client += "Transfer-Encoding: chunked\r\n";
+                }
+                else if ( response.status != 304 ) {
+                    snprintf( line, sizeof( line ), "Content-Length: %zu\r\n", body.size() );
+                    socket->to_client += line;
+                }
+                socket->to_client += response.close ? "Connection: close\r\n" : "Connection: keep-alive\r\n";
+                socket->to_client += response.headers + "\r\n";
+
+                if ( response.drop_after >= 0 && (size_t)response.drop_after < body.size() ) {
+                    socket->to_client += body.substr( 0, response.drop_after );
+                    socket->server_closed = true;
+                    return;
+                }
+                socket->to_client += body;
+                if ( response.close ) {
+                    socket->server_closed = true;
+                }
+            }
+    };
+
+#endif // _STANDIN_HTTP_H
@@ -0,0 +1,308 @@
+/****************************************************************************
+ *   Sep 27 14:12:30 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "hardware/bleconn.cpp"
+
+#include <unity.h>
+
+static bleconn_t conn;
+
+/*
+ * runs the loop every 5ms like blectl_loop() and returns the or of all updates,
+ * a requested level is taken by the phone at once
+ */
+static uint32_t run( uint32_t from, uint32_t to, bool advertising = true ) {
+    uint32_t updates = 0;
+
+    for ( uint32_t now = from ; now != to ; now += 5 ) {
+        uint32_t update = bleconn_loop( &conn, now, advertising );
+        if ( update & BLECONN_UPDATE_CONN ) {
+            bleconn_params( &conn, bleconn_levels[ conn.requested ].max_int, bleconn_levels[ conn.requested ].latency, now );
+        }
+        updates |= update;
+    }
+    return( updates );
+}
+
+void setUp( void ) {
+}
+
+void tearDown( void ) {
+}
+
+void test_levels_decay_without_traffic( void ) {
+    bleconn_init( &conn, 0 );
+    bleconn_connect( &conn, 0 );
+
+    TEST_ASSERT_EQUAL( BLECONN_UPDATE_CONN, bleconn_loop( &conn, 0, true ) & BLECONN_UPDATE_CONN );
+    TEST_ASSERT_EQUAL( BLECONN_LEVEL_BURST, conn.requested );
+    run( 0, BLECONN_BURST_HOLD - 5 );
+    TEST_ASSERT_EQUAL( BLECONN_LEVEL_BURST, conn.requested );
+    run( BLECONN_BURST_HOLD - 5, BLECONN_BURST_HOLD + 5 );
+    TEST_ASSERT_EQUAL( BLECONN_LEVEL_ACTIVE, conn.requested );
+    run( BLECONN_BURST_HOLD + 5, BLECONN_ACTIVE_HOLD + 5 );
+    TEST_ASSERT_EQUAL( BLECONN_LEVEL_IDLE, conn.requested );
+    TEST_ASSERT_EQUAL( 3, conn.requests );
+
+    /*
+     * a message goes to the burst level at once, without waiting for the request gap
+     */
+    bleconn_activity( &conn, 40000 );
+    TEST_ASSERT_EQUAL( BLECONN_UPDATE_CONN, run( 40000, 40005 ) & BLECONN_UPDATE_CONN );
+    TEST_ASSERT_EQUAL( BLECONN_LEVEL_BURST, conn.requested );
+    TEST_ASSERT_EQUAL( 24, conn.interval );
+}
+
+/*
+ * a slower level waits for the request gap, the phone is not asked on every message
+ */
+void test_slower_requests_keep_the_gap( void ) {
+    bleconn_init( &conn, 0 );
+    bleconn_connect( &conn, 0 );
+    run( 0, BLECONN_ACTIVE_HOLD + 5 );
+    uint32_t requests = conn.requests;
+
+    for ( uint32_t now = 40000 ; now < 60000 ; now += 5000 ) {
+        bleconn_activity( &conn, now );
+        run( now, now + 5000 );
+    }
+    TEST_ASSERT_LESS_OR_EQUAL( requests + 4, conn.requests );
+    for ( uint32_t now = 60000 ; now < 60000 + BLECONN_ACTIVE_HOLD + BLECONN_REQUEST_GAP ; now += 5 ) {
+        uint32_t last_request = conn.last_request;
+        if ( bleconn_loop( &conn, now, true ) & BLECONN_UPDATE_CONN ) {
+            TEST_ASSERT_GREATER_OR_EQUAL( BLECONN_REQUEST_GAP, now - last_request );
+        }
+    }
+    TEST_ASSERT_EQUAL( BLECONN_LEVEL_IDLE, conn.requested );
+}
+
+void test_transfer_holds_bulk( void ) {
+    bleconn_init( &conn, 0 );
+    bleconn_connect( &conn, 0 );
+    bleconn_bulk( &conn, true, 1000 );
+    run( 1000, 100000 );
+    TEST_ASSERT_EQUAL( BLECONN_LEVEL_BULK, conn.requested );
+    TEST_ASSERT_EQUAL( 12, conn.interval );
+
+    bleconn_bulk( &conn, false, 100000 );
+    run( 100000, 100000 + BLECONN_REQUEST_GAP + 5 );
+    TEST_ASSERT_EQUAL( BLECONN_LEVEL_BURST, conn.requested );
+}
+
+void test_advertising_backs_off( void ) {
+    static const uint32_t steps[] = { 0, 30000, 150000, 750000 };
+    uint32_t now = 0;
+
+    bleconn_init( &conn, 0 );
+    for ( int step = 0 ; step < 4 ; step++ ) {
+        TEST_ASSERT_EQUAL( BLECONN_UPDATE_ADV, run( now, steps[ step ] + 5 ) & BLECONN_UPDATE_ADV );
+        TEST_ASSERT_EQUAL( step, conn.adv_step );
+        now = steps[ step ] + 5;
+        if ( step < 3 ) {
+            TEST_ASSERT_EQUAL( 0, run( now, steps[ step + 1 ] - 5 ) & BLECONN_UPDATE_ADV );
+            now = steps[ step + 1 ] - 5;
+        }
+    }
+    TEST_ASSERT_EQUAL( 0, run( now, now + 3600000 ) & BLECONN_UPDATE_ADV );
+    TEST_ASSERT_EQUAL( 2056, bleconn_adv_step( &conn )->min_int );
+
+    /*
+     * fast again after the next disconnect, nothing while advertising is off
+     */
+    now += 3600000;
+    bleconn_connect( &conn, now );
+    bleconn_disconnect( &conn, now + 1000 );
+    TEST_ASSERT_EQUAL( 0, run( now + 1000, now + 20000, false ) & BLECONN_UPDATE_ADV );
+    TEST_ASSERT_EQUAL( BLECONN_UPDATE_ADV, bleconn_loop( &conn, now + 20000, true ) & BLECONN_UPDATE_ADV );
+    TEST_ASSERT_EQUAL( 32, bleconn_adv_step( &conn )->min_int );
+}
+
+/*
+ * 60s at 30ms are 2000 events, idle at 500ms with latency 3 is one event every 2s
+ */
+void test_event_count_and_duty( void ) {
+    bleconn_init( &conn, 0 );
+    bleconn_connect( &conn, 0 );
+    bleconn_params( &conn, 24, 0, 0 );
+    bleconn_activity( &conn, 0 );
+    bleconn_bulk( &conn, true, 0 );
+    bleconn_stats_reset( &conn, 0 );
+    TEST_ASSERT_EQUAL( 400 * 10000 / 30000, bleconn_duty( &conn, 60000 ) );
+    TEST_ASSERT_EQUAL( 2000, conn.conn_events );
+
+    bleconn_bulk( &conn, false, 60000 );
+    bleconn_params( &conn, 400, 3, 60000 );
+    bleconn_stats_reset( &conn, 60000 + BLECONN_BURST_HOLD );
+    bleconn_duty( &conn, 60000 + BLECONN_BURST_HOLD + 60000 );
+    TEST_ASSERT_EQUAL( 30, conn.conn_events );
+
+    bleconn_disconnect( &conn, 200000 );
+    bleconn_loop( &conn, 200000, true );
+    bleconn_stats_reset( &conn, 200000 );
+    bleconn_duty( &conn, 210000 );
+    // ( 32 + 48 ) * 0.625ms / 2 plus 5ms of advDelay
+    TEST_ASSERT_EQUAL( 10000 / 30, conn.adv_events );
+}
+
+/*
+ * millis() wraps after 49 days, the holds and steps go on over it
+ */
+void test_millis_wrap( void ) {
+    uint32_t start = 0xffffffff - 9999;
+
+    bleconn_init( &conn, start );
+    bleconn_connect( &conn, start );
+    run( start, start + BLECONN_ACTIVE_HOLD + 5 );
+    TEST_ASSERT_EQUAL( BLECONN_LEVEL_IDLE, conn.requested );
+    bleconn_params( &conn, 24, 0, start + BLECONN_ACTIVE_HOLD + 5 );
+    bleconn_stats_reset( &conn, start + BLECONN_ACTIVE_HOLD + 5 );
+    bleconn_duty( &conn, start + BLECONN_ACTIVE_HOLD + 5 + 30000 );
+    TEST_ASSERT_EQUAL( 1000, conn.conn_events );
+}
+
+/*
+ * 16 hours of gadgetbridge traffic: 15 bursts of 1 to 5 messages an hour, a
+ * transfer and two disconnects. the phone takes a request after 6 events. the
+ * fixed parameters before were out of range, so the phone kept its 45ms
+ */
+void test_a_day_of_traffic( void ) {
+    struct event_t { uint32_t t; int type; };
+    enum { MSG, BULK_ON, BULK_OFF, DISCONNECT, CONNECT };
+    const uint32_t day = 16 * 3600 * 1000u;
+    std::vector< event_t > events;
+    uint32_t random_state = 7;
+    int bursts = 0;
+    auto random = [&]() {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        return( random_state );
+    };
+
+    for ( uint32_t t = 60000 ; t < day ; ) {
+        t += (uint32_t)( -log( ( random() % 1000000 + 1 ) / 1000001.0 ) * 240000 );
+        bursts++;
+        for ( uint32_t i = 0 ; i < 1 + random() % 5 ; i++ ) {
+            events.push_back( { t + i * 1000, MSG } );
+        }
+    }
+    events.push_back( { 3 * 3600000u, BULK_ON } );
+    events.push_back( { 3 * 3600000u + 60000, BULK_OFF } );
+    events.push_back( { 5 * 3600000u, DISCONNECT } );
+    events.push_back( { 5 * 3600000u + 300000, CONNECT } );
+    events.push_back( { 9 * 3600000u, DISCONNECT } );
+    events.push_back( { 10 * 3600000u, CONNECT } );
+    std::stable_sort( events.begin(), events.end(), []( const event_t &a, const event_t &b ) { return( a.t < b.t ); } );
+
+    bleconn_init( &conn, 0 );
+    bleconn_connect( &conn, 0 );
+    uint16_t interval = 36, latency = 0;
+    bleconn_params( &conn, interval, latency, 0 );
+    int64_t pending_at = -1;
+    int pending_level = 0, msgs = 0, requests = 0, periods = 0;
+    uint64_t conn_events = 0, adv_events = 0, duty_sum = 0;
+    double wait_sum = 0, disconnected = 0;
+    uint32_t disconnect_at = 0;
+    bool connected = true;
+    size_t next = 0;
+
+    for ( uint32_t now = 0 ; now < day ; now += 5 ) {
+        for ( ; next < events.size() && events[ next ].t <= now ; next++ ) {
+            switch( events[ next ].type ) {
+                case MSG:           if ( connected ) {
+                                        bool quiet = now - conn.last_activity >= BLECONN_BURST_HOLD;
+                                        wait_sum += interval * 1.25 * ( quiet ? latency + 1 : 1 ) / 2;
+                                        msgs++;
+                                        bleconn_activity( &conn, now );
+                                    }
+                                    break;
+                case BULK_ON:       bleconn_bulk( &conn, true, now );
+                                    break;
+                case BULK_OFF:      bleconn_bulk( &conn, false, now );
+                                    break;
+                case DISCONNECT:    bleconn_disconnect( &conn, now );
+                                    connected = false;
+                                    disconnect_at = now;
+                                    break;
+                case CONNECT:       bleconn_connect( &conn, now );
+                                    connected = true;
+                                    disconnected += now - disconnect_at;
+                                    interval = 36;
+                                    latency = 0;
+                                    bleconn_params( &conn, interval, latency, now );
+                                    break;
+            }
+        }
+        uint32_t update = bleconn_loop( &conn, now, true );
+        if ( update & BLECONN_UPDATE_CONN ) {
+            requests++;
+            pending_level = conn.requested;
+            pending_at = now + 6 * interval * 5 / 4;
+        }
+        if ( pending_at >= 0 && now >= pending_at ) {
+            interval = bleconn_levels[ pending_level ].max_int;
+            latency = bleconn_levels[ pending_level ].latency;
+            bleconn_params( &conn, interval, latency, now );
+            pending_at = -1;
+        }
+        if ( update & BLECONN_STATS ) {
+            duty_sum += bleconn_duty( &conn, now );
+            periods++;
+            conn_events += conn.conn_events;
+            adv_events += conn.adv_events;
+            bleconn_stats_reset( &conn, now );
+        }
+    }
+
+    double fixed_conn = ( day - disconnected ) / 45.0;
+    double fixed_adv = disconnected / ( 93.75 + 5 );
+    double fixed_duty = ( fixed_conn * BLECONN_CONN_EVENT_US + fixed_adv * BLECONN_ADV_EVENT_US ) / ( day * 10.0 );
+    double duty = duty_sum / (double)periods / 100;
+    char msg[ 200 ];
+
+    snprintf( msg, sizeof( msg ), "adaptive: %d conn events, %d adv events, %d requests, radio duty %.3f%%, %.0fms average wait for a message (%d messages)",
+              (int)conn_events, (int)adv_events, requests, duty, wait_sum / msgs, msgs );
+    TEST_MESSAGE( msg );
+    snprintf( msg, sizeof( msg ), "fixed:    %.0f conn events, %.0f adv events, radio duty %.3f%%, 22ms average wait for a message",
+              fixed_conn, fixed_adv, fixed_duty );
+    TEST_MESSAGE( msg );
+
+    /*
+     * burst, active and idle once per burst, plus the transfer and the reconnects
+     */
+    TEST_ASSERT_TRUE( duty * 4 < fixed_duty );
+    TEST_ASSERT_TRUE( conn_events * 4 < fixed_conn );
+    TEST_ASSERT_LESS_OR_EQUAL( 3 * bursts + 10, requests );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_levels_decay_without_traffic );
+    RUN_TEST( test_slower_requests_keep_the_gap );
+    RUN_TEST( test_transfer_holds_bulk );
+    RUN_TEST( test_advertising_backs_off );
+    RUN_TEST( test_event_count_and_duty );
+    RUN_TEST( test_millis_wrap );
+    RUN_TEST( test_a_day_of_traffic );
+    return( UNITY_END() );
+}
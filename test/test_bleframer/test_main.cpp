@@ -0,0 +1,239 @@
+/****************************************************************************
+ *   Sep 27 11:40:05 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+static size_t allocs = 0;
+
+static void *counting_realloc( void *ptr, size_t size ) {
+    allocs++;
+    return( realloc( ptr, size ) );
+}
+#define ps_realloc counting_realloc
+
+#include "hardware/bleframer.cpp"
+
+#include <unity.h>
+
+static bleframer_t framer;
+static std::vector< std::pair< uint8_t, std::string > > received;
+static size_t received_len;
+
+static void store_msg( uint8_t type, char *msg ) {
+    received.push_back( std::make_pair( type, std::string( msg ) ) );
+}
+
+static void count_msg( uint8_t type, char *msg ) {
+    received_len += strlen( msg );
+}
+
+/*
+ * a notification stream like gadgetbridge sends it, messages of 120 to 420 bytes
+ */
+static std::string test_stream( int count ) {
+    std::string stream;
+    char msg[ 600 ];
+
+    for ( int i = 0 ; i < count ; i++ ) {
+        snprintf( msg, sizeof( msg ), "\x10GB({t:\"notify\",id:%d,src:\"WhatsApp\",title:\"Alice\",body:\"%.*s\"})\n", 1000 + i, 100 + ( i * 37 ) % 300,
+                  "Are we still on for tonight? I was thinking about the place near the station, they have the good pizza and the table outside. "
+                  "Let me know when you leave work so I can book it, otherwise we just go to the usual one, also fine by me. Bring the charger "
+                  "please, mine is broken since last week and I can't find a new one." );
+        stream += msg;
+    }
+    return( stream );
+}
+
+/*
+ * the framer before: each write copied to the heap, then each char appended with a
+ * realloc to the exact new size
+ */
+static char *old_msg = NULL;
+static uint32_t old_msg_size = 0;
+
+static void old_add_char( char msg_char ) {
+    old_msg_size++;
+    old_msg = (char *)counting_realloc( old_msg, old_msg_size + 1 );
+    old_msg[ old_msg_size - 1 ] = msg_char;
+    old_msg[ old_msg_size ] = '\0';
+}
+
+static void old_delete( void ) {
+    old_msg_size = 0;
+    old_msg = (char *)counting_realloc( old_msg, 1 );
+    old_msg[ 0 ] = '\0';
+}
+
+static void old_feed( const char *data, size_t len ) {
+    char *msg = (char *)calloc( len + 1, 1 );
+    allocs++;
+    memcpy( msg, data, len );
+    for ( size_t i = 0 ; i < len ; i++ ) {
+        switch( msg[ i ] ) {
+            case EndofText:
+            case DataLinkEscape:    old_delete();
+                                    break;
+            case LineFeed:          if ( old_msg[ 0 ] == 'G' && old_msg[ 1 ] == 'B' ) {
+                                        old_msg[ old_msg_size - 1 ] = '\0';
+                                        count_msg( BLEFRAMER_MSG, &old_msg[ 3 ] );
+                                    }
+                                    else {
+                                        count_msg( BLEFRAMER_MSG, old_msg );
+                                    }
+                                    break;
+            default:                old_add_char( msg[ i ] );
+        }
+    }
+    free( msg );
+}
+
+static void feed( const std::string &stream, size_t write_size, bool old = false ) {
+    for ( size_t pos = 0 ; pos < stream.size() ; pos += write_size ) {
+        size_t len = std::min( write_size, stream.size() - pos );
+        if ( old ) {
+            old_feed( stream.data() + pos, len );
+        }
+        else {
+            bleframer_feed( &framer, stream.data() + pos, len );
+        }
+    }
+}
+
+void setUp( void ) {
+    received.clear();
+    received_len = 0;
+    bleframer_init( &framer, store_msg );
+    allocs = 0;
+}
+
+void tearDown( void ) {
+    free( framer.msg );
+}
+
+void test_message_types( void ) {
+    std::string stream = "\x10GB({t:\"find\",n:true})\n\x10{\"t\":\"ver\"}\n\x10setTime(1600000000);E.setTimeZone(2.0)\n\x10GB\n\n";
+
+    bleframer_feed( &framer, stream.data(), stream.size() );
+    TEST_ASSERT_EQUAL( 5, received.size() );
+    TEST_ASSERT_EQUAL( 5, framer.msgs );
+    TEST_ASSERT_EQUAL( BLEFRAMER_MSG, received[ 0 ].first );
+    TEST_ASSERT_EQUAL_STRING( "{t:\"find\",n:true}", received[ 0 ].second.c_str() );
+    TEST_ASSERT_EQUAL( BLEFRAMER_MSG, received[ 1 ].first );
+    TEST_ASSERT_EQUAL_STRING( "{\"t\":\"ver\"}", received[ 1 ].second.c_str() );
+    TEST_ASSERT_EQUAL( BLEFRAMER_CMD, received[ 2 ].first );
+    TEST_ASSERT_EQUAL_STRING( "setTime(1600000000);E.setTimeZone(2.0)", received[ 2 ].second.c_str() );
+    /*
+     * too short to cut down, passed on as it is
+     */
+    TEST_ASSERT_EQUAL( BLEFRAMER_CMD, received[ 3 ].first );
+    TEST_ASSERT_EQUAL_STRING( "GB", received[ 3 ].second.c_str() );
+    TEST_ASSERT_EQUAL_STRING( "GB", received[ 4 ].second.c_str() );
+}
+
+void test_new_message_drops_the_unfinished_one( void ) {
+    std::string stream = "\x10GB({t:\"notify\",bo\x10GB({t:\"call\"})\n\x03\x10{t:1\x03{}\n";
+
+    bleframer_feed( &framer, stream.data(), stream.size() );
+    TEST_ASSERT_EQUAL( 2, received.size() );
+    TEST_ASSERT_EQUAL_STRING( "{t:\"call\"}", received[ 0 ].second.c_str() );
+    TEST_ASSERT_EQUAL_STRING( "{}", received[ 1 ].second.c_str() );
+}
+
+/*
+ * the same messages for any write size from the 20 bytes of the default mtu up to
+ * many messages per write
+ */
+void test_any_write_size( void ) {
+    std::string stream = test_stream( 50 );
+    std::vector< std::pair< uint8_t, std::string > > expected;
+
+    feed( stream, stream.size() );
+    expected = received;
+    TEST_ASSERT_EQUAL( 50, expected.size() );
+    TEST_ASSERT_EQUAL_STRING( "{t:\"notify\",id:1000,src:\"WhatsApp\",title:\"Alice\",body:\"", expected[ 0 ].second.substr( 0, 55 ).c_str() );
+    for ( size_t write_size = 1 ; write_size <= 600 ; write_size++ ) {
+        received.clear();
+        feed( stream, write_size );
+        TEST_ASSERT_TRUE( received == expected );
+    }
+}
+
+/*
+ * the buffer grows by doubling and then stays, a long message does not realloc per write
+ */
+void test_buffer_only_grows( void ) {
+    std::string stream = test_stream( 1000 );
+    std::string big = "\x10GB({t:\"notify\",body:\"" + std::string( 5000, 'x' ) + "\"})\n";
+
+    feed( stream, 20 );
+    TEST_ASSERT_EQUAL( 1, allocs );
+    TEST_ASSERT_EQUAL( 512, framer.capacity );
+
+    allocs = 0;
+    feed( big, 20 );
+    TEST_ASSERT_EQUAL( 4, allocs );
+    TEST_ASSERT_EQUAL( 8192, framer.capacity );
+    TEST_ASSERT_EQUAL( 5000 + 20, received.back().second.size() );
+}
+
+/*
+ * onWrite calls per kB for the default and the negotiated mtu, and messages per
+ * second and allocations per message for the framer before and now
+ */
+void test_writes_and_messages_per_second( void ) {
+    std::string stream = test_stream( 1000 );
+    char msg[ 160 ];
+
+    free( framer.msg );
+    bleframer_init( &framer, count_msg );
+    for ( int mtu : { 23, 247 } ) {
+        size_t write_size = mtu - 3;
+        size_t writes = ( stream.size() + write_size - 1 ) / write_size;
+
+        for ( int old = 1 ; old >= 0 ; old-- ) {
+            int runs = 0;
+            double seconds;
+
+            allocs = 0;
+            auto start = std::chrono::steady_clock::now();
+            do {
+                feed( stream, write_size, old );
+                runs++;
+                seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+            } while( seconds < 0.2 );
+
+            snprintf( msg, sizeof( msg ), "mtu %3d %s: %5.1f onWrite/kB, %4.1f onWrite/msg, %6.2f allocs/msg, %8.0f msgs/s on the host",
+                      mtu, old ? "per char" : "framer  ", writes * 1024.0 / stream.size(), writes / 1000.0, allocs / ( runs * 1000.0 ), runs * 1000 / seconds );
+            TEST_MESSAGE( msg );
+        }
+    }
+    free( old_msg );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_message_types );
+    RUN_TEST( test_new_message_drops_the_unfinished_one );
+    RUN_TEST( test_any_write_size );
+    RUN_TEST( test_buffer_only_grows );
+    RUN_TEST( test_writes_and_messages_per_second );
+    return( UNITY_END() );
+}
@@ -0,0 +1,232 @@
+/****************************************************************************
+ *   Sep 27 16:25:51 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "hardware/bleout.cpp"
+
+#include <unity.h>
+
+#define LEVEL       0
+#define STATE       1
+
+static bleout_t out;
+static bleout_batch_t batch;
+
+/*
+ * what the phone has: the last value of each characteristic and the tx stream
+ */
+static int phone_value[ BLEOUT_CHARS ];
+static std::string phone_rx;
+static int batches;
+
+static uint8_t take( uint16_t part, uint32_t now ) {
+    uint8_t count = bleout_take( &out, &batch, part, now );
+
+    if ( count ) {
+        batches++;
+    }
+    for ( int i = 0 ; i < count ; i++ ) {
+        const uint8_t *data = &batch.data[ batch.item[ i ].offset ];
+        TEST_ASSERT_LESS_OR_EQUAL( part, batch.item[ i ].len );
+        if ( batch.item[ i ].id == BLEOUT_TX ) {
+            phone_rx.append( (const char *)data, batch.item[ i ].len );
+        }
+        else {
+            phone_value[ batch.item[ i ].id ] = data[ 0 ];
+        }
+    }
+    return( count );
+}
+
+static bool set( uint8_t id, uint8_t value ) {
+    return( bleout_set( &out, id, &value, 1 ) );
+}
+
+void setUp( void ) {
+    bleout_init( &out );
+    bleout_char( &out, LEVEL, 60000 );
+    bleout_char( &out, STATE, 1000 );
+    for ( auto &value : phone_value ) {
+        value = -1;
+    }
+    phone_rx.clear();
+    batches = 0;
+}
+
+void tearDown( void ) {
+}
+
+void test_unchanged_values_are_not_send( void ) {
+    TEST_ASSERT_TRUE( set( LEVEL, 90 ) );
+    TEST_ASSERT_EQUAL( 1, take( 20, 0 ) );
+    TEST_ASSERT_EQUAL( 90, phone_value[ LEVEL ] );
+
+    for ( uint32_t now = 1000 ; now < 600000 ; now += 1000 ) {
+        TEST_ASSERT_FALSE( set( LEVEL, 90 ) );
+        TEST_ASSERT_EQUAL( 0, take( 20, now ) );
+    }
+    TEST_ASSERT_EQUAL( 1, out.notifies );
+    TEST_ASSERT_EQUAL( 599, out.deduped );
+}
+
+/*
+ * a change waits for the interval, only the newest value is send and a value
+ * that goes back to what the phone has is not send at all
+ */
+void test_rate_limit_keeps_the_newest_value( void ) {
+    set( LEVEL, 90 );
+    take( 20, 0 );
+
+    set( LEVEL, 89 );
+    set( LEVEL, 88 );
+    TEST_ASSERT_EQUAL( 0, take( 20, 59999 ) );
+    TEST_ASSERT_EQUAL( 1, take( 20, 60000 ) );
+    TEST_ASSERT_EQUAL( 88, phone_value[ LEVEL ] );
+
+    set( LEVEL, 87 );
+    TEST_ASSERT_FALSE( set( LEVEL, 88 ) );
+    TEST_ASSERT_EQUAL( 0, take( 20, 200000 ) );
+    TEST_ASSERT_EQUAL( 2, out.notifies );
+}
+
+/*
+ * the due state change takes the level along when half of its interval is over
+ */
+void test_values_ride_along_in_one_batch( void ) {
+    set( LEVEL, 90 );
+    set( STATE, 0xaf );
+    TEST_ASSERT_EQUAL( 2, take( 20, 0 ) );
+
+    set( LEVEL, 89 );
+    set( STATE, 0xbb );
+    TEST_ASSERT_EQUAL( 1, take( 20, 1000 ) );
+    TEST_ASSERT_EQUAL( 0xbb, phone_value[ STATE ] );
+    TEST_ASSERT_EQUAL( 90, phone_value[ LEVEL ] );
+
+    set( STATE, 0xaf );
+    TEST_ASSERT_EQUAL( 2, take( 20, 30000 ) );
+    TEST_ASSERT_EQUAL( 89, phone_value[ LEVEL ] );
+    TEST_ASSERT_EQUAL( 3, out.batches );
+}
+
+/*
+ * the parts of a reply are collected for BLEOUT_TX_DELAY, a full notify goes at once
+ */
+void test_tx_is_collected_and_split( void ) {
+    std::string reply = "{\"t\":\"status\",\"bat\":90}\n";
+    std::string long_reply( 1500, ' ' );
+
+    bleout_send( &out, (const uint8_t *)reply.data(), 10, 0 );
+    bleout_send( &out, (const uint8_t *)reply.data() + 10, reply.size() - 10, 5 );
+    TEST_ASSERT_EQUAL( 0, take( 244, BLEOUT_TX_DELAY - 1 ) );
+    TEST_ASSERT_EQUAL( 1, take( 244, BLEOUT_TX_DELAY ) );
+    TEST_ASSERT_TRUE( phone_rx == reply );
+
+    for ( size_t i = 0 ; i < long_reply.size() ; i++ ) {
+        long_reply[ i ] = 'a' + i % 26;
+    }
+    phone_rx.clear();
+    batches = 0;
+    TEST_ASSERT_TRUE( bleout_send( &out, (const uint8_t *)long_reply.data(), long_reply.size(), 100 ) );
+    for ( uint32_t now = 100 ; out.tx_len ; now++ ) {
+        take( 20, now );
+    }
+    TEST_ASSERT_TRUE( phone_rx == long_reply );
+    TEST_ASSERT_EQUAL( ( 1500 + BLEOUT_BATCH_ITEMS * 20 - 1 ) / ( BLEOUT_BATCH_ITEMS * 20 ), batches );
+}
+
+void test_full_tx_queues_nothing( void ) {
+    std::string big( BLEOUT_TX_SIZE + 1, 'a' );
+
+    TEST_ASSERT_TRUE( bleout_send( &out, (const uint8_t *)big.data(), 100, 0 ) );
+    TEST_ASSERT_FALSE( bleout_send( &out, (const uint8_t *)big.data(), BLEOUT_TX_SIZE - 99, 0 ) );
+    TEST_ASSERT_EQUAL( 100, out.tx_len );
+    TEST_ASSERT_EQUAL( BLEOUT_TX_SIZE - 99, out.tx_dropped );
+    TEST_ASSERT_TRUE( bleout_send( &out, (const uint8_t *)big.data(), BLEOUT_TX_SIZE - 100, 0 ) );
+}
+
+/*
+ * after a reconnect the phone gets the current values again, old tx data is gone
+ */
+void test_connect_sends_the_values_again( void ) {
+    set( LEVEL, 90 );
+    set( STATE, 0xaf );
+    take( 20, 0 );
+    set( LEVEL, 85 );
+    bleout_send( &out, (const uint8_t *)"abc", 3, 0 );
+
+    bleout_connect( &out );
+    TEST_ASSERT_EQUAL( 0, out.tx_len );
+    phone_value[ LEVEL ] = phone_value[ STATE ] = -1;
+    TEST_ASSERT_EQUAL( 2, take( 20, 10 ) );
+    TEST_ASSERT_EQUAL( 85, phone_value[ LEVEL ] );
+    TEST_ASSERT_EQUAL( 0xaf, phone_value[ STATE ] );
+}
+
+/*
+ * one idle hour like pmu_loop() does it: both values set every second, the level
+ * drops 1% every 3 minutes, the watch is plugged in at 40 minutes and a three
+ * part gadgetbridge reply every 10 minutes. blectl_update_battery() send two
+ * notifies every second before
+ */
+void test_an_idle_hour( void ) {
+    std::string sent;
+    uint32_t before = 0;
+    char msg[ 128 ];
+
+    for ( uint32_t now = 0 ; now < 3600000 ; now += 5 ) {
+        if ( now % 1000 == 0 ) {
+            set( LEVEL, 90 - now / 180000 );
+            set( STATE, now > 2400000 ? 0xbb : 0xaf );
+            before += 2;
+        }
+        if ( now % 600000 == 1000 ) {
+            char reply[ 400 ];
+            int len = snprintf( reply, sizeof( reply ), "{\"t\":\"status\",\"bat\":%d,\"x\":\"%0300d\"}\n", 90 - now / 180000, (int)now );
+            for ( int i = 0 ; i < 3 ; i++ ) {
+                bleout_send( &out, (const uint8_t *)reply + i * len / 3, ( i + 1 ) * len / 3 - i * len / 3, now );
+            }
+            sent.append( reply, len );
+        }
+        take( 244, now );
+    }
+    TEST_ASSERT_TRUE( phone_rx == sent );
+    TEST_ASSERT_EQUAL( 90 - 3599999 / 180000, phone_value[ LEVEL ] );
+    TEST_ASSERT_EQUAL( 0xbb, phone_value[ STATE ] );
+    TEST_ASSERT_LESS_THAN( before / 50, out.notifies );
+
+    snprintf( msg, sizeof( msg ), "an idle hour: %d notifies before, %d now in %d batches (%d values set, %d deduped)",
+              before, out.notifies, out.batches, out.values, out.deduped );
+    TEST_MESSAGE( msg );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_unchanged_values_are_not_send );
+    RUN_TEST( test_rate_limit_keeps_the_newest_value );
+    RUN_TEST( test_values_ride_along_in_one_batch );
+    RUN_TEST( test_tx_is_collected_and_split );
+    RUN_TEST( test_full_tx_queues_nothing );
+    RUN_TEST( test_connect_sends_the_values_again );
+    RUN_TEST( test_an_idle_hour );
+    return( UNITY_END() );
+}
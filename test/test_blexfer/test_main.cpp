@@ -0,0 +1,375 @@
+/****************************************************************************
+ *   Sep 27 09:48:16 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "hardware/blexfer.cpp"
+
+#include <unity.h>
+
+typedef std::vector< uint8_t > bytes_t;
+
+/*
+ * the watch: a file target that keeps the written part over a disconnect like
+ * blectl does with the spiffs file
+ */
+static blexfer_t xfer;
+static bytes_t part;
+static bytes_t done_file;
+static std::string part_name;
+static uint32_t part_size;
+static uint32_t part_crc;
+static int part_target = -1;
+static size_t written_bytes;
+static int closes[ 3 ];
+static bytes_t reply;
+
+static bool open_target( blexfer_t *xfer, uint32_t *offset, uint32_t *crc ) {
+    if ( part_target == xfer->target && part_name == xfer->name && part_size == xfer->size && part_crc == xfer->crc ) {
+        *offset = part.size();
+        *crc = blexfer_crc32( 0, part.data(), part.size() );
+    }
+    else {
+        part.clear();
+    }
+    part_target = xfer->target;
+    part_name = xfer->name;
+    part_size = xfer->size;
+    part_crc = xfer->crc;
+    return( true );
+}
+
+static bool write_target( const uint8_t *data, size_t len ) {
+    part.insert( part.end(), data, data + len );
+    written_bytes += len;
+    return( true );
+}
+
+static bool close_target( blexfer_t *xfer, uint8_t reason ) {
+    closes[ reason ]++;
+    if ( reason == BLEXFER_CLOSE_DONE ) {
+        done_file = part;
+    }
+    if ( reason != BLEXFER_CLOSE_SUSPEND ) {
+        part.clear();
+        part_target = -1;
+    }
+    return( true );
+}
+
+static void reply_client( const uint8_t *data, size_t len ) {
+    TEST_ASSERT_LESS_OR_EQUAL( BLEXFER_REPLY_LEN, len );
+    reply.assign( data, data + len );
+}
+
+/*
+ * the link on a virtual clock: ll packets fill the connection events, a data write
+ * can get lost or damaged and the connection can drop after some bytes. a control
+ * write waits for the next event for its response and notify
+ */
+struct link_t {
+    uint16_t mtu;
+    size_t ll;                                  /** @brief ll payload, 27 or 251 with dle */
+    double ci;                                  /** @brief connection interval */
+    int per_event;                              /** @brief packets the phone sends per event */
+    double loss;
+    double corrupt;
+    std::vector< size_t > drop_at;
+    double flash_rate;                          /** @brief bytes per second the target writes */
+    double t;
+    int in_event;
+    size_t sent;
+    size_t lost;
+    int reconnects;
+};
+
+static uint32_t test_random_state;
+
+static uint32_t test_random( void ) {
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+    return( test_random_state );
+}
+
+static bool chance( double p ) {
+    return( ( test_random() % 1000000 ) < p * 1000000 );
+}
+
+static void air( link_t *link, size_t att_len ) {
+    size_t left = att_len + 3 + 4;
+    size_t used = std::min( link->ll, att_len + 7 );
+
+    while( left > 0 ) {
+        left -= std::min( left, link->ll );
+        if ( link->in_event >= link->per_event ) {
+            link->t = ( (int)( link->t / link->ci ) + 1 ) * link->ci;
+            link->in_event = 0;
+        }
+        link->in_event++;
+        link->t += ( ( used + 14 ) * 8 + 380 ) * 1e-6;
+    }
+}
+
+static bool link_data( link_t *link, const bytes_t &data ) {
+    if ( !link->drop_at.empty() && link->sent >= link->drop_at.front() ) {
+        link->drop_at.erase( link->drop_at.begin() );
+        blexfer_disconnect( &xfer );
+        link->t += 1.0;
+        link->reconnects++;
+        return( false );
+    }
+    link->sent += data.size();
+    air( link, data.size() );
+    if ( chance( link->loss ) ) {
+        link->lost++;
+        return( true );
+    }
+    bytes_t chunk = data;
+    if ( chance( link->corrupt ) ) {
+        chunk.back() ^= 1;
+    }
+    blexfer_data( &xfer, chunk.data(), chunk.size() );
+    return( true );
+}
+
+static const bytes_t &link_control( link_t *link, const bytes_t &cmd ) {
+    air( link, cmd.size() );
+    reply.clear();
+    blexfer_control( &xfer, cmd.data(), cmd.size() );
+    TEST_ASSERT_FALSE( reply.empty() );
+    if ( reply[ 0 ] == BLEXFER_REPLY_ACK ) {
+        link->t += BLEXFER_WINDOW * ( link->mtu - 7 ) / link->flash_rate;
+    }
+    link->t = ( (int)( link->t / link->ci ) + 1 ) * link->ci;
+    link->in_event = 1;
+    return( reply );
+}
+
+static void put_u16( bytes_t &out, uint16_t value ) {
+    out.push_back( value );
+    out.push_back( value >> 8 );
+}
+
+static void put_u32( bytes_t &out, uint32_t value ) {
+    put_u16( out, value );
+    put_u16( out, value >> 16 );
+}
+
+static uint32_t get_u32( const bytes_t &data, size_t pos ) {
+    return( data[ pos ] | data[ pos + 1 ] << 8 | data[ pos + 2 ] << 16 | (uint32_t)data[ pos + 3 ] << 24 );
+}
+
+/*
+ * the client like send() and transfer() in tools/blexfer.py
+ */
+enum { SEND_DONE, SEND_LOST, SEND_ERROR };
+
+static int client_send( link_t *link, const char *name, const bytes_t &data ) {
+    bytes_t cmd = { BLEXFER_CMD_START, BLEXFER_TARGET_FILE };
+
+    put_u16( cmd, link->mtu );
+    put_u32( cmd, data.size() );
+    put_u32( cmd, blexfer_crc32( 0, data.data(), data.size() ) );
+    cmd.insert( cmd.end(), name, name + strlen( name ) );
+    bytes_t answer = link_control( link, cmd );
+    if ( answer[ 0 ] != BLEXFER_REPLY_START ) {
+        return( SEND_ERROR );
+    }
+    uint32_t chunk = answer[ 1 ] | answer[ 2 ] << 8;
+    uint32_t window = answer[ 3 ];
+    uint32_t offset = get_u32( answer, 4 );
+
+    while( offset < data.size() ) {
+        uint32_t block_len = std::min( (size_t)chunk * window, data.size() - offset );
+        uint32_t chunks = ( block_len + chunk - 1 ) / chunk;
+        uint32_t missing = chunks == 32 ? 0xffffffff : ( 1ul << chunks ) - 1;
+        int retry;
+
+        for ( retry = 0 ; retry < 8 ; retry++ ) {
+            for ( uint32_t index = 0 ; index < window ; index++ ) {
+                if ( missing & ( 1ul << index ) ) {
+                    bytes_t packet;
+                    put_u32( packet, offset + index * chunk );
+                    packet.insert( packet.end(), data.begin() + offset + index * chunk, data.begin() + offset + std::min( ( index + 1 ) * chunk, block_len ) );
+                    if ( !link_data( link, packet ) ) {
+                        return( SEND_LOST );
+                    }
+                }
+            }
+            cmd = { BLEXFER_CMD_BLOCK };
+            put_u32( cmd, offset );
+            put_u16( cmd, block_len );
+            put_u32( cmd, blexfer_crc32( 0, data.data() + offset, block_len ) );
+            answer = link_control( link, cmd );
+            if ( answer[ 0 ] == BLEXFER_REPLY_ACK ) {
+                offset = get_u32( answer, 1 );
+                break;
+            }
+            if ( answer[ 0 ] != BLEXFER_REPLY_NAK ) {
+                return( SEND_ERROR );
+            }
+            missing = get_u32( answer, 5 );
+        }
+        if ( retry == 8 ) {
+            return( SEND_ERROR );
+        }
+    }
+    answer = link_control( link, bytes_t( 1, BLEXFER_CMD_END ) );
+    return( answer[ 0 ] == BLEXFER_REPLY_DONE ? SEND_DONE : SEND_ERROR );
+}
+
+static bool client_transfer( link_t *link, const char *name, const bytes_t &data ) {
+    for ( int attempt = 0 ; attempt <= 5 ; attempt++ ) {
+        int result = client_send( link, name, data );
+        if ( result != SEND_LOST ) {
+            return( result == SEND_DONE );
+        }
+    }
+    return( false );
+}
+
+static bytes_t test_data( size_t len ) {
+    bytes_t data;
+
+    test_random_state = 77;
+    while( data.size() < len ) {
+        data.push_back( test_random() );
+    }
+    return( data );
+}
+
+/*
+ * runs a transfer and reports the effective throughput on the virtual clock
+ */
+static link_t run( const char *label, const bytes_t &data, uint16_t mtu, size_t ll, double ci, double loss = 0, std::vector< size_t > drop_at = {}, double corrupt = 0 ) {
+    link_t link = { mtu, ll, ci, 6, loss, corrupt, drop_at, 150e3, 0, 0, 0, 0, 0 };
+    char msg[ 160 ];
+
+    blexfer_init( &xfer, open_target, write_target, close_target, reply_client );
+    part.clear();
+    done_file.clear();
+    part_target = -1;
+    written_bytes = 0;
+    memset( closes, 0, sizeof( closes ) );
+    test_random_state = 2;
+
+    TEST_ASSERT_TRUE( client_transfer( &link, "/test.bin", data ) );
+    TEST_ASSERT_TRUE( done_file == data );
+    TEST_ASSERT_EQUAL( 1, closes[ BLEXFER_CLOSE_DONE ] );
+    TEST_ASSERT_EQUAL( 0, closes[ BLEXFER_CLOSE_ABORT ] );
+    TEST_ASSERT_EQUAL( link.reconnects, closes[ BLEXFER_CLOSE_SUSPEND ] );
+    /*
+     * a resume never writes a block twice
+     */
+    TEST_ASSERT_EQUAL( data.size(), written_bytes );
+
+    snprintf( msg, sizeof( msg ), "%-36s %6.1f kB/s %5.1fs, sent +%.1f%%, lost %d, reconnects %d",
+              label, data.size() / 1024.0 / std::max( link.t, 1e-9 ), link.t, ( link.sent - data.size() ) * 100.0 / std::max( data.size(), (size_t)1 ), (int)link.lost, link.reconnects );
+    TEST_MESSAGE( msg );
+    return( link );
+}
+
+void setUp( void ) {
+}
+
+void tearDown( void ) {
+}
+
+void test_throughput_over_the_mtu( void ) {
+    bytes_t data = test_data( 300000 );
+
+    run( "mtu 23, ci 30ms", data, 23, 27, 0.030 );
+    run( "mtu 185 no dle, ci 30ms", data, 185, 27, 0.030 );
+    run( "mtu 247 + dle, ci 30ms", data, 247, 251, 0.030 );
+    run( "mtu 247 + dle, ci 15ms", data, 247, 251, 0.015 );
+}
+
+void test_lossy_link( void ) {
+    bytes_t data = test_data( 300000 );
+
+    run( "mtu 23, ci 30ms, 1% loss", data, 23, 27, 0.030, 0.01 );
+    run( "mtu 247 + dle, ci 15ms, 1% loss", data, 247, 251, 0.015, 0.01 );
+    run( "mtu 247 + dle, ci 15ms, 5% loss", data, 247, 251, 0.015, 0.05 );
+    run( "mtu 247 + dle, ci 15ms, 30% loss", bytes_t( data.begin(), data.begin() + 100000 ), 247, 251, 0.015, 0.3 );
+    run( "mtu 247 + dle, 2% damaged chunks", data, 247, 251, 0.015, 0, {}, 0.02 );
+}
+
+void test_resume_after_disconnect( void ) {
+    bytes_t data = test_data( 300000 );
+    link_t link;
+
+    link = run( "mtu 247 + dle, 3 disconnects", data, 247, 251, 0.015, 0, { 50000, 120000, 250000 } );
+    TEST_ASSERT_EQUAL( 3, link.reconnects );
+    link = run( "mtu 23, 2% loss, 2 disconnects", bytes_t( data.begin(), data.begin() + 60000 ), 23, 27, 0.030, 0.02, { 10000, 30000 } );
+    TEST_ASSERT_EQUAL( 2, link.reconnects );
+}
+
+void test_short_files( void ) {
+    run( "empty file", bytes_t(), 247, 251, 0.015 );
+    run( "one byte", bytes_t( 1, 'x' ), 23, 27, 0.015 );
+    run( "one full block", test_data( 32 * 240 ), 247, 251, 0.015 );
+}
+
+void test_protocol_errors( void ) {
+    bytes_t block = { BLEXFER_CMD_BLOCK, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    bytes_t start = { BLEXFER_CMD_START, BLEXFER_TARGET_FILE, 247, 0, 100, 0, 0, 0, 0, 0, 0, 0 };
+
+    blexfer_init( &xfer, open_target, write_target, close_target, reply_client );
+    part_target = -1;
+    memset( closes, 0, sizeof( closes ) );
+
+    blexfer_control( &xfer, block.data(), block.size() );
+    TEST_ASSERT_EQUAL_STRING( "no transfer", xfer.error );
+    blexfer_control( &xfer, bytes_t( 1, 0x42 ).data(), 1 );
+    TEST_ASSERT_EQUAL_STRING( "unknown command", xfer.error );
+    blexfer_control( &xfer, start.data(), 5 );
+    TEST_ASSERT_EQUAL_STRING( "bad start", xfer.error );
+
+    start.insert( start.end(), 32, 'a' );
+    blexfer_control( &xfer, start.data(), start.size() );
+    TEST_ASSERT_EQUAL_STRING( "bad start", xfer.error );
+    start.resize( start.size() - 2 );
+    blexfer_control( &xfer, start.data(), start.size() );
+    TEST_ASSERT_EQUAL( BLEXFER_REPLY_START, reply[ 0 ] );
+    TEST_ASSERT_EQUAL( 247 - 3 - BLEXFER_DATA_HEADER, reply[ 1 ] | reply[ 2 ] << 8 );
+
+    block[ 1 ] = 8;
+    blexfer_control( &xfer, block.data(), block.size() );
+    TEST_ASSERT_EQUAL_STRING( "block out of order", xfer.error );
+    TEST_ASSERT_EQUAL( 1, closes[ BLEXFER_CLOSE_SUSPEND ] );
+
+    blexfer_control( &xfer, bytes_t( 1, BLEXFER_CMD_END ).data(), 1 );
+    TEST_ASSERT_EQUAL_STRING( "no transfer", xfer.error );
+    blexfer_control( &xfer, bytes_t( 1, BLEXFER_CMD_ABORT ).data(), 1 );
+    TEST_ASSERT_EQUAL_STRING( "aborted", xfer.error );
+    TEST_ASSERT_EQUAL( BLEXFER_REPLY_ERROR, reply[ 0 ] );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_throughput_over_the_mtu );
+    RUN_TEST( test_lossy_link );
+    RUN_TEST( test_resume_after_disconnect );
+    RUN_TEST( test_short_files );
+    RUN_TEST( test_protocol_errors );
+    return( UNITY_END() );
+}
@@ -0,0 +1,247 @@
+/****************************************************************************
+ *   Sep 26 14:51:09 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "hardware/configapi.cpp"
+
+#include <unity.h>
+
+/*
+ * a fake module registry: display setters don't save like display_set_brightness,
+ * pmu setters save on their own like pmu_set_silence_wakeup, the display rotation
+ * setter saves an other module and motor has no save at all
+ */
+static int32_t brightness;
+static int32_t rotation;
+static char key[ 16 ];
+static bool silence;
+static bool compute;
+static bool vibe;
+
+static int display_saves;
+static int pmu_saves;
+static int other_saves;
+static int refreshes;
+
+static void display_save( void ) {
+    if ( configapi_defer_save( display_save ) ) {
+        return;
+    }
+    display_saves++;
+}
+
+static void pmu_save( void ) {
+    if ( configapi_defer_save( pmu_save ) ) {
+        return;
+    }
+    pmu_saves++;
+}
+
+static void other_save( void ) {
+    if ( configapi_defer_save( other_save ) ) {
+        return;
+    }
+    other_saves++;
+}
+
+static const configapi_field_t display_fields[] = {
+    CONFIGAPI_INT_FIELD( "brightness", 8, 255, 0, []() -> int32_t { return( brightness ); }, []( int32_t value ) { brightness = value; } ),
+    CONFIGAPI_INT_FIELD( "rotation", 0, 270, 90, []() -> int32_t { return( rotation ); }, []( int32_t value ) { rotation = value; other_save(); } ),
+    CONFIGAPI_STRING_FIELD( "key", sizeof( key ) - 1, []() -> const char * { return( key ); }, []( const char *value ) { strlcpy( key, value, sizeof( key ) ); } )
+};
+
+static const configapi_field_t pmu_fields[] = {
+    CONFIGAPI_BOOL_FIELD( "silence", []() -> bool { return( silence ); }, []( bool value ) { silence = value; pmu_save(); } ),
+    CONFIGAPI_BOOL_FIELD( "compute", []() -> bool { return( compute ); }, []( bool value ) { compute = value; pmu_save(); } ),
+    CONFIGAPI_INT_FIELD( "capacity", 0, INT32_MAX, 0, []() -> int32_t { return( 300 ); }, NULL )
+};
+
+static const configapi_field_t motor_fields[] = {
+    CONFIGAPI_BOOL_FIELD( "vibe", []() -> bool { return( vibe ); }, []( bool value ) { vibe = value; } )
+};
+
+static configapi_result_t patch( const char *json, char *error = NULL, size_t size = 0 ) {
+    DynamicJsonDocument doc( 2048 );
+    char dummy[ 64 ];
+
+    TEST_ASSERT_FALSE( deserializeJson( doc, json ) );
+    if ( error == NULL ) {
+        error = dummy;
+        size = sizeof( dummy );
+    }
+    error[ 0 ] = '\0';
+    return( configapi_patch( doc.as<JsonObjectConst>(), error, size ) );
+}
+
+static std::string get( void ) {
+    DynamicJsonDocument doc( 2048 );
+    std::string json;
+
+    configapi_get( doc.to<JsonObject>() );
+    serializeJson( doc, json );
+    return( json );
+}
+
+/*
+ * a rejected batch changes and saves nothing, not even the valid fields in front of the bad one
+ */
+static void reject( const char *json, const char *expected ) {
+    char error[ 64 ];
+    std::string before = get();
+
+    TEST_ASSERT_EQUAL( CONFIGAPI_INVALID, patch( json, error, sizeof( error ) ) );
+    TEST_ASSERT_EQUAL_STRING( expected, error );
+    configapi_loop();
+    TEST_ASSERT_TRUE( get() == before );
+    TEST_ASSERT_EQUAL( 0, display_saves + pmu_saves + other_saves + refreshes );
+}
+
+void setUp( void ) {
+    static bool registered = false;
+
+    if ( !registered ) {
+        configapi_register_cb( []() { refreshes++; } );
+        configapi_register( "display", display_fields, sizeof( display_fields ) / sizeof( configapi_field_t ), display_save );
+        configapi_register( "pmu", pmu_fields, sizeof( pmu_fields ) / sizeof( configapi_field_t ), pmu_save );
+        configapi_register( "motor", motor_fields, sizeof( motor_fields ) / sizeof( configapi_field_t ), NULL );
+        registered = true;
+    }
+    brightness = 128;
+    rotation = 0;
+    strlcpy( key, "abc", sizeof( key ) );
+    silence = true;
+    compute = false;
+    vibe = true;
+    display_saves = pmu_saves = other_saves = refreshes = 0;
+}
+
+void tearDown( void ) {
+    configapi_loop();
+}
+
+void test_get_all_modules( void ) {
+    TEST_ASSERT_EQUAL_STRING( "{\"display\":{\"brightness\":128,\"rotation\":0,\"key\":\"abc\"},"
+                              "\"pmu\":{\"silence\":true,\"compute\":false,\"capacity\":300},"
+                              "\"motor\":{\"vibe\":true}}", get().c_str() );
+}
+
+void test_schema_validation( void ) {
+    reject( "{\"display\":{\"brightness\":100},\"gps\":{}}", "unknown module gps" );
+    reject( "{\"display\":5}", "display: object expected" );
+    reject( "{\"display\":{\"brightness\":100,\"contrast\":1}}", "display.contrast: unknown field" );
+    reject( "{\"pmu\":{\"silence\":false,\"capacity\":500}}", "pmu.capacity: read only" );
+    reject( "{\"display\":{\"brightness\":7}}", "display.brightness: invalid value" );
+    reject( "{\"display\":{\"brightness\":256}}", "display.brightness: invalid value" );
+    reject( "{\"display\":{\"brightness\":100.5}}", "display.brightness: invalid value" );
+    reject( "{\"display\":{\"brightness\":\"100\"}}", "display.brightness: invalid value" );
+    reject( "{\"display\":{\"rotation\":45}}", "display.rotation: invalid value" );
+    reject( "{\"display\":{\"key\":\"0123456789abcdefg\"}}", "display.key: invalid value" );
+    reject( "{\"pmu\":{\"silence\":1}}", "pmu.silence: invalid value" );
+}
+
+void test_batched_write_saves_each_module_once( void ) {
+    TEST_ASSERT_EQUAL( CONFIGAPI_QUEUED, patch( "{\"display\":{\"brightness\":42,\"rotation\":180,\"key\":\"xyz\"},"
+                                                "\"pmu\":{\"silence\":false,\"compute\":true},\"motor\":{\"vibe\":false}}" ) );
+    /*
+     * the setters run from the main loop only
+     */
+    TEST_ASSERT_EQUAL( 128, brightness );
+    configapi_loop();
+
+    TEST_ASSERT_EQUAL( 42, brightness );
+    TEST_ASSERT_EQUAL( 180, rotation );
+    TEST_ASSERT_EQUAL_STRING( "xyz", key );
+    TEST_ASSERT_FALSE( silence );
+    TEST_ASSERT_TRUE( compute );
+    TEST_ASSERT_FALSE( vibe );
+    TEST_ASSERT_EQUAL( 1, display_saves );
+    TEST_ASSERT_EQUAL( 1, pmu_saves );
+    TEST_ASSERT_EQUAL( 1, other_saves );
+    TEST_ASSERT_EQUAL( 1, refreshes );
+
+    /*
+     * outside of a batch a save is not deferred
+     */
+    pmu_save();
+    TEST_ASSERT_EQUAL( 2, pmu_saves );
+}
+
+void test_get_sent_back_changes_nothing( void ) {
+    TEST_ASSERT_EQUAL( CONFIGAPI_QUEUED, patch( get().c_str() ) );
+    configapi_loop();
+    TEST_ASSERT_EQUAL( 0, display_saves + pmu_saves + other_saves + refreshes );
+
+    TEST_ASSERT_EQUAL( CONFIGAPI_QUEUED, patch( "{}" ) );
+    configapi_loop();
+    TEST_ASSERT_EQUAL( 0, display_saves + pmu_saves + other_saves + refreshes );
+}
+
+void test_full_queue_is_busy( void ) {
+    char error[ 64 ];
+
+    for ( int i = 0 ; i < CONFIGAPI_MAX_QUEUED ; i++ ) {
+        TEST_ASSERT_EQUAL( CONFIGAPI_QUEUED, patch( "{\"display\":{\"brightness\":50}}" ) );
+    }
+    TEST_ASSERT_EQUAL( CONFIGAPI_BUSY, patch( "{\"display\":{\"brightness\":60}}", error, sizeof( error ) ) );
+    TEST_ASSERT_EQUAL_STRING( "busy, try again", error );
+    TEST_ASSERT_EQUAL( 128, brightness );
+
+    configapi_loop();
+    TEST_ASSERT_EQUAL( 50, brightness );
+    TEST_ASSERT_EQUAL( 1, display_saves );
+    TEST_ASSERT_EQUAL( 1, refreshes );
+}
+
+/*
+ * the webserver task patches while the main loop applies
+ */
+void test_patch_from_an_other_task( void ) {
+    std::atomic<int> queued( 0 );
+    std::thread webserver( [&]() {
+        char json[ 64 ];
+        for ( int i = 0 ; i < 200 ; i++ ) {
+            snprintf( json, sizeof( json ), "{\"display\":{\"brightness\":%d}}", 8 + i );
+            while( patch( json ) == CONFIGAPI_BUSY ) {
+                std::this_thread::yield();
+            }
+            queued++;
+        }
+    });
+
+    while( queued < 200 ) {
+        configapi_loop();
+    }
+    webserver.join();
+    configapi_loop();
+    TEST_ASSERT_EQUAL( 8 + 199, brightness );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_get_all_modules );
+    RUN_TEST( test_schema_validation );
+    RUN_TEST( test_batched_write_saves_each_module_once );
+    RUN_TEST( test_get_sent_back_changes_nothing );
+    RUN_TEST( test_full_queue_is_busy );
+    RUN_TEST( test_patch_from_an_other_task );
+    return( UNITY_END() );
+}
@@ -0,0 +1,235 @@
+/****************************************************************************
+ *   Sep 28 14:31:08 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "hardware/bleframer.cpp"
+#include "hardware/espruino.cpp"
+
+#include <unity.h>
+#include <time.h>
+
+static bleframer_t framer;
+static std::vector< std::string > cmds;
+static int msgs;
+
+static void store_msg( uint8_t type, char *msg ) {
+    if ( type == BLEFRAMER_CMD ) {
+        cmds.push_back( msg );
+    }
+    else {
+        msgs++;
+    }
+}
+
+void setUp( void ) {
+    bleframer_init( &framer, store_msg );
+    cmds.clear();
+    msgs = 0;
+}
+
+void tearDown( void ) {
+    free( framer.msg );
+}
+
+void test_time_and_timezone( void ) {
+    espruino_cmd_t cmd;
+
+    TEST_ASSERT_EQUAL( ESPRUINO_TIME | ESPRUINO_TIMEZONE, espruino_exec( "setTime(1600275937);E.setTimeZone(2.0);", &cmd ) );
+    TEST_ASSERT_TRUE( cmd.time == 1600275937 );
+    TEST_ASSERT_EQUAL( 0, cmd.time_ms );
+    TEST_ASSERT_EQUAL( 120, cmd.timezone );
+    TEST_ASSERT_EQUAL( 2, cmd.statements );
+    TEST_ASSERT_EQUAL( 0, cmd.skipped );
+
+    TEST_ASSERT_EQUAL( ESPRUINO_TIME | ESPRUINO_TIMEZONE, espruino_exec( " setTime( 1700000000.750 ) ; E.setTimeZone( -3.5 ) ;\r", &cmd ) );
+    TEST_ASSERT_TRUE( cmd.time == 1700000000 );
+    TEST_ASSERT_EQUAL( 750, cmd.time_ms );
+    TEST_ASSERT_EQUAL( -210, cmd.timezone );
+
+    TEST_ASSERT_EQUAL( ESPRUINO_TIMEZONE, espruino_exec( "E.setTimeZone(5.75)", &cmd ) );
+    TEST_ASSERT_EQUAL( 345, cmd.timezone );
+    TEST_ASSERT_EQUAL( ESPRUINO_TIMEZONE, espruino_exec( "E.setTimeZone(+14)", &cmd ) );
+    TEST_ASSERT_EQUAL( 840, cmd.timezone );
+}
+
+/*
+ * a ; in brackets or strings does not end a statement, only the calls themselves count
+ */
+void test_everything_else_is_skipped( void ) {
+    espruino_cmd_t cmd;
+
+    TEST_ASSERT_EQUAL( ESPRUINO_TIME, espruino_exec( "setTime(1600275937);(s=>{s&&(s.timezone=2.0)&&require('Storage').write('setting.json',s);})(require('Storage').readJSON('setting.json',1))", &cmd ) );
+    TEST_ASSERT_EQUAL( 2, cmd.statements );
+    TEST_ASSERT_EQUAL( 1, cmd.skipped );
+
+    TEST_ASSERT_EQUAL( 0, espruino_exec( "print('setTime(1700000000)');E.showMessage(\"E.setTimeZone(3)\")", &cmd ) );
+    TEST_ASSERT_EQUAL( 2, cmd.skipped );
+    TEST_ASSERT_EQUAL( 0, espruino_exec( "print('a\\';setTime(1700000000)')", &cmd ) );
+    TEST_ASSERT_EQUAL( 1, cmd.statements );
+    TEST_ASSERT_EQUAL( 0, espruino_exec( "setTimer(1700000000);setTime(1700000000)+1;setTime(x);setTime();E.setTimeZone", &cmd ) );
+    TEST_ASSERT_EQUAL( 5, cmd.skipped );
+    TEST_ASSERT_EQUAL( 0, espruino_exec( "", &cmd ) );
+    TEST_ASSERT_EQUAL( 0, cmd.statements );
+}
+
+/*
+ * a phone without time and values out of range are not taken
+ */
+void test_out_of_range( void ) {
+    espruino_cmd_t cmd;
+
+    TEST_ASSERT_EQUAL( ESPRUINO_TIMEZONE, espruino_exec( "setTime(86400);E.setTimeZone(0.0)", &cmd ) );
+    TEST_ASSERT_EQUAL( 0, espruino_exec( "setTime(4102444800)", &cmd ) );
+    TEST_ASSERT_EQUAL( 0, espruino_exec( "setTime(-1600275937)", &cmd ) );
+    TEST_ASSERT_EQUAL( 0, espruino_exec( "setTime(99999999999999999999999)", &cmd ) );
+    TEST_ASSERT_EQUAL( 0, espruino_exec( "E.setTimeZone(-12.5)", &cmd ) );
+    TEST_ASSERT_EQUAL( 0, espruino_exec( "E.setTimeZone(14.25)", &cmd ) );
+}
+
+void test_posix_tz( void ) {
+    struct {
+        int16_t timezone;
+        const char *tz;
+    } table[] = { { 0, "UTC0" }, { 120, "UTC-2" }, { -480, "UTC8" }, { 330, "UTC-5:30" }, { 345, "UTC-5:45" }, { -210, "UTC3:30" }, { 840, "UTC-14" } };
+    char tz[ 16 ];
+
+    for ( auto &t : table ) {
+        espruino_tz( t.timezone, tz, sizeof( tz ) );
+        TEST_ASSERT_EQUAL_STRING( t.tz, tz );
+    }
+}
+
+/*
+ * what the phones send after the connect, in 20 byte writes of the default mtu
+ * through the framer, then the clock is set like timesync does it
+ */
+void test_replay_connect_transcripts( void ) {
+    static const struct {
+        const char *name;
+        const char *data;
+        int64_t time;
+        int16_t timezone;
+        const char *local;
+    } transcripts[] = {
+        { "gadgetbridge 0.46, berlin summer",
+          "\x03\x10setTime(1600275937);E.setTimeZone(2.0);\n\x10GB({\"t\":\"notify\",\"id\":1,\"src\":\"Whatsapp\",\"title\":\"Anna\",\"body\":\"hi; (ok)\"})\n",
+          1600275937, 120, "2020-09-16 19:05:37" },
+        { "gadgetbridge 0.48, settings function",
+          "\x10setTime(1600275937);E.setTimeZone(2.0);(s=>{s&&(s.timezone=2.0)&&require('Storage').write('setting.json',s);})(require('Storage').readJSON('setting.json',1))\n\x10GB({\"t\":\"musicstate\",\"state\":\"pause\"})\n",
+          1600275937, 120, "2020-09-16 19:05:37" },
+        { "gadgetbridge 0.70, india",
+          "\x10setTime(1700000000);E.setTimeZone(5.5);(s=>s&&(s.timezone=5.5,require('Storage').write('setting.json',s)))(require('Storage').readJSON('setting.json',1))\n",
+          1700000000, 330, "2023-11-15 03:43:20" },
+        { "nepal", "\x10setTime(1700000000);E.setTimeZone(5.75);\n", 1700000000, 345, "2023-11-15 03:58:20" },
+        { "newfoundland", "\x10setTime(1700000000);E.setTimeZone(-3.5);\n", 1700000000, -210, "2023-11-14 18:43:20" },
+        { "los angeles, spaces and ms", "\x10 setTime( 1700000000.750 ) ; E.setTimeZone( -8 ) ;\r\n", 1700000000, -480, "2023-11-14 14:13:20" },
+        { "phone without time", "\x10setTime(86400);E.setTimeZone(0.0);\n", 0, 0, NULL },
+        { "settimezone inside a string only", "\x10print('setTime(1700000000)');E.showMessage(\"E.setTimeZone(3)\")\n", 0, 0, NULL },
+        { "plain json", "{\"t\":\"find\",\"n\":true}\n", 0, 0, NULL },
+    };
+    char msg[ 200 ];
+
+    for ( auto &t : transcripts ) {
+        size_t len = strlen( t.data );
+        espruino_cmd_t cmd;
+        uint8_t found = 0;
+        int64_t time = 0;
+        int16_t timezone = 0;
+        char local[ 32 ] = "-";
+
+        tearDown();
+        setUp();
+        for ( size_t pos = 0 ; pos < len ; pos += 20 ) {
+            bleframer_feed( &framer, t.data + pos, std::min( (size_t)20, len - pos ) );
+        }
+        for ( auto &line : cmds ) {
+            found |= espruino_exec( line.c_str(), &cmd );
+            if ( cmd.found & ESPRUINO_TIME ) {
+                time = cmd.time;
+            }
+            if ( cmd.found & ESPRUINO_TIMEZONE ) {
+                timezone = cmd.timezone;
+            }
+        }
+        if ( found & ESPRUINO_TIME ) {
+            char tz[ 16 ];
+            time_t utc = time;
+            struct tm info;
+
+            espruino_tz( timezone, tz, sizeof( tz ) );
+            setenv( "TZ", tz, 1 );
+            tzset();
+            localtime_r( &utc, &info );
+            strftime( local, sizeof( local ), "%Y-%m-%d %H:%M:%S", &info );
+        }
+        snprintf( msg, sizeof( msg ), "%-36s %d cmd %d msg, time %lld tz %4d local %s", t.name, (int)cmds.size(), msgs, (long long)time, timezone, local );
+        TEST_MESSAGE( msg );
+
+        if ( t.local ) {
+            TEST_ASSERT_EQUAL( ESPRUINO_TIME | ESPRUINO_TIMEZONE, found );
+            TEST_ASSERT_TRUE( time == t.time );
+            TEST_ASSERT_EQUAL( t.timezone, timezone );
+            TEST_ASSERT_EQUAL_STRING( t.local, local );
+        }
+        else {
+            TEST_ASSERT_EQUAL( 0, found & ESPRUINO_TIME );
+        }
+    }
+    unsetenv( "TZ" );
+}
+
+/*
+ * every cut of a connect line is safe to run, and the time of a whole one
+ */
+void test_any_prefix_and_speed( void ) {
+    const char *line = "setTime(1600275937);E.setTimeZone(2.0);(s=>{s&&(s.timezone=2.0)&&require('Storage').write('setting.json',s);})(require('Storage').readJSON('setting.json',1))";
+    espruino_cmd_t cmd;
+    char msg[ 100 ];
+    int runs = 0;
+    double seconds;
+
+    for ( size_t i = 0 ; i <= strlen( line ) ; i++ ) {
+        std::string prefix( line, i );
+        uint8_t found = espruino_exec( prefix.c_str(), &cmd );
+        TEST_ASSERT_EQUAL( i < 19 ? 0 : ESPRUINO_TIME | ( i < 38 ? 0 : ESPRUINO_TIMEZONE ), found );
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    do {
+        espruino_exec( line, &cmd );
+        runs++;
+        seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    } while( seconds < 0.2 );
+    snprintf( msg, sizeof( msg ), "%.0f ns per connect line of %d bytes on the host", seconds * 1e9 / runs, (int)strlen( line ) );
+    TEST_MESSAGE( msg );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_time_and_timezone );
+    RUN_TEST( test_everything_else_is_skipped );
+    RUN_TEST( test_out_of_range );
+    RUN_TEST( test_posix_tz );
+    RUN_TEST( test_replay_connect_transcripts );
+    RUN_TEST( test_any_prefix_and_speed );
+    return( UNITY_END() );
+}
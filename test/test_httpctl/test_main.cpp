@@ -0,0 +1,317 @@
+/****************************************************************************
+ *   Sep 22 20:31:12 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+#include "standin_http.h"
+
+#include "hardware/httpctl.cpp"
+#include "hardware/datacache.cpp"
+#include "hardware/json_extract.cpp"
+#include "app/weather/weather_fetch.cpp"
+
+#include <unity.h>
+
+/*
+ * connection pool and pipelining against the stand-in server, the tcp handshakes of each
+ * fetch batch are counted. every test uses its own host, so it starts without a connection
+ */
+#define TEST_PORT       8080
+
+static standin_http_response_t echo_path( const standin_http_request_t &request ) {
+    standin_http_response_t response;
+    response.body = request.path;
+    return( response );
+}
+
+static std::string read_body( httpctl_con_t *con ) {
+    std::string body;
+    char buffer[ 256 ];
+    size_t len;
+
+    while( ( len = httpctl_get_stream( con )->readBytes( buffer, sizeof( buffer ) ) ) > 0 ) {
+        body.append( buffer, len );
+    }
+    return( body );
+}
+
+/*
+ * send a batch of requests on one connection and read all responses
+ */
+static int fetch_batch( const char *host, int count, const char **path ) {
+    httpctl_response_t response;
+    int received = 0;
+
+    httpctl_con_t *con = httpctl_get_pipelined( host, TEST_PORT, count, path, NULL, &response );
+    if ( con == NULL ) {
+        return( 0 );
+    }
+    do {
+        if ( response.httpcode != 200 || read_body( con ) != path[ received ] ) {
+            break;
+        }
+        received++;
+    } while( received < count && httpctl_receive( con, &response ) > 0 );
+    httpctl_close( con );
+    return( received );
+}
+
+static StandinHttp *server = NULL;
+
+void wifictl_register_cb( EventBits_t event, WIFICTL_CALLBACK_FUNC wifictl_event_cb ) {}
+
+void setUp( void ) {
+    native_wifi_connected = true;
+}
+
+/*
+ * a failed assert leaves the test without destructors, so the server is removed here
+ */
+void tearDown( void ) {
+    delete server;
+    server = NULL;
+}
+
+void test_pipelined_batch_takes_one_handshake( void ) {
+    server = new StandinHttp( TEST_PORT, echo_path );
+    const char *path[] = { "/data/2.5/weather", "/data/2.5/forecast", "/three", "/four" };
+    uint32_t lookups = native_dns_lookups;
+
+    TEST_ASSERT_EQUAL( 2, fetch_batch( "batch.local", 2, path ) );
+    TEST_ASSERT_EQUAL( 1, server->handshakes );
+    TEST_ASSERT_EQUAL( 2, server->requests );
+    // both requests went out before the first response was read
+    TEST_ASSERT_EQUAL( 1, server->log[ 1 ].connection );
+    TEST_ASSERT_TRUE( server->log[ 1 ].pipelined );
+
+    // the next batch reuses the keep-alive connection and the dns cache
+    TEST_ASSERT_EQUAL( 4, fetch_batch( "batch.local", 4, path ) );
+    TEST_ASSERT_EQUAL( 1, server->handshakes );
+    TEST_ASSERT_EQUAL( 6, server->requests );
+    TEST_ASSERT_EQUAL( 1, native_dns_lookups - lookups );
+}
+
+void test_too_many_requests_are_refused( void ) {
+    server = new StandinHttp( TEST_PORT, echo_path );
+    const char *path[ HTTPCTL_MAX_PIPELINE + 1 ] = { "/a", "/b", "/c", "/d", "/e" };
+    httpctl_response_t response;
+
+    TEST_ASSERT_NULL( httpctl_get_pipelined( "many.local", TEST_PORT, HTTPCTL_MAX_PIPELINE + 1, path, NULL, &response ) );
+    TEST_ASSERT_EQUAL( 0, server->requests );
+}
+
+void test_idle_connection_expires( void ) {
+    server = new StandinHttp( TEST_PORT, echo_path );
+    const char *path[] = { "/a", "/b" };
+    uint32_t lookups = native_dns_lookups;
+
+    TEST_ASSERT_EQUAL( 2, fetch_batch( "idle.local", 2, path ) );
+    delay( HTTPCTL_KEEPALIVE_TIMEOUT * 1000 + 1 );
+    TEST_ASSERT_EQUAL( 2, fetch_batch( "idle.local", 2, path ) );
+    TEST_ASSERT_EQUAL( 2, server->handshakes );
+    TEST_ASSERT_EQUAL( 1, native_dns_lookups - lookups );
+}
+
+void test_closed_idle_connection_is_replaced( void ) {
+    server = new StandinHttp( TEST_PORT, echo_path );
+    const char *path[] = { "/a", "/b" };
+
+    TEST_ASSERT_EQUAL( 2, fetch_batch( "closed.local", 2, path ) );
+    server->close_all();
+    TEST_ASSERT_EQUAL( 2, fetch_batch( "closed.local", 2, path ) );
+    TEST_ASSERT_EQUAL( 2, server->handshakes );
+}
+
+void test_reused_connection_closed_on_request_is_retried( void ) {
+    // the server closes the idle connection just when the next request arrives
+    server = new StandinHttp( TEST_PORT, []( const standin_http_request_t &request ) {
+        standin_http_response_t response = echo_path( request );
+        if ( request.connection == 1 && request.path == "/again" ) {
+            response.no_response = true;
+            response.close = true;
+        }
+        return( response );
+    } );
+    const char *path[] = { "/first" };
+    const char *again[] = { "/again" };
+
+    TEST_ASSERT_EQUAL( 1, fetch_batch( "race.local", 1, path ) );
+    TEST_ASSERT_EQUAL( 1, fetch_batch( "race.local", 1, again ) );
+    TEST_ASSERT_EQUAL( 2, server->handshakes );
+    TEST_ASSERT_EQUAL( 2, server->log[ 2 ].connection );
+}
+
+void test_close_after_response_loses_the_pipelined_requests( void ) {
+    server = new StandinHttp( TEST_PORT, []( const standin_http_request_t &request ) {
+        standin_http_response_t response = echo_path( request );
+        response.close = true;
+        return( response );
+    } );
+    const char *path[] = { "/a", "/b" };
+    httpctl_response_t response;
+
+    httpctl_con_t *con = httpctl_get_pipelined( "close.local", TEST_PORT, 2, path, NULL, &response );
+    TEST_ASSERT_NOT_NULL( con );
+    TEST_ASSERT_EQUAL( 200, response.httpcode );
+    TEST_ASSERT_FALSE( response.keepalive );
+    TEST_ASSERT_TRUE( read_body( con ) == "/a" );
+    TEST_ASSERT_EQUAL( -1, httpctl_receive( con, &response ) );
+    httpctl_close( con );
+    TEST_ASSERT_EQUAL( 1, server->requests );
+}
+
+void test_chunked_body( void ) {
+    std::string body;
+    for ( int i = 0 ; i < 2500 ; i++ ) {
+        body += 'a' + i % 26;
+    }
+    server = new StandinHttp( TEST_PORT, [ body ]( const standin_http_request_t &request ) {
+        standin_http_response_t response;
+        response.body = request.path == "/chunked" ? body : request.path;
+        response.chunked = request.path == "/chunked";
+        return( response );
+    } );
+    const char *path[] = { "/chunked", "/after" };
+    httpctl_response_t response;
+
+    httpctl_con_t *con = httpctl_get_pipelined( "chunked.local", TEST_PORT, 2, path, NULL, &response );
+    TEST_ASSERT_NOT_NULL( con );
+    TEST_ASSERT_TRUE( response.chunked );
+    TEST_ASSERT_TRUE( read_body( con ) == body );
+    TEST_ASSERT_EQUAL( 200, httpctl_receive( con, &response ) );
+    TEST_ASSERT_TRUE( read_body( con ) == "/after" );
+    httpctl_close( con );
+    TEST_ASSERT_EQUAL( 1, server->handshakes );
+}
+
+void test_read_timeout_across_millis_wrap( void ) {
+    server = new StandinHttp( TEST_PORT, []( const standin_http_request_t &request ) {
+        standin_http_response_t response;
+        response.no_response = true;
+        return( response );
+    } );
+    httpctl_response_t response;
+
+    native_clock = 0xffffffff - HTTPCTL_TIMEOUT / 2;
+    uint32_t start = millis();
+    TEST_ASSERT_NULL( httpctl_get( "http://timeout.local:8080/", NULL, &response ) );
+    TEST_ASSERT_GREATER_OR_EQUAL( HTTPCTL_TIMEOUT, millis() - start );
+    TEST_ASSERT_LESS_THAN( HTTPCTL_TIMEOUT * 2, millis() - start );
+}
+
+void test_dns_cache_across_millis_wrap( void ) {
+    IPAddress ip;
+    uint32_t lookups = native_dns_lookups;
+
+    native_clock = 0xffffffff - 1000;
+    TEST_ASSERT_TRUE( httpctl_resolve( "wrap.local", ip ) );
+    delay( 2000 );
+    TEST_ASSERT_TRUE( httpctl_resolve( "wrap.local", ip ) );
+    TEST_ASSERT_EQUAL( 1, native_dns_lookups - lookups );
+    delay( HTTPCTL_DNS_TTL * 1000 );
+    TEST_ASSERT_TRUE( httpctl_resolve( "wrap.local", ip ) );
+    TEST_ASSERT_EQUAL( 2, native_dns_lookups - lookups );
+    TEST_ASSERT_FALSE( httpctl_resolve( "invalid", ip ) );
+}
+
+/*
+ * weather_fetch() sends the weather and the forecast request as one batch
+ */
+static standin_http_response_t owm( const standin_http_request_t &request ) {
+    standin_http_response_t response;
+
+    if ( StandinHttp::header( request, "If-None-Match" ) == "\"v1\"" ) {
+        response.status = 304;
+        return( response );
+    }
+    response.headers = "ETag: \"v1\"\r\n";
+    if ( request.path.find( "/data/2.5/weather?" ) == 0 ) {
+        response.body = "{\"weather\":[{\"id\":800,\"icon\":\"01d\"}],\"main\":{\"temp\":21.5,\"pressure\":1013,\"humidity\":40},"
+                        "\"wind\":{\"speed\":3.1,\"deg\":200},\"dt\":1600000000,\"name\":\"Berlin\",\"cod\":200}";
+    }
+    else {
+        response.body = "{\"cod\":\"200\",\"cnt\":2,\"list\":[{\"dt\":1600004800,\"main\":{\"temp\":19.2,\"pressure\":1012,\"humidity\":45},"
+                        "\"weather\":[{\"icon\":\"02d\"}],\"wind\":{\"speed\":2.5,\"deg\":180},\"rain\":{\"3h\":0.4}},"
+                        "{\"dt\":1600015600,\"main\":{\"temp\":14.8,\"pressure\":1011,\"humidity\":60},\"weather\":[{\"icon\":\"04n\"}],"
+                        "\"wind\":{\"speed\":1.5,\"deg\":170}}],\"city\":{\"name\":\"Berlin\"}}";
+    }
+    return( response );
+}
+
+void test_weather_fetch_batch( void ) {
+    server = new StandinHttp( 80, owm );
+    weather_config_t config;
+    static weather_data_t data;
+    datacache_t cache;
+
+    strlcpy( config.apikey, "0123456789abcdef", sizeof( config.apikey ) );
+    strlcpy( config.lat, "52.52", sizeof( config.lat ) );
+    strlcpy( config.lon, "13.40", sizeof( config.lon ) );
+    datacache_set_key( &cache, "52.52,13.40" );
+
+    TEST_ASSERT_EQUAL( 200, weather_fetch( &config, &data, &cache ) );
+    TEST_ASSERT_EQUAL( 1, server->handshakes );
+    TEST_ASSERT_EQUAL( 2, server->requests );
+    TEST_ASSERT_TRUE( server->log[ 1 ].pipelined );
+    TEST_ASSERT_EQUAL_STRING( "Berlin", data.today.name );
+    TEST_ASSERT_EQUAL_STRING( "21.5°C", data.today.temp );
+    TEST_ASSERT_EQUAL( 2, data.forecast.count );
+    TEST_ASSERT_EQUAL( 148, data.forecast.temp[ 1 ] );
+    TEST_ASSERT_EQUAL( 4, data.forecast.precipitation[ 0 ] );
+
+    // unchanged data, both requests are conditional and no new connection is needed
+    TEST_ASSERT_EQUAL( 304, weather_fetch( &config, &data, &cache ) );
+    TEST_ASSERT_EQUAL( 1, server->handshakes );
+    TEST_ASSERT_EQUAL( 4, server->requests );
+}
+
+void test_weather_fetch_server_closes_after_weather( void ) {
+    server = new StandinHttp( 80, []( const standin_http_request_t &request ) {
+        standin_http_response_t response = owm( request );
+        response.close = true;
+        return( response );
+    } );
+    weather_config_t config;
+    static weather_data_t data;
+    datacache_t cache;
+
+    datacache_set_key( &cache, "closing" );
+    TEST_ASSERT_EQUAL( 200, weather_fetch( &config, &data, &cache ) );
+    TEST_ASSERT_EQUAL( 2, server->handshakes );
+    TEST_ASSERT_EQUAL( 2, data.forecast.count );
+}
+
+int main( int argc, char **argv ) {
+    httpctl_setup();
+
+    UNITY_BEGIN();
+    RUN_TEST( test_pipelined_batch_takes_one_handshake );
+    RUN_TEST( test_too_many_requests_are_refused );
+    RUN_TEST( test_idle_connection_expires );
+    RUN_TEST( test_closed_idle_connection_is_replaced );
+    RUN_TEST( test_reused_connection_closed_on_request_is_retried );
+    RUN_TEST( test_close_after_response_loses_the_pipelined_requests );
+    RUN_TEST( test_chunked_body );
+    RUN_TEST( test_read_timeout_across_millis_wrap );
+    RUN_TEST( test_dns_cache_across_millis_wrap );
+    RUN_TEST( test_weather_fetch_batch );
+    RUN_TEST( test_weather_fetch_server_closes_after_weather );
+    return( UNITY_END() );
+}
@@ -0,0 +1,117 @@
+/****************************************************************************
+ *   Sep 26 10:12:37 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _PAYLOADS_H
+    #define _PAYLOADS_H
+
+    /*
+     * answer of api.openweathermap.org/data/2.5/weather for one city, metric units
+     */
+    static const char owm_weather[] =
+        "{\"coord\":{\"lon\":6.95,\"lat\":50.93},\"weather\":[{\"id\":803,\"main\":\"Clouds\",\"description\":\"broken clouds\""
+        ",\"icon\":\"04d\"}],\"base\":\"stations\",\"main\":{\"temp\":16.33,\"feels_like\":14.1,\"temp_min\":15.56,\"temp_max\""
+        ":17.22,\"pressure\":1013,\"humidity\":67},\"visibility\":10000,\"wind\":{\"speed\":3.1,\"deg\":230},\"clouds\":{\"a"
+        "ll\":75},\"dt\":1600957834,\"sys\":{\"type\":1,\"id\":1271,\"country\":\"DE\",\"sunrise\":1600925312,\"sunset\":16009"
+        "69005},\"timezone\":7200,\"id\":2886242,\"name\":\"K\303\266ln\",\"cod\":200}";
+
+    /*
+     * answer of api.openweathermap.org/data/2.5/forecast with cnt=16, metric units
+     */
+    static const char owm_forecast[] =
+        "{\"cod\":\"200\",\"message\":0,\"cnt\":16,\"list\":[{\"dt\":1600970400,\"main\":{\"temp\":14.27,\"feels_like\":12.5,\"t"
+        "emp_min\":13.67,\"temp_max\":14.27,\"pressure\":1012,\"sea_level\":1012,\"grnd_level\":1004,\"humidity\":77,\"te"
+        "mp_kf\":0.6},\"weather\":[{\"id\":803,\"main\":\"Clouds\",\"description\":\"broken clouds\",\"icon\":\"04n\"}],\"cloud"
+        "s\":{\"all\":75},\"wind\":{\"speed\":3.6,\"deg\":242,\"gust\":6.1},\"visibility\":10000,\"pop\":0.1,\"sys\":{\"pod\":\"n"
+        "\"},\"dt_txt\":\"2020-09-24 18:00:00\"},{\"dt\":1600981200,\"main\":{\"temp\":13.52,\"feels_like\":11.75,\"temp_mi"
+        "n\":12.92,\"temp_max\":13.52,\"pressure\":1013,\"sea_level\":1013,\"grnd_level\":1005,\"humidity\":76,\"temp_kf\""
+        ":0.6},\"weather\":[{\"id\":500,\"main\":\"Rain\",\"description\":\"light rain\",\"icon\":\"10n\"}],\"clouds\":{\"all\":7"
+        "3},\"wind\":{\"speed\":3.81,\"deg\":245,\"gust\":6.4},\"visibility\":10000,\"pop\":0.15,\"rain\":{\"3h\":0.52},\"sys\""
+        ":{\"pod\":\"n\"},\"dt_txt\":\"2020-09-24 21:00:00\"},{\"dt\":1600992000,\"main\":{\"temp\":14.12,\"feels_like\":12.3"
+        "5,\"temp_min\":13.52,\"temp_max\":14.12,\"pressure\":1014,\"sea_level\":1014,\"grnd_level\":1006,\"humidity\":75"
+        ",\"temp_kf\":0},\"weather\":[{\"id\":500,\"main\":\"Rain\",\"description\":\"light rain\",\"icon\":\"10n\"}],\"clouds\":"
+        "{\"all\":71},\"wind\":{\"speed\":4.02,\"deg\":248,\"gust\":6.7},\"visibility\":10000,\"pop\":0.2,\"rain\":{\"3h\":0.62"
+        "},\"sys\":{\"pod\":\"n\"},\"dt_txt\":\"2020-09-25 00:00:00\"},{\"dt\":1601002800,\"main\":{\"temp\":12.56,\"feels_lik"
+        "e\":10.79,\"temp_min\":11.96,\"temp_max\":12.56,\"pressure\":1015,\"sea_level\":1015,\"grnd_level\":1004,\"humid"
+        "ity\":74,\"temp_kf\":0},\"weather\":[{\"id\":804,\"main\":\"Clouds\",\"description\":\"overcast clouds\",\"icon\":\"04"
+        "n\"}],\"clouds\":{\"all\":69},\"wind\":{\"speed\":4.23,\"deg\":251,\"gust\":7.0},\"visibility\":10000,\"pop\":0.25,\"s"
+        "ys\":{\"pod\":\"n\"},\"dt_txt\":\"2020-09-25 03:00:00\"},{\"dt\":1601013600,\"main\":{\"temp\":13.09,\"feels_like\":1"
+        "1.32,\"temp_min\":12.49,\"temp_max\":13.09,\"pressure\":1012,\"sea_level\":1012,\"grnd_level\":1005,\"humidity\""
+        ":73,\"temp_kf\":0},\"weather\":[{\"id\":800,\"main\":\"Clear\",\"description\":\"clear sky\",\"icon\":\"01d\"}],\"cloud"
+        "s\":{\"all\":67},\"wind\":{\"speed\":4.44,\"deg\":254,\"gust\":7.3},\"visibility\":10000,\"pop\":0.3,\"sys\":{\"pod\":\""
+        "d\"},\"dt_txt\":\"2020-09-25 06:00:00\"},{\"dt\":1601024400,\"main\":{\"temp\":12.35,\"feels_like\":10.58,\"temp_m"
+        "in\":11.75,\"temp_max\":12.35,\"pressure\":1013,\"sea_level\":1013,\"grnd_level\":1006,\"humidity\":72,\"temp_kf"
+        "\":0},\"weather\":[{\"id\":800,\"main\":\"Clear\",\"description\":\"clear sky\",\"icon\":\"01d\"}],\"clouds\":{\"all\":65"
+        "},\"wind\":{\"speed\":4.65,\"deg\":257,\"gust\":7.6},\"visibility\":10000,\"pop\":0.35,\"sys\":{\"pod\":\"d\"},\"dt_txt"
+        "\":\"2020-09-25 09:00:00\"},{\"dt\":1601035200,\"main\":{\"temp\":11.34,\"feels_like\":9.57,\"temp_min\":10.74,\"t"
+        "emp_max\":11.34,\"pressure\":1014,\"sea_level\":1014,\"grnd_level\":1004,\"humidity\":71,\"temp_kf\":0},\"weathe"
+        "r\":[{\"id\":803,\"main\":\"Clouds\",\"description\":\"broken clouds\",\"icon\":\"04d\"}],\"clouds\":{\"all\":63},\"wind"
+        "\":{\"speed\":4.86,\"deg\":260,\"gust\":7.9},\"visibility\":10000,\"pop\":0.4,\"sys\":{\"pod\":\"d\"},\"dt_txt\":\"2020-"
+        "09-25 12:00:00\"},{\"dt\":1601046000,\"main\":{\"temp\":11.83,\"feels_like\":10.06,\"temp_min\":11.23,\"temp_max"
+        "\":11.83,\"pressure\":1015,\"sea_level\":1015,\"grnd_level\":1005,\"humidity\":70,\"temp_kf\":0},\"weather\":[{\"i"
+        "d\":804,\"main\":\"Clouds\",\"description\":\"overcast clouds\",\"icon\":\"04d\"}],\"clouds\":{\"all\":61},\"wind\":{\"s"
+        "peed\":5.07,\"deg\":263,\"gust\":8.2},\"visibility\":10000,\"pop\":0.45,\"sys\":{\"pod\":\"d\"},\"dt_txt\":\"2020-09-2"
+        "5 15:00:00\"},{\"dt\":1601056800,\"main\":{\"temp\":10.49,\"feels_like\":8.72,\"temp_min\":9.89,\"temp_max\":10.4"
+        "9,\"pressure\":1012,\"sea_level\":1012,\"grnd_level\":1006,\"humidity\":69,\"temp_kf\":0},\"weather\":[{\"id\":501"
+        ",\"main\":\"Rain\",\"description\":\"moderate rain\",\"icon\":\"10n\"}],\"clouds\":{\"all\":59},\"wind\":{\"speed\":5.28"
+        ",\"deg\":266,\"gust\":8.5},\"visibility\":10000,\"pop\":0.5,\"rain\":{\"3h\":1.22},\"sys\":{\"pod\":\"n\"},\"dt_txt\":\"2"
+        "020-09-25 18:00:00\"},{\"dt\":1601067600,\"main\":{\"temp\":10.89,\"feels_like\":9.12,\"temp_min\":10.29,\"temp_"
+        "max\":10.89,\"pressure\":1013,\"sea_level\":1013,\"grnd_level\":1004,\"humidity\":68,\"temp_kf\":0},\"weather\":["
+        "{\"id\":500,\"main\":\"Rain\",\"description\":\"light rain\",\"icon\":\"10n\"}],\"clouds\":{\"all\":57},\"wind\":{\"speed"
+        "\":5.49,\"deg\":269,\"gust\":8.8},\"visibility\":10000,\"pop\":0.55,\"rain\":{\"3h\":1.32},\"sys\":{\"pod\":\"n\"},\"dt_"
+        "txt\":\"2020-09-25 21:00:00\"},{\"dt\":1601078400,\"main\":{\"temp\":9.76,\"feels_like\":7.99,\"temp_min\":9.16,\""
+        "temp_max\":9.76,\"pressure\":1014,\"sea_level\":1014,\"grnd_level\":1005,\"humidity\":67,\"temp_kf\":0},\"weathe"
+        "r\":[{\"id\":803,\"main\":\"Clouds\",\"description\":\"broken clouds\",\"icon\":\"04n\"}],\"clouds\":{\"all\":55},\"wind"
+        "\":{\"speed\":5.7,\"deg\":272,\"gust\":9.1},\"visibility\":10000,\"pop\":0.6,\"sys\":{\"pod\":\"n\"},\"dt_txt\":\"2020-0"
+        "9-26 00:00:00\"},{\"dt\":1601089200,\"main\":{\"temp\":9.4,\"feels_like\":7.63,\"temp_min\":8.8,\"temp_max\":9.4,"
+        "\"pressure\":1015,\"sea_level\":1015,\"grnd_level\":1006,\"humidity\":66,\"temp_kf\":0},\"weather\":[{\"id\":800,\""
+        "main\":\"Clear\",\"description\":\"clear sky\",\"icon\":\"01n\"}],\"clouds\":{\"all\":53},\"wind\":{\"speed\":5.91,\"deg"
+        "\":275,\"gust\":9.4},\"visibility\":10000,\"pop\":0.65,\"sys\":{\"pod\":\"n\"},\"dt_txt\":\"2020-09-26 03:00:00\"},{\""
+        "dt\":1601100000,\"main\":{\"temp\":9.67,\"feels_like\":7.9,\"temp_min\":9.07,\"temp_max\":9.67,\"pressure\":1012,"
+        "\"sea_level\":1012,\"grnd_level\":1004,\"humidity\":65,\"temp_kf\":0},\"weather\":[{\"id\":800,\"main\":\"Clear\",\"d"
+        "escription\":\"clear sky\",\"icon\":\"01d\"}],\"clouds\":{\"all\":51},\"wind\":{\"speed\":6.12,\"deg\":278,\"gust\":9.7"
+        "},\"visibility\":10000,\"pop\":0.7,\"sys\":{\"pod\":\"d\"},\"dt_txt\":\"2020-09-26 06:00:00\"},{\"dt\":1601110800,\"m"
+        "ain\":{\"temp\":10.07,\"feels_like\":8.3,\"temp_min\":9.47,\"temp_max\":10.07,\"pressure\":1013,\"sea_level\":101"
+        "3,\"grnd_level\":1005,\"humidity\":64,\"temp_kf\":0},\"weather\":[{\"id\":600,\"main\":\"Snow\",\"description\":\"lig"
+        "ht snow\",\"icon\":\"13d\"}],\"clouds\":{\"all\":49},\"wind\":{\"speed\":6.33,\"deg\":281,\"gust\":10.0},\"visibility\""
+        ":10000,\"pop\":0.75,\"snow\":{\"3h\":0.31},\"sys\":{\"pod\":\"d\"},\"dt_txt\":\"2020-09-26 09:00:00\"},{\"dt\":1601121"
+        "600,\"main\":{\"temp\":8.27,\"feels_like\":6.5,\"temp_min\":7.67,\"temp_max\":8.27,\"pressure\":1014,\"sea_level\""
+        ":1014,\"grnd_level\":1006,\"humidity\":63,\"temp_kf\":0},\"weather\":[{\"id\":804,\"main\":\"Clouds\",\"description"
+        "\":\"overcast clouds\",\"icon\":\"04d\"}],\"clouds\":{\"all\":47},\"wind\":{\"speed\":6.54,\"deg\":284,\"gust\":10.3},\""
+        "visibility\":10000,\"pop\":0.8,\"sys\":{\"pod\":\"d\"},\"dt_txt\":\"2020-09-26 12:00:00\"},{\"dt\":1601132400,\"main"
+        "\":{\"temp\":8.07,\"feels_like\":6.3,\"temp_min\":7.47,\"temp_max\":8.07,\"pressure\":1015,\"sea_level\":1015,\"gr"
+        "nd_level\":1004,\"humidity\":62,\"temp_kf\":0},\"weather\":[{\"id\":803,\"main\":\"Clouds\",\"description\":\"broken"
+        " clouds\",\"icon\":\"04d\"}],\"clouds\":{\"all\":45},\"wind\":{\"speed\":6.75,\"deg\":287,\"gust\":10.6},\"visibility\""
+        ":10000,\"pop\":0.85,\"sys\":{\"pod\":\"d\"},\"dt_txt\":\"2020-09-26 15:00:00\"}],\"city\":{\"id\":2886242,\"name\":\"K\303\266"
+        "ln\",\"coord\":{\"lat\":50.9333,\"lon\":6.95},\"country\":\"DE\",\"population\":963395,\"timezone\":7200,\"sunrise\":"
+        "1600925312,\"sunset\":1600969005}}";
+
+    /*
+     * answer of /api/CryptoTicker/24hrStatistics/BTCUSDT, the binance 24hr ticker
+     */
+    static const char crypto_statistics[] =
+        "{\"symbol\":\"BTCUSDT\",\"priceChange\":\"-212.67000000\",\"priceChangePercent\":\"-1.979\",\"weightedAvgPrice\":\""
+        "10591.29714252\",\"prevClosePrice\":\"10746.32000000\",\"lastPrice\":\"10533.65000000\",\"lastQty\":\"0.003254\","
+        "\"bidPrice\":\"10533.64000000\",\"bidQty\":\"0.514617\",\"askPrice\":\"10533.65000000\",\"askQty\":\"1.200000\",\"ope"
+        "nPrice\":\"10746.32000000\",\"highPrice\":\"10786.00000000\",\"lowPrice\":\"10254.51000000\",\"volume\":\"60118.13"
+        "469200\",\"quoteVolume\":\"636725862.71563281\",\"openTime\":1600871434016,\"closeTime\":1600957834016,\"first"
+        "Id\":434201516,\"lastId\":435118301,\"count\":916786}";
+
+#endif // _PAYLOADS_H
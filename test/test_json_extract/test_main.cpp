@@ -0,0 +1,287 @@
+/****************************************************************************
+ *   Sep 26 10:12:37 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+#include "Stream.h"
+
+#include "hardware/json_extract.cpp"
+
+#include <unity.h>
+
+#include "payloads.h"
+
+/*
+ * the same structs and field tables as weather_fetch.cpp and crypto_ticker_fetch.cpp
+ */
+typedef struct {
+    int32_t timestamp;
+    float temp;
+    float humidity;
+    float pressure;
+    float wind_speed;
+    int32_t wind_deg;
+    float rain;
+    float snow;
+    char icon[8];
+} weather_fetch_entry_t;
+
+typedef struct {
+    char name[32];
+    weather_fetch_entry_t today;
+} weather_fetch_today_t;
+
+typedef struct {
+    char name[32];
+    weather_fetch_entry_t list[ 16 ];
+} weather_fetch_forecast_t;
+
+typedef struct {
+    char lastPrice[50];
+    char priceChangePercent[50];
+    char volume[50];
+} crypto_ticker_data_t;
+
+static const json_extract_field_t weather_today_fields[] = {
+    JSON_EXTRACT_FIELD( "name",              JSON_EXTRACT_STRING, weather_fetch_today_t, name ),
+    JSON_EXTRACT_FIELD( "dt",                JSON_EXTRACT_INT,    weather_fetch_today_t, today.timestamp ),
+    JSON_EXTRACT_FIELD( "main.temp",         JSON_EXTRACT_FLOAT,  weather_fetch_today_t, today.temp ),
+    JSON_EXTRACT_FIELD( "main.humidity",     JSON_EXTRACT_FLOAT,  weather_fetch_today_t, today.humidity ),
+    JSON_EXTRACT_FIELD( "main.pressure",     JSON_EXTRACT_FLOAT,  weather_fetch_today_t, today.pressure ),
+    JSON_EXTRACT_FIELD( "weather[0].icon",   JSON_EXTRACT_STRING, weather_fetch_today_t, today.icon ),
+    JSON_EXTRACT_FIELD( "wind.speed",        JSON_EXTRACT_FLOAT,  weather_fetch_today_t, today.wind_speed ),
+    JSON_EXTRACT_FIELD( "wind.deg",          JSON_EXTRACT_INT,    weather_fetch_today_t, today.wind_deg )
+};
+
+static const json_extract_field_t weather_forecast_fields[] = {
+    JSON_EXTRACT_FIELD( "city.name",                     JSON_EXTRACT_STRING, weather_fetch_forecast_t, name ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].dt",               JSON_EXTRACT_INT,    weather_fetch_forecast_t, list, timestamp ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].main.temp",        JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, temp ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].main.humidity",    JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, humidity ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].main.pressure",    JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, pressure ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].weather[0].icon",  JSON_EXTRACT_STRING, weather_fetch_forecast_t, list, icon ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].wind.speed",       JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, wind_speed ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].wind.deg",         JSON_EXTRACT_INT,    weather_fetch_forecast_t, list, wind_deg ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].rain.3h",          JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, rain ),
+    JSON_EXTRACT_ARRAY_FIELD( "list[].snow.3h",          JSON_EXTRACT_FLOAT,  weather_fetch_forecast_t, list, snow )
+};
+
+static const json_extract_field_t crypto_ticker_statistics_fields[] = {
+    JSON_EXTRACT_FIELD( "lastPrice",            JSON_EXTRACT_STRING, crypto_ticker_data_t, lastPrice ),
+    JSON_EXTRACT_FIELD( "priceChangePercent",   JSON_EXTRACT_STRING, crypto_ticker_data_t, priceChangePercent ),
+    JSON_EXTRACT_FIELD( "volume",               JSON_EXTRACT_STRING, crypto_ticker_data_t, volume )
+};
+
+typedef struct {
+    char name[32];
+    char short_name[8];
+} text_t;
+
+static const json_extract_field_t text_fields[] = {
+    JSON_EXTRACT_FIELD( "name",     JSON_EXTRACT_STRING, text_t, name ),
+    JSON_EXTRACT_FIELD( "short",    JSON_EXTRACT_STRING, text_t, short_name )
+};
+
+/*
+ * a payload that arrives in tcp segments, available() never reaches over the end
+ * of the current segment like the WiFiClient
+ */
+class NativeJsonStream : public Stream {
+    public:
+        NativeJsonStream( const char *payload, size_t segment_size ) : data( payload ), len( strlen( payload ) ), segment( segment_size ) {}
+        int available( void ) {
+            size_t left = len - pos;
+            size_t in_segment = segment - pos % segment;
+            return( left < in_segment ? left : in_segment );
+        }
+        int read( void ) { return( pos < len ? (uint8_t)data[ pos++ ] : -1 ); }
+        int peek( void ) { return( pos < len ? (uint8_t)data[ pos ] : -1 ); }
+        size_t write( uint8_t c ) { return( 0 ); }
+
+    private:
+        const char *data;
+        size_t len;
+        size_t pos = 0;
+        size_t segment;
+};
+
+template< typename T > static int extract( const char *payload, const json_extract_field_t *fields, size_t field_count, T *dest, size_t segment = 1460 ) {
+    NativeJsonStream stream( payload, segment );
+
+    memset( dest, 0, sizeof( T ) );
+    return( json_extract( stream, fields, field_count, dest ) );
+}
+
+#define FIELD_COUNT( fields )       ( sizeof( fields ) / sizeof( json_extract_field_t ) )
+
+void setUp( void ) {
+}
+
+void tearDown( void ) {
+}
+
+void test_owm_weather( void ) {
+    weather_fetch_today_t today;
+
+    TEST_ASSERT_EQUAL( 8, extract( owm_weather, weather_today_fields, FIELD_COUNT( weather_today_fields ), &today ) );
+    TEST_ASSERT_EQUAL_STRING( "K\xc3\xb6ln", today.name );
+    TEST_ASSERT_EQUAL( 1600957834, today.today.timestamp );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 16.33, today.today.temp );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 67, today.today.humidity );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 1013, today.today.pressure );
+    TEST_ASSERT_EQUAL_STRING( "04d", today.today.icon );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 3.1, today.today.wind_speed );
+    TEST_ASSERT_EQUAL( 230, today.today.wind_deg );
+}
+
+void test_owm_forecast_in_any_segment_size( void ) {
+    static const size_t segments[] = { 1, 7, 536, 1460, 65536 };
+    weather_fetch_forecast_t forecast, other;
+
+    TEST_ASSERT_EQUAL( 1 + 16 * 7 + 4 + 1, extract( owm_forecast, weather_forecast_fields, FIELD_COUNT( weather_forecast_fields ), &forecast ) );
+    TEST_ASSERT_EQUAL_STRING( "K\xc3\xb6ln", forecast.name );
+
+    TEST_ASSERT_EQUAL( 1600970400, forecast.list[ 0 ].timestamp );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 14.27, forecast.list[ 0 ].temp );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 77, forecast.list[ 0 ].humidity );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 1012, forecast.list[ 0 ].pressure );
+    TEST_ASSERT_EQUAL_STRING( "04n", forecast.list[ 0 ].icon );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 3.6, forecast.list[ 0 ].wind_speed );
+    TEST_ASSERT_EQUAL( 242, forecast.list[ 0 ].wind_deg );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 0, forecast.list[ 0 ].rain );
+
+    TEST_ASSERT_EQUAL( 1600981200, forecast.list[ 1 ].timestamp );
+    TEST_ASSERT_EQUAL_STRING( "10n", forecast.list[ 1 ].icon );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 0.52, forecast.list[ 1 ].rain );
+
+    TEST_ASSERT_EQUAL_STRING( "13d", forecast.list[ 13 ].icon );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 0.31, forecast.list[ 13 ].snow );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 10.07, forecast.list[ 13 ].temp );
+
+    TEST_ASSERT_EQUAL( 1601132400, forecast.list[ 15 ].timestamp );
+    TEST_ASSERT_FLOAT_WITHIN( 0.001, 8.07, forecast.list[ 15 ].temp );
+    TEST_ASSERT_EQUAL( 287, forecast.list[ 15 ].wind_deg );
+
+    for ( auto segment : segments ) {
+        TEST_ASSERT_EQUAL( 1 + 16 * 7 + 4 + 1, extract( owm_forecast, weather_forecast_fields, FIELD_COUNT( weather_forecast_fields ), &other, segment ) );
+        TEST_ASSERT_EQUAL_MEMORY( &forecast, &other, sizeof( forecast ) );
+    }
+}
+
+void test_crypto_statistics( void ) {
+    crypto_ticker_data_t data;
+
+    TEST_ASSERT_EQUAL( 3, extract( crypto_statistics, crypto_ticker_statistics_fields, FIELD_COUNT( crypto_ticker_statistics_fields ), &data ) );
+    TEST_ASSERT_EQUAL_STRING( "10533.65000000", data.lastPrice );
+    TEST_ASSERT_EQUAL_STRING( "-1.979", data.priceChangePercent );
+    TEST_ASSERT_EQUAL_STRING( "60118.13469200", data.volume );
+}
+
+void test_surrogate_pairs( void ) {
+    text_t text;
+
+    TEST_ASSERT_EQUAL( 1, extract( "{\"name\":\"Caf\\u00e9 \\ud83c\\udf27 \\uD83D\\uDE00\"}", text_fields, FIELD_COUNT( text_fields ), &text ) );
+    TEST_ASSERT_EQUAL_STRING( "Caf\xc3\xa9 \xf0\x9f\x8c\xa7 \xf0\x9f\x98\x80", text.name );
+
+    /*
+     * lone surrogates, a high one before a plain char, an escape, the end and a low one alone
+     */
+    TEST_ASSERT_EQUAL( 1, extract( "{\"name\":\"a\\ud83cb\\ud83c\\nc\\udf27d\\ud83c\"}", text_fields, FIELD_COUNT( text_fields ), &text ) );
+    TEST_ASSERT_EQUAL_STRING( "a\xef\xbf\xbd" "b\xef\xbf\xbd\nc\xef\xbf\xbd" "d\xef\xbf\xbd", text.name );
+
+    /*
+     * two high surrogates, only the second one has its pair
+     */
+    TEST_ASSERT_EQUAL( 1, extract( "{\"name\":\"\\ud83c\\ud83c\\udf27\"}", text_fields, FIELD_COUNT( text_fields ), &text ) );
+    TEST_ASSERT_EQUAL_STRING( "\xef\xbf\xbd\xf0\x9f\x8c\xa7", text.name );
+
+    TEST_ASSERT_EQUAL( -1, extract( "{\"name\":\"\\ud83c\\udf2\"}", text_fields, FIELD_COUNT( text_fields ), &text ) );
+}
+
+void test_truncated_strings_keep_whole_chars( void ) {
+    text_t text;
+
+    TEST_ASSERT_EQUAL( 1, extract( "{\"short\":\"ab\\u00e9\\ud83c\\udf27x\"}", text_fields, FIELD_COUNT( text_fields ), &text ) );
+    TEST_ASSERT_EQUAL_STRING( "ab\xc3\xa9", text.short_name );
+
+    TEST_ASSERT_EQUAL( 1, extract( "{\"short\":\"abcdef\xc3\xa9x\"}", text_fields, FIELD_COUNT( text_fields ), &text ) );
+    TEST_ASSERT_EQUAL_STRING( "abcdef", text.short_name );
+
+    TEST_ASSERT_EQUAL( 1, extract( "{\"short\":\"abc\xf0\x9f\x8c\xa7x\"}", text_fields, FIELD_COUNT( text_fields ), &text ) );
+    TEST_ASSERT_EQUAL_STRING( "abc\xf0\x9f\x8c\xa7", text.short_name );
+}
+
+void test_parse_errors_and_trailing_data( void ) {
+    weather_fetch_forecast_t forecast;
+    std::string cut( owm_forecast, sizeof( owm_forecast ) / 2 );
+
+    TEST_ASSERT_EQUAL( -1, extract( cut.c_str(), weather_forecast_fields, FIELD_COUNT( weather_forecast_fields ), &forecast ) );
+    TEST_ASSERT_EQUAL( -1, extract( "{\"list\":[1,2}", weather_forecast_fields, FIELD_COUNT( weather_forecast_fields ), &forecast ) );
+    TEST_ASSERT_EQUAL( -1, extract( "", weather_forecast_fields, FIELD_COUNT( weather_forecast_fields ), &forecast ) );
+
+    /*
+     * the end of the document ends the extraction, the httpctl stream ends at the body
+     */
+    std::string trailing = std::string( crypto_statistics ) + "\r\n{\"lastPrice\":\"0\"}";
+    crypto_ticker_data_t data;
+    TEST_ASSERT_EQUAL( 3, extract( trailing.c_str(), crypto_ticker_statistics_fields, FIELD_COUNT( crypto_ticker_statistics_fields ), &data ) );
+    TEST_ASSERT_EQUAL_STRING( "10533.65000000", data.lastPrice );
+}
+
+/*
+ * the DOM before took getSize() * 2 bytes of psram, the extractor only its state
+ */
+void test_benchmark( void ) {
+    static const struct { const char *name; const char *payload; const json_extract_field_t *fields; size_t field_count; } payloads[] = {
+        { "owm weather", owm_weather, weather_today_fields, FIELD_COUNT( weather_today_fields ) },
+        { "owm forecast", owm_forecast, weather_forecast_fields, FIELD_COUNT( weather_forecast_fields ) },
+        { "crypto statistics", crypto_statistics, crypto_ticker_statistics_fields, FIELD_COUNT( crypto_ticker_statistics_fields ) },
+    };
+    weather_fetch_forecast_t dest;
+    char msg[ 160 ];
+
+    for ( auto &payload : payloads ) {
+        size_t len = strlen( payload.payload );
+        size_t runs = 0;
+        double seconds;
+        auto start = std::chrono::steady_clock::now();
+        do {
+            NativeJsonStream stream( payload.payload, 1460 );
+            TEST_ASSERT_GREATER_THAN( 0, json_extract( stream, payload.fields, payload.field_count, &dest ) );
+            runs++;
+            seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+        } while( seconds < 0.2 );
+        snprintf( msg, sizeof( msg ), "%s: %d bytes, %.1f MB/s on the host, heap %d bytes (DOM before: %d bytes)",
+                  payload.name, (int)len, runs * len / seconds / 1e6, (int)sizeof( json_extract_ctx_t ), (int)( len * 2 ) );
+        TEST_MESSAGE( msg );
+    }
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_owm_weather );
+    RUN_TEST( test_owm_forecast_in_any_segment_size );
+    RUN_TEST( test_crypto_statistics );
+    RUN_TEST( test_surrogate_pairs );
+    RUN_TEST( test_truncated_strings_keep_whole_chars );
+    RUN_TEST( test_parse_errors_and_trailing_data );
+    RUN_TEST( test_benchmark );
+    return( UNITY_END() );
+}
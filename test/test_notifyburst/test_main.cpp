@@ -0,0 +1,256 @@
+/****************************************************************************
+ *   Sep 28 10:12:37 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "hardware/notifyrules.cpp"
+#include "hardware/notifyburst.cpp"
+
+#include <unity.h>
+
+static notifyburst_t burst;
+static notifyburst_summary_t summary;
+
+void setUp( void ) {
+    notifyburst_init( &burst, 2000 );
+}
+
+void tearDown( void ) {
+}
+
+void test_same_id_replaces_the_notification( void ) {
+    notifyburst_add( &burst, 7, "Whatsapp", "Alice", "see you", NOTIFYRULES_WAKE, 0 );
+    notifyburst_add( &burst, 7, "Whatsapp", "Alice", "see you at 8", NOTIFYRULES_WAKE, 100 );
+    TEST_ASSERT_EQUAL( 1, burst.total );
+    TEST_ASSERT_EQUAL( 1, burst.entries );
+    TEST_ASSERT_EQUAL( 1, burst.merged );
+
+    notifyburst_take( &burst, &summary );
+    TEST_ASSERT_EQUAL( 1, summary.total );
+    TEST_ASSERT_EQUAL_STRING( "Whatsapp", summary.src );
+    TEST_ASSERT_EQUAL_STRING( "Alice", summary.title );
+    TEST_ASSERT_EQUAL_STRING( "see you at 8", summary.body );
+    TEST_ASSERT_FALSE( burst.open );
+}
+
+/*
+ * the same app and title is one conversation, case does not matter
+ */
+void test_conversation_is_merged( void ) {
+    notifyburst_add( &burst, 1, "Whatsapp", "Family", "one", NOTIFYRULES_WAKE, 0 );
+    notifyburst_add( &burst, 2, "Whatsapp", "Work", "meeting", NOTIFYRULES_WAKE, 10 );
+    notifyburst_add( &burst, 3, "WhatsApp", "family", "two", NOTIFYRULES_WAKE, 20 );
+    notifyburst_add( &burst, 4, "Whatsapp", "Family", "three", NOTIFYRULES_WAKE, 30 );
+    TEST_ASSERT_EQUAL( 4, burst.total );
+    TEST_ASSERT_EQUAL( 2, burst.entries );
+    TEST_ASSERT_EQUAL( 3, burst.entry[ 1 ].count );
+
+    notifyburst_take( &burst, &summary );
+    TEST_ASSERT_EQUAL( 2, summary.conversations );
+    TEST_ASSERT_EQUAL_STRING( "Whatsapp", summary.src );
+    TEST_ASSERT_EQUAL_STRING( "4 messages in 2 chats", summary.title );
+    TEST_ASSERT_EQUAL_STRING( "Family (3): three\nWork: meeting\n", summary.body );
+
+    notifyburst_add( &burst, 5, "Whatsapp", "Family", "four", NOTIFYRULES_WAKE, 3000 );
+    notifyburst_add( &burst, 6, "Whatsapp", "Family", "five", NOTIFYRULES_WAKE, 3100 );
+    notifyburst_take( &burst, &summary );
+    TEST_ASSERT_EQUAL_STRING( "Family (2)", summary.title );
+    TEST_ASSERT_EQUAL_STRING( "five", summary.body );
+}
+
+/*
+ * more conversations than entries are only counted, the body stays in size
+ */
+void test_more_conversations_than_entries( void ) {
+    char title[ 16 ];
+    std::string body( 200, 'x' );
+
+    for ( int i = 0 ; i < NOTIFYBURST_ENTRIES + 2 ; i++ ) {
+        snprintf( title, sizeof( title ), "chat %d", i );
+        notifyburst_add( &burst, 10 + i, i % 2 ? "Telegram" : "Whatsapp", title, "hi", NOTIFYRULES_WAKE, i * 10 );
+    }
+    TEST_ASSERT_EQUAL( NOTIFYBURST_ENTRIES, burst.entries );
+    TEST_ASSERT_EQUAL( 2, burst.others );
+
+    notifyburst_take( &burst, &summary );
+    TEST_ASSERT_EQUAL( NOTIFYBURST_ENTRIES + 2, summary.total );
+    TEST_ASSERT_EQUAL( NOTIFYBURST_ENTRIES + 1, summary.conversations );
+    TEST_ASSERT_EQUAL_STRING( "", summary.src );
+    TEST_ASSERT_EQUAL_STRING( "8 messages in 7 chats", summary.title );
+    TEST_ASSERT_EQUAL_STRING( "chat 5: hi\nchat 4: hi\nchat 3: hi\nchat 2: hi\nchat 1: hi\nchat 0: hi\nand 2 more\n", summary.body );
+
+    /*
+     * full bodies fill the summary, the rest is cut and the title still counts all
+     */
+    for ( int i = 0 ; i < NOTIFYBURST_ENTRIES + 2 ; i++ ) {
+        snprintf( title, sizeof( title ), "chat %d", i );
+        notifyburst_add( &burst, 20 + i, "Whatsapp", title, body.c_str(), NOTIFYRULES_WAKE, 5000 + i * 10 );
+    }
+    notifyburst_take( &burst, &summary );
+    TEST_ASSERT_EQUAL_STRING( "8 messages in 7 chats", summary.title );
+    TEST_ASSERT_EQUAL( 0, strncmp( summary.body, "chat 5: xxx", 11 ) );
+    TEST_ASSERT_EQUAL( sizeof( summary.body ) - 1, strlen( summary.body ) );
+}
+
+/*
+ * a burst ends after a quiet window, a chat that never stops after two windows
+ */
+void test_window_ends_the_burst( void ) {
+    notifyburst_add( &burst, 1, "Whatsapp", "Family", "one", NOTIFYRULES_WAKE, 1000 );
+    TEST_ASSERT_FALSE( notifyburst_due( &burst, 2999 ) );
+    TEST_ASSERT_TRUE( notifyburst_due( &burst, 3000 ) );
+    notifyburst_take( &burst, &summary );
+    TEST_ASSERT_FALSE( notifyburst_due( &burst, 10000 ) );
+
+    for ( uint32_t now = 10000 ; now < 10000 + 2000 * NOTIFYBURST_MAX_WINDOWS ; now += 500 ) {
+        notifyburst_add( &burst, 0, "Whatsapp", "Family", "more", NOTIFYRULES_WAKE, now );
+        TEST_ASSERT_FALSE( notifyburst_due( &burst, now + 499 ) );
+    }
+    TEST_ASSERT_TRUE( notifyburst_due( &burst, 10000 + 2000 * NOTIFYBURST_MAX_WINDOWS ) );
+
+    notifyburst_init( &burst, 0 );
+    notifyburst_add( &burst, 1, "Whatsapp", "Family", "one", NOTIFYRULES_WAKE, 1000 );
+    TEST_ASSERT_TRUE( notifyburst_due( &burst, 1000 ) );
+}
+
+void test_loudest_action_wins( void ) {
+    notifyburst_add( &burst, 1, "Telegram", "Bob", "hi", NOTIFYRULES_VIBE, 0 );
+    notifyburst_add( &burst, 2, "Telegram", "Mom", "call me", NOTIFYRULES_WAKE, 10 );
+    notifyburst_add( &burst, 3, "Telegram", "Bob", "?", NOTIFYRULES_VIBE, 20 );
+    notifyburst_take( &burst, &summary );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_WAKE, summary.action );
+    TEST_ASSERT_EQUAL_STRING( "Telegram", summary.src );
+
+    notifyburst_add( &burst, 4, "Telegram", "Bob", "hi", NOTIFYRULES_VIBE, 5000 );
+    notifyburst_take( &burst, &summary );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_VIBE, summary.action );
+    TEST_ASSERT_EQUAL( 2, burst.alerts );
+}
+
+/*
+ * an evening: single chats every few minutes, a group chat burst with edits and a
+ * second chat in between, and a mail sync. a wake alert wakes up, vibrates and
+ * redraws, a vibe alert only vibrates. before every notification was one alert
+ */
+struct trace_t {
+    uint32_t t;
+    uint32_t id;
+    const char *src;
+    std::string title;
+    std::string body;
+    uint8_t action;
+};
+
+static uint32_t xorshift32( uint32_t *x ) {
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return( *x );
+}
+
+static std::vector< trace_t > evening( void ) {
+    std::vector< trace_t > trace;
+    uint32_t x = 3, t = 0, id = 100;
+
+    for ( int i = 0 ; i < 20 ; i++ ) {
+        t += 60000 + xorshift32( &x ) % 240000;
+        trace.push_back( { t, id++, "Telegram", "Bob", "single " + std::to_string( i ), NOTIFYRULES_VIBE } );
+    }
+    t = 600000;
+    for ( int i = 0 ; i < 30 ; i++ ) {
+        t += 150 + xorshift32( &x ) % 600;
+        trace.push_back( { t, id++, "Whatsapp", "Family", "burst msg " + std::to_string( i ), NOTIFYRULES_WAKE } );
+        if ( i % 5 == 4 ) {
+            trace.push_back( { t + 50, id - 1, "Whatsapp", "Family", "burst msg " + std::to_string( i ) + " (edited)", NOTIFYRULES_WAKE } );
+        }
+        if ( i % 7 == 3 ) {
+            trace.push_back( { t + 80, id++, "Whatsapp", "Work", "work " + std::to_string( i ), NOTIFYRULES_VIBE } );
+        }
+    }
+    t = 2400000;
+    for ( int i = 0 ; i < 15 ; i++ ) {
+        t += 100 + xorshift32( &x ) % 300;
+        trace.push_back( { t, id++, i % 2 ? "K-9 Mail" : "Gmail", "Newsletter " + std::to_string( i % 4 ), "mail " + std::to_string( i ), NOTIFYRULES_VIBE } );
+    }
+    std::stable_sort( trace.begin(), trace.end(), []( const trace_t &a, const trace_t &b ) { return( a.t < b.t ); } );
+    return( trace );
+}
+
+void test_replay_an_evening( void ) {
+    std::vector< trace_t > trace = evening();
+    int wakeups[ 4 ] = { 0 };
+    int vibes[ 4 ] = { 0 };
+    uint32_t windows[ 4 ] = { 0, 1000, 2000, 5000 };
+    char msg[ 200 ];
+
+    for ( int w = 0 ; w < 4 ; w++ ) {
+        size_t next = 0;
+        uint32_t first = 0, max_delay = 0, shown = 0;
+
+        notifyburst_init( &burst, windows[ w ] );
+        for ( uint32_t now = 0 ; now < 4000000 ; now += 5 ) {
+            while ( next < trace.size() && trace[ next ].t <= now ) {
+                if ( !burst.open ) {
+                    first = now;
+                }
+                notifyburst_add( &burst, trace[ next ].id, trace[ next ].src, trace[ next ].title.c_str(), trace[ next ].body.c_str(), trace[ next ].action, now );
+                next++;
+            }
+            if ( notifyburst_due( &burst, now ) ) {
+                notifyburst_take( &burst, &summary );
+                max_delay = std::max( max_delay, now - first );
+                shown += summary.total;
+                vibes[ w ]++;
+                if ( summary.action == NOTIFYRULES_WAKE ) {
+                    wakeups[ w ]++;
+                }
+            }
+        }
+        /*
+         * nothing is lost, an edit in the same burst is not a message of its own and
+         * no alert comes later than the longest burst. an edit after the burst of its
+         * message is alerted again
+         */
+        TEST_ASSERT_EQUAL( trace.size(), burst.received );
+        TEST_ASSERT_LESS_OR_EQUAL( trace.size(), shown );
+        TEST_ASSERT_GREATER_OR_EQUAL( 69, shown );
+        TEST_ASSERT_LESS_OR_EQUAL( windows[ w ] * NOTIFYBURST_MAX_WINDOWS, max_delay );
+
+        snprintf( msg, sizeof( msg ), "window %4dms: %3d wakeups, %3d vibes, %3d redraws, %2d messages, %2d merged, first notification shown after at most %dms",
+                  windows[ w ], wakeups[ w ], vibes[ w ], wakeups[ w ], shown, burst.merged, max_delay );
+        TEST_MESSAGE( msg );
+    }
+    TEST_ASSERT_EQUAL( 75, trace.size() );
+    TEST_ASSERT_EQUAL( 75, vibes[ 0 ] );
+    TEST_ASSERT_LESS_THAN( vibes[ 0 ] / 2, vibes[ 2 ] );
+    TEST_ASSERT_LESS_THAN( wakeups[ 0 ] / 4, wakeups[ 2 ] );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_same_id_replaces_the_notification );
+    RUN_TEST( test_conversation_is_merged );
+    RUN_TEST( test_more_conversations_than_entries );
+    RUN_TEST( test_window_ends_the_burst );
+    RUN_TEST( test_loudest_action_wins );
+    RUN_TEST( test_replay_an_evening );
+    return( UNITY_END() );
+}
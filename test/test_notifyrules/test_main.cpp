@@ -0,0 +1,226 @@
+/****************************************************************************
+ *   Sep 27 18:03:27 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "hardware/notifyrules.cpp"
+
+#include <unity.h>
+
+#define M( h, m )   ( ( h ) * 60 + ( m ) )
+
+static const notifyrules_rule_t config[] = {
+    { "Whatsapp", "", M( 9, 0 ), M( 17, 0 ), NOTIFYRULES_VIBE, false },
+    { "Gmail", "", 0, 0, NOTIFYRULES_SILENT, false },
+    { "Telegram", "Mom", 0, 0, NOTIFYRULES_WAKE, true },
+    { "Telegram", "", 0, 0, NOTIFYRULES_VIBE, false },
+    { "", "Boss", M( 8, 0 ), M( 18, 0 ), NOTIFYRULES_WAKE, false },
+    { "", "", M( 12, 0 ), M( 13, 0 ), NOTIFYRULES_SILENT, false },
+};
+
+static const notifyrules_rule_t dnd = { "", "", M( 22, 0 ), M( 7, 0 ), NOTIFYRULES_SILENT, false };
+
+static notifyrules_t rules;
+
+void setUp( void ) {
+    notifyrules_compile( &rules, config, sizeof( config ) / sizeof( notifyrules_rule_t ), &dnd );
+}
+
+void tearDown( void ) {
+}
+
+void test_most_specific_rule_wins( void ) {
+    struct {
+        const char *src;
+        const char *sender;
+        uint16_t minute;
+        uint8_t action;
+    } cases[] = {
+        { "Whatsapp", "Bob", M( 10, 0 ), NOTIFYRULES_VIBE },
+        { "WhatsApp", "Bob", M( 18, 0 ), NOTIFYRULES_WAKE },         // not case sensitive, outside the window
+        { "Whatsapp", "Boss", M( 10, 0 ), NOTIFYRULES_VIBE },        // a src rule beats a sender rule
+        { "K-9 Mail", "Boss", M( 10, 0 ), NOTIFYRULES_WAKE },
+        { "K-9 Mail", "Boss", M( 12, 30 ), NOTIFYRULES_WAKE },       // a sender rule beats the lunch rule
+        { "K-9 Mail", "Bob", M( 12, 30 ), NOTIFYRULES_SILENT },
+        { "Gmail", "x", M( 10, 0 ), NOTIFYRULES_SILENT },
+        { "Telegram", "mom", M( 10, 0 ), NOTIFYRULES_WAKE },         // src and sender beat src
+        { "Telegram", "Bob", M( 10, 0 ), NOTIFYRULES_VIBE },
+        { NULL, NULL, M( 10, 0 ), NOTIFYRULES_WAKE },
+        { NULL, "Boss", M( 10, 0 ), NOTIFYRULES_WAKE },
+        { "", "", M( 12, 0 ), NOTIFYRULES_SILENT },
+        { "", "", M( 13, 0 ), NOTIFYRULES_WAKE },
+    };
+
+    for ( auto &c : cases ) {
+        TEST_ASSERT_EQUAL( c.action, notifyrules_match( &rules, c.src, c.sender, c.minute ) );
+    }
+}
+
+/*
+ * do not disturb goes over midnight and only an override rule is louder
+ */
+void test_do_not_disturb( void ) {
+    TEST_ASSERT_EQUAL( NOTIFYRULES_WAKE, notifyrules_match( &rules, "Telegram", "Mom", M( 23, 0 ) ) );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_SILENT, notifyrules_match( &rules, "Telegram", "Bob", M( 23, 0 ) ) );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_SILENT, notifyrules_match( &rules, "Telegram", "Bob", M( 6, 59 ) ) );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_VIBE, notifyrules_match( &rules, "Telegram", "Bob", M( 7, 0 ) ) );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_SILENT, notifyrules_match( &rules, "Unknown", NULL, M( 23, 30 ) ) );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_WAKE, notifyrules_match( &rules, "Unknown", NULL, M( 21, 59 ) ) );
+
+    /*
+     * a vibrate only dnd keeps silent rules silent
+     */
+    notifyrules_rule_t vibe_dnd = dnd;
+    vibe_dnd.action = NOTIFYRULES_VIBE;
+    notifyrules_compile( &rules, config, sizeof( config ) / sizeof( notifyrules_rule_t ), &vibe_dnd );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_VIBE, notifyrules_match( &rules, "Unknown", NULL, M( 23, 30 ) ) );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_SILENT, notifyrules_match( &rules, "Gmail", NULL, M( 23, 30 ) ) );
+
+    notifyrules_compile( &rules, config, sizeof( config ) / sizeof( notifyrules_rule_t ), NULL );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_WAKE, notifyrules_match( &rules, "Unknown", NULL, M( 23, 30 ) ) );
+}
+
+void test_windows_and_hash( void ) {
+    TEST_ASSERT_TRUE( notifyrules_in_window( 0, 0, 0 ) );
+    TEST_ASSERT_TRUE( notifyrules_in_window( 100, 100, 1439 ) );
+    TEST_ASSERT_TRUE( notifyrules_in_window( 100, 200, 100 ) );
+    TEST_ASSERT_FALSE( notifyrules_in_window( 100, 200, 200 ) );
+    TEST_ASSERT_TRUE( notifyrules_in_window( 1380, 60, 0 ) );
+    TEST_ASSERT_TRUE( notifyrules_in_window( 1380, 60, 1380 ) );
+    TEST_ASSERT_FALSE( notifyrules_in_window( 1380, 60, 60 ) );
+    TEST_ASSERT_FALSE( notifyrules_in_window( 1380, 60, 1379 ) );
+
+    TEST_ASSERT_EQUAL( 0, notifyrules_hash( NULL ) );
+    TEST_ASSERT_EQUAL( 0, notifyrules_hash( "" ) );
+    TEST_ASSERT_EQUAL( notifyrules_hash( "telegram" ), notifyrules_hash( "TeleGram" ) );
+    TEST_ASSERT_NOT_EQUAL( notifyrules_hash( "telegram" ), notifyrules_hash( "telegra" ) );
+}
+
+/*
+ * rules in the same bucket stay apart and keep the config order, more than
+ * NOTIFYRULES_MAX are ignored
+ */
+void test_many_rules( void ) {
+    notifyrules_rule_t many[ NOTIFYRULES_MAX + 4 ];
+
+    memset( many, 0, sizeof( many ) );
+    for ( int i = 0 ; i < NOTIFYRULES_MAX + 4 ; i++ ) {
+        snprintf( many[ i ].src, sizeof( many[ i ].src ), "app%d", i % ( NOTIFYRULES_MAX + 2 ) );
+        many[ i ].action = i % 3;
+    }
+    many[ 5 ].from = M( 8, 0 );
+    many[ 5 ].to = M( 9, 0 );
+    notifyrules_compile( &rules, many, NOTIFYRULES_MAX + 4, NULL );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_MAX, rules.count );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_MAX, rules.start[ NOTIFYRULES_BUCKETS + 1 ] );
+
+    for ( int i = 0 ; i < NOTIFYRULES_MAX ; i++ ) {
+        char src[ 16 ];
+        snprintf( src, sizeof( src ), "APP%d", i );
+        TEST_ASSERT_EQUAL( i == 5 ? NOTIFYRULES_WAKE : i % 3, notifyrules_match( &rules, src, "x", M( 12, 0 ) ) );
+    }
+    TEST_ASSERT_EQUAL( 5 % 3, notifyrules_match( &rules, "app5", "x", M( 8, 30 ) ) );
+    /*
+     * app32, app33 and a second app0 rule with vibe come after NOTIFYRULES_MAX and are cut
+     */
+    TEST_ASSERT_EQUAL( NOTIFYRULES_WAKE, notifyrules_match( &rules, "app32", "x", M( 12, 0 ) ) );
+    TEST_ASSERT_EQUAL( NOTIFYRULES_WAKE, notifyrules_match( &rules, "app0", "x", M( 12, 0 ) ) );
+}
+
+/*
+ * 150 notifications a day from the usual apps, the watch is in standby for 16 of
+ * 24 hours. before each one in standby woke the watch
+ */
+void test_avoided_wakeups_per_day( void ) {
+    static const char *apps[][ 2 ] = {
+        { "Whatsapp", "Bob" }, { "Whatsapp", "Alice" }, { "Gmail", "Newsletter" }, { "Gmail", "Boss" },
+        { "Telegram", "Mom" }, { "Telegram", "Group" }, { "K-9 Mail", "Boss" }, { "Twitter", "" },
+        { "Calendar", "" }, { "Amazon", "" },
+    };
+    uint32_t random_state = 11;
+    auto random = [&]() {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        return( random_state );
+    };
+    int count[ 3 ] = { 0 }, before = 0, wakeups = 0, mom = 0;
+    char msg[ 160 ];
+
+    for ( int i = 0 ; i < 150 ; i++ ) {
+        auto &app = apps[ random() % 10 ];
+        uint16_t minute = random() % NOTIFYRULES_DAY;
+        bool standby = random() % 3 != 0;
+        uint8_t action = notifyrules_match( &rules, app[ 0 ], app[ 1 ], minute );
+
+        count[ action ]++;
+        if ( standby ) {
+            before++;
+            wakeups += action == NOTIFYRULES_WAKE;
+        }
+        if ( !strcmp( app[ 1 ], "Mom" ) ) {
+            TEST_ASSERT_EQUAL( NOTIFYRULES_WAKE, action );
+            mom++;
+        }
+    }
+    TEST_ASSERT_GREATER_THAN( 0, mom );
+    TEST_ASSERT_LESS_THAN( before / 2, wakeups );
+
+    snprintf( msg, sizeof( msg ), "150 notifications: %d wake, %d vibe, %d silent; wakeups from standby %d before, %d now, %d avoided",
+              count[ NOTIFYRULES_WAKE ], count[ NOTIFYRULES_VIBE ], count[ NOTIFYRULES_SILENT ], before, wakeups, before - wakeups );
+    TEST_MESSAGE( msg );
+}
+
+void test_lookup_time( void ) {
+    notifyrules_rule_t many[ NOTIFYRULES_MAX ];
+    volatile int sum = 0;
+    char msg[ 128 ];
+    int lookups = 0;
+    double seconds;
+
+    memset( many, 0, sizeof( many ) );
+    for ( int i = 0 ; i < NOTIFYRULES_MAX ; i++ ) {
+        snprintf( many[ i ].src, sizeof( many[ i ].src ), "app%d", i );
+        many[ i ].action = i % 3;
+    }
+    notifyrules_compile( &rules, many, NOTIFYRULES_MAX, &dnd );
+    auto start = std::chrono::steady_clock::now();
+    do {
+        for ( int i = 0 ; i < 1000 ; i++ ) {
+            sum += notifyrules_match( &rules, "app17", "someone", i % NOTIFYRULES_DAY );
+        }
+        lookups += 1000;
+        seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    } while( seconds < 0.2 );
+    snprintf( msg, sizeof( msg ), "%d rules: %.0f ns per lookup on the host, compiled %d bytes", NOTIFYRULES_MAX, seconds * 1e9 / lookups, (int)sizeof( notifyrules_t ) );
+    TEST_MESSAGE( msg );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_most_specific_rule_wins );
+    RUN_TEST( test_do_not_disturb );
+    RUN_TEST( test_windows_and_hash );
+    RUN_TEST( test_many_rules );
+    RUN_TEST( test_avoided_wakeups_per_day );
+    RUN_TEST( test_lookup_time );
+    return( UNITY_END() );
+}
@@ -0,0 +1,402 @@
+/****************************************************************************
+ *   Sep 26 17:33:48 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+#include "mbedtls/sha256.h"
+
+#include "hardware/otadelta.cpp"
+
+#include <unity.h>
+#include <unordered_map>
+
+/*
+ * old/new image pairs are generated like a firmware: code words and every 12th word
+ * a pointer into flash. a new version inserts some functions, which moves the code
+ * and every pointer behind them, and changes some code. the patch is made with the
+ * same steps as tools/mkdelta.py
+ */
+#define TEST_IMAGE_SIZE         ( 256 * 1024 )
+#define TEST_FLASH_BASE         0x400d0000
+
+typedef std::vector< uint8_t > image_t;
+
+static image_t old_image;
+static image_t new_image;
+static image_t written;
+static size_t read_errors;
+
+static uint32_t test_random_state;
+
+static uint32_t test_random( void ) {
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+    return( test_random_state );
+}
+
+static image_t build( const std::vector< std::pair< bool, uint32_t > > &words ) {
+    image_t image;
+
+    for ( auto &word : words ) {
+        uint32_t value = word.first ? TEST_FLASH_BASE + word.second : word.second;
+        for ( int i = 0 ; i < 4 ; i++ ) {
+            image.push_back( value >> ( i * 8 ) );
+        }
+    }
+    return( image );
+}
+
+static void generate( uint32_t seed ) {
+    std::vector< std::pair< bool, uint32_t > > words;
+
+    test_random_state = seed;
+    for ( size_t k = 0 ; k < TEST_IMAGE_SIZE / 4 ; k++ ) {
+        words.push_back( k % 12 == 0 ? std::make_pair( true, test_random() % TEST_IMAGE_SIZE ) : std::make_pair( false, test_random() ) );
+    }
+    old_image = build( words );
+
+    for ( int insert = 1 + test_random() % 5 ; insert > 0 ; insert-- ) {
+        size_t at = test_random() % words.size();
+        size_t n = 4 + test_random() % 400;
+        std::vector< std::pair< bool, uint32_t > > code;
+        for ( size_t i = 0 ; i < n ; i++ ) {
+            code.push_back( std::make_pair( false, test_random() ) );
+        }
+        words.insert( words.begin() + at, code.begin(), code.end() );
+        for ( auto &word : words ) {
+            if ( word.first && word.second >= at * 4 ) {
+                word.second += 4 * n;
+            }
+        }
+    }
+    for ( int change = 5 + test_random() % 35 ; change > 0 ; change-- ) {
+        size_t at = test_random() % ( words.size() - 50 );
+        for ( size_t k = at ; k < at + 1 + test_random() % 49 ; k++ ) {
+            words[ k ] = std::make_pair( false, test_random() );
+        }
+    }
+    new_image = build( words );
+    for ( size_t tail = test_random() % 3000 ; tail > 0 ; tail-- ) {
+        new_image.push_back( test_random() );
+    }
+}
+
+static void put_varint( image_t &out, uint32_t value ) {
+    while( value >= 0x80 ) {
+        out.push_back( ( value & 0x7f ) | 0x80 );
+        value >>= 7;
+    }
+    out.push_back( value );
+}
+
+static void put_le32( image_t &out, uint32_t value ) {
+    for ( int i = 0 ; i < 4 ; i++ ) {
+        out.push_back( value >> ( i * 8 ) );
+    }
+}
+
+static void put_sha256( image_t &out, const image_t &image ) {
+    mbedtls_sha256_context ctx;
+    uint8_t sha256[ 32 ];
+
+    mbedtls_sha256_init( &ctx );
+    mbedtls_sha256_starts_ret( &ctx, 0 );
+    mbedtls_sha256_update_ret( &ctx, image.data(), image.size() );
+    mbedtls_sha256_finish_ret( &ctx, sha256 );
+    out.insert( out.end(), sha256, sha256 + 32 );
+}
+
+/*
+ * runs of ( zeros, count, count bytes ), short zero runs stay in the bytes
+ */
+static void put_sparse_diff( image_t &out, const image_t &diff ) {
+    size_t pos = 0;
+
+    while( pos < diff.size() ) {
+        size_t zeros = 0;
+        while( pos + zeros < diff.size() && diff[ pos + zeros ] == 0 ) {
+            zeros++;
+        }
+        size_t start = pos + zeros;
+        size_t end = start;
+        while( end < diff.size() ) {
+            if ( diff[ end ] != 0 ) {
+                end++;
+                continue;
+            }
+            size_t run = 0;
+            while( end + run < diff.size() && diff[ end + run ] == 0 ) {
+                run++;
+            }
+            if ( run >= 3 || end + run == diff.size() ) {
+                break;
+            }
+            end += run;
+        }
+        put_varint( out, zeros );
+        put_varint( out, end - start );
+        out.insert( out.end(), diff.begin() + start, diff.begin() + end );
+        pos = end;
+    }
+}
+
+static image_t make_delta( const image_t &old, const image_t &update, int *adds ) {
+    const size_t block_size = 16;
+    std::unordered_map< std::string, size_t > index;
+    image_t patch;
+    size_t old_pos = 0, literal = 0, pos = 0;
+
+    *adds = 0;
+    for ( long p = old.size() - block_size ; p >= 0 ; p -= 4 ) {
+        index[ std::string( (const char *)&old[ p ], block_size ) ] = p;
+    }
+
+    patch.insert( patch.end(), OTADELTA_MAGIC, OTADELTA_MAGIC + 4 );
+    patch.push_back( OTADELTA_VERSION );
+    patch.resize( 8, 0 );
+    put_le32( patch, old.size() );
+    put_le32( patch, update.size() );
+    put_sha256( patch, old );
+    put_sha256( patch, update );
+
+    while( pos + block_size <= update.size() ) {
+        size_t match = old_pos + pos - literal;
+        if ( match + block_size > old.size() || memcmp( &old[ match ], &update[ pos ], block_size ) ) {
+            auto found = index.find( std::string( (const char *)&update[ pos ], block_size ) );
+            if ( found == index.end() ) {
+                pos++;
+                continue;
+            }
+            match = found->second;
+        }
+
+        size_t start = pos, old_start = match;
+        while( start > literal && old_start > 0 && update[ start - 1 ] == old[ old_start - 1 ] ) {
+            start--;
+            old_start--;
+        }
+        size_t end = pos + block_size, old_end = match + block_size;
+        while( end < update.size() && old_end < old.size() && update[ end ] == old[ old_end ] ) {
+            end++;
+            old_end++;
+        }
+        long score = 0, best = 0;
+        size_t best_len = 0, len = 0;
+        while( end + len < update.size() && old_end + len < old.size() && len - best_len < 32 ) {
+            score += update[ end + len ] == old[ old_end + len ] ? 1 : -1;
+            len++;
+            if ( score > best ) {
+                best = score;
+                best_len = len;
+            }
+        }
+        end += best_len;
+
+        if ( start > literal ) {
+            patch.push_back( OTADELTA_OP_INSERT );
+            put_varint( patch, start - literal );
+            patch.insert( patch.end(), update.begin() + literal, update.begin() + start );
+        }
+
+        image_t diff( end - start );
+        bool any = false;
+        for ( size_t i = 0 ; i < diff.size() ; i++ ) {
+            diff[ i ] = update[ start + i ] - old[ old_start + i ];
+            any |= diff[ i ] != 0;
+        }
+        long offset = (long)old_start - (long)old_pos;
+        patch.push_back( any ? OTADELTA_OP_ADD : OTADELTA_OP_COPY );
+        put_varint( patch, offset >= 0 ? offset << 1 : ( -offset << 1 ) - 1 );
+        put_varint( patch, end - start );
+        if ( any ) {
+            put_sparse_diff( patch, diff );
+            ( *adds )++;
+        }
+
+        old_pos = old_start + end - start;
+        literal = end;
+        pos = end;
+    }
+    if ( literal < update.size() ) {
+        patch.push_back( OTADELTA_OP_INSERT );
+        put_varint( patch, update.size() - literal );
+        patch.insert( patch.end(), update.begin() + literal, update.end() );
+    }
+    patch.push_back( OTADELTA_OP_END );
+    return( patch );
+}
+
+static bool read_old( size_t offset, uint8_t *data, size_t len ) {
+    if ( offset + len > old_image.size() ) {
+        read_errors++;
+        return( false );
+    }
+    memcpy( data, &old_image[ offset ], len );
+    return( true );
+}
+
+static bool write_new( const uint8_t *data, size_t len ) {
+    written.insert( written.end(), data, data + len );
+    return( true );
+}
+
+static bool check_header( otadelta_t *delta ) {
+    return( delta->old_size == old_image.size() );
+}
+
+static bool apply_patch( const image_t &patch, size_t chunk, const char **error = NULL ) {
+    otadelta_t *delta = new otadelta_t;
+    bool ok = true;
+
+    written.clear();
+    otadelta_init( delta, read_old, write_new, check_header );
+    for ( size_t pos = 0 ; pos < patch.size() && ok ; pos += chunk ) {
+        ok = otadelta_feed( delta, &patch[ pos ], std::min( chunk, patch.size() - pos ) );
+    }
+    ok = ok && otadelta_finish( delta );
+    if ( error ) {
+        *error = delta->error;
+    }
+    delete delta;
+    return( ok );
+}
+
+void setUp( void ) {
+    read_errors = 0;
+}
+
+void tearDown( void ) {
+}
+
+void test_generated_pairs_in_any_chunk_size( void ) {
+    static const size_t chunks[] = { 1, 2, 3, 7, 64, 1436, 8192, 1 << 30 };
+    char msg[ 128 ];
+    int adds;
+
+    for ( uint32_t seed = 1 ; seed <= 3 ; seed++ ) {
+        generate( seed );
+        image_t patch = make_delta( old_image, new_image, &adds );
+        TEST_ASSERT_GREATER_THAN( 0, adds );
+        TEST_ASSERT_LESS_THAN( new_image.size() / 4, patch.size() );
+        for ( auto chunk : chunks ) {
+            TEST_ASSERT_TRUE( apply_patch( patch, chunk ) );
+            TEST_ASSERT_TRUE( written == new_image );
+        }
+        snprintf( msg, sizeof( msg ), "seed %d: %d -> %d bytes, patch %d bytes (%.1f%%), %d add ops",
+                  seed, (int)old_image.size(), (int)new_image.size(), (int)patch.size(), patch.size() * 100.0 / new_image.size(), adds );
+        TEST_MESSAGE( msg );
+    }
+    TEST_ASSERT_EQUAL( 0, read_errors );
+}
+
+void test_unchanged_image_is_one_copy( void ) {
+    int adds;
+
+    generate( 4 );
+    image_t patch = make_delta( old_image, old_image, &adds );
+    TEST_ASSERT_EQUAL( OTADELTA_HEADER_SIZE + 1 + 1 + 3 + 1, patch.size() );
+    TEST_ASSERT_EQUAL( OTADELTA_OP_COPY, patch[ OTADELTA_HEADER_SIZE ] );
+    TEST_ASSERT_TRUE( apply_patch( patch, 1436 ) );
+    TEST_ASSERT_TRUE( written == old_image );
+}
+
+void test_patch_for_an_other_image_is_rejected( void ) {
+    const char *error;
+    int adds;
+
+    generate( 5 );
+    image_t patch = make_delta( old_image, new_image, &adds );
+    old_image.push_back( 0 );
+    TEST_ASSERT_FALSE( apply_patch( patch, 1436, &error ) );
+    TEST_ASSERT_EQUAL_STRING( "patch does not fit the running image", error );
+    TEST_ASSERT_EQUAL( 0, written.size() );
+
+    TEST_ASSERT_TRUE( otadelta_is_delta( patch.data(), patch.size() ) );
+    TEST_ASSERT_FALSE( otadelta_is_delta( old_image.data(), old_image.size() ) );
+    TEST_ASSERT_FALSE( otadelta_is_delta( patch.data(), 3 ) );
+}
+
+/*
+ * a broken patch fails or writes exactly new_size bytes, it never reads beyond the old
+ * image or writes beyond the new one. the sha256 check of the caller catches the rest
+ */
+void test_broken_patches_stay_in_bounds( void ) {
+    size_t rejected = 0, truncated = 0;
+    char msg[ 128 ];
+    int adds;
+
+    generate( 6 );
+    image_t patch = make_delta( old_image, new_image, &adds );
+    test_random_state = 99;
+    for ( int i = 0 ; i < 300 ; i++ ) {
+        image_t broken = patch;
+        broken[ OTADELTA_HEADER_SIZE + test_random() % ( broken.size() - OTADELTA_HEADER_SIZE ) ] ^= 1 + test_random() % 255;
+        if ( !apply_patch( broken, 1436 ) ) {
+            rejected++;
+        }
+        else {
+            TEST_ASSERT_EQUAL( new_image.size(), written.size() );
+        }
+        TEST_ASSERT_LESS_OR_EQUAL( new_image.size(), written.size() );
+    }
+    for ( int i = 0 ; i < 50 ; i++ ) {
+        image_t broken( patch.begin(), patch.begin() + test_random() % patch.size() );
+        if ( !apply_patch( broken, 1436 ) ) {
+            truncated++;
+        }
+    }
+    image_t trailing = patch;
+    trailing.push_back( 0 );
+
+    TEST_ASSERT_FALSE( apply_patch( trailing, 1436 ) );
+    TEST_ASSERT_EQUAL( 50, truncated );
+    TEST_ASSERT_GREATER_THAN( 0, rejected );
+    TEST_ASSERT_EQUAL( 0, read_errors );
+    snprintf( msg, sizeof( msg ), "%d of 300 flipped bytes rejected, the rest hit literal or diff bytes", (int)rejected );
+    TEST_MESSAGE( msg );
+}
+
+void test_throughput( void ) {
+    char msg[ 128 ];
+    int adds, runs = 0;
+    double seconds;
+
+    generate( 7 );
+    image_t patch = make_delta( old_image, new_image, &adds );
+    auto start = std::chrono::steady_clock::now();
+    do {
+        TEST_ASSERT_TRUE( apply_patch( patch, 1436 ) );
+        runs++;
+        seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    } while( seconds < 0.2 );
+    snprintf( msg, sizeof( msg ), "%.1f MB/s of new image on the host, state %d bytes", runs * new_image.size() / seconds / 1e6, (int)sizeof( otadelta_t ) );
+    TEST_MESSAGE( msg );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_generated_pairs_in_any_chunk_size );
+    RUN_TEST( test_unchanged_image_is_one_copy );
+    RUN_TEST( test_patch_for_an_other_image_is_rejected );
+    RUN_TEST( test_broken_patches_stay_in_bounds );
+    RUN_TEST( test_throughput );
+    return( UNITY_END() );
+}
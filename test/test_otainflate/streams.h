@@ -0,0 +1,1028 @@
+/****************************************************************************
+ *   Sep 26 19:05:21 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef _STREAMS_H
+    #define _STREAMS_H
+
+    /*
+     * generated with python gzip.compress(), the data comes from test_sample() with the same kind, length and seed
+     */
+    struct test_stream_t {
+        const char *kind;
+        size_t len;
+        uint32_t seed;
+        int level;
+        size_t gz_len;
+        const uint8_t *gz;
+    };
+
+    static const uint8_t stream_0[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x01, 0x00, 0x00, 0xff, 0xff, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_1[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_2[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_3[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x01, 0x01, 0x00, 0xfe, 0xff, 0xf1,
+        0x07, 0x2d, 0xb8, 0x18, 0x01, 0x00, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_4[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0xfb, 0x08, 0x00, 0x07, 0x2d, 0xb8,
+        0x18, 0x01, 0x00, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_5[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xfb, 0x08, 0x00, 0x07, 0x2d, 0xb8,
+        0x18, 0x01, 0x00, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_6[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x01, 0x64, 0x00, 0x9b, 0xff, 0xf1,
+        0x55, 0xed, 0xcf, 0x5e, 0xad, 0xde, 0xe1, 0xf2, 0x2c, 0x76, 0xa9, 0xfc, 0xfb, 0xfc, 0xe2, 0x6e,
+        0x49, 0x3c, 0xc0, 0x88, 0x65, 0xd4, 0x12, 0x23, 0x11, 0xc7, 0xfd, 0xb0, 0xe6, 0x99, 0x1d, 0x71,
+        0xdf, 0x56, 0xc9, 0x07, 0x43, 0x45, 0xff, 0x94, 0xba, 0x57, 0x5e, 0xad, 0xde, 0xe1, 0xf2, 0x2c,
+        0x76, 0xa9, 0xfc, 0x11, 0x5c, 0x7f, 0xf9, 0x68, 0xab, 0x8d, 0x52, 0xc6, 0x38, 0xf6, 0x8a, 0x7c,
+        0x91, 0x05, 0x43, 0x11, 0x3a, 0xd7, 0x1f, 0x6d, 0xff, 0x5e, 0x43, 0x9b, 0xdf, 0x6d, 0x25, 0xbb,
+        0x5d, 0x51, 0x12, 0x66, 0x39, 0x05, 0x0d, 0x73, 0xda, 0x86, 0x07, 0x43, 0x45, 0xff, 0x94, 0xba,
+        0x57, 0x6b, 0xb8, 0x16, 0x34, 0x75, 0x63, 0x64, 0x00, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_7[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0xfb, 0x18, 0xfa, 0xf6, 0x7c, 0xdc,
+        0xda, 0x7b, 0x0f, 0x3f, 0xe9, 0x94, 0xad, 0xfc, 0xf3, 0xfb, 0xcf, 0xa3, 0x3c, 0x4f, 0x9b, 0x03,
+        0x1d, 0xa9, 0x57, 0x84, 0x94, 0x05, 0x8f, 0xff, 0xdd, 0xf0, 0x6c, 0xa6, 0x6c, 0xe1, 0xfd, 0xb0,
+        0x93, 0xec, 0xce, 0xae, 0xff, 0xa7, 0xec, 0x0a, 0x87, 0x2b, 0x13, 0x8c, 0xa9, 0xff, 0x99, 0xb1,
+        0xba, 0x37, 0xe8, 0x98, 0xc5, 0xb7, 0xae, 0x9a, 0x89, 0xac, 0xce, 0x82, 0x56, 0xd7, 0xe5, 0x73,
+        0xff, 0xc7, 0x39, 0xcf, 0xbe, 0x9f, 0xab, 0xba, 0x3b, 0x36, 0x50, 0x28, 0xcd, 0x92, 0x95, 0xb7,
+        0xf8, 0x56, 0x1b, 0x54, 0x5b, 0xf6, 0x0e, 0x00, 0x16, 0x34, 0x75, 0x63, 0x64, 0x00, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_8[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xfb, 0x18, 0xfa, 0xf6, 0x7c, 0xdc,
+        0xda, 0x7b, 0x0f, 0x3f, 0xe9, 0x94, 0xad, 0xfc, 0xf3, 0xfb, 0xcf, 0xa3, 0x3c, 0x4f, 0x9b, 0x03,
+        0x1d, 0xa9, 0x57, 0x84, 0x94, 0x05, 0x8f, 0xff, 0xdd, 0xf0, 0x6c, 0xa6, 0x6c, 0xe1, 0xfd, 0xb0,
+        0x93, 0xec, 0xce, 0xae, 0xff, 0xa7, 0xec, 0x0a, 0x87, 0x2b, 0x13, 0x8c, 0xa9, 0xff, 0x99, 0xb1,
+        0xba, 0x37, 0xe8, 0x98, 0xc5, 0xb7, 0xae, 0x9a, 0x89, 0xac, 0xce, 0x82, 0x56, 0xd7, 0xe5, 0x73,
+        0xff, 0xc7, 0x39, 0xcf, 0xbe, 0x9f, 0xab, 0xba, 0x3b, 0x36, 0x50, 0x28, 0xcd, 0x92, 0x95, 0xb7,
+        0xf8, 0x56, 0x1b, 0x54, 0x5b, 0xf6, 0x0e, 0x00, 0x16, 0x34, 0x75, 0x63, 0x64, 0x00, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_9[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x75, 0x5a, 0x09, 0x8c, 0x97, 0xd5,
+        0x11, 0x6f, 0x41, 0x8a, 0x8a, 0x54, 0x16, 0x2c, 0xed, 0x2a, 0x68, 0x2d, 0xe5, 0xb4, 0xca, 0x7d,
+        0x09, 0x82, 0x40, 0x48, 0x28, 0xd0, 0x94, 0x7b, 0x89, 0x15, 0xea, 0x81, 0x40, 0xb1, 0x72, 0x78,
+        0x21, 0x68, 0x44, 0x21, 0x82, 0x52, 0x30, 0x21, 0x1c, 0x4a, 0x21, 0x6d, 0xa1, 0xe0, 0x42, 0x59,
+        0x11, 0xac, 0x46, 0x14, 0x25, 0x10, 0x95, 0x43, 0x2d, 0xa4, 0x9c, 0x16, 0xa5, 0x1c, 0x02, 0x16,
+        0x09, 0x87, 0x5b, 0x8a, 0x5c, 0xb2, 0x9d, 0x79, 0x6f, 0x7e, 0x33, 0xf3, 0xde, 0xae, 0x89, 0xf0,
+        0xff, 0xbe, 0x77, 0xcc, 0xfc, 0xae, 0xf7, 0xfe, 0xb8, 0xf0, 0xf5, 0xc0, 0x13, 0xdb, 0x86, 0xbe,
+        0xfa, 0xef, 0x83, 0xa5, 0xbf, 0x78, 0x7c, 0xf9, 0xa5, 0x8b, 0x97, 0x0e, 0x8d, 0xfe, 0x65, 0xc7,
+        0xf5, 0xcf, 0x3f, 0xb0, 0xb3, 0x66, 0xbd, 0x82, 0x4d, 0xdf, 0xae, 0x3a, 0x3a, 0xbf, 0xee, 0xb8,
+        0xfd, 0x83, 0xb6, 0x54, 0xed, 0xd6, 0xbd, 0x6c, 0xce, 0x3b, 0x45, 0xba, 0xac, 0xe0, 0xee, 0x49,
+        0xe7, 0x47, 0xae, 0x98, 0xd9, 0x6f, 0x63, 0xbb, 0xb3, 0xd3, 0x9f, 0x9a, 0x55, 0xa5, 0x5b, 0xc1,
+        0xed, 0x7b, 0x6e, 0x7a, 0xa8, 0x6c, 0x68, 0xb7, 0x05, 0xfb, 0x1f, 0xaa, 0xbf, 0x76, 0x48, 0xdf,
+        0x9a, 0xc3, 0xdb, 0x57, 0xa9, 0xfe, 0xc8, 0xde, 0xa9, 0xb2, 0xed, 0xc1, 0x35, 0x57, 0x7f, 0x7b,
+        0x78, 0xd9, 0xe5, 0xee, 0x5f, 0x0f, 0x3c, 0x21, 0x23, 0xeb, 0x07, 0x9c, 0xd0, 0x12, 0x67, 0x1f,
+        0xd9, 0xba, 0xe3, 0xa5, 0xf7, 0xb8, 0x4b, 0xb7, 0x65, 0x77, 0xb5, 0xbc, 0xa6, 0xc6, 0x1f, 0x0e,
+        0x77, 0xea, 0xd4, 0x6a, 0x5c, 0x8f, 0xc1, 0x1b, 0xaf, 0xab, 0xd7, 0xa6, 0x10, 0x20, 0x50, 0xf2,
+        0xe8, 0x92, 0xc1, 0xf3, 0x7b, 0x17, 0xbe, 0x75, 0xfa, 0x5c, 0xb3, 0x7b, 0xdf, 0x5f, 0xab, 0x25,
+        0xdc, 0xc6, 0x25, 0x33, 0xca, 0x66, 0xb6, 0xdc, 0x6d, 0x2c, 0xc6, 0xf6, 0xff, 0x74, 0x61, 0xf7,
+        0x39, 0x45, 0xa8, 0x37, 0x41, 0xf7, 0xdc, 0xb7, 0xa5, 0xa2, 0x9a, 0xc4, 0xa3, 0xcb, 0x88, 0x93,
+        0xab, 0xef, 0xf8, 0xd7, 0x85, 0xc7, 0xaf, 0x9c, 0xdd, 0xe4, 0xfc, 0xe4, 0x9d, 0x8b, 0x5a, 0xbf,
+        0x74, 0xdf, 0xf8, 0x6a, 0xa3, 0xea, 0xdc, 0xf8, 0xfb, 0x91, 0x77, 0x94, 0x35, 0x9c, 0xf9, 0x41,
+        0xa7, 0xf1, 0x13, 0x0b, 0x3f, 0xda, 0xbc, 0x63, 0xec, 0x89, 0xbd, 0x1d, 0x6f, 0xd1, 0x5a, 0x59,
+        0x13, 0x21, 0x19, 0x78, 0xa9, 0x2a, 0x54, 0x39, 0xaa, 0x00, 0x28, 0x3a, 0x53, 0xd0, 0xb7, 0xc7,
+        0x9a, 0x55, 0x3b, 0x9e, 0xa9, 0x3b, 0xa7, 0xf9, 0x8d, 0x35, 0x3d, 0xbf, 0x33, 0xfb, 0x52, 0x28,
+        0x15, 0xe1, 0xbd, 0xfc, 0xd6, 0xc3, 0xdb, 0x1b, 0xfb, 0x4d, 0x95, 0x3b, 0xef, 0x7b, 0xf2, 0xf8,
+        0xb9, 0x3e, 0x4d, 0x46, 0xbc, 0x9b, 0xc2, 0x0e, 0x60, 0xd2, 0x7a, 0x61, 0xe8, 0xaf, 0xbd, 0x46,
+        0x56, 0x3d, 0xf4, 0x6e, 0x8f, 0x41, 0xd3, 0x9c, 0x86, 0x42, 0x47, 0xdd, 0x16, 0x3e, 0xf0, 0xfa,
+        0x8d, 0xfd, 0x0b, 0x6b, 0x8f, 0x5c, 0xd2, 0xb2, 0xde, 0x13, 0x2f, 0x0e, 0x20, 0x52, 0x33, 0xa6,
+        0xf8, 0xf6, 0x36, 0x85, 0xd5, 0xa0, 0xdb, 0xb5, 0x2a, 0x3a, 0x61, 0xa6, 0xd4, 0x5c, 0x62, 0x16,
+        0xf6, 0x26, 0x3a, 0x51, 0x22, 0xda, 0xc1, 0x7f, 0x54, 0x81, 0x06, 0xca, 0x52, 0xb0, 0x7d, 0xaa,
+        0x5e, 0xb0, 0x31, 0xb5, 0x9e, 0xe4, 0xdf, 0xad, 0xe0, 0xaf, 0x5f, 0x99, 0xf0, 0xdb, 0x8f, 0xc6,
+        0xec, 0xbc, 0x95, 0x43, 0xf6, 0xb2, 0x3c, 0xdf, 0xcf, 0x3d, 0xd5, 0x03, 0x29, 0x53, 0x3a, 0x46,
+        0x0b, 0x87, 0x1c, 0x39, 0x51, 0x74, 0x22, 0x15, 0x71, 0x19, 0x58, 0xf5, 0xae, 0x40, 0xef, 0x9b,
+        0x44, 0x49, 0x30, 0xc6, 0xe7, 0x71, 0xd0, 0x99, 0x73, 0x5a, 0xcb, 0x0a, 0xac, 0xa2, 0xd3, 0xdf,
+        0xdc, 0x79, 0xf3, 0x9b, 0x6f, 0x95, 0x6e, 0x99, 0xfb, 0xf7, 0x46, 0x3b, 0x6a, 0x15, 0x0f, 0x6e,
+        0x88, 0xa5, 0xd3, 0xe9, 0xf4, 0x04, 0x4c, 0xe1, 0xb7, 0xb4, 0xd9, 0xd2, 0x69, 0xc3, 0xbf, 0x32,
+        0xe5, 0x81, 0x68, 0x9c, 0x90, 0x32, 0x1d, 0xa8, 0x84, 0xea, 0x24, 0x93, 0x28, 0xef, 0x4d, 0x7c,
+        0x8d, 0xd5, 0xf3, 0x03, 0x4d, 0x53, 0xce, 0xbe, 0x8c, 0xe2, 0x2f, 0x4d, 0x21, 0x69, 0x1f, 0x91,
+        0xe0, 0x8a, 0x33, 0x5c, 0x94, 0x35, 0x6f, 0xfb, 0xf3, 0x8c, 0x22, 0x0f, 0xd2, 0x31, 0x73, 0x5a,
+        0x67, 0x0b, 0x5a, 0x51, 0xcc, 0x1a, 0x0d, 0xe7, 0xfd, 0x17, 0xb5, 0xec, 0xf1, 0x83, 0x1a, 0xcf,
+        0x47, 0xcf, 0x32, 0xff, 0x12, 0x69, 0x84, 0x84, 0x20, 0x39, 0x2f, 0xf8, 0xe3, 0x15, 0xb4, 0xdb,
+        0x6b, 0x82, 0x84, 0x23, 0x30, 0xea, 0x2f, 0xcd, 0x3d, 0x59, 0x82, 0xe2, 0xb7, 0x88, 0x2f, 0xdc,
+        0x5d, 0x3a, 0x64, 0xe8, 0xd0, 0x30, 0xa6, 0x76, 0x4a, 0x05, 0x07, 0x6d, 0x74, 0xd7, 0x2f, 0x56,
+        0x1d, 0x78, 0xff, 0x9d, 0x7b, 0xfb, 0x4c, 0xff, 0xfe, 0xf4, 0x5a, 0xfb, 0x4f, 0xc5, 0x1b, 0x04,
+        0x59, 0xc0, 0x76, 0x6e, 0xf0, 0x34, 0x11, 0x25, 0x71, 0xa7, 0x96, 0xf7, 0x52, 0x79, 0xa7, 0x2a,
+        0xff, 0x70, 0xe5, 0x48, 0x23, 0xe3, 0x51, 0xeb, 0xfa, 0x3c, 0xe1, 0x0d, 0x33, 0x30, 0x42, 0xcf,
+        0x89, 0xaf, 0x5b, 0x55, 0x60, 0x86, 0x36, 0x8d, 0x70, 0x09, 0xff, 0xda, 0xb7, 0x7f, 0x8f, 0x5e,
+        0x64, 0x23, 0xe0, 0x23, 0x74, 0x9a, 0x87, 0xbe, 0x69, 0x66, 0xa6, 0x80, 0x2f, 0x6d, 0xfd, 0xd3,
+        0x22, 0x3e, 0x88, 0xd8, 0xd1, 0xb8, 0x4d, 0x06, 0x09, 0x25, 0xb1, 0x23, 0x0a, 0xfb, 0xe8, 0x62,
+        0x63, 0xda, 0x50, 0x9a, 0xb7, 0x0f, 0x7e, 0x46, 0x3d, 0x2f, 0xfc, 0xcc, 0x71, 0x50, 0xd6, 0x99,
+        0x57, 0x8b, 0xc3, 0x86, 0xdd, 0xd9, 0xe8, 0x12, 0x05, 0xcd, 0x4c, 0x09, 0xa0, 0xe9, 0x0f, 0x0c,
+        0xaa, 0x05, 0xce, 0x0b, 0x3e, 0x8b, 0x44, 0x94, 0x60, 0x7b, 0x6a, 0x4e, 0x7d, 0x10, 0x51, 0x45,
+        0x8f, 0x48, 0x7d, 0xa6, 0xcf, 0xa9, 0x4f, 0x25, 0xe2, 0x49, 0x94, 0xa5, 0x10, 0x0a, 0x47, 0x5e,
+        0x97, 0x45, 0xfb, 0x78, 0xda, 0xe7, 0xd2, 0x3d, 0xa6, 0xcc, 0x6b, 0x88, 0x3d, 0x25, 0x49, 0x59,
+        0x45, 0x81, 0xd2, 0x4d, 0x5c, 0x36, 0x93, 0x81, 0xb6, 0xa4, 0x80, 0xfc, 0xa9, 0x00, 0x30, 0x41,
+        0x75, 0x87, 0x16, 0x8f, 0xee, 0x04, 0x5d, 0xfb, 0x75, 0xe1, 0x83, 0x78, 0x9c, 0xd9, 0xf9, 0x2c,
+        0xc2, 0x68, 0x9e, 0x1c, 0x36, 0x1e, 0x85, 0x9a, 0x69, 0x05, 0xd5, 0x36, 0xed, 0xae, 0x1e, 0x46,
+        0xf8, 0x1e, 0x8c, 0x6e, 0xf5, 0x83, 0xe9, 0x25, 0x18, 0x00, 0x4d, 0x46, 0xb3, 0xb4, 0xb2, 0xc8,
+        0x09, 0x5c, 0x7b, 0x97, 0xb3, 0xf2, 0xe7, 0xb5, 0x9f, 0xdc, 0x8c, 0xda, 0x24, 0x8b, 0xe7, 0x02,
+        0xb5, 0x73, 0xe1, 0x73, 0x11, 0x1a, 0x13, 0x5e, 0x3e, 0x7e, 0x35, 0x9a, 0x99, 0x1b, 0x0c, 0x89,
+        0x85, 0xd6, 0x52, 0x0f, 0xb8, 0x8c, 0xce, 0xca, 0xe4, 0x1f, 0x8d, 0xac, 0x69, 0x7d, 0xcf, 0x4e,
+        0x07, 0x63, 0x4b, 0x7d, 0xd5, 0x87, 0x0d, 0x19, 0x4c, 0x61, 0x11, 0x74, 0xb8, 0xfe, 0xc3, 0x12,
+        0x86, 0x22, 0xbc, 0xef, 0xcf, 0x56, 0x4a, 0x28, 0x43, 0x82, 0xc7, 0xa7, 0x29, 0xf1, 0x36, 0xd6,
+        0xe9, 0xfd, 0xfa, 0xe4, 0x6b, 0x63, 0x77, 0x75, 0x2c, 0x54, 0x7f, 0x0f, 0xc0, 0xf1, 0xa9, 0xd3,
+        0x94, 0x28, 0x55, 0x35, 0x6b, 0x0a, 0xf1, 0x63, 0xc1, 0x56, 0xdb, 0x42, 0x25, 0x09, 0x57, 0x1c,
+        0x73, 0x52, 0xb1, 0x86, 0x15, 0x04, 0x56, 0xb9, 0x9b, 0xe2, 0xf8, 0x56, 0x23, 0x47, 0x1a, 0x05,
+        0x42, 0x38, 0x0f, 0x4c, 0x12, 0xf8, 0x8a, 0x9b, 0xf0, 0x5b, 0xe8, 0xa8, 0x25, 0xc2, 0x1b, 0x1c,
+        0xa4, 0xd3, 0x17, 0x63, 0x8d, 0xdd, 0x7d, 0x05, 0x99, 0xd7, 0x23, 0x55, 0x6a, 0x82, 0x12, 0x6d,
+        0x14, 0xe1, 0x5f, 0xe8, 0x6f, 0xa8, 0xba, 0x84, 0xea, 0x68, 0xcf, 0x56, 0xe8, 0x6a, 0x0c, 0x92,
+        0x54, 0x78, 0xf4, 0xb6, 0x67, 0xaa, 0x09, 0x8c, 0x62, 0xf9, 0x4c, 0x21, 0xe0, 0xba, 0x69, 0xfe,
+        0x86, 0xb2, 0x02, 0x7e, 0xaa, 0xce, 0x5d, 0xb1, 0xc2, 0x49, 0xcb, 0x4a, 0x44, 0xae, 0x35, 0x75,
+        0x97, 0x3e, 0x48, 0x60, 0x48, 0x0e, 0xba, 0x14, 0x01, 0x2f, 0xae, 0xd6, 0x48, 0xeb, 0xe2, 0x2c,
+        0x1a, 0x4b, 0xbd, 0x56, 0x9a, 0x88, 0x3d, 0xc1, 0x94, 0x20, 0x07, 0x1b, 0x9a, 0x12, 0x60, 0x2c,
+        0x62, 0x60, 0x76, 0xe3, 0x69, 0x37, 0x22, 0x92, 0xee, 0x81, 0x65, 0xbe, 0x5b, 0x44, 0xf2, 0xce,
+        0xfc, 0x88, 0x34, 0x3b, 0x66, 0x0a, 0x45, 0x81, 0xeb, 0x03, 0xd4, 0x0a, 0xf0, 0xd4, 0xa1, 0x58,
+        0x6d, 0xe2, 0x8f, 0x59, 0xc0, 0x30, 0x13, 0x07, 0x74, 0x3e, 0xbd, 0x5b, 0x90, 0x6b, 0xa8, 0xe5,
+        0xcd, 0xac, 0x5c, 0xa1, 0x6d, 0xca, 0x2d, 0xf3, 0xda, 0xef, 0xe4, 0x1b, 0x66, 0x0d, 0xcb, 0xf3,
+        0x20, 0x79, 0x81, 0x16, 0xa4, 0x05, 0x0c, 0xb5, 0x2f, 0xac, 0x24, 0x69, 0x5a, 0xba, 0xbc, 0xd6,
+        0x28, 0x02, 0xce, 0x2a, 0x0b, 0x06, 0x52, 0x99, 0xc9, 0x7f, 0x95, 0x89, 0x71, 0xb8, 0x04, 0x85,
+        0x8e, 0x0b, 0xb5, 0x95, 0x16, 0x82, 0x33, 0x19, 0xad, 0x68, 0x0a, 0x13, 0x4a, 0x3b, 0x70, 0xd5,
+        0xf2, 0xa3, 0x44, 0x37, 0x5d, 0x16, 0xf2, 0xa3, 0x50, 0x8c, 0x77, 0xc3, 0xad, 0x4b, 0x21, 0x06,
+        0x1a, 0x07, 0x60, 0xe0, 0x19, 0xf6, 0xb1, 0x85, 0x19, 0x9c, 0xba, 0x30, 0x2a, 0x8b, 0x09, 0x8a,
+        0x11, 0x00, 0x6f, 0x84, 0x35, 0x54, 0x9e, 0x57, 0x41, 0xb1, 0x75, 0x68, 0x9c, 0x95, 0xe2, 0xae,
+        0xe8, 0x62, 0x77, 0x02, 0x80, 0x65, 0x8b, 0x8b, 0xfe, 0x1b, 0xe3, 0xb5, 0x20, 0xa0, 0xb7, 0xe5,
+        0x68, 0x22, 0x11, 0x3a, 0x58, 0x99, 0x80, 0xb1, 0xab, 0x18, 0xbf, 0xc0, 0x2f, 0xaa, 0x4b, 0x9a,
+        0x49, 0xff, 0x55, 0x00, 0x8c, 0xa1, 0x3c, 0x5e, 0x80, 0xce, 0xd8, 0xa1, 0xac, 0x01, 0xa0, 0x04,
+        0xa4, 0x4e, 0xd8, 0xe5, 0x70, 0xfa, 0xa8, 0x99, 0x9a, 0x76, 0x46, 0xe1, 0x8b, 0x2e, 0x2f, 0x6d,
+        0x4f, 0x5a, 0x1b, 0x15, 0xf1, 0x98, 0x60, 0x84, 0x2a, 0x5f, 0xa6, 0xbd, 0x4e, 0xfa, 0xe3, 0x9d,
+        0xdd, 0x0d, 0xe8, 0xc1, 0xe1, 0xe1, 0x5f, 0x2b, 0xd7, 0xfd, 0xe6, 0x13, 0xbf, 0x3c, 0xad, 0x84,
+        0x0b, 0x06, 0xbb, 0xa2, 0xda, 0xff, 0xec, 0x09, 0xc2, 0x59, 0x3c, 0x04, 0x16, 0x87, 0xf3, 0xed,
+        0x33, 0x71, 0xad, 0x43, 0x3f, 0x2a, 0x8e, 0xf8, 0x6e, 0x26, 0x18, 0x1b, 0xc2, 0xbf, 0xc6, 0xd2,
+        0x39, 0xb5, 0x3d, 0x24, 0x23, 0xfd, 0xb7, 0x7d, 0x57, 0xd0, 0xbf, 0xc1, 0x2e, 0x9f, 0x2d, 0xdb,
+        0x0a, 0x5f, 0xbc, 0xc1, 0xa3, 0xf4, 0x84, 0x01, 0x2a, 0x3e, 0x55, 0xc4, 0x2c, 0x4a, 0xa2, 0x93,
+        0x5e, 0x54, 0x94, 0x98, 0x91, 0x65, 0xe1, 0x1c, 0x5c, 0xb1, 0xb3, 0xab, 0x21, 0xca, 0x12, 0xde,
+        0x3e, 0x53, 0x40, 0xb7, 0x47, 0x8f, 0x53, 0x7f, 0xc3, 0xa1, 0x95, 0x1f, 0xd5, 0x00, 0x34, 0x3e,
+        0x53, 0xdd, 0xa9, 0xcb, 0x57, 0x0a, 0x14, 0x2e, 0x1f, 0x90, 0x34, 0xd3, 0xa4, 0x80, 0xe5, 0x82,
+        0xf4, 0xe6, 0x15, 0x0d, 0x88, 0x65, 0xda, 0x50, 0xaf, 0xcf, 0x60, 0x42, 0x0c, 0x13, 0x31, 0x5b,
+        0xa0, 0x3c, 0x52, 0xe7, 0x8b, 0xc5, 0xe1, 0x31, 0xbe, 0xe5, 0xb4, 0x2c, 0x62, 0xec, 0x83, 0xca,
+        0xdf, 0x4e, 0x4f, 0x59, 0xa6, 0x77, 0x0c, 0xc3, 0x67, 0xf1, 0x23, 0xaa, 0x85, 0x4b, 0x8d, 0x22,
+        0x70, 0x6d, 0xb6, 0x9a, 0x52, 0x10, 0x32, 0xc0, 0xb5, 0x79, 0x59, 0x09, 0xad, 0xc9, 0x96, 0xd4,
+        0x77, 0xa7, 0x06, 0xa8, 0x69, 0x1b, 0xae, 0xa6, 0x0a, 0x6e, 0xb3, 0xfa, 0x34, 0x5d, 0xc3, 0xed,
+        0x3a, 0x56, 0x05, 0xba, 0x98, 0x72, 0xa9, 0x83, 0x6e, 0x31, 0xe9, 0xde, 0xb4, 0xba, 0xad, 0x83,
+        0x8f, 0xe9, 0xfa, 0xa1, 0xd5, 0xbf, 0x4b, 0xd7, 0x41, 0x55, 0x7a, 0x03, 0x64, 0xb0, 0x4c, 0x05,
+        0x53, 0xbd, 0x30, 0x4d, 0x4c, 0xc5, 0x78, 0x04, 0x21, 0xaa, 0x15, 0xef, 0x24, 0x3a, 0xc2, 0xba,
+        0xe3, 0x33, 0xe6, 0xb8, 0xed, 0x6e, 0x7d, 0x67, 0xa1, 0xcc, 0x61, 0x1d, 0x4e, 0x21, 0x1e, 0x24,
+        0x11, 0x50, 0xf8, 0xb0, 0x3f, 0x60, 0xd1, 0x99, 0xb7, 0x31, 0x87, 0xcf, 0x9f, 0x40, 0xa3, 0x8e,
+        0x71, 0xc1, 0x90, 0x80, 0xa3, 0x52, 0x66, 0xc6, 0xeb, 0x71, 0x12, 0x9b, 0x3e, 0x8c, 0x90, 0xa9,
+        0x55, 0xda, 0xdc, 0xc7, 0x48, 0x23, 0x17, 0x0a, 0x1a, 0xee, 0x6a, 0xcf, 0x48, 0xe8, 0x5a, 0x28,
+        0x83, 0x2a, 0xb3, 0x48, 0x94, 0x58, 0x92, 0xef, 0xb0, 0xf3, 0x99, 0xc8, 0x34, 0x19, 0xdb, 0xeb,
+        0x11, 0x82, 0x3b, 0x56, 0x15, 0xc8, 0x3c, 0x63, 0xae, 0x15, 0xab, 0xea, 0x46, 0x42, 0x3c, 0x94,
+        0x87, 0xcd, 0x04, 0x7a, 0x9a, 0x77, 0x8a, 0x63, 0xc8, 0x62, 0x5b, 0x3d, 0xb1, 0x88, 0xd7, 0xd6,
+        0x50, 0x26, 0x19, 0x2e, 0x8a, 0x8c, 0x0b, 0x10, 0x15, 0x52, 0xd3, 0x1b, 0x23, 0xa5, 0x6c, 0x19,
+        0x9e, 0x77, 0xac, 0xc0, 0x93, 0xb5, 0xd9, 0xa7, 0xb5, 0xd3, 0x0b, 0x23, 0xc2, 0xb6, 0x75, 0x84,
+        0x5b, 0x54, 0x7b, 0x13, 0x4c, 0x5b, 0x77, 0x63, 0x70, 0x96, 0xd8, 0x0e, 0xb6, 0xda, 0xa1, 0x9a,
+        0xcc, 0xb4, 0x6e, 0x5d, 0xcf, 0x38, 0xb4, 0x15, 0x60, 0xb8, 0x65, 0x44, 0x25, 0xd8, 0x14, 0xb2,
+        0xab, 0xbe, 0x64, 0x21, 0xa0, 0x45, 0x5a, 0x63, 0x80, 0xb7, 0x7a, 0x7e, 0xb4, 0x27, 0x54, 0xa0,
+        0x45, 0xa8, 0x1f, 0xde, 0xfd, 0x3a, 0xb5, 0x61, 0x18, 0x43, 0xa7, 0x95, 0x03, 0x4a, 0x0c, 0xbf,
+        0x3d, 0x81, 0x61, 0xac, 0xda, 0xf8, 0x79, 0xef, 0xe9, 0xe7, 0x88, 0x2b, 0x29, 0xa2, 0x38, 0x15,
+        0x55, 0x47, 0x7d, 0xc2, 0x32, 0xdf, 0xfe, 0xa9, 0xa3, 0x40, 0xc6, 0x7e, 0x4f, 0xce, 0xdc, 0xbc,
+        0x2f, 0x3b, 0x95, 0x8e, 0x93, 0x41, 0x53, 0x06, 0xa6, 0x56, 0x26, 0x92, 0xb9, 0x60, 0xbb, 0xf6,
+        0xa4, 0xa7, 0x44, 0x8b, 0x48, 0xc7, 0xd8, 0xa9, 0xdc, 0x61, 0x62, 0x90, 0x2f, 0x5b, 0x39, 0x7b,
+        0x92, 0x24, 0x80, 0x4c, 0x80, 0xa2, 0xc4, 0xcb, 0x2d, 0xcb, 0x68, 0xe2, 0xe8, 0x18, 0x3a, 0x4d,
+        0x6d, 0xc4, 0xd1, 0x53, 0xdf, 0xa7, 0x74, 0x85, 0x8a, 0xdb, 0xe3, 0x14, 0x5e, 0x33, 0xca, 0x28,
+        0xc9, 0x51, 0x1b, 0x3b, 0xd1, 0xbb, 0xa5, 0x4c, 0xed, 0x27, 0x26, 0x5a, 0x1d, 0xf7, 0xa1, 0xae,
+        0x51, 0x3b, 0x99, 0x78, 0xa1, 0xae, 0x2b, 0x3f, 0x6f, 0x14, 0x5d, 0x82, 0x7d, 0x5b, 0xe0, 0x5c,
+        0x3c, 0x91, 0x73, 0x8f, 0x46, 0x19, 0xea, 0x20, 0x1b, 0x89, 0x9e, 0x0d, 0xcf, 0x0d, 0x3f, 0x4f,
+        0x45, 0x05, 0x45, 0x21, 0x56, 0xf9, 0x2e, 0xae, 0x39, 0x23, 0xf6, 0x3f, 0xdd, 0x08, 0xc7, 0xa8,
+        0x82, 0x2d, 0xe9, 0x21, 0x97, 0x05, 0x4a, 0x90, 0x0f, 0x45, 0x9a, 0x14, 0x28, 0x7b, 0x1b, 0x4f,
+        0x19, 0x6d, 0x7e, 0x4b, 0x4b, 0xf9, 0x98, 0xd3, 0xb9, 0x02, 0xfc, 0xc0, 0xb1, 0x7c, 0x59, 0x0d,
+        0x0b, 0xd6, 0xb1, 0x73, 0x9e, 0x9a, 0x42, 0x62, 0x62, 0xa1, 0x48, 0x0c, 0x40, 0x69, 0xc6, 0xf9,
+        0x4a, 0x14, 0xc8, 0xfe, 0xc8, 0xa0, 0xb2, 0x65, 0xe1, 0x83, 0x15, 0xd9, 0x30, 0x77, 0xf1, 0xed,
+        0xc9, 0x15, 0xad, 0xc0, 0x73, 0x29, 0x57, 0xbf, 0xb2, 0x4d, 0x3a, 0xc5, 0x3c, 0x88, 0x7e, 0x3a,
+        0xc8, 0xfc, 0x69, 0x70, 0x13, 0x67, 0xa1, 0x3a, 0x14, 0xcd, 0x10, 0x28, 0x61, 0xf1, 0x84, 0xd6,
+        0xcb, 0xd3, 0xf4, 0x19, 0x3d, 0xb1, 0x87, 0x0b, 0x04, 0x31, 0x84, 0x2d, 0xd8, 0xe0, 0xbe, 0x1a,
+        0xa6, 0xba, 0xc6, 0xeb, 0x9b, 0xd7, 0xdb, 0x31, 0xd3, 0x78, 0x63, 0x1b, 0x7d, 0x61, 0x48, 0x21,
+        0x86, 0x6d, 0xee, 0x66, 0x81, 0x6c, 0x69, 0x25, 0x3c, 0xf3, 0x2d, 0x53, 0x9d, 0x17, 0x0a, 0xdf,
+        0xaf, 0xd0, 0xc1, 0x34, 0x53, 0xd6, 0x28, 0x70, 0x71, 0x55, 0x52, 0xd9, 0x08, 0x1e, 0x90, 0x86,
+        0x83, 0x1d, 0xff, 0x2a, 0x31, 0xad, 0xe5, 0xdb, 0xb9, 0x42, 0x6b, 0x4e, 0x59, 0x93, 0xa2, 0x95,
+        0x53, 0xbe, 0x50, 0x5d, 0x52, 0x45, 0x74, 0x98, 0xd4, 0x26, 0xcb, 0x8d, 0xe7, 0x6c, 0xfb, 0xb3,
+        0x40, 0xe6, 0xd3, 0x60, 0xcd, 0x45, 0x38, 0x62, 0x8b, 0xb2, 0x69, 0x2a, 0x74, 0x0c, 0x91, 0xa4,
+        0x8a, 0x1b, 0xb8, 0x9f, 0x68, 0x9c, 0x7e, 0xb3, 0xc9, 0x15, 0xaa, 0x12, 0x39, 0xf0, 0x1c, 0x97,
+        0xeb, 0x39, 0x75, 0xf3, 0xae, 0xe9, 0x5c, 0xaa, 0x0b, 0x52, 0x6d, 0x78, 0xfa, 0x62, 0x2a, 0x45,
+        0x55, 0x65, 0x23, 0xc1, 0xc9, 0xa0, 0x29, 0x70, 0x7d, 0xc8, 0x16, 0x7c, 0x23, 0xa4, 0xe5, 0x7f,
+        0x28, 0xe2, 0x81, 0x13, 0x9c, 0xba, 0x27, 0x85, 0xe1, 0x50, 0x13, 0x5b, 0x76, 0x09, 0x8e, 0x0d,
+        0xa4, 0xf7, 0xcd, 0x8a, 0xe8, 0x58, 0x97, 0x58, 0x4d, 0x23, 0x18, 0xc4, 0x50, 0x6e, 0x21, 0x07,
+        0x35, 0x5d, 0x31, 0x9d, 0xf1, 0xd7, 0x0a, 0x4a, 0xb3, 0x3e, 0x8a, 0x07, 0x47, 0xe3, 0x3f, 0x3c,
+        0x9a, 0x05, 0x97, 0xcc, 0x38, 0x97, 0x71, 0xd4, 0x7d, 0x73, 0x7d, 0x72, 0x22, 0xb8, 0x23, 0x8c,
+        0xff, 0x07, 0x28, 0x88, 0x6e, 0xa9, 0xc8, 0xdc, 0x25, 0xca, 0x34, 0x7c, 0xd6, 0x3a, 0xcb, 0x0b,
+        0xdb, 0x81, 0x6f, 0xc3, 0x01, 0x16, 0xbd, 0x74, 0xef, 0xe7, 0x71, 0xe3, 0x76, 0xcf, 0xa9, 0xe0,
+        0xc2, 0xd5, 0xb1, 0x79, 0xfc, 0xfd, 0xb9, 0xb8, 0x24, 0x15, 0x79, 0xa8, 0xf5, 0x49, 0x0b, 0xd6,
+        0x1d, 0x6f, 0x33, 0x45, 0x6b, 0x55, 0xec, 0x74, 0xf7, 0xe0, 0x66, 0xe4, 0x44, 0x49, 0xac, 0xeb,
+        0x39, 0xb7, 0x06, 0x51, 0x27, 0x3b, 0xd3, 0x18, 0x96, 0xff, 0x7c, 0x7a, 0xe0, 0xa4, 0x4c, 0x56,
+        0xdc, 0x36, 0xfb, 0x1e, 0x93, 0x64, 0x37, 0xf1, 0x8c, 0x64, 0xac, 0x43, 0xec, 0x68, 0x00, 0x15,
+        0xde, 0x93, 0x7e, 0xb5, 0x06, 0x02, 0x45, 0x25, 0x6f, 0xb6, 0x2f, 0x65, 0xa3, 0xfe, 0xa5, 0xc3,
+        0xb6, 0xdc, 0x5d, 0x68, 0x1b, 0xbe, 0x65, 0x3e, 0x6c, 0x6a, 0x46, 0x20, 0x6a, 0x2d, 0xa7, 0xe4,
+        0x14, 0x2f, 0xb8, 0x5d, 0xeb, 0x86, 0x60, 0x5a, 0x39, 0x88, 0x84, 0x4f, 0x65, 0xc1, 0xbb, 0xce,
+        0xd7, 0xc3, 0x70, 0x5f, 0x27, 0xa2, 0x7b, 0xe4, 0x45, 0x29, 0xd0, 0x1e, 0x3c, 0x84, 0x0b, 0x82,
+        0xc3, 0x64, 0x77, 0x70, 0x44, 0xe5, 0xc5, 0x21, 0xe3, 0xe2, 0xa0, 0x2b, 0x89, 0xbd, 0x82, 0x1e,
+        0x29, 0xd5, 0x03, 0x13, 0x37, 0xcc, 0xa6, 0xe8, 0xeb, 0xd0, 0x0a, 0xea, 0x11, 0x68, 0xd5, 0xce,
+        0x74, 0xc8, 0xfe, 0xda, 0xd7, 0xa7, 0x83, 0x61, 0x1e, 0xe5, 0xcb, 0xeb, 0x78, 0xb6, 0xa7, 0x41,
+        0xa8, 0xc4, 0xd3, 0x1f, 0xa7, 0xcc, 0x36, 0xc0, 0xc1, 0x8f, 0x1d, 0xda, 0x18, 0x82, 0x70, 0xbc,
+        0xb3, 0x3a, 0xe7, 0xd2, 0xdd, 0x0a, 0x96, 0x7b, 0xe2, 0x24, 0x45, 0x2e, 0xfd, 0xd3, 0x95, 0xae,
+        0x3a, 0xeb, 0xb7, 0x21, 0xab, 0x2b, 0xba, 0x64, 0xa3, 0x85, 0xd3, 0x49, 0x10, 0x4e, 0x83, 0xe6,
+        0x8d, 0xb4, 0xe5, 0x56, 0xea, 0xbb, 0x3e, 0x40, 0x60, 0x7c, 0xc2, 0x62, 0xde, 0x6d, 0x27, 0xfb,
+        0xcb, 0xc0, 0x49, 0x51, 0xa7, 0xe7, 0x52, 0x6b, 0x51, 0x53, 0x70, 0xf9, 0x5b, 0x50, 0xd4, 0xfd,
+        0xf3, 0x99, 0x15, 0xbb, 0x83, 0x92, 0xc3, 0x21, 0x1b, 0x99, 0x84, 0x96, 0xbc, 0x34, 0x2a, 0x87,
+        0xdd, 0x92, 0x6a, 0x39, 0x1c, 0x1b, 0x0b, 0x19, 0x4c, 0x2b, 0xc6, 0xaf, 0x79, 0xcc, 0x08, 0x13,
+        0xbd, 0x6c, 0x04, 0x49, 0x29, 0x88, 0x95, 0xa5, 0x22, 0x4b, 0x58, 0x35, 0xea, 0xac, 0xa5, 0xe2,
+        0x6b, 0x40, 0xb7, 0x83, 0x50, 0x15, 0xd5, 0x7d, 0x15, 0x18, 0xa1, 0x45, 0xea, 0x48, 0x2c, 0x78,
+        0x24, 0xd5, 0xc0, 0xd9, 0x54, 0x3b, 0x68, 0xb5, 0x99, 0x59, 0xf9, 0x74, 0xaf, 0x49, 0xab, 0x9c,
+        0x7a, 0xd6, 0x4e, 0x5d, 0xd3, 0xb3, 0x19, 0x78, 0x1f, 0xcd, 0x08, 0x8f, 0xc9, 0x33, 0x78, 0x9f,
+        0x17, 0xd5, 0xfd, 0xd2, 0x4f, 0x87, 0x5c, 0xce, 0x2a, 0x34, 0xf5, 0xad, 0xc1, 0x43, 0xf4, 0x1c,
+        0x71, 0x4a, 0x8d, 0x1c, 0xa2, 0x4f, 0xc4, 0x9c, 0x6b, 0xb3, 0xd2, 0x29, 0x50, 0x5d, 0x31, 0xef,
+        0x70, 0x4a, 0x99, 0x97, 0x2b, 0x04, 0xc9, 0x9b, 0x25, 0x86, 0xe9, 0xc3, 0x03, 0xaa, 0x8d, 0x47,
+        0x1e, 0xa6, 0xb5, 0xa9, 0xdd, 0x9a, 0x52, 0xf8, 0xff, 0x81, 0xd8, 0x25, 0xe9, 0x16, 0xdc, 0x4e,
+        0x63, 0x19, 0x51, 0x0f, 0xe5, 0x7d, 0x14, 0xda, 0x50, 0x8b, 0x60, 0x28, 0x75, 0x5e, 0x6c, 0x3a,
+        0xc3, 0x57, 0x1b, 0x69, 0x27, 0x8d, 0xf8, 0x3b, 0x23, 0x0a, 0x8d, 0x0a, 0x85, 0x10, 0x2d, 0x25,
+        0xed, 0x30, 0x58, 0x15, 0xe9, 0x3e, 0x20, 0x15, 0x2e, 0x00, 0x70, 0xeb, 0xd1, 0x1d, 0x24, 0x65,
+        0x17, 0x4e, 0x01, 0x1a, 0xb3, 0xcb, 0x67, 0x26, 0x3e, 0xf6, 0x5d, 0x5f, 0xe4, 0xa8, 0x12, 0xaa,
+        0x47, 0x19, 0x89, 0x24, 0xcb, 0x9a, 0x76, 0x57, 0x4d, 0xef, 0xf2, 0x49, 0x38, 0x8f, 0xe6, 0x07,
+        0x78, 0x47, 0xdc, 0xde, 0x49, 0x1d, 0xae, 0xc4, 0xee, 0x3f, 0x4b, 0x5a, 0x30, 0x06, 0x5e, 0x90,
+        0x72, 0x8f, 0x02, 0x65, 0xc0, 0xd2, 0x25, 0xbd, 0x85, 0x54, 0xac, 0x2c, 0xe2, 0xfe, 0xef, 0x89,
+        0xd5, 0x9c, 0x15, 0x8f, 0x03, 0x30, 0x86, 0x66, 0xb1, 0x35, 0x4d, 0xb9, 0x7d, 0x71, 0xec, 0x48,
+        0xfc, 0x94, 0xcd, 0x58, 0xb5, 0xdc, 0x97, 0x83, 0x57, 0x59, 0x35, 0x4d, 0xa7, 0xe4, 0x48, 0xab,
+        0x40, 0x44, 0xe6, 0x1b, 0x84, 0xf4, 0x07, 0x0e, 0x46, 0x60, 0xd1, 0xc3, 0x18, 0xf0, 0x8b, 0x32,
+        0x15, 0x0c, 0x37, 0x97, 0xdc, 0x20, 0xc4, 0x3d, 0x44, 0x3b, 0x19, 0x8a, 0x2a, 0x8a, 0x34, 0xe9,
+        0x1e, 0x41, 0x27, 0x1f, 0xe8, 0x86, 0xf6, 0xc8, 0x47, 0xf0, 0xc4, 0x57, 0xe4, 0x01, 0x17, 0x2f,
+        0x75, 0x71, 0x6b, 0x2e, 0x76, 0x8b, 0xea, 0x69, 0x34, 0xa4, 0xd1, 0x0d, 0x06, 0xe9, 0xe9, 0x0b,
+        0x46, 0x20, 0xd3, 0xb0, 0xc1, 0x75, 0x9f, 0xf4, 0x2b, 0x03, 0x86, 0x43, 0x5e, 0x02, 0x0c, 0xb6,
+        0xb2, 0xbd, 0xc0, 0x9e, 0xf6, 0x53, 0xc2, 0x27, 0x58, 0x1c, 0x46, 0xc7, 0xff, 0xa2, 0xc7, 0x41,
+        0xa7, 0xb7, 0x3a, 0x03, 0x45, 0xb3, 0x34, 0x4f, 0x06, 0xd1, 0x9e, 0xb4, 0xdc, 0x3f, 0xf4, 0xe9,
+        0x96, 0xcc, 0x0e, 0x5b, 0x7c, 0x6f, 0x07, 0xee, 0xc9, 0x52, 0x65, 0x4b, 0x3c, 0x13, 0x9e, 0x96,
+        0x0b, 0x8c, 0xd1, 0x81, 0x58, 0x0a, 0x25, 0xe5, 0x74, 0xe7, 0xda, 0x12, 0x42, 0x0d, 0xbe, 0x82,
+        0x9d, 0x33, 0x4b, 0xa3, 0x0a, 0xcb, 0x84, 0x49, 0x4b, 0x51, 0xa0, 0xd5, 0xad, 0x62, 0x7d, 0xd2,
+        0x64, 0x73, 0x19, 0x82, 0x63, 0x24, 0x10, 0xef, 0x10, 0x55, 0xa0, 0xcb, 0x7c, 0x62, 0x9a, 0x4e,
+        0xd2, 0x5e, 0x72, 0x10, 0x81, 0x10, 0x9f, 0x82, 0xb4, 0x4e, 0x3c, 0x59, 0xd4, 0x25, 0x3e, 0x0c,
+        0xbb, 0x8a, 0xf7, 0x7b, 0x4d, 0x14, 0x4d, 0x4c, 0x29, 0xd1, 0xca, 0x63, 0x15, 0xbe, 0xe6, 0xea,
+        0x18, 0xca, 0x0e, 0x01, 0x1e, 0xd7, 0xd1, 0xbd, 0xc0, 0x8a, 0x4f, 0xea, 0xb7, 0xa9, 0x64, 0x17,
+        0xb0, 0xbc, 0xc8, 0xba, 0x83, 0x1b, 0x57, 0xe7, 0x77, 0x15, 0x0f, 0x57, 0x84, 0x89, 0xd8, 0x02,
+        0x43, 0xd8, 0x73, 0x43, 0x2a, 0xab, 0xad, 0xfc, 0x23, 0x1a, 0x66, 0x77, 0x2c, 0x37, 0xb0, 0x55,
+        0xf6, 0x14, 0xa8, 0xfc, 0x68, 0x6f, 0x59, 0xea, 0x31, 0x53, 0x91, 0xb3, 0xa2, 0x8c, 0x78, 0xac,
+        0x4f, 0x35, 0xfe, 0xbd, 0x5d, 0x54, 0x2e, 0x90, 0x4e, 0x71, 0xa8, 0xa3, 0xc0, 0x99, 0x4e, 0xc7,
+        0x7d, 0x99, 0x7d, 0x51, 0x65, 0xc0, 0xce, 0x26, 0xfd, 0xa9, 0x57, 0x7d, 0x02, 0xe6, 0xdb, 0x70,
+        0x4b, 0xfc, 0xea, 0x0c, 0x54, 0xfd, 0x5d, 0x25, 0xb4, 0xe5, 0x1c, 0x09, 0x7e, 0xaf, 0xb4, 0x44,
+        0x20, 0xeb, 0xd1, 0x5b, 0x51, 0x47, 0x7c, 0xca, 0x58, 0x1f, 0x6e, 0xfe, 0x73, 0x76, 0x84, 0xd0,
+        0x3b, 0xab, 0xd4, 0xe1, 0x95, 0x6c, 0x40, 0xaf, 0xdd, 0xf0, 0x53, 0x71, 0x41, 0x14, 0x74, 0x33,
+        0x07, 0xd8, 0x7e, 0x99, 0x59, 0x28, 0x00, 0xdb, 0xea, 0x3e, 0x85, 0x56, 0xde, 0x1f, 0x9d, 0x62,
+        0xb2, 0x6c, 0x8b, 0xd7, 0x8a, 0xdf, 0x4b, 0x99, 0x3a, 0x4f, 0xaa, 0x70, 0xd6, 0x34, 0xf9, 0x4a,
+        0xb2, 0x20, 0xf3, 0x0e, 0x7b, 0xdb, 0xad, 0x30, 0x6c, 0x8c, 0x0b, 0x33, 0xe2, 0x40, 0x82, 0x8e,
+        0x46, 0x2f, 0x85, 0xd1, 0xf9, 0xff, 0x45, 0x12, 0x66, 0x88, 0xe0, 0x2e, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_10[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x8d, 0x5a, 0x09, 0x90, 0x56, 0xc5,
+        0x11, 0x4e, 0x50, 0x82, 0x8a, 0x44, 0x0e, 0x43, 0xb2, 0x0a, 0x1a, 0x25, 0xc8, 0x15, 0xe5, 0x3e,
+        0x97, 0x43, 0xa0, 0xa8, 0x22, 0x64, 0x53, 0xe1, 0x58, 0x58, 0xca, 0xc8, 0x46, 0x10, 0x61, 0x83,
+        0x11, 0xc4, 0x6b, 0x05, 0x2c, 0x51, 0x28, 0xc1, 0x6c, 0xc0, 0x2a, 0x8a, 0x43, 0x11, 0x2a, 0x09,
+        0x04, 0x5c, 0x08, 0x2b, 0x82, 0xd1, 0x02, 0x41, 0x29, 0xb6, 0x54, 0x04, 0x35, 0x50, 0x61, 0x39,
+        0x0c, 0x4a, 0x38, 0x04, 0x0c, 0x6e, 0x71, 0xb8, 0x21, 0xc8, 0x72, 0x6d, 0xa6, 0x67, 0xa6, 0x7b,
+        0xba, 0x7b, 0xe6, 0xa5, 0x52, 0x05, 0xfb, 0xff, 0xff, 0x7b, 0x33, 0xdd, 0x5f, 0x7f, 0xdd, 0x73,
+        0x74, 0xcf, 0x7c, 0x33, 0xfc, 0xd4, 0xae, 0xc2, 0xd7, 0xff, 0x79, 0xa4, 0xea, 0xa7, 0x4f, 0xad,
+        0xbe, 0x7c, 0xe9, 0xf2, 0xd1, 0x89, 0x3f, 0xeb, 0xb9, 0xf5, 0xc5, 0x87, 0xf6, 0x34, 0x6c, 0xd6,
+        0xe0, 0xa3, 0x2b, 0xeb, 0x4e, 0x2c, 0x6e, 0x3a, 0xf9, 0xd0, 0x88, 0x1d, 0x75, 0xfa, 0x0f, 0xa8,
+        0x59, 0xb0, 0xa9, 0x80, 0x9a, 0x35, 0xb8, 0x7f, 0x7a, 0x75, 0xd1, 0x9a, 0xb9, 0x43, 0xb7, 0x75,
+        0x3b, 0x5f, 0xf2, 0xcc, 0xbc, 0xda, 0xfd, 0x1b, 0xf4, 0xd8, 0x7f, 0xfb, 0x23, 0x35, 0x85, 0xfd,
+        0x97, 0x1c, 0x7a, 0xa4, 0xf9, 0xe6, 0x51, 0x43, 0x1a, 0x8e, 0xeb, 0x5e, 0xbb, 0xde, 0xe3, 0x07,
+        0x66, 0xf9, 0x6e, 0x0f, 0x6f, 0xbc, 0xe1, 0xca, 0xb1, 0x55, 0x57, 0x07, 0x7c, 0x33, 0xfc, 0x94,
+        0x7f, 0xb2, 0x35, 0xff, 0x14, 0x89, 0x38, 0xff, 0xf8, 0xce, 0x8a, 0x97, 0xdf, 0x03, 0x2d, 0xfd,
+        0x57, 0xdd, 0xd7, 0xf1, 0xc6, 0xfa, 0xbf, 0x3f, 0xd6, 0xbb, 0x77, 0xa7, 0xc9, 0x03, 0x47, 0x6e,
+        0xbb, 0xb9, 0x59, 0x97, 0x1c, 0x04, 0x81, 0x22, 0x4f, 0xac, 0x18, 0xb9, 0x38, 0x2f, 0x67, 0xc3,
+        0xd9, 0x0b, 0xed, 0x46, 0xbf, 0xbf, 0x99, 0x44, 0xb0, 0x8e, 0x2b, 0xe6, 0xd4, 0xcc, 0xed, 0xb8,
+        0x2f, 0x58, 0xf1, 0xe8, 0xb0, 0xcf, 0x96, 0x0e, 0x58, 0x50, 0x80, 0xf2, 0xa6, 0x50, 0x9f, 0x31,
+        0x3b, 0x52, 0x32, 0x8d, 0x1d, 0x7d, 0xc7, 0x9f, 0x5e, 0xdf, 0xeb, 0x1f, 0x17, 0x9f, 0xba, 0x6e,
+        0x7e, 0xeb, 0xea, 0x19, 0x7b, 0x96, 0x75, 0x7e, 0x79, 0x4c, 0x71, 0xdd, 0x09, 0x4d, 0x6e, 0xfb,
+        0x6d, 0x51, 0xaf, 0x9a, 0x16, 0x73, 0x3f, 0xe8, 0x5d, 0x3c, 0x35, 0xe7, 0xe3, 0xed, 0x15, 0x8f,
+        0x9e, 0x3a, 0xd0, 0xb3, 0x0d, 0xc9, 0x52, 0x4a, 0xbc, 0x91, 0xd6, 0x2e, 0x62, 0xc5, 0x48, 0x76,
+        0x2c, 0x60, 0x2b, 0x7a, 0xd3, 0x60, 0xc8, 0xc0, 0x8d, 0xeb, 0x2a, 0x9e, 0x6b, 0xba, 0xa0, 0xfd,
+        0x6d, 0x0d, 0x39, 0x96, 0x73, 0x07, 0x25, 0x94, 0x14, 0xde, 0xab, 0x1b, 0x1e, 0xdb, 0xdd, 0x8a,
+        0x3f, 0xb8, 0xa6, 0xcf, 0xc1, 0x69, 0x95, 0x17, 0x06, 0xb7, 0x1e, 0xff, 0xae, 0x84, 0x6d, 0xc1,
+        0x48, 0x79, 0xf6, 0xd1, 0x9f, 0x7f, 0x5e, 0x54, 0xe7, 0xe8, 0xbb, 0x03, 0x47, 0xcc, 0x66, 0x1c,
+        0x7a, 0x73, 0xc8, 0xdb, 0xde, 0x1e, 0xf4, 0xf5, 0x5b, 0x87, 0x96, 0x36, 0x2e, 0x5a, 0xd1, 0xb1,
+        0xd9, 0xd3, 0x2f, 0xe5, 0x1b, 0xa3, 0xe6, 0xcc, 0xe4, 0xea, 0xc3, 0x2b, 0x6c, 0x8d, 0xe6, 0xf6,
+        0xab, 0x83, 0x9a, 0xf0, 0x4d, 0x55, 0xf0, 0x12, 0x58, 0x11, 0x7e, 0x79, 0x9e, 0x4c, 0x44, 0x74,
+        0xa3, 0x20, 0xf4, 0x52, 0x90, 0x03, 0xb2, 0xd2, 0x63, 0xfb, 0x8c, 0x7c, 0x01, 0x8e, 0x69, 0x34,
+        0x0d, 0xfe, 0x06, 0x81, 0xbf, 0x7c, 0x6d, 0xca, 0xaf, 0x3f, 0x9e, 0xb4, 0xe7, 0x6e, 0x10, 0xf9,
+        0x8a, 0xff, 0xfe, 0x20, 0xe8, 0x24, 0x1f, 0x78, 0x31, 0x55, 0x93, 0x48, 0xb0, 0x8d, 0x23, 0x46,
+        0x0a, 0xbd, 0x90, 0x24, 0xae, 0x42, 0xab, 0xf2, 0x12, 0x7c, 0xdf, 0xee, 0x99, 0x44, 0x8b, 0xf1,
+        0xb3, 0x12, 0xcd, 0x59, 0x70, 0x96, 0xc4, 0x7a, 0x58, 0x05, 0x67, 0xbf, 0xbd, 0xf7, 0x8e, 0xb7,
+        0x37, 0x54, 0xed, 0x58, 0xf8, 0xd7, 0x96, 0x15, 0x8d, 0x4a, 0x47, 0xb6, 0xc0, 0xa6, 0x25, 0x66,
+        0xf4, 0x58, 0x4c, 0xf6, 0x8f, 0x54, 0xb6, 0x72, 0xf6, 0xb8, 0xaf, 0x03, 0xf3, 0x88, 0x68, 0xb2,
+        0x37, 0x2a, 0xf0, 0x60, 0x44, 0x10, 0x4f, 0xfe, 0x25, 0x8a, 0xe7, 0x4e, 0x7c, 0x03, 0xd8, 0xe3,
+        0x0f, 0xda, 0x4a, 0x9b, 0xb9, 0x18, 0xc2, 0x5f, 0x25, 0x21, 0xe9, 0xb1, 0x71, 0xed, 0x39, 0x10,
+        0x0a, 0x9c, 0x77, 0xfd, 0x89, 0x32, 0x11, 0x1e, 0x9a, 0x61, 0xc6, 0xb8, 0x56, 0x0d, 0x3a, 0x99,
+        0x30, 0x6b, 0x39, 0x0e, 0xfa, 0x5f, 0x22, 0xb1, 0x95, 0x47, 0x28, 0x3c, 0x9f, 0x38, 0x0f, 0xf6,
+        0x97, 0x79, 0x45, 0x18, 0x21, 0x18, 0x39, 0xbf, 0xe3, 0xc3, 0xcb, 0x72, 0x77, 0x20, 0x10, 0x62,
+        0xbd, 0x34, 0xe1, 0x4f, 0xed, 0xb9, 0xb1, 0x06, 0x0a, 0xef, 0xe2, 0xfd, 0x02, 0xda, 0xbd, 0x06,
+        0x85, 0x0e, 0x15, 0xba, 0xa8, 0x9d, 0x99, 0x18, 0x68, 0x13, 0xfb, 0x7d, 0xb9, 0xee, 0xf0, 0xfb,
+        0x9b, 0x46, 0x0f, 0x2e, 0xf9, 0x6e, 0x49, 0xa3, 0x43, 0x67, 0xdc, 0x0c, 0x82, 0xb1, 0x80, 0xdd,
+        0x41, 0xc1, 0xb3, 0xc6, 0x50, 0x43, 0xee, 0xac, 0xd8, 0x97, 0x61, 0xda, 0x12, 0x2c, 0x7f, 0x7f,
+        0x6d, 0x51, 0x30, 0x86, 0xa3, 0xa6, 0xf6, 0x3a, 0xc2, 0x5b, 0x28, 0x30, 0xde, 0x3c, 0x46, 0x3e,
+        0x75, 0x25, 0x82, 0x01, 0xda, 0x6c, 0x83, 0xcb, 0xdb, 0xdf, 0xb8, 0xc7, 0x77, 0xcc, 0x0f, 0xdf,
+        0x11, 0xe1, 0x23, 0x50, 0x8a, 0x87, 0x21, 0x92, 0x83, 0x99, 0x68, 0xaf, 0xe9, 0xfa, 0x87, 0x65,
+        0x30, 0x10, 0xb1, 0x47, 0xab, 0x2e, 0x0a, 0x12, 0x8a, 0xc4, 0x1e, 0x8e, 0xd8, 0x27, 0x96, 0x07,
+        0x4b, 0x5b, 0x78, 0xe5, 0xdd, 0xad, 0x3f, 0x1d, 0x9f, 0x17, 0xef, 0x64, 0x36, 0x90, 0xd5, 0xca,
+        0x57, 0xcb, 0x6d, 0x87, 0x7d, 0xea, 0xe9, 0x0a, 0x02, 0x0d, 0x96, 0x1a, 0x80, 0xf1, 0x2c, 0x46,
+        0x5c, 0xe0, 0x78, 0xc1, 0xcf, 0x02, 0x4f, 0x8a, 0x75, 0xbb, 0x74, 0x4e, 0x73, 0x34, 0x84, 0x18,
+        0x3d, 0xee, 0xe5, 0x83, 0xf9, 0x10, 0xf5, 0x92, 0x22, 0x78, 0x89, 0x62, 0x4d, 0x10, 0x7a, 0x1b,
+        0xa1, 0x9d, 0x0a, 0xed, 0x4a, 0xa9, 0xe7, 0xf2, 0x03, 0x81, 0x99, 0x37, 0x30, 0xec, 0x4d, 0x24,
+        0x91, 0x55, 0x8e, 0x20, 0xd9, 0x09, 0xc4, 0x2a, 0x1a, 0xa2, 0xb5, 0x8f, 0x8f, 0x0a, 0x04, 0xe6,
+        0x51, 0xf5, 0x22, 0xe1, 0xce, 0x3b, 0x96, 0xd7, 0xa1, 0x7d, 0x61, 0x20, 0x56, 0x82, 0x75, 0x3c,
+        0x16, 0xd1, 0xd1, 0xf0, 0x72, 0x6c, 0x31, 0x0a, 0x6a, 0x47, 0x12, 0x88, 0x5b, 0xa9, 0x9d, 0x7c,
+        0xe8, 0xe0, 0x73, 0x30, 0xd4, 0x95, 0x3f, 0x94, 0x93, 0xa0, 0x05, 0x34, 0x03, 0x95, 0x49, 0xc9,
+        0x9e, 0x4e, 0xc4, 0x75, 0x60, 0x35, 0x30, 0x5f, 0xad, 0x47, 0x0a, 0x29, 0x51, 0xe1, 0xb9, 0x84,
+        0xdc, 0xb9, 0xf4, 0x05, 0x07, 0x0d, 0x0c, 0x5e, 0x5d, 0xbc, 0x1e, 0x95, 0x05, 0x6f, 0x00, 0x24,
+        0x20, 0x9a, 0x44, 0x3d, 0xc4, 0x62, 0x74, 0x9e, 0xa2, 0x7f, 0x22, 0xc6, 0x1a, 0xc9, 0xe7, 0xd6,
+        0xd1, 0x43, 0xa7, 0x92, 0x7e, 0xd2, 0x97, 0x72, 0x05, 0xd3, 0x5b, 0x61, 0x79, 0xb8, 0xe5, 0xc3,
+        0x32, 0x80, 0xe2, 0xed, 0x7e, 0x50, 0xb5, 0xf4, 0x41, 0x69, 0x23, 0xb8, 0x58, 0xcd, 0xe2, 0xcc,
+        0x8d, 0x4d, 0xf2, 0xde, 0x9c, 0x71, 0x93, 0xd3, 0x4e, 0x1e, 0xb3, 0xd2, 0xdf, 0xd3, 0xcb, 0x1b,
+        0xbd, 0xe6, 0xbb, 0x42, 0xa5, 0x14, 0xc9, 0x77, 0x02, 0x3b, 0xed, 0xb2, 0x92, 0x7c, 0x70, 0xb9,
+        0x67, 0x8c, 0x2a, 0xe0, 0x30, 0x11, 0xb0, 0x64, 0x7b, 0x60, 0x1c, 0x57, 0x35, 0xe3, 0x91, 0x96,
+        0xd6, 0x20, 0x1c, 0x0f, 0x60, 0x24, 0xe2, 0x2b, 0x6d, 0x0d, 0xbf, 0xac, 0x46, 0x12, 0x61, 0x7f,
+        0xb1, 0xd1, 0xe7, 0xc2, 0x9a, 0xb6, 0x9f, 0x1e, 0x19, 0xe7, 0x43, 0x32, 0x35, 0x85, 0x0c, 0x6d,
+        0xe9, 0xe7, 0xa3, 0x61, 0x01, 0x55, 0x5f, 0x2b, 0x1d, 0xd5, 0x83, 0x2b, 0xa8, 0x35, 0xdb, 0x40,
+        0xe3, 0x57, 0xee, 0xf6, 0xf4, 0x6c, 0x5d, 0xea, 0x3f, 0x25, 0x04, 0x9c, 0x1e, 0xda, 0xbf, 0x45,
+        0x56, 0xb1, 0xd9, 0x00, 0xb4, 0x62, 0x0b, 0x46, 0x2d, 0x30, 0xe1, 0x6c, 0x6d, 0x18, 0xc7, 0x94,
+        0x0f, 0x18, 0x43, 0x87, 0x89, 0x0f, 0x39, 0x1d, 0x53, 0x48, 0xab, 0xc0, 0x24, 0xdf, 0xaf, 0xe4,
+        0x5c, 0xd1, 0xd3, 0xfd, 0xd6, 0x29, 0x96, 0x0e, 0x70, 0xa8, 0x34, 0x00, 0xb0, 0x78, 0x07, 0xaa,
+        0x19, 0x8f, 0xb4, 0x19, 0x43, 0x64, 0x1f, 0x74, 0x19, 0xd7, 0xe6, 0x90, 0x6c, 0x5a, 0xec, 0x90,
+        0xaa, 0xa0, 0x89, 0x73, 0x98, 0x88, 0x2d, 0x0b, 0x4f, 0x4d, 0x3f, 0x53, 0x7f, 0x08, 0x04, 0xb2,
+        0xf5, 0x86, 0xde, 0xcb, 0xb9, 0x45, 0x6f, 0x72, 0xc5, 0xde, 0x3c, 0xe9, 0xb6, 0xac, 0x79, 0x46,
+        0xcc, 0xbe, 0x26, 0x9e, 0x37, 0x02, 0x3d, 0x0f, 0x1b, 0x5f, 0xa0, 0x0a, 0xc3, 0x05, 0xf2, 0xa3,
+        0xe6, 0x3d, 0x54, 0x4e, 0xa2, 0x63, 0xae, 0x51, 0x08, 0xda, 0x4c, 0xb4, 0xe0, 0x03, 0xd9, 0x9c,
+        0x6f, 0xf9, 0x00, 0x07, 0x8b, 0x20, 0xab, 0x71, 0x69, 0x3c, 0x9b, 0xa3, 0x67, 0x94, 0x59, 0x61,
+        0x73, 0x1f, 0x3b, 0x3f, 0x7e, 0x1a, 0xa5, 0x5f, 0x36, 0x7e, 0x08, 0x4a, 0xb0, 0xbb, 0xc5, 0xce,
+        0x95, 0x48, 0x06, 0x2a, 0xb6, 0xc0, 0xd0, 0x4e, 0xdb, 0x0f, 0x5c, 0xa8, 0xe0, 0x34, 0x45, 0xae,
+        0x32, 0x76, 0x75, 0x06, 0x40, 0x3a, 0xbf, 0x21, 0x3b, 0xaf, 0x47, 0xc6, 0xb6, 0xa0, 0x62, 0x25,
+        0x0a, 0xb4, 0xa2, 0x96, 0x30, 0x27, 0x20, 0x30, 0xd5, 0xb8, 0xe0, 0xdf, 0x2e, 0xbc, 0x96, 0xa8,
+        0x3c, 0x16, 0x95, 0xf8, 0x10, 0x3a, 0x72, 0x8d, 0x01, 0x06, 0x5e, 0xc5, 0xe7, 0x17, 0xe1, 0x07,
+        0xf1, 0x22, 0x63, 0x92, 0x2f, 0x05, 0x82, 0x1c, 0xfc, 0x81, 0xe8, 0x82, 0x75, 0x28, 0x56, 0xe4,
+        0x0e, 0xd2, 0x13, 0x61, 0x72, 0x38, 0x7b, 0x22, 0x38, 0x55, 0x6a, 0x46, 0xc1, 0x97, 0x58, 0xbc,
+        0x74, 0x3d, 0x9d, 0x20, 0xf1, 0xa4, 0xc7, 0x88, 0xac, 0x7c, 0x25, 0x75, 0x9d, 0xe6, 0xc3, 0x5b,
+        0xcd, 0x0d, 0x94, 0x68, 0x1a, 0xed, 0xf0, 0x7f, 0xed, 0x96, 0x5f, 0x7d, 0x9a, 0x3d, 0x4f, 0xb7,
+        0x51, 0xc9, 0xac, 0x63, 0xfb, 0xef, 0x83, 0xd0, 0xe0, 0xf4, 0x2a, 0x0a, 0xc1, 0xf9, 0xce, 0x39,
+        0xd7, 0x96, 0xa1, 0x9f, 0xe0, 0x17, 0x63, 0xa6, 0x4d, 0xe6, 0xb4, 0x76, 0xf3, 0x66, 0xc6, 0x69,
+        0xe8, 0x63, 0x68, 0x34, 0xff, 0x76, 0xef, 0xb5, 0xfc, 0xdf, 0xb5, 0x97, 0xc7, 0x56, 0xe8, 0x8a,
+        0x7e, 0xe1, 0x0e, 0x9e, 0x40, 0x23, 0x0c, 0x9f, 0x44, 0x43, 0x57, 0x85, 0x92, 0xe7, 0x89, 0x26,
+        0x2a, 0xe3, 0xa9, 0xa2, 0x1a, 0x3b, 0x0e, 0xae, 0xdd, 0xd3, 0x2f, 0x20, 0x52, 0x11, 0xde, 0x5d,
+        0x31, 0x40, 0xdd, 0x9d, 0x8f, 0xb3, 0xb7, 0xac, 0xfa, 0x33, 0x1a, 0xc8, 0x5f, 0x13, 0x50, 0xf4,
+        0xf2, 0x61, 0x1f, 0xcd, 0xe6, 0xa5, 0x07, 0x0b, 0x02, 0x55, 0x02, 0x66, 0x11, 0xfb, 0xd7, 0x01,
+        0xf5, 0x56, 0x05, 0x33, 0x0e, 0xd8, 0x2c, 0x3b, 0xa4, 0xe7, 0x4b, 0xbd, 0x87, 0x27, 0x71, 0x95,
+        0xb3, 0x55, 0x88, 0x89, 0x3d, 0x5c, 0x37, 0x1a, 0x65, 0x8a, 0x6f, 0x27, 0xf0, 0x73, 0xf7, 0xe1,
+        0xd8, 0xc2, 0x49, 0xcd, 0x84, 0xc0, 0x4d, 0xaa, 0x35, 0xa6, 0xf3, 0x20, 0x1b, 0x9a, 0x95, 0x99,
+        0x36, 0xaa, 0x49, 0x73, 0x36, 0x6a, 0x58, 0xfa, 0x84, 0xa8, 0x12, 0xb3, 0x59, 0x73, 0xf3, 0xba,
+        0x3e, 0xeb, 0x75, 0xb2, 0x36, 0xf2, 0x12, 0x98, 0x93, 0x1e, 0x64, 0x8d, 0x0d, 0xef, 0x6d, 0xeb,
+        0x85, 0x76, 0xe9, 0xbd, 0x73, 0x61, 0xbd, 0x2c, 0x5e, 0x47, 0xd4, 0xce, 0x43, 0x90, 0xd6, 0x65,
+        0xf1, 0x0e, 0x81, 0xed, 0x75, 0xbc, 0xe3, 0x31, 0x10, 0x58, 0x12, 0x61, 0xb3, 0x07, 0xec, 0xf1,
+        0x39, 0xd8, 0xb8, 0xeb, 0x7e, 0xb1, 0xf4, 0xb0, 0x84, 0x37, 0x3d, 0xdd, 0x1d, 0x31, 0x24, 0xa0,
+        0xe0, 0x63, 0x3c, 0xb4, 0x9d, 0x67, 0xde, 0xc1, 0x77, 0xf8, 0xf9, 0x23, 0xe4, 0xa8, 0xa7, 0x6b,
+        0x30, 0xca, 0xe2, 0xa8, 0xa5, 0x9c, 0xf1, 0xa6, 0x7b, 0x89, 0x9d, 0x3e, 0xa4, 0x92, 0xa6, 0x54,
+        0xce, 0xc3, 0x88, 0xa8, 0x51, 0x73, 0x79, 0xdd, 0xe7, 0x7c, 0xd0, 0x75, 0x20, 0x0b, 0x6a, 0xcf,
+        0x0b, 0xf5, 0x41, 0x43, 0x40, 0xb5, 0x22, 0xd9, 0xbc, 0x54, 0xdb, 0xab, 0x38, 0xd9, 0x40, 0x64,
+        0x7a, 0xdf, 0xe0, 0xa4, 0x52, 0x47, 0x83, 0xb8, 0xd0, 0x87, 0xa4, 0x77, 0x82, 0xf9, 0xb6, 0xe8,
+        0x0c, 0x84, 0x21, 0x90, 0x1d, 0xe4, 0xb1, 0x9a, 0x59, 0xfd, 0xac, 0x5d, 0xbc, 0x2c, 0xdb, 0xf0,
+        0x9c, 0xb3, 0x15, 0xaf, 0x6b, 0xe0, 0xf7, 0x8a, 0x35, 0xf8, 0x2d, 0xa8, 0x39, 0x48, 0xb2, 0xe5,
+        0x84, 0xe1, 0x60, 0x8b, 0xf5, 0xc7, 0xb3, 0xf6, 0x36, 0x5a, 0xda, 0xb9, 0x3f, 0x80, 0x0b, 0x11,
+        0x9b, 0x1b, 0x5a, 0x33, 0x54, 0x33, 0xc0, 0xac, 0xbb, 0xb7, 0x02, 0x0e, 0x52, 0x95, 0xd8, 0x08,
+        0x1b, 0x53, 0xac, 0x9b, 0xe4, 0x06, 0x43, 0x05, 0x81, 0x69, 0x44, 0x32, 0xf2, 0xb9, 0xab, 0x17,
+        0x3b, 0xf7, 0x58, 0x09, 0xa6, 0x11, 0xca, 0x77, 0x39, 0x46, 0x6a, 0x23, 0x3c, 0x16, 0xa0, 0x9b,
+        0x96, 0xf9, 0x65, 0x01, 0x7f, 0x5c, 0xf6, 0x71, 0x52, 0x5b, 0xbd, 0xc8, 0x7d, 0xfa, 0x05, 0x86,
+        0x2b, 0xdf, 0x93, 0x11, 0xaa, 0x9e, 0xf4, 0x0d, 0x9b, 0x71, 0xf5, 0xcf, 0x9c, 0xe0, 0x53, 0xda,
+        0x0c, 0xe5, 0xcd, 0x31, 0x6a, 0x54, 0x32, 0x9b, 0x12, 0x4b, 0x76, 0x60, 0x4b, 0x91, 0x14, 0xbc,
+        0x10, 0x7a, 0xed, 0x57, 0xb3, 0x08, 0x0a, 0x11, 0x19, 0x5f, 0x34, 0x98, 0x00, 0xe4, 0x2b, 0x41,
+        0x5c, 0x94, 0xe6, 0x09, 0x9a, 0xc9, 0xf0, 0xa8, 0x99, 0x32, 0x13, 0x87, 0x4e, 0x40, 0xa7, 0x2a,
+        0x25, 0x83, 0xe8, 0xf7, 0xcc, 0x7e, 0xc8, 0xe2, 0x6e, 0xf7, 0x0a, 0x7f, 0x2a, 0x93, 0x51, 0xa4,
+        0xcd, 0xb2, 0xa7, 0x72, 0x6f, 0x91, 0xa5, 0xa1, 0x62, 0x12, 0x56, 0x12, 0x9d, 0x2f, 0x93, 0x3b,
+        0xc1, 0xf0, 0x9c, 0x78, 0x4b, 0x9d, 0x48, 0x78, 0x59, 0x04, 0x73, 0xb5, 0x88, 0x73, 0xf9, 0x54,
+        0x9e, 0xf8, 0x2a, 0xd4, 0x96, 0x36, 0x43, 0xba, 0x7a, 0xbc, 0xd0, 0xd6, 0x53, 0x51, 0x82, 0x2e,
+        0x50, 0x73, 0x2d, 0x2a, 0x45, 0xe7, 0xd5, 0x0d, 0x1b, 0x18, 0x89, 0x2e, 0x72, 0x90, 0xfb, 0x06,
+        0x61, 0x56, 0x8b, 0x76, 0x90, 0xc8, 0xec, 0x3d, 0xf0, 0x8a, 0xed, 0x90, 0xa2, 0x4c, 0x81, 0x87,
+        0xb9, 0x19, 0x57, 0x22, 0x97, 0x8b, 0xc5, 0x46, 0xa3, 0x04, 0x4c, 0x4e, 0xfa, 0x0d, 0x0c, 0x63,
+        0x69, 0x5f, 0x95, 0xb2, 0xf9, 0x3a, 0x14, 0x90, 0x95, 0xb1, 0xaa, 0xe0, 0x43, 0x57, 0xa8, 0xc7,
+        0xfa, 0x18, 0xc7, 0x78, 0xe5, 0x7f, 0x24, 0x6f, 0xbc, 0x65, 0x97, 0xf8, 0x28, 0x20, 0x4a, 0x9a,
+        0xfc, 0x5c, 0xf3, 0x11, 0xc4, 0x42, 0xbd, 0x8c, 0xbc, 0x4c, 0x0f, 0xc9, 0x50, 0x81, 0x2c, 0x99,
+        0x33, 0x08, 0xfb, 0x50, 0xdd, 0x44, 0x1d, 0x6c, 0xe0, 0x8c, 0x31, 0x56, 0xed, 0x16, 0xa1, 0x7d,
+        0x18, 0x66, 0xa9, 0x8d, 0x80, 0x17, 0x24, 0x97, 0x1e, 0x15, 0x90, 0x1d, 0x83, 0x08, 0x6e, 0xf9,
+        0x8e, 0x59, 0xcc, 0x17, 0x04, 0x3f, 0xe9, 0x44, 0xe9, 0xfc, 0xa0, 0x48, 0x1f, 0xf2, 0x48, 0xda,
+        0x58, 0x4d, 0x86, 0x95, 0xcf, 0xb2, 0x6b, 0xa4, 0x4c, 0xd0, 0xc6, 0x33, 0x41, 0x49, 0xc1, 0xda,
+        0x99, 0x5f, 0x12, 0x2f, 0x92, 0x11, 0xbe, 0x37, 0x17, 0x75, 0xe7, 0xf9, 0x61, 0x2f, 0xa0, 0xfc,
+        0x34, 0x92, 0xe2, 0xc2, 0x0e, 0xb1, 0x65, 0xf1, 0x8a, 0x7c, 0x92, 0x2d, 0x10, 0xe5, 0xec, 0xdc,
+        0x42, 0xae, 0x6c, 0xfa, 0x48, 0x97, 0x1f, 0xbe, 0x1a, 0xad, 0xb7, 0x40, 0xd4, 0x2d, 0xba, 0xb1,
+        0x4f, 0x15, 0x35, 0x88, 0xeb, 0xc7, 0x97, 0x54, 0x9a, 0x49, 0xd6, 0xf8, 0xc0, 0x51, 0xd0, 0xe2,
+        0x09, 0x50, 0x35, 0xf8, 0x56, 0x1e, 0x90, 0xba, 0x01, 0xa7, 0xab, 0xb1, 0x12, 0x06, 0x43, 0x6d,
+        0xac, 0xe5, 0x99, 0xf6, 0x70, 0xf3, 0x7b, 0x3b, 0x21, 0x3a, 0xd9, 0x57, 0xd5, 0x4d, 0x2d, 0x19,
+        0x72, 0x2d, 0x6b, 0x98, 0x0a, 0x27, 0x3e, 0xad, 0xf0, 0x4c, 0x93, 0xf0, 0x20, 0xda, 0x7f, 0xc1,
+        0xd3, 0x78, 0xbb, 0x70, 0x21, 0x8b, 0x84, 0x85, 0xf1, 0xce, 0xf4, 0x38, 0xe0, 0xff, 0x9e, 0x4e,
+        0xca, 0xd5, 0x7c, 0x48, 0x3b, 0xba, 0x71, 0xf3, 0xb6, 0x84, 0x78, 0x01, 0x77, 0xe0, 0xd4, 0x93,
+        0xcf, 0x0a, 0x8f, 0xa2, 0xef, 0x17, 0xae, 0xe3, 0x6e, 0x71, 0x50, 0x74, 0xf1, 0x06, 0xa7, 0xdc,
+        0xfd, 0x7d, 0xc1, 0x35, 0x91, 0x24, 0x17, 0x66, 0x25, 0x0f, 0x4d, 0x8b, 0xc3, 0x9b, 0x82, 0xcd,
+        0x19, 0x1b, 0xb9, 0x91, 0xed, 0x8c, 0x27, 0xca, 0x9c, 0x5c, 0x6e, 0x73, 0x67, 0x34, 0x54, 0xcd,
+        0xa8, 0x63, 0x75, 0x7d, 0x7a, 0xf8, 0x74, 0x45, 0x2b, 0xce, 0x36, 0x07, 0x9f, 0xf4, 0x91, 0xdd,
+        0x3a, 0x51, 0x1e, 0xc8, 0x75, 0x1a, 0x13, 0x63, 0x6d, 0x5a, 0xf2, 0xa0, 0x0c, 0x85, 0xfa, 0x78,
+        0x0b, 0xfd, 0x32, 0xaa, 0x75, 0xf2, 0x71, 0x68, 0xce, 0x26, 0xb4, 0xf2, 0x2b, 0xb8, 0xab, 0x4e,
+        0x66, 0x8a, 0x7e, 0x94, 0x9c, 0x81, 0x06, 0x3d, 0xe4, 0xa8, 0x8e, 0xb3, 0xb0, 0xe8, 0xd6, 0x00,
+        0xf4, 0xaa, 0x6e, 0x46, 0xe7, 0xe2, 0x8c, 0x44, 0xf6, 0x15, 0x1a, 0x49, 0xa0, 0x03, 0xf9, 0xda,
+        0xee, 0xf3, 0x00, 0x0f, 0x39, 0x2e, 0x66, 0x18, 0xc7, 0x45, 0xb5, 0x78, 0x55, 0x88, 0x8a, 0xf6,
+        0x30, 0xae, 0xc3, 0x7c, 0x13, 0xfa, 0xf4, 0x68, 0x8d, 0xd1, 0x61, 0xcd, 0x6a, 0xac, 0x78, 0x50,
+        0xc7, 0xbe, 0xfa, 0x34, 0xe7, 0x04, 0x4c, 0x5e, 0x95, 0xaa, 0xcf, 0x5d, 0x54, 0xc9, 0xfb, 0x44,
+        0x5a, 0x56, 0x8e, 0x1e, 0xfc, 0x84, 0x89, 0x64, 0x89, 0xa5, 0x92, 0x73, 0x41, 0xc5, 0x38, 0x3f,
+        0xec, 0xc4, 0x91, 0xe4, 0x6c, 0x19, 0x96, 0x39, 0xe5, 0x00, 0x7f, 0xe5, 0x4a, 0xae, 0xe7, 0x45,
+        0x3d, 0xcd, 0x29, 0xf1, 0xf5, 0x3a, 0x8a, 0x37, 0xc3, 0x2d, 0xa8, 0x8a, 0x27, 0x45, 0x5d, 0xde,
+        0xe1, 0xc5, 0xa0, 0x30, 0xb2, 0xbf, 0xb2, 0x36, 0x65, 0x2c, 0x70, 0x24, 0x8b, 0xa5, 0x22, 0x7f,
+        0xd1, 0x3b, 0x9c, 0x35, 0x6e, 0xf3, 0x3e, 0x8e, 0x95, 0x93, 0xf9, 0x66, 0xc8, 0x31, 0x87, 0xbd,
+        0x7d, 0x88, 0xf8, 0xc1, 0xb1, 0xcd, 0x82, 0xe9, 0x24, 0x52, 0xaa, 0xb8, 0xbc, 0xa1, 0x9e, 0xd0,
+        0xf1, 0x96, 0x93, 0x8c, 0x77, 0x66, 0xe0, 0x76, 0x91, 0xaa, 0xa8, 0xbb, 0x9f, 0x16, 0x5d, 0x85,
+        0x41, 0x55, 0xd0, 0xf4, 0x75, 0xba, 0xd2, 0x90, 0xac, 0x2d, 0x39, 0x81, 0xc7, 0x33, 0x0b, 0x1b,
+        0x8d, 0x2d, 0x57, 0xdb, 0xc1, 0x2a, 0x1e, 0xdd, 0x1b, 0xa5, 0x94, 0x33, 0xcf, 0x87, 0x51, 0xd7,
+        0xf6, 0xbc, 0x02, 0x1f, 0x4f, 0xd6, 0x58, 0xda, 0xe1, 0xf1, 0x42, 0xbc, 0x5f, 0xfe, 0xf1, 0xa8,
+        0xab, 0x4a, 0x42, 0x5b, 0xae, 0x5a, 0xdd, 0x14, 0x1a, 0x1f, 0x76, 0x5f, 0xa3, 0xf8, 0xe1, 0x19,
+        0x5e, 0x99, 0xc8, 0x08, 0xd5, 0x45, 0xc7, 0xe2, 0x6a, 0x1c, 0x77, 0xbd, 0x8c, 0x18, 0xbe, 0x38,
+        0xaa, 0x9d, 0x0d, 0x9d, 0x77, 0x45, 0x27, 0xd6, 0xf8, 0xe0, 0x03, 0xef, 0x2e, 0x1f, 0xdd, 0x1e,
+        0x37, 0xe3, 0xd8, 0x3f, 0xd1, 0x87, 0xa8, 0x13, 0x50, 0x8d, 0x51, 0x61, 0x1d, 0x6a, 0x34, 0x2f,
+        0x8f, 0xf3, 0x5c, 0x76, 0xe0, 0xee, 0x15, 0xc1, 0x9a, 0x21, 0x2f, 0x4a, 0xe4, 0xa4, 0x0b, 0x52,
+        0x0c, 0x43, 0x90, 0xe2, 0xb5, 0xe7, 0x27, 0xce, 0x0e, 0x58, 0x7b, 0xd4, 0x8e, 0x46, 0xfa, 0x5e,
+        0x38, 0x0a, 0xf8, 0x72, 0x7f, 0x6e, 0xea, 0x93, 0x59, 0x0b, 0xb9, 0x38, 0x61, 0x70, 0x34, 0xfa,
+        0xe3, 0xb6, 0x8c, 0x1b, 0x31, 0xf7, 0xf1, 0x48, 0xa8, 0x46, 0xe5, 0x87, 0xc3, 0xa0, 0x0b, 0x1e,
+        0xae, 0x05, 0x2e, 0x7c, 0xde, 0xdf, 0x18, 0x80, 0x06, 0xd2, 0x76, 0x47, 0x90, 0x02, 0x26, 0x9b,
+        0xe4, 0x79, 0xa3, 0xc4, 0xa0, 0xfb, 0xcf, 0xd3, 0xeb, 0xed, 0xfd, 0x35, 0x86, 0x03, 0x61, 0x14,
+        0xaa, 0xb0, 0x0d, 0x9c, 0x82, 0xfa, 0x52, 0xa7, 0xd1, 0xd8, 0x17, 0xce, 0x08, 0x93, 0xf7, 0xd8,
+        0x32, 0x8e, 0x42, 0x74, 0x32, 0x19, 0xad, 0xbe, 0x60, 0xaf, 0x25, 0x92, 0x0f, 0x38, 0x9d, 0x65,
+        0x3c, 0xf6, 0x7f, 0x9c, 0x94, 0xca, 0xad, 0x51, 0xb9, 0x37, 0x3c, 0x5d, 0xa9, 0x57, 0x77, 0x19,
+        0xa6, 0x3f, 0xe0, 0xd1, 0xa9, 0x25, 0x4e, 0x1f, 0x99, 0x59, 0x9f, 0x08, 0xa3, 0xe5, 0x1d, 0x46,
+        0xf2, 0xe2, 0x4e, 0x4d, 0x76, 0x87, 0x7a, 0xc9, 0x34, 0xf8, 0xd6, 0x00, 0xe9, 0xd9, 0x8b, 0xc1,
+        0x00, 0xbd, 0x00, 0xde, 0xfc, 0xe9, 0xd0, 0x1a, 0xc4, 0x70, 0x34, 0x95, 0xf4, 0xb3, 0x81, 0x80,
+        0xd8, 0x33, 0x36, 0x31, 0xa7, 0xb0, 0xfa, 0x0c, 0x37, 0x7a, 0xe4, 0x5e, 0xba, 0xc9, 0xf0, 0x64,
+        0xbe, 0x93, 0xaa, 0xc6, 0x90, 0xb8, 0xbf, 0xd1, 0xb7, 0x36, 0xca, 0x1d, 0xa1, 0xf1, 0xe8, 0x5c,
+        0xd0, 0x99, 0x48, 0x6c, 0x74, 0xdd, 0xd2, 0x4f, 0x60, 0x80, 0x0e, 0x0d, 0x93, 0x50, 0xa4, 0x4d,
+        0xf7, 0x6e, 0x2e, 0x63, 0x87, 0xd4, 0x6c, 0x17, 0xc6, 0x53, 0xe9, 0xac, 0x8d, 0xac, 0x09, 0x68,
+        0xf2, 0x56, 0x29, 0x7d, 0x13, 0x7b, 0x2d, 0x03, 0x27, 0x3e, 0xa0, 0x11, 0x57, 0x0c, 0x12, 0xd7,
+        0xda, 0xf8, 0x64, 0xa3, 0x0e, 0x9e, 0x14, 0xd2, 0x26, 0x6e, 0x64, 0x19, 0x2d, 0xee, 0xcb, 0xd8,
+        0xeb, 0x75, 0x49, 0x40, 0xa5, 0xd6, 0x7e, 0xff, 0x10, 0xdd, 0x6e, 0x6b, 0x12, 0x50, 0xe6, 0x5a,
+        0x78, 0xe2, 0x9e, 0xa3, 0xde, 0x5c, 0x40, 0x55, 0xa0, 0x6c, 0x2f, 0x62, 0x79, 0xc9, 0x9e, 0xa1,
+        0xb1, 0x5c, 0x5f, 0x64, 0x3a, 0xf1, 0x61, 0x73, 0x07, 0x7d, 0xe4, 0x7a, 0xab, 0xa4, 0x35, 0xb4,
+        0x7c, 0x15, 0x15, 0xaa, 0x39, 0x56, 0x16, 0x70, 0xd5, 0x31, 0xf6, 0x0f, 0x0e, 0xd4, 0xc4, 0x49,
+        0xa7, 0x1f, 0x2b, 0x64, 0x11, 0x3c, 0x1b, 0x5c, 0x17, 0xfe, 0x76, 0x63, 0xfb, 0x86, 0x8c, 0x72,
+        0x63, 0x7a, 0x09, 0x71, 0xfd, 0x94, 0xfb, 0xe4, 0x05, 0x10, 0x7d, 0xf3, 0x84, 0xb1, 0x2e, 0x6f,
+        0x8c, 0xde, 0x83, 0xb3, 0xc4, 0x2f, 0xce, 0x21, 0xab, 0xbf, 0xa9, 0xc5, 0xcb, 0x83, 0xac, 0xac,
+        0x8e, 0x8f, 0xd3, 0xf7, 0x0a, 0xf3, 0xd4, 0x96, 0x9a, 0x2c, 0xa6, 0x2f, 0x77, 0xfc, 0x31, 0xe3,
+        0x52, 0x8d, 0x92, 0x94, 0xfb, 0x5a, 0xd6, 0xc5, 0x19, 0x5b, 0x15, 0xf7, 0x88, 0x54, 0xe2, 0xc1,
+        0xde, 0x2c, 0xf5, 0x00, 0xbb, 0xc6, 0x57, 0x03, 0x63, 0xff, 0x84, 0x0b, 0x20, 0xfe, 0xf2, 0x13,
+        0xe7, 0x0a, 0x7e, 0x57, 0xe1, 0x5a, 0x96, 0x18, 0x95, 0x6d, 0xd2, 0x13, 0xb4, 0xac, 0xfd, 0xed,
+        0x4b, 0x94, 0x41, 0x71, 0xa6, 0xb0, 0x46, 0xc0, 0xf9, 0x0f, 0xc1, 0xe8, 0xf3, 0x5f, 0x45, 0x12,
+        0x66, 0x88, 0xe0, 0x2e, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_11[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x5a, 0x09, 0x90, 0x56, 0xc5,
+        0x11, 0x4e, 0x50, 0x82, 0x8a, 0x44, 0x0e, 0x43, 0xb2, 0x0a, 0x1a, 0x25, 0xc8, 0x15, 0xe5, 0x3e,
+        0x97, 0x43, 0xa0, 0xa8, 0x22, 0x64, 0x53, 0xe1, 0x58, 0x58, 0xca, 0xc8, 0x46, 0x10, 0x61, 0x83,
+        0x11, 0xc4, 0x6b, 0x05, 0x2c, 0x51, 0x28, 0xc1, 0x6c, 0xc0, 0x2a, 0x8a, 0x43, 0x11, 0x2a, 0x09,
+        0x04, 0x5c, 0x08, 0x2b, 0x82, 0xd1, 0x02, 0x41, 0x29, 0xb6, 0x54, 0x04, 0x35, 0x50, 0x61, 0x39,
+        0x0c, 0x4a, 0x38, 0x04, 0x0c, 0x6e, 0x71, 0xb8, 0x21, 0xc8, 0x72, 0x6d, 0xa6, 0x67, 0xa6, 0x7b,
+        0xba, 0x7b, 0xe6, 0xa5, 0x52, 0x05, 0xfb, 0xff, 0xff, 0x7b, 0x33, 0xdd, 0x5f, 0x7f, 0xdd, 0x73,
+        0x74, 0xcf, 0x7c, 0x33, 0xfc, 0xd4, 0xae, 0xc2, 0xd7, 0xff, 0x79, 0xa4, 0xea, 0xa7, 0x4f, 0xad,
+        0xbe, 0x7c, 0xe9, 0xf2, 0xd1, 0x89, 0x3f, 0xeb, 0xb9, 0xf5, 0xc5, 0x87, 0xf6, 0x34, 0x6c, 0xd6,
+        0xe0, 0xa3, 0x2b, 0xeb, 0x4e, 0x2c, 0x6e, 0x3a, 0xf9, 0xd0, 0x88, 0x1d, 0x75, 0xfa, 0x0f, 0xa8,
+        0x59, 0xb0, 0xa9, 0x80, 0x9a, 0x35, 0xb8, 0x7f, 0x7a, 0x75, 0xd1, 0x9a, 0xb9, 0x43, 0xb7, 0x75,
+        0x3b, 0x5f, 0xf2, 0xcc, 0xbc, 0xda, 0xfd, 0x1b, 0xf4, 0xd8, 0x7f, 0xfb, 0x23, 0x35, 0x85, 0xfd,
+        0x97, 0x1c, 0x7a, 0xa4, 0xf9, 0xe6, 0x51, 0x43, 0x1a, 0x8e, 0xeb, 0x5e, 0xbb, 0xde, 0xe3, 0x07,
+        0x66, 0xf9, 0x6e, 0x0f, 0x6f, 0xbc, 0xe1, 0xca, 0xb1, 0x55, 0x57, 0x07, 0x7c, 0x33, 0xfc, 0x94,
+        0x7f, 0xb2, 0x35, 0xff, 0x14, 0x89, 0x38, 0xff, 0xf8, 0xce, 0x8a, 0x97, 0xdf, 0x03, 0x2d, 0xfd,
+        0x57, 0xdd, 0xd7, 0xf1, 0xc6, 0xfa, 0xbf, 0x3f, 0xd6, 0xbb, 0x77, 0xa7, 0xc9, 0x03, 0x47, 0x6e,
+        0xbb, 0xb9, 0x59, 0x97, 0x1c, 0x04, 0x81, 0x22, 0x4f, 0xac, 0x18, 0xb9, 0x38, 0x2f, 0x67, 0xc3,
+        0xd9, 0x0b, 0xed, 0x46, 0xbf, 0xbf, 0x99, 0x44, 0xb0, 0x8e, 0x2b, 0xe6, 0xd4, 0xcc, 0xed, 0xb8,
+        0x2f, 0x58, 0xf1, 0xe8, 0xb0, 0xcf, 0x96, 0x0e, 0x58, 0x50, 0x80, 0xf2, 0xa6, 0x50, 0x9f, 0x31,
+        0x3b, 0x52, 0x32, 0x8d, 0x1d, 0x7d, 0xc7, 0x9f, 0x5e, 0xdf, 0xeb, 0x1f, 0x17, 0x9f, 0xba, 0x6e,
+        0x7e, 0xeb, 0xea, 0x19, 0x7b, 0x96, 0x75, 0x7e, 0x79, 0x4c, 0x71, 0xdd, 0x09, 0x4d, 0x6e, 0xfb,
+        0x6d, 0x51, 0xaf, 0x9a, 0x16, 0x73, 0x3f, 0xe8, 0x5d, 0x3c, 0x35, 0xe7, 0xe3, 0xed, 0x15, 0x8f,
+        0x9e, 0x3a, 0xd0, 0xb3, 0x0d, 0xc9, 0x52, 0x4a, 0xbc, 0x91, 0xd6, 0x2e, 0x62, 0xc5, 0x48, 0x76,
+        0x2c, 0x60, 0x2b, 0x7a, 0xd3, 0x60, 0xc8, 0xc0, 0x8d, 0xeb, 0x2a, 0x9e, 0x6b, 0xba, 0xa0, 0xfd,
+        0x6d, 0x0d, 0x39, 0x96, 0x73, 0x07, 0x25, 0x94, 0x14, 0xde, 0xab, 0x1b, 0x1e, 0xdb, 0xdd, 0x8a,
+        0x3f, 0xb8, 0xa6, 0xcf, 0xc1, 0x69, 0x95, 0x17, 0x06, 0xb7, 0x1e, 0xff, 0xae, 0x84, 0x6d, 0xc1,
+        0x48, 0x79, 0xf6, 0xd1, 0x9f, 0x7f, 0x5e, 0x54, 0xe7, 0xe8, 0xbb, 0x03, 0x47, 0xcc, 0x66, 0x1c,
+        0x7a, 0x73, 0xc8, 0xdb, 0xde, 0x1e, 0xf4, 0xf5, 0x5b, 0x87, 0x96, 0x36, 0x2e, 0x5a, 0xd1, 0xb1,
+        0xd9, 0xd3, 0x2f, 0xe5, 0x1b, 0xa3, 0xe6, 0xcc, 0xe4, 0xea, 0xc3, 0x2b, 0x6c, 0x8d, 0xe6, 0xf6,
+        0xab, 0x83, 0x9a, 0xf0, 0x4d, 0x55, 0xf0, 0x12, 0x58, 0x11, 0x7e, 0x79, 0x9e, 0x4c, 0x44, 0x74,
+        0xa3, 0x20, 0xf4, 0x52, 0x90, 0x03, 0xb2, 0xd2, 0x63, 0xfb, 0x8c, 0x7c, 0x01, 0x8e, 0x69, 0x34,
+        0x0d, 0xfe, 0x06, 0x81, 0xbf, 0x7c, 0x6d, 0xca, 0xaf, 0x3f, 0x9e, 0xb4, 0xe7, 0x6e, 0x10, 0xf9,
+        0x8a, 0xff, 0xfe, 0x20, 0xe8, 0x24, 0x1f, 0x78, 0x31, 0x55, 0x93, 0x48, 0xb0, 0x8d, 0x23, 0x46,
+        0x0a, 0xbd, 0x90, 0x24, 0xae, 0x42, 0xab, 0xf2, 0x12, 0x7c, 0xdf, 0xee, 0x99, 0x44, 0x8b, 0xf1,
+        0xb3, 0x12, 0xcd, 0x59, 0x70, 0x96, 0xc4, 0x7a, 0x58, 0x05, 0x67, 0xbf, 0xbd, 0xf7, 0x8e, 0xb7,
+        0x37, 0x54, 0xed, 0x58, 0xf8, 0xd7, 0x96, 0x15, 0x8d, 0x4a, 0x47, 0xb6, 0xc0, 0xa6, 0x25, 0x66,
+        0xf4, 0x58, 0x4c, 0xf6, 0x8f, 0x54, 0xb6, 0x72, 0xf6, 0xb8, 0xaf, 0x03, 0xf3, 0x88, 0x68, 0xb2,
+        0x37, 0x2a, 0xf0, 0x60, 0x44, 0x10, 0x4f, 0xfe, 0x25, 0x8a, 0xe7, 0x4e, 0x7c, 0x03, 0xd8, 0xe3,
+        0x0f, 0xda, 0x4a, 0x9b, 0xb9, 0x18, 0xc2, 0x5f, 0x25, 0x21, 0xe9, 0xb1, 0x71, 0xed, 0x39, 0x10,
+        0x0a, 0x9c, 0x77, 0xfd, 0x89, 0x32, 0x11, 0x1e, 0x9a, 0x61, 0xc6, 0xb8, 0x56, 0x0d, 0x3a, 0x99,
+        0x30, 0x6b, 0x39, 0x0e, 0xfa, 0x5f, 0x22, 0xb1, 0x95, 0x47, 0x28, 0x3c, 0x9f, 0x38, 0x0f, 0xf6,
+        0x97, 0x79, 0x45, 0x18, 0x21, 0x18, 0x39, 0xbf, 0xe3, 0xc3, 0xcb, 0x72, 0x77, 0x20, 0x10, 0x62,
+        0xbd, 0x34, 0xe1, 0x4f, 0xed, 0xb9, 0xb1, 0x06, 0x0a, 0xef, 0xe2, 0xfd, 0x02, 0xda, 0xbd, 0x06,
+        0x85, 0x0e, 0x15, 0xba, 0xa8, 0x9d, 0x99, 0x18, 0x68, 0x13, 0xfb, 0x7d, 0xb9, 0xee, 0xf0, 0xfb,
+        0x9b, 0x46, 0x0f, 0x2e, 0xf9, 0x6e, 0x49, 0xa3, 0x43, 0x67, 0xdc, 0x0c, 0x82, 0xb1, 0x80, 0xdd,
+        0x41, 0xc1, 0xb3, 0xc6, 0x50, 0x43, 0xee, 0xac, 0xd8, 0x97, 0x61, 0xda, 0x12, 0x2c, 0x7f, 0x7f,
+        0x6d, 0x51, 0x30, 0x86, 0xa3, 0xa6, 0xf6, 0x3a, 0xc2, 0x5b, 0x28, 0x30, 0xde, 0x3c, 0x46, 0x3e,
+        0x75, 0x25, 0x82, 0x01, 0xda, 0x6c, 0x83, 0xcb, 0xdb, 0xdf, 0xb8, 0xc7, 0x77, 0xcc, 0x0f, 0xdf,
+        0x11, 0xe1, 0x23, 0x50, 0x8a, 0x87, 0x21, 0x92, 0x83, 0x99, 0x68, 0xaf, 0xe9, 0xfa, 0x87, 0x65,
+        0x30, 0x10, 0xb1, 0x47, 0xab, 0x2e, 0x0a, 0x12, 0x8a, 0xc4, 0x1e, 0x8e, 0xd8, 0x27, 0x96, 0x07,
+        0x4b, 0x5b, 0x78, 0xe5, 0xdd, 0xad, 0x3f, 0x1d, 0x9f, 0x17, 0xef, 0x64, 0x36, 0x90, 0xd5, 0xca,
+        0x57, 0xcb, 0x6d, 0x87, 0x7d, 0xea, 0xe9, 0x0a, 0x02, 0x0d, 0x96, 0x1a, 0x80, 0xf1, 0x2c, 0x46,
+        0x5c, 0xe0, 0x78, 0xc1, 0xcf, 0x02, 0x4f, 0x8a, 0x75, 0xbb, 0x74, 0x4e, 0x73, 0x34, 0x84, 0x18,
+        0x3d, 0xee, 0xe5, 0x83, 0xf9, 0x10, 0xf5, 0x92, 0x22, 0x78, 0x89, 0x62, 0x4d, 0x10, 0x7a, 0x1b,
+        0xa1, 0x9d, 0x0a, 0xed, 0x4a, 0xa9, 0xe7, 0xf2, 0x03, 0x81, 0x99, 0x37, 0x30, 0xec, 0x4d, 0x24,
+        0x91, 0x55, 0x8e, 0x20, 0xd9, 0x09, 0xc4, 0x2a, 0x1a, 0xa2, 0xb5, 0x8f, 0x8f, 0x0a, 0x04, 0xe6,
+        0x51, 0xf5, 0x22, 0xe1, 0xce, 0x3b, 0x96, 0xd7, 0xa1, 0x7d, 0x61, 0x20, 0x56, 0x82, 0x75, 0x3c,
+        0x16, 0xd1, 0xd1, 0xf0, 0x72, 0x6c, 0x31, 0x0a, 0x6a, 0x47, 0x12, 0x88, 0x5b, 0xa9, 0x9d, 0x7c,
+        0xe8, 0xe0, 0x73, 0x30, 0xd4, 0x95, 0x3f, 0x94, 0x93, 0xa0, 0x05, 0x34, 0x03, 0x95, 0x49, 0xc9,
+        0x9e, 0x4e, 0xc4, 0x75, 0x60, 0x35, 0x30, 0x5f, 0xad, 0x47, 0x0a, 0x29, 0x51, 0xe1, 0xb9, 0x84,
+        0xdc, 0xb9, 0xf4, 0x05, 0x07, 0x0d, 0x0c, 0x5e, 0x5d, 0xbc, 0x1e, 0x95, 0x05, 0x6f, 0x00, 0x24,
+        0x20, 0x9a, 0x44, 0x3d, 0xc4, 0x62, 0x74, 0x9e, 0xa2, 0x7f, 0x22, 0xc6, 0x1a, 0xc9, 0xe7, 0xd6,
+        0xd1, 0x43, 0xa7, 0x92, 0x7e, 0xd2, 0x97, 0x72, 0x05, 0xd3, 0x5b, 0x61, 0x79, 0xb8, 0xe5, 0xc3,
+        0x32, 0x80, 0xe2, 0xed, 0x7e, 0x50, 0xb5, 0xf4, 0x41, 0x69, 0x23, 0xb8, 0x58, 0xcd, 0xe2, 0xcc,
+        0x8d, 0x4d, 0xf2, 0xde, 0x9c, 0x71, 0x93, 0xd3, 0x4e, 0x1e, 0xb3, 0xd2, 0xdf, 0xd3, 0xcb, 0x1b,
+        0xbd, 0xe6, 0xbb, 0x42, 0xa5, 0x14, 0xc9, 0x77, 0x02, 0x3b, 0xed, 0xb2, 0x92, 0x7c, 0x70, 0xb9,
+        0x67, 0x8c, 0x2a, 0xe0, 0x30, 0x11, 0xb0, 0x64, 0x7b, 0x60, 0x1c, 0x57, 0x35, 0xe3, 0x91, 0x96,
+        0xd6, 0x20, 0x1c, 0x0f, 0x60, 0x24, 0xe2, 0x2b, 0x6d, 0x0d, 0xbf, 0xac, 0x46, 0x12, 0x61, 0x7f,
+        0xb1, 0xd1, 0xe7, 0xc2, 0x9a, 0xb6, 0x9f, 0x1e, 0x19, 0xe7, 0x43, 0x32, 0x35, 0x85, 0x0c, 0x6d,
+        0xe9, 0xe7, 0xa3, 0x61, 0x01, 0x55, 0x5f, 0x2b, 0x1d, 0xd5, 0x83, 0x2b, 0xa8, 0x35, 0xdb, 0x40,
+        0xe3, 0x57, 0xee, 0xf6, 0xf4, 0x6c, 0x5d, 0xea, 0x3f, 0x25, 0x04, 0x9c, 0x1e, 0xda, 0xbf, 0x45,
+        0x56, 0xb1, 0xd9, 0x00, 0xb4, 0x62, 0x0b, 0x46, 0x2d, 0x30, 0xe1, 0x6c, 0x6d, 0x18, 0xc7, 0x94,
+        0x0f, 0x18, 0x43, 0x87, 0x89, 0x0f, 0x39, 0x1d, 0x53, 0x48, 0xab, 0xc0, 0x24, 0xdf, 0xaf, 0xe4,
+        0x5c, 0xd1, 0xd3, 0xfd, 0xd6, 0x29, 0x96, 0x0e, 0x70, 0xa8, 0x34, 0x00, 0xb0, 0x78, 0x07, 0xaa,
+        0x19, 0x8f, 0xb4, 0x19, 0x43, 0x64, 0x1f, 0x74, 0x19, 0xd7, 0xe6, 0x90, 0x6c, 0x5a, 0xec, 0x90,
+        0xaa, 0xa0, 0x89, 0x73, 0x98, 0x88, 0x2d, 0x0b, 0x4f, 0x4d, 0x3f, 0x53, 0x7f, 0x08, 0x04, 0xb2,
+        0xf5, 0x86, 0xde, 0xcb, 0xb9, 0x45, 0x6f, 0x72, 0xc5, 0xde, 0x3c, 0xe9, 0xb6, 0xac, 0x79, 0x46,
+        0xcc, 0xbe, 0x26, 0x9e, 0x37, 0x02, 0x3d, 0x0f, 0x1b, 0x5f, 0xa0, 0x0a, 0xc3, 0x05, 0xf2, 0xa3,
+        0xe6, 0x3d, 0x54, 0x4e, 0xa2, 0x63, 0xae, 0x51, 0x08, 0xda, 0x4c, 0xb4, 0xe0, 0x03, 0xd9, 0x9c,
+        0x6f, 0xf9, 0x00, 0x07, 0x8b, 0x20, 0xab, 0x71, 0x69, 0x3c, 0x9b, 0xa3, 0x67, 0x94, 0x59, 0x61,
+        0x73, 0x1f, 0x3b, 0x3f, 0x7e, 0x1a, 0xa5, 0x5f, 0x36, 0x7e, 0x08, 0x4a, 0xb0, 0xbb, 0xc5, 0xce,
+        0x95, 0x48, 0x06, 0x2a, 0xb6, 0xc0, 0xd0, 0x4e, 0xdb, 0x0f, 0x5c, 0xa8, 0xe0, 0x34, 0x45, 0xae,
+        0x32, 0x76, 0x75, 0x06, 0x40, 0x3a, 0xbf, 0x21, 0x3b, 0xaf, 0x47, 0xc6, 0xb6, 0xa0, 0x62, 0x25,
+        0x0a, 0xb4, 0xa2, 0x96, 0x30, 0x27, 0x20, 0x30, 0xd5, 0xb8, 0xe0, 0xdf, 0x2e, 0xbc, 0x96, 0xa8,
+        0x3c, 0x16, 0x95, 0xf8, 0x10, 0x3a, 0x72, 0x8d, 0x01, 0x06, 0x5e, 0xc5, 0xe7, 0x17, 0xe1, 0x07,
+        0xf1, 0x22, 0x63, 0x92, 0x2f, 0x05, 0x82, 0x1c, 0xfc, 0x81, 0xe8, 0x82, 0x75, 0x28, 0x56, 0xe4,
+        0x0e, 0xd2, 0x13, 0x61, 0x72, 0x38, 0x7b, 0x22, 0x38, 0x55, 0x6a, 0x46, 0xc1, 0x97, 0x58, 0xbc,
+        0x74, 0x3d, 0x9d, 0x20, 0xf1, 0xa4, 0xc7, 0x88, 0xac, 0x7c, 0x25, 0x75, 0x9d, 0xe6, 0xc3, 0x5b,
+        0xcd, 0x0d, 0x94, 0x68, 0x1a, 0xed, 0xf0, 0x7f, 0xed, 0x96, 0x5f, 0x7d, 0x9a, 0x3d, 0x4f, 0xb7,
+        0x51, 0xc9, 0xac, 0x63, 0xfb, 0xef, 0x83, 0xd0, 0xe0, 0xf4, 0x2a, 0x0a, 0xc1, 0xf9, 0xce, 0x39,
+        0xd7, 0x96, 0xa1, 0x9f, 0xe0, 0x17, 0x63, 0xa6, 0x4d, 0xe6, 0xb4, 0x76, 0xf3, 0x66, 0xc6, 0x69,
+        0xe8, 0x63, 0x68, 0x34, 0xff, 0x76, 0xef, 0xb5, 0xfc, 0xdf, 0xb5, 0x97, 0xc7, 0x56, 0xe8, 0x8a,
+        0x7e, 0xe1, 0x0e, 0x9e, 0x40, 0x23, 0x0c, 0x9f, 0x44, 0x43, 0x57, 0x85, 0x92, 0xe7, 0x89, 0x26,
+        0x2a, 0xe3, 0xa9, 0xa2, 0x1a, 0x3b, 0x0e, 0xae, 0xdd, 0xd3, 0x2f, 0x20, 0x52, 0x11, 0xde, 0x5d,
+        0x31, 0x40, 0xdd, 0x9d, 0x8f, 0xb3, 0xb7, 0xac, 0xfa, 0x33, 0x1a, 0xc8, 0x5f, 0x13, 0x50, 0xf4,
+        0xf2, 0x61, 0x1f, 0xcd, 0xe6, 0xa5, 0x07, 0x0b, 0x02, 0x55, 0x02, 0x66, 0x11, 0xfb, 0xd7, 0x01,
+        0xf5, 0x56, 0x05, 0x33, 0x0e, 0xd8, 0x2c, 0x3b, 0xa4, 0xe7, 0x4b, 0xbd, 0x87, 0x27, 0x71, 0x95,
+        0xb3, 0x55, 0x88, 0x89, 0x3d, 0x5c, 0x37, 0x1a, 0x65, 0x8a, 0x6f, 0x27, 0xf0, 0x73, 0xf7, 0xe1,
+        0xd8, 0xc2, 0x49, 0xcd, 0x84, 0xc0, 0x4d, 0xaa, 0x35, 0xa6, 0xf3, 0x20, 0x1b, 0x9a, 0x95, 0x99,
+        0x36, 0xaa, 0x49, 0x73, 0x36, 0x6a, 0x58, 0xfa, 0x84, 0xa8, 0x12, 0xb3, 0x59, 0x73, 0xf3, 0xba,
+        0x3e, 0xeb, 0x75, 0xb2, 0x36, 0xf2, 0x12, 0x98, 0x93, 0x1e, 0x64, 0x8d, 0x0d, 0xef, 0x6d, 0xeb,
+        0x85, 0x76, 0xe9, 0xbd, 0x73, 0x61, 0xbd, 0x2c, 0x5e, 0x47, 0xd4, 0xce, 0x43, 0x90, 0xd6, 0x65,
+        0xf1, 0x0e, 0x81, 0xed, 0x75, 0xbc, 0xe3, 0x31, 0x10, 0x58, 0x12, 0x61, 0xb3, 0x07, 0xec, 0xf1,
+        0x39, 0xd8, 0xb8, 0xeb, 0x7e, 0xb1, 0xf4, 0xb0, 0x84, 0x37, 0x3d, 0xdd, 0x1d, 0x31, 0x24, 0xa0,
+        0xe0, 0x63, 0x3c, 0xb4, 0x9d, 0x67, 0xde, 0xc1, 0x77, 0xf8, 0xf9, 0x23, 0xe4, 0xa8, 0xa7, 0x6b,
+        0x30, 0xca, 0xe2, 0xa8, 0xa5, 0x9c, 0xf1, 0xa6, 0x7b, 0x89, 0x9d, 0x3e, 0xa4, 0x92, 0xa6, 0x54,
+        0xce, 0xc3, 0x88, 0xa8, 0x51, 0x73, 0x79, 0xdd, 0xe7, 0x7c, 0xd0, 0x75, 0x20, 0x0b, 0x6a, 0xcf,
+        0x0b, 0xf5, 0x41, 0x43, 0x40, 0xb5, 0x22, 0xd9, 0xbc, 0x54, 0xdb, 0xab, 0x38, 0xd9, 0x40, 0x64,
+        0x7a, 0xdf, 0xe0, 0xa4, 0x52, 0x47, 0x83, 0xb8, 0xd0, 0x87, 0xa4, 0x77, 0x82, 0xf9, 0xb6, 0xe8,
+        0x0c, 0x84, 0x21, 0x90, 0x1d, 0xe4, 0xb1, 0x9a, 0x59, 0xfd, 0xac, 0x5d, 0xbc, 0x2c, 0xdb, 0xf0,
+        0x9c, 0xb3, 0x15, 0xaf, 0x6b, 0xe0, 0xf7, 0x8a, 0x35, 0xf8, 0x2d, 0xa8, 0x39, 0x48, 0xb2, 0xe5,
+        0x84, 0xe1, 0x60, 0x8b, 0xf5, 0xc7, 0xb3, 0xf6, 0x36, 0x5a, 0xda, 0xb9, 0x3f, 0x80, 0x0b, 0x11,
+        0x9b, 0x1b, 0x5a, 0x33, 0x54, 0x33, 0xc0, 0xac, 0xbb, 0xb7, 0x02, 0x0e, 0x52, 0x95, 0xd8, 0x08,
+        0x1b, 0x53, 0xac, 0x9b, 0xe4, 0x06, 0x43, 0x05, 0x81, 0x69, 0x44, 0x32, 0xf2, 0xb9, 0xab, 0x17,
+        0x3b, 0xf7, 0x58, 0x09, 0xa6, 0x11, 0xca, 0x77, 0x39, 0x46, 0x6a, 0x23, 0x3c, 0x16, 0xa0, 0x9b,
+        0x96, 0xf9, 0x65, 0x01, 0x7f, 0x5c, 0xf6, 0x71, 0x52, 0x5b, 0xbd, 0xc8, 0x7d, 0xfa, 0x05, 0x86,
+        0x2b, 0xdf, 0x93, 0x11, 0xaa, 0x9e, 0xf4, 0x0d, 0x9b, 0x71, 0xf5, 0xcf, 0x9c, 0xe0, 0x53, 0xda,
+        0x0c, 0xe5, 0xcd, 0x31, 0x6a, 0x54, 0x32, 0x9b, 0x12, 0x4b, 0x76, 0x60, 0x4b, 0x91, 0x14, 0xbc,
+        0x10, 0x7a, 0xed, 0x57, 0xb3, 0x08, 0x0a, 0x11, 0x19, 0x5f, 0x34, 0x98, 0x00, 0xe4, 0x2b, 0x41,
+        0x5c, 0x94, 0xe6, 0x09, 0x9a, 0xc9, 0xf0, 0xa8, 0x99, 0x32, 0x13, 0x87, 0x4e, 0x40, 0xa7, 0x2a,
+        0x25, 0x83, 0xe8, 0xf7, 0xcc, 0x7e, 0xc8, 0xe2, 0x6e, 0xf7, 0x0a, 0x7f, 0x2a, 0x93, 0x51, 0xa4,
+        0xcd, 0xb2, 0xa7, 0x72, 0x6f, 0x91, 0xa5, 0xa1, 0x62, 0x12, 0x56, 0x12, 0x9d, 0x2f, 0x93, 0x3b,
+        0xc1, 0xf0, 0x9c, 0x78, 0x4b, 0x9d, 0x48, 0x78, 0x59, 0x04, 0x73, 0xb5, 0x88, 0x73, 0xf9, 0x54,
+        0x9e, 0xf8, 0x2a, 0xd4, 0x96, 0x36, 0x43, 0xba, 0x7a, 0xbc, 0xd0, 0xd6, 0x53, 0x51, 0x82, 0x2e,
+        0x50, 0x73, 0x2d, 0x2a, 0x45, 0xe7, 0xd5, 0x0d, 0x1b, 0x18, 0x89, 0x2e, 0x72, 0x90, 0xfb, 0x06,
+        0x61, 0x56, 0x8b, 0x76, 0x90, 0xc8, 0xec, 0x3d, 0xf0, 0x8a, 0xed, 0x90, 0xa2, 0x4c, 0x81, 0x87,
+        0xb9, 0x19, 0x57, 0x22, 0x97, 0x8b, 0xc5, 0x46, 0xa3, 0x04, 0x4c, 0x4e, 0xfa, 0x0d, 0x0c, 0x63,
+        0x69, 0x5f, 0x95, 0xb2, 0xf9, 0x3a, 0x14, 0x90, 0x95, 0xb1, 0xaa, 0xe0, 0x43, 0x57, 0xa8, 0xc7,
+        0xfa, 0x18, 0xc7, 0x78, 0xe5, 0x7f, 0x24, 0x6f, 0xbc, 0x65, 0x97, 0xf8, 0x28, 0x20, 0x4a, 0x9a,
+        0xfc, 0x5c, 0xf3, 0x11, 0xc4, 0x42, 0xbd, 0x8c, 0xbc, 0x4c, 0x0f, 0xc9, 0x50, 0x81, 0x2c, 0x99,
+        0x33, 0x08, 0xfb, 0x50, 0xdd, 0x44, 0x1d, 0x6c, 0xe0, 0x8c, 0x31, 0x56, 0xed, 0x16, 0xa1, 0x7d,
+        0x18, 0x66, 0xa9, 0x8d, 0x80, 0x17, 0x24, 0x97, 0x1e, 0x15, 0x90, 0x1d, 0x83, 0x08, 0x6e, 0xf9,
+        0x8e, 0x59, 0xcc, 0x17, 0x04, 0x3f, 0xe9, 0x44, 0xe9, 0xfc, 0xa0, 0x48, 0x1f, 0xf2, 0x48, 0xda,
+        0x58, 0x4d, 0x86, 0x95, 0xcf, 0xb2, 0x6b, 0xa4, 0x4c, 0xd0, 0xc6, 0x33, 0x41, 0x49, 0xc1, 0xda,
+        0x99, 0x5f, 0x12, 0x2f, 0x92, 0x11, 0xbe, 0x37, 0x17, 0x75, 0xe7, 0xf9, 0x61, 0x2f, 0xa0, 0xfc,
+        0x34, 0x92, 0xe2, 0xc2, 0x0e, 0xb1, 0x65, 0xf1, 0x8a, 0x7c, 0x92, 0x2d, 0x10, 0xe5, 0xec, 0xdc,
+        0x42, 0xae, 0x6c, 0xfa, 0x48, 0x97, 0x1f, 0xbe, 0x1a, 0xad, 0xb7, 0x40, 0xd4, 0x2d, 0xba, 0xb1,
+        0x4f, 0x15, 0x35, 0x88, 0xeb, 0xc7, 0x97, 0x54, 0x9a, 0x49, 0xd6, 0xf8, 0xc0, 0x51, 0xd0, 0xe2,
+        0x09, 0x50, 0x35, 0xf8, 0x56, 0x1e, 0x90, 0xba, 0x01, 0xa7, 0xab, 0xb1, 0x12, 0x06, 0x43, 0x6d,
+        0xac, 0xe5, 0x99, 0xf6, 0x70, 0xf3, 0x7b, 0x3b, 0x21, 0x3a, 0xd9, 0x57, 0xd5, 0x4d, 0x2d, 0x19,
+        0x72, 0x2d, 0x6b, 0x98, 0x0a, 0x27, 0x3e, 0xad, 0xf0, 0x4c, 0x93, 0xf0, 0x20, 0xda, 0x7f, 0xc1,
+        0xd3, 0x78, 0xbb, 0x70, 0x21, 0x8b, 0x84, 0x85, 0xf1, 0xce, 0xf4, 0x38, 0xe0, 0xff, 0x9e, 0x4e,
+        0xca, 0xd5, 0x7c, 0x48, 0x3b, 0xba, 0x71, 0xf3, 0xb6, 0x84, 0x78, 0x01, 0x77, 0xe0, 0xd4, 0x93,
+        0xcf, 0x0a, 0x8f, 0xa2, 0xef, 0x17, 0xae, 0xe3, 0x6e, 0x71, 0x50, 0x74, 0xf1, 0x06, 0xa7, 0xdc,
+        0xfd, 0x7d, 0xc1, 0x35, 0x91, 0x24, 0x17, 0x66, 0x25, 0x0f, 0x4d, 0x8b, 0xc3, 0x9b, 0x82, 0xcd,
+        0x19, 0x1b, 0xb9, 0x91, 0xed, 0x8c, 0x27, 0xca, 0x9c, 0x5c, 0x6e, 0x73, 0x67, 0x34, 0x54, 0xcd,
+        0xa8, 0x63, 0x75, 0x7d, 0x7a, 0xf8, 0x74, 0x45, 0x2b, 0xce, 0x36, 0x07, 0x9f, 0xf4, 0x91, 0xdd,
+        0x3a, 0x51, 0x1e, 0xc8, 0x75, 0x1a, 0x13, 0x63, 0x6d, 0x5a, 0xf2, 0xa0, 0x0c, 0x85, 0xfa, 0x78,
+        0x0b, 0xfd, 0x32, 0xaa, 0x75, 0xf2, 0x71, 0x68, 0xce, 0x26, 0xb4, 0xf2, 0x2b, 0xb8, 0xab, 0x4e,
+        0x66, 0x8a, 0x7e, 0x94, 0x9c, 0x81, 0x06, 0x3d, 0xe4, 0xa8, 0x8e, 0xb3, 0xb0, 0xe8, 0xd6, 0x00,
+        0xf4, 0xaa, 0x6e, 0x46, 0xe7, 0xe2, 0x8c, 0x44, 0xf6, 0x15, 0x1a, 0x49, 0xa0, 0x03, 0xf9, 0xda,
+        0xee, 0xf3, 0x00, 0x0f, 0x39, 0x2e, 0x66, 0x18, 0xc7, 0x45, 0xb5, 0x78, 0x55, 0x88, 0x8a, 0xf6,
+        0x30, 0xae, 0xc3, 0x7c, 0x13, 0xfa, 0xf4, 0x68, 0x8d, 0xd1, 0x61, 0xcd, 0x6a, 0xac, 0x78, 0x50,
+        0xc7, 0xbe, 0xfa, 0x34, 0xe7, 0x04, 0x4c, 0x5e, 0x95, 0xaa, 0xcf, 0x5d, 0x54, 0xc9, 0xfb, 0x44,
+        0x5a, 0x56, 0x8e, 0x1e, 0xfc, 0x84, 0x89, 0x64, 0x89, 0xa5, 0x92, 0x73, 0x41, 0xc5, 0x38, 0x3f,
+        0xec, 0xc4, 0x91, 0xe4, 0x6c, 0x19, 0x96, 0x39, 0xe5, 0x00, 0x7f, 0xe5, 0x4a, 0xae, 0xe7, 0x45,
+        0x3d, 0xcd, 0x29, 0xf1, 0xf5, 0x3a, 0x8a, 0x37, 0xc3, 0x2d, 0xa8, 0x8a, 0x27, 0x45, 0x5d, 0xde,
+        0xe1, 0xc5, 0xa0, 0x30, 0xb2, 0xbf, 0xb2, 0x36, 0x65, 0x2c, 0x70, 0x24, 0x8b, 0xa5, 0x22, 0x7f,
+        0xd1, 0x3b, 0x9c, 0x35, 0x6e, 0xf3, 0x3e, 0x8e, 0x95, 0x93, 0xf9, 0x66, 0xc8, 0x31, 0x87, 0xbd,
+        0x7d, 0x88, 0xf8, 0xc1, 0xb1, 0xcd, 0x82, 0xe9, 0x24, 0x52, 0xaa, 0xb8, 0xbc, 0xa1, 0x9e, 0xd0,
+        0xf1, 0x96, 0x93, 0x8c, 0x77, 0x66, 0xe0, 0x76, 0x91, 0xaa, 0xa8, 0xbb, 0x9f, 0x16, 0x5d, 0x85,
+        0x41, 0x55, 0xd0, 0xf4, 0x75, 0xba, 0xd2, 0x90, 0xac, 0x2d, 0x39, 0x81, 0xc7, 0x33, 0x0b, 0x1b,
+        0x8d, 0x2d, 0x57, 0xdb, 0xc1, 0x2a, 0x1e, 0xdd, 0x1b, 0xa5, 0x94, 0x33, 0xcf, 0x87, 0x51, 0xd7,
+        0xf6, 0xbc, 0x02, 0x1f, 0x4f, 0xd6, 0x58, 0xda, 0xe1, 0xf1, 0x42, 0xbc, 0x5f, 0xfe, 0xf1, 0xa8,
+        0xab, 0x4a, 0x42, 0x5b, 0xae, 0x5a, 0xdd, 0x14, 0x1a, 0x1f, 0x76, 0x5f, 0xa3, 0xf8, 0xe1, 0x19,
+        0x5e, 0x99, 0xc8, 0x08, 0xd5, 0x45, 0xc7, 0xe2, 0x6a, 0x1c, 0x77, 0xbd, 0x8c, 0x18, 0xbe, 0x38,
+        0xaa, 0x9d, 0x0d, 0x9d, 0x77, 0x45, 0x27, 0xd6, 0xf8, 0xe0, 0x03, 0xef, 0x2e, 0x1f, 0xdd, 0x1e,
+        0x37, 0xe3, 0xd8, 0x3f, 0xd1, 0x87, 0xa8, 0x13, 0x50, 0x8d, 0x51, 0x61, 0x1d, 0x6a, 0x34, 0x2f,
+        0x8f, 0xf3, 0x5c, 0x76, 0xe0, 0xee, 0x15, 0xc1, 0x9a, 0x21, 0x2f, 0x4a, 0xe4, 0xa4, 0x0b, 0x52,
+        0x0c, 0x43, 0x90, 0xe2, 0xb5, 0xe7, 0x27, 0xce, 0x0e, 0x58, 0x7b, 0xd4, 0x8e, 0x46, 0xfa, 0x5e,
+        0x38, 0x0a, 0xf8, 0x72, 0x7f, 0x6e, 0xea, 0x93, 0x59, 0x0b, 0xb9, 0x38, 0x61, 0x70, 0x34, 0xfa,
+        0xe3, 0xb6, 0x8c, 0x1b, 0x31, 0xf7, 0xf1, 0x48, 0xa8, 0x46, 0xe5, 0x87, 0xc3, 0xa0, 0x0b, 0x1e,
+        0xae, 0x05, 0x2e, 0x7c, 0xde, 0xdf, 0x18, 0x80, 0x06, 0xd2, 0x76, 0x47, 0x90, 0x02, 0x26, 0x9b,
+        0xe4, 0x79, 0xa3, 0xc4, 0xa0, 0xfb, 0xcf, 0xd3, 0xeb, 0xed, 0xfd, 0x35, 0x86, 0x03, 0x61, 0x14,
+        0xaa, 0xb0, 0x0d, 0x9c, 0x82, 0xfa, 0x52, 0xa7, 0xd1, 0xd8, 0x17, 0xce, 0x08, 0x93, 0xf7, 0xd8,
+        0x32, 0x8e, 0x42, 0x74, 0x32, 0x19, 0xad, 0xbe, 0x60, 0xaf, 0x25, 0x92, 0x0f, 0x38, 0x9d, 0x65,
+        0x3c, 0xf6, 0x7f, 0x9c, 0x94, 0xca, 0xad, 0x51, 0xb9, 0x37, 0x3c, 0x5d, 0xa9, 0x57, 0x77, 0x19,
+        0xa6, 0x3f, 0xe0, 0xd1, 0xa9, 0x25, 0x4e, 0x1f, 0x99, 0x59, 0x9f, 0x08, 0xa3, 0xe5, 0x1d, 0x46,
+        0xf2, 0xe2, 0x4e, 0x4d, 0x76, 0x87, 0x7a, 0xc9, 0x34, 0xf8, 0xd6, 0x00, 0xe9, 0xd9, 0x8b, 0xc1,
+        0x00, 0xbd, 0x00, 0xde, 0xfc, 0xe9, 0xd0, 0x1a, 0xc4, 0x70, 0x34, 0x95, 0xf4, 0x77, 0x8a, 0xef,
+        0xaf, 0x64, 0x6c, 0x62, 0x4e, 0x61, 0xf5, 0x19, 0x6e, 0xf4, 0xc8, 0xbd, 0x74, 0x93, 0xe1, 0xc9,
+        0x7c, 0x27, 0x55, 0x8d, 0x21, 0x71, 0x7f, 0xa3, 0x6f, 0x6d, 0x94, 0x3b, 0x42, 0xe3, 0xd1, 0xb9,
+        0xa0, 0x33, 0x91, 0xd8, 0xe8, 0xba, 0xa5, 0x9f, 0xc0, 0x00, 0x1d, 0x1a, 0x26, 0xa1, 0x48, 0x9b,
+        0xee, 0xdd, 0x5c, 0xc6, 0x0e, 0xa9, 0xd9, 0x2e, 0x8c, 0xa7, 0xd2, 0x59, 0x1b, 0x59, 0x13, 0xd0,
+        0xe4, 0xad, 0x52, 0xfa, 0x26, 0xf6, 0x5a, 0x06, 0x4e, 0x7c, 0x40, 0x23, 0xae, 0x18, 0x24, 0xae,
+        0xb5, 0xf1, 0xc9, 0x46, 0x1d, 0x3c, 0x29, 0xa4, 0x4d, 0xdc, 0xc8, 0x32, 0x5a, 0xdc, 0x97, 0xb1,
+        0xd7, 0xeb, 0x92, 0x80, 0x4a, 0xad, 0xfd, 0xfe, 0x21, 0xba, 0xdd, 0xd6, 0x24, 0xa0, 0xcc, 0xb5,
+        0xf0, 0xc4, 0x3d, 0x47, 0xbd, 0xb9, 0x80, 0xaa, 0x40, 0xd9, 0x5e, 0xc4, 0xf2, 0x92, 0x3d, 0x43,
+        0x63, 0xb9, 0xbe, 0xc8, 0x74, 0xe2, 0xc3, 0xe6, 0x0e, 0xfa, 0xc8, 0xf5, 0x56, 0x49, 0x6b, 0x68,
+        0xf9, 0x2a, 0x2a, 0x54, 0x73, 0xac, 0x2c, 0xe0, 0xaa, 0x63, 0xec, 0x1f, 0x1c, 0xa8, 0x89, 0x93,
+        0x4e, 0x3f, 0x56, 0xc8, 0x22, 0x78, 0x36, 0xb8, 0x2e, 0xfc, 0xed, 0xc6, 0xf6, 0x0d, 0x19, 0xe5,
+        0xc6, 0xf4, 0x12, 0xe2, 0xfa, 0x29, 0xf7, 0xc9, 0x0b, 0x20, 0xfa, 0xe6, 0x09, 0x63, 0x5d, 0xde,
+        0x18, 0xbd, 0x07, 0x67, 0x89, 0x5f, 0x9c, 0x43, 0x56, 0x7f, 0x53, 0x8b, 0x97, 0x07, 0x59, 0x59,
+        0x1d, 0x1f, 0xa7, 0xef, 0x15, 0xe6, 0xa9, 0x2d, 0x35, 0x59, 0x4c, 0x5f, 0xee, 0xf8, 0x63, 0xc6,
+        0xa5, 0x1a, 0x25, 0x29, 0xf7, 0xb5, 0xac, 0x8b, 0x33, 0xb6, 0x2a, 0xee, 0x11, 0xa9, 0xc4, 0x83,
+        0xbd, 0x59, 0xea, 0x01, 0x76, 0x8d, 0xaf, 0x06, 0xc6, 0xfe, 0x09, 0x17, 0x40, 0xfc, 0xe5, 0x27,
+        0xce, 0x15, 0xfc, 0xae, 0xc2, 0xb5, 0x2c, 0x31, 0x2a, 0xdb, 0xa4, 0x27, 0x68, 0x59, 0xfb, 0xdb,
+        0x97, 0x28, 0x83, 0xe2, 0x4c, 0x61, 0x8d, 0x80, 0xf3, 0x1f, 0x82, 0xd1, 0xe7, 0xbf, 0x45, 0x12,
+        0x66, 0x88, 0xe0, 0x2e, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_12[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0xc1, 0x31, 0x01, 0x00, 0x00,
+        0x00, 0xc2, 0xa0, 0xf5, 0x4f, 0xed, 0x65, 0x0b, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+        0x1b, 0x79, 0x44, 0xa9, 0xe6, 0x40, 0x9c, 0x00, 0x00,
+    };
+
+    static const uint8_t stream_13[] = {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x01, 0xb8, 0x0b, 0x47, 0xf4, 0x63,
+        0x03, 0x47, 0x49, 0xcb, 0xf3, 0x43, 0x04, 0x0f, 0x4f, 0x01, 0x0a, 0x83, 0x8a, 0xcb, 0x4f, 0xb7,
+        0xf7, 0xa4, 0x82, 0xbb, 0x51, 0x61, 0xd6, 0x15, 0x4d, 0xa1, 0xd1, 0xfb, 0xe7, 0x94, 0x63, 0xd0,
+        0x53, 0xdd, 0x9e, 0xd8, 0x45, 0x9b, 0xda, 0xa5, 0x9f, 0x56, 0x91, 0x95, 0xea, 0x19, 0x60, 0xe1,
+        0x76, 0xa1, 0xc3, 0x80, 0x7f, 0x43, 0x57, 0xb4, 0x2d, 0x42, 0x74, 0xa0, 0xa9, 0x7c, 0x05, 0x46,
+        0x80, 0x56, 0x1c, 0xf4, 0x41, 0x69, 0xe2, 0xcc, 0xfe, 0xe9, 0x3e, 0x6b, 0x57, 0x4e, 0x06, 0x89,
+        0xb6, 0x85, 0x6a, 0xd9, 0xcf, 0x54, 0x1e, 0xd6, 0xf5, 0x60, 0xea, 0x40, 0x7b, 0x80, 0x98, 0xd6,
+        0xa9, 0xad, 0x30, 0x03, 0x8b, 0xa5, 0x4e, 0x3a, 0x84, 0xe0, 0x31, 0xb7, 0x09, 0xc8, 0x05, 0x8c,
+        0x36, 0x95, 0x82, 0x81, 0x23, 0x25, 0x45, 0xff, 0x13, 0x7a, 0xdb, 0xc9, 0x8a, 0xdb, 0xc4, 0xb9,
+        0x1e, 0x5c, 0x9d, 0x52, 0x87, 0xbd, 0x49, 0x55, 0x97, 0x85, 0x0a, 0x92, 0x58, 0xed, 0xbc, 0xaf,
+        0xdd, 0xaa, 0x6e, 0x01, 0x5f, 0xf9, 0x93, 0x1c, 0x3f, 0x0d, 0xb1, 0xe6, 0xbb, 0x00, 0x14, 0x85,
+        0xa2, 0x2b, 0xc7, 0x5d, 0x4b, 0xc1, 0x61, 0xd1, 0xef, 0x9f, 0x28, 0x53, 0x80, 0xfd, 0xd2, 0x25,
+        0xe9, 0x51, 0x59, 0x8e, 0x75, 0xf5, 0xfd, 0x95, 0x29, 0xa5, 0xe7, 0x52, 0x74, 0xf9, 0xb9, 0x9e,
+        0xad, 0xb4, 0xa5, 0x8b, 0x58, 0xb8, 0xe8, 0x80, 0x99, 0xde, 0x3b, 0x32, 0x5e, 0x33, 0x16, 0xd6,
+        0xec, 0x36, 0x38, 0x5f, 0xd2, 0xd9, 0x39, 0x81, 0xf6, 0xf5, 0x19, 0x1a, 0x49, 0xd4, 0x67, 0xf5,
+        0x01, 0x60, 0x38, 0x40, 0x55, 0xb3, 0xea, 0xf6, 0x6a, 0xbe, 0x9e, 0x34, 0x9b, 0xcd, 0x34, 0x06,
+        0x4c, 0x2e, 0x0f, 0x2b, 0x1c, 0xe7, 0xeb, 0xe8, 0xaf, 0x6c, 0xdc, 0x27, 0xf5, 0x8e, 0xd2, 0x8f,
+        0x96, 0x76, 0xd7, 0x13, 0x05, 0x98, 0x5c, 0xb6, 0x9f, 0xa2, 0x3b, 0x06, 0xbb, 0xb5, 0x10, 0x33,
+        0xb9, 0x06, 0x03, 0xfb, 0xc5, 0xe8, 0xba, 0x8f, 0x70, 0x3e, 0x4f, 0x59, 0xae, 0xe3, 0x1b, 0xaf,
+        0x98, 0x1e, 0x12, 0x67, 0xe0, 0x84, 0x2e, 0x1e, 0xd9, 0x2d, 0x97, 0xd5, 0x97, 0x23, 0x4b, 0x40,
+        0x86, 0xce, 0x9f, 0xea, 0x5c, 0x7e, 0x77, 0x7f, 0x9e, 0xf9, 0x2e, 0x24, 0x1a, 0x34, 0x2c, 0xfb,
+        0x09, 0x71, 0x96, 0x38, 0x30, 0xed, 0xc9, 0xc5, 0x89, 0x1b, 0x41, 0x60, 0xe7, 0xb9, 0x6b, 0x5e,
+        0xdd, 0xd7, 0xb4, 0xb6, 0x9b, 0xa1, 0x3d, 0x32, 0xab, 0xcc, 0x86, 0x89, 0xc6, 0xc9, 0xd1, 0xde,
+        0x01, 0x73, 0xf6, 0x39, 0x03, 0x25, 0x10, 0x93, 0xf6, 0xb9, 0xc4, 0x67, 0x49, 0xf6, 0xae, 0xf2,
+        0xb9, 0x45, 0x78, 0x6a, 0xf2, 0xcb, 0x7c, 0x6a, 0x2f, 0x33, 0x75, 0xde, 0xe0, 0x16, 0xe2, 0x49,
+        0x9a, 0x38, 0xde, 0xf4, 0xe2, 0x0b, 0x4f, 0x3c, 0x65, 0xc9, 0x88, 0x51, 0x4e, 0x09, 0x01, 0x88,
+        0xa6, 0x05, 0x45, 0xa0, 0x6f, 0xb6, 0x75, 0x99, 0xd1, 0x62, 0x28, 0x2d, 0xcf, 0xdd, 0xb5, 0x06,
+        0xac, 0xeb, 0xdc, 0xd7, 0x6f, 0xe3, 0x7f, 0x29, 0xf8, 0xee, 0xb1, 0x7c, 0x91, 0x16, 0xaf, 0xa4,
+        0x6e, 0xe6, 0xf3, 0x18, 0x32, 0x67, 0xc2, 0x3e, 0x7d, 0x8c, 0xb5, 0x14, 0xa8, 0xe8, 0xb3, 0xf5,
+        0x6e, 0xc5, 0x61, 0x69, 0x49, 0xa2, 0x71, 0x0c, 0x20, 0xa8, 0x24, 0xf9, 0xa1, 0xfc, 0xb5, 0x0f,
+        0x40, 0x64, 0xce, 0x2e, 0x30, 0x31, 0x2d, 0x9f, 0x5e, 0x01, 0x24, 0xb3, 0xd4, 0xf8, 0x60, 0xca,
+        0x88, 0x6e, 0x01, 0x27, 0xad, 0x39, 0x89, 0xb0, 0xf9, 0x73, 0x20, 0x86, 0x7d, 0xd5, 0x3c, 0x95,
+        0x1a, 0xa6, 0x4f, 0xc0, 0x40, 0xfb, 0x3b, 0x0e, 0x14, 0xb1, 0x86, 0x38, 0x8a, 0xf7, 0x73, 0x90,
+        0x49, 0x7e, 0x8c, 0x5a, 0xbc, 0x15, 0xcf, 0x2e, 0x24, 0x03, 0xf9, 0x80, 0x54, 0xc4, 0x7e, 0xa3,
+        0x72, 0x47, 0x46, 0x65, 0x34, 0x69, 0xf8, 0x60, 0x12, 0x30, 0x7f, 0x3f, 0x46, 0x18, 0xc4, 0x39,
+        0x61, 0xfe, 0xbd, 0xdb, 0x71, 0x7f, 0x67, 0x2d, 0xab, 0x4e, 0x50, 0x7e, 0x41, 0xff, 0xb4, 0x8c,
+        0xd1, 0x0f, 0x6b, 0xbf, 0xe5, 0xc7, 0x6f, 0x8b, 0xbc, 0x16, 0xd8, 0xf9, 0xb3, 0x16, 0xa0, 0x49,
+        0x89, 0x47, 0xcf, 0xca, 0x83, 0x79, 0x88, 0x93, 0x66, 0xba, 0x21, 0x9f, 0xfd, 0x8d, 0xfd, 0x09,
+        0xf9, 0xeb, 0xcb, 0x15, 0x90, 0x31, 0x9e, 0x7a, 0x34, 0x56, 0x5c, 0xdb, 0xd0, 0x1b, 0x05, 0x7a,
+        0xdb, 0xe4, 0x74, 0xdc, 0x46, 0x44, 0x42, 0x7d, 0x8e, 0x7f, 0xc0, 0x81, 0xdb, 0x39, 0x31, 0xc3,
+        0x00, 0x84, 0xfa, 0xb0, 0xf5, 0x7b, 0xfb, 0xd7, 0x36, 0x39, 0x3b, 0xd6, 0xee, 0x53, 0xd1, 0x83,
+        0x54, 0xa5, 0xed, 0x92, 0xad, 0xa9, 0xe1, 0xc8, 0x7e, 0x26, 0x46, 0x49, 0x47, 0x04, 0xa3, 0x2f,
+        0x4e, 0x25, 0x54, 0x7c, 0x3a, 0x74, 0x0d, 0x88, 0x01, 0x0e, 0x23, 0x3f, 0x46, 0x9d, 0x9b, 0x8a,
+        0x5c, 0x21, 0x06, 0x48, 0x39, 0xac, 0x5c, 0xae, 0xb4, 0x88, 0x8e, 0xed, 0x8a, 0x66, 0x73, 0x56,
+        0xa6, 0xdf, 0x38, 0xc0, 0xa8, 0xe1, 0xa5, 0x6c, 0x4e, 0x64, 0x2f, 0x4e, 0xb5, 0x8a, 0x37, 0xae,
+        0xc3, 0xe5, 0x66, 0x63, 0x2b, 0x96, 0xee, 0xd4, 0xeb, 0xad, 0x2a, 0xb4, 0x07, 0x21, 0x05, 0x4c,
+        0xa3, 0xa7, 0xfa, 0xfe, 0xe2, 0x86, 0x0f, 0x82, 0xb3, 0x2e, 0x12, 0xcb, 0xb7, 0x03, 0xa2, 0x15,
+        0x0e, 0x9b, 0x2a, 0xce, 0xb2, 0x39, 0x07, 0x2c, 0x87, 0xe5, 0x22, 0xc0, 0x83, 0xa4, 0xb5, 0x1b,
+        0xc1, 0x44, 0x79, 0xf1, 0x67, 0xf8, 0x8a, 0xb2, 0x81, 0xca, 0xf9, 0x6d, 0xc9, 0xdb, 0x0d, 0xd0,
+        0x11, 0xd2, 0xbe, 0xb3, 0x37, 0x50, 0x6d, 0x2d, 0x02, 0x3f, 0xfb, 0x0e, 0x53, 0xdb, 0x6c, 0x4d,
+        0xe4, 0xc9, 0xc2, 0xbb, 0x65, 0x9a, 0x11, 0xde, 0x5c, 0x9a, 0xc1, 0x01, 0x05, 0x96, 0x86, 0x04,
+        0x2d, 0x3a, 0x14, 0xb8, 0xfd, 0x24, 0x54, 0x9a, 0xa1, 0xe7, 0x72, 0xc5, 0xc8, 0xf4, 0xfb, 0xdd,
+        0xa2, 0xde, 0x27, 0xbc, 0x32, 0xa2, 0xa2, 0x2c, 0x42, 0xc1, 0xcd, 0xeb, 0x2c, 0x0a, 0xe7, 0x5b,
+        0x6d, 0x04, 0xae, 0x32, 0x4f, 0x54, 0x58, 0x45, 0xcb, 0x94, 0x9e, 0xd2, 0xb4, 0x56, 0x6d, 0x6a,
+        0xfe, 0xd6, 0xd3, 0x36, 0x7f, 0x0f, 0x98, 0xe0, 0x86, 0x79, 0xfa, 0xb1, 0xe3, 0xfa, 0xa8, 0x4d,
+        0xe5, 0x46, 0xa1, 0x99, 0xea, 0xdf, 0xa2, 0x2d, 0x23, 0xb1, 0xe4, 0xe1, 0x9f, 0x4d, 0x3d, 0xc0,
+        0xb1, 0xcb, 0x64, 0xd2, 0x85, 0x9c, 0xb9, 0x8a, 0x81, 0x71, 0xda, 0xd6, 0x52, 0x5c, 0xb1, 0x88,
+        0x6f, 0xe8, 0xe1, 0xb3, 0xaa, 0x4d, 0x92, 0x5a, 0x95, 0xad, 0x96, 0x5c, 0x89, 0xfd, 0x61, 0x4f,
+        0x1d, 0x5b, 0x28, 0x42, 0xec, 0x84, 0x2c, 0x1d, 0x03, 0x08, 0x38, 0xe8, 0xa1, 0xe8, 0x56, 0x0c,
+        0x27, 0x58, 0x75, 0xbe, 0x15, 0xdc, 0xfa, 0x68, 0x0f, 0x1b, 0x39, 0xef, 0x38, 0x8a, 0x61, 0xd7,
+        0x39, 0xad, 0x59, 0x92, 0xad, 0x2e, 0xe2, 0x0e, 0xe0, 0x13, 0x5e, 0xba, 0x76, 0x00, 0x11, 0xc6,
+        0x95, 0x4d, 0xfc, 0xe6, 0x5c, 0x2c, 0x8f, 0x76, 0xae, 0xf8, 0x7a, 0x96, 0xa4, 0xc5, 0xb0, 0x96,
+        0x38, 0x4b, 0xb4, 0x61, 0x6a, 0xea, 0xee, 0x26, 0x30, 0xcc, 0xaa, 0x56, 0xda, 0xba, 0x6a, 0xfd,
+        0xda, 0x54, 0x9e, 0x3d, 0xe8, 0x9f, 0x1b, 0x55, 0xcd, 0x3a, 0x7e, 0xfc, 0xa5, 0x41, 0x4c, 0x59,
+        0x0d, 0x2f, 0x58, 0x49, 0xff, 0xc4, 0x9e, 0x12, 0x1c, 0x1d, 0xb7, 0x52, 0x2f, 0xaa, 0x59, 0x6e,
+        0xeb, 0x9f, 0x73, 0x7e, 0x8f, 0xa3, 0x2a, 0x88, 0x5f, 0x0c, 0xdb, 0xdf, 0x35, 0xdb, 0x33, 0x84,
+        0x07, 0x04, 0x92, 0x46, 0xbd, 0x14, 0x2c, 0xb8, 0x9e, 0x0e, 0xf7, 0xcb, 0x94, 0x32, 0xe3, 0x10,
+        0x03, 0x1e, 0x8b, 0x72, 0x4b, 0x47, 0x26, 0x54, 0x68, 0x45, 0x94, 0xc9, 0x53, 0x8b, 0x64, 0x70,
+        0x3d, 0x8b, 0xd6, 0x5f, 0x99, 0xce, 0x80, 0xcb, 0xd1, 0x48, 0xae, 0xbe, 0x2c, 0x88, 0x6b, 0x76,
+        0x21, 0xcd, 0xdf, 0xf4, 0xc1, 0x50, 0x10, 0x09, 0x30, 0x26, 0x68, 0xa5, 0x22, 0xe8, 0x23, 0x8a,
+        0x9f, 0x13, 0x29, 0x91, 0xcb, 0x49, 0x99, 0xdb, 0x4f, 0xfc, 0xab, 0x00, 0xa3, 0xe7, 0xd7, 0x22,
+        0x97, 0x1a, 0x97, 0x45, 0x41, 0xd6, 0xf9, 0x15, 0x51, 0x29, 0x64, 0x0c, 0x76, 0xac, 0x0a, 0xa2,
+        0x50, 0x6a, 0xd5, 0x69, 0x17, 0x6a, 0x8a, 0xe2, 0xf5, 0xb5, 0x7f, 0x34, 0xb4, 0x66, 0x7d, 0x92,
+        0x44, 0xd2, 0x8c, 0x45, 0x77, 0xf9, 0xb9, 0xb6, 0x75, 0xad, 0x14, 0xc2, 0x9d, 0x3a, 0xe0, 0x0e,
+        0x15, 0xdf, 0x46, 0xc2, 0xe9, 0xd2, 0x9a, 0x13, 0x89, 0xf9, 0x2d, 0x74, 0x09, 0xa7, 0x5b, 0x63,
+        0xde, 0x4e, 0x81, 0xd7, 0xf6, 0x24, 0x2b, 0xf1, 0xcd, 0xd3, 0x51, 0x68, 0x5f, 0x36, 0x11, 0x99,
+        0x84, 0xf3, 0xf4, 0x38, 0xd5, 0x49, 0xf4, 0x1d, 0xc5, 0x66, 0xb3, 0x2b, 0x5c, 0x67, 0x17, 0xc3,
+        0x0d, 0x57, 0x1e, 0xec, 0x5e, 0x49, 0x57, 0x99, 0x03, 0xd2, 0x8a, 0x79, 0x93, 0x1d, 0x89, 0x93,
+        0x70, 0x21, 0x75, 0x91, 0xa5, 0x52, 0xc7, 0xd8, 0xe4, 0xd5, 0x6e, 0x9e, 0xae, 0x08, 0x78, 0x0d,
+        0xa0, 0x73, 0x4c, 0xf5, 0x51, 0xcd, 0xb9, 0x0e, 0x37, 0x26, 0x17, 0x35, 0xea, 0x91, 0x35, 0x6e,
+        0x41, 0xa6, 0x02, 0xc9, 0x11, 0xa1, 0xc5, 0xdd, 0x27, 0xc1, 0x3f, 0xec, 0x20, 0x25, 0x1e, 0x6e,
+        0xb9, 0xfb, 0xc8, 0x12, 0x43, 0xd4, 0x65, 0xaf, 0xab, 0x78, 0xe0, 0xb0, 0x8d, 0xab, 0x0a, 0x08,
+        0x83, 0xbb, 0xc4, 0xed, 0x1c, 0xfb, 0x30, 0xfe, 0x06, 0x1f, 0xd3, 0x6b, 0xfd, 0x91, 0xcd, 0xbd,
+        0xd3, 0xc1, 0x2f, 0xb7, 0x0d, 0x9b, 0x58, 0x10, 0x1f, 0x55, 0xe0, 0x14, 0xf9, 0xad, 0xb3, 0x2e,
+        0x13, 0xae, 0xd2, 0x20, 0x5f, 0x05, 0x48, 0x38, 0xb7, 0x91, 0x20, 0xc8, 0x30, 0x61, 0xe5, 0x37,
+        0x45, 0xec, 0x93, 0xfa, 0xe1, 0x35, 0x23, 0x1d, 0x5a, 0x7a, 0xbe, 0x92, 0xdc, 0xd5, 0x72, 0x39,
+        0x49, 0x5a, 0x14, 0x4e, 0x5c, 0x93, 0x8a, 0xda, 0xdf, 0x25, 0x6f, 0x0a, 0x37, 0xba, 0x60, 0xea,
+        0x98, 0x20, 0x99, 0x52, 0xe9, 0x02, 0x4c, 0x30, 0xef, 0xda, 0x4e, 0x41, 0xb6, 0x87, 0xe0, 0x35,
+        0x6c, 0xf1, 0xbc, 0x9d, 0x09, 0x45, 0xb6, 0x3a, 0x07, 0x57, 0x35, 0xdf, 0x6c, 0xa7, 0x01, 0xd5,
+        0x47, 0xdc, 0xf7, 0xb4, 0x98, 0xde, 0x03, 0xfe, 0x04, 0x4e, 0x2f, 0x83, 0x4d, 0xa7, 0x15, 0x91,
+        0x80, 0x6a, 0xf0, 0x32, 0xb1, 0x2f, 0x51, 0xac, 0x2f, 0xdc, 0x61, 0x14, 0x20, 0x40, 0x34, 0x24,
+        0xb8, 0x11, 0xcb, 0x61, 0xf3, 0xa4, 0x6b, 0x01, 0x4f, 0x8d, 0x0a, 0x2d, 0x1e, 0x82, 0x4f, 0x15,
+        0xf1, 0xad, 0x3e, 0x66, 0x36, 0x3f, 0xe6, 0x60, 0x56, 0x89, 0x91, 0x46, 0xec, 0x41, 0x4b, 0x30,
+        0xf8, 0x49, 0x1c, 0xb8, 0x45, 0x5e, 0x01, 0x4f, 0xd8, 0xa1, 0xd2, 0x80, 0x43, 0x7e, 0x91, 0x26,
+        0x13, 0x2a, 0x72, 0xdb, 0x2b, 0x2a, 0x45, 0xee, 0xd4, 0xcc, 0xa2, 0xa0, 0x0c, 0xc7, 0xca, 0xe2,
+        0x6d, 0x0c, 0x0c, 0x7c, 0xd9, 0xae, 0x91, 0x5b, 0xcd, 0xcc, 0x41, 0x61, 0x97, 0x09, 0x6c, 0x1d,
+        0xb9, 0x7f, 0xa6, 0x6b, 0x5b, 0x6f, 0xa6, 0xcd, 0xaa, 0x66, 0x3c, 0xae, 0x30, 0xcd, 0xc0, 0xb4,
+        0xc7, 0xed, 0x52, 0x0b, 0x94, 0x08, 0xbc, 0x4c, 0xbc, 0xbf, 0x78, 0x51, 0x5f, 0x56, 0xc0, 0x32,
+        0x25, 0x84, 0xef, 0x52, 0x08, 0x15, 0xd8, 0x06, 0xe8, 0x90, 0x59, 0xce, 0x46, 0xc8, 0x3f, 0x82,
+        0x12, 0xb6, 0x8f, 0xab, 0xb4, 0x3c, 0x25, 0x5b, 0xaf, 0xaa, 0x8a, 0x35, 0xe3, 0xc2, 0x42, 0x0c,
+        0xca, 0xc2, 0x30, 0xe4, 0xfa, 0x0a, 0x75, 0x9c, 0x2b, 0xb5, 0xbf, 0x49, 0xce, 0xe6, 0x21, 0xb7,
+        0x35, 0xf0, 0xe0, 0x22, 0x55, 0x9d, 0xce, 0x8a, 0xad, 0xde, 0xcd, 0x8c, 0x9a, 0x67, 0xbc, 0xb8,
+        0x66, 0xa7, 0x39, 0xae, 0xcb, 0xef, 0x7c, 0xb4, 0xdc, 0xc5, 0xae, 0x60, 0x50, 0xe0, 0xed, 0xc1,
+        0x35, 0xa6, 0x42, 0xc8, 0x56, 0xb7, 0xab, 0x9f, 0xc5, 0xa4, 0xe0, 0x22, 0xdd, 0x78, 0xab, 0xc9,
+        0x3e, 0x89, 0x0b, 0xcf, 0xed, 0x49, 0x30, 0x03, 0x60, 0xd0, 0xd7, 0x2d, 0xca, 0xa2, 0x3b, 0xfe,
+        0xb1, 0x7e, 0x4a, 0xc4, 0xc0, 0x48, 0x52, 0x20, 0x96, 0xac, 0x21, 0x5d, 0xcd, 0x20, 0x92, 0xf8,
+        0x63, 0x46, 0xb7, 0x8d, 0x16, 0x32, 0xea, 0x81, 0x6a, 0xd1, 0x42, 0xfa, 0xdb, 0x5c, 0xd1, 0x9b,
+        0x7d, 0x10, 0x66, 0x71, 0x19, 0x8e, 0xc1, 0x63, 0xc7, 0xe6, 0x43, 0x2e, 0x8b, 0x27, 0x63, 0x4e,
+        0x82, 0x22, 0x0e, 0x03, 0x12, 0xb1, 0x12, 0x28, 0x2e, 0x2a, 0xc0, 0x55, 0xf4, 0xca, 0xe4, 0x29,
+        0xfb, 0x40, 0xb5, 0x87, 0xff, 0x2c, 0x1e, 0x00, 0x3d, 0xef, 0x60, 0xfc, 0x1d, 0x54, 0xc7, 0x89,
+        0xd6, 0xe7, 0x84, 0xd8, 0xca, 0xd4, 0x52, 0x78, 0xae, 0x99, 0x95, 0xb4, 0xda, 0x49, 0xb6, 0x0c,
+        0xe1, 0x6f, 0xa9, 0x8c, 0x5e, 0x8d, 0xfa, 0xc8, 0x1c, 0x30, 0xc4, 0x15, 0x11, 0x2d, 0x41, 0xf9,
+        0x3e, 0xeb, 0x7d, 0xa0, 0xa0, 0xde, 0x62, 0x4b, 0x98, 0x44, 0x45, 0xcb, 0x6f, 0x2b, 0xed, 0x59,
+        0xdb, 0x65, 0x82, 0xf4, 0x41, 0x69, 0x75, 0x5a, 0x11, 0x40, 0xbd, 0x74, 0x1d, 0xc3, 0x7f, 0xf0,
+        0x97, 0x4c, 0x63, 0x7a, 0xaf, 0x8e, 0xbe, 0x22, 0x68, 0xbc, 0x1e, 0xd4, 0xda, 0xf4, 0x1a, 0xf0,
+        0x15, 0x63, 0xfb, 0x53, 0xe0, 0xe1, 0x85, 0xfa, 0xe6, 0x67, 0x94, 0xe4, 0x52, 0x6e, 0xf2, 0xc6,
+        0xb5, 0xb9, 0x84, 0x1c, 0xf2, 0x99, 0x9e, 0x04, 0x45, 0x15, 0x35, 0x19, 0xe6, 0x28, 0x6e, 0x0d,
+        0x89, 0x13, 0x18, 0xef, 0xd1, 0xe6, 0x02, 0xbc, 0xc0, 0xe8, 0xd9, 0xab, 0xb2, 0xf2, 0xaa, 0xe0,
+        0x8e, 0xce, 0x24, 0xad, 0x68, 0x9f, 0xa4, 0xa9, 0x5c, 0xe4, 0xda, 0x6e, 0x92, 0xf2, 0x6a, 0xd2,
+        0x99, 0xc2, 0x64, 0xf9, 0x59, 0x4d, 0x02, 0x65, 0x99, 0x67, 0xf4, 0x72, 0xac, 0x80, 0x1f, 0x24,
+        0x3d, 0x7d, 0xc7, 0x97, 0x09, 0x56, 0xed, 0x59, 0x5e, 0x1b, 0x21, 0x4c, 0xc6, 0x6b, 0x4e, 0x80,
+        0xb5, 0xa8, 0xb3, 0x3d, 0xda, 0x6e, 0xa4, 0x8d, 0x94, 0x0d, 0x34, 0xea, 0xe8, 0x10, 0xf1, 0x40,
+        0x97, 0xae, 0x68, 0x58, 0x13, 0x37, 0xd5, 0xe2, 0xba, 0xe6, 0x93, 0xd9, 0x5d, 0x10, 0xa8, 0x81,
+        0x17, 0x07, 0xbf, 0xb7, 0x92, 0xc6, 0xdc, 0xa3, 0x1d, 0xd2, 0x1a, 0x51, 0xd4, 0x9f, 0xd4, 0xff,
+        0xd6, 0xc9, 0x87, 0x6d, 0xee, 0xc9, 0x7a, 0xaf, 0xb8, 0xb2, 0xcd, 0x32, 0xc4, 0x4d, 0xd8, 0x0a,
+        0x36, 0x20, 0x73, 0xb5, 0xeb, 0xd2, 0x8a, 0x68, 0x11, 0x13, 0xc2, 0x64, 0xec, 0xc9, 0xc6, 0x20,
+        0x13, 0xe2, 0x75, 0x82, 0x9a, 0x5f, 0x41, 0xc4, 0x32, 0xf7, 0xeb, 0xf8, 0x1d, 0x98, 0x58, 0x5a,
+        0x99, 0xca, 0x35, 0xaf, 0x08, 0xc3, 0x91, 0x67, 0xd1, 0x7e, 0xe9, 0x1e, 0x1c, 0x8b, 0x8e, 0x4c,
+        0x3c, 0xce, 0x7e, 0x7b, 0xe9, 0xe8, 0xf2, 0xd3, 0x48, 0xc0, 0x39, 0xc4, 0xa7, 0xea, 0x1b, 0x53,
+        0x7e, 0xc2, 0x53, 0x15, 0x2e, 0x51, 0x66, 0x18, 0xc0, 0x7c, 0xe7, 0xbb, 0x69, 0xc6, 0x50, 0xc9,
+        0xbd, 0x56, 0x5a, 0x4c, 0xef, 0x29, 0x81, 0xf9, 0x60, 0xbb, 0x63, 0x38, 0x4d, 0x63, 0xb6, 0x46,
+        0x7b, 0x18, 0x31, 0xd2, 0x93, 0xd9, 0x79, 0x06, 0x70, 0xb5, 0x2b, 0x7f, 0xb1, 0xdc, 0xae, 0x46,
+        0xc6, 0x21, 0x86, 0xd6, 0x6f, 0x77, 0x57, 0x61, 0x3d, 0x2d, 0xf5, 0x6e, 0x22, 0x8f, 0xbf, 0x45,
+        0x36, 0xaa, 0x21, 0x62, 0x65, 0x62, 0x7c, 0x95, 0xd2, 0xa0, 0x12, 0x88, 0x32, 0x56, 0x97, 0x86,
+        0xa8, 0xfe, 0xc5, 0x6e, 0xaf, 0x28, 0x4a, 0x1c, 0x9f, 0x67, 0x2e, 0xce, 0xea, 0xa9, 0x50, 0x66,
+        0x29, 0x65, 0x92, 0x85, 0x0c, 0x3c, 0x4b, 0xfb, 0x29, 0x93, 0x97, 0xcc, 0xec, 0xbe, 0x5a, 0x9f,
+        0xf1, 0xef, 0xdd, 0xbd, 0x09, 0xa2, 0xec, 0xe6, 0x80, 0x12, 0x63, 0xc5, 0x7a, 0x41, 0x14, 0xe0,
+        0x10, 0x40, 0x75, 0xe9, 0x7f, 0xe5, 0x41, 0xb4, 0x19, 0x3e, 0x43, 0x84, 0xd0, 0x81, 0xa2, 0x5b,
+        0xbd, 0xdd, 0x4e, 0x96, 0x80, 0x74, 0xb8, 0x23, 0x89, 0x1e, 0x91, 0x92, 0x35, 0x6a, 0x6d, 0x07,
+        0x67, 0xc5, 0x71, 0x72, 0x1d, 0x48, 0x89, 0xe5, 0xbf, 0xb0, 0x58, 0x04, 0x4b, 0xb1, 0xf8, 0x1d,
+        0xe2, 0xd0, 0xbc, 0x8f, 0x53, 0xdf, 0x69, 0xf7, 0x5b, 0x6c, 0x90, 0x5f, 0x36, 0xb5, 0x73, 0xeb,
+        0xd4, 0x51, 0x65, 0xac, 0xb1, 0x51, 0x5c, 0xce, 0x29, 0x82, 0x46, 0xb4, 0x4f, 0x46, 0x78, 0xa2,
+        0x07, 0xfd, 0xe3, 0xba, 0xd7, 0x91, 0xc3, 0x8d, 0x92, 0x86, 0x24, 0xaf, 0x96, 0x7d, 0x04, 0xd9,
+        0x32, 0xa0, 0xb0, 0xe5, 0x23, 0x8e, 0xe5, 0xd4, 0x04, 0xb8, 0x76, 0x38, 0x84, 0xf9, 0xd7, 0x3c,
+        0xc7, 0xa2, 0x35, 0x22, 0xd8, 0x07, 0x07, 0xdf, 0x8c, 0xdb, 0xe1, 0xb3, 0x91, 0x7a, 0xc0, 0xd7,
+        0xee, 0x36, 0xcc, 0xc5, 0x33, 0xf5, 0x58, 0x7e, 0xcb, 0x9b, 0x8b, 0x6a, 0x51, 0xfd, 0x3d, 0xef,
+        0xf5, 0x32, 0xf7, 0xb9, 0xc9, 0x7f, 0x48, 0x06, 0x8a, 0x05, 0x8e, 0x2d, 0xa1, 0x3e, 0x47, 0x69,
+        0x35, 0x69, 0xeb, 0xb8, 0xb5, 0x9d, 0x7a, 0xcc, 0xb3, 0x74, 0xd4, 0x9e, 0x36, 0x19, 0x0b, 0xd9,
+        0x84, 0xe7, 0x2a, 0xb2, 0xc6, 0xbd, 0xe9, 0x51, 0x03, 0x96, 0xa7, 0x28, 0x35, 0xcf, 0x33, 0x68,
+        0xed, 0x26, 0xd4, 0xf7, 0x70, 0xf6, 0xa5, 0x2a, 0x04, 0x93, 0xfe, 0xc2, 0x71, 0x1b, 0xe6, 0x03,
+        0x23, 0x94, 0x34, 0xee, 0x63, 0xc7, 0xb3, 0xfa, 0x5c, 0xb4, 0x67, 0xbf, 0x62, 0x48, 0x6d, 0x69,
+        0xd4, 0x1f, 0xa6, 0x04, 0x29, 0x99, 0xb9, 0x34, 0x79, 0x9d, 0x4a, 0x1c, 0xdd, 0xf2, 0x55, 0xfd,
+        0x2d, 0x1f, 0x25, 0xc5, 0x1e, 0x1b, 0x8e, 0x29, 0x47, 0x1a, 0xc8, 0xf4, 0x63, 0x8b, 0x70, 0xe2,
+        0xa2, 0xda, 0x96, 0x9b, 0x90, 0x39, 0xd4, 0x7c, 0x5a, 0x8f, 0x71, 0x17, 0xbe, 0x52, 0x1d, 0xbf,
+        0x55, 0xce, 0x74, 0xab, 0x14, 0x98, 0x69, 0xe0, 0x40, 0xdf, 0x7d, 0x5b, 0xc1, 0x20, 0x8b, 0x9e,
+        0xc6, 0x07, 0xee, 0x55, 0xe2, 0xe7, 0x00, 0xf2, 0x18, 0xa8, 0xbf, 0x5d, 0x80, 0x30, 0xec, 0x54,
+        0x4f, 0xb5, 0x0c, 0xb3, 0x57, 0x02, 0x93, 0x33, 0xc4, 0xfb, 0x0b, 0xee, 0x58, 0xe6, 0x3a, 0xaf,
+        0x89, 0x28, 0x17, 0xf5, 0x4f, 0x26, 0x68, 0x9e, 0x41, 0x66, 0xb9, 0xed, 0xb9, 0x85, 0xda, 0x42,
+        0x11, 0x48, 0xed, 0xf1, 0xaf, 0x04, 0xe0, 0xd8, 0x2e, 0x2e, 0x19, 0xe3, 0x79, 0x03, 0xd0, 0x7d,
+        0xe0, 0x0b, 0x80, 0x32, 0x53, 0x6e, 0x1a, 0x6d, 0x45, 0x6f, 0x6d, 0x0a, 0xef, 0xc8, 0xf3, 0xb1,
+        0xf6, 0x81, 0xb3, 0x22, 0x34, 0x66, 0xf9, 0xed, 0xad, 0x48, 0x8e, 0x2a, 0x0d, 0x48, 0x9e, 0xbf,
+        0x95, 0x76, 0xdc, 0x6b, 0xf0, 0xfe, 0xba, 0x80, 0x8a, 0x52, 0x12, 0x88, 0x14, 0x2a, 0x84, 0x08,
+        0xa9, 0xcb, 0x88, 0x73, 0x59, 0xb9, 0x87, 0x22, 0x89, 0x01, 0x92, 0xf7, 0x71, 0x63, 0x41, 0xa5,
+        0x21, 0xd9, 0x8a, 0xa2, 0xa7, 0x67, 0x89, 0xa1, 0x16, 0x4f, 0x41, 0x5e, 0x3f, 0xce, 0x98, 0x6d,
+        0xfa, 0x9e, 0x44, 0xae, 0x96, 0x3a, 0x74, 0xf7, 0x98, 0xef, 0x12, 0x79, 0xdc, 0xfc, 0x55, 0x9a,
+        0xca, 0x9c, 0x27, 0xbf, 0x0c, 0x7f, 0x9c, 0x1b, 0x37, 0x17, 0xf4, 0x8e, 0x4f, 0x0f, 0x8d, 0xa4,
+        0xd9, 0x5c, 0xb8, 0xe5, 0x38, 0xf6, 0x00, 0x37, 0xfb, 0xc9, 0xa0, 0xba, 0x5d, 0x0a, 0x7e, 0xb0,
+        0xa7, 0x9d, 0x07, 0x01, 0x59, 0x04, 0xa6, 0x4e, 0x55, 0xf4, 0xd9, 0xbd, 0xe5, 0xfe, 0x59, 0xb8,
+        0x18, 0x21, 0x77, 0x0b, 0xd9, 0xfa, 0x3b, 0x18, 0x7b, 0x43, 0xe0, 0xb1, 0x1c, 0x5a, 0x8f, 0xda,
+        0x6a, 0xce, 0xdd, 0x3d, 0xe3, 0xc9, 0xa9, 0x1c, 0x5a, 0xc0, 0x50, 0x9f, 0x92, 0x4f, 0x40, 0x4b,
+        0x31, 0x0a, 0xbb, 0x82, 0x65, 0x65, 0x9e, 0x8f, 0x5d, 0x50, 0x64, 0xeb, 0xb8, 0x48, 0xe4, 0x21,
+        0x3b, 0x5f, 0xb0, 0x92, 0xbc, 0x89, 0x7d, 0xa3, 0x2e, 0x79, 0x30, 0xca, 0x2a, 0x11, 0x3d, 0x25,
+        0x72, 0x91, 0x10, 0x40, 0x6b, 0xfd, 0x3c, 0x8f, 0x80, 0xb0, 0x73, 0x10, 0x91, 0xac, 0x56, 0x72,
+        0x70, 0x61, 0xd2, 0xe5, 0xb3, 0xa5, 0x38, 0xc3, 0xdf, 0x4b, 0x3b, 0x9a, 0x3d, 0x0b, 0xb0, 0x37,
+        0x9a, 0x76, 0x99, 0xe0, 0x49, 0xb9, 0x3f, 0xc6, 0x90, 0x2b, 0x59, 0x99, 0x27, 0x24, 0xb2, 0x6f,
+        0x7b, 0x82, 0x92, 0xe5, 0x01, 0x3d, 0x7f, 0x88, 0x08, 0xc2, 0xbd, 0x72, 0xdd, 0xdc, 0xdd, 0x07,
+        0x9a, 0xc9, 0x47, 0x3f, 0x43, 0xf6, 0xc6, 0x03, 0x5b, 0x45, 0xa4, 0x24, 0x12, 0xdf, 0x16, 0x33,
+        0x18, 0x21, 0xf4, 0x5f, 0x35, 0x91, 0x8d, 0x72, 0xd1, 0x81, 0xca, 0xe9, 0x2f, 0xfb, 0xf1, 0xc4,
+        0x12, 0xc7, 0x05, 0x37, 0xad, 0xcb, 0x42, 0x84, 0xe5, 0x27, 0xbb, 0x88, 0x4f, 0x2e, 0xa6, 0x33,
+        0xb2, 0x59, 0x8e, 0x76, 0xf9, 0xac, 0x75, 0xac, 0x54, 0xd5, 0x51, 0x59, 0x82, 0xb9, 0x99, 0x88,
+        0x16, 0xa1, 0x79, 0x50, 0x34, 0x63, 0x4e, 0xca, 0x25, 0xc8, 0x8d, 0x90, 0x7a, 0x29, 0xde, 0x41,
+        0xdc, 0x0a, 0xb7, 0x0f, 0x32, 0xec, 0x12, 0xa4, 0x6e, 0x5b, 0xa6, 0x99, 0xe5, 0xb3, 0x1b, 0x65,
+        0x63, 0x0f, 0x7d, 0x59, 0x47, 0x35, 0x05, 0x2e, 0x75, 0x86, 0xda, 0x1e, 0xbf, 0x27, 0x33, 0x64,
+        0xb2, 0x5d, 0x2c, 0xef, 0xee, 0x72, 0xf9, 0xcc, 0x8b, 0x77, 0xbe, 0xf0, 0xf6, 0xda, 0xa2, 0xf3,
+        0xb5, 0x8b, 0xbf, 0x33, 0xc2, 0x6e, 0x3c, 0x74, 0x3b, 0x49, 0xf6, 0xac, 0x1a, 0xe7, 0x7c, 0x95,
+        0xc6, 0x75, 0xbe, 0x85, 0x52, 0x1d, 0x0c, 0xc3, 0x04, 0xaf, 0xf2, 0xd4, 0xc0, 0x87, 0xf4, 0xe7,
+        0x28, 0x22, 0x9e, 0x2f, 0x91, 0xff, 0xb2, 0x09, 0x33, 0x30, 0x9e, 0xaa, 0x01, 0xfd, 0xf6, 0xd5,
+        0x8b, 0xe6, 0x9e, 0xb0, 0xd1, 0xa5, 0x7b, 0x17, 0x91, 0xd2, 0x83, 0x9d, 0x26, 0x61, 0x06, 0xb2,
+        0x35, 0xca, 0xc2, 0xef, 0x56, 0x6e, 0x58, 0x00, 0xde, 0x48, 0xd8, 0xb8, 0x0b, 0x00, 0x00,
+    };
+
+    /*
+     * text 5000 bytes seed 11 with FEXTRA, FNAME, FCOMMENT and FHCRC in the header
+     */
+    static const uint8_t stream_fields[] = {
+        0x1f, 0x8b, 0x08, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x05, 0x00, 0x61, 0x62, 0x63, 0x64,
+        0x65, 0x6e, 0x61, 0x6d, 0x65, 0x2e, 0x62, 0x69, 0x6e, 0x00, 0x63, 0x6f, 0x6d, 0x6d, 0x65, 0x6e,
+        0x74, 0x00, 0x12, 0x34, 0x7d, 0x58, 0x7d, 0x4c, 0x55, 0x65, 0x18, 0x97, 0x04, 0x2a, 0x1d, 0xe1,
+        0xa4, 0xa1, 0x51, 0x99, 0x38, 0xe7, 0x60, 0x03, 0x8b, 0x28, 0xb3, 0x80, 0x09, 0x52, 0x22, 0x42,
+        0xf9, 0x15, 0x8d, 0x89, 0x43, 0x73, 0x0d, 0xeb, 0x0a, 0xdc, 0xec, 0xe3, 0x0f, 0x5d, 0xa1, 0x7d,
+        0xf0, 0x51, 0xd4, 0xcc, 0x7f, 0xc4, 0x2d, 0x65, 0x99, 0xca, 0xc5, 0x4b, 0xd2, 0x68, 0x64, 0xd1,
+        0x4c, 0x0a, 0x33, 0x6a, 0xab, 0x56, 0x37, 0x65, 0x51, 0x6d, 0xac, 0x6b, 0x7a, 0xa7, 0x34, 0x6f,
+        0xe3, 0xc2, 0xa0, 0xa1, 0xd0, 0x39, 0xef, 0xd9, 0xf3, 0x3e, 0x1f, 0xf7, 0xbd, 0x77, 0x73, 0x7a,
+        0xee, 0x39, 0xef, 0xfb, 0x3c, 0xbf, 0xe7, 0xf7, 0xfb, 0x3d, 0xcf, 0x79, 0x8f, 0x2b, 0x3c, 0x53,
+        0x8d, 0x9b, 0xae, 0xce, 0xf9, 0x34, 0x75, 0xe7, 0xe1, 0xd7, 0x66, 0x54, 0xbf, 0xf7, 0x4a, 0x42,
+        0x4a, 0xf2, 0xad, 0x9e, 0xd6, 0x96, 0x19, 0x67, 0xb6, 0x05, 0xd6, 0x6d, 0xad, 0x4b, 0x5f, 0xfd,
+        0x40, 0xdb, 0x5c, 0x5f, 0x46, 0x62, 0xc6, 0xf2, 0xed, 0x4d, 0x65, 0x9d, 0xeb, 0xfc, 0xed, 0xbd,
+        0xf9, 0x39, 0xbe, 0x8e, 0x7f, 0xbc, 0x53, 0x7d, 0xa1, 0xbc, 0x86, 0x0b, 0xcd, 0xa1, 0xbf, 0x36,
+        0xa7, 0x1d, 0x78, 0xa3, 0x7d, 0x56, 0x6a, 0x76, 0xdd, 0xed, 0x37, 0xf2, 0x9a, 0x7b, 0x6e, 0xaa,
+        0xa8, 0xaa, 0xf9, 0xa4, 0xc5, 0x37, 0xea, 0x3a, 0x97, 0xd2, 0xd5, 0x3a, 0x3a, 0xfc, 0xe3, 0xc0,
+        0xec, 0xda, 0xec, 0xa2, 0xe9, 0xde, 0x5f, 0x6f, 0x78, 0x8f, 0xd4, 0x17, 0xfd, 0xc6, 0x02, 0xb5,
+        0x8d, 0x9f, 0xb8, 0xa7, 0xeb, 0x27, 0xb7, 0x7f, 0xf1, 0xee, 0xdd, 0x64, 0xbd, 0x8a, 0xed, 0x7e,
+        0xf4, 0xbf, 0xd2, 0xf6, 0x7f, 0x0b, 0x7d, 0x27, 0x8b, 0x33, 0x36, 0x5c, 0x1f, 0xcb, 0x2e, 0x5f,
+        0x7b, 0xbd, 0x69, 0xe5, 0xd3, 0xae, 0x8f, 0x4f, 0xf9, 0x9f, 0x9f, 0x57, 0x7f, 0xdf, 0xd7, 0x08,
+        0xf0, 0x87, 0x8e, 0xb6, 0xed, 0xfb, 0xdc, 0x43, 0xc7, 0xea, 0x5f, 0xdd, 0xb9, 0x38, 0x6e, 0x4d,
+        0xf2, 0xfc, 0xaa, 0x7d, 0xfd, 0x07, 0x73, 0x46, 0x36, 0x67, 0x2d, 0x61, 0x59, 0x31, 0x91, 0x83,
+        0xd9, 0x5e, 0xdb, 0xda, 0x5d, 0x79, 0xa9, 0x6d, 0x30, 0x3d, 0x2d, 0x6b, 0x4f, 0xc0, 0xb5, 0xb5,
+        0x26, 0xf0, 0x41, 0x7e, 0xda, 0x94, 0xb7, 0xa0, 0xb7, 0xff, 0xe1, 0x3e, 0xbc, 0x22, 0xa5, 0x7d,
+        0x53, 0x5e, 0x81, 0x41, 0x6a, 0x97, 0xb9, 0x17, 0xf5, 0xef, 0xb8, 0x32, 0xa7, 0x67, 0xe0, 0xce,
+        0xb7, 0x67, 0xba, 0xe7, 0x9e, 0xef, 0xbc, 0x7f, 0x61, 0xa9, 0xdf, 0x8e, 0x99, 0xf4, 0xe7, 0x9a,
+        0xcc, 0x82, 0xb1, 0x37, 0xbb, 0x2f, 0x2e, 0xda, 0xbb, 0x7e, 0xb2, 0x18, 0x51, 0x86, 0x13, 0x1a,
+        0x7e, 0xa7, 0xc5, 0x13, 0xfa, 0x30, 0x7b, 0x28, 0xf6, 0xc5, 0xbc, 0xce, 0x89, 0xf1, 0xa7, 0x16,
+        0xb2, 0x40, 0x40, 0x2b, 0x61, 0x60, 0x68, 0x05, 0xd7, 0xec, 0x70, 0x16, 0x96, 0x6e, 0x14, 0x0d,
+        0x62, 0xcc, 0xda, 0x7b, 0xd7, 0xc6, 0xc2, 0xf8, 0xf8, 0xd8, 0x2a, 0x11, 0x00, 0x36, 0x6d, 0xe8,
+        0x6d, 0xf8, 0xee, 0xa3, 0x9e, 0x4b, 0x57, 0x73, 0x2b, 0x96, 0xb7, 0x3c, 0xb7, 0x7e, 0x24, 0xa6,
+        0x31, 0xbd, 0x20, 0x61, 0xcb, 0xc9, 0x8b, 0xef, 0x6e, 0x14, 0xeb, 0x95, 0x4a, 0xb7, 0x25, 0xfb,
+        0xc3, 0xd3, 0x0a, 0x62, 0x6f, 0x3e, 0x53, 0xb3, 0xeb, 0x97, 0xc1, 0xe1, 0x23, 0xd5, 0x5f, 0x25,
+        0xae, 0xae, 0xce, 0x3c, 0xff, 0xf2, 0xfe, 0x2b, 0x9b, 0xba, 0x34, 0x08, 0x40, 0x45, 0xf2, 0x88,
+        0xed, 0x13, 0x1c, 0xd0, 0xb7, 0x28, 0xf8, 0x52, 0x26, 0xf1, 0x17, 0x45, 0x83, 0x95, 0x23, 0xad,
+        0x63, 0x5b, 0x32, 0x05, 0xce, 0x95, 0x8a, 0x57, 0xfd, 0xf4, 0x1a, 0xf3, 0x14, 0x8f, 0x5d, 0xa6,
+        0x4c, 0xc7, 0xa2, 0x36, 0x58, 0xba, 0x07, 0xa8, 0xdc, 0x50, 0x24, 0x0b, 0x23, 0x20, 0x43, 0x9d,
+        0x65, 0xa4, 0x2a, 0x34, 0x95, 0x58, 0x3c, 0xa0, 0x92, 0x12, 0xfb, 0x77, 0x1c, 0x68, 0x5a, 0xe5,
+        0x75, 0x3d, 0xe4, 0x0a, 0x3e, 0xf1, 0xfe, 0xb2, 0x5d, 0x71, 0x17, 0x18, 0x1c, 0xb1, 0x57, 0x2c,
+        0xd5, 0x45, 0xa2, 0x26, 0x9a, 0xe8, 0x72, 0xad, 0x42, 0xbc, 0xbe, 0x7a, 0x84, 0x99, 0xcc, 0xf6,
+        0xaf, 0xe2, 0x8a, 0x93, 0xa2, 0x6e, 0x11, 0x78, 0x8f, 0xf1, 0xc7, 0xa4, 0x45, 0x74, 0x2e, 0x8b,
+        0x33, 0xa0, 0x80, 0x3c, 0xc6, 0xf6, 0x61, 0x69, 0x8d, 0xdd, 0xa6, 0x38, 0x79, 0xdc, 0x46, 0x44,
+        0x6e, 0xce, 0x64, 0x7e, 0xb6, 0x1f, 0x92, 0x7e, 0x80, 0xbe, 0x11, 0x0c, 0x61, 0x52, 0x61, 0x0b,
+        0x67, 0x0e, 0x68, 0xc6, 0x10, 0x05, 0xd1, 0x0c, 0x69, 0xb4, 0x2a, 0x1a, 0x06, 0xe5, 0x63, 0x22,
+        0xb1, 0x6e, 0xe0, 0x8d, 0x00, 0x0c, 0xeb, 0x3f, 0x7d, 0x81, 0xa3, 0x80, 0xe4, 0x26, 0x75, 0x0b,
+        0xe4, 0xa2, 0x42, 0xb2, 0x87, 0x5c, 0x12, 0xc1, 0xc4, 0xfa, 0xe8, 0xd1, 0x2e, 0x9b, 0xc7, 0x80,
+        0x2a, 0x86, 0xb6, 0x41, 0x8c, 0xd8, 0xa7, 0x3d, 0x25, 0xc2, 0x77, 0x10, 0x4c, 0x7a, 0x0d, 0xf2,
+        0x4a, 0xf8, 0x51, 0xf3, 0x24, 0x65, 0x50, 0xc4, 0xad, 0x04, 0x5d, 0x01, 0x57, 0x37, 0xf0, 0x68,
+        0xeb, 0xcf, 0x8c, 0x24, 0x32, 0xb3, 0xbe, 0x99, 0x46, 0x7d, 0x2b, 0xf0, 0x0d, 0x00, 0xa3, 0x1b,
+        0x05, 0xe0, 0x55, 0x7f, 0xf9, 0xc7, 0xbc, 0xbf, 0x51, 0xa5, 0x90, 0x42, 0x48, 0x49, 0x20, 0xb5,
+        0x3d, 0x89, 0x46, 0xb3, 0xbc, 0x82, 0xd9, 0x18, 0xc2, 0x88, 0x66, 0x2c, 0x21, 0xaf, 0xd3, 0x78,
+        0xc2, 0x09, 0xab, 0x81, 0x66, 0x16, 0x16, 0x24, 0x6a, 0x63, 0x6a, 0x23, 0xcb, 0x50, 0x72, 0xa4,
+        0x24, 0x89, 0xb0, 0xe0, 0x2d, 0x0c, 0x04, 0x8c, 0x2b, 0x90, 0x6c, 0xee, 0x89, 0x32, 0x60, 0xaf,
+        0xea, 0xde, 0x9f, 0xc5, 0x43, 0x9c, 0xdb, 0x9f, 0x23, 0xdf, 0x42, 0xed, 0x92, 0x20, 0xe3, 0xcb,
+        0x8b, 0x18, 0x22, 0xbc, 0xcd, 0x93, 0x30, 0xaa, 0x16, 0x8a, 0x4d, 0x89, 0xc9, 0x51, 0x01, 0x43,
+        0x61, 0xc3, 0x41, 0xf9, 0xbb, 0x71, 0x9e, 0x1b, 0xa7, 0xc1, 0xd9, 0xf9, 0x86, 0x9e, 0x80, 0x92,
+        0xf3, 0x1d, 0xf1, 0x90, 0x73, 0x78, 0x90, 0x03, 0x06, 0x7e, 0x01, 0x9f, 0x61, 0xf8, 0x69, 0x98,
+        0x93, 0x44, 0xc1, 0x8c, 0x38, 0x45, 0xb4, 0x6d, 0x50, 0x75, 0x91, 0x40, 0x9e, 0x11, 0x38, 0x10,
+        0x17, 0x12, 0x61, 0x50, 0xa4, 0xe7, 0x14, 0xd9, 0x2a, 0x06, 0x9e, 0xbe, 0xa0, 0x53, 0x3b, 0xfa,
+        0xa8, 0xc0, 0xb8, 0xdf, 0x5b, 0x6b, 0xf5, 0xeb, 0x42, 0x07, 0x20, 0xe0, 0xb8, 0x08, 0x28, 0x12,
+        0x2a, 0x6f, 0x6f, 0x77, 0x20, 0x85, 0xe7, 0x15, 0xee, 0xf6, 0x3a, 0xeb, 0x40, 0x29, 0x9d, 0xcf,
+        0xab, 0xd2, 0xcf, 0x56, 0x7f, 0x0b, 0xa8, 0x56, 0xcc, 0x60, 0x28, 0x00, 0x14, 0x31, 0x6d, 0x53,
+        0xd5, 0x7a, 0x32, 0x5e, 0xd3, 0xd8, 0x63, 0xc2, 0x18, 0xf3, 0xa2, 0x1e, 0x5e, 0xb4, 0x0d, 0x8f,
+        0x81, 0x7c, 0xe3, 0xca, 0x56, 0xdc, 0x1f, 0x74, 0x61, 0x4a, 0x2c, 0x4b, 0x22, 0x0a, 0xa4, 0x2b,
+        0x6d, 0x5e, 0xd0, 0x29, 0x50, 0x41, 0xb7, 0xe1, 0x45, 0x22, 0x48, 0x53, 0x08, 0x9e, 0x65, 0x7d,
+        0x12, 0x76, 0xca, 0xba, 0x96, 0x44, 0xea, 0x2e, 0x3d, 0xca, 0x44, 0xc2, 0xa4, 0x84, 0x02, 0xc3,
+        0xc1, 0x73, 0x81, 0xa0, 0xfa, 0x32, 0x8b, 0xa2, 0xc8, 0xb5, 0x6b, 0xd0, 0xb9, 0x49, 0xc6, 0x5b,
+        0x18, 0x09, 0x60, 0x5c, 0xed, 0xc4, 0x49, 0xca, 0x83, 0xc9, 0xce, 0xf4, 0x1b, 0x21, 0x82, 0x4c,
+        0xe2, 0xc8, 0xc0, 0xe8, 0x60, 0x0b, 0xef, 0xc6, 0x04, 0xd1, 0x0e, 0x5c, 0x13, 0x71, 0x0c, 0x33,
+        0xfb, 0x11, 0x7e, 0x84, 0x27, 0xa8, 0x10, 0x35, 0x78, 0xa4, 0x4e, 0x17, 0xca, 0x80, 0xb0, 0x90,
+        0xb0, 0xd6, 0x71, 0x36, 0x05, 0x82, 0xc9, 0x8e, 0xeb, 0x38, 0x94, 0x2f, 0x53, 0x17, 0xb2, 0x3c,
+        0x95, 0xa2, 0xcc, 0x08, 0x07, 0x26, 0x50, 0x65, 0x9b, 0x0e, 0x58, 0xad, 0x9c, 0x25, 0x76, 0x8b,
+        0x9f, 0xac, 0x08, 0xc2, 0xff, 0x59, 0x11, 0x9d, 0xf8, 0xc8, 0x69, 0x6a, 0x66, 0x9e, 0x66, 0xe7,
+        0x1e, 0x20, 0xd3, 0x2d, 0x67, 0xf8, 0x5a, 0x3b, 0xe7, 0xe1, 0xcd, 0x26, 0xf0, 0xf8, 0x8f, 0x0a,
+        0x97, 0xa2, 0xda, 0x4b, 0xed, 0x68, 0x86, 0xd7, 0x06, 0x50, 0x6f, 0x8d, 0x0e, 0x07, 0xc6, 0x3b,
+        0xaa, 0xee, 0xc2, 0xfd, 0x27, 0x8c, 0x34, 0x1f, 0xda, 0x81, 0x21, 0xa7, 0x48, 0x59, 0x8d, 0x6a,
+        0x97, 0x40, 0xcb, 0x94, 0x54, 0xda, 0xa2, 0x9c, 0x6a, 0xc6, 0x43, 0xc9, 0xaf, 0x9b, 0x2d, 0x2e,
+        0xc2, 0x1d, 0x0a, 0xe6, 0x8a, 0x3b, 0xb9, 0x2a, 0x0a, 0x23, 0x73, 0x4f, 0xf4, 0x83, 0x9e, 0x82,
+        0xb9, 0x60, 0x6d, 0x20, 0xfc, 0x8d, 0x55, 0x02, 0x6e, 0xd6, 0x3e, 0x23, 0x48, 0x2c, 0x76, 0x28,
+        0x1d, 0xe6, 0x8e, 0x25, 0xeb, 0x93, 0x74, 0x10, 0xd3, 0x27, 0x7b, 0x84, 0xc3, 0x14, 0x97, 0x16,
+        0x70, 0x91, 0xa8, 0x59, 0xa2, 0x36, 0xe2, 0x38, 0xe7, 0x73, 0xc5, 0x66, 0xc3, 0x82, 0x4a, 0x74,
+        0x21, 0xe1, 0x69, 0x56, 0x18, 0x70, 0xf5, 0x08, 0x0a, 0xb4, 0x20, 0x12, 0x61, 0x66, 0xc3, 0x07,
+        0x12, 0x0d, 0x87, 0x51, 0xb4, 0x79, 0x05, 0x63, 0xd6, 0x4f, 0xeb, 0x8f, 0xb0, 0x6b, 0x50, 0xa9,
+        0x81, 0x23, 0xe3, 0x25, 0xf5, 0x9b, 0x40, 0xb6, 0xb6, 0x00, 0xd2, 0xd0, 0x1d, 0x4c, 0x66, 0x55,
+        0x2a, 0x50, 0xc4, 0x81, 0x85, 0xf5, 0xd1, 0x83, 0x08, 0xef, 0x33, 0x4c, 0x06, 0x9b, 0x41, 0x76,
+        0x42, 0xa6, 0x47, 0x1d, 0x42, 0xb0, 0xfa, 0xd3, 0xc8, 0x49, 0xc4, 0xb3, 0x01, 0x2d, 0x56, 0x67,
+        0xbe, 0x17, 0x37, 0xea, 0x7b, 0x90, 0x97, 0x35, 0x87, 0x0f, 0x50, 0x40, 0x3b, 0x16, 0x9b, 0xfe,
+        0xdb, 0x81, 0xe8, 0xaa, 0x04, 0x39, 0x0d, 0xa5, 0xc2, 0xbf, 0x2c, 0x66, 0x93, 0x7d, 0x5a, 0x61,
+        0x77, 0xd0, 0xf4, 0xcf, 0x90, 0x6a, 0x57, 0x11, 0xc2, 0x81, 0x6d, 0x35, 0x2d, 0xa2, 0xcf, 0x3e,
+        0xc3, 0x77, 0x5c, 0x2d, 0x12, 0x8d, 0xa9, 0xc4, 0x36, 0x76, 0xaa, 0xee, 0x73, 0xca, 0xfd, 0x1f,
+        0xe1, 0xce, 0x6d, 0x30, 0x88, 0x13, 0x00, 0x00,
+    };
+
+    static const test_stream_t test_streams[] = {
+        { "text", 0, 7, 0, sizeof( stream_0 ), stream_0 },
+        { "text", 0, 7, 1, sizeof( stream_1 ), stream_1 },
+        { "text", 0, 7, 9, sizeof( stream_2 ), stream_2 },
+        { "text", 1, 7, 0, sizeof( stream_3 ), stream_3 },
+        { "text", 1, 7, 1, sizeof( stream_4 ), stream_4 },
+        { "text", 1, 7, 9, sizeof( stream_5 ), stream_5 },
+        { "text", 100, 7, 0, sizeof( stream_6 ), stream_6 },
+        { "text", 100, 7, 1, sizeof( stream_7 ), stream_7 },
+        { "text", 100, 7, 9, sizeof( stream_8 ), stream_8 },
+        { "text", 12000, 7, 1, sizeof( stream_9 ), stream_9 },
+        { "text", 12000, 7, 6, sizeof( stream_10 ), stream_10 },
+        { "text", 12000, 7, 9, sizeof( stream_11 ), stream_11 },
+        { "zero", 40000, 0, 9, sizeof( stream_12 ), stream_12 },
+        { "rand", 3000, 3, 9, sizeof( stream_13 ), stream_13 },
+    };
+
+#endif // _STREAMS_H
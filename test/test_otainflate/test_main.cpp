@@ -0,0 +1,259 @@
+/****************************************************************************
+ *   Sep 26 19:05:21 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "hardware/otainflate.cpp"
+
+#include <unity.h>
+#include "streams.h"
+
+typedef std::vector< uint8_t > bytes_t;
+
+static bytes_t written;
+static size_t write_calls;
+static size_t max_write;
+static bool write_ok;
+
+static uint32_t test_random_state;
+
+static uint32_t test_random( void ) {
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+    return( test_random_state );
+}
+
+/*
+ * the same data as sample() in the script that made streams.h: zeros, random bytes
+ * or words from a small dictionary with some random bytes in between
+ */
+static bytes_t test_sample( const char *kind, size_t len, uint32_t seed ) {
+    bytes_t out;
+
+    test_random_state = seed;
+    if ( !strcmp( kind, "zero" ) ) {
+        out.resize( len, 0 );
+    }
+    else if ( !strcmp( kind, "rand" ) ) {
+        while( out.size() < len ) {
+            out.push_back( test_random() );
+        }
+    }
+    else {
+        std::vector< bytes_t > words;
+        for ( int i = 0 ; i < 32 ; i++ ) {
+            bytes_t word;
+            for ( size_t n = 3 + test_random() % 13 ; n > 0 ; n-- ) {
+                word.push_back( test_random() );
+            }
+            words.push_back( word );
+        }
+        while( out.size() < len ) {
+            uint32_t value = test_random();
+            if ( value % 4 ) {
+                out.insert( out.end(), words[ ( value >> 8 ) % 32 ].begin(), words[ ( value >> 8 ) % 32 ].end() );
+            }
+            else {
+                out.push_back( value >> 8 );
+            }
+        }
+        out.resize( len );
+    }
+    return( out );
+}
+
+static bool write_out( const uint8_t *data, size_t len ) {
+    written.insert( written.end(), data, data + len );
+    write_calls++;
+    max_write = std::max( max_write, len );
+    return( write_ok );
+}
+
+/*
+ * chunk 0 splits the stream at random like the tcp segments of an upload
+ */
+static bool inflate_stream( const uint8_t *gz, size_t gz_len, size_t chunk, const char **error = NULL ) {
+    otainflate_t *inflate = new otainflate_t;
+    bool ok = true;
+
+    written.clear();
+    write_calls = 0;
+    max_write = 0;
+    test_random_state = 1234;
+    otainflate_init( inflate, write_out );
+    for ( size_t pos = 0 ; pos < gz_len && ok ; ) {
+        size_t n = std::min( chunk ? chunk : 1 + test_random() % 5000, gz_len - pos );
+        ok = otainflate_feed( inflate, gz + pos, n );
+        pos += n;
+    }
+    ok = ok && otainflate_finish( inflate );
+    if ( error ) {
+        *error = inflate->error;
+    }
+    delete inflate;
+    return( ok );
+}
+
+static bool inflate_stream( const bytes_t &gz, size_t chunk, const char **error = NULL ) {
+    return( inflate_stream( gz.data(), gz.size(), chunk, error ) );
+}
+
+static void expect_error( const bytes_t &gz, const char *expected ) {
+    static const size_t chunks[] = { 0, 1, 4096 };
+    const char *error;
+
+    for ( auto chunk : chunks ) {
+        TEST_ASSERT_FALSE( inflate_stream( gz, chunk, &error ) );
+        TEST_ASSERT_EQUAL_STRING( expected, error );
+    }
+}
+
+void setUp( void ) {
+    write_ok = true;
+}
+
+void tearDown( void ) {
+}
+
+/*
+ * stored, fixed and dynamic huffman blocks, long zero runs with distance 1 and an
+ * empty stream, each split in any way
+ */
+void test_streams_in_any_chunk_size( void ) {
+    static const size_t chunks[] = { 0, 1, 2, 3, 7, 1436, 4096, 1 << 30 };
+
+    for ( auto &stream : test_streams ) {
+        bytes_t data = test_sample( stream.kind, stream.len, stream.seed );
+        for ( auto chunk : chunks ) {
+            TEST_ASSERT_TRUE( inflate_stream( stream.gz, stream.gz_len, chunk ) );
+            TEST_ASSERT_TRUE( written == data );
+            TEST_ASSERT_LESS_OR_EQUAL( OTAINFLATE_WINDOW_SIZE, max_write );
+        }
+    }
+    TEST_ASSERT_TRUE( otainflate_is_gzip( stream_9, sizeof( stream_9 ) ) );
+    TEST_ASSERT_FALSE( otainflate_is_gzip( stream_9, 2 ) );
+    TEST_ASSERT_FALSE( otainflate_is_gzip( (const uint8_t *)"\xe9\x05\x02", 3 ) );
+}
+
+void test_header_fields_are_skipped( void ) {
+    bytes_t data = test_sample( "text", 5000, 11 );
+
+    for ( size_t chunk = 1 ; chunk <= 40 ; chunk++ ) {
+        TEST_ASSERT_TRUE( inflate_stream( stream_fields, sizeof( stream_fields ), chunk ) );
+        TEST_ASSERT_TRUE( written == data );
+    }
+}
+
+/*
+ * the 40000 zeros come out in window sized writes, not byte by byte
+ */
+void test_output_is_written_per_window( void ) {
+    TEST_ASSERT_TRUE( inflate_stream( stream_12, sizeof( stream_12 ), 1 << 30 ) );
+    TEST_ASSERT_EQUAL( 40000, written.size() );
+    TEST_ASSERT_EQUAL( 2, write_calls );
+}
+
+void test_broken_streams( void ) {
+    bytes_t good( stream_11, stream_11 + sizeof( stream_11 ) );
+    bytes_t bad;
+
+    expect_error( bytes_t( good.begin(), good.end() - 1 ), "gzip stream truncated" );
+    expect_error( bytes_t( good.begin(), good.begin() + good.size() / 2 ), "gzip stream truncated" );
+    expect_error( bytes_t( good.begin(), good.begin() + 5 ), "gzip stream truncated" );
+    expect_error( bytes_t(), "gzip stream truncated" );
+
+    bad = good;
+    bad[ bad.size() - 8 ] ^= 1;
+    expect_error( bad, "gzip crc32 mismatch" );
+    bad = good;
+    bad[ bad.size() - 1 ] ^= 1;
+    expect_error( bad, "gzip size mismatch" );
+    bad = good;
+    bad.push_back( 'x' );
+    expect_error( bad, "data after the gzip stream" );
+    bad = good;
+    bad[ 2 ] = 7;
+    expect_error( bad, "not a gzip stream" );
+    bad = good;
+    bad[ 10 ] |= 6;
+    expect_error( bad, "invalid block type" );
+
+    write_ok = false;
+    expect_error( good, "write failed" );
+}
+
+/*
+ * a damaged stream fails or, when the damage is in the gzip header or makes the
+ * same data, comes out right. it never crashes or writes data the crc32 missed
+ */
+void test_random_damage( void ) {
+    bytes_t good( stream_11, stream_11 + sizeof( stream_11 ) );
+    bytes_t data = test_sample( "text", 12000, 7 );
+    uint32_t state = 99;
+    size_t rejected = 0;
+    char msg[ 64 ];
+
+    for ( int i = 0 ; i < 300 ; i++ ) {
+        bytes_t bad = good;
+        test_random_state = state;
+        for ( int n = 1 + test_random() % 5 ; n > 0 ; n-- ) {
+            bad[ 10 + test_random() % ( bad.size() - 10 ) ] = test_random();
+        }
+        state = test_random_state;
+        if ( inflate_stream( bad, 0 ) ) {
+            TEST_ASSERT_TRUE( written == data );
+        }
+        else {
+            rejected++;
+        }
+    }
+    snprintf( msg, sizeof( msg ), "%d of 300 damaged streams rejected", (int)rejected );
+    TEST_MESSAGE( msg );
+}
+
+void test_throughput( void ) {
+    bytes_t data = test_sample( "text", 12000, 7 );
+    char msg[ 128 ];
+    int runs = 0;
+    double seconds;
+
+    auto start = std::chrono::steady_clock::now();
+    do {
+        TEST_ASSERT_TRUE( inflate_stream( stream_11, sizeof( stream_11 ), 1436 ) );
+        runs++;
+        seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    } while( seconds < 0.2 );
+    snprintf( msg, sizeof( msg ), "%.1f MB/s of output on the host, %d -> %d bytes, state %d bytes",
+              runs * data.size() / seconds / 1e6, (int)data.size(), (int)sizeof( stream_11 ), (int)sizeof( otainflate_t ) );
+    TEST_MESSAGE( msg );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_streams_in_any_chunk_size );
+    RUN_TEST( test_header_fields_are_skipped );
+    RUN_TEST( test_output_is_written_per_window );
+    RUN_TEST( test_broken_streams );
+    RUN_TEST( test_random_damage );
+    RUN_TEST( test_throughput );
+    return( UNITY_END() );
+}
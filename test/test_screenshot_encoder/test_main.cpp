@@ -0,0 +1,348 @@
+/****************************************************************************
+ *   Sep 24 18:22:40 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "gui/screenshot_encoder.cpp"
+
+#include <unity.h>
+
+/*
+ * the encoded images are decoded again with decoders written after the png and qoi
+ * specs and compared pixel by pixel. the png has only stored deflate blocks, so no
+ * inflate is needed
+ */
+#define TEST_WIDTH      240
+#define TEST_HEIGHT     240
+
+typedef struct {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector< uint8_t > rgb;
+} test_image_t;
+
+static std::vector< uint16_t > framebuffer;
+
+static uint32_t get32( const uint8_t *p ) {
+    return( (uint32_t)p[ 0 ] << 24 | p[ 1 ] << 16 | p[ 2 ] << 8 | p[ 3 ] );
+}
+
+static uint32_t crc32( const uint8_t *data, size_t len ) {
+    uint32_t crc = 0xffffffff;
+
+    while( len-- ) {
+        crc ^= *data++;
+        for ( int k = 0 ; k < 8 ; k++ ) {
+            crc = crc & 1 ? ( crc >> 1 ) ^ 0xedb88320 : crc >> 1;
+        }
+    }
+    return( crc ^ 0xffffffff );
+}
+
+static uint32_t adler32( const uint8_t *data, size_t len ) {
+    uint32_t a = 1, b = 0;
+
+    while( len-- ) {
+        a = ( a + *data++ ) % 65521;
+        b = ( b + a ) % 65521;
+    }
+    return( b << 16 | a );
+}
+
+/*
+ * rgb888 of a rgb565 pixel, the low bits are filled with the high bits
+ */
+static void expand( uint16_t pixel, uint8_t *rgb ) {
+    uint8_t r = pixel >> 11, g = ( pixel >> 5 ) & 0x3f, b = pixel & 0x1f;
+
+    rgb[ 0 ] = r << 3 | r >> 2;
+    rgb[ 1 ] = g << 2 | g >> 4;
+    rgb[ 2 ] = b << 3 | b >> 2;
+}
+
+static std::vector< uint8_t > expected_rgb( bool swap ) {
+    std::vector< uint8_t > rgb( framebuffer.size() * 3 );
+
+    for ( size_t i = 0 ; i < framebuffer.size() ; i++ ) {
+        uint16_t pixel = swap ? (uint16_t)( framebuffer[ i ] >> 8 | framebuffer[ i ] << 8 ) : framebuffer[ i ];
+        expand( pixel, &rgb[ i * 3 ] );
+    }
+    return( rgb );
+}
+
+static std::string encode( screenshot_format_t format, bool swap, size_t read_size ) {
+    std::string data;
+    std::vector< uint8_t > buf( read_size );
+    size_t len;
+
+    screenshot_encoder_t *encoder = screenshot_encoder_open( format, framebuffer.data(), TEST_WIDTH, TEST_HEIGHT, swap );
+    if ( encoder == NULL ) {
+        return( data );
+    }
+    while( ( len = screenshot_encoder_read( encoder, buf.data(), buf.size() ) ) > 0 ) {
+        data.append( (const char *)buf.data(), len );
+    }
+    screenshot_encoder_close( encoder );
+    return( data );
+}
+
+/*
+ * check every chunk crc, the zlib header and adler32 and join the stored blocks
+ */
+static bool png_decode( const std::string &file, test_image_t *image ) {
+    const uint8_t *p = (const uint8_t *)file.data();
+    const uint8_t *end = p + file.size();
+    std::vector< uint8_t > zlib, raw;
+
+    if ( file.size() < 8 || memcmp( p, "\x89PNG\r\n\x1a\n", 8 ) ) {
+        return( false );
+    }
+    p += 8;
+    while( p + 12 <= end ) {
+        uint32_t len = get32( p );
+        if ( p + 12 + len > end || crc32( p + 4, len + 4 ) != get32( p + 8 + len ) ) {
+            return( false );
+        }
+        if ( !memcmp( p + 4, "IHDR", 4 ) ) {
+            image->width = get32( p + 8 );
+            image->height = get32( p + 12 );
+            if ( p[ 16 ] != 8 || p[ 17 ] != 2 || p[ 18 ] || p[ 19 ] || p[ 20 ] ) {
+                return( false );
+            }
+        }
+        else if ( !memcmp( p + 4, "IDAT", 4 ) ) {
+            zlib.insert( zlib.end(), p + 8, p + 8 + len );
+        }
+        else if ( !memcmp( p + 4, "IEND", 4 ) ) {
+            break;
+        }
+        p += 12 + len;
+    }
+
+    if ( zlib.size() < 6 || ( zlib[ 0 ] << 8 | zlib[ 1 ] ) % 31 || ( zlib[ 0 ] & 0x0f ) != 8 ) {
+        return( false );
+    }
+    size_t pos = 2;
+    bool last = false;
+    while( !last ) {
+        if ( pos + 5 > zlib.size() || ( zlib[ pos ] & 0x06 ) ) {
+            return( false );
+        }
+        last = zlib[ pos ] & 1;
+        uint16_t len = zlib[ pos + 1 ] | zlib[ pos + 2 ] << 8;
+        uint16_t nlen = zlib[ pos + 3 ] | zlib[ pos + 4 ] << 8;
+        if ( (uint16_t)~len != nlen || pos + 5 + len > zlib.size() ) {
+            return( false );
+        }
+        raw.insert( raw.end(), &zlib[ pos + 5 ], &zlib[ pos + 5 ] + len );
+        pos += 5 + len;
+    }
+    if ( pos + 4 != zlib.size() || get32( &zlib[ pos ] ) != adler32( raw.data(), raw.size() ) ) {
+        return( false );
+    }
+
+    if ( raw.size() != image->height * ( 1 + image->width * 3 ) ) {
+        return( false );
+    }
+    for ( uint32_t y = 0 ; y < image->height ; y++ ) {
+        const uint8_t *row = &raw[ y * ( 1 + image->width * 3 ) ];
+        if ( row[ 0 ] != 0 ) {
+            return( false );
+        }
+        image->rgb.insert( image->rgb.end(), row + 1, row + 1 + image->width * 3 );
+    }
+    return( true );
+}
+
+static bool qoi_decode( const std::string &file, test_image_t *image ) {
+    const uint8_t *p = (const uint8_t *)file.data();
+    const uint8_t *end = p + file.size() - 8;
+    uint8_t index[ 64 ][ 4 ] = {};
+    uint8_t px[ 4 ] = { 0, 0, 0, 255 };
+
+    if ( file.size() < 22 || memcmp( p, "qoif", 4 ) || memcmp( end, "\0\0\0\0\0\0\0\1", 8 ) ) {
+        return( false );
+    }
+    image->width = get32( p + 4 );
+    image->height = get32( p + 8 );
+    size_t pixels = image->width * image->height;
+    p += 14;
+
+    while( image->rgb.size() < pixels * 3 ) {
+        int run = 1;
+
+        if ( p >= end ) {
+            return( false );
+        }
+        uint8_t op = *p++;
+        if ( op == 0xfe ) {
+            memcpy( px, p, 3 );
+            p += 3;
+        }
+        else if ( op == 0xff ) {
+            memcpy( px, p, 4 );
+            p += 4;
+        }
+        else if ( ( op & 0xc0 ) == 0x00 ) {
+            memcpy( px, index[ op ], 4 );
+        }
+        else if ( ( op & 0xc0 ) == 0x40 ) {
+            px[ 0 ] += ( ( op >> 4 ) & 3 ) - 2;
+            px[ 1 ] += ( ( op >> 2 ) & 3 ) - 2;
+            px[ 2 ] += ( op & 3 ) - 2;
+        }
+        else if ( ( op & 0xc0 ) == 0x80 ) {
+            int vg = ( op & 0x3f ) - 32;
+            px[ 0 ] += vg - 8 + ( *p >> 4 );
+            px[ 1 ] += vg;
+            px[ 2 ] += vg - 8 + ( *p & 0x0f );
+            p++;
+        }
+        else {
+            run = ( op & 0x3f ) + 1;
+        }
+        memcpy( index[ ( px[ 0 ] * 3 + px[ 1 ] * 5 + px[ 2 ] * 7 + px[ 3 ] * 11 ) % 64 ], px, 4 );
+        while( run-- ) {
+            image->rgb.insert( image->rgb.end(), px, px + 3 );
+        }
+    }
+    return( p == end && image->rgb.size() == pixels * 3 );
+}
+
+/*
+ * flat areas, gradients, noise and a long run over the row end like a watch face
+ */
+static void fill_framebuffer( void ) {
+    framebuffer.assign( TEST_WIDTH * TEST_HEIGHT, 0 );
+    srand( 1 );
+    for ( int y = 0 ; y < TEST_HEIGHT ; y++ ) {
+        for ( int x = 0 ; x < TEST_WIDTH ; x++ ) {
+            uint16_t &pixel = framebuffer[ y * TEST_WIDTH + x ];
+            if ( y < 60 ) {
+                pixel = 0x0000;
+            }
+            else if ( y < 120 ) {
+                pixel = ( x / 8 ) << 11 | ( y - 60 ) << 5 | ( x / 8 );
+            }
+            else if ( y < 180 ) {
+                pixel = rand();
+            }
+            else {
+                pixel = x < 120 ? 0xffff : ( x % 3 ? 0x07e0 : 0xf81f );
+            }
+        }
+    }
+}
+
+void setUp( void ) {
+    fill_framebuffer();
+}
+
+void tearDown( void ) {
+}
+
+void test_raw_is_the_framebuffer( void ) {
+    std::string data = encode( SCREENSHOT_RAW, false, 1000 );
+
+    TEST_ASSERT_EQUAL( framebuffer.size() * 2, data.size() );
+    TEST_ASSERT_EQUAL_MEMORY( framebuffer.data(), data.data(), data.size() );
+}
+
+void test_png_decodes_to_the_framebuffer( void ) {
+    test_image_t image;
+
+    TEST_ASSERT_TRUE( png_decode( encode( SCREENSHOT_PNG, false, 4096 ), &image ) );
+    TEST_ASSERT_EQUAL( TEST_WIDTH, image.width );
+    TEST_ASSERT_EQUAL( TEST_HEIGHT, image.height );
+    TEST_ASSERT_TRUE( image.rgb == expected_rgb( false ) );
+}
+
+void test_qoi_decodes_to_the_framebuffer( void ) {
+    test_image_t image;
+
+    TEST_ASSERT_TRUE( qoi_decode( encode( SCREENSHOT_QOI, false, 4096 ), &image ) );
+    TEST_ASSERT_EQUAL( TEST_WIDTH, image.width );
+    TEST_ASSERT_EQUAL( TEST_HEIGHT, image.height );
+    TEST_ASSERT_TRUE( image.rgb == expected_rgb( false ) );
+}
+
+void test_swapped_pixels( void ) {
+    test_image_t png, qoi;
+
+    TEST_ASSERT_TRUE( png_decode( encode( SCREENSHOT_PNG, true, 4096 ), &png ) );
+    TEST_ASSERT_TRUE( qoi_decode( encode( SCREENSHOT_QOI, true, 4096 ), &qoi ) );
+    TEST_ASSERT_TRUE( png.rgb == expected_rgb( true ) );
+    TEST_ASSERT_TRUE( qoi.rgb == expected_rgb( true ) );
+}
+
+void test_read_size_does_not_change_the_stream( void ) {
+    static const size_t sizes[] = { 1, 7, 64, 1460, 100000 };
+    std::string png = encode( SCREENSHOT_PNG, false, 4096 );
+    std::string qoi = encode( SCREENSHOT_QOI, false, 4096 );
+
+    for ( auto size : sizes ) {
+        TEST_ASSERT_TRUE( encode( SCREENSHOT_PNG, false, size ) == png );
+        TEST_ASSERT_TRUE( encode( SCREENSHOT_QOI, false, size ) == qoi );
+    }
+}
+
+void test_qoi_long_runs_and_single_color( void ) {
+    test_image_t image;
+
+    // one color: only runs of 62 and a rest carried over all rows
+    framebuffer.assign( TEST_WIDTH * TEST_HEIGHT, 0x1234 );
+    std::string qoi = encode( SCREENSHOT_QOI, false, 4096 );
+    TEST_ASSERT_TRUE( qoi_decode( qoi, &image ) );
+    TEST_ASSERT_TRUE( image.rgb == expected_rgb( false ) );
+    TEST_ASSERT_LESS_THAN( 1000, qoi.size() );
+}
+
+void test_encoder_throughput( void ) {
+    static const screenshot_format_t formats[] = { SCREENSHOT_RAW, SCREENSHOT_PNG, SCREENSHOT_QOI };
+    static const char *names[] = { "raw", "png", "qoi" };
+    char msg[ 128 ];
+
+    for ( int f = 0 ; f < 3 ; f++ ) {
+        size_t size = 0;
+        int frames = 0;
+        auto start = std::chrono::steady_clock::now();
+        double seconds;
+        do {
+            size = encode( formats[ f ], true, 1460 ).size();
+            frames++;
+            seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+        } while( seconds < 0.2 );
+        snprintf( msg, sizeof( msg ), "%s: %d bytes, %.0f frames/s on the host", names[ f ], (int)size, frames / seconds );
+        TEST_MESSAGE( msg );
+    }
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_raw_is_the_framebuffer );
+    RUN_TEST( test_png_decodes_to_the_framebuffer );
+    RUN_TEST( test_qoi_decodes_to_the_framebuffer );
+    RUN_TEST( test_swapped_pixels );
+    RUN_TEST( test_read_size_does_not_change_the_stream );
+    RUN_TEST( test_qoi_long_runs_and_single_color );
+    RUN_TEST( test_encoder_throughput );
+    return( UNITY_END() );
+}
@@ -0,0 +1,242 @@
+/****************************************************************************
+ *   Sep 23 19:14:52 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+#include "standin_http.h"
+
+#include "hardware/httpctl.cpp"
+#include "gui/mainbar/setup_tile/update/update_download.cpp"
+
+#include <unity.h>
+
+/*
+ * firmware download against the stand-in server, the connection is dropped in the
+ * middle of the body. otaupdate is replaced by a flash in ram that keeps whole sectors
+ * on suspend, the "sha256" of the written part is its length
+ */
+#define TEST_PORT       8081
+#define TEST_URL        "http://firmware.local:8081/firmware.bin"
+#define TEST_SIZE       40000
+
+static std::string image;
+static std::string flash;
+static bool ota_running = false;
+static int ota_begins = 0;
+static int ota_resumes = 0;
+static int ota_suspends = 0;
+static int ota_ends = 0;
+static bool wifi_off_on_suspend = false;
+
+bool otaupdate_begin( int command, size_t total, const char *sha256 ) {
+    flash.clear();
+    ota_running = true;
+    ota_begins++;
+    return( true );
+}
+
+bool otaupdate_resume( int command, size_t offset, size_t total, const char *sha256, const char *written_sha256 ) {
+    if ( ota_running || offset > flash.size() || strtoul( written_sha256, NULL, 10 ) != offset ) {
+        return( false );
+    }
+    flash.resize( offset );
+    ota_running = true;
+    ota_resumes++;
+    return( true );
+}
+
+bool otaupdate_write( const uint8_t *data, size_t len ) {
+    flash.append( (const char *)data, len );
+    return( true );
+}
+
+bool otaupdate_end( void ) {
+    ota_running = false;
+    ota_ends++;
+    return( flash == image );
+}
+
+void otaupdate_abort( void ) {
+    ota_running = false;
+}
+
+size_t otaupdate_suspend( char *written_sha256 ) {
+    size_t offset = flash.size() - flash.size() % OTAUPDATE_SECTOR_SIZE;
+
+    flash.resize( offset );
+    snprintf( written_sha256, OTAUPDATE_SHA256_LEN + 1, "%zu", offset );
+    ota_running = false;
+    ota_suspends++;
+    if ( wifi_off_on_suspend ) {
+        native_wifi_connected = false;
+    }
+    return( offset );
+}
+
+bool otaupdate_is_running( void ) {
+    return( ota_running );
+}
+
+/*
+ * serve the image with range requests, drop_at are the file offsets where a connection is lost
+ */
+static std::vector< size_t > drop_at;
+static bool chunked = false;
+
+static standin_http_response_t serve_image( const standin_http_request_t &request ) {
+    standin_http_response_t response;
+    size_t start = 0;
+    char line[ 64 ];
+
+    std::string range = StandinHttp::header( request, "Range" );
+    if ( range.size() ) {
+        start = strtoul( range.c_str() + 6, NULL, 10 );
+        response.status = 206;
+        snprintf( line, sizeof( line ), "Content-Range: bytes %zu-%zu/%zu\r\n", start, image.size() - 1, image.size() );
+        response.headers = line;
+    }
+    response.headers += "ETag: \"firmware-1\"\r\n";
+    response.body = image.substr( start );
+    response.chunked = chunked && !range.size();
+    response.chunk_size = 3000;
+    for ( auto &drop : drop_at ) {
+        if ( drop > start ) {
+            // a chunked body has a chunk header in front of every chunk
+            response.drop_after = drop - start + ( response.chunked ? 4 + 4 * ( ( drop - start ) / 3000 ) : 0 );
+            drop_at.erase( drop_at.begin() );
+            break;
+        }
+    }
+    return( response );
+}
+
+static StandinHttp *server = NULL;
+
+void wifictl_register_cb( EventBits_t event, WIFICTL_CALLBACK_FUNC wifictl_event_cb ) {}
+
+void setUp( void ) {
+    native_wifi_connected = true;
+    native_files.clear();
+    image.clear();
+    for ( int i = 0 ; i < TEST_SIZE ; i++ ) {
+        image += (char)( i * 7 + i / 251 );
+    }
+    flash.clear();
+    ota_running = false;
+    ota_begins = ota_resumes = ota_suspends = ota_ends = 0;
+    drop_at.clear();
+    chunked = false;
+    wifi_off_on_suspend = false;
+    server = new StandinHttp( TEST_PORT, serve_image );
+}
+
+/*
+ * a failed assert leaves the test without destructors, so the server is removed here
+ */
+void tearDown( void ) {
+    delete server;
+    server = NULL;
+}
+
+void test_complete_download( void ) {
+    TEST_ASSERT_EQUAL( 200, update_download( TEST_URL, NULL ) );
+    TEST_ASSERT_EQUAL( 1, ota_ends );
+    TEST_ASSERT_EQUAL( 0, ota_suspends );
+    TEST_ASSERT_TRUE( flash == image );
+    // only the headers httpctl sends itself
+    TEST_ASSERT_TRUE( server->log[ 0 ].headers.find( "force-unsecure" ) == std::string::npos );
+    TEST_ASSERT_TRUE( StandinHttp::header( server->log[ 0 ], "Range" ) == "" );
+}
+
+void test_lost_connection_is_resumed( void ) {
+    drop_at = { 10000 };
+
+    TEST_ASSERT_EQUAL( 200, update_download( TEST_URL, NULL ) );
+    TEST_ASSERT_EQUAL( 1, ota_suspends );
+    TEST_ASSERT_EQUAL( 1, ota_resumes );
+    TEST_ASSERT_EQUAL( 1, ota_ends );
+    TEST_ASSERT_TRUE( flash == image );
+    TEST_ASSERT_EQUAL( 2, server->requests );
+    TEST_ASSERT_TRUE( StandinHttp::header( server->log[ 1 ], "Range" ) == "bytes=8192-" );
+    TEST_ASSERT_TRUE( StandinHttp::header( server->log[ 1 ], "If-Range" ) == "\"firmware-1\"" );
+}
+
+void test_lost_chunked_connection_is_resumed( void ) {
+    // no Content-Length, only the missing last chunk shows the lost connection
+    chunked = true;
+    drop_at = { 10000 };
+
+    TEST_ASSERT_EQUAL( 200, update_download( TEST_URL, NULL ) );
+    TEST_ASSERT_EQUAL( 1, ota_suspends );
+    TEST_ASSERT_EQUAL( 1, ota_ends );
+    TEST_ASSERT_TRUE( flash == image );
+}
+
+void test_complete_chunked_download( void ) {
+    chunked = true;
+
+    TEST_ASSERT_EQUAL( 200, update_download( TEST_URL, NULL ) );
+    TEST_ASSERT_EQUAL( 0, ota_suspends );
+    TEST_ASSERT_EQUAL( 1, ota_ends );
+    TEST_ASSERT_TRUE( flash == image );
+}
+
+void test_lost_range_request_is_resumed( void ) {
+    // the resumed part is lost again, the Content-Range total is not reached
+    drop_at = { 10000, 30000 };
+
+    TEST_ASSERT_EQUAL( 200, update_download( TEST_URL, NULL ) );
+    TEST_ASSERT_EQUAL( 2, ota_suspends );
+    TEST_ASSERT_EQUAL( 2, ota_resumes );
+    TEST_ASSERT_EQUAL( 1, ota_ends );
+    TEST_ASSERT_TRUE( flash == image );
+    TEST_ASSERT_TRUE( StandinHttp::header( server->log[ 2 ], "Range" ) == "bytes=28672-" );
+}
+
+void test_paused_download_is_resumed_later( void ) {
+    // the wifi is gone after the connection is lost, the state is kept for later
+    drop_at = { 20000 };
+    wifi_off_on_suspend = true;
+
+    TEST_ASSERT_EQUAL( UPDATE_DOWNLOAD_PAUSED, update_download( TEST_URL, NULL ) );
+    TEST_ASSERT_EQUAL( 0, ota_ends );
+    TEST_ASSERT_TRUE( update_download_is_pending() );
+
+    native_wifi_connected = true;
+    wifi_off_on_suspend = false;
+    TEST_ASSERT_EQUAL( 200, update_download_resume() );
+    TEST_ASSERT_EQUAL( 1, ota_ends );
+    TEST_ASSERT_TRUE( flash == image );
+    TEST_ASSERT_FALSE( update_download_is_pending() );
+    TEST_ASSERT_TRUE( StandinHttp::header( server->log.back(), "Range" ) == "bytes=16384-" );
+}
+
+int main( int argc, char **argv ) {
+    httpctl_setup();
+
+    UNITY_BEGIN();
+    RUN_TEST( test_complete_download );
+    RUN_TEST( test_lost_connection_is_resumed );
+    RUN_TEST( test_lost_chunked_connection_is_resumed );
+    RUN_TEST( test_complete_chunked_download );
+    RUN_TEST( test_lost_range_request_is_resumed );
+    RUN_TEST( test_paused_download_is_resumed_later );
+    return( UNITY_END() );
+}
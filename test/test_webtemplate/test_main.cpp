@@ -0,0 +1,282 @@
+/****************************************************************************
+ *   Sep 25 19:40:12 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "webserver/webtemplate.cpp"
+
+#include <unity.h>
+
+/*
+ * the same fields and layout as /info in webserver.cpp, with values of the length
+ * the watch sends
+ */
+static const char info_html[] PROGMEM =
+    "<html><head><meta charset=\"utf-8\"></head><body><h3>Information</h3>"
+    "<b><u>Memory</u></b><br>"
+    "<b>Heap size: </b>%HEAP_SIZE%<br>"
+    "<b>Heap free: </b>%HEAP_FREE%<br>"
+    "<b>Heap free min: </b>%HEAP_FREE_MIN%<br>"
+    "<b>Heap size: </b>%HEAP_SIZE%<br>"
+    "<b>Psram size: </b>%PSRAM_SIZE%<br>"
+    "<b>Psram free: </b>%PSRAM_FREE%<br>"
+    "<br><b><u>System</u></b><br>"
+    "\t<b>Battery voltage: </b>%BATTERY_VOLTAGE% Volts<br>"
+    "\t<b>Uptime: </b>%UPTIME%<br>"
+    "<br><b><u>Chip</u></b>"
+    "<br><b>SdkVersion: </b>%SDK_VERSION%<br>"
+    "<b>CpuFreq: </b>%CPU_FREQ% MHz<br>"
+    "<br><b><u>Flash</u></b><br>"
+    "<b>FlashChipSpeed: </b>%FLASH_SPEED% MHz<br>"
+    "<b>Flash mode: </b>%FLASH_MODE_NAME%</b><br>"
+    "<b>Flash sector size: </b>%FLASH_SECTOR_SIZE%<br>"
+    "<b>FlashChipMode: </b>%FLASH_MODE%<br>"
+    "<b>FlashChipSize (SDK): </b>%FLASH_SIZE%<br>"
+    "<br><b><u>Firmware</u></b><br>"
+    "<b>SketchSpace free: </b>%SKETCH_FREE% (%SKETCH_FREE_PERCENT%%%)<br>"
+    "<b>BuildTime: </b>" __DATE__ " " __TIME__ "<br>"
+    "<b>Version: </b>" __FIRMWARE__ "<br>"
+    "<b>GCC-Version: </b>" __VERSION__ "<br>"
+    "<b>SketchMD5: </b>%SKETCH_MD5%<br>"
+    "<br><b><u>Filesystem</u></b><br>"
+    "<b>Total size: </b>%SPIFFS_TOTAL%<br>"
+    "<b>Used size: </b>%SPIFFS_USED%<br>"
+    "<br>";
+
+static const char *info_values[][ 2 ] = {
+    { "HEAP_SIZE", "348352" },
+    { "HEAP_FREE", "161432" },
+    { "HEAP_FREE_MIN", "98212" },
+    { "PSRAM_SIZE", "4194252" },
+    { "PSRAM_FREE", "3795084" },
+    { "BATTERY_VOLTAGE", "4.12" },
+    { "UPTIME", "86401" },
+    { "SDK_VERSION", "v3.3.2-107-g4f8acd7f1" },
+    { "CPU_FREQ", "240" },
+    { "FLASH_SPEED", "80" },
+    { "FLASH_MODE_NAME", "DIO" },
+    { "FLASH_SECTOR_SIZE", "4096" },
+    { "FLASH_MODE", "2" },
+    { "FLASH_SIZE", "16777216" },
+    { "SKETCH_FREE", "5177344" },
+    { "SKETCH_FREE_PERCENT", "78" },
+    { "SKETCH_MD5", "8c2fbd7e4a61e1c9f50d1ab0d2e3a6c4" },
+    { "SPIFFS_TOTAL", "1475447" },
+    { "SPIFFS_USED", "313046" },
+};
+
+static int field_calls = 0;
+
+static void info_field( const char *field, char *value, size_t size ) {
+    field_calls++;
+    for ( auto &info_value : info_values ) {
+        if ( !strcmp( field, info_value[ 0 ] ) ) {
+            snprintf( value, size, "%s", info_value[ 1 ] );
+        }
+    }
+}
+
+static void test_field( const char *field, char *value, size_t size ) {
+    if ( !strcmp( field, "A" ) ) {
+        snprintf( value, size, "1" );
+    }
+    else if ( !strcmp( field, "B" ) ) {
+        snprintf( value, size, "50" );
+    }
+    else if ( !strcmp( field, "LONG" ) ) {
+        snprintf( value, size, "%0100d", 7 );
+    }
+}
+
+static std::string render( const char *tmpl, WEBTEMPLATE_FIELD_FUNC field_cb, size_t read_size ) {
+    webtemplate_t webtemplate;
+    std::vector< uint8_t > buf( read_size );
+    std::string out;
+    size_t len;
+
+    memset( &webtemplate, 0, sizeof( webtemplate ) );
+    webtemplate.tmpl = tmpl;
+    webtemplate.field_cb = field_cb;
+    while( ( len = webtemplate_read( &webtemplate, buf.data(), buf.size() ) ) > 0 ) {
+        TEST_ASSERT_LESS_OR_EQUAL( read_size, len );
+        out.append( (const char *)buf.data(), len );
+    }
+    TEST_ASSERT_EQUAL( out.size(), webtemplate.sent );
+    return( out );
+}
+
+/*
+ * the page like the String code before built it: one concat per piece that reallocs
+ * to the exact new length like the arduino String, a temporary String for every
+ * field value and a copy of the page in the response. counts the allocations and
+ * the most bytes held at once
+ */
+static std::string render_string_concat( const char *tmpl, WEBTEMPLATE_FIELD_FUNC field_cb, int *allocs, size_t *peak ) {
+    char *html = NULL;
+    size_t html_len = 0;
+    std::string page;
+
+    *allocs = 0;
+    *peak = 0;
+    auto concat = [&]( const char *piece, size_t len ) {
+        char *grown = (char *)malloc( html_len + len + 1 );
+        *peak = std::max( *peak, ( html ? html_len + 1 : 0 ) + html_len + len + 1 );
+        if ( html ) {
+            memcpy( grown, html, html_len );
+            free( html );
+        }
+        memcpy( grown + html_len, piece, len );
+        html = grown;
+        html_len += len;
+        html[ html_len ] = '\0';
+        ( *allocs )++;
+    };
+
+    for ( const char *p = tmpl ; *p ; ) {
+        const char *field_start = strchr( p, '%' );
+        if ( field_start == NULL ) {
+            concat( p, strlen( p ) );
+            break;
+        }
+        if ( field_start != p ) {
+            concat( p, field_start - p );
+        }
+        if ( field_start[ 1 ] == '%' ) {
+            concat( "%", 1 );
+            p = field_start + 2;
+            continue;
+        }
+        const char *field_end = strchr( field_start + 1, '%' );
+        char field[ WEBTEMPLATE_FIELD_SIZE ] = "";
+        char value[ WEBTEMPLATE_VALUE_SIZE ] = "";
+        memcpy( field, field_start + 1, field_end - field_start - 1 );
+        field_cb( field, value, sizeof( value ) );
+        char *number = strdup( value );
+        ( *allocs )++;
+        concat( number, strlen( number ) );
+        free( number );
+        p = field_end + 1;
+    }
+
+    char *response = strdup( html );
+    ( *allocs )++;
+    *peak = std::max( *peak, 2 * ( html_len + 1 ) );
+    page = response;
+    free( response );
+    free( html );
+    return( page );
+}
+
+void setUp( void ) {
+    field_calls = 0;
+}
+
+void tearDown( void ) {
+}
+
+void test_fields_and_percent( void ) {
+    TEST_ASSERT_TRUE( render( "<b>%A%</b> %B%%%, 100% %UNKNOWN% %", test_field, 4096 ) == "<b>1</b> 50%, 100%  %" );
+    TEST_ASSERT_TRUE( render( "%lower% %", test_field, 4096 ) == "%lower% %" );
+    TEST_ASSERT_TRUE( render( "", test_field, 4096 ) == "" );
+}
+
+void test_long_value_is_cut( void ) {
+    std::string out = render( "[%LONG%]", test_field, 4096 );
+
+    TEST_ASSERT_EQUAL( WEBTEMPLATE_VALUE_SIZE - 1 + 2, out.size() );
+}
+
+void test_every_chunk_size_gives_the_same_page( void ) {
+    std::string page = render( info_html, info_field, 4096 );
+
+    TEST_ASSERT_NOT_NULL( strstr( page.c_str(), "<b>Heap free: </b>161432<br>" ) );
+    TEST_ASSERT_NOT_NULL( strstr( page.c_str(), "(78%)" ) );
+    for ( size_t size = 1 ; size <= 256 ; size++ ) {
+        TEST_ASSERT_TRUE( render( info_html, info_field, size ) == page );
+    }
+}
+
+void test_send_streams_the_page_and_frees_on_disconnect( void ) {
+    AsyncWebServerRequest request;
+    size_t chunks;
+
+    webtemplate_send( &request, "text/html", info_html, info_field );
+    TEST_ASSERT_NOT_NULL( request.response );
+    TEST_ASSERT_EQUAL_STRING( "text/html", request.response->content_type.c_str() );
+    TEST_ASSERT_EQUAL_STRING( "no-store", request.response->headers[ "Cache-Control" ].c_str() );
+    TEST_ASSERT_EQUAL( 0, field_calls );
+
+    request.native_fill( 1460, &chunks );
+    TEST_ASSERT_TRUE( request.response_body == render( info_html, info_field, 4096 ) );
+    TEST_ASSERT_EQUAL( ( request.response_body.size() + 1459 ) / 1460, chunks );
+    request.native_disconnect();
+}
+
+/*
+ * the numbers the request asked for, on the host. the template holds only its state,
+ * the String code held the page twice at the end and more while it was growing
+ */
+void test_heap_and_time_per_page( void ) {
+    char msg[ 160 ];
+    int allocs;
+    size_t peak;
+    int pages;
+    double seconds;
+
+    std::string page = render_string_concat( info_html, info_field, &allocs, &peak );
+    TEST_ASSERT_TRUE( page == render( info_html, info_field, 4096 ) );
+    TEST_ASSERT_LESS_THAN( peak, sizeof( webtemplate_t ) );
+
+    snprintf( msg, sizeof( msg ), "/info %d bytes: String concat %d allocations, %d bytes high-water; template 1 allocation, %d bytes",
+              (int)page.size(), allocs, (int)peak, (int)sizeof( webtemplate_t ) );
+    TEST_MESSAGE( msg );
+
+    auto start = std::chrono::steady_clock::now();
+    pages = 0;
+    do {
+        render_string_concat( info_html, info_field, &allocs, &peak );
+        pages++;
+        seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    } while( seconds < 0.2 );
+    double concat_us = seconds * 1e6 / pages;
+
+    start = std::chrono::steady_clock::now();
+    pages = 0;
+    do {
+        render( info_html, info_field, 1460 );
+        pages++;
+        seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    } while( seconds < 0.2 );
+    double template_us = seconds * 1e6 / pages;
+
+    snprintf( msg, sizeof( msg ), "/info on the host: String concat %.1f us, template %.1f us per page", concat_us, template_us );
+    TEST_MESSAGE( msg );
+}
+
+int main( int argc, char **argv ) {
+    UNITY_BEGIN();
+    RUN_TEST( test_fields_and_percent );
+    RUN_TEST( test_long_value_is_cut );
+    RUN_TEST( test_every_chunk_size_gives_the_same_page );
+    RUN_TEST( test_send_streams_the_page_and_frees_on_disconnect );
+    RUN_TEST( test_heap_and_time_per_page );
+    return( UNITY_END() );
+}
@@ -0,0 +1,266 @@
+/****************************************************************************
+ *   Sep 23 21:40:05 2020
+ *   Copyright  2020  Dirk Brosswick
+ *   Email: dirk.brosswick@googlemail.com
+ ****************************************************************************/
+
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include "native.h"
+
+#include "hardware/otadelta.cpp"
+#include "hardware/otainflate.cpp"
+#include "hardware/otaupdate.cpp"
+#include "webserver/webupdate.cpp"
+
+#include <unity.h>
+
+/*
+ * browser upload into otaupdate. the test plays the async_tcp task: it sends the image
+ * in tcp segments into the upload handler and waits like a sender when the bytes the
+ * handler has not acked fill the tcp window. the flash costs real time per sector
+ */
+#define TEST_IMAGE_SIZE     ( 384 * 1024 + 123 )
+#define TEST_SEGMENT_SIZE   1436                /** @brief mss of the esp32 */
+#define TEST_TCP_WINDOW     5744                /** @brief default lwip window of the esp32, 4 * mss */
+#define TEST_TIMEOUT        10                  /** @brief seconds to wait for the sender or the result */
+
+typedef struct {
+    uint32_t max_callback_us = 0;               /** @brief longest time the upload handler blocked the async_tcp task */
+    uint32_t window_waits = 0;                  /** @brief how often the sender waited for acks */
+    double seconds = 0;
+} test_upload_stats_t;
+
+static AsyncWebServer server( 80 );
+static std::string image;
+static char image_sha256[ OTAUPDATE_SHA256_LEN + 1 ];
+static AsyncWebServerRequest *request = NULL;
+
+static double now( void ) {
+    return( std::chrono::duration< double >( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
+
+static void sha256_hex( const std::string &data, char *hex ) {
+    mbedtls_sha256_context ctx;
+    uint8_t digest[ 32 ];
+
+    mbedtls_sha256_init( &ctx );
+    mbedtls_sha256_starts_ret( &ctx, 0 );
+    mbedtls_sha256_update_ret( &ctx, (const uint8_t *)data.data(), data.size() );
+    mbedtls_sha256_finish_ret( &ctx, digest );
+    otaupdate_hex( digest, hex );
+}
+
+static AsyncWebServerRequest *new_request( const char *sha256 ) {
+    request = new AsyncWebServerRequest;
+    request->params.emplace( WEBUPDATE_SHA256_PARAM, AsyncWebParameter( sha256 ) );
+    request->params.emplace( WEBUPDATE_SIZE_PARAM, AsyncWebParameter( std::to_string( image.size() ) ) );
+    return( request );
+}
+
+/*
+ * send the first len bytes of the image, on_wait is called when the sender waits for acks
+ * the first time. with the whole image the request handler is called at the end
+ */
+static bool upload( AsyncWebServerRequest *request, size_t len, test_upload_stats_t *stats, std::function< void( void ) > on_wait = NULL ) {
+    native_web_handler_t *handler = server.native_handler( WEBUPDATE_URL, HTTP_POST );
+    AsyncClient *client = request->client();
+    double start = now();
+
+    for ( size_t pos = 0 ; pos < len ; pos += TEST_SEGMENT_SIZE ) {
+        size_t part = std::min( (size_t)TEST_SEGMENT_SIZE, image.size() - pos );
+
+        if ( client->native_unacked() + part > TEST_TCP_WINDOW ) {
+            if ( stats->window_waits++ == 0 && on_wait ) {
+                on_wait();
+            }
+            double wait_start = now();
+            while( client->native_unacked() + part > TEST_TCP_WINDOW ) {
+                if ( now() - wait_start > TEST_TIMEOUT ) {
+                    return( false );
+                }
+                std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+            }
+        }
+        double callback_start = now();
+        handler->on_upload( request, "firmware.bin", pos, (uint8_t *)&image[ pos ], part, pos + part == image.size() );
+        stats->max_callback_us = std::max( stats->max_callback_us, (uint32_t)( ( now() - callback_start ) * 1e6 ) );
+        client->native_received( part );
+    }
+    if ( len == image.size() ) {
+        handler->on_request( request );
+    }
+    stats->seconds = now() - start;
+    return( true );
+}
+
+/*
+ * wait for the done or fail event
+ */
+static std::string wait_result( void ) {
+    double start = now();
+
+    while( now() - start < TEST_TIMEOUT ) {
+        for ( auto &event : server.event_sources[ 0 ]->native_events() ) {
+            if ( !event.compare( 0, 5, "done:" ) || !event.compare( 0, 5, "fail:" ) ) {
+                return( event );
+            }
+        }
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    return( "timeout" );
+}
+
+static void wait_task_end( void ) {
+    double start = now();
+
+    while( _webupdate_Task && now() - start < TEST_TIMEOUT ) {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+}
+
+static bool image_in_flash( void ) {
+    return( !memcmp( native_partition( &native_partitions[ 1 ] ).data(), image.data(), image.size() ) );
+}
+
+void setUp( void ) {
+    native_flash_sector_us = 0;
+    native_flash_stalled = false;
+    native_flash_violations = 0;
+    native_boot_partition = &native_partitions[ 0 ];
+    ESP.restarts = 0;
+    server.event_sources[ 0 ]->native_clear();
+}
+
+/*
+ * a failed assert leaves the test without destructors, the update and the request are removed here
+ */
+void tearDown( void ) {
+    native_flash_stalled = false;
+    if ( request ) {
+        request->native_disconnect();
+        wait_task_end();
+        delete request;
+        request = NULL;
+    }
+    otaupdate_abort();
+}
+
+void test_upload_is_verified_and_activated( void ) {
+    test_upload_stats_t stats;
+
+    TEST_ASSERT_TRUE( upload( new_request( image_sha256 ), image.size(), &stats ) );
+    TEST_ASSERT_EQUAL( 202, request->response_code );
+    TEST_ASSERT_TRUE( wait_result() == std::string( "done: {\"written\":" ) + std::to_string( image.size() ) + ",\"total\":" + std::to_string( image.size() ) + ",\"msg\":\"" + image_sha256 + "\"}" );
+    wait_task_end();
+    TEST_ASSERT_TRUE( image_in_flash() );
+    TEST_ASSERT_EQUAL( 0, native_flash_violations );
+    TEST_ASSERT_TRUE( native_boot_partition == &native_partitions[ 1 ] );
+    TEST_ASSERT_EQUAL( 1, ESP.restarts );
+}
+
+void test_upload_handler_never_waits_for_the_flash( void ) {
+    test_upload_stats_t stats;
+    size_t held_when_waiting = 0;
+
+    // the flash is busy until the sender has to wait for acks
+    native_flash_stalled = true;
+    TEST_ASSERT_TRUE( upload( new_request( image_sha256 ), image.size(), &stats, [ &held_when_waiting ]() {
+        held_when_waiting = request->client()->native_unacked();
+        native_flash_stalled = false;
+    } ) );
+    TEST_ASSERT_GREATER_THAN( 0, held_when_waiting );
+    TEST_ASSERT_GREATER_THAN( 0, stats.window_waits );
+    TEST_ASSERT_LESS_THAN( 100000, stats.max_callback_us );
+    TEST_ASSERT_EQUAL( 202, request->response_code );
+    TEST_ASSERT_TRUE( !wait_result().compare( 0, 5, "done:" ) );
+    wait_task_end();
+    TEST_ASSERT_TRUE( image_in_flash() );
+    TEST_ASSERT_EQUAL( 0, request->client()->native_unacked() );
+}
+
+void test_upload_throughput( void ) {
+    test_upload_stats_t stats;
+    char msg[ 160 ];
+
+    // ~1 MB/s flash, the upload is limited by the flash and not by waits on the async_tcp task
+    native_flash_sector_us = 4000;
+    double start = now();
+    TEST_ASSERT_TRUE( upload( new_request( image_sha256 ), image.size(), &stats ) );
+    TEST_ASSERT_TRUE( !wait_result().compare( 0, 5, "done:" ) );
+    double seconds = now() - start;
+    double flash_kbs = 4.0 / ( native_flash_sector_us / 1e6 );
+
+    snprintf( msg, sizeof( msg ), "%.0f kB in %.2fs: %.0f kB/s, flash %.0f kB/s, longest upload callback %uus, %u waits for acks",
+              image.size() / 1024.0, seconds, image.size() / 1024.0 / seconds, flash_kbs, stats.max_callback_us, stats.window_waits );
+    TEST_MESSAGE( msg );
+    TEST_ASSERT_GREATER_THAN( flash_kbs / 2, image.size() / 1024.0 / seconds );
+    TEST_ASSERT_LESS_THAN( native_flash_sector_us, stats.max_callback_us );
+    TEST_ASSERT_GREATER_THAN( 0, request->client()->held_total );
+}
+
+void test_lost_connection_drops_the_update( void ) {
+    test_upload_stats_t stats;
+
+    TEST_ASSERT_TRUE( upload( new_request( image_sha256 ), image.size() / 2, &stats ) );
+    request->native_disconnect();
+    TEST_ASSERT_TRUE( wait_result().find( "aborted" ) != std::string::npos );
+    wait_task_end();
+    TEST_ASSERT_FALSE( otaupdate_is_running() );
+    TEST_ASSERT_TRUE( native_boot_partition == &native_partitions[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, ESP.restarts );
+}
+
+void test_wrong_sha256_is_not_activated( void ) {
+    test_upload_stats_t stats;
+    char sha256[ OTAUPDATE_SHA256_LEN + 1 ];
+
+    strlcpy( sha256, image_sha256, sizeof( sha256 ) );
+    sha256[ 0 ] = sha256[ 0 ] == '0' ? '1' : '0';
+    TEST_ASSERT_TRUE( upload( new_request( sha256 ), image.size(), &stats ) );
+    TEST_ASSERT_TRUE( wait_result().find( "sha256 mismatch" ) != std::string::npos );
+    wait_task_end();
+    TEST_ASSERT_TRUE( native_boot_partition == &native_partitions[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, ESP.restarts );
+}
+
+void test_upload_during_another_update_is_refused( void ) {
+    test_upload_stats_t stats;
+
+    TEST_ASSERT_TRUE( otaupdate_begin( U_FLASH, 0, NULL ) );
+    TEST_ASSERT_TRUE( upload( new_request( image_sha256 ), image.size(), &stats ) );
+    TEST_ASSERT_EQUAL( 409, request->response_code );
+    otaupdate_abort();
+}
+
+int main( int argc, char **argv ) {
+    srand( 1 );
+    for ( int i = 0 ; i < TEST_IMAGE_SIZE ; i++ ) {
+        image += (char)rand();
+    }
+    image[ 0 ] = ESP_IMAGE_HEADER_MAGIC;
+    sha256_hex( image, image_sha256 );
+    webupdate_setup( &server );
+
+    UNITY_BEGIN();
+    RUN_TEST( test_upload_is_verified_and_activated );
+    RUN_TEST( test_upload_handler_never_waits_for_the_flash );
+    RUN_TEST( test_upload_throughput );
+    RUN_TEST( test_lost_connection_drops_the_update );
+    RUN_TEST( test_wrong_sha256_is_not_activated );
+    RUN_TEST( test_upload_during_another_update_is_refused );
+    return( UNITY_END() );
+}
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+#
+# send a file or a firmware to the watch over ble, without wifi
+#
+# the watch side is src/hardware/blexfer.cpp. the data is send in blocks of up
+# to 32 chunks, each block is acked with its crc32 and lost chunks are send again.
+# after a lost connection the transfer continues where the watch has stopped.
+#
+# python3 tools/blexfer.py --firmware .pio/build/ttgo-t-watch/firmware.bin
+# python3 tools/blexfer.py --file data/background.png /background.png
+#
+# the watch must be paired, needs bleak (pip3 install bleak)
+#
+import argparse
+import asyncio
+import struct
+import sys
+import time
+import zlib
+
+SERVICE_UUID = "8a4b0001-5f0e-4c4a-9d4e-2a3c7e1b6f10"
+CONTROL_UUID = "8a4b0002-5f0e-4c4a-9d4e-2a3c7e1b6f10"
+DATA_UUID = "8a4b0003-5f0e-4c4a-9d4e-2a3c7e1b6f10"
+
+CMD_START = 0x01
+CMD_BLOCK = 0x02
+CMD_END = 0x03
+CMD_ABORT = 0x04
+
+REPLY_START = 0x81
+REPLY_ACK = 0x82
+REPLY_NAK = 0x83
+REPLY_DONE = 0x84
+REPLY_ERROR = 0x85
+
+TARGET_FILE = 0
+TARGET_FIRMWARE = 1
+
+REPLY_TIMEOUT = 10
+BLOCK_RETRIES = 8
+RECONNECTS = 5
+
+class TransferError( Exception ):
+    pass
+
+class LinkLost( Exception ):
+    pass
+
+async def send( link, target, name, data, progress = None ):
+    """ one connection, returns when the watch has checked the whole data """
+    crc = zlib.crc32( data )
+    reply = await link.control( struct.pack( "<BBHII", CMD_START, target, link.mtu, len( data ), crc ) + name.encode() )
+    if reply[ 0 ] != REPLY_START:
+        raise TransferError( reply[ 1: ].decode( errors = "replace" ) )
+    chunk, window, offset = struct.unpack( "<HBI", reply[ 1:8 ] )
+
+    while offset < len( data ):
+        block = data[ offset:offset + chunk * window ]
+        block_crc = zlib.crc32( block )
+        missing = ( 1 << ( ( len( block ) + chunk - 1 ) // chunk ) ) - 1
+        for retry in range( BLOCK_RETRIES ):
+            for index in range( window ):
+                if missing & ( 1 << index ):
+                    await link.data( struct.pack( "<I", offset + index * chunk ) + block[ index * chunk:( index + 1 ) * chunk ] )
+            reply = await link.control( struct.pack( "<BIHI", CMD_BLOCK, offset, len( block ), block_crc ) )
+            if reply[ 0 ] == REPLY_ACK:
+                offset = struct.unpack( "<I", reply[ 1:5 ] )[ 0 ]
+                break
+            if reply[ 0 ] != REPLY_NAK:
+                raise TransferError( reply[ 1: ].decode( errors = "replace" ) )
+            missing = struct.unpack( "<I", reply[ 5:9 ] )[ 0 ]
+        else:
+            raise TransferError( "block at %d failed %d times" % ( offset, BLOCK_RETRIES ) )
+        if progress:
+            progress( offset, len( data ) )
+
+    reply = await link.control( bytes( [ CMD_END ] ) )
+    if reply[ 0 ] != REPLY_DONE:
+        raise TransferError( reply[ 1: ].decode( errors = "replace" ) )
+
+async def transfer( connect, target, name, data, progress = None ):
+    """ send and reconnect after a lost connection, the watch resumes the transfer """
+    for attempt in range( RECONNECTS + 1 ):
+        try:
+            link = await connect()
+            try:
+                await send( link, target, name, data, progress )
+                return
+            finally:
+                await link.close()
+        except LinkLost as e:
+            print( "\nconnection lost (%s), reconnect" % e )
+    raise TransferError( "connection lost %d times" % ( RECONNECTS + 1 ) )
+
+class BleakLink:
+    """ the two characteristics of the transfer service, replies come as notify """
+
+    @classmethod
+    async def open( cls, address ):
+        from bleak import BleakClient
+        self = cls()
+        self.replies = asyncio.Queue()
+        self.client = BleakClient( address, disconnected_callback = lambda c: self.replies.put_nowait( None ) )
+        await self.client.connect()
+        self.mtu = getattr( self.client, "mtu_size", 23 )
+        await self.client.start_notify( CONTROL_UUID, lambda sender, value: self.replies.put_nowait( bytes( value ) ) )
+        return( self )
+
+    async def control( self, data ):
+        try:
+            await self.client.write_gatt_char( CONTROL_UUID, data, response = True )
+            reply = await asyncio.wait_for( self.replies.get(), REPLY_TIMEOUT )
+        except asyncio.TimeoutError:
+            raise LinkLost( "no reply" )
+        except Exception as e:
+            raise LinkLost( str( e ) )
+        if reply is None:
+            raise LinkLost( "disconnected" )
+        return( reply )
+
+    async def data( self, data ):
+        try:
+            await self.client.write_gatt_char( DATA_UUID, data, response = False )
+        except Exception as e:
+            raise LinkLost( str( e ) )
+
+    async def close( self ):
+        try:
+            await self.client.disconnect()
+        except Exception:
+            pass
+
+async def find_watch():
+    from bleak import BleakScanner
+    for device in await BleakScanner.discover():
+        if device.name and "T-Watch2020" in device.name:
+            return( device.address )
+    raise TransferError( "no watch found" )
+
+def main( argv ):
+    parser = argparse.ArgumentParser( description = "send a file or firmware to the watch over ble" )
+    parser.add_argument( "--address", help = "ble address of the watch, default is the first T-Watch2020 found" )
+    group = parser.add_mutually_exclusive_group( required = True )
+    group.add_argument( "--firmware", metavar = "IMAGE", help = "firmware.bin, a delta patch or a .gz of them" )
+    group.add_argument( "--file", nargs = 2, metavar = ( "LOCAL", "REMOTE" ), help = "file and its spiffs path" )
+    args = parser.parse_args( argv[ 1: ] )
+
+    if args.firmware:
+        target, name, local = TARGET_FIRMWARE, "firmware", args.firmware
+    else:
+        target, name, local = TARGET_FILE, args.file[ 1 ], args.file[ 0 ]
+    with open( local, "rb" ) as f:
+        data = f.read()
+
+    async def run():
+        address = args.address or await find_watch()
+        start = time.time()
+        def progress( offset, size ):
+            print( "\r%d/%d bytes, %.1f kB/s " % ( offset, size, offset / 1024 / max( time.time() - start, 0.001 ) ), end = "", flush = True )
+        await transfer( lambda: BleakLink.open( address ), target, name, data, progress )
+        print( "\ndone in %.1fs" % ( time.time() - start ) )
+
+    try:
+        asyncio.run( run() )
+    except TransferError as e:
+        print( "\ntransfer failed: %s" % e )
+        return( 1 )
+    return( 0 )
+
+if __name__ == "__main__":
+    sys.exit( main( sys.argv ) )
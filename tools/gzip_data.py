@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+#
+# gzip the web assets in data/ into a staging folder the spiffs image is build from
+#
+# every file in data/ is stored as <file>.gz only, the plain copy is left out of the
+# image. the webserver sends the .gz with Content-Encoding: gzip and uses the crc32
+# and size from the gzip trailer as strong ETag, so the mtime is fixed to 0 to get
+# the same file for the same content. images are already compressed and copied as
+# they are, a .gz in data/ is left over from an older version of this script and
+# skipped.
+#
+# used as platformio extra_script, the image is build from $BUILD_DIR/data, or from
+# the shell: python3 tools/gzip_data.py [data_dir [stage_dir]]
+#
+import gzip
+import os
+import shutil
+import sys
+
+COPY = ( ".ico", ".png", ".jpg" )
+
+def gzip_data( data_dir, stage_dir ):
+    total_plain = 0
+    total_stage = 0
+
+    shutil.rmtree( stage_dir, ignore_errors = True )
+    os.makedirs( stage_dir )
+
+    for name in sorted( os.listdir( data_dir ) ):
+        path = os.path.join( data_dir, name )
+        if not os.path.isfile( path ) or name.endswith( ".gz" ):
+            continue
+
+        with open( path, "rb" ) as f:
+            plain = f.read()
+        if name.endswith( COPY ):
+            stage = os.path.join( stage_dir, name )
+            shutil.copyfile( path, stage )
+        else:
+            stage = os.path.join( stage_dir, name + ".gz" )
+            with open( stage, "wb" ) as f:
+                with gzip.GzipFile( filename = "", mode = "wb", compresslevel = 9, fileobj = f, mtime = 0 ) as gz:
+                    gz.write( plain )
+
+        size = os.path.getsize( stage )
+        total_plain += len( plain )
+        total_stage += size
+        print( "gzip %-24s %7d -> %7d bytes" % ( os.path.basename( stage ), len( plain ), size ) )
+
+    if total_plain:
+        print( "gzip %-24s %7d -> %7d bytes (%d%%)" % ( "total", total_plain, total_stage, total_stage * 100 // total_plain ) )
+
+try:
+    Import( "env" )
+
+    if set( [ "buildfs", "uploadfs", "uploadfsota" ] ) & set( COMMAND_LINE_TARGETS ):
+        stage_dir = os.path.join( env.subst( "$BUILD_DIR" ), "data" )
+        gzip_data( env.subst( "$PROJECT_DATA_DIR" ), stage_dir )
+        env.Replace( PROJECT_DATA_DIR = stage_dir )
+except NameError:
+    if __name__ == "__main__":
+        root = os.path.join( os.path.dirname( os.path.abspath( __file__ ) ), ".." )
+        gzip_data( sys.argv[ 1 ] if len( sys.argv ) > 1 else os.path.join( root, "data" ),
+                   sys.argv[ 2 ] if len( sys.argv ) > 2 else os.path.join( root, ".pio", "data" ) )
@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+#
+# make a delta patch from the running firmware to a new firmware
+#
+# the watch applies the patch while it is downloaded (src/hardware/otadelta.cpp), it
+# reads the old bytes from the running partition and needs no ram for the images.
+# matches are found with a hash of 16 byte blocks, extended byte by byte and then
+# extended as long as more than half of the bytes match. such a region is stored as
+# old bytes plus a sparse diff, a moved call or pointer only cost a few bytes.
+#
+# python3 tools/mkdelta.py old/firmware.bin new/firmware.bin 2020090801.delta
+#
+# the patch is checked against the new image before it is written
+#
+import hashlib
+import struct
+import sys
+
+MAGIC = b"TWDP"
+VERSION = 1
+BLOCK = 16
+STEP = 4
+MIN_ZEROS = 3
+LOOKAHEAD = 32
+
+OP_END = 0
+OP_COPY = 1
+OP_ADD = 2
+OP_INSERT = 3
+
+def varint( value ):
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if value:
+            out.append( byte | 0x80 )
+        else:
+            out.append( byte )
+            return( bytes( out ) )
+
+def zigzag( value ):
+    return( ( value << 1 ) if value >= 0 else ( ( -value << 1 ) - 1 ) )
+
+def sparse_diff( diff ):
+    # runs of ( zeros, bytes ), short zero runs are kept in the bytes
+    out = bytearray()
+    pos = 0
+    while pos < len( diff ):
+        zeros = 0
+        while pos + zeros < len( diff ) and diff[ pos + zeros ] == 0:
+            zeros += 1
+        start = pos + zeros
+        end = start
+        while end < len( diff ):
+            if diff[ end ] != 0:
+                end += 1
+                continue
+            run = 0
+            while end + run < len( diff ) and diff[ end + run ] == 0:
+                run += 1
+            if run >= MIN_ZEROS or end + run == len( diff ):
+                break
+            end += run
+        out += varint( zeros ) + varint( end - start ) + bytes( diff[ start:end ] )
+        pos = end
+    return( bytes( out ) )
+
+def make_delta( old, new ):
+    index = {}
+    for pos in range( len( old ) - BLOCK, -1, -STEP ):
+        index[ old[ pos:pos + BLOCK ] ] = pos
+
+    ops = bytearray()
+    old_pos = 0
+    literal = 0
+    pos = 0
+    while pos <= len( new ) - BLOCK:
+        block = new[ pos:pos + BLOCK ]
+        # prefer the old position that continues the last match
+        match = old_pos + pos - literal
+        if old[ match:match + BLOCK ] != block:
+            match = index.get( block )
+            if match is None:
+                pos += 1
+                continue
+
+        start = pos
+        old_start = match
+        while start > literal and old_start > 0 and new[ start - 1 ] == old[ old_start - 1 ]:
+            start -= 1
+            old_start -= 1
+
+        end = pos + BLOCK
+        old_end = match + BLOCK
+        while end < len( new ) and old_end < len( old ) and new[ end ] == old[ old_end ]:
+            end += 1
+            old_end += 1
+
+        score = 0
+        best = 0
+        best_len = 0
+        length = 0
+        while end + length < len( new ) and old_end + length < len( old ) and length - best_len < LOOKAHEAD:
+            score += 1 if new[ end + length ] == old[ old_end + length ] else -1
+            length += 1
+            if score > best:
+                best = score
+                best_len = length
+        end += best_len
+
+        if start > literal:
+            ops += bytes( [ OP_INSERT ] ) + varint( start - literal ) + new[ literal:start ]
+
+        diff = bytes( ( n - o ) & 0xff for n, o in zip( new[ start:end ], old[ old_start:old_start + end - start ] ) )
+        offset = varint( zigzag( old_start - old_pos ) ) + varint( end - start )
+        if any( diff ):
+            ops += bytes( [ OP_ADD ] ) + offset + sparse_diff( diff )
+        else:
+            ops += bytes( [ OP_COPY ] ) + offset
+
+        old_pos = old_start + end - start
+        literal = end
+        pos = end
+
+    if literal < len( new ):
+        ops += bytes( [ OP_INSERT ] ) + varint( len( new ) - literal ) + new[ literal: ]
+    ops += bytes( [ OP_END ] )
+
+    header = MAGIC + struct.pack( "<B3xII", VERSION, len( old ), len( new ) )
+    header += hashlib.sha256( old ).digest() + hashlib.sha256( new ).digest()
+    return( header + bytes( ops ) )
+
+def apply_delta( old, patch ):
+    def read_varint():
+        nonlocal pos
+        value = 0
+        shift = 0
+        while True:
+            byte = patch[ pos ]
+            pos += 1
+            value |= ( byte & 0x7f ) << shift
+            shift += 7
+            if not byte & 0x80:
+                return( value )
+
+    if patch[ 0:4 ] != MAGIC:
+        raise ValueError( "not a delta patch" )
+    old_size, new_size = struct.unpack( "<II", patch[ 8:16 ] )
+    if len( old ) != old_size or hashlib.sha256( old ).digest() != patch[ 16:48 ]:
+        raise ValueError( "patch does not fit the old image" )
+
+    new = bytearray()
+    pos = 80
+    old_pos = 0
+    while True:
+        op = patch[ pos ]
+        pos += 1
+        if op == OP_END:
+            break
+        if op == OP_INSERT:
+            length = read_varint()
+            new += patch[ pos:pos + length ]
+            pos += length
+            continue
+        offset = read_varint()
+        old_pos += ( offset >> 1 ) ^ -( offset & 1 )
+        length = read_varint()
+        if op == OP_COPY:
+            new += old[ old_pos:old_pos + length ]
+        else:
+            done = 0
+            while done < length:
+                zeros = read_varint()
+                count = read_varint()
+                new += old[ old_pos + done:old_pos + done + zeros ]
+                done += zeros
+                new += bytes( ( o + d ) & 0xff for o, d in zip( old[ old_pos + done:old_pos + done + count ], patch[ pos:pos + count ] ) )
+                pos += count
+                done += count
+        old_pos += length
+
+    if len( new ) != new_size or hashlib.sha256( new ).digest() != patch[ 48:80 ]:
+        raise ValueError( "patch result does not match the new image" )
+    return( bytes( new ) )
+
+def main( argv ):
+    if len( argv ) != 4:
+        print( "usage: %s old.bin new.bin out.delta" % argv[ 0 ] )
+        return( 1 )
+
+    with open( argv[ 1 ], "rb" ) as f:
+        old = f.read()
+    with open( argv[ 2 ], "rb" ) as f:
+        new = f.read()
+
+    patch = make_delta( old, new )
+    if apply_delta( old, patch ) != new:
+        print( "patch check failed" )
+        return( 1 )
+
+    with open( argv[ 3 ], "wb" ) as f:
+        f.write( patch )
+    print( "delta %s -> %s: %d bytes, %d%% of %d" % ( argv[ 1 ], argv[ 2 ], len( patch ), len( patch ) * 100 // max( len( new ), 1 ), len( new ) ) )
+    return( 0 )
+
+if __name__ == "__main__":
+    sys.exit( main( sys.argv ) )